@@ -413,36 +413,30 @@ void _iot_mqtt_signin_client_callback(st_mqtt_event event, void *event_data, voi
 					return;
 				}
 
-				char *payload_json = NULL;
 #if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
-				size_t payload_json_len = 0;
-
-				if (iot_serialize_cbor2json((uint8_t *)md->payload, md->payloadlen, &payload_json, &payload_json_len)) {
-					IOT_ERROR("cbor2json failed");
-					return;
-				}
-
-				if ((payload_json == NULL) || (payload_json_len == 0)) {
-					IOT_ERROR("json buffer is null");
-					return;
+				/* cbor is decoded as it is, without json text */
+				IOT_DEBUG("raw msg (len:%d)", md->payloadlen);
+				if (!strncmp(md->topic, IOT_SUB_TOPIC_COMMAND_PREFIX, IOT_SUB_TOPIC_COMMAND_PREFIX_SIZE)) {
+					iot_cap_dispatch_commands_cbor(ctx, (uint8_t *)md->payload, md->payloadlen);
+				} else if (!strncmp(md->topic, IOT_SUB_TOPIC_NOTIFICATION_PREFIX, IOT_SUB_TOPIC_NOTIFICATION_PREFIX_SIZE)) {
+					iot_noti_sub_cb_cbor(ctx, (uint8_t *)md->payload, md->payloadlen);
+				} else {
+					IOT_WARN("No msg delivery handler for %s", (char *)md->topic);
 				}
 #else
-				payload_json = md->payload;
-#endif
+				char *payload_json = md->payload;
+
 				IOT_DEBUG("raw msg : %s", payload_json);
 				if (!strncmp(md->topic, IOT_SUB_TOPIC_COMMAND_PREFIX, IOT_SUB_TOPIC_COMMAND_PREFIX_SIZE)) {
 					/* Send commands to each registered capability callback handler
-					 * and registered noti callback handler. 
+					 * and registered noti callback handler with one parse.
 					 * application can choose one of both handlers to handle commands */
-					iot_cap_sub_cb(ctx->cap_handle_list, payload_json);
-					iot_cap_commands_cb(ctx, payload_json);
+					iot_cap_dispatch_commands(ctx, payload_json);
 				} else if (!strncmp(md->topic, IOT_SUB_TOPIC_NOTIFICATION_PREFIX, IOT_SUB_TOPIC_NOTIFICATION_PREFIX_SIZE)) {
 					iot_noti_sub_cb(ctx, payload_json);
 				} else {
 					IOT_WARN("No msg delivery handler for %s", (char *)md->topic);
 				}
-#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
-				free(payload_json);
 #endif
 			}
 			break;
@@ -911,8 +905,6 @@ iot_error_t _iot_es_mqtt_connect(struct iot_context *ctx, st_mqtt_client target_
 	iot_error_t iot_ret = IOT_ERROR_NONE;
 	char client_id[IOT_REG_UUID_STR_LEN + 1] = {0, };
 	struct iot_cloud_prov_data *cloud_prov;
-	char *root_cert = NULL;
-	size_t root_cert_len;
 
 	/* Use mac based random client_id for GreatGate */
 	iot_ret = iot_get_random_id_str(client_id, sizeof(client_id));
@@ -928,16 +920,21 @@ iot_error_t _iot_es_mqtt_connect(struct iot_context *ctx, st_mqtt_client target_
 		goto done_mqtt_connect;
 	}
 
-	iot_ret = iot_nv_get_certificate(IOT_SECURITY_CERT_ID_ROOT_CA, &root_cert, &root_cert_len);
-	if (iot_ret != IOT_ERROR_NONE) {
-		IOT_ERROR("failed to get root cert");
-		goto done_mqtt_connect;
+	/* Root cert doesn't change between reconnects, read it from NV only once */
+	if (!ctx->root_cert) {
+		iot_ret = iot_nv_get_certificate(IOT_SECURITY_CERT_ID_ROOT_CA,
+				&ctx->root_cert, &ctx->root_cert_len);
+		if (iot_ret != IOT_ERROR_NONE) {
+			IOT_ERROR("failed to get root cert");
+			ctx->root_cert = NULL;
+			goto done_mqtt_connect;
+		}
 	}
 
 	broker_info.url = cloud_prov->broker_url;
 	broker_info.port = cloud_prov->broker_port;
-	broker_info.ca_cert = (const unsigned char *)root_cert;
-	broker_info.ca_cert_len = root_cert_len;
+	broker_info.ca_cert = (const unsigned char *)ctx->root_cert;
+	broker_info.ca_cert_len = ctx->root_cert_len;
 	broker_info.ssl = 1;
 
 	IOT_INFO("url: %s, port: %d", cloud_prov->broker_url, cloud_prov->broker_port);
@@ -973,6 +970,7 @@ iot_error_t _iot_es_mqtt_connect(struct iot_context *ctx, st_mqtt_client target_
 			/* These cases are related to device's clientID, serialNumber, deviceId & web token
 			 * So we try to cleanup all data & reboot
 			 */
+			iot_wt_cache_clear(&ctx->wt_cache);
 			if (ctx->mqtt_connect_critical_reject_count++ < IOT_MQTT_CONNECT_CRITICAL_REJECT_MAX) {
 				IOT_WARN("MQTT critical reject retry %d", ctx->mqtt_connect_critical_reject_count);
 				iot_ret = IOT_ERROR_MQTT_CONNECT_FAIL;
@@ -1004,9 +1002,6 @@ iot_error_t _iot_es_mqtt_connect(struct iot_context *ctx, st_mqtt_client target_
 
 
 done_mqtt_connect:
-	if (root_cert)
-		free((void *)root_cert);
-
 	return iot_ret;
 }
 
@@ -1071,7 +1066,7 @@ iot_error_t iot_es_connect(struct iot_context *ctx, int conn_type)
 	}
 #endif
 
-	iot_ret = iot_wt_create((const iot_wt_params_t *)&wt_params, &token_buf);
+	iot_ret = iot_wt_create_cached(&ctx->wt_cache, (const iot_wt_params_t *)&wt_params, &token_buf);
 	if (iot_ret != IOT_ERROR_NONE) {
 		IOT_ERROR("failed to make wt-token");
 		goto out;
@@ -35,6 +35,14 @@ typedef struct {
 	char filename[128];
 } iot_bsp_fs_handle_t;
 
+/**
+ * @brief Prefix of files spilling runtime data, such as events buffered offline.
+ *
+ * They aren't nv data and are written and removed often, so a bsp may keep
+ * them apart from nv files.
+ */
+#define IOT_BSP_FS_SPILL_PREFIX	"OfflineEvt"
+
 /**
  * @name iot_bsp_fs_open_mode_t
  * @brief file system open mode.
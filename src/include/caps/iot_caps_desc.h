@@ -0,0 +1,1535 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Generated by tools/capgen/stdk-capgen.py from iot_caps_helper_*.h, do not edit */
+
+#ifndef _IOT_CAPS_DESC_H_
+#define _IOT_CAPS_DESC_H_
+
+#include <stdbool.h>
+#include "st_dev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Interned ids of attributes, index of generated attribute description table
+ */
+enum {
+	IOT_CAPS_ATTR_ACCELERATIONSENSOR_ACCELERATION,
+	IOT_CAPS_ATTR_ACTIVITYLIGHTINGMODE_LIGHTINGMODE,
+	IOT_CAPS_ATTR_AIRQUALITYSENSOR_AIRQUALITY,
+	IOT_CAPS_ATTR_ALARM_ALARM,
+	IOT_CAPS_ATTR_AUDIOMUTE_MUTE,
+	IOT_CAPS_ATTR_AUDIOVOLUME_VOLUME,
+	IOT_CAPS_ATTR_BATTERY_BATTERY,
+	IOT_CAPS_ATTR_BODYMASSINDEXMEASUREMENT_BMIMEASUREMENT,
+	IOT_CAPS_ATTR_BODYWEIGHTMEASUREMENT_BODYWEIGHTMEASUREMENT,
+	IOT_CAPS_ATTR_BUTTON_SUPPORTEDBUTTONVALUES,
+	IOT_CAPS_ATTR_BUTTON_BUTTON,
+	IOT_CAPS_ATTR_BUTTON_NUMBEROFBUTTONS,
+	IOT_CAPS_ATTR_CARBONDIOXIDEHEALTHCONCERN_CARBONDIOXIDEHEALTHCONCERN,
+	IOT_CAPS_ATTR_CARBONDIOXIDEMEASUREMENT_CARBONDIOXIDE,
+	IOT_CAPS_ATTR_CARBONMONOXIDEDETECTOR_CARBONMONOXIDE,
+	IOT_CAPS_ATTR_CARBONMONOXIDEMEASUREMENT_CARBONMONOXIDELEVEL,
+	IOT_CAPS_ATTR_COLORCONTROL_COLOR,
+	IOT_CAPS_ATTR_COLORCONTROL_HUE,
+	IOT_CAPS_ATTR_COLORCONTROL_SATURATION,
+	IOT_CAPS_ATTR_COLORTEMPERATURE_COLORTEMPERATURE,
+	IOT_CAPS_ATTR_CONTACTSENSOR_CONTACT,
+	IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_COMPLETIONTIME,
+	IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_SUPPORTEDMACHINESTATES,
+	IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_MACHINESTATE,
+	IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_DISHWASHERJOBSTATE,
+	IOT_CAPS_ATTR_DOORCONTROL_DOOR,
+	IOT_CAPS_ATTR_DRYEROPERATINGSTATE_COMPLETIONTIME,
+	IOT_CAPS_ATTR_DRYEROPERATINGSTATE_SUPPORTEDMACHINESTATES,
+	IOT_CAPS_ATTR_DRYEROPERATINGSTATE_MACHINESTATE,
+	IOT_CAPS_ATTR_DRYEROPERATINGSTATE_DRYERJOBSTATE,
+	IOT_CAPS_ATTR_DUSTHEALTHCONCERN_DUSTHEALTHCONCERN,
+	IOT_CAPS_ATTR_DUSTSENSOR_FINEDUSTLEVEL,
+	IOT_CAPS_ATTR_DUSTSENSOR_DUSTLEVEL,
+	IOT_CAPS_ATTR_ENERGYMETER_ENERGY,
+	IOT_CAPS_ATTR_EQUIVALENTCARBONDIOXIDEMEASUREMENT_EQUIVALENTCARBONDIOXIDEMEASUREMENT,
+	IOT_CAPS_ATTR_EXECUTE_DATA,
+	IOT_CAPS_ATTR_FANOSCILLATIONMODE_SUPPORTEDFANOSCILLATIONMODES,
+	IOT_CAPS_ATTR_FANOSCILLATIONMODE_FANOSCILLATIONMODE,
+	IOT_CAPS_ATTR_FANSPEED_FANSPEED,
+	IOT_CAPS_ATTR_FILTERSTATUS_FILTERSTATUS,
+	IOT_CAPS_ATTR_FINEDUSTHEALTHCONCERN_FINEDUSTHEALTHCONCERN,
+	IOT_CAPS_ATTR_FINEDUSTSENSOR_FINEDUSTLEVEL,
+	IOT_CAPS_ATTR_FIRMWAREUPDATE_LASTUPDATESTATUS,
+	IOT_CAPS_ATTR_FIRMWAREUPDATE_STATE,
+	IOT_CAPS_ATTR_FIRMWAREUPDATE_CURRENTVERSION,
+	IOT_CAPS_ATTR_FIRMWAREUPDATE_LASTUPDATETIME,
+	IOT_CAPS_ATTR_FIRMWAREUPDATE_AVAILABLEVERSION,
+	IOT_CAPS_ATTR_FIRMWAREUPDATE_LASTUPDATESTATUSREASON,
+	IOT_CAPS_ATTR_FORMALDEHYDEMEASUREMENT_FORMALDEHYDELEVEL,
+	IOT_CAPS_ATTR_GARAGEDOORCONTROL_DOOR,
+	IOT_CAPS_ATTR_GASMETER_GASMETERTIME,
+	IOT_CAPS_ATTR_GASMETER_GASMETER,
+	IOT_CAPS_ATTR_GASMETER_GASMETERCALORIFIC,
+	IOT_CAPS_ATTR_GASMETER_GASMETERVOLUME,
+	IOT_CAPS_ATTR_GASMETER_GASMETERPRECISION,
+	IOT_CAPS_ATTR_GASMETER_GASMETERCONVERSION,
+	IOT_CAPS_ATTR_ILLUMINANCEMEASUREMENT_ILLUMINANCE,
+	IOT_CAPS_ATTR_IMAGECAPTURE_ENCRYPTED,
+	IOT_CAPS_ATTR_IMAGECAPTURE_IMAGE,
+	IOT_CAPS_ATTR_IMAGECAPTURE_CAPTURETIME,
+	IOT_CAPS_ATTR_LOCK_LOCK,
+	IOT_CAPS_ATTR_MEDIAINPUTSOURCE_INPUTSOURCE,
+	IOT_CAPS_ATTR_MEDIAINPUTSOURCE_SUPPORTEDINPUTSOURCES,
+	IOT_CAPS_ATTR_MEDIAPLAYBACK_SUPPORTEDPLAYBACKCOMMANDS,
+	IOT_CAPS_ATTR_MEDIAPLAYBACK_PLAYBACKSTATUS,
+	IOT_CAPS_ATTR_MEDIAPLAYBACKREPEAT_PLAYBACKREPEATMODE,
+	IOT_CAPS_ATTR_MEDIAPLAYBACKSHUFFLE_PLAYBACKSHUFFLE,
+	IOT_CAPS_ATTR_MODE_SUPPORTEDMODES,
+	IOT_CAPS_ATTR_MODE_MODE,
+	IOT_CAPS_ATTR_MOLDHEALTHCONCERN_MOLDHEALTHCONCERN,
+	IOT_CAPS_ATTR_MOTIONSENSOR_MOTION,
+	IOT_CAPS_ATTR_OBJECTDETECTION_DETECTED,
+	IOT_CAPS_ATTR_OBJECTDETECTION_SUPPORTEDVALUES,
+	IOT_CAPS_ATTR_ODORSENSOR_ODORLEVEL,
+	IOT_CAPS_ATTR_OPERATINGSTATE_SUPPORTEDMACHINESTATES,
+	IOT_CAPS_ATTR_OPERATINGSTATE_MACHINESTATE,
+	IOT_CAPS_ATTR_OVENOPERATINGSTATE_OVENJOBSTATE,
+	IOT_CAPS_ATTR_OVENOPERATINGSTATE_COMPLETIONTIME,
+	IOT_CAPS_ATTR_OVENOPERATINGSTATE_SUPPORTEDMACHINESTATES,
+	IOT_CAPS_ATTR_OVENOPERATINGSTATE_PROGRESS,
+	IOT_CAPS_ATTR_OVENOPERATINGSTATE_OPERATIONTIME,
+	IOT_CAPS_ATTR_OVENOPERATINGSTATE_MACHINESTATE,
+	IOT_CAPS_ATTR_OVENSETPOINT_OVENSETPOINT,
+	IOT_CAPS_ATTR_PHMEASUREMENT_PH,
+	IOT_CAPS_ATTR_PANICALARM_PANICALARM,
+	IOT_CAPS_ATTR_POWERMETER_POWER,
+	IOT_CAPS_ATTR_POWERSOURCE_POWERSOURCE,
+	IOT_CAPS_ATTR_PRESENCESENSOR_PRESENCE,
+	IOT_CAPS_ATTR_RADONHEALTHCONCERN_RADONHEALTHCONCERN,
+	IOT_CAPS_ATTR_RAPIDCOOLING_RAPIDCOOLING,
+	IOT_CAPS_ATTR_RELATIVEHUMIDITYMEASUREMENT_HUMIDITY,
+	IOT_CAPS_ATTR_REMOTECONTROLSTATUS_REMOTECONTROLENABLED,
+	IOT_CAPS_ATTR_ROBOTCLEANERMOVEMENT_ROBOTCLEANERMOVEMENT,
+	IOT_CAPS_ATTR_ROBOTCLEANERTURBOMODE_ROBOTCLEANERTURBOMODE,
+	IOT_CAPS_ATTR_SAMSUNGTV_VOLUME,
+	IOT_CAPS_ATTR_SAMSUNGTV_MESSAGEBUTTON,
+	IOT_CAPS_ATTR_SAMSUNGTV_SWITCH,
+	IOT_CAPS_ATTR_SAMSUNGTV_MUTE,
+	IOT_CAPS_ATTR_SAMSUNGTV_PICTUREMODE,
+	IOT_CAPS_ATTR_SAMSUNGTV_SOUNDMODE,
+	IOT_CAPS_ATTR_SECURITYSYSTEM_ALARM,
+	IOT_CAPS_ATTR_SECURITYSYSTEM_SECURITYSYSTEMSTATUS,
+	IOT_CAPS_ATTR_SIGNALSTRENGTH_RSSI,
+	IOT_CAPS_ATTR_SIGNALSTRENGTH_LQI,
+	IOT_CAPS_ATTR_SLEEPSENSOR_SLEEPING,
+	IOT_CAPS_ATTR_SMOKEDETECTOR_SMOKE,
+	IOT_CAPS_ATTR_SOUNDPRESSURELEVEL_SOUNDPRESSURELEVEL,
+	IOT_CAPS_ATTR_SOUNDSENSOR_SOUND,
+	IOT_CAPS_ATTR_SWITCH_SWITCH,
+	IOT_CAPS_ATTR_SWITCHLEVEL_LEVEL,
+	IOT_CAPS_ATTR_TAMPERALERT_TAMPER,
+	IOT_CAPS_ATTR_TEMPERATUREALARM_TEMPERATUREALARM,
+	IOT_CAPS_ATTR_TEMPERATUREMEASUREMENT_TEMPERATURE,
+	IOT_CAPS_ATTR_THERMOSTATCOOLINGSETPOINT_COOLINGSETPOINT,
+	IOT_CAPS_ATTR_THERMOSTATFANMODE_THERMOSTATFANMODE,
+	IOT_CAPS_ATTR_THERMOSTATFANMODE_SUPPORTEDTHERMOSTATFANMODES,
+	IOT_CAPS_ATTR_THERMOSTATHEATINGSETPOINT_HEATINGSETPOINT,
+	IOT_CAPS_ATTR_THERMOSTATMODE_THERMOSTATMODE,
+	IOT_CAPS_ATTR_THERMOSTATMODE_SUPPORTEDTHERMOSTATMODES,
+	IOT_CAPS_ATTR_THERMOSTATOPERATINGSTATE_THERMOSTATOPERATINGSTATE,
+	IOT_CAPS_ATTR_THERMOSTATSETPOINT_THERMOSTATSETPOINT,
+	IOT_CAPS_ATTR_THREEAXIS_THREEAXIS,
+	IOT_CAPS_ATTR_TIMEDSESSION_COMPLETIONTIME,
+	IOT_CAPS_ATTR_TIMEDSESSION_SESSIONSTATUS,
+	IOT_CAPS_ATTR_TVOCHEALTHCONCERN_TVOCHEALTHCONCERN,
+	IOT_CAPS_ATTR_TVOCMEASUREMENT_TVOCLEVEL,
+	IOT_CAPS_ATTR_ULTRAVIOLETINDEX_ULTRAVIOLETINDEX,
+	IOT_CAPS_ATTR_VALVE_VALVE,
+	IOT_CAPS_ATTR_VERYFINEDUSTHEALTHCONCERN_VERYFINEDUSTHEALTHCONCERN,
+	IOT_CAPS_ATTR_VERYFINEDUSTSENSOR_VERYFINEDUSTLEVEL,
+	IOT_CAPS_ATTR_VOLTAGEMEASUREMENT_VOLTAGE,
+	IOT_CAPS_ATTR_WATERSENSOR_WATER,
+	IOT_CAPS_ATTR_WINDOWSHADE_WINDOWSHADE,
+	IOT_CAPS_ATTR_WINDOWSHADE_SUPPORTEDWINDOWSHADECOMMANDS,
+	IOT_CAPS_ATTR_MAX
+};
+
+/*
+ * Typed senders check value against the attribute description and
+ * publish it without copying, see st_cap_send_attr_desc().
+ * Attribute with one unit is sent with it, unit is chosen by caller
+ * when there are several.
+ */
+static inline int st_cap_send_accelerationSensor_acceleration(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_ACCELERATIONSENSOR_ACCELERATION, &value, NULL);
+}
+
+static inline int st_cap_send_activityLightingMode_lightingMode(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_ACTIVITYLIGHTINGMODE_LIGHTINGMODE, &value, NULL);
+}
+
+static inline int st_cap_send_airQualitySensor_airQuality(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_AIRQUALITYSENSOR_AIRQUALITY, &value, NULL);
+}
+
+static inline int st_cap_send_alarm_alarm(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_ALARM_ALARM, &value, NULL);
+}
+
+static inline int st_cap_send_audioMute_mute(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_AUDIOMUTE_MUTE, &value, NULL);
+}
+
+static inline int st_cap_send_audioVolume_volume(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_AUDIOVOLUME_VOLUME, &value, NULL);
+}
+
+static inline int st_cap_send_battery_battery(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_BATTERY_BATTERY, &value, NULL);
+}
+
+static inline int st_cap_send_bodyMassIndexMeasurement_bmiMeasurement(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_BODYMASSINDEXMEASUREMENT_BMIMEASUREMENT, &value, NULL);
+}
+
+static inline int st_cap_send_bodyWeightMeasurement_bodyWeightMeasurement(IOT_CAP_HANDLE *cap_handle, double number, const char *unit)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_BODYWEIGHTMEASUREMENT_BODYWEIGHTMEASUREMENT, &value, unit);
+}
+
+static inline int st_cap_send_button_supportedButtonValues(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_BUTTON_SUPPORTEDBUTTONVALUES, &value, NULL);
+}
+
+static inline int st_cap_send_button_button(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_BUTTON_BUTTON, &value, NULL);
+}
+
+static inline int st_cap_send_button_numberOfButtons(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_BUTTON_NUMBEROFBUTTONS, &value, NULL);
+}
+
+static inline int st_cap_send_carbonDioxideHealthConcern_carbonDioxideHealthConcern(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_CARBONDIOXIDEHEALTHCONCERN_CARBONDIOXIDEHEALTHCONCERN, &value, NULL);
+}
+
+static inline int st_cap_send_carbonDioxideMeasurement_carbonDioxide(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_CARBONDIOXIDEMEASUREMENT_CARBONDIOXIDE, &value, NULL);
+}
+
+static inline int st_cap_send_carbonMonoxideDetector_carbonMonoxide(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_CARBONMONOXIDEDETECTOR_CARBONMONOXIDE, &value, NULL);
+}
+
+static inline int st_cap_send_carbonMonoxideMeasurement_carbonMonoxideLevel(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_CARBONMONOXIDEMEASUREMENT_CARBONMONOXIDELEVEL, &value, NULL);
+}
+
+static inline int st_cap_send_colorControl_color(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_COLORCONTROL_COLOR, &value, NULL);
+}
+
+static inline int st_cap_send_colorControl_hue(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_COLORCONTROL_HUE, &value, NULL);
+}
+
+static inline int st_cap_send_colorControl_saturation(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_COLORCONTROL_SATURATION, &value, NULL);
+}
+
+static inline int st_cap_send_colorTemperature_colorTemperature(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_COLORTEMPERATURE_COLORTEMPERATURE, &value, NULL);
+}
+
+static inline int st_cap_send_contactSensor_contact(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_CONTACTSENSOR_CONTACT, &value, NULL);
+}
+
+static inline int st_cap_send_dishwasherOperatingState_completionTime(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_COMPLETIONTIME, &value, NULL);
+}
+
+static inline int st_cap_send_dishwasherOperatingState_supportedMachineStates(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_SUPPORTEDMACHINESTATES, &value, NULL);
+}
+
+static inline int st_cap_send_dishwasherOperatingState_machineState(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_MACHINESTATE, &value, NULL);
+}
+
+static inline int st_cap_send_dishwasherOperatingState_dishwasherJobState(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_DISHWASHERJOBSTATE, &value, NULL);
+}
+
+static inline int st_cap_send_doorControl_door(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DOORCONTROL_DOOR, &value, NULL);
+}
+
+static inline int st_cap_send_dryerOperatingState_completionTime(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DRYEROPERATINGSTATE_COMPLETIONTIME, &value, NULL);
+}
+
+static inline int st_cap_send_dryerOperatingState_supportedMachineStates(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DRYEROPERATINGSTATE_SUPPORTEDMACHINESTATES, &value, NULL);
+}
+
+static inline int st_cap_send_dryerOperatingState_machineState(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DRYEROPERATINGSTATE_MACHINESTATE, &value, NULL);
+}
+
+static inline int st_cap_send_dryerOperatingState_dryerJobState(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DRYEROPERATINGSTATE_DRYERJOBSTATE, &value, NULL);
+}
+
+static inline int st_cap_send_dustHealthConcern_dustHealthConcern(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DUSTHEALTHCONCERN_DUSTHEALTHCONCERN, &value, NULL);
+}
+
+static inline int st_cap_send_dustSensor_fineDustLevel(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DUSTSENSOR_FINEDUSTLEVEL, &value, NULL);
+}
+
+static inline int st_cap_send_dustSensor_dustLevel(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_DUSTSENSOR_DUSTLEVEL, &value, NULL);
+}
+
+static inline int st_cap_send_energyMeter_energy(IOT_CAP_HANDLE *cap_handle, double number, const char *unit)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_ENERGYMETER_ENERGY, &value, unit);
+}
+
+static inline int st_cap_send_equivalentCarbonDioxideMeasurement_equivalentCarbonDioxideMeasurement(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_EQUIVALENTCARBONDIOXIDEMEASUREMENT_EQUIVALENTCARBONDIOXIDEMEASUREMENT, &value, NULL);
+}
+
+static inline int st_cap_send_execute_data(IOT_CAP_HANDLE *cap_handle, const char *json)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
+	value.json_object = (char *)json;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_EXECUTE_DATA, &value, NULL);
+}
+
+static inline int st_cap_send_fanOscillationMode_supportedFanOscillationModes(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FANOSCILLATIONMODE_SUPPORTEDFANOSCILLATIONMODES, &value, NULL);
+}
+
+static inline int st_cap_send_fanOscillationMode_fanOscillationMode(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FANOSCILLATIONMODE_FANOSCILLATIONMODE, &value, NULL);
+}
+
+static inline int st_cap_send_fanSpeed_fanSpeed(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FANSPEED_FANSPEED, &value, NULL);
+}
+
+static inline int st_cap_send_filterStatus_filterStatus(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FILTERSTATUS_FILTERSTATUS, &value, NULL);
+}
+
+static inline int st_cap_send_fineDustHealthConcern_fineDustHealthConcern(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FINEDUSTHEALTHCONCERN_FINEDUSTHEALTHCONCERN, &value, NULL);
+}
+
+static inline int st_cap_send_fineDustSensor_fineDustLevel(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FINEDUSTSENSOR_FINEDUSTLEVEL, &value, NULL);
+}
+
+static inline int st_cap_send_firmwareUpdate_lastUpdateStatus(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FIRMWAREUPDATE_LASTUPDATESTATUS, &value, NULL);
+}
+
+static inline int st_cap_send_firmwareUpdate_state(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FIRMWAREUPDATE_STATE, &value, NULL);
+}
+
+static inline int st_cap_send_firmwareUpdate_currentVersion(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FIRMWAREUPDATE_CURRENTVERSION, &value, NULL);
+}
+
+static inline int st_cap_send_firmwareUpdate_lastUpdateTime(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FIRMWAREUPDATE_LASTUPDATETIME, &value, NULL);
+}
+
+static inline int st_cap_send_firmwareUpdate_availableVersion(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FIRMWAREUPDATE_AVAILABLEVERSION, &value, NULL);
+}
+
+static inline int st_cap_send_firmwareUpdate_lastUpdateStatusReason(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FIRMWAREUPDATE_LASTUPDATESTATUSREASON, &value, NULL);
+}
+
+static inline int st_cap_send_formaldehydeMeasurement_formaldehydeLevel(IOT_CAP_HANDLE *cap_handle, double number, const char *unit)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_FORMALDEHYDEMEASUREMENT_FORMALDEHYDELEVEL, &value, unit);
+}
+
+static inline int st_cap_send_garageDoorControl_door(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_GARAGEDOORCONTROL_DOOR, &value, NULL);
+}
+
+static inline int st_cap_send_gasMeter_gasMeterTime(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_GASMETER_GASMETERTIME, &value, NULL);
+}
+
+static inline int st_cap_send_gasMeter_gasMeter(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_GASMETER_GASMETER, &value, NULL);
+}
+
+static inline int st_cap_send_gasMeter_gasMeterCalorific(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_GASMETER_GASMETERCALORIFIC, &value, NULL);
+}
+
+static inline int st_cap_send_gasMeter_gasMeterVolume(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_GASMETER_GASMETERVOLUME, &value, NULL);
+}
+
+static inline int st_cap_send_gasMeter_gasMeterPrecision(IOT_CAP_HANDLE *cap_handle, const char *json)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
+	value.json_object = (char *)json;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_GASMETER_GASMETERPRECISION, &value, NULL);
+}
+
+static inline int st_cap_send_gasMeter_gasMeterConversion(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_GASMETER_GASMETERCONVERSION, &value, NULL);
+}
+
+static inline int st_cap_send_illuminanceMeasurement_illuminance(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_ILLUMINANCEMEASUREMENT_ILLUMINANCE, &value, NULL);
+}
+
+static inline int st_cap_send_imageCapture_encrypted(IOT_CAP_HANDLE *cap_handle, bool boolean)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_BOOLEAN;
+	value.boolean = boolean;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_IMAGECAPTURE_ENCRYPTED, &value, NULL);
+}
+
+static inline int st_cap_send_imageCapture_image(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_IMAGECAPTURE_IMAGE, &value, NULL);
+}
+
+static inline int st_cap_send_imageCapture_captureTime(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_IMAGECAPTURE_CAPTURETIME, &value, NULL);
+}
+
+static inline int st_cap_send_lock_lock(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_LOCK_LOCK, &value, NULL);
+}
+
+static inline int st_cap_send_mediaInputSource_inputSource(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MEDIAINPUTSOURCE_INPUTSOURCE, &value, NULL);
+}
+
+static inline int st_cap_send_mediaInputSource_supportedInputSources(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MEDIAINPUTSOURCE_SUPPORTEDINPUTSOURCES, &value, NULL);
+}
+
+static inline int st_cap_send_mediaPlayback_supportedPlaybackCommands(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MEDIAPLAYBACK_SUPPORTEDPLAYBACKCOMMANDS, &value, NULL);
+}
+
+static inline int st_cap_send_mediaPlayback_playbackStatus(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MEDIAPLAYBACK_PLAYBACKSTATUS, &value, NULL);
+}
+
+static inline int st_cap_send_mediaPlaybackRepeat_playbackRepeatMode(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MEDIAPLAYBACKREPEAT_PLAYBACKREPEATMODE, &value, NULL);
+}
+
+static inline int st_cap_send_mediaPlaybackShuffle_playbackShuffle(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MEDIAPLAYBACKSHUFFLE_PLAYBACKSHUFFLE, &value, NULL);
+}
+
+static inline int st_cap_send_mode_supportedModes(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MODE_SUPPORTEDMODES, &value, NULL);
+}
+
+static inline int st_cap_send_mode_mode(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MODE_MODE, &value, NULL);
+}
+
+static inline int st_cap_send_moldHealthConcern_moldHealthConcern(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MOLDHEALTHCONCERN_MOLDHEALTHCONCERN, &value, NULL);
+}
+
+static inline int st_cap_send_motionSensor_motion(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_MOTIONSENSOR_MOTION, &value, NULL);
+}
+
+static inline int st_cap_send_objectDetection_detected(IOT_CAP_HANDLE *cap_handle, const char *json)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
+	value.json_object = (char *)json;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OBJECTDETECTION_DETECTED, &value, NULL);
+}
+
+static inline int st_cap_send_objectDetection_supportedValues(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OBJECTDETECTION_SUPPORTEDVALUES, &value, NULL);
+}
+
+static inline int st_cap_send_odorSensor_odorLevel(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_ODORSENSOR_ODORLEVEL, &value, NULL);
+}
+
+static inline int st_cap_send_operatingState_supportedMachineStates(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OPERATINGSTATE_SUPPORTEDMACHINESTATES, &value, NULL);
+}
+
+static inline int st_cap_send_operatingState_machineState(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OPERATINGSTATE_MACHINESTATE, &value, NULL);
+}
+
+static inline int st_cap_send_ovenOperatingState_ovenJobState(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OVENOPERATINGSTATE_OVENJOBSTATE, &value, NULL);
+}
+
+static inline int st_cap_send_ovenOperatingState_completionTime(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OVENOPERATINGSTATE_COMPLETIONTIME, &value, NULL);
+}
+
+static inline int st_cap_send_ovenOperatingState_supportedMachineStates(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OVENOPERATINGSTATE_SUPPORTEDMACHINESTATES, &value, NULL);
+}
+
+static inline int st_cap_send_ovenOperatingState_progress(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OVENOPERATINGSTATE_PROGRESS, &value, NULL);
+}
+
+static inline int st_cap_send_ovenOperatingState_operationTime(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OVENOPERATINGSTATE_OPERATIONTIME, &value, NULL);
+}
+
+static inline int st_cap_send_ovenOperatingState_machineState(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OVENOPERATINGSTATE_MACHINESTATE, &value, NULL);
+}
+
+static inline int st_cap_send_ovenSetpoint_ovenSetpoint(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_OVENSETPOINT_OVENSETPOINT, &value, NULL);
+}
+
+static inline int st_cap_send_pHMeasurement_pH(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_PHMEASUREMENT_PH, &value, NULL);
+}
+
+static inline int st_cap_send_panicAlarm_panicAlarm(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_PANICALARM_PANICALARM, &value, NULL);
+}
+
+static inline int st_cap_send_powerMeter_power(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_POWERMETER_POWER, &value, NULL);
+}
+
+static inline int st_cap_send_powerSource_powerSource(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_POWERSOURCE_POWERSOURCE, &value, NULL);
+}
+
+static inline int st_cap_send_presenceSensor_presence(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_PRESENCESENSOR_PRESENCE, &value, NULL);
+}
+
+static inline int st_cap_send_radonHealthConcern_radonHealthConcern(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_RADONHEALTHCONCERN_RADONHEALTHCONCERN, &value, NULL);
+}
+
+static inline int st_cap_send_rapidCooling_rapidCooling(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_RAPIDCOOLING_RAPIDCOOLING, &value, NULL);
+}
+
+static inline int st_cap_send_relativeHumidityMeasurement_humidity(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_RELATIVEHUMIDITYMEASUREMENT_HUMIDITY, &value, NULL);
+}
+
+static inline int st_cap_send_remoteControlStatus_remoteControlEnabled(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_REMOTECONTROLSTATUS_REMOTECONTROLENABLED, &value, NULL);
+}
+
+static inline int st_cap_send_robotCleanerMovement_robotCleanerMovement(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_ROBOTCLEANERMOVEMENT_ROBOTCLEANERMOVEMENT, &value, NULL);
+}
+
+static inline int st_cap_send_robotCleanerTurboMode_robotCleanerTurboMode(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_ROBOTCLEANERTURBOMODE_ROBOTCLEANERTURBOMODE, &value, NULL);
+}
+
+static inline int st_cap_send_samsungTV_volume(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SAMSUNGTV_VOLUME, &value, NULL);
+}
+
+static inline int st_cap_send_samsungTV_messageButton(IOT_CAP_HANDLE *cap_handle, const char *json)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
+	value.json_object = (char *)json;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SAMSUNGTV_MESSAGEBUTTON, &value, NULL);
+}
+
+static inline int st_cap_send_samsungTV_switch(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SAMSUNGTV_SWITCH, &value, NULL);
+}
+
+static inline int st_cap_send_samsungTV_mute(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SAMSUNGTV_MUTE, &value, NULL);
+}
+
+static inline int st_cap_send_samsungTV_pictureMode(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SAMSUNGTV_PICTUREMODE, &value, NULL);
+}
+
+static inline int st_cap_send_samsungTV_soundMode(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SAMSUNGTV_SOUNDMODE, &value, NULL);
+}
+
+static inline int st_cap_send_securitySystem_alarm(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SECURITYSYSTEM_ALARM, &value, NULL);
+}
+
+static inline int st_cap_send_securitySystem_securitySystemStatus(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SECURITYSYSTEM_SECURITYSYSTEMSTATUS, &value, NULL);
+}
+
+static inline int st_cap_send_signalStrength_rssi(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SIGNALSTRENGTH_RSSI, &value, NULL);
+}
+
+static inline int st_cap_send_signalStrength_lqi(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SIGNALSTRENGTH_LQI, &value, NULL);
+}
+
+static inline int st_cap_send_sleepSensor_sleeping(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SLEEPSENSOR_SLEEPING, &value, NULL);
+}
+
+static inline int st_cap_send_smokeDetector_smoke(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SMOKEDETECTOR_SMOKE, &value, NULL);
+}
+
+static inline int st_cap_send_soundPressureLevel_soundPressureLevel(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SOUNDPRESSURELEVEL_SOUNDPRESSURELEVEL, &value, NULL);
+}
+
+static inline int st_cap_send_soundSensor_sound(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SOUNDSENSOR_SOUND, &value, NULL);
+}
+
+static inline int st_cap_send_switch_switch(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SWITCH_SWITCH, &value, NULL);
+}
+
+static inline int st_cap_send_switchLevel_level(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_SWITCHLEVEL_LEVEL, &value, NULL);
+}
+
+static inline int st_cap_send_tamperAlert_tamper(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_TAMPERALERT_TAMPER, &value, NULL);
+}
+
+static inline int st_cap_send_temperatureAlarm_temperatureAlarm(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_TEMPERATUREALARM_TEMPERATUREALARM, &value, NULL);
+}
+
+static inline int st_cap_send_temperatureMeasurement_temperature(IOT_CAP_HANDLE *cap_handle, double number, const char *unit)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_TEMPERATUREMEASUREMENT_TEMPERATURE, &value, unit);
+}
+
+static inline int st_cap_send_thermostatCoolingSetpoint_coolingSetpoint(IOT_CAP_HANDLE *cap_handle, double number, const char *unit)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_THERMOSTATCOOLINGSETPOINT_COOLINGSETPOINT, &value, unit);
+}
+
+static inline int st_cap_send_thermostatFanMode_thermostatFanMode(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_THERMOSTATFANMODE_THERMOSTATFANMODE, &value, NULL);
+}
+
+static inline int st_cap_send_thermostatFanMode_supportedThermostatFanModes(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_THERMOSTATFANMODE_SUPPORTEDTHERMOSTATFANMODES, &value, NULL);
+}
+
+static inline int st_cap_send_thermostatHeatingSetpoint_heatingSetpoint(IOT_CAP_HANDLE *cap_handle, double number, const char *unit)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_THERMOSTATHEATINGSETPOINT_HEATINGSETPOINT, &value, unit);
+}
+
+static inline int st_cap_send_thermostatMode_thermostatMode(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_THERMOSTATMODE_THERMOSTATMODE, &value, NULL);
+}
+
+static inline int st_cap_send_thermostatMode_supportedThermostatModes(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_THERMOSTATMODE_SUPPORTEDTHERMOSTATMODES, &value, NULL);
+}
+
+static inline int st_cap_send_thermostatOperatingState_thermostatOperatingState(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_THERMOSTATOPERATINGSTATE_THERMOSTATOPERATINGSTATE, &value, NULL);
+}
+
+static inline int st_cap_send_thermostatSetpoint_thermostatSetpoint(IOT_CAP_HANDLE *cap_handle, double number, const char *unit)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_THERMOSTATSETPOINT_THERMOSTATSETPOINT, &value, unit);
+}
+
+static inline int st_cap_send_threeAxis_threeAxis(IOT_CAP_HANDLE *cap_handle, const char *json)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
+	value.json_object = (char *)json;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_THREEAXIS_THREEAXIS, &value, NULL);
+}
+
+static inline int st_cap_send_timedSession_completionTime(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_TIMEDSESSION_COMPLETIONTIME, &value, NULL);
+}
+
+static inline int st_cap_send_timedSession_sessionStatus(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_TIMEDSESSION_SESSIONSTATUS, &value, NULL);
+}
+
+static inline int st_cap_send_tvocHealthConcern_tvocHealthConcern(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_TVOCHEALTHCONCERN_TVOCHEALTHCONCERN, &value, NULL);
+}
+
+static inline int st_cap_send_tvocMeasurement_tvocLevel(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_TVOCMEASUREMENT_TVOCLEVEL, &value, NULL);
+}
+
+static inline int st_cap_send_ultravioletIndex_ultravioletIndex(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_ULTRAVIOLETINDEX_ULTRAVIOLETINDEX, &value, NULL);
+}
+
+static inline int st_cap_send_valve_valve(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_VALVE_VALVE, &value, NULL);
+}
+
+static inline int st_cap_send_veryFineDustHealthConcern_veryFineDustHealthConcern(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_VERYFINEDUSTHEALTHCONCERN_VERYFINEDUSTHEALTHCONCERN, &value, NULL);
+}
+
+static inline int st_cap_send_veryFineDustSensor_veryFineDustLevel(IOT_CAP_HANDLE *cap_handle, int integer)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_INTEGER;
+	value.integer = integer;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_VERYFINEDUSTSENSOR_VERYFINEDUSTLEVEL, &value, NULL);
+}
+
+static inline int st_cap_send_voltageMeasurement_voltage(IOT_CAP_HANDLE *cap_handle, double number)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_NUMBER;
+	value.number = number;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_VOLTAGEMEASUREMENT_VOLTAGE, &value, NULL);
+}
+
+static inline int st_cap_send_waterSensor_water(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_WATERSENSOR_WATER, &value, NULL);
+}
+
+static inline int st_cap_send_windowShade_windowShade(IOT_CAP_HANDLE *cap_handle, const char *string)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STRING;
+	value.string = (char *)string;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_WINDOWSHADE_WINDOWSHADE, &value, NULL);
+}
+
+static inline int st_cap_send_windowShade_supportedWindowShadeCommands(IOT_CAP_HANDLE *cap_handle, const char **values, uint8_t num)
+{
+	iot_cap_val_t value;
+
+	value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+	value.strings = (char **)values;
+	value.str_num = num;
+
+	return st_cap_send_attr_desc(cap_handle, IOT_CAPS_ATTR_WINDOWSHADE_SUPPORTEDWINDOWSHADECOMMANDS, &value, NULL);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _IOT_CAPS_DESC_H_ */
@@ -20,6 +20,7 @@
 #define ST_DEVICE_SDK_C_JSON_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #define ST_DEVICE_SDK_C_USE_EXTERNAL_JSON_CJSON
 #ifdef ST_DEVICE_SDK_C_USE_EXTERNAL_JSON_CJSON
@@ -118,6 +119,11 @@ static inline void JSON_FREE(void *obj) {
     cJSON_free(obj);
 }
 
+static inline void JSON_INIT_HOOKS(void *(*malloc_fn)(size_t size), void (*free_fn)(void *ptr)) {
+    cJSON_Hooks hooks = { .malloc_fn = malloc_fn, .free_fn = free_fn };
+    cJSON_InitHooks(&hooks);
+}
+
 static inline bool JSON_IS_STRING(const JSON_H * const item) {
     return cJSON_IsString(item);
 }
@@ -175,6 +181,7 @@ JSON_H *JSON_PARSE(const char *value);
 char *JSON_GET_STRING_VALUE(JSON_H *item);
 JSON_H *JSON_CREATE_NUMBER(double num);
 void JSON_FREE(void *obj);
+void JSON_INIT_HOOKS(void *(*malloc_fn)(size_t size), void (*free_fn)(void *ptr));
 bool JSON_IS_STRING(const JSON_H * const item);
 bool JSON_IS_NUMBER(const JSON_H * const item);
 bool JSON_IS_OBJECT(const JSON_H * const item);
@@ -0,0 +1,117 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _IOT_ARENA_H_
+#define _IOT_ARENA_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef CONFIG_STDK_IOT_CORE_CMD_ARENA_SIZE
+#define CONFIG_STDK_IOT_CORE_CMD_ARENA_SIZE	1024
+#endif
+
+#define IOT_ARENA_DEFAULT_SIZE	CONFIG_STDK_IOT_CORE_CMD_ARENA_SIZE
+#define IOT_ARENA_ALIGN		8
+
+typedef struct iot_arena_block iot_arena_block_t;
+
+/**
+ * @brief bump pointer allocator whose allocations are released all at once
+ *
+ * Zero filled arena is ready to use with IOT_ARENA_DEFAULT_SIZE blocks.
+ * It is not thread safe, one transaction uses it at a time.
+ */
+typedef struct {
+	iot_arena_block_t *head;	/**< @brief first block, kept across resets */
+	iot_arena_block_t *curr;	/**< @brief block allocations are taken from */
+	size_t offset;			/**< @brief used bytes of curr */
+	size_t block_size;		/**< @brief size of head block, 0 for default */
+	size_t used;			/**< @brief bytes allocated since last reset */
+	size_t high_water;		/**< @brief largest used of all transactions */
+	unsigned int overflows;		/**< @brief number of extra blocks taken from heap */
+	unsigned int resets;		/**< @brief number of finished transactions */
+} iot_arena_t;
+
+/**
+ * @brief	initialize empty arena, nothing is allocated until first use
+ * @param[in] arena	arena to initialize
+ * @param[in] block_size	size of first block, 0 for IOT_ARENA_DEFAULT_SIZE
+ */
+void iot_arena_init(iot_arena_t *arena, size_t block_size);
+
+/**
+ * @brief	allocate from arena, it is valid until iot_arena_reset()
+ * @param[in] arena	arena to allocate from
+ * @param[in] size	bytes to allocate
+ * @return
+ *	pointer aligned to IOT_ARENA_ALIGN bytes, NULL on failure
+ */
+void *iot_arena_alloc(iot_arena_t *arena, size_t size);
+
+/**
+ * @brief	same as iot_arena_alloc(), but zero filled
+ */
+void *iot_arena_calloc(iot_arena_t *arena, size_t num, size_t size);
+
+/**
+ * @brief	copy string into arena
+ * @return
+ *	copied string, NULL if str is NULL or on failure
+ */
+char *iot_arena_strdup(iot_arena_t *arena, const char *str);
+
+/**
+ * @brief	check whether ptr was allocated from arena
+ */
+bool iot_arena_contains(const iot_arena_t *arena, const void *ptr);
+
+/**
+ * @brief	release every allocation at once to end a transaction
+ *
+ * First block is kept for next transaction, extra blocks are freed.
+ *
+ * @param[in] arena	arena to reset
+ */
+void iot_arena_reset(iot_arena_t *arena);
+
+/**
+ * @brief	free every block of arena, counters are kept
+ */
+void iot_arena_deinit(iot_arena_t *arena);
+
+/**
+ * @brief	let following cJSON allocations of caller thread come from arena
+ *
+ * Only one arena can be hooked at a time. Trees parsed while hooked
+ * must not be deleted, iot_arena_reset() releases them.
+ * It is no-op unless CONFIG_STDK_IOT_CORE_CMD_ARENA_CJSON_HOOKS is set.
+ *
+ * @param[in] arena	arena to allocate cJSON nodes from
+ * @return
+ *	true : hooked, call iot_arena_json_end() after parsing
+ *	false : cJSON keeps using heap
+ */
+bool iot_arena_json_begin(iot_arena_t *arena);
+
+/**
+ * @brief	stop allocating cJSON nodes from arena hooked by iot_arena_json_begin()
+ */
+void iot_arena_json_end(iot_arena_t *arena);
+
+#endif /* _IOT_ARENA_H_ */
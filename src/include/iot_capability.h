@@ -40,6 +40,42 @@ typedef struct {
 	char *string;	/**< @brief NULL-terminated string. */
 } iot_cap_unit_t;
 
+/**
+ * @brief Description of a capability attribute, generated into iot_caps_desc.c.
+ */
+typedef struct iot_caps_attr_desc {
+	const char *capability;		/**< @brief capability id */
+	const char *name;		/**< @brief attribute name */
+	unsigned int property;		/**< @brief ATTR_SET_* bits */
+	unsigned int value_type;	/**< @brief VALUE_TYPE_* */
+	double min;			/**< @brief minimum, if ATTR_SET_VALUE_MIN */
+	double max;			/**< @brief maximum, if ATTR_SET_VALUE_MAX */
+	unsigned int max_length;	/**< @brief maximum string length, if ATTR_SET_MAX_LENGTH */
+	const char *const *values;	/**< @brief allowed string values */
+	unsigned int values_num;	/**< @brief number of values, 0 for any */
+	const char *const *units;	/**< @brief allowed units */
+	unsigned int units_num;		/**< @brief number of units */
+	const char *key;		/**< @brief "capability" and "attribute" members pre-encoded in event format */
+	unsigned int key_len;		/**< @brief the size of key in bytes */
+} iot_caps_attr_desc_t;
+
+/**
+ * @brief Attribute descriptions indexed by IOT_CAPS_ATTR_* ids.
+ */
+extern const iot_caps_attr_desc_t iot_caps_attr_descs[];
+
+/**
+ * @brief Check value and unit of an event against the attribute description.
+ *
+ * @param[in] desc attribute description
+ * @param[in] value value to send
+ * @param[in,out] unit unit to send, NULL is replaced with the only unit of attribute
+ * @retval IOT_ERROR_NONE value and unit are allowed
+ * @retval IOT_ERROR_INVALID_ARGS value type, range, length or unit is not allowed
+ */
+iot_error_t iot_caps_validate_attr(const iot_caps_attr_desc_t *desc,
+		const iot_cap_val_t *value, const char **unit);
+
 /**
  * @brief Contains data for "deviceEvent" payload.
  */
@@ -78,6 +114,12 @@ typedef struct iot_cap_evt_data_t {
 	 *
 	 */
 	iot_cap_attr_option_t options;
+
+	/**
+	 * @brief generated description of attribute, NULL if not known.
+	 *
+	 */
+	const iot_caps_attr_desc_t *desc;
 } iot_cap_evt_data_t;
 
 /**
@@ -146,6 +188,179 @@ struct iot_cap_handle_list {
 	struct iot_cap_handle_list *next;
 };
 
+/**
+ * @brief Contains one slot of command dispatch index
+ *
+ * Key strings are not copied, they refer to the component and capability
+ * of handle and cmd_type of command which are kept since registration.
+ */
+typedef struct iot_cap_cmd_index_entry {
+	uint32_t hash;				/**< @brief hash of (component, capability, command) */
+	struct iot_cap_handle *handle;		/**< @brief capability handle, NULL for empty slot */
+	struct iot_cap_cmd_set *command;	/**< @brief command callback data */
+} iot_cap_cmd_index_entry_t;
+
+/**
+ * @brief Contains open addressing hash table for command dispatch
+ */
+struct iot_cap_cmd_index {
+	iot_cap_cmd_index_entry_t *entries;	/**< @brief linear probing slots */
+	unsigned int capacity;			/**< @brief number of slots, power of 2 */
+	unsigned int count;			/**< @brief number of used slots */
+};
+
+/**
+ * @brief Contains one event queued for batch publishing
+ *
+ * Key is "component\0capability\0attribute" and data is serialized
+ * event object in the format of deviceEvent payload.
+ */
+typedef struct iot_evt_batch_item {
+	struct iot_evt_batch_item *next;	/**< @brief next queued event */
+	uint32_t key_hash;			/**< @brief hash of key */
+	char *key;				/**< @brief identity for coalescing */
+	size_t key_len;				/**< @brief length of key including separators */
+	uint8_t *data;				/**< @brief serialized event */
+	size_t len;				/**< @brief length of serialized event */
+	int seq_num;				/**< @brief sequence number of event */
+} iot_evt_batch_item_t;
+
+/**
+ * @brief Contains queue of events waiting for batch publishing
+ */
+struct iot_evt_batch {
+	iot_os_mutex lock;			/**< @brief protects queue from send calls and window timer */
+	st_event_batch_config config;		/**< @brief batching options */
+	iot_evt_batch_item_t *head;		/**< @brief oldest queued event */
+	iot_evt_batch_item_t *tail;		/**< @brief newest queued event */
+	unsigned int count;			/**< @brief number of queued events */
+	size_t bytes;				/**< @brief total length of queued events */
+	iot_os_timer_handle timer;		/**< @brief batching window timer */
+	bool flush_queued;			/**< @brief flush work is posted already */
+
+	unsigned int published;			/**< @brief number of batched messages published */
+	unsigned int coalesced;			/**< @brief number of events replaced by newer one */
+};
+
+/**
+ * @brief Contains one serialized event waiting for publishing
+ */
+typedef struct iot_evt_encoded {
+	int seq_num;				/**< @brief sequence number of event */
+	uint8_t *data;				/**< @brief serialized event object */
+	size_t len;				/**< @brief length of serialized event */
+} iot_evt_encoded_t;
+
+/**
+ * @brief Contains last sent state of one attribute
+ *
+ * Record is "component\0capability\0attribute\0" key followed by state,
+ * which is value, unit and data of event. Numeric value is kept in number
+ * instead of state to be compared with deadband.
+ * Pending is the latest numeric change held back by min_interval_ms,
+ * it is published when the interval since sent_ms passes.
+ */
+typedef struct iot_attr_cache_entry {
+	uint32_t key_hash;			/**< @brief hash of key */
+	uint8_t *record;			/**< @brief key and state, NULL for empty slot */
+	size_t key_len;				/**< @brief length of key including separators */
+	size_t len;				/**< @brief length of record */
+	bool numeric;				/**< @brief whether number holds value */
+	double number;				/**< @brief numeric value */
+	unsigned int sent_ms;			/**< @brief tick when state was sent */
+	iot_evt_encoded_t pending;		/**< @brief held back event, data is NULL if none */
+	double pending_number;			/**< @brief numeric value of held back event */
+} iot_attr_cache_entry_t;
+
+/**
+ * @brief Result of comparing event with last sent state of its attribute
+ */
+typedef enum {
+	IOT_ATTR_CACHE_SEND,			/**< @brief changed, to be sent now */
+	IOT_ATTR_CACHE_SUPPRESS,		/**< @brief not changed, to be dropped */
+	IOT_ATTR_CACHE_DEFER,			/**< @brief changed within min_interval_ms, to be sent later */
+} iot_attr_cache_verdict_t;
+
+/**
+ * @brief Contains last sent states for suppressing unchanged events
+ *
+ * Cache is used and replaced under evt_lock of context.
+ */
+struct iot_attr_cache {
+	st_attr_cache_config config;		/**< @brief cache options */
+	iot_attr_cache_entry_t *entries;	/**< @brief config.max_entries slots */
+	unsigned int count;			/**< @brief number of used slots */
+	iot_os_timer_handle timer;		/**< @brief min_interval_ms timer for held back events */
+	bool armed;				/**< @brief timer is started for due_ms */
+	unsigned int due_ms;			/**< @brief tick when earliest held back event is due */
+	bool flush_queued;			/**< @brief flush work is posted already */
+
+	unsigned int sent;			/**< @brief number of events passed to publishing */
+	unsigned int suppressed;		/**< @brief number of events dropped as not changed or superseded */
+};
+
+/**
+ * @brief Contains one file holding spilled events
+ */
+typedef struct iot_evt_offline_segment {
+	unsigned int events;			/**< @brief number of events in file */
+	unsigned int replayed;			/**< @brief number of events published already */
+	size_t bytes;				/**< @brief file size */
+} iot_evt_offline_segment_t;
+
+/**
+ * @brief Contains store-and-forward buffer for events raised while offline
+ *
+ * Events live in a RAM ring first. When the ring is full and spilling
+ * is configured, the whole ring is written to a new segment file, so
+ * older events are always in files and newer ones in RAM.
+ * Buffer is used and replaced under evt_lock of context.
+ */
+struct iot_evt_offline {
+	iot_os_mutex lock;			/**< @brief protects buffer from send calls and replay */
+	st_offline_buffer_config config;	/**< @brief buffering options */
+	iot_evt_encoded_t *ring;		/**< @brief RAM ring of max_events slots */
+	unsigned int head;			/**< @brief slot of the oldest event in RAM */
+	unsigned int count;			/**< @brief number of events in RAM */
+	size_t bytes;				/**< @brief size of events in RAM */
+	iot_evt_offline_segment_t *segments;	/**< @brief ring of max_spill_files segments */
+	unsigned int seg_first;			/**< @brief id of the oldest segment file */
+	unsigned int seg_count;			/**< @brief number of segment files */
+	bool replay_queued;			/**< @brief replay work is posted already */
+
+	st_offline_buffer_stats stats;		/**< @brief counters, pending is updated on read */
+};
+
+/**
+ * @brief Run the command handler registered for a command.
+ *
+ * @param[in] cmd_index dispatch index of context, may be NULL
+ * @param[in] cap_handle_list capability handles of context
+ * @param[in] component_name component of command
+ * @param[in] capability_name capability of command
+ * @param[in] command_name command name
+ * @param[in] cmd_data decoded arguments of command
+ * @retval IOT_ERROR_NONE handler is found and called
+ * @retval IOT_ERROR_BAD_REQ there is no handler for command
+ */
+iot_error_t iot_cap_process_cmd(iot_cap_cmd_index_t *cmd_index, iot_cap_handle_list_t *cap_handle_list,
+		char *component_name, char *capability_name, char *command_name, iot_cap_cmd_data_t *cmd_data);
+
+/**
+ * @brief Free what a decoded command keeps out of command arena.
+ *
+ * @param[in] cmd_data command decoded for version 2 handler
+ */
+void iot_cap_free_cmd_data_v2(st_command_data *cmd_data);
+
+/**
+ * @brief Handle a decoded notification and pass it to iot task.
+ *
+ * @param[in] ctx iot-core context
+ * @param[in] noti_data decoded notification
+ */
+void iot_cap_noti_process(struct iot_context *ctx, iot_noti_data_t *noti_data);
+
 /**
  * @brief Contains data for final message handling.
  */
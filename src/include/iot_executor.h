@@ -0,0 +1,132 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _IOT_EXECUTOR_H_
+#define _IOT_EXECUTOR_H_
+
+#include <stdbool.h>
+#include "iot_error.h"
+
+#ifndef CONFIG_STDK_IOT_CORE_GATEWAY_WORKERS
+#define CONFIG_STDK_IOT_CORE_GATEWAY_WORKERS	4
+#endif
+
+#define IOT_EXECUTOR_WORKERS	CONFIG_STDK_IOT_CORE_GATEWAY_WORKERS
+#define IOT_EXECUTOR_TASK_NAME	"iot-executor"
+#define IOT_EXECUTOR_POLLER_NAME	"iot-poller"
+
+struct iot_context;
+
+/**
+ * @brief socket registered to shared poller
+ */
+typedef struct iot_executor_watch iot_executor_watch_t;
+
+#define IOT_EXECUTOR_WAIT_READ	(1 << 0)
+#define IOT_EXECUTOR_WAIT_WRITE	(1 << 1)
+
+/**
+ * @brief	called on poller thread when watched socket gets ready or is woken up
+ * @param[in] arg	user argument given to iot_executor_watch_socket()
+ * @return
+ *	IOT_EXECUTOR_WAIT_READ and/or IOT_EXECUTOR_WAIT_WRITE : what to wait next
+ *	0 : stop watching until socket is woken up or unwatched
+ */
+typedef int (*iot_executor_ready_cb)(void *arg);
+
+/**
+ * @brief Contains counters of shared executor
+ */
+typedef struct {
+	unsigned int contexts;		/**< @brief number of attached contexts */
+	unsigned int threads;		/**< @brief number of worker and poller threads */
+	unsigned int sockets;		/**< @brief number of watched sockets */
+	unsigned int runs;		/**< @brief number of context runs by workers */
+} iot_executor_stats_t;
+
+/**
+ * @brief	run works of context on shared worker threads
+ *
+ * Works of one context never run concurrently and keep their queueing order,
+ * the same as they did on a work queue thread of its own.
+ * Shared threads are started on the first attach.
+ *
+ * @param[in] ctx	context whose work_queue is already created
+ * @return
+ *	IOT_ERROR_NONE : success
+ */
+iot_error_t iot_executor_attach(struct iot_context *ctx);
+
+/**
+ * @brief	stop running works of context on shared worker threads
+ *
+ * Works still queued are left in work_queue. It waits for the run of context
+ * in progress, so it must not be called from a work of the same context.
+ * Nothing may queue works to context while it is detached.
+ *
+ * @param[in] ctx	context attached by iot_executor_attach()
+ */
+void iot_executor_detach(struct iot_context *ctx);
+
+/**
+ * @brief	watch socket on shared poller thread
+ * @param[in] fd	socket to watch, readability is waited first
+ * @param[in] cb	function called each time socket gets ready
+ * @param[in] arg	user argument passed to cb
+ * @return
+ *	watch handle, NULL on failure
+ */
+iot_executor_watch_t *iot_executor_watch_socket(int fd, iot_executor_ready_cb cb, void *arg);
+
+/**
+ * @brief	run cb of watch on poller thread soon, regardless of socket readiness
+ *
+ * It can be called from any thread, wake-ups requested before cb runs are merged.
+ *
+ * @param[in] watch	handle returned by iot_executor_watch_socket()
+ */
+void iot_executor_wake_socket(iot_executor_watch_t *watch);
+
+/**
+ * @brief	stop watching socket, must be called before socket is closed
+ *
+ * It never blocks, cb may still be running for this watch on poller thread
+ * when it returns. Use iot_executor_is_running() to wait for it.
+ *
+ * @param[in] watch	handle returned by iot_executor_watch_socket()
+ */
+void iot_executor_unwatch_socket(iot_executor_watch_t *watch);
+
+/**
+ * @brief	check whether poller thread is running a callback for arg
+ * @param[in] arg	user argument given to iot_executor_watch_socket()
+ */
+bool iot_executor_is_running(void *arg);
+
+/**
+ * @brief	check whether caller runs on one of shared worker threads
+ */
+bool iot_executor_is_worker(void);
+
+/**
+ * @brief	get counters of shared executor
+ * @param[out] stats	current counters
+ */
+void iot_executor_get_stats(iot_executor_stats_t *stats);
+
+#endif /* _IOT_EXECUTOR_H_ */
@@ -309,6 +309,23 @@ void iot_cap_sub_cb(iot_cap_handle_list_t *cap_handle_list, char *payload);
  */
 void iot_cap_commands_cb(struct iot_context *ctx, char *payload);
 
+/**
+ * @brief	dispatch mqtt command msg to every command handler
+ * @details	this function parses command message once and hands the parsed
+ *		commands to both per-capability callbacks and notification callback
+ * @param[in]	ctx		iot-core context
+ * @param[in]	payload			received raw message from server
+ */
+void iot_cap_dispatch_commands(struct iot_context *ctx, char *payload);
+
+/**
+ * @brief	get command message statistics of context
+ * @param[in]	ctx		iot-core context
+ * @param[out]	dispatched	number of command messages passed to iot_cap_dispatch_commands()
+ * @param[out]	parsed		number of command payload parses
+ */
+void iot_cap_get_command_stats(struct iot_context *ctx, unsigned int *dispatched, unsigned int *parsed);
+
 /**
  * @brief	callback for mqtt noti msg
  * @details	this function is used to handle notification message from server
@@ -317,6 +334,28 @@ void iot_cap_commands_cb(struct iot_context *ctx, char *payload);
  */
 void iot_noti_sub_cb(struct iot_context *ctx, char *payload);
 
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+/**
+ * @brief	dispatch cbor mqtt command msg to every command handler
+ * @details	same as iot_cap_dispatch_commands(), but commands are decoded
+ *		from cbor directly without converting it to json
+ * @param[in]	ctx		iot-core context
+ * @param[in]	payload			received raw cbor message from server
+ * @param[in]	len			the size of payload in bytes
+ */
+void iot_cap_dispatch_commands_cbor(struct iot_context *ctx, uint8_t *payload, size_t len);
+
+/**
+ * @brief	callback for cbor mqtt noti msg
+ * @details	same as iot_noti_sub_cb(), but notification is decoded
+ *		from cbor directly without converting it to json
+ * @param[in]	ctx		iot-core context
+ * @param[in]	payload		received raw cbor message from server
+ * @param[in]	len		the size of payload in bytes
+ */
+void iot_noti_sub_cb_cbor(struct iot_context *ctx, uint8_t *payload, size_t len);
+#endif
+
 /**
  * @brief	call init callback
  * @details	this function is used to call all allocated capability callbacks when target is connected
@@ -324,6 +363,14 @@ void iot_noti_sub_cb(struct iot_context *ctx, char *payload);
  */
 void iot_cap_call_init_cb(iot_cap_handle_list_t *cap_handle_list);
 
+/**
+ * @brief	publish events buffered while offline
+ * @details	this function is used to replay buffered events in order when target is connected
+ *		or rate limit is over
+ * @param[in]	ctx		iot-core context
+ */
+void iot_cap_replay_offline_events(struct iot_context *ctx);
+
 /* For universal purpose */
 /**
  * @brief	get time data by sec
@@ -26,6 +26,8 @@
 #include "iot_mqtt.h"
 #include "security/iot_security_crypto.h"
 #include "iot_util.h"
+#include "iot_wt.h"
+#include "iot_arena.h"
 
 #define IOT_WIFI_PROV_SSID_STR_LEN		(32)
 #define IOT_WIFI_PROV_PASSWORD_STR_LEN 	(64)
@@ -42,6 +44,7 @@
 #define DEVICE_PENDING_WORK_SIGNAL	(1 << 0)
 #define DEVICE_WORK_QUEUE_KILL_SIGNAL	(1 << 1)
 #define DEVICE_WORK_QUEUE_TASK_SIGNAL_ALL	(DEVICE_PENDING_WORK_SIGNAL | DEVICE_WORK_QUEUE_KILL_SIGNAL)
+#define DEVICE_WORK_QUEUE_BATCH	4
 
 #define IOT_USR_INTERACT_BIT_CMD_DONE		(1u << 4u)
 
@@ -289,6 +292,10 @@ struct iot_state_data {
  * @brief Contains "iot core's main state" data
  */
 typedef struct iot_cap_handle_list iot_cap_handle_list_t;
+typedef struct iot_cap_cmd_index iot_cap_cmd_index_t;
+typedef struct iot_evt_batch iot_evt_batch_t;
+typedef struct iot_evt_offline iot_evt_offline_t;
+typedef struct iot_attr_cache iot_attr_cache_t;
 
 #define IOT_ST_ECODE_STR_LEN	(6)
 
@@ -320,6 +327,13 @@ struct iot_context {
 	iot_os_eventgroup *iot_events;		/**< @brief Internal handling events */
 
 	iot_cap_handle_list_t *cap_handle_list;		/**< @brief allocated capability handle lists */
+	iot_cap_cmd_index_t *cap_cmd_index;		/**< @brief (component, capability, command) dispatch index */
+	iot_evt_batch_t *evt_batch;			/**< @brief events waiting for batch publishing, NULL if disabled */
+	iot_evt_offline_t *evt_offline;			/**< @brief events raised while offline, NULL if disabled */
+	iot_attr_cache_t *attr_cache;			/**< @brief last sent state of attributes, NULL if disabled */
+	iot_arena_t cmd_arena;				/**< @brief allocations for one received command message */
+	unsigned int cmd_dispatched;			/**< @brief number of command messages dispatched */
+	unsigned int cmd_parsed;			/**< @brief number of command payload parses */
 
 	st_mqtt_client evt_mqttcli;			/**< @brief SmartThings MQTT Client for event & commands */
 	gg_connection_request_status sign_in_connection_request_status;	/**< @brief Sign-in connection request status */
@@ -329,6 +343,9 @@ struct iot_context {
 	gg_connection_request_status sign_up_connection_request_status;	/**< @brief Sign-up connection request status */
 	char *mqtt_event_topic;				/**< @brief mqtt topic for event publish */
 	char *mqtt_health_topic;				/**< @brief mqtt topic for health publish */
+	char *root_cert;					/**< @brief root CA certificate read from NV, kept for reconnects */
+	size_t root_cert_len;				/**< @brief length of root_cert */
+	iot_wt_cache_t wt_cache;			/**< @brief signed web token kept for reconnects */
 
 	struct iot_device_prov_data prov_data;	/**< @brief allocated device provisioning data */
 	struct iot_devconf_prov_data devconf;	/**< @brief allocated device configuration data */
@@ -357,7 +374,10 @@ struct iot_context {
 	iot_os_thread work_queue_thread; /**< @brief iot main work queue thread */
 	iot_os_eventgroup *work_queue_signal; /**< @brief work queue thread signal */
 	iot_util_queue_t *work_queue;	/**< @brief work task queue */
+	int work_scheduled;		/**< @brief whether context waits in shared executor, for gateway mode */
+	int work_refs;			/**< @brief number of shared executor references to context, for gateway mode */
 	iot_os_mutex st_conn_lock; /**< @brief User level control API lock */
+	iot_os_mutex evt_lock;	/**< @brief protects evt_batch from being replaced while in use */
 
 	bool add_justworks; 	/**< @brief to skip user-confirm using JUSTWORKS bit */
 
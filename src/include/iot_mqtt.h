@@ -96,6 +96,39 @@ typedef enum {
 	ST_MQTT_EVENT_DISCONNECTED = 4,
 } st_mqtt_event;
 
+typedef struct st_mqtt_chunk_pool_stats {
+	unsigned int header_hits;		/**< @brief packet chunk headers served from preallocated slab */
+	unsigned int header_misses;		/**< @brief packet chunk headers that fell back to heap */
+	unsigned int data_hits;			/**< @brief packet payloads served from preallocated slabs */
+	unsigned int data_misses;		/**< @brief packet payloads that fell back to heap */
+	unsigned int in_use;			/**< @brief packet chunks currently alive */
+	unsigned int high_water;		/**< @brief peak number of packet chunks alive at once */
+	unsigned int data_in_use;		/**< @brief packet payloads currently alive */
+	unsigned int data_high_water;	/**< @brief peak number of packet payloads alive at once */
+} st_mqtt_chunk_pool_stats;
+
+typedef struct st_mqtt_read_stats {
+	unsigned int packets;			/**< @brief received packets */
+	unsigned int packets_in_place;	/**< @brief received packets delivered from receive buffer without copy */
+	unsigned int bytes_copied;		/**< @brief total bytes copied after network read */
+	unsigned int last_bytes_copied;	/**< @brief bytes copied for the last received packet */
+} st_mqtt_read_stats;
+
+typedef struct st_mqtt_write_stats {
+	unsigned int packets;			/**< @brief sent packets */
+	unsigned int records;			/**< @brief completed writes of coalesced packets, one TLS record each */
+	unsigned int writes;			/**< @brief write calls to network port */
+	unsigned int bytes;				/**< @brief total bytes sent */
+} st_mqtt_write_stats;
+
+typedef struct st_mqtt_connect_stats {
+	unsigned int dns_ms;			/**< @brief time spent resolving broker address */
+	unsigned int tcp_ms;			/**< @brief time spent establishing TCP connection */
+	unsigned int handshake_ms;		/**< @brief time spent in TLS handshake */
+	unsigned int connack_ms;		/**< @brief time from queueing CONNECT to receiving CONNACK */
+	unsigned int session_offered;	/**< @brief TLS session of previous connection was offered for resumption */
+} st_mqtt_connect_stats;
+
 typedef void (*st_mqtt_event_callback)(st_mqtt_event event, void *event_data, void *usr_data);
 
 enum {
@@ -184,6 +217,35 @@ DLLExport int st_mqtt_unsubscribe(st_mqtt_client client, int count, char* topics
  */
 DLLExport int st_mqtt_disconnect(st_mqtt_client client);
 
+/** MQTT Chunk pool stats - get packet chunk allocator counters
+ *  @param client - the client object to use
+ *  @param stats - counters copied from the client's chunk pool
+ *  @return success code
+ */
+DLLExport int st_mqtt_get_chunk_pool_stats(st_mqtt_client client, st_mqtt_chunk_pool_stats *stats);
+
+/** Get receive path statistics of an MQTT client
+ *  @param client - the client object to use
+ *  @param stats - counters copied from the client's buffered reader
+ *  @return success code
+ */
+DLLExport int st_mqtt_get_read_stats(st_mqtt_client client, st_mqtt_read_stats *stats);
+
+/** Get send path statistics of an MQTT client
+ *  Packets per record and bytes per write tell how well queued packets are coalesced.
+ *  @param client - the client object to use
+ *  @param stats - counters of the client's write stream
+ *  @return success code
+ */
+DLLExport int st_mqtt_get_write_stats(st_mqtt_client client, st_mqtt_write_stats *stats);
+
+/** Get time spent in each phase of the last connection of an MQTT client
+ *  @param client - the client object to use
+ *  @param stats - phase times of the last st_mqtt_connect()
+ *  @return success code
+ */
+DLLExport int st_mqtt_get_connect_stats(st_mqtt_client client, st_mqtt_connect_stats *stats);
+
 /** Destroy an MQTT client object
  *  @param client - the client object to destroy
  *  @return success code
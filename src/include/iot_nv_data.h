@@ -95,6 +95,29 @@ iot_error_t iot_nv_init(unsigned char *device_info, size_t device_info_len);
  */
 iot_error_t iot_nv_deinit();
 
+/**
+ * @brief Start a batch of nv accesses.
+ *
+ * @details The storage backend is set up once here and kept for every nv access
+ * until the matching iot_nv_commit(), instead of being set up and torn down
+ * for each access. Batches can be nested and can be opened from several threads.
+ * @retval IOT_ERROR_NONE Batch started successful.
+ * @retval IOT_ERROR_NV_DATA_ERROR nv is not initialized or storage init failed.
+ *
+ * @see iot_nv_commit
+ */
+iot_error_t iot_nv_begin(void);
+
+/**
+ * @brief Finish a batch of nv accesses started by iot_nv_begin().
+ *
+ * @details When the last batch finishes, data written during the batches is
+ * written back to the storage and the storage backend is torn down.
+ * @retval IOT_ERROR_NONE Batch finished successful.
+ * @retval IOT_ERROR_NV_DATA_ERROR nv is not initialized or write back failed.
+ */
+iot_error_t iot_nv_commit(void);
+
 /**
  * @brief Check provisioning data existence in the nv file-system.
  *
@@ -19,7 +19,14 @@
 #ifndef _IOT_SERIALIZE_H_
 #define _IOT_SERIALIZE_H_
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+#include <cbor.h>
+#endif
 #include "JSON.h"
+#include "iot_error.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,6 +36,38 @@ extern "C" {
 /* In case of nano newlib, it doesn't support float printf,sprintf family */
 #define IOT_SERIALIZE_SPRINTF_FLOAT	0
 #define IOT_SERIALIZE_DECIMAL_PRECISION	1000000
+#define IOT_SERIALIZE_WRITER_MAX_DEPTH	16
+
+typedef enum {
+	IOT_SERIALIZE_FORMAT_JSON,
+	IOT_SERIALIZE_FORMAT_CBOR,
+} iot_serialize_format_t;
+
+/**
+ * @brief Contains streaming serializer state
+ *
+ * Values are written straight into a caller provided buffer, without building
+ * a JSON tree. Output is byte-identical to JSON_PRINT() or
+ * iot_serialize_json2cbor() of the equivalent tree. Once the buffer is full,
+ * writing goes on counting the required size so that caller can retry with
+ * a big enough buffer. Errors are sticky and reported by
+ * iot_serialize_writer_finish().
+ */
+typedef struct iot_serialize_writer {
+	iot_serialize_format_t format;
+	uint8_t *buf;			/**< @brief output buffer */
+	size_t size;			/**< @brief size of output buffer */
+	size_t len;			/**< @brief JSON bytes written or required so far */
+	unsigned int depth;		/**< @brief number of open containers */
+	unsigned int has_item;		/**< @brief JSON, bit per depth : container has an item already */
+	unsigned int is_array;		/**< @brief JSON, bit per depth : container is an array */
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	CborEncoder enc[IOT_SERIALIZE_WRITER_MAX_DEPTH + 1];	/**< @brief CBOR, encoder per depth */
+	uint8_t *head[IOT_SERIALIZE_WRITER_MAX_DEPTH + 1];	/**< @brief CBOR, head of open container per depth, NULL if out of buffer */
+	uint32_t items[IOT_SERIALIZE_WRITER_MAX_DEPTH + 1];	/**< @brief CBOR, number of items written per depth */
+#endif
+	iot_error_t err;		/**< @brief first error occurred */
+} iot_serialize_writer_t;
 
 /**
  * @brief	Convert cbor payload to json payload
@@ -45,6 +84,22 @@ extern "C" {
  */
 iot_error_t iot_serialize_cbor2json(uint8_t *cbor, size_t cborlen, char **json, size_t *jsonlen);
 
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+/**
+ * @brief	Convert one cbor value to json text
+ * Output is sized by a counting pass first, so it is allocated once in exact size.
+ * @param[in,out]	value	cbor value to convert, advanced to the next value on success
+ * @param[out]	json	a pointer to a null terminated json text, must be freed with free()
+ * @param[out]	jsonlen	the length of json text in bytes
+ * @return	iot_state_t
+ * @retval	IOT_ERROR_NONE		cbor successfully converted to json
+ * @retval	IOT_ERROR_INVALID_ARG	there is something wrong with the inputs
+ * @retval	IOT_ERROR_MEM_ALLOC	failed to alloc buffer to store json
+ * @retval	IOT_ERROR_CBOR_TO_JSON	failed to write payload with json
+ */
+iot_error_t iot_serialize_cbor_value_to_json(CborValue *value, char **json, size_t *jsonlen);
+
+#endif
 /**
  * @brief	Convert json structure to cbor payload
  * @param[in]	json	a node to a json strucure
@@ -57,6 +112,116 @@ iot_error_t iot_serialize_cbor2json(uint8_t *cbor, size_t cborlen, char **json,
  */
 iot_error_t iot_serialize_json2cbor(JSON_H *json, uint8_t **cbor, size_t *cborlen);
 
+/**
+ * @brief	Initialize streaming serializer
+ * @param[in]	writer	writer to initialize
+ * @param[in]	format	output format
+ * @param[in]	buf	output buffer, can be NULL to measure required size only
+ * @param[in]	size	the size of output buffer in bytes
+ */
+void iot_serialize_writer_init(iot_serialize_writer_t *writer, iot_serialize_format_t format,
+		uint8_t *buf, size_t size);
+
+/**
+ * @brief	Open an object
+ * @param[in]	writer	writer to write to
+ * @param[in]	key	member name inside of an object, NULL at top level or inside of an array
+ */
+void iot_serialize_writer_open_object(iot_serialize_writer_t *writer, const char *key);
+
+/**
+ * @brief	Open an array
+ * @param[in]	writer	writer to write to
+ * @param[in]	key	member name inside of an object, NULL at top level or inside of an array
+ */
+void iot_serialize_writer_open_array(iot_serialize_writer_t *writer, const char *key);
+
+/**
+ * @brief	Close the last opened object or array
+ * @param[in]	writer	writer to write to
+ */
+void iot_serialize_writer_close(iot_serialize_writer_t *writer);
+
+/**
+ * @brief	Write a string value
+ * Like JSON_ADD_STRING_TO_OBJECT(), nothing is written for NULL string.
+ * @param[in]	writer	writer to write to
+ * @param[in]	key	member name inside of an object, NULL inside of an array
+ * @param[in]	string	string value
+ */
+void iot_serialize_writer_add_string(iot_serialize_writer_t *writer, const char *key, const char *string);
+
+/**
+ * @brief	Write a number value
+ * @param[in]	writer	writer to write to
+ * @param[in]	key	member name inside of an object, NULL inside of an array
+ * @param[in]	number	number value
+ */
+void iot_serialize_writer_add_number(iot_serialize_writer_t *writer, const char *key, double number);
+
+/**
+ * @brief	Write a boolean value
+ * @param[in]	writer	writer to write to
+ * @param[in]	key	member name inside of an object, NULL inside of an array
+ * @param[in]	boolean	boolean value
+ */
+void iot_serialize_writer_add_bool(iot_serialize_writer_t *writer, const char *key, bool boolean);
+
+/**
+ * @brief	Write an array of strings
+ * Like JSON_CREATE_STRING_ARRAY(), nothing is written if any string is NULL.
+ * @param[in]	writer	writer to write to
+ * @param[in]	key	member name inside of an object, NULL inside of an array
+ * @param[in]	strings	string values
+ * @param[in]	count	number of strings
+ */
+void iot_serialize_writer_add_string_array(iot_serialize_writer_t *writer, const char *key,
+		const char **strings, int count);
+
+/**
+ * @brief	Write a value given as JSON text
+ * The text is re-serialized as JSON_PARSE() followed by JSON_PRINT() would.
+ * Like adding a NULL item, nothing is written if the text can't be parsed.
+ * @param[in]	writer	writer to write to
+ * @param[in]	key	member name inside of an object, NULL inside of an array
+ * @param[in]	json	JSON text
+ */
+void iot_serialize_writer_add_raw_json(iot_serialize_writer_t *writer, const char *key, const char *json);
+
+/**
+ * @brief	Write a value serialized already by another writer of the same format
+ * @param[in]	writer	writer to write to
+ * @param[in]	key	member name inside of an object, NULL inside of an array
+ * @param[in]	data	output of iot_serialize_writer_finish() holding one value
+ * @param[in]	len	the size of data in bytes
+ */
+void iot_serialize_writer_add_encoded(iot_serialize_writer_t *writer, const char *key,
+		const uint8_t *data, size_t len);
+
+/**
+ * @brief	Write object members serialized already in the format of writer
+ *
+ * Keys and values are not checked, data is copied as it is.
+ * @param[in]	writer	writer to write to
+ * @param[in]	data	members without separator at either end, like "a":1,"b":2 for JSON
+ * @param[in]	len	the size of data in bytes
+ * @param[in]	count	the number of members in data
+ */
+void iot_serialize_writer_add_members(iot_serialize_writer_t *writer,
+		const char *data, size_t len, unsigned int count);
+
+/**
+ * @brief	Finish writing and terminate output with a null byte
+ * @param[in]	writer	writer to finish
+ * @param[out]	len	the size of output in bytes, without null termination
+ * @param[out]	needed	buffer size required for whole output with null termination
+ * @return	iot_error_t
+ * @retval	IOT_ERROR_NONE		output is complete in buffer
+ * @retval	IOT_ERROR_MEM_ALLOC	buffer is too small, retry with needed bytes
+ * @retval	IOT_ERROR_BAD_REQ	failed to serialize
+ */
+iot_error_t iot_serialize_writer_finish(iot_serialize_writer_t *writer, size_t *len, size_t *needed);
+
 #ifdef __cplusplus
 }
 #endif
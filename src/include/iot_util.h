@@ -61,6 +61,26 @@ typedef struct iot_util_queue_data {
 	struct iot_util_queue_data *next;
 } iot_util_queue_data_t;
 
+#define IOT_UTIL_CACHE_LINE_SIZE	64
+
+/**
+ * @brief fixed capacity ring of iot_util_queue
+ *
+ * Producers and consumers claim slots with atomic compare-and-swap on
+ * enqueue_pos/dequeue_pos, and each slot's sequence tells whether it is
+ * free or holds an item of the current lap. Positions are kept on their
+ * own cache lines so producers and the consumer don't share one.
+ */
+typedef struct iot_util_queue_ring {
+	size_t enqueue_pos;	/**< @brief next position to be written by producers */
+	char pad0[IOT_UTIL_CACHE_LINE_SIZE - sizeof(size_t)];
+	size_t dequeue_pos;	/**< @brief next position to be read by consumers */
+	char pad1[IOT_UTIL_CACHE_LINE_SIZE - sizeof(size_t)];
+	size_t mask;		/**< @brief capacity - 1, capacity is power of 2 */
+	size_t slot_size;	/**< @brief sequence, removed mark and item size in bytes, aligned */
+	unsigned char *slots;	/**< @brief capacity slots following this struct */
+} iot_util_queue_ring_t;
+
 /**
  * @brief internal queue struct
  */
@@ -69,6 +89,9 @@ typedef struct {
 	size_t item_size;
 	struct iot_util_queue_data *head;
 	struct iot_util_queue_data *tail;
+	iot_util_queue_ring_t *ring;	/**< @brief fixed capacity ring, NULL for linked queue */
+	void (*notify)(void *arg);	/**< @brief called after each item is sent, NULL if not used */
+	void *notify_arg;		/**< @brief user argument of notify */
 } iot_util_queue_t;
 
 /**
@@ -85,6 +108,23 @@ typedef struct {
  */
 iot_util_queue_t* iot_util_queue_create(size_t item_size);
 
+/**
+ * @brief	create queue on fixed capacity ring
+ *
+ * This function create queue which never allocates memory after creation.
+ * Items are sent and received without lock, so it can be shared by
+ * several producers. Send fails when the ring is full.
+ *
+ * @param[in] item_size	size of queue data item
+ * @param[in] capacity	maximum number of items, rounded up to power of 2
+ *
+ * @return
+ *	return is queue struct pointer.
+ *	If queue was not created, NULL is returned.
+ *
+ */
+iot_util_queue_t* iot_util_queue_create_ring(size_t item_size, size_t capacity);
+
 /**
  * @brief	delete queue
  *
@@ -121,6 +161,57 @@ iot_error_t iot_util_queue_send(iot_util_queue_t* queue, void * data);
  */
 iot_error_t iot_util_queue_receive(iot_util_queue_t* queue, void * data);
 
+/**
+ * @brief	receive several messages from the front of queue at once.
+ *
+ * @param[in] queue	pointer of queue to receive items
+ * @param[out] data	buffer for max_items items received from queue
+ * @param[in] max_items	maximum number of items to receive
+ *
+ * @return	number of items received, 0 if queue is empty
+ *
+ */
+size_t iot_util_queue_receive_batch(iot_util_queue_t* queue, void * data, size_t max_items);
+
+/**
+ * @brief	remove every item matched from queue.
+ *
+ * On a ring queue matched items are marked in place and skipped by the
+ * receivers, so it can run while items are sent and received. Their slots
+ * are freed by the next receive.
+ *
+ * @param[in] queue	pointer of queue to remove items from
+ * @param[in] match	function returns true for item to be removed
+ * @param[in] arg	user argument passed to match
+ *
+ */
+void iot_util_queue_remove_if(iot_util_queue_t* queue,
+		bool (*match)(void *item, void *arg), void *arg);
+
+/**
+ * @brief	check whether queue has no item.
+ *
+ * @param[in] queue	pointer of queue to check
+ *
+ * @return	true if queue is empty
+ *
+ */
+bool iot_util_queue_is_empty(iot_util_queue_t* queue);
+
+/**
+ * @brief	set function to be called whenever an item is sent to queue.
+ *
+ * It's called on the sender's thread after the item is queued, so consumer
+ * can be scheduled without waiting on a signal of its own.
+ *
+ * @param[in] queue	pointer of queue to watch
+ * @param[in] notify	function to call, NULL to stop notification
+ * @param[in] arg	user argument passed to notify
+ *
+ */
+void iot_util_queue_set_notify(iot_util_queue_t* queue,
+		void (*notify)(void *arg), void *arg);
+
 /**
  * @brief	generate retry back time.
  *
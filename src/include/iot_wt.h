@@ -25,6 +25,10 @@
 extern "C" {
 #endif
 
+#ifndef CONFIG_STDK_IOT_CORE_WEBTOKEN_REUSE_SEC
+#define CONFIG_STDK_IOT_CORE_WEBTOKEN_REUSE_SEC	600
+#endif
+
 /**
  * @brief Contains information for JWT/CWT creation
  */
@@ -38,6 +42,15 @@ typedef struct iot_wt_params {
 	char *cert_sn;		/**< @brief device certification serial number */
 } iot_wt_params_t;
 
+/**
+ * @brief Keeps a signed Web Token to pass again on reconnects
+ */
+typedef struct iot_wt_cache {
+	iot_security_buffer_t token;	/**< @brief signed token, token.p is NULL if nothing is kept */
+	long issued_at;			/**< @brief time in seconds the token was signed at */
+	char *params;			/**< @brief wt_params the token was made of */
+} iot_wt_cache_t;
+
 /**
  * @brief	Create a Web Token as proof of the device's identity
  * @details	This function makes a Web Token string to connect to ST Cloud.
@@ -51,6 +64,27 @@ typedef struct iot_wt_params {
  */
 iot_error_t iot_wt_create(const iot_wt_params_t *wt_params, iot_security_buffer_t *token_buf);
 
+/**
+ * @brief	Get a Web Token kept in cache or create a new one
+ * @details	The kept token is reused while it is younger than
+ *		CONFIG_STDK_IOT_CORE_WEBTOKEN_REUSE_SEC and wt_params are the same
+ *		as it was made of. Otherwise a new token is signed and kept instead.
+ * @param[in]	cache	a pointer of token cache
+ * @param[in]	wt_params a set of information parameters used for making Web Token
+ * @param[out]	token_buf a pointer of buffer to store a copy of token, caller frees it
+ * @retval	IOT_ERROR_NONE		Web Token is sucessfully got
+ * @retval	IOT_ERROR_MEM_ALLOC	no more available heap memory
+ * @retval	IOT_ERROR_WEBTOKEN_FAIL	failed to make json
+ */
+iot_error_t iot_wt_create_cached(iot_wt_cache_t *cache, const iot_wt_params_t *wt_params,
+		iot_security_buffer_t *token_buf);
+
+/**
+ * @brief	Drop a Web Token kept in cache, the next one is signed again
+ * @param[in]	cache	a pointer of token cache
+ */
+void iot_wt_cache_clear(iot_wt_cache_t *cache);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,161 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _IOT_MQTT_CHUNK_POOL_H_
+#define _IOT_MQTT_CHUNK_POOL_H_
+
+#include <stddef.h>
+#include "iot_os_util.h"
+
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL)
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_HEADER_COUNT
+#define CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_HEADER_COUNT	16
+#endif
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_SMALL_SIZE
+#define CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_SMALL_SIZE		64
+#endif
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_SMALL_COUNT
+#define CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_SMALL_COUNT	8
+#endif
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_MEDIUM_SIZE
+#define CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_MEDIUM_SIZE	256
+#endif
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_MEDIUM_COUNT
+#define CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_MEDIUM_COUNT	4
+#endif
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_LARGE_SIZE
+#define CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_LARGE_SIZE		1024
+#endif
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_LARGE_COUNT
+#define CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_LARGE_COUNT	2
+#endif
+
+#define IOT_MQTT_CHUNK_POOL_HEADER_COUNT	CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_HEADER_COUNT
+#define IOT_MQTT_CHUNK_POOL_SMALL_SIZE		CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_SMALL_SIZE
+#define IOT_MQTT_CHUNK_POOL_SMALL_COUNT		CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_SMALL_COUNT
+#define IOT_MQTT_CHUNK_POOL_MEDIUM_SIZE		CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_MEDIUM_SIZE
+#define IOT_MQTT_CHUNK_POOL_MEDIUM_COUNT	CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_MEDIUM_COUNT
+#define IOT_MQTT_CHUNK_POOL_LARGE_SIZE		CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_LARGE_SIZE
+#define IOT_MQTT_CHUNK_POOL_LARGE_COUNT		CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL_LARGE_COUNT
+#else
+/* Pool disabled : every request falls back to the heap */
+#define IOT_MQTT_CHUNK_POOL_HEADER_COUNT	0
+#define IOT_MQTT_CHUNK_POOL_SMALL_SIZE		0
+#define IOT_MQTT_CHUNK_POOL_SMALL_COUNT		0
+#define IOT_MQTT_CHUNK_POOL_MEDIUM_SIZE		0
+#define IOT_MQTT_CHUNK_POOL_MEDIUM_COUNT	0
+#define IOT_MQTT_CHUNK_POOL_LARGE_SIZE		0
+#define IOT_MQTT_CHUNK_POOL_LARGE_COUNT		0
+#endif
+
+enum iot_mqtt_chunk_pool_class {
+	IOT_MQTT_CHUNK_POOL_CLASS_SMALL,
+	IOT_MQTT_CHUNK_POOL_CLASS_MEDIUM,
+	IOT_MQTT_CHUNK_POOL_CLASS_LARGE,
+	IOT_MQTT_CHUNK_POOL_CLASS_MAX,
+};
+
+struct iot_mqtt_packet_chunk;
+
+/**
+ * @brief Contains a fixed size block slab
+ */
+typedef struct iot_mqtt_chunk_slab {
+	unsigned char *base;		/**< @brief start of contiguous slab memory */
+	size_t block_size;		/**< @brief size of each block in bytes */
+	unsigned int block_count;	/**< @brief number of blocks in slab */
+	void *free_list;		/**< @brief singly linked list of free blocks */
+} iot_mqtt_chunk_slab_t;
+
+/**
+ * @brief Contains per-client packet chunk pool
+ *
+ * Pool is referenced by its client and by every chunk header allocated from
+ * it, so chunks still owned by a caller when the client is destroyed can be
+ * released later. The last reference frees the pool.
+ */
+typedef struct iot_mqtt_chunk_pool {
+	iot_os_mutex lock;
+	iot_mqtt_chunk_slab_t header_slab;				/**< @brief slab for iot_mqtt_packet_chunk_t */
+	iot_mqtt_chunk_slab_t data_slab[IOT_MQTT_CHUNK_POOL_CLASS_MAX];	/**< @brief size-classed payload slabs */
+	unsigned int refs;		/**< @brief client reference plus one per live chunk header */
+
+	unsigned int header_hits;	/**< @brief header allocations served from slab */
+	unsigned int header_misses;	/**< @brief header allocations that fell back to heap */
+	unsigned int data_hits;		/**< @brief payload allocations served from slabs */
+	unsigned int data_misses;	/**< @brief payload allocations that fell back to heap */
+	unsigned int in_use;		/**< @brief chunk headers currently alive */
+	unsigned int high_water;	/**< @brief peak value of in_use */
+	unsigned int data_in_use;	/**< @brief payload buffers currently alive */
+	unsigned int data_high_water;	/**< @brief peak value of data_in_use */
+} iot_mqtt_chunk_pool_t;
+
+/**
+ * @brief	create chunk pool
+ * This function preallocates slabs according to the configured classes.
+ * Returned pool holds one reference for the caller.
+ * @return
+ *	chunk pool : success
+ *	NULL : fail
+ */
+iot_mqtt_chunk_pool_t *iot_mqtt_chunk_pool_create(void);
+
+/**
+ * @brief	drop the caller reference of chunk pool
+ * Pool and its slabs are freed when no chunk header is alive anymore,
+ * otherwise the last iot_mqtt_chunk_pool_free_header() frees them.
+ * @param[in] pool	pool to release, may be NULL
+ */
+void iot_mqtt_chunk_pool_release(iot_mqtt_chunk_pool_t *pool);
+
+/**
+ * @brief	get a zeroed chunk header from pool or heap
+ * Each header takes a reference of pool until it is freed.
+ * @param[in] pool	pool to allocate from, NULL allocates from heap
+ * @return
+ *	chunk header : success
+ *	NULL : fail
+ */
+struct iot_mqtt_packet_chunk *iot_mqtt_chunk_pool_alloc_header(iot_mqtt_chunk_pool_t *pool);
+
+/**
+ * @brief	return chunk header to pool or heap
+ * Payload of chunk must be freed before its header.
+ * @param[in] pool	pool the header was allocated from, may be NULL
+ * @param[in] chunk	chunk header to release
+ */
+void iot_mqtt_chunk_pool_free_header(iot_mqtt_chunk_pool_t *pool, struct iot_mqtt_packet_chunk *chunk);
+
+/**
+ * @brief	get a payload buffer from the smallest fitting class or heap
+ * @param[in] pool	pool to allocate from, NULL allocates from heap
+ * @param[in] size	required payload size in bytes
+ * @return
+ *	payload buffer : success
+ *	NULL : fail
+ */
+unsigned char *iot_mqtt_chunk_pool_alloc_data(iot_mqtt_chunk_pool_t *pool, size_t size);
+
+/**
+ * @brief	return payload buffer to pool or heap
+ * @param[in] pool	pool the buffer was allocated from, may be NULL
+ * @param[in] data	payload buffer to release
+ */
+void iot_mqtt_chunk_pool_free_data(iot_mqtt_chunk_pool_t *pool, unsigned char *data);
+
+#endif /* _IOT_MQTT_CHUNK_POOL_H_ */
@@ -39,6 +39,12 @@ extern "C" {
 #include "iot_mqtt_packet.h"
 #include "iot_os_util.h"
 #include "port_net.h"
+#include "iot_mqtt_chunk_pool.h"
+#include "iot_mqtt_inflight.h"
+#include "iot_mqtt_reader.h"
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+#include "iot_executor.h"
+#endif
 
 #define MQTT_PUB_NOCOPY					1
 
@@ -48,10 +54,21 @@ extern "C" {
 #define MQTT_PUBLISH_RETRY 				3
 #define MQTT_PING_RETRY 				3
 #define MQTT_WRITE_TIMEOUT				10000	/* in ms*/
+
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_WRITE_BATCH
+#define CONFIG_STDK_IOT_CORE_MQTT_WRITE_BATCH	4
+#endif
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_WRITE_BUFFER_SIZE
+#define CONFIG_STDK_IOT_CORE_MQTT_WRITE_BUFFER_SIZE	512
+#endif
+
+#define IOT_MQTT_WRITE_BATCH			CONFIG_STDK_IOT_CORE_MQTT_WRITE_BATCH
+#define IOT_MQTT_WRITE_BUFFER_SIZE		CONFIG_STDK_IOT_CORE_MQTT_WRITE_BUFFER_SIZE
 #define MQTT_READ_TIMEOUT				10000	/* in ms*/
 #define MQTT_RETRY_TIMEOUT				12000	/* in ms*/
 #define MQTT_CONNECT_TIMEOUT			20000	/* in ms*/
 #define MQTT_ACKPENDING_WAITCYCLE_IN_SYNC_FUNCTION			50		/* in ms*/
+#define MQTT_WRITE_UNBLOCKED_SIGNAL		(1u << 0)
 
 #define MQTT_DISCONNECT_MAX_SIZE		5
 #define MQTT_PUBACK_MAX_SIZE			5
@@ -59,6 +76,7 @@ extern "C" {
 
 #define MQTT_TASK_STACK_SIZE 			(1024*5)
 #define MQTT_TASK_PRIORITY 				4
+#define MQTT_REACTOR_MAX_CYCLES			8	/* run cycles per wake-up before yielding poller */
 
 #define MQTT_CLIENT_STRUCT_MAGIC_NUMBER	0x19890107
 
@@ -87,19 +105,26 @@ typedef struct iot_mqtt_packet_chunk {
 	unsigned int chunk_id;
 	int chunk_state;
 
-	iot_os_timer_handle expiry_time;
+	unsigned int deadline;
 	int retry_count;
 
 	unsigned char have_owner;
 	int return_code;
 
+	iot_mqtt_chunk_pool_t *pool;
+	iot_mqtt_reader_t *reader;	/* chunk_data is borrowed from reader if set */
+
 	struct iot_mqtt_packet_chunk *next;
+	struct iot_mqtt_packet_chunk *prev;
+	struct iot_mqtt_packet_chunk *hash_next, *hash_prev;
+	struct iot_mqtt_packet_chunk *wheel_next, *wheel_prev;
 } iot_mqtt_packet_chunk_t;
 
 typedef struct iot_mqtt_packet_chunk_queue {
 	iot_os_mutex lock;
 	struct iot_mqtt_packet_chunk *head;
 	struct iot_mqtt_packet_chunk *tail;
+	iot_mqtt_inflight_t *index;
 } iot_mqtt_packet_chunk_queue_t;
 
 typedef struct MQTTClient {
@@ -116,18 +141,41 @@ typedef struct MQTTClient {
 
 	iot_os_mutex client_manage_lock;
 	iot_os_thread socket_thread;
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	iot_executor_watch_t *socket_watch;
+	struct iot_mqtt_packet_chunk *read_partial;	/* packet of which rest is not arrived yet */
+	size_t read_offset;
+	size_t write_offset;	/* bytes of write batch sent before socket got full */
+	int write_blocked;
+	iot_os_eventgroup *write_event;	/* MQTT_WRITE_UNBLOCKED_SIGNAL is set once blocked write ends */
+	int callback_work_queued;	/* user callbacks wait for a work on work queue */
+#endif
 
 	struct iot_mqtt_packet_chunk *ping_packet;
 
 	iot_os_mutex write_lock;
 	iot_os_mutex read_lock;
 
+	struct iot_mqtt_packet_chunk *write_batch[IOT_MQTT_WRITE_BATCH];	/* packets being sent together */
+	int write_batch_count;
+	unsigned char *write_buf;	/* coalesced data of write batch, NULL if batch size is 1 */
+	size_t write_len;
+	st_mqtt_write_stats write_stats;
+	st_mqtt_connect_stats connect_stats;
+
 	iot_mqtt_packet_chunk_queue_t write_pending_queue;
 	iot_mqtt_packet_chunk_queue_t ack_pending_queue;
 	iot_mqtt_packet_chunk_queue_t user_event_callback_queue;
 
 	iot_os_eventgroup *work_queue_signal;
 	iot_util_queue_t *work_queue;
+
+	iot_mqtt_chunk_pool_t *chunk_pool;
+	iot_mqtt_inflight_t ack_inflight;
+	iot_os_timer_handle retry_timer;
+	unsigned int retry_deadline;
+
+	iot_mqtt_reader_t reader;
 } MQTTClient;
 
 #if defined(__cplusplus)
@@ -0,0 +1,98 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _IOT_MQTT_INFLIGHT_H_
+#define _IOT_MQTT_INFLIGHT_H_
+
+#define IOT_MQTT_INFLIGHT_BUCKETS		32	/* must be power of 2 */
+#define IOT_MQTT_INFLIGHT_WHEEL_SLOTS		64	/* must be power of 2 */
+#define IOT_MQTT_INFLIGHT_WHEEL_TICK_MS		500
+
+struct iot_mqtt_packet_chunk;
+
+/**
+ * @brief Contains in-flight packet index
+ *
+ * Chunks waiting for an acknowledge are hashed by (packet_type, packet_id)
+ * for ack matching and hung on a timing wheel by deadline for expiry.
+ * Caller must serialize access (ack_pending_queue lock).
+ */
+typedef struct iot_mqtt_inflight {
+	struct iot_mqtt_packet_chunk *bucket[IOT_MQTT_INFLIGHT_BUCKETS];	/**< @brief (packet_type, packet_id) hash chains */
+	struct iot_mqtt_packet_chunk *slot[IOT_MQTT_INFLIGHT_WHEEL_SLOTS];	/**< @brief deadline ordered wheel slots */
+	unsigned int cursor_tick;	/**< @brief oldest wheel tick which is not swept yet */
+	unsigned int count;		/**< @brief number of indexed chunks */
+} iot_mqtt_inflight_t;
+
+/**
+ * @brief	initialize in-flight index
+ * @param[in] inflight	index to initialize
+ * @param[in] now_ms	current tick from iot_os_get_tick_ms()
+ */
+void iot_mqtt_inflight_init(iot_mqtt_inflight_t *inflight, unsigned int now_ms);
+
+/**
+ * @brief	add chunk to in-flight index
+ * chunk->deadline must be set before calling this function
+ * @param[in] inflight	index to add to
+ * @param[in] chunk	chunk waiting for acknowledge
+ */
+void iot_mqtt_inflight_add(iot_mqtt_inflight_t *inflight, struct iot_mqtt_packet_chunk *chunk);
+
+/**
+ * @brief	remove chunk from in-flight index
+ * @param[in] inflight	index to remove from
+ * @param[in] chunk	chunk which was added by iot_mqtt_inflight_add()
+ */
+void iot_mqtt_inflight_remove(iot_mqtt_inflight_t *inflight, struct iot_mqtt_packet_chunk *chunk);
+
+/**
+ * @brief	find in-flight chunk by packet type and id
+ * @param[in] inflight	index to look up
+ * @param[in] packet_type	MQTT packet type of chunk
+ * @param[in] packet_id	MQTT packet id of chunk
+ * @return
+ *	matched chunk : success
+ *	NULL : there is no matched chunk
+ */
+struct iot_mqtt_packet_chunk *iot_mqtt_inflight_find(iot_mqtt_inflight_t *inflight,
+		int packet_type, unsigned int packet_id);
+
+/**
+ * @brief	find in-flight chunk whose deadline has passed
+ * The wheel cursor is advanced up to now_ms as empty slots are swept.
+ * @param[in] inflight	index to look up
+ * @param[in] now_ms	current tick from iot_os_get_tick_ms()
+ * @return
+ *	expired chunk : success
+ *	NULL : there is no expired chunk
+ */
+struct iot_mqtt_packet_chunk *iot_mqtt_inflight_find_expired(iot_mqtt_inflight_t *inflight,
+		unsigned int now_ms);
+
+/**
+ * @brief	get the earliest deadline among in-flight chunks
+ * @param[in] inflight	index to look up
+ * @param[out] deadline	earliest deadline in iot_os_get_tick_ms() unit
+ * @return
+ *	0 : success
+ *	-1 : there is no in-flight chunk
+ */
+int iot_mqtt_inflight_next_deadline(iot_mqtt_inflight_t *inflight, unsigned int *deadline);
+
+#endif /* _IOT_MQTT_INFLIGHT_H_ */
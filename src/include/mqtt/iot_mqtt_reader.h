@@ -0,0 +1,144 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _IOT_MQTT_READER_H_
+#define _IOT_MQTT_READER_H_
+
+#include <stddef.h>
+#include "iot_os_util.h"
+#include "port_net.h"
+
+#ifndef CONFIG_STDK_IOT_CORE_MQTT_READ_BUFFER_SIZE
+#define CONFIG_STDK_IOT_CORE_MQTT_READ_BUFFER_SIZE	1024
+#endif
+
+#define IOT_MQTT_READ_BUFFER_SIZE	CONFIG_STDK_IOT_CORE_MQTT_READ_BUFFER_SIZE
+
+/**
+ * @brief Contains buffered MQTT packet reader
+ *
+ * Bytes are pulled from the network in bulk and packets are framed in place,
+ * so a received chunk can borrow its data from the buffer instead of owning a copy.
+ * Borrowed regions are pinned until released and the buffer is only compacted
+ * when nothing is pinned. head/tail are owned by the reading thread (read_lock),
+ * lock protects pinned count and statistics.
+ */
+typedef struct iot_mqtt_reader {
+	iot_os_mutex lock;
+	unsigned char *buf;		/**< @brief receive buffer */
+	size_t size;			/**< @brief size of receive buffer */
+	size_t head;			/**< @brief first byte not consumed yet */
+	size_t tail;			/**< @brief end of received bytes */
+	unsigned int pinned;		/**< @brief number of borrowed packets alive */
+
+	unsigned int pending_copied;	/**< @brief bytes copied for the packet being framed */
+	unsigned int packets;		/**< @brief number of framed packets */
+	unsigned int packets_in_place;	/**< @brief number of packets delivered without copy */
+	unsigned int bytes_copied;	/**< @brief total bytes copied after network read */
+	unsigned int last_bytes_copied;	/**< @brief bytes copied for the last packet */
+} iot_mqtt_reader_t;
+
+/**
+ * @brief	initialize reader and allocate its receive buffer
+ * @param[in] reader	reader to initialize
+ * @param[in] size	receive buffer size
+ * @return
+ *	0 : success
+ *	-1 : fail
+ */
+int iot_mqtt_reader_init(iot_mqtt_reader_t *reader, size_t size);
+
+/**
+ * @brief	free receive buffer of reader
+ * every borrowed packet must be released before
+ * @param[in] reader	reader to deinitialize
+ */
+void iot_mqtt_reader_deinit(iot_mqtt_reader_t *reader);
+
+/**
+ * @brief	drop every buffered byte, e.g. on new connection
+ * @param[in] reader	reader to reset
+ */
+void iot_mqtt_reader_reset(iot_mqtt_reader_t *reader);
+
+/**
+ * @brief	check whether a whole packet is buffered
+ * @param[in] reader	reader to check
+ * @param[out] packet_len	whole packet length if fixed header is buffered, 0 otherwise
+ * @return
+ *	1 : whole packet is buffered
+ *	0 : more bytes are needed
+ *	-1 : malformed remaining length
+ */
+int iot_mqtt_reader_frame(iot_mqtt_reader_t *reader, size_t *packet_len);
+
+/**
+ * @brief	read available bytes from network into receive buffer
+ * @param[in] reader	reader to fill
+ * @param[in] net_ctx	network context to read
+ * @param[in] need	whole length of packet being framed, 0 if unknown
+ * @return
+ *	positive : number of bytes read
+ *	0 : nothing read or no free space in place for the packet
+ *	negative : network error
+ */
+int iot_mqtt_reader_fill(iot_mqtt_reader_t *reader, PORT_NET_CONTEXT net_ctx, size_t need);
+
+/**
+ * @brief	check whether a packet can be framed in place at all
+ * @param[in] reader	reader to check
+ * @param[in] packet_len	whole packet length
+ * @return
+ *	true : packet fits in receive buffer
+ *	false : packet has to be read into own memory
+ */
+bool iot_mqtt_reader_can_frame(iot_mqtt_reader_t *reader, size_t packet_len);
+
+/**
+ * @brief	consume a framed packet and pin its memory
+ * @param[in] reader	reader to consume
+ * @param[in] packet_len	length returned by iot_mqtt_reader_frame()
+ * @return
+ *	start of packet inside receive buffer, valid until iot_mqtt_reader_release()
+ */
+unsigned char *iot_mqtt_reader_pin(iot_mqtt_reader_t *reader, size_t packet_len);
+
+/**
+ * @brief	release packet memory pinned by iot_mqtt_reader_pin()
+ * @param[in] reader	reader which owns packet memory
+ */
+void iot_mqtt_reader_release(iot_mqtt_reader_t *reader);
+
+/**
+ * @brief	copy out buffered bytes for packets which are not framed in place
+ * @param[in] reader	reader to consume
+ * @param[out] dst	destination
+ * @param[in] len	maximum number of bytes to copy
+ * @return
+ *	number of bytes copied
+ */
+size_t iot_mqtt_reader_take(iot_mqtt_reader_t *reader, unsigned char *dst, size_t len);
+
+/**
+ * @brief	account a completed packet in statistics
+ * @param[in] reader	reader which framed packet
+ * @param[in] in_place	true if packet was delivered from receive buffer
+ */
+void iot_mqtt_reader_account(iot_mqtt_reader_t *reader, bool in_place);
+
+#endif /* _IOT_MQTT_READER_H_ */
@@ -248,6 +248,19 @@ void iot_os_mutex_destroy(iot_os_mutex* mutex);
  */
 void iot_os_delay(unsigned int delay_ms);
 
+/**
+ * @brief	get monotonic tick count
+ *
+ * This function returns elapsed time in ms unit from an arbitrary starting point.
+ * The count never goes backwards but wraps around,
+ * so two ticks should be compared by their difference.
+ *
+ * @return
+ *	current tick count in ms unit
+ *
+ */
+unsigned int iot_os_get_tick_ms(void);
+
 /**
  * @brief	init timer
  *
@@ -346,6 +359,20 @@ void iot_os_timer_delete(iot_os_timer_handle timer_handle);
  */
 int iot_os_timer_start(iot_os_timer_handle timer_handle);
 
+/**
+ * @brief	change timer expiry time and restart timer
+ *
+ * This function will change expiry time of timer and (re)start it
+ *
+ * @param[in] timer	handle to restart
+ * @param[in] expiry_time_ms new timer expiry time in milliseconds
+ *
+ * @return
+ * 	0 : timer restarts successfully
+ *	non-zero : failed to restart timer
+ */
+int iot_os_timer_change_period(iot_os_timer_handle timer_handle, unsigned int expiry_time_ms);
+
 /**
  * @brief	stop timer
  *
@@ -34,6 +34,13 @@ typedef struct {
 	unsigned int device_cert_len;		/**< @brief a size of device certificate chain */
 } port_net_tls_config;
 
+typedef struct {
+	unsigned int dns_ms;		/**< @brief time spent resolving server address */
+	unsigned int tcp_ms;		/**< @brief time spent establishing TCP connection */
+	unsigned int handshake_ms;	/**< @brief time spent in TLS handshake */
+	unsigned int session_offered;	/**< @brief session of previous connection to server was offered for resumption */
+} port_net_connect_stats;
+
 void port_net_free(PORT_NET_CONTEXT ctx);
 
 PORT_NET_CONTEXT port_net_connect(char *address, char *port, port_net_tls_config *config);
@@ -46,6 +53,12 @@ int port_net_read_poll(PORT_NET_CONTEXT ctx, unsigned int wait_time_ms);
 
 int port_net_write(PORT_NET_CONTEXT ctx, void *buf, size_t len);
 
+int port_net_get_socket(PORT_NET_CONTEXT ctx);
+
+int port_net_set_nonblock(PORT_NET_CONTEXT ctx);
+
+int port_net_get_connect_stats(PORT_NET_CONTEXT ctx, port_net_connect_stats *stats);
+
 void port_net_close(PORT_NET_CONTEXT ctx);
 
 #ifdef __cplusplus
@@ -257,6 +257,73 @@ typedef union {
 	bool provisioned;				/**< @brief to check provisoned or not */
 } iot_info_data_t;
 
+/**
+ * @brief Contains options for batching of deviceEvent publishing.
+ */
+typedef struct {
+	unsigned int window_ms;		/**< @brief time to collect events from the first queued one, in milliseconds */
+	unsigned int max_events;	/**< @brief publish right away when this many events are queued, 0 for no limit */
+	unsigned int max_bytes;		/**< @brief publish right away when queued events reach this size, 0 for no limit */
+	bool coalesce;			/**< @brief set true to keep only the last value of same component/capability/attribute */
+} st_event_batch_config;
+
+/**
+ * @brief Contains a enumeration values for policy when offline event buffer is full.
+ */
+typedef enum {
+	ST_OFFLINE_DROP_OLDEST,		/**< @brief drop the oldest buffered events to keep new one */
+	ST_OFFLINE_DROP_NEWEST,		/**< @brief keep buffered events and drop new one */
+} st_offline_drop_policy;
+
+/**
+ * @brief Contains options for buffering deviceEvent while disconnected.
+ */
+typedef struct {
+	unsigned int max_events;	/**< @brief number of events kept in RAM */
+	unsigned int max_bytes;		/**< @brief size of events kept in RAM, 0 for no limit */
+	unsigned int max_spill_files;	/**< @brief number of files to spill full RAM buffer into, 0 to use RAM only */
+	unsigned int replay_batch;	/**< @brief number of events per replayed deviceEvent message, 0 for default */
+	st_offline_drop_policy policy;	/**< @brief what to drop when buffer is full */
+} st_offline_buffer_config;
+
+/**
+ * @brief Contains counters of offline event buffer.
+ */
+typedef struct {
+	unsigned int buffered;		/**< @brief number of events stored while offline */
+	unsigned int replayed;		/**< @brief number of buffered events published after reconnection */
+	unsigned int dropped;		/**< @brief number of events dropped by policy or error */
+	unsigned int pending;		/**< @brief number of events waiting for replay */
+} st_offline_buffer_stats;
+
+/**
+ * @brief Contains options for suppressing deviceEvent whose value is not changed.
+ */
+typedef struct {
+	unsigned int max_entries;	/**< @brief number of attributes whose last sent state is kept */
+	double deadband;		/**< @brief numeric change within this is regarded as no change, 0 for exact match */
+	unsigned int min_interval_ms;	/**< @brief changed numeric value is held back within this time, 0 for no limit */
+} st_attr_cache_config;
+
+/**
+ * @brief Contains counters of attribute state cache.
+ */
+typedef struct {
+	unsigned int sent;		/**< @brief number of events passed to publishing */
+	unsigned int suppressed;	/**< @brief number of events dropped as not changed or superseded while held back */
+	unsigned int entries;		/**< @brief number of attributes whose state is kept */
+} st_attr_cache_stats;
+
+/**
+ * @brief Contains usage of arena which received command messages are decoded into.
+ */
+typedef struct {
+	unsigned int block_size;	/**< @brief size of arena block kept across messages */
+	unsigned int high_water;	/**< @brief largest bytes one command message has used */
+	unsigned int overflows;		/**< @brief number of extra blocks taken because block was too small */
+	unsigned int messages;		/**< @brief number of command messages handled */
+} st_command_arena_stats;
+
 /**
  * @brief Contains a enumeration values for mode of iot_dump
  */
@@ -431,10 +498,31 @@ void st_cap_free_attr(IOT_EVENT* event);
  * @param[in] evt_num The number of IOT_EVENT data in the event.
  *
  * @return return `sequence number`(which is positive integer) if successful,
+ * `(0)` if every event is suppressed by st_conn_set_attr_cache(),
  * negative integer for error case.
  */
 int st_cap_send_attr(IOT_EVENT *event[], uint8_t evt_num);
 
+/**
+ * @brief Request to publish deviceEvent of a known attribute.
+ *
+ * @details This function checks value and unit against the attribute description
+ * generated from caps/iot_caps_helper_*.h, and publishes it without
+ * creating IOT_EVENT. Values out of range, not in allowed values or longer than
+ * max length are rejected before they are sent.
+ * Typed senders in caps/iot_caps_desc.h like st_cap_send_switchLevel_level() call it.
+ *
+ * @param[in] cap_handle The capability handle of the attribute.
+ * @param[in] attr_id IOT_CAPS_ATTR_* id defined in caps/iot_caps_desc.h.
+ * @param[in] value The value of the attribute. It is not copied.
+ * @param[in] unit The unit of the value. NULL for the only unit of attribute, if any.
+ *
+ * @return return `sequence number`(which is positive integer) if successful,
+ * negative integer for error case.
+ */
+int st_cap_send_attr_desc(IOT_CAP_HANDLE *cap_handle, unsigned int attr_id,
+			const iot_cap_val_t *value, const char *unit);
+
 /**
  * @brief Create and initialize a capability handle.
  *
@@ -495,6 +583,8 @@ int st_cap_cmd_set_cb(IOT_CAP_HANDLE *cap_handle, const char *cmd_type,
  * @param[in]	device_info		starting pointer of device_info.json contents
  * @param[in]	device_info_len		size of device_info.json contents
  * @return		return IOT_CTX handle(a pointer) if it succeeds, or NULL if it fails
+ * @note	NV data is shared by the process. With CONFIG_STDK_IOT_CORE_GATEWAY_MODE
+ *		only the first context succeeds, later calls return NULL.
  */
 IOT_CTX* st_conn_init(unsigned char *onboarding_config, unsigned int onboarding_config_len,
 		unsigned char* device_info, unsigned int device_info_len);
@@ -598,10 +688,104 @@ int st_change_device_name(IOT_CTX *iot_ctx, const char *new_name);
  * @param[in] attr_num The number of attr_data list.
  *
  * @return return `sequence number`(which is positive integer) if successful,
+ * `(0)` if every attr data is suppressed by st_conn_set_attr_cache(),
  * negative integer for error case.
  */
 int st_cap_send_attr_v2(IOT_CTX *iot_ctx, st_attr_data* attr_data[], uint8_t attr_num);
 
+/**
+ * @brief Enable or disable batching of deviceEvent publishing.
+ *
+ * @details When enabled, st_cap_send_attr() and st_cap_send_attr_v2() queue their events
+ * and events queued within the window are published together in one deviceEvent message.
+ * Sequence number returned by each send call is still unique for the call and is kept
+ * in its events. When coalescing is enabled, a queued event is replaced by newer one
+ * of same component/capability/attribute.
+ * Queued events are published right away when batching is disabled or reconfigured.
+ * Queued events which can't be published, because target is offline without offline buffer
+ * or is rate limited, are dropped and reported by IOT_NOTI_TYPE_SEND_FAILED with their
+ * sequence number.
+ *
+ * @param[in]	iot_ctx		iot_context handle generated by st_conn_init()
+ * @param[in]	config		batching options, NULL to disable batching
+ *
+ * @return return `(0)` if it works successfully, non-zero for error case.
+ */
+int st_conn_set_event_batch(IOT_CTX *iot_ctx, const st_event_batch_config *config);
+
+/**
+ * @brief Enable or disable buffering of deviceEvent while disconnected.
+ *
+ * @details When enabled, events sent while the device is not connected to server
+ * or is rate limited are stored instead of failing, and the send call returns
+ * their sequence number. Stored events are replayed in sequence number order,
+ * a few in each deviceEvent message, once the connection is back.
+ * Events are kept in RAM first and full RAM buffer is spilled into files
+ * when max_spill_files is set. Pending events are dropped when disabled.
+ *
+ * @param[in]	iot_ctx		iot_context handle generated by st_conn_init()
+ * @param[in]	config		buffering options, NULL to disable buffering
+ *
+ * @return return `(0)` if it works successfully, non-zero for error case.
+ */
+int st_conn_set_offline_buffer(IOT_CTX *iot_ctx, const st_offline_buffer_config *config);
+
+/**
+ * @brief Get counters of offline event buffer.
+ *
+ * @param[in]	iot_ctx		iot_context handle generated by st_conn_init()
+ * @param[out]	stats		counters since buffering was enabled
+ *
+ * @return return `(0)` if it works successfully, non-zero for error case.
+ */
+int st_conn_get_offline_buffer_stats(IOT_CTX *iot_ctx, st_offline_buffer_stats *stats);
+
+/**
+ * @brief Get usage of arena for received command messages.
+ *
+ * @details Everything decoded from one command message is allocated from
+ * an arena which is reset when the message is handled. Compare high_water
+ * with block_size to tune CONFIG_STDK_IOT_CORE_CMD_ARENA_SIZE for a product.
+ *
+ * @param[in]	iot_ctx		iot_context handle generated by st_conn_init()
+ * @param[out]	stats		usage since st_conn_init()
+ *
+ * @return return `(0)` if it works successfully, non-zero for error case.
+ */
+int st_conn_get_command_arena_stats(IOT_CTX *iot_ctx, st_command_arena_stats *stats);
+
+/**
+ * @brief Enable or disable suppressing deviceEvent whose value is not changed.
+ *
+ * @details When enabled, last sent value, unit and data of each component/capability/attribute
+ * are kept, and st_cap_send_attr() and st_cap_send_attr_v2() drop events which are same
+ * as them. Numeric value is regarded as changed only when it differs more than deadband
+ * from last sent one, and it is not sent more often than min_interval_ms.
+ * Numeric change within min_interval_ms is held back, and only the latest held back
+ * value of each attribute is sent when the interval passes. A call whose events are
+ * only held back returns the sequence number they will be sent with. A held back value
+ * which can't be published when the interval passes is reported by IOT_NOTI_TYPE_SEND_FAILED.
+ * Events with state_change or command id are always sent.
+ * When every event of a call is dropped, the call returns `(0)` without using a sequence number.
+ * Held back values are sent and kept states are cleared when disabled or reconfigured.
+ *
+ * @param[in]	iot_ctx		iot_context handle generated by st_conn_init()
+ * @param[in]	config		cache options, NULL to disable cache
+ *
+ * @return return `(0)` if it works successfully, non-zero for error case.
+ */
+int st_conn_set_attr_cache(IOT_CTX *iot_ctx, const st_attr_cache_config *config);
+
+/**
+ * @brief Get counters of attribute state cache.
+ *
+ * @param[in]	iot_ctx		iot_context handle generated by st_conn_init()
+ * @param[out]	stats		counters since cache was enabled
+ *
+ * @return return `(0)` if it works successfully, non-zero for error case.
+ */
+int st_conn_get_attr_cache_stats(IOT_CTX *iot_ctx, st_attr_cache_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1061,6 +1061,13 @@ iot_error_t iot_device_cleanup(struct iot_context *ctx)
 		ctx->lookup_id = NULL;
 	}
 
+	if (ctx->root_cert) {
+		free(ctx->root_cert);
+		ctx->root_cert = NULL;
+	}
+
+	iot_wt_cache_clear(&ctx->wt_cache);
+
 	return iot_err;
 }
 
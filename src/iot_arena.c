@@ -0,0 +1,292 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "iot_os_util.h"
+#include "iot_debug.h"
+#include "iot_arena.h"
+#if defined(CONFIG_STDK_IOT_CORE_CMD_ARENA_CJSON_HOOKS)
+#include "JSON.h"
+#endif
+
+#define IOT_ARENA_ALIGN_UP(x)	(((x) + (IOT_ARENA_ALIGN - 1)) & ~((size_t)IOT_ARENA_ALIGN - 1))
+
+struct iot_arena_block {
+	struct iot_arena_block *next;
+	size_t size;
+};
+
+#define IOT_ARENA_BLOCK_HEADER	IOT_ARENA_ALIGN_UP(sizeof(struct iot_arena_block))
+#define IOT_ARENA_BLOCK_DATA(block)	((uint8_t *)(block) + IOT_ARENA_BLOCK_HEADER)
+
+static iot_arena_block_t *_iot_arena_new_block(size_t size)
+{
+	iot_arena_block_t *block;
+
+	if (size > SIZE_MAX - IOT_ARENA_BLOCK_HEADER) {
+		return NULL;
+	}
+
+	block = (iot_arena_block_t *)iot_os_malloc(IOT_ARENA_BLOCK_HEADER + size);
+	if (block == NULL) {
+		IOT_ERROR("failed to malloc for arena block");
+		return NULL;
+	}
+	block->next = NULL;
+	block->size = size;
+
+	return block;
+}
+
+static void _iot_arena_free_blocks(iot_arena_block_t *block)
+{
+	iot_arena_block_t *next;
+
+	while (block) {
+		next = block->next;
+		iot_os_free(block);
+		block = next;
+	}
+}
+
+void iot_arena_init(iot_arena_t *arena, size_t block_size)
+{
+	if (arena == NULL) {
+		return;
+	}
+
+	memset(arena, 0, sizeof(iot_arena_t));
+	arena->block_size = IOT_ARENA_ALIGN_UP(block_size);
+}
+
+void *iot_arena_alloc(iot_arena_t *arena, size_t size)
+{
+	iot_arena_block_t *block;
+	size_t block_size;
+	void *ptr;
+
+	if (arena == NULL || size > SIZE_MAX - IOT_ARENA_ALIGN) {
+		return NULL;
+	}
+	size = IOT_ARENA_ALIGN_UP(size ? size : 1);
+
+	if (arena->head == NULL) {
+		if (arena->block_size == 0) {
+			arena->block_size = IOT_ARENA_ALIGN_UP(IOT_ARENA_DEFAULT_SIZE);
+		}
+		arena->head = _iot_arena_new_block(arena->block_size);
+		if (arena->head == NULL) {
+			return NULL;
+		}
+		arena->curr = arena->head;
+		arena->offset = 0;
+	}
+
+	if (arena->curr->size - arena->offset < size) {
+		/* Doesn't fit, transaction continues on extra block until reset */
+		block_size = (size > arena->block_size) ? size : arena->block_size;
+		block = _iot_arena_new_block(block_size);
+		if (block == NULL) {
+			return NULL;
+		}
+		arena->curr->next = block;
+		arena->curr = block;
+		arena->offset = 0;
+		arena->overflows++;
+	}
+
+	ptr = IOT_ARENA_BLOCK_DATA(arena->curr) + arena->offset;
+	arena->offset += size;
+	arena->used += size;
+	if (arena->used > arena->high_water) {
+		arena->high_water = arena->used;
+	}
+
+	return ptr;
+}
+
+void *iot_arena_calloc(iot_arena_t *arena, size_t num, size_t size)
+{
+	void *ptr;
+
+	if (size && num > SIZE_MAX / size) {
+		return NULL;
+	}
+
+	ptr = iot_arena_alloc(arena, num * size);
+	if (ptr) {
+		memset(ptr, 0, num * size);
+	}
+
+	return ptr;
+}
+
+char *iot_arena_strdup(iot_arena_t *arena, const char *str)
+{
+	char *dup;
+	size_t len;
+
+	if (str == NULL) {
+		return NULL;
+	}
+
+	len = strlen(str) + 1;
+	dup = (char *)iot_arena_alloc(arena, len);
+	if (dup) {
+		memcpy(dup, str, len);
+	}
+
+	return dup;
+}
+
+bool iot_arena_contains(const iot_arena_t *arena, const void *ptr)
+{
+	const iot_arena_block_t *block;
+	const uint8_t *p = (const uint8_t *)ptr;
+
+	if (arena == NULL || ptr == NULL) {
+		return false;
+	}
+
+	for (block = arena->head; block; block = block->next) {
+		if (p >= IOT_ARENA_BLOCK_DATA(block) && p < IOT_ARENA_BLOCK_DATA(block) + block->size) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void iot_arena_reset(iot_arena_t *arena)
+{
+	if (arena == NULL) {
+		return;
+	}
+
+	if (arena->head) {
+		_iot_arena_free_blocks(arena->head->next);
+		arena->head->next = NULL;
+	}
+	arena->curr = arena->head;
+	arena->offset = 0;
+	arena->used = 0;
+	arena->resets++;
+}
+
+void iot_arena_deinit(iot_arena_t *arena)
+{
+	if (arena == NULL) {
+		return;
+	}
+
+	_iot_arena_free_blocks(arena->head);
+	arena->head = NULL;
+	arena->curr = NULL;
+	arena->offset = 0;
+	arena->used = 0;
+}
+
+#if defined(CONFIG_STDK_IOT_CORE_CMD_ARENA_CJSON_HOOKS)
+/* cJSON hooks are global, so allocations come from hooked arena
+ * only on the thread which hooked it, and heap is used for the rest */
+static iot_arena_t *json_arena;
+static iot_os_thread json_owner;
+static bool json_hooks_installed;
+
+static iot_arena_t *_iot_arena_json_owned(void)
+{
+	iot_arena_t *arena = __atomic_load_n(&json_arena, __ATOMIC_ACQUIRE);
+	iot_os_thread self = NULL;
+
+	if (arena == NULL || iot_os_thread_get_current_handle(&self) != IOT_OS_TRUE ||
+			__atomic_load_n(&json_owner, __ATOMIC_ACQUIRE) != self) {
+		return NULL;
+	}
+
+	return arena;
+}
+
+static void *_iot_arena_json_malloc(size_t size)
+{
+	iot_arena_t *arena = _iot_arena_json_owned();
+
+	if (arena) {
+		return iot_arena_alloc(arena, size);
+	}
+
+	return malloc(size);
+}
+
+static void _iot_arena_json_free(void *ptr)
+{
+	iot_arena_t *arena = _iot_arena_json_owned();
+
+	/* released by reset */
+	if (arena && iot_arena_contains(arena, ptr)) {
+		return;
+	}
+
+	free(ptr);
+}
+
+bool iot_arena_json_begin(iot_arena_t *arena)
+{
+	iot_arena_t *expected = NULL;
+	iot_os_thread self = NULL;
+
+	if (arena == NULL || iot_os_thread_get_current_handle(&self) != IOT_OS_TRUE) {
+		return false;
+	}
+
+	if (!__atomic_compare_exchange_n(&json_arena, &expected, arena,
+			false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+		IOT_DEBUG("cJSON hooks are used by other arena");
+		return false;
+	}
+	__atomic_store_n(&json_owner, self, __ATOMIC_RELEASE);
+
+	if (!json_hooks_installed) {
+		JSON_INIT_HOOKS(_iot_arena_json_malloc, _iot_arena_json_free);
+		json_hooks_installed = true;
+	}
+
+	return true;
+}
+
+void iot_arena_json_end(iot_arena_t *arena)
+{
+	if (arena == NULL || __atomic_load_n(&json_arena, __ATOMIC_ACQUIRE) != arena) {
+		return;
+	}
+
+	__atomic_store_n(&json_owner, NULL, __ATOMIC_RELEASE);
+	__atomic_store_n(&json_arena, NULL, __ATOMIC_RELEASE);
+}
+#else
+bool iot_arena_json_begin(iot_arena_t *arena)
+{
+	return false;
+}
+
+void iot_arena_json_end(iot_arena_t *arena)
+{
+}
+#endif
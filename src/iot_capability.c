@@ -19,9 +19,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
-#include <cbor.h>
-#endif
 
 #include "iot_internal.h"
 #include "iot_util.h"
@@ -29,23 +26,37 @@
 #include "iot_capability.h"
 #include "iot_os_util.h"
 #include "iot_bsp_system.h"
+#include "iot_bsp_fs.h"
 #include "JSON.h"
 #include "st_caps.h"
+#include "caps/iot_caps_helper.h"
+#include "caps/iot_caps_desc.h"
 
 #define MAX_SQNUM 0x7FFFFFFF
 
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+#define IOT_EVT_SERIALIZE_FORMAT	IOT_SERIALIZE_FORMAT_CBOR
+#else
+#define IOT_EVT_SERIALIZE_FORMAT	IOT_SERIALIZE_FORMAT_JSON
+#endif
+#define IOT_EVT_PAYLOAD_SIZE_PER_ITEM	256
+#define IOT_EVT_OFFLINE_REPLAY_BATCH	8
+#define IOT_EVT_OFFLINE_SEGMENT_NAME	IOT_BSP_FS_SPILL_PREFIX
+
 STATIC_FUNCTION
 iot_error_t _iot_parse_noti_data(void *data, iot_noti_data_t *noti_data);
 
-static iot_error_t _iot_parse_cmd_data(JSON_H* cmditem, char** component,
+static iot_error_t _iot_parse_cmd_data(iot_arena_t *arena, JSON_H* cmditem, char** component,
 			char** capability, char** command, iot_cap_cmd_data_t* cmd_data);
-static JSON_H *_iot_make_evt_data(const char* component, const char* capability, iot_cap_evt_data_t* evt_data, int seq_num);
+static iot_error_t _iot_write_evt_data(iot_serialize_writer_t *writer, const char* component,
+			const char* capability, iot_cap_evt_data_t* evt_data, int seq_num);
+static iot_error_t _iot_write_evt_data_v2(iot_serialize_writer_t *writer, st_attr_data *attr_data, int seq_num);
 static void _iot_free_val(iot_cap_val_t* val);
 static void _iot_free_unit(iot_cap_unit_t* unit);
-static void _iot_free_cmd_data(iot_cap_cmd_data_t* cmd_data);
 static void _iot_free_evt_data(iot_cap_evt_data_t* evt_data);
 static IOT_EVENT* _iot_cap_create_attr(const char *attribute,
 			iot_cap_val_t *value, const char *unit, const char *data);
+static void _iot_evt_offline_replay(struct iot_context *ctx, iot_evt_offline_t *offline);
 
 /**************************************************************
 *                       Synchronous Call                      *
@@ -336,6 +347,118 @@ int st_conn_set_noti_cb(IOT_CTX *iot_ctx,
 	return IOT_ERROR_NONE;
 }
 
+#define IOT_CAP_CMD_INDEX_INIT_CAPACITY	16
+
+static uint32_t _iot_cap_cmd_hash(const char *component, const char *capability, const char *command)
+{
+	const char *key[3] = {component, capability, command};
+	uint32_t hash = 2166136261u;
+	const unsigned char *p;
+	int i;
+
+	/* FNV-1a over "component\0capability\0command" */
+	for (i = 0; i < 3; i++) {
+		for (p = (const unsigned char *)key[i]; *p; p++) {
+			hash ^= *p;
+			hash *= 16777619u;
+		}
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static iot_cap_cmd_index_entry_t *_iot_cap_cmd_index_find(iot_cap_cmd_index_t *index, const char *component,
+			const char *capability, const char *command)
+{
+	iot_cap_cmd_index_entry_t *entry;
+	uint32_t hash = _iot_cap_cmd_hash(component, capability, command);
+	unsigned int mask = index->capacity - 1;
+	unsigned int pos;
+
+	for (pos = hash & mask; ; pos = (pos + 1) & mask) {
+		entry = &index->entries[pos];
+		if (entry->handle == NULL) {
+			return NULL;
+		}
+		if (entry->hash == hash && !strcmp(command, entry->command->cmd_type) &&
+				!strcmp(capability, entry->handle->capability) &&
+				!strcmp(component, entry->handle->component)) {
+			return entry;
+		}
+	}
+}
+
+static void _iot_cap_cmd_index_place(iot_cap_cmd_index_entry_t *entries, unsigned int capacity,
+			iot_cap_cmd_index_entry_t *src)
+{
+	unsigned int pos;
+
+	for (pos = src->hash & (capacity - 1); entries[pos].handle; pos = (pos + 1) & (capacity - 1));
+	entries[pos] = *src;
+}
+
+static iot_error_t _iot_cap_cmd_index_add(struct iot_context *ctx, struct iot_cap_handle *handle,
+			struct iot_cap_cmd_set *command)
+{
+	iot_cap_cmd_index_t *index = ctx->cap_cmd_index;
+	iot_cap_cmd_index_entry_t *entries;
+	iot_cap_cmd_index_entry_t *entry;
+	iot_cap_cmd_index_entry_t new_entry;
+	unsigned int capacity;
+	unsigned int i;
+
+	if (index == NULL) {
+		index = (iot_cap_cmd_index_t *)iot_os_malloc(sizeof(iot_cap_cmd_index_t));
+		if (!index) {
+			IOT_ERROR("failed to malloc for cmd index");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+		memset(index, 0, sizeof(iot_cap_cmd_index_t));
+		ctx->cap_cmd_index = index;
+	}
+
+	/* Same command registered by another handle of same capability, last one wins */
+	if (index->count) {
+		entry = _iot_cap_cmd_index_find(index, handle->component, handle->capability, command->cmd_type);
+		if (entry) {
+			IOT_WARN("[%s]%s:%s is registered again", handle->component, handle->capability, command->cmd_type);
+			entry->handle = handle;
+			entry->command = command;
+			return IOT_ERROR_NONE;
+		}
+	}
+
+	/* Keep load factor under 1/2 so that a miss ends in a few probes */
+	if ((index->count + 1) * 2 > index->capacity) {
+		capacity = index->capacity ? index->capacity * 2 : IOT_CAP_CMD_INDEX_INIT_CAPACITY;
+		entries = (iot_cap_cmd_index_entry_t *)iot_os_malloc(sizeof(iot_cap_cmd_index_entry_t) * capacity);
+		if (!entries) {
+			IOT_ERROR("failed to malloc for cmd index entries");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+		memset(entries, 0, sizeof(iot_cap_cmd_index_entry_t) * capacity);
+		for (i = 0; i < index->capacity; i++) {
+			if (index->entries[i].handle) {
+				_iot_cap_cmd_index_place(entries, capacity, &index->entries[i]);
+			}
+		}
+		if (index->entries) {
+			iot_os_free(index->entries);
+		}
+		index->entries = entries;
+		index->capacity = capacity;
+	}
+
+	new_entry.hash = _iot_cap_cmd_hash(handle->component, handle->capability, command->cmd_type);
+	new_entry.handle = handle;
+	new_entry.command = command;
+	_iot_cap_cmd_index_place(index->entries, index->capacity, &new_entry);
+	index->count++;
+
+	return IOT_ERROR_NONE;
+}
+
 int st_cap_cmd_set_cb(IOT_CAP_HANDLE *cap_handle, const char *cmd_type,
 		st_cap_cmd_cb cmd_cb, void *usr_data)
 {
@@ -381,6 +504,14 @@ int st_cap_cmd_set_cb(IOT_CAP_HANDLE *cap_handle, const char *cmd_type,
 		iot_os_free(command);
 		return IOT_ERROR_MEM_ALLOC;
 	}
+	if (handle->ctx && command->cmd_type &&
+			_iot_cap_cmd_index_add(handle->ctx, handle, command) != IOT_ERROR_NONE) {
+		iot_os_free(new_list);
+		iot_os_free(command->cmd_type);
+		iot_os_free(command);
+		return IOT_ERROR_MEM_ALLOC;
+	}
+
 	new_list->command = command;
 	new_list->next = handle->cmd_list;
 	handle->cmd_list = new_list;
@@ -388,93 +519,1945 @@ int st_cap_cmd_set_cb(IOT_CAP_HANDLE *cap_handle, const char *cmd_type,
 	return IOT_ERROR_NONE;
 }
 
-int st_cap_send_attr(IOT_EVENT *event[], uint8_t evt_num)
+static iot_error_t _iot_write_evt(iot_serialize_writer_t *writer, void *event, bool is_v2, int seq_num)
 {
-	iot_cap_evt_data_t** evt_data = (iot_cap_evt_data_t**)event;
-	int ret;
-	struct iot_context *ctx = NULL;
-	st_mqtt_msg msg = {0};
+	iot_cap_evt_data_t *evt_data;
+
+	if (is_v2) {
+		return _iot_write_evt_data_v2(writer, (st_attr_data *)event, seq_num);
+	}
+
+	evt_data = (iot_cap_evt_data_t *)event;
+	return _iot_write_evt_data(writer, evt_data->ref_cap->component,
+			evt_data->ref_cap->capability, evt_data, seq_num);
+}
+
+static iot_error_t _iot_write_evt_root(iot_serialize_writer_t *writer, void **events, uint8_t evt_num,
+			bool is_v2, int seq_num)
+{
+	iot_error_t err = IOT_ERROR_NONE;
 	int i;
-	JSON_H *evt_root = NULL;
-	JSON_H *evt_arr = NULL;
-	JSON_H *evt_item = NULL;
 
-	if (!evt_data || !evt_num || !evt_data[0] || !evt_data[0]->ref_cap || !evt_data[0]->ref_cap->ctx) {
-		IOT_DUMP(IOT_DEBUG_LEVEL_ERROR, IOT_DUMP_CAPABILITY_SEND_EVENT_NO_DATA_ERROR, 0, 0);
-		IOT_ERROR("There is no ctx or evt_data");
-		return IOT_ERROR_INVALID_ARGS;
+	iot_serialize_writer_open_object(writer, NULL);
+	iot_serialize_writer_open_array(writer, "deviceEvents");
+
+	for (i = 0; i < evt_num && err == IOT_ERROR_NONE; i++) {
+		err = _iot_write_evt(writer, events[i], is_v2, seq_num);
+	}
+	if (err != IOT_ERROR_NONE) {
+		IOT_ERROR("Cannot make evt_data!!");
+		return err;
 	}
-	ctx = evt_data[0]->ref_cap->ctx;
 
-	if (ctx->curr_state != IOT_STATE_CLOUD_CONNECTED || ctx->evt_mqttcli == NULL) {
-		IOT_DUMP(IOT_DEBUG_LEVEL_ERROR, IOT_DUMP_CAPABILITY_SEND_EVENT_NO_CONNECT_ERROR, ctx->curr_state, 0);
-		IOT_ERROR("Target has not connected to server yet!!");
-		return IOT_ERROR_BAD_REQ;
+	iot_serialize_writer_close(writer);
+	iot_serialize_writer_close(writer);
+
+	return IOT_ERROR_NONE;
+}
+
+/*
+ * Events are written straight into one payload buffer instead of building
+ * a JSON tree. Buffer is grown once to the exact size if estimation is short.
+ * Without root, only the first event is written as a bare event object.
+ */
+static iot_error_t _iot_encode_evt_payload(void **events, uint8_t evt_num, bool is_v2,
+			bool with_root, int seq_num, uint8_t **payload, size_t *payload_len)
+{
+	iot_serialize_writer_t writer;
+	iot_error_t err;
+	size_t size = IOT_EVT_PAYLOAD_SIZE_PER_ITEM * evt_num;
+	size_t len = 0, needed;
+	uint8_t *buf;
+	int retry;
+
+	for (retry = 0; ; retry++) {
+		buf = (uint8_t *)iot_os_malloc(size);
+		if (buf == NULL) {
+			IOT_ERROR("failed to malloc for event payload");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+
+		needed = 0;
+		iot_serialize_writer_init(&writer, IOT_EVT_SERIALIZE_FORMAT, buf, size);
+		if (with_root) {
+			err = _iot_write_evt_root(&writer, events, evt_num, is_v2, seq_num);
+		} else {
+			err = _iot_write_evt(&writer, events[0], is_v2, seq_num);
+		}
+		if (err == IOT_ERROR_NONE) {
+			err = iot_serialize_writer_finish(&writer, &len, &needed);
+		}
+		if (err == IOT_ERROR_NONE) {
+			break;
+		}
+
+		iot_os_free(buf);
+		if (err != IOT_ERROR_MEM_ALLOC || needed <= size || retry > 0) {
+			return err;
+		}
+		size = needed;
 	}
 
-	if (ctx->rate_limit) {
-		IOT_WARN("Exceed rate limit. Can't send attributes for a while");
+	*payload = buf;
+	*payload_len = len;
+
+	return IOT_ERROR_NONE;
+}
+
+static bool _iot_evt_can_publish(struct iot_context *ctx)
+{
+	return ctx->curr_state == IOT_STATE_CLOUD_CONNECTED && ctx->evt_mqttcli != NULL && !ctx->rate_limit;
+}
+
+/*
+ * Serialized events are copied into one deviceEvents payload. First pass
+ * measures the payload, second one writes it into a buffer of exact size.
+ */
+static iot_error_t _iot_evt_publish_encoded(struct iot_context *ctx, const iot_evt_encoded_t *records,
+			unsigned int num)
+{
+	iot_serialize_writer_t writer;
+	st_mqtt_msg msg = {0};
+	uint8_t *buf = NULL;
+	size_t size = 0, len = 0, needed = 0;
+	iot_error_t err;
+	unsigned int i;
+	int ret;
+
+	while (1) {
+		iot_serialize_writer_init(&writer, IOT_EVT_SERIALIZE_FORMAT, buf, size);
+		iot_serialize_writer_open_object(&writer, NULL);
+		iot_serialize_writer_open_array(&writer, "deviceEvents");
+		for (i = 0; i < num; i++) {
+			iot_serialize_writer_add_encoded(&writer, NULL, records[i].data, records[i].len);
+		}
+		iot_serialize_writer_close(&writer);
+		iot_serialize_writer_close(&writer);
+		err = iot_serialize_writer_finish(&writer, &len, &needed);
+
+		if (buf != NULL || err != IOT_ERROR_MEM_ALLOC) {
+			break;
+		}
+		size = needed;
+		buf = (uint8_t *)iot_os_malloc(size);
+		if (buf == NULL) {
+			IOT_ERROR("failed to malloc for event payload");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+	}
+
+	if (err != IOT_ERROR_NONE) {
+		IOT_ERROR("Fail to transfer to payload (%d)", err);
+		if (buf) {
+			iot_os_free(buf);
+		}
+		return err;
+	}
+
+	msg.qos = st_mqtt_qos1;
+	msg.retained = false;
+	msg.topic = ctx->mqtt_event_topic;
+	msg.payload = buf;
+	msg.payloadlen = len;
+
+	IOT_INFO("publish %u events, topic : %s, payload :\n%s",
+		num, ctx->mqtt_event_topic, (char *)msg.payload);
+
+	ret = st_mqtt_publish_async(ctx->evt_mqttcli, &msg);
+	iot_os_free(buf);
+	if (ret) {
+		IOT_WARN("MQTT pub error(%d)", ret);
+		return IOT_ERROR_MQTT_PUBLISH_FAIL;
+	}
+
+	IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_SEND_EVENT_SUCCESS, num, 0);
+
+	return IOT_ERROR_NONE;
+}
+
+static unsigned int _iot_evt_offline_pending(iot_evt_offline_t *offline)
+{
+	unsigned int pending;
+	unsigned int i;
+
+	if (iot_os_mutex_lock(&offline->lock) != IOT_OS_TRUE) {
+		return 0;
+	}
+	pending = offline->count;
+	for (i = 0; i < offline->seg_count; i++) {
+		pending += offline->segments[(offline->seg_first + i) % offline->config.max_spill_files].events;
+	}
+	if (offline->seg_count) {
+		pending -= offline->segments[offline->seg_first % offline->config.max_spill_files].replayed;
+	}
+	iot_os_mutex_unlock(&offline->lock);
+
+	return pending;
+}
+
+static void _iot_evt_offline_segment_name(unsigned int id, char *name, size_t size)
+{
+	snprintf(name, size, "%s%u", IOT_EVT_OFFLINE_SEGMENT_NAME, id);
+}
+
+/* Caller holds offline lock */
+static void _iot_evt_offline_remove_segment(iot_evt_offline_t *offline)
+{
+	iot_evt_offline_segment_t *segment;
+	char name[32];
+
+	segment = &offline->segments[offline->seg_first % offline->config.max_spill_files];
+	offline->stats.dropped += segment->events - segment->replayed;
+
+	_iot_evt_offline_segment_name(offline->seg_first, name, sizeof(name));
+	if (iot_bsp_fs_remove(name) != IOT_ERROR_NONE) {
+		IOT_WARN("Fail to remove %s", name);
+	}
+
+	offline->seg_first++;
+	offline->seg_count--;
+}
+
+/* Caller holds offline lock, every event in RAM goes into a new segment file */
+static iot_error_t _iot_evt_offline_spill(iot_evt_offline_t *offline)
+{
+	iot_evt_offline_segment_t *segment;
+	iot_evt_encoded_t *record;
+	iot_bsp_fs_handle_t handle;
+	uint32_t header[2];
+	char name[32];
+	uint8_t *buf, *pos;
+	size_t size = 0;
+	unsigned int i, id;
+	iot_error_t err;
+
+	for (i = 0; i < offline->count; i++) {
+		size += sizeof(header) + offline->ring[(offline->head + i) % offline->config.max_events].len;
+	}
+	buf = (uint8_t *)iot_os_malloc(size);
+	if (buf == NULL) {
+		IOT_ERROR("failed to malloc for offline segment");
+		return IOT_ERROR_MEM_ALLOC;
+	}
+	for (i = 0, pos = buf; i < offline->count; i++) {
+		record = &offline->ring[(offline->head + i) % offline->config.max_events];
+		header[0] = (uint32_t)record->seq_num;
+		header[1] = (uint32_t)record->len;
+		memcpy(pos, header, sizeof(header));
+		memcpy(pos + sizeof(header), record->data, record->len);
+		pos += sizeof(header) + record->len;
+	}
+
+	id = offline->seg_first + offline->seg_count;
+	_iot_evt_offline_segment_name(id, name, sizeof(name));
+	err = iot_bsp_fs_open(name, FS_READWRITE, &handle);
+	if (err == IOT_ERROR_NONE) {
+		err = iot_bsp_fs_write(handle, (const char *)buf, size);
+		iot_bsp_fs_close(handle);
+	}
+	iot_os_free(buf);
+	if (err != IOT_ERROR_NONE) {
+		IOT_ERROR("Fail to write %s (%d)", name, err);
+		return err;
+	}
+
+	segment = &offline->segments[id % offline->config.max_spill_files];
+	segment->events = offline->count;
+	segment->replayed = 0;
+	segment->bytes = size;
+	offline->seg_count++;
+
+	for (i = 0; i < offline->count; i++) {
+		iot_os_free(offline->ring[(offline->head + i) % offline->config.max_events].data);
+	}
+	offline->head = 0;
+	offline->count = 0;
+	offline->bytes = 0;
+
+	return IOT_ERROR_NONE;
+}
+
+/* Caller holds offline lock, record data belongs to buffer from now */
+static void _iot_evt_offline_store(iot_evt_offline_t *offline, iot_evt_encoded_t *record)
+{
+	iot_evt_encoded_t *oldest;
+	unsigned int max_events = offline->config.max_events;
+	size_t max_bytes = offline->config.max_bytes;
+
+	if (max_bytes && record->len > max_bytes) {
+		IOT_WARN("Drop event(%d), too large for offline buffer", record->seq_num);
+		iot_os_free(record->data);
+		offline->stats.dropped++;
+		return;
+	}
+
+	while (offline->count == max_events || (max_bytes && offline->bytes + record->len > max_bytes)) {
+		if (offline->config.max_spill_files) {
+			if (offline->seg_count < offline->config.max_spill_files ||
+					offline->config.policy == ST_OFFLINE_DROP_OLDEST) {
+				if (offline->seg_count == offline->config.max_spill_files) {
+					IOT_WARN("Drop the oldest offline segment");
+					_iot_evt_offline_remove_segment(offline);
+				}
+				if (_iot_evt_offline_spill(offline) == IOT_ERROR_NONE) {
+					continue;
+				}
+			}
+		}
+
+		if (offline->config.policy == ST_OFFLINE_DROP_NEWEST) {
+			IOT_WARN("Drop event(%d), offline buffer is full", record->seq_num);
+			iot_os_free(record->data);
+			offline->stats.dropped++;
+			return;
+		}
+
+		oldest = &offline->ring[offline->head];
+		IOT_WARN("Drop event(%d), offline buffer is full", oldest->seq_num);
+		offline->bytes -= oldest->len;
+		iot_os_free(oldest->data);
+		offline->stats.dropped++;
+		offline->head = (offline->head + 1) % max_events;
+		offline->count--;
+	}
+
+	offline->ring[(offline->head + offline->count) % max_events] = *record;
+	offline->count++;
+	offline->bytes += record->len;
+	offline->stats.buffered++;
+}
+
+static void _iot_evt_offline_replay_work(struct iot_context *ctx, device_work_param param)
+{
+	iot_cap_replay_offline_events(ctx);
+}
+
+/* Caller holds evt_lock */
+static void _iot_evt_offline_schedule_replay(struct iot_context *ctx)
+{
+	iot_evt_offline_t *offline = ctx->evt_offline;
+
+	if (offline == NULL || !_iot_evt_can_publish(ctx)) {
+		return;
+	}
+
+	/* Replay from device work thread, caller can be timer context */
+	if (ctx->work_queue) {
+		if (iot_os_mutex_lock(&offline->lock) != IOT_OS_TRUE) {
+			return;
+		}
+		if (!offline->replay_queued &&
+				iot_put_device_work(ctx, _iot_evt_offline_replay_work, NULL) == IOT_ERROR_NONE) {
+			offline->replay_queued = true;
+		}
+		iot_os_mutex_unlock(&offline->lock);
+	} else {
+		_iot_evt_offline_replay(ctx, offline);
+	}
+}
+
+/* Caller holds evt_lock, records are stored in sequence number order and their data belong to buffer from now */
+static void _iot_evt_offline_store_records(struct iot_context *ctx, iot_evt_encoded_t *records,
+			unsigned int num)
+{
+	iot_evt_offline_t *offline = ctx->evt_offline;
+	iot_evt_encoded_t record;
+	unsigned int i, j;
+
+	for (i = 1; i < num; i++) {
+		record = records[i];
+		for (j = i; j > 0 && records[j - 1].seq_num > record.seq_num; j--) {
+			records[j] = records[j - 1];
+		}
+		records[j] = record;
+	}
+
+	while (iot_os_mutex_lock(&offline->lock) != IOT_OS_TRUE);
+	for (i = 0; i < num; i++) {
+		_iot_evt_offline_store(offline, &records[i]);
+	}
+	iot_os_mutex_unlock(&offline->lock);
+
+	_iot_evt_offline_schedule_replay(ctx);
+}
+
+/* Caller holds offline lock */
+static iot_error_t _iot_evt_offline_replay_segment(struct iot_context *ctx, iot_evt_offline_t *offline,
+			iot_evt_encoded_t *records, unsigned int batch_num)
+{
+	iot_evt_offline_segment_t *segment;
+	iot_bsp_fs_handle_t handle;
+	uint32_t header[2];
+	char name[32];
+	uint8_t *buf, *pos, *end;
+	size_t len;
+	unsigned int index = 0, num = 0;
+	iot_error_t err;
+
+	segment = &offline->segments[offline->seg_first % offline->config.max_spill_files];
+	_iot_evt_offline_segment_name(offline->seg_first, name, sizeof(name));
+
+	buf = (uint8_t *)iot_os_malloc(segment->bytes);
+	if (buf == NULL) {
+		IOT_ERROR("failed to malloc for offline segment");
+		return IOT_ERROR_MEM_ALLOC;
+	}
+
+	len = segment->bytes;
+	err = iot_bsp_fs_open(name, FS_READONLY, &handle);
+	if (err == IOT_ERROR_NONE) {
+		err = iot_bsp_fs_read(handle, (char *)buf, &len);
+		iot_bsp_fs_close(handle);
+	}
+	if (err != IOT_ERROR_NONE || len != segment->bytes) {
+		IOT_ERROR("Fail to read %s (%d), drop %u events", name, err,
+				segment->events - segment->replayed);
+		iot_os_free(buf);
+		_iot_evt_offline_remove_segment(offline);
+		return IOT_ERROR_NONE;
+	}
+
+	/* Events published before a failure are skipped */
+	for (pos = buf, end = buf + len; pos + sizeof(header) <= end; index++) {
+		memcpy(header, pos, sizeof(header));
+		if (header[1] > (size_t)(end - pos) - sizeof(header)) {
+			IOT_ERROR("Broken record in %s", name);
+			break;
+		}
+		if (index >= segment->replayed) {
+			records[num].seq_num = (int)header[0];
+			records[num].data = pos + sizeof(header);
+			records[num].len = header[1];
+			num++;
+		}
+		pos += sizeof(header) + header[1];
+
+		if (num == batch_num || (num && pos + sizeof(header) > end)) {
+			err = _iot_evt_publish_encoded(ctx, records, num);
+			if (err == IOT_ERROR_NONE) {
+				segment->replayed += num;
+				offline->stats.replayed += num;
+				num = 0;
+			}
+			if (err != IOT_ERROR_NONE || !_iot_evt_can_publish(ctx)) {
+				break;
+			}
+		}
+	}
+	if (num && err == IOT_ERROR_NONE) {
+		/* Records before a broken one */
+		err = _iot_evt_publish_encoded(ctx, records, num);
+		if (err == IOT_ERROR_NONE) {
+			segment->replayed += num;
+			offline->stats.replayed += num;
+		}
+	}
+	iot_os_free(buf);
+
+	if (err != IOT_ERROR_NONE) {
+		return err;
+	}
+	if (segment->replayed < segment->events && !_iot_evt_can_publish(ctx)) {
+		/* Stopped by rate limit or disconnection, resume later */
 		return IOT_ERROR_BAD_REQ;
 	}
 
-	if (ctx->event_sequence_num == MAX_SQNUM) {
-		ctx->event_sequence_num = 0;
-	}
-	ctx->event_sequence_num = (ctx->event_sequence_num + 1) & MAX_SQNUM;
+	_iot_evt_offline_remove_segment(offline);
+
+	return IOT_ERROR_NONE;
+}
+
+/* Caller holds evt_lock, so buffer can't be replaced while it is published */
+static void _iot_evt_offline_replay(struct iot_context *ctx, iot_evt_offline_t *offline)
+{
+	iot_evt_encoded_t *records;
+	unsigned int batch_num, num, i;
+
+	if (iot_os_mutex_lock(&offline->lock) != IOT_OS_TRUE) {
+		return;
+	}
+	offline->replay_queued = false;
+
+	batch_num = offline->config.replay_batch ? offline->config.replay_batch : IOT_EVT_OFFLINE_REPLAY_BATCH;
+	records = (iot_evt_encoded_t *)iot_os_malloc(sizeof(iot_evt_encoded_t) * batch_num);
+	if (records == NULL) {
+		IOT_ERROR("failed to malloc for offline replay");
+		iot_os_mutex_unlock(&offline->lock);
+		return;
+	}
+
+	/* Files hold older events than RAM */
+	while (offline->seg_count && _iot_evt_can_publish(ctx)) {
+		if (_iot_evt_offline_replay_segment(ctx, offline, records, batch_num) != IOT_ERROR_NONE) {
+			break;
+		}
+	}
+
+	while (offline->seg_count == 0 && offline->count && _iot_evt_can_publish(ctx)) {
+		num = offline->count < batch_num ? offline->count : batch_num;
+		for (i = 0; i < num; i++) {
+			records[i] = offline->ring[(offline->head + i) % offline->config.max_events];
+		}
+		if (_iot_evt_publish_encoded(ctx, records, num) != IOT_ERROR_NONE) {
+			break;
+		}
+
+		for (i = 0; i < num; i++) {
+			offline->bytes -= offline->ring[offline->head].len;
+			iot_os_free(offline->ring[offline->head].data);
+			offline->head = (offline->head + 1) % offline->config.max_events;
+		}
+		offline->count -= num;
+		offline->stats.replayed += num;
+	}
+
+	iot_os_free(records);
+	iot_os_mutex_unlock(&offline->lock);
+}
+
+void iot_cap_replay_offline_events(struct iot_context *ctx)
+{
+	if (ctx == NULL || iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		return;
+	}
+	if (ctx->evt_offline) {
+		_iot_evt_offline_replay(ctx, ctx->evt_offline);
+	}
+	iot_os_mutex_unlock(&ctx->evt_lock);
+}
+
+/* Caller holds evt_lock, so send calls and replay work can't see detached buffer */
+static iot_evt_offline_t *_iot_evt_offline_detach(struct iot_context *ctx)
+{
+	iot_evt_offline_t *offline = ctx->evt_offline;
+
+	ctx->evt_offline = NULL;
+
+	return offline;
+}
+
+/* Called without evt_lock, nothing else refers to detached buffer */
+static void _iot_evt_offline_free(iot_evt_offline_t *offline)
+{
+	if (offline == NULL) {
+		return;
+	}
+
+	if (offline->count || offline->seg_count) {
+		IOT_WARN("Drop offline events, %u in RAM and %u files", offline->count, offline->seg_count);
+	}
+	while (offline->seg_count) {
+		_iot_evt_offline_remove_segment(offline);
+	}
+	while (offline->count) {
+		iot_os_free(offline->ring[offline->head].data);
+		offline->head = (offline->head + 1) % offline->config.max_events;
+		offline->count--;
+	}
+
+	iot_os_mutex_destroy(&offline->lock);
+	if (offline->segments) {
+		iot_os_free(offline->segments);
+	}
+	iot_os_free(offline->ring);
+	iot_os_free(offline);
+}
+
+int st_conn_set_offline_buffer(IOT_CTX *iot_ctx, const st_offline_buffer_config *config)
+{
+	struct iot_context *ctx = (struct iot_context *)iot_ctx;
+	iot_evt_offline_t *offline = NULL;
+	iot_evt_offline_t *old_offline;
+
+	if (!ctx || (config && config->max_events == 0)) {
+		IOT_ERROR("There is no ctx or invalid config");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	if (config) {
+		offline = (iot_evt_offline_t *)iot_os_malloc(sizeof(iot_evt_offline_t));
+		if (offline == NULL) {
+			IOT_ERROR("failed to malloc for offline buffer");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+		memset(offline, '\0', sizeof(iot_evt_offline_t));
+		offline->config = *config;
+
+		offline->ring = (iot_evt_encoded_t *)iot_os_malloc(sizeof(iot_evt_encoded_t) * config->max_events);
+		if (offline->ring == NULL) {
+			IOT_ERROR("failed to malloc for offline ring");
+			goto error_offline;
+		}
+		if (config->max_spill_files) {
+			offline->segments = (iot_evt_offline_segment_t *)iot_os_malloc(
+					sizeof(iot_evt_offline_segment_t) * config->max_spill_files);
+			if (offline->segments == NULL) {
+				IOT_ERROR("failed to malloc for offline segments");
+				goto error_offline;
+			}
+		}
+		if (iot_os_mutex_init(&offline->lock) != IOT_OS_TRUE) {
+			IOT_ERROR("failed to init offline buffer lock");
+			goto error_offline;
+		}
+	}
+
+	if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		IOT_ERROR("failed to lock evt_lock");
+		_iot_evt_offline_free(offline);
+		return IOT_ERROR_BAD_REQ;
+	}
+	old_offline = _iot_evt_offline_detach(ctx);
+	ctx->evt_offline = offline;
+	iot_os_mutex_unlock(&ctx->evt_lock);
+
+	_iot_evt_offline_free(old_offline);
+
+	return IOT_ERROR_NONE;
+
+error_offline:
+	if (offline->segments) {
+		iot_os_free(offline->segments);
+	}
+	if (offline->ring) {
+		iot_os_free(offline->ring);
+	}
+	iot_os_free(offline);
+	return IOT_ERROR_MEM_ALLOC;
+}
+
+int st_conn_get_offline_buffer_stats(IOT_CTX *iot_ctx, st_offline_buffer_stats *stats)
+{
+	struct iot_context *ctx = (struct iot_context *)iot_ctx;
+	iot_evt_offline_t *offline;
+	int ret = IOT_ERROR_NONE;
+
+	if (!ctx || !stats) {
+		IOT_ERROR("There is no ctx or stats");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		return IOT_ERROR_BAD_REQ;
+	}
+	offline = ctx->evt_offline;
+	if (offline == NULL) {
+		IOT_ERROR("There is no offline buffer");
+		ret = IOT_ERROR_INVALID_ARGS;
+	} else {
+		stats->pending = _iot_evt_offline_pending(offline);
+		while (iot_os_mutex_lock(&offline->lock) != IOT_OS_TRUE);
+		stats->buffered = offline->stats.buffered;
+		stats->replayed = offline->stats.replayed;
+		stats->dropped = offline->stats.dropped;
+		iot_os_mutex_unlock(&offline->lock);
+	}
+	iot_os_mutex_unlock(&ctx->evt_lock);
+
+	return ret;
+}
+
+/* Caller holds evt_lock */
+static iot_error_t _iot_evt_offline_add(struct iot_context *ctx, void **events, uint8_t evt_num,
+			bool is_v2, int seq_num)
+{
+	iot_evt_encoded_t *records;
+	unsigned int i;
+
+	records = (iot_evt_encoded_t *)iot_os_malloc(sizeof(iot_evt_encoded_t) * evt_num);
+	if (records == NULL) {
+		IOT_ERROR("failed to malloc for offline events");
+		return IOT_ERROR_MEM_ALLOC;
+	}
+
+	for (i = 0; i < evt_num; i++) {
+		records[i].seq_num = seq_num;
+		if (_iot_encode_evt_payload(&events[i], 1, is_v2, false, seq_num,
+				&records[i].data, &records[i].len) != IOT_ERROR_NONE) {
+			while (i--) {
+				iot_os_free(records[i].data);
+			}
+			iot_os_free(records);
+			return IOT_ERROR_BAD_REQ;
+		}
+	}
+
+	_iot_evt_offline_store_records(ctx, records, evt_num);
+	iot_os_free(records);
+
+	return IOT_ERROR_NONE;
+}
+
+static uint32_t _iot_evt_batch_hash(const char *key, size_t len)
+{
+	uint32_t hash = 2166136261u;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		hash = (hash ^ (uint8_t)key[i]) * 16777619u;
+	}
+
+	return hash;
+}
+
+static iot_evt_batch_item_t *_iot_evt_batch_new_item(void *event, bool is_v2, int seq_num)
+{
+	iot_cap_evt_data_t *evt_data;
+	st_attr_data *attr_data;
+	iot_evt_batch_item_t *item;
+	const char *names[3];
+	size_t lens[3];
+	char *pos;
+	int i;
+
+	if (is_v2) {
+		attr_data = (st_attr_data *)event;
+		names[0] = (attr_data->component_type == ST_COMPONENT_CUSTOM) ?
+				attr_data->custom_component_name : "main";
+		names[1] = attr_data->custom_cap_name;
+		names[2] = attr_data->custom_attr_name;
+	} else {
+		evt_data = (iot_cap_evt_data_t *)event;
+		names[0] = evt_data->ref_cap->component;
+		names[1] = evt_data->ref_cap->capability;
+		names[2] = evt_data->evt_type;
+	}
+
+	item = (iot_evt_batch_item_t *)iot_os_malloc(sizeof(iot_evt_batch_item_t));
+	if (item == NULL) {
+		IOT_ERROR("failed to malloc for batch item");
+		return NULL;
+	}
+	memset(item, '\0', sizeof(iot_evt_batch_item_t));
+
+	for (i = 0; i < 3; i++) {
+		lens[i] = names[i] ? strlen(names[i]) : 0;
+		item->key_len += lens[i] + 1;
+	}
+	item->key = (char *)iot_os_malloc(item->key_len);
+	if (item->key == NULL) {
+		IOT_ERROR("failed to malloc for batch item key");
+		iot_os_free(item);
+		return NULL;
+	}
+	for (i = 0, pos = item->key; i < 3; i++) {
+		memcpy(pos, names[i] ? names[i] : "", lens[i] + 1);
+		pos += lens[i] + 1;
+	}
+	item->key_hash = _iot_evt_batch_hash(item->key, item->key_len);
+
+	if (_iot_encode_evt_payload(&event, 1, is_v2, false, seq_num,
+			&item->data, &item->len) != IOT_ERROR_NONE) {
+		iot_os_free(item->key);
+		iot_os_free(item);
+		return NULL;
+	}
+	item->seq_num = seq_num;
+
+	return item;
+}
+
+static void _iot_evt_batch_free_item(iot_evt_batch_item_t *item)
+{
+	if (item->data) {
+		iot_os_free(item->data);
+	}
+	iot_os_free(item->key);
+	iot_os_free(item);
+}
+
+/*
+ * Caller of send API got sequence numbers of these events already,
+ * so dropping them is reported once per sequence number.
+ */
+static void _iot_evt_report_dropped(struct iot_context *ctx, const iot_evt_encoded_t *records,
+			unsigned int num)
+{
+	iot_noti_data_t noti_data;
+	unsigned int i, j;
+
+	for (i = 0; i < num; i++) {
+		for (j = 0; j < i && records[j].seq_num != records[i].seq_num; j++);
+		if (j < i) {
+			continue;
+		}
+
+		memset(&noti_data, '\0', sizeof(iot_noti_data_t));
+		noti_data.type = IOT_NOTI_TYPE_SEND_FAILED;
+		noti_data.raw.send_fail.failed_sequence_num = records[i].seq_num;
+		if (iot_command_send(ctx, IOT_COMMAND_NOTIFICATION_RECEIVED,
+				&noti_data, sizeof(noti_data)) != IOT_ERROR_NONE) {
+			IOT_ERROR("Fail to report dropped event(%d)", records[i].seq_num);
+		}
+	}
+}
+
+/* Caller holds batch lock */
+static void _iot_evt_batch_flush(struct iot_context *ctx, iot_evt_batch_t *batch)
+{
+	iot_evt_batch_item_t *item, *next;
+	iot_evt_encoded_t *records;
+	unsigned int count = batch->count;
+	unsigned int i;
+
+	if (batch->timer) {
+		iot_os_timer_stop(batch->timer);
+	}
+	if (batch->head == NULL) {
+		return;
+	}
+
+	records = (iot_evt_encoded_t *)iot_os_malloc(sizeof(iot_evt_encoded_t) * count);
+	if (records == NULL) {
+		IOT_ERROR("failed to malloc for %u batched events", count);
+		goto out_flush;
+	}
+	for (i = 0, item = batch->head; item; i++, item = item->next) {
+		records[i].seq_num = item->seq_num;
+		records[i].data = item->data;
+		records[i].len = item->len;
+	}
+
+	if (ctx->evt_offline && (!_iot_evt_can_publish(ctx) || _iot_evt_offline_pending(ctx->evt_offline))) {
+		/* Serialized events belong to offline buffer from now */
+		for (item = batch->head; item; item = item->next) {
+			item->data = NULL;
+		}
+		_iot_evt_offline_store_records(ctx, records, count);
+	} else if (ctx->curr_state != IOT_STATE_CLOUD_CONNECTED || ctx->evt_mqttcli == NULL) {
+		IOT_WARN("Drop %u batched events, target is not connected", count);
+		_iot_evt_report_dropped(ctx, records, count);
+	} else if (ctx->rate_limit) {
+		IOT_WARN("Drop %u batched events, exceed rate limit", count);
+		_iot_evt_report_dropped(ctx, records, count);
+	} else if (_iot_evt_publish_encoded(ctx, records, count) == IOT_ERROR_NONE) {
+		batch->published++;
+	} else {
+		_iot_evt_report_dropped(ctx, records, count);
+	}
+	iot_os_free(records);
+
+out_flush:
+	for (item = batch->head; item; item = next) {
+		next = item->next;
+		_iot_evt_batch_free_item(item);
+	}
+	batch->head = batch->tail = NULL;
+	batch->count = 0;
+	batch->bytes = 0;
+}
+
+/* Batch is looked up under evt_lock, st_conn_set_event_batch() may replace it meanwhile */
+static void _iot_evt_batch_flush_work(struct iot_context *ctx, device_work_param param)
+{
+	iot_evt_batch_t *batch;
+
+	if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		return;
+	}
+	batch = ctx->evt_batch;
+	if (batch && iot_os_mutex_lock(&batch->lock) == IOT_OS_TRUE) {
+		batch->flush_queued = false;
+		_iot_evt_batch_flush(ctx, batch);
+		iot_os_mutex_unlock(&batch->lock);
+	}
+	iot_os_mutex_unlock(&ctx->evt_lock);
+}
+
+static void _iot_evt_batch_window_cb(iot_os_timer_handle handle, void *user_data)
+{
+	struct iot_context *ctx = (struct iot_context *)user_data;
+	iot_evt_batch_t *batch;
+
+	/* Publish from device work thread, not from timer context */
+	if (ctx->work_queue == NULL) {
+		_iot_evt_batch_flush_work(ctx, NULL);
+		return;
+	}
+
+	if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		return;
+	}
+	batch = ctx->evt_batch;
+	if (batch && iot_os_mutex_lock(&batch->lock) == IOT_OS_TRUE) {
+		if (!batch->flush_queued &&
+				iot_put_device_work(ctx, _iot_evt_batch_flush_work, NULL) == IOT_ERROR_NONE) {
+			batch->flush_queued = true;
+		}
+		iot_os_mutex_unlock(&batch->lock);
+	}
+	iot_os_mutex_unlock(&ctx->evt_lock);
+}
+
+static bool _iot_evt_batch_full(iot_evt_batch_t *batch, unsigned int count, size_t bytes)
+{
+	return (batch->config.max_events && count >= batch->config.max_events) ||
+			(batch->config.max_bytes && bytes >= batch->config.max_bytes);
+}
+
+static bool _iot_evt_batch_over(iot_evt_batch_t *batch, unsigned int count, size_t bytes)
+{
+	return (batch->config.max_events && count > batch->config.max_events) ||
+			(batch->config.max_bytes && bytes > batch->config.max_bytes);
+}
+
+static iot_error_t _iot_evt_batch_add(struct iot_context *ctx, void **events, uint8_t evt_num,
+			bool is_v2, int seq_num)
+{
+	iot_evt_batch_t *batch = ctx->evt_batch;
+	iot_evt_batch_item_t *item, *iter, *prev;
+	iot_error_t err = IOT_ERROR_NONE;
+	int i;
+
+	if (iot_os_mutex_lock(&batch->lock) != IOT_OS_TRUE) {
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	for (i = 0; i < evt_num; i++) {
+		item = _iot_evt_batch_new_item(events[i], is_v2, seq_num);
+		if (item == NULL) {
+			err = IOT_ERROR_BAD_REQ;
+			break;
+		}
+
+		/* Last value wins, replaced event keeps its place in the batch */
+		if (batch->config.coalesce) {
+			for (prev = NULL, iter = batch->head; iter; prev = iter, iter = iter->next) {
+				if (iter->key_hash == item->key_hash && iter->key_len == item->key_len &&
+						!memcmp(iter->key, item->key, item->key_len)) {
+					break;
+				}
+			}
+			if (iter) {
+				item->next = iter->next;
+				if (prev) {
+					prev->next = item;
+				} else {
+					batch->head = item;
+				}
+				if (batch->tail == iter) {
+					batch->tail = item;
+				}
+				batch->bytes = batch->bytes - iter->len + item->len;
+				batch->coalesced++;
+				_iot_evt_batch_free_item(iter);
+				continue;
+			}
+		}
+
+		/* Flush first only if the new event doesn't fit, a batch may fill up exactly */
+		if (batch->head && _iot_evt_batch_over(batch, batch->count + 1, batch->bytes + item->len)) {
+			_iot_evt_batch_flush(ctx, batch);
+		}
+
+		if (batch->tail) {
+			batch->tail->next = item;
+		} else {
+			batch->head = item;
+		}
+		batch->tail = item;
+		batch->count++;
+		batch->bytes += item->len;
+
+		if (batch->count == 1 && batch->timer && iot_os_timer_start(batch->timer)) {
+			IOT_WARN("Fail to start batch window timer");
+		}
+	}
+
+	if (batch->head && (_iot_evt_batch_full(batch, batch->count, batch->bytes) ||
+			batch->timer == NULL)) {
+		_iot_evt_batch_flush(ctx, batch);
+	}
+	iot_os_mutex_unlock(&batch->lock);
+
+	return err;
+}
+
+/* Caller holds evt_lock, so window timer and flush work can't see detached batch */
+static iot_evt_batch_t *_iot_evt_batch_detach(struct iot_context *ctx)
+{
+	iot_evt_batch_t *batch = ctx->evt_batch;
+
+	if (batch == NULL) {
+		return NULL;
+	}
+
+	while (iot_os_mutex_lock(&batch->lock) != IOT_OS_TRUE);
+	_iot_evt_batch_flush(ctx, batch);
+	ctx->evt_batch = NULL;
+	iot_os_mutex_unlock(&batch->lock);
+
+	return batch;
+}
+
+/* Called without evt_lock, window callback may be waiting for it */
+static void _iot_evt_batch_free(iot_evt_batch_t *batch)
+{
+	if (batch == NULL) {
+		return;
+	}
+
+	if (batch->timer) {
+		iot_os_timer_delete(batch->timer);
+	}
+	iot_os_mutex_destroy(&batch->lock);
+	iot_os_free(batch);
+}
+
+int st_conn_set_event_batch(IOT_CTX *iot_ctx, const st_event_batch_config *config)
+{
+	struct iot_context *ctx = (struct iot_context *)iot_ctx;
+	iot_evt_batch_t *batch = NULL;
+	iot_evt_batch_t *old_batch;
+
+	if (!ctx) {
+		IOT_ERROR("There is no ctx");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	if (config) {
+		batch = (iot_evt_batch_t *)iot_os_malloc(sizeof(iot_evt_batch_t));
+		if (batch == NULL) {
+			IOT_ERROR("failed to malloc for event batch");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+		memset(batch, '\0', sizeof(iot_evt_batch_t));
+		batch->config = *config;
+
+		if (iot_os_mutex_init(&batch->lock) != IOT_OS_TRUE) {
+			IOT_ERROR("failed to init event batch lock");
+			iot_os_free(batch);
+			return IOT_ERROR_MEM_ALLOC;
+		}
+
+		/* Zero window means events are only batched within one send call */
+		if (config->window_ms) {
+			batch->timer = iot_os_timer_create(_iot_evt_batch_window_cb, config->window_ms, ctx);
+			if (batch->timer == NULL) {
+				IOT_ERROR("failed to create event batch timer");
+				iot_os_mutex_destroy(&batch->lock);
+				iot_os_free(batch);
+				return IOT_ERROR_MEM_ALLOC;
+			}
+		}
+	}
+
+	if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		IOT_ERROR("failed to lock evt_lock");
+		_iot_evt_batch_free(batch);
+		return IOT_ERROR_BAD_REQ;
+	}
+	old_batch = _iot_evt_batch_detach(ctx);
+	ctx->evt_batch = batch;
+	iot_os_mutex_unlock(&ctx->evt_lock);
+
+	_iot_evt_batch_free(old_batch);
+
+	return IOT_ERROR_NONE;
+}
+
+static size_t _iot_attr_cache_put(uint8_t *record, size_t pos, const void *data, size_t len)
+{
+	if (record) {
+		memcpy(record + pos, data, len);
+	}
+
+	return pos + len;
+}
+
+static size_t _iot_attr_cache_put_string(uint8_t *record, size_t pos, const char *string)
+{
+	if (string == NULL) {
+		string = "";
+	}
+
+	return _iot_attr_cache_put(record, pos, string, strlen(string) + 1);
+}
+
+/* Writes key and state of event into record, or only measures them if record is NULL.
+ * Returns 0 for event whose state can't be compared */
+static size_t _iot_attr_cache_build(void *event, bool is_v2, uint8_t *record,
+			iot_attr_cache_entry_t *entry)
+{
+	iot_cap_evt_data_t *evt_data;
+	st_attr_data *attr_data;
+	const char *unit, *data;
+	uint8_t tag, boolean;
+	size_t pos = 0;
+	int i;
+
+	entry->numeric = false;
+	if (is_v2) {
+		attr_data = (st_attr_data *)event;
+		pos = _iot_attr_cache_put_string(record, pos, (attr_data->component_type == ST_COMPONENT_CUSTOM) ?
+				attr_data->custom_component_name : "main");
+		pos = _iot_attr_cache_put_string(record, pos, attr_data->custom_cap_name);
+		pos = _iot_attr_cache_put_string(record, pos, attr_data->custom_attr_name);
+		entry->key_len = pos;
+
+		tag = (uint8_t)attr_data->value.data_type;
+		pos = _iot_attr_cache_put(record, pos, &tag, 1);
+		switch (attr_data->value.data_type) {
+		case ST_DATA_TYPE_STRING:
+			pos = _iot_attr_cache_put_string(record, pos, attr_data->value.data.string);
+			break;
+		case ST_DATA_TYPE_NUMBER:
+			entry->numeric = true;
+			entry->number = attr_data->value.data.number;
+			break;
+		case ST_DATA_TYPE_BOOLEAN:
+			boolean = attr_data->value.data.boolean ? 1 : 0;
+			pos = _iot_attr_cache_put(record, pos, &boolean, 1);
+			break;
+		case ST_DATA_TYPE_RAW_JSON:
+			pos = _iot_attr_cache_put_string(record, pos, attr_data->value.data.raw_json);
+			break;
+		case ST_DATA_TYPE_NULL:
+			break;
+		default:
+			return 0;
+		}
+		unit = attr_data->unit;
+		data = attr_data->data;
+	} else {
+		evt_data = (iot_cap_evt_data_t *)event;
+		pos = _iot_attr_cache_put_string(record, pos, evt_data->ref_cap->component);
+		pos = _iot_attr_cache_put_string(record, pos, evt_data->ref_cap->capability);
+		pos = _iot_attr_cache_put_string(record, pos, evt_data->evt_type);
+		entry->key_len = pos;
+
+		tag = (uint8_t)evt_data->evt_value.type;
+		pos = _iot_attr_cache_put(record, pos, &tag, 1);
+		switch (evt_data->evt_value.type) {
+		case IOT_CAP_VAL_TYPE_INTEGER:
+			entry->numeric = true;
+			entry->number = evt_data->evt_value.integer;
+			break;
+		case IOT_CAP_VAL_TYPE_NUMBER:
+			entry->numeric = true;
+			entry->number = evt_data->evt_value.number;
+			break;
+		case IOT_CAP_VAL_TYPE_STRING:
+			pos = _iot_attr_cache_put_string(record, pos, evt_data->evt_value.string);
+			break;
+		case IOT_CAP_VAL_TYPE_STR_ARRAY:
+			pos = _iot_attr_cache_put(record, pos, &evt_data->evt_value.str_num, 1);
+			for (i = 0; i < evt_data->evt_value.str_num; i++) {
+				pos = _iot_attr_cache_put_string(record, pos, evt_data->evt_value.strings[i]);
+			}
+			break;
+		case IOT_CAP_VAL_TYPE_JSON_OBJECT:
+			pos = _iot_attr_cache_put_string(record, pos, evt_data->evt_value.json_object);
+			break;
+		case IOT_CAP_VAL_TYPE_BOOLEAN:
+			boolean = evt_data->evt_value.boolean ? 1 : 0;
+			pos = _iot_attr_cache_put(record, pos, &boolean, 1);
+			break;
+		default:
+			return 0;
+		}
+		unit = (evt_data->evt_unit.type == IOT_CAP_UNIT_TYPE_STRING) ? evt_data->evt_unit.string : NULL;
+		data = evt_data->evt_value_data;
+	}
+
+	pos = _iot_attr_cache_put_string(record, pos, unit);
+	pos = _iot_attr_cache_put_string(record, pos, data);
+
+	return pos;
+}
+
+/* Leaves record NULL if event state can't be kept */
+static void _iot_attr_cache_new_entry(void *event, bool is_v2, iot_attr_cache_entry_t *entry)
+{
+	memset(entry, '\0', sizeof(iot_attr_cache_entry_t));
+
+	entry->len = _iot_attr_cache_build(event, is_v2, NULL, entry);
+	if (entry->len == 0) {
+		return;
+	}
+
+	entry->record = (uint8_t *)iot_os_malloc(entry->len);
+	if (entry->record == NULL) {
+		IOT_WARN("failed to malloc for attribute state, it is sent anyway");
+		return;
+	}
+	_iot_attr_cache_build(event, is_v2, entry->record, entry);
+	entry->key_hash = _iot_evt_batch_hash((const char *)entry->record, entry->key_len);
+}
+
+static bool _iot_attr_cache_forced(void *event, bool is_v2)
+{
+	iot_cap_evt_data_t *evt_data;
+	st_attr_data *attr_data;
+
+	if (is_v2) {
+		attr_data = (st_attr_data *)event;
+		return attr_data->state_change || attr_data->related_command_id;
+	}
+
+	evt_data = (iot_cap_evt_data_t *)event;
+	return evt_data->options.state_change || evt_data->options.command_id;
+}
+
+/* Caller holds evt_lock */
+static iot_attr_cache_entry_t *_iot_attr_cache_find(iot_attr_cache_t *cache, const iot_attr_cache_entry_t *key)
+{
+	iot_attr_cache_entry_t *entry;
+	unsigned int i;
+
+	for (i = 0; i < cache->config.max_entries; i++) {
+		entry = &cache->entries[i];
+		if (entry->record && entry->key_hash == key->key_hash && entry->key_len == key->key_len &&
+				!memcmp(entry->record, key->record, key->key_len)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Caller holds evt_lock, found is the cached entry of same attribute or NULL */
+static iot_attr_cache_verdict_t _iot_attr_cache_check(iot_attr_cache_t *cache,
+			const iot_attr_cache_entry_t *new_entry, unsigned int now, iot_attr_cache_entry_t **found)
+{
+	iot_attr_cache_entry_t *entry = _iot_attr_cache_find(cache, new_entry);
+	double diff;
+
+	*found = entry;
+	if (entry == NULL || entry->numeric != new_entry->numeric || entry->len != new_entry->len ||
+			memcmp(entry->record + entry->key_len, new_entry->record + new_entry->key_len,
+				entry->len - entry->key_len)) {
+		return IOT_ATTR_CACHE_SEND;
+	}
+
+	if (!new_entry->numeric) {
+		return IOT_ATTR_CACHE_SUPPRESS;
+	}
+
+	diff = new_entry->number - entry->number;
+	if (diff < 0) {
+		diff = -diff;
+	}
+	if (diff <= cache->config.deadband) {
+		return IOT_ATTR_CACHE_SUPPRESS;
+	}
+
+	/* Changed, but sent recently */
+	if (cache->config.min_interval_ms && (now - entry->sent_ms) < cache->config.min_interval_ms) {
+		return IOT_ATTR_CACHE_DEFER;
+	}
+
+	return IOT_ATTR_CACHE_SEND;
+}
+
+/* Caller holds evt_lock, held back event is replaced by a newer state */
+static void _iot_attr_cache_drop_pending(iot_attr_cache_t *cache, iot_attr_cache_entry_t *entry)
+{
+	if (entry == NULL || entry->pending.data == NULL) {
+		return;
+	}
+
+	iot_os_free(entry->pending.data);
+	entry->pending.data = NULL;
+	cache->suppressed++;
+}
+
+static bool _iot_attr_cache_due(iot_attr_cache_t *cache, const iot_attr_cache_entry_t *entry,
+			unsigned int now)
+{
+	return (now - entry->sent_ms) >= cache->config.min_interval_ms;
+}
+
+/* Caller holds evt_lock, timer is only moved earlier while it is armed */
+static iot_error_t _iot_attr_cache_arm(iot_attr_cache_t *cache, unsigned int due_ms, unsigned int now)
+{
+	unsigned int delay = (int)(due_ms - now) > 0 ? due_ms - now : 1;
+
+	if (cache->armed && (int)(due_ms - cache->due_ms) >= 0) {
+		return IOT_ERROR_NONE;
+	}
+
+	if (iot_os_timer_change_period(cache->timer, delay)) {
+		IOT_WARN("Fail to start attribute cache timer");
+		return IOT_ERROR_BAD_REQ;
+	}
+	cache->armed = true;
+	cache->due_ms = due_ms;
+
+	return IOT_ERROR_NONE;
+}
+
+/* Caller holds evt_lock, event is serialized now as it may be freed after send call */
+static iot_error_t _iot_attr_cache_defer(iot_attr_cache_t *cache, iot_attr_cache_entry_t *entry,
+			void *event, bool is_v2, double number, int seq_num, unsigned int now)
+{
+	iot_evt_encoded_t pending;
+	iot_error_t err;
+
+	err = _iot_encode_evt_payload(&event, 1, is_v2, false, seq_num, &pending.data, &pending.len);
+	if (err != IOT_ERROR_NONE) {
+		return err;
+	}
+	pending.seq_num = seq_num;
+
+	err = _iot_attr_cache_arm(cache, entry->sent_ms + cache->config.min_interval_ms, now);
+	if (err != IOT_ERROR_NONE) {
+		iot_os_free(pending.data);
+		return err;
+	}
+
+	_iot_attr_cache_drop_pending(cache, entry);
+	entry->pending = pending;
+	entry->pending_number = number;
+
+	return IOT_ERROR_NONE;
+}
+
+/* Caller holds evt_lock, record of new_entry is taken */
+static void _iot_attr_cache_store(iot_attr_cache_t *cache, iot_attr_cache_entry_t *new_entry, unsigned int now)
+{
+	iot_attr_cache_entry_t *entry = _iot_attr_cache_find(cache, new_entry);
+	iot_attr_cache_entry_t *slot;
+	unsigned int i;
+
+	if (entry == NULL) {
+		for (i = 0; i < cache->config.max_entries; i++) {
+			slot = &cache->entries[i];
+			if (slot->record == NULL) {
+				entry = slot;
+				cache->count++;
+				break;
+			}
+			/* Full, least recently sent attribute without held back event gives its slot */
+			if (entry == NULL || (entry->pending.data && !slot->pending.data) ||
+					(!entry->pending.data == !slot->pending.data &&
+					(now - slot->sent_ms) > (now - entry->sent_ms))) {
+				entry = slot;
+			}
+		}
+	}
+
+	_iot_attr_cache_drop_pending(cache, entry);
+	if (entry->record) {
+		iot_os_free(entry->record);
+	}
+	*entry = *new_entry;
+	entry->sent_ms = now;
+	new_entry->record = NULL;
+}
+
+/* Caller holds evt_lock, publishes held back events which are due or all of them */
+static void _iot_attr_cache_flush(struct iot_context *ctx, iot_attr_cache_t *cache, bool all)
+{
+	iot_attr_cache_entry_t *entry;
+	iot_evt_encoded_t *records = NULL;
+	unsigned int now = iot_os_get_tick_ms();
+	unsigned int count = 0, due_ms = 0;
+	bool published = false, stored = false, rearm = false;
+	unsigned int i;
+
+	if (cache->timer) {
+		iot_os_timer_stop(cache->timer);
+	}
+	cache->armed = false;
+
+	for (i = 0; i < cache->config.max_entries; i++) {
+		entry = &cache->entries[i];
+		if (entry->pending.data == NULL) {
+			continue;
+		}
+		if (all || _iot_attr_cache_due(cache, entry, now)) {
+			count++;
+		} else if (!rearm || (int)(entry->sent_ms + cache->config.min_interval_ms - due_ms) < 0) {
+			due_ms = entry->sent_ms + cache->config.min_interval_ms;
+			rearm = true;
+		}
+	}
+
+	if (count) {
+		records = (iot_evt_encoded_t *)iot_os_malloc(sizeof(iot_evt_encoded_t) * count);
+		if (records == NULL) {
+			IOT_ERROR("failed to malloc for %u held back events", count);
+		}
+	}
+
+	if (records) {
+		for (i = 0, count = 0; i < cache->config.max_entries; i++) {
+			entry = &cache->entries[i];
+			if (entry->pending.data && (all || _iot_attr_cache_due(cache, entry, now))) {
+				records[count++] = entry->pending;
+			}
+		}
+
+		if (ctx->evt_offline && (!_iot_evt_can_publish(ctx) || _iot_evt_offline_pending(ctx->evt_offline))) {
+			/* Serialized events belong to offline buffer from now */
+			_iot_evt_offline_store_records(ctx, records, count);
+			stored = true;
+		} else if (ctx->curr_state != IOT_STATE_CLOUD_CONNECTED || ctx->evt_mqttcli == NULL) {
+			IOT_WARN("Drop %u held back events, target is not connected", count);
+			_iot_evt_report_dropped(ctx, records, count);
+		} else if (ctx->rate_limit) {
+			IOT_WARN("Drop %u held back events, exceed rate limit", count);
+			_iot_evt_report_dropped(ctx, records, count);
+		} else if (_iot_evt_publish_encoded(ctx, records, count) == IOT_ERROR_NONE) {
+			published = true;
+		} else {
+			_iot_evt_report_dropped(ctx, records, count);
+		}
+		iot_os_free(records);
+	}
+
+	for (i = 0; i < cache->config.max_entries && count; i++) {
+		entry = &cache->entries[i];
+		if (entry->pending.data == NULL || !(all || _iot_attr_cache_due(cache, entry, now))) {
+			continue;
+		}
+		if (!stored) {
+			iot_os_free(entry->pending.data);
+		}
+		entry->pending.data = NULL;
+		if (stored || published) {
+			entry->number = entry->pending_number;
+			entry->sent_ms = now;
+			cache->sent++;
+		}
+	}
+
+	if (rearm) {
+		_iot_attr_cache_arm(cache, due_ms, now);
+	}
+}
+
+/* Cache is looked up under evt_lock, st_conn_set_attr_cache() may replace it meanwhile */
+static void _iot_attr_cache_flush_work(struct iot_context *ctx, device_work_param param)
+{
+	iot_attr_cache_t *cache;
+
+	if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		return;
+	}
+	cache = ctx->attr_cache;
+	if (cache) {
+		cache->flush_queued = false;
+		_iot_attr_cache_flush(ctx, cache, false);
+	}
+	iot_os_mutex_unlock(&ctx->evt_lock);
+}
+
+static void _iot_attr_cache_interval_cb(iot_os_timer_handle handle, void *user_data)
+{
+	struct iot_context *ctx = (struct iot_context *)user_data;
+	iot_attr_cache_t *cache;
+
+	/* Publish from device work thread, not from timer context */
+	if (ctx->work_queue == NULL) {
+		_iot_attr_cache_flush_work(ctx, NULL);
+		return;
+	}
+
+	if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		return;
+	}
+	cache = ctx->attr_cache;
+	if (cache && !cache->flush_queued &&
+			iot_put_device_work(ctx, _iot_attr_cache_flush_work, NULL) == IOT_ERROR_NONE) {
+		cache->flush_queued = true;
+	}
+	iot_os_mutex_unlock(&ctx->evt_lock);
+}
+
+/* Caller holds evt_lock, held back events are published before cache goes away */
+static iot_attr_cache_t *_iot_attr_cache_detach(struct iot_context *ctx)
+{
+	iot_attr_cache_t *cache = ctx->attr_cache;
+
+	if (cache == NULL) {
+		return NULL;
+	}
+
+	_iot_attr_cache_flush(ctx, cache, true);
+	ctx->attr_cache = NULL;
+
+	return cache;
+}
+
+/* Called without evt_lock, interval callback may be waiting for it */
+static void _iot_attr_cache_free(iot_attr_cache_t *cache)
+{
+	unsigned int i;
+
+	if (cache == NULL) {
+		return;
+	}
+
+	if (cache->timer) {
+		iot_os_timer_delete(cache->timer);
+	}
+	for (i = 0; i < cache->config.max_entries; i++) {
+		if (cache->entries[i].record) {
+			iot_os_free(cache->entries[i].record);
+		}
+		if (cache->entries[i].pending.data) {
+			iot_os_free(cache->entries[i].pending.data);
+		}
+	}
+	iot_os_free(cache->entries);
+	iot_os_free(cache);
+}
+
+int st_conn_set_attr_cache(IOT_CTX *iot_ctx, const st_attr_cache_config *config)
+{
+	struct iot_context *ctx = (struct iot_context *)iot_ctx;
+	iot_attr_cache_t *cache = NULL;
+	iot_attr_cache_t *old_cache;
+
+	if (!ctx || (config && (config->max_entries == 0 || config->deadband < 0))) {
+		IOT_ERROR("There is no ctx or invalid config");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	if (config) {
+		cache = (iot_attr_cache_t *)iot_os_malloc(sizeof(iot_attr_cache_t));
+		if (cache == NULL) {
+			IOT_ERROR("failed to malloc for attribute cache");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+		memset(cache, '\0', sizeof(iot_attr_cache_t));
+		cache->config = *config;
+
+		cache->entries = (iot_attr_cache_entry_t *)iot_os_malloc(sizeof(iot_attr_cache_entry_t) * config->max_entries);
+		if (cache->entries == NULL) {
+			IOT_ERROR("failed to malloc for attribute cache entries");
+			iot_os_free(cache);
+			return IOT_ERROR_MEM_ALLOC;
+		}
+		memset(cache->entries, '\0', sizeof(iot_attr_cache_entry_t) * config->max_entries);
+
+		/* Changes held back by min_interval_ms are published when it passes */
+		if (config->min_interval_ms) {
+			cache->timer = iot_os_timer_create(_iot_attr_cache_interval_cb, config->min_interval_ms, ctx);
+			if (cache->timer == NULL) {
+				IOT_ERROR("failed to create attribute cache timer");
+				_iot_attr_cache_free(cache);
+				return IOT_ERROR_MEM_ALLOC;
+			}
+		}
+	}
+
+	if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		IOT_ERROR("failed to lock evt_lock");
+		_iot_attr_cache_free(cache);
+		return IOT_ERROR_BAD_REQ;
+	}
+	old_cache = _iot_attr_cache_detach(ctx);
+	ctx->attr_cache = cache;
+	iot_os_mutex_unlock(&ctx->evt_lock);
+
+	_iot_attr_cache_free(old_cache);
+
+	return IOT_ERROR_NONE;
+}
+
+int st_conn_get_attr_cache_stats(IOT_CTX *iot_ctx, st_attr_cache_stats *stats)
+{
+	struct iot_context *ctx = (struct iot_context *)iot_ctx;
+	iot_attr_cache_t *cache;
+	int ret = IOT_ERROR_NONE;
+
+	if (!ctx || !stats) {
+		IOT_ERROR("There is no ctx or stats");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+		return IOT_ERROR_BAD_REQ;
+	}
+	cache = ctx->attr_cache;
+	if (cache) {
+		stats->sent = cache->sent;
+		stats->suppressed = cache->suppressed;
+		stats->entries = cache->count;
+	} else {
+		IOT_ERROR("There is no attribute cache");
+		ret = IOT_ERROR_INVALID_ARGS;
+	}
+	iot_os_mutex_unlock(&ctx->evt_lock);
+
+	return ret;
+}
+
+/* Caller validated events already */
+static int _iot_cap_send_events(struct iot_context *ctx, void **events, uint8_t evt_num, bool is_v2)
+{
+	st_mqtt_msg msg = {0};
+	uint8_t *payload;
+	size_t payload_len;
+	int ret;
+
+	/* Checked again under evt_lock, batching or buffering may be turned off meanwhile */
+	if (ctx->evt_batch || ctx->evt_offline) {
+		if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+			IOT_ERROR("Fail to lock evt_lock");
+			return IOT_ERROR_BAD_REQ;
+		}
+		if (ctx->evt_batch) {
+			ret = _iot_evt_batch_add(ctx, events, evt_num, is_v2, ctx->event_sequence_num);
+			iot_os_mutex_unlock(&ctx->evt_lock);
+			if (ret != IOT_ERROR_NONE) {
+				IOT_ERROR("Fail to queue events for batch");
+				return IOT_ERROR_BAD_REQ;
+			}
+			return ctx->event_sequence_num;
+		}
+
+		/* Keep order behind events which are not replayed yet */
+		if (ctx->evt_offline && (!_iot_evt_can_publish(ctx) || _iot_evt_offline_pending(ctx->evt_offline))) {
+			ret = _iot_evt_offline_add(ctx, events, evt_num, is_v2, ctx->event_sequence_num);
+			iot_os_mutex_unlock(&ctx->evt_lock);
+			if (ret != IOT_ERROR_NONE) {
+				IOT_ERROR("Fail to buffer events while offline");
+				return IOT_ERROR_BAD_REQ;
+			}
+			return ctx->event_sequence_num;
+		}
+		iot_os_mutex_unlock(&ctx->evt_lock);
+	}
+
+	/* Caller let it through for offline buffer which may be turned off meanwhile */
+	if (ctx->curr_state != IOT_STATE_CLOUD_CONNECTED || ctx->evt_mqttcli == NULL) {
+		IOT_ERROR("Target has not connected to server yet!!");
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	/* Make event data format & enqueue data */
+	if (_iot_encode_evt_payload(events, evt_num, is_v2, true,
+			ctx->event_sequence_num, &payload, &payload_len) != IOT_ERROR_NONE) {
+		IOT_ERROR("Fail to transfer to payload");
+		return IOT_ERROR_BAD_REQ;
+	}
+	msg.qos = st_mqtt_qos1;
+	msg.retained = false;
+	msg.topic = ctx->mqtt_event_topic;
+	msg.payload = payload;
+	msg.payloadlen = payload_len;
+
+	IOT_INFO("publish event, topic : %s, payload :\n%s",
+		ctx->mqtt_event_topic, (char *)msg.payload);
+
+	ret = st_mqtt_publish_async(ctx->evt_mqttcli, &msg);
+	if (ret) {
+		IOT_WARN("MQTT pub error(%d)", ret);
+		iot_os_free(msg.payload);
+		return IOT_ERROR_MQTT_PUBLISH_FAIL;
+	}
+
+	IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_SEND_EVENT_SUCCESS, evt_num, 0);
+
+	iot_os_free(msg.payload);
+	return ctx->event_sequence_num;
+}
+
+static int _iot_cap_send_attr_events(struct iot_context *ctx, void **events, uint8_t evt_num, bool is_v2)
+{
+	iot_attr_cache_t *cache = NULL;
+	iot_attr_cache_entry_t *entries = NULL;
+	iot_attr_cache_entry_t *entry, *found = NULL;
+	iot_attr_cache_verdict_t verdict;
+	void **sent_events = NULL;
+	unsigned int now = 0;
+	int seq_num = ctx->event_sequence_num;
+	int sent_num = 0, deferred_num = 0;
+	int ret, i;
+
+	if (seq_num == MAX_SQNUM) {
+		seq_num = 0;
+	}
+	seq_num = (seq_num + 1) & MAX_SQNUM;
+
+	/* Peeked only to skip allocation, cache is read again under evt_lock */
+	if (ctx->attr_cache) {
+		entries = (iot_attr_cache_entry_t *)iot_os_malloc(sizeof(iot_attr_cache_entry_t) * evt_num);
+		sent_events = (void **)iot_os_malloc(sizeof(void *) * evt_num);
+		if (entries == NULL || sent_events == NULL) {
+			IOT_ERROR("failed to malloc for attribute cache check");
+			ret = IOT_ERROR_MEM_ALLOC;
+			goto exit;
+		}
+		memset(entries, '\0', sizeof(iot_attr_cache_entry_t) * evt_num);
+		if (iot_os_mutex_lock(&ctx->evt_lock) != IOT_OS_TRUE) {
+			IOT_ERROR("Fail to lock evt_lock");
+			ret = IOT_ERROR_BAD_REQ;
+			goto exit;
+		}
+
+		cache = ctx->attr_cache;
+		now = iot_os_get_tick_ms();
+		for (i = 0; i < evt_num; i++) {
+			entry = &entries[sent_num];
+			verdict = IOT_ATTR_CACHE_SEND;
+			if (cache) {
+				_iot_attr_cache_new_entry(events[i], is_v2, entry);
+				if (entry->record && !_iot_attr_cache_forced(events[i], is_v2)) {
+					verdict = _iot_attr_cache_check(cache, entry, now, &found);
+				}
+			}
+
+			if (verdict == IOT_ATTR_CACHE_DEFER && _iot_attr_cache_defer(cache, found, events[i],
+					is_v2, entry->number, seq_num, now) != IOT_ERROR_NONE) {
+				IOT_WARN("Fail to hold back changed event, it is sent now");
+				verdict = IOT_ATTR_CACHE_SEND;
+			}
+
+			if (verdict == IOT_ATTR_CACHE_SEND) {
+				sent_events[sent_num++] = events[i];
+				continue;
+			}
+
+			iot_os_free(entry->record);
+			entry->record = NULL;
+			if (verdict == IOT_ATTR_CACHE_SUPPRESS) {
+				/* Held back change is superseded by state which was sent already */
+				_iot_attr_cache_drop_pending(cache, found);
+				cache->suppressed++;
+			} else {
+				deferred_num++;
+			}
+		}
+		iot_os_mutex_unlock(&ctx->evt_lock);
+
+		if (sent_num == 0) {
+			if (deferred_num) {
+				IOT_DEBUG("Hold back %d changed events", deferred_num);
+				ctx->event_sequence_num = seq_num;
+				ret = seq_num;
+			} else {
+				IOT_DEBUG("Suppress %d unchanged events", evt_num);
+				ret = 0;
+			}
+			goto exit;
+		}
+		events = sent_events;
+		evt_num = (uint8_t)sent_num;
+	}
+
+	ctx->event_sequence_num = seq_num;
+
+	ret = _iot_cap_send_events(ctx, events, evt_num, is_v2);
+
+	/* Only states which were sent are kept, cache may be replaced meanwhile */
+	if (cache && iot_os_mutex_lock(&ctx->evt_lock) == IOT_OS_TRUE) {
+		cache = ctx->attr_cache;
+		for (i = 0; i < sent_num; i++) {
+			if (cache && ret > 0 && entries[i].record) {
+				_iot_attr_cache_store(cache, &entries[i], now);
+			}
+			if (entries[i].record) {
+				iot_os_free(entries[i].record);
+			}
+		}
+		if (cache && ret > 0) {
+			cache->sent += sent_num;
+		}
+		iot_os_mutex_unlock(&ctx->evt_lock);
+		sent_num = 0;
+	}
+
+exit:
+	for (i = 0; i < sent_num; i++) {
+		if (entries[i].record) {
+			iot_os_free(entries[i].record);
+		}
+	}
+	if (entries) {
+		iot_os_free(entries);
+	}
+	if (sent_events) {
+		iot_os_free(sent_events);
+	}
+
+	return ret;
+}
+
+int st_cap_send_attr(IOT_EVENT *event[], uint8_t evt_num)
+{
+	iot_cap_evt_data_t** evt_data = (iot_cap_evt_data_t**)event;
+	struct iot_context *ctx = NULL;
+	int i;
+
+	if (!evt_data || !evt_num || !evt_data[0] || !evt_data[0]->ref_cap || !evt_data[0]->ref_cap->ctx) {
+		IOT_DUMP(IOT_DEBUG_LEVEL_ERROR, IOT_DUMP_CAPABILITY_SEND_EVENT_NO_DATA_ERROR, 0, 0);
+		IOT_ERROR("There is no ctx or evt_data");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+	ctx = evt_data[0]->ref_cap->ctx;
+
+	if ((ctx->curr_state != IOT_STATE_CLOUD_CONNECTED || ctx->evt_mqttcli == NULL) && !ctx->evt_offline) {
+		IOT_DUMP(IOT_DEBUG_LEVEL_ERROR, IOT_DUMP_CAPABILITY_SEND_EVENT_NO_CONNECT_ERROR, ctx->curr_state, 0);
+		IOT_ERROR("Target has not connected to server yet!!");
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	if (ctx->rate_limit && !ctx->evt_offline) {
+		IOT_WARN("Exceed rate limit. Can't send attributes for a while");
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	for (i = 0; i < evt_num; i++) {
+		if (!evt_data[i] || !(evt_data[i]->ref_cap) || ctx != evt_data[i]->ref_cap->ctx) {
+			IOT_ERROR("There si no capability reference in event data or ctx not matched");
+			return IOT_ERROR_BAD_REQ;
+		}
+	}
+
+	return _iot_cap_send_attr_events(ctx, (void **)evt_data, evt_num, false);
+}
+
+static bool _iot_caps_has_value(const char *const *values, unsigned int values_num, const char *value)
+{
+	unsigned int i;
+
+	if (value == NULL) {
+		return false;
+	}
+
+	for (i = 0; i < values_num; i++) {
+		if (!strcmp(values[i], value)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static iot_error_t _iot_caps_validate_string(const iot_caps_attr_desc_t *desc, const char *string)
+{
+	if (string == NULL) {
+		IOT_ERROR("%s.%s : no string value", desc->capability, desc->name);
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	if ((desc->property & ATTR_SET_MAX_LENGTH) && strlen(string) > desc->max_length) {
+		IOT_ERROR("%s.%s : longer than %u", desc->capability, desc->name, desc->max_length);
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	if (desc->values_num && !_iot_caps_has_value(desc->values, desc->values_num, string)) {
+		IOT_ERROR("%s.%s : '%s' is not allowed", desc->capability, desc->name, string);
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	return IOT_ERROR_NONE;
+}
+
+iot_error_t iot_caps_validate_attr(const iot_caps_attr_desc_t *desc,
+		const iot_cap_val_t *value, const char **unit)
+{
+	iot_error_t err;
+	double number;
+	int i;
+
+	if (!desc || !value || !unit) {
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	if (desc->value_type == VALUE_TYPE_OBJECT ||
+			((desc->property & ATTR_SET_VALUE_ARRAY) && desc->value_type != VALUE_TYPE_STRING)) {
+		if (value->type != IOT_CAP_VAL_TYPE_JSON_OBJECT || value->json_object == NULL) {
+			goto type_mismatch;
+		}
+	} else if (desc->property & ATTR_SET_VALUE_ARRAY) {
+		if (value->type != IOT_CAP_VAL_TYPE_STR_ARRAY || (value->str_num && value->strings == NULL)) {
+			goto type_mismatch;
+		}
+		for (i = 0; i < value->str_num; i++) {
+			err = _iot_caps_validate_string(desc, value->strings[i]);
+			if (err != IOT_ERROR_NONE) {
+				return err;
+			}
+		}
+	} else if (desc->value_type == VALUE_TYPE_STRING) {
+		if (value->type != IOT_CAP_VAL_TYPE_STRING) {
+			goto type_mismatch;
+		}
+		err = _iot_caps_validate_string(desc, value->string);
+		if (err != IOT_ERROR_NONE) {
+			return err;
+		}
+	} else if (desc->value_type == VALUE_TYPE_BOOLEAN) {
+		if (value->type != IOT_CAP_VAL_TYPE_BOOLEAN) {
+			goto type_mismatch;
+		}
+	} else {
+		if (value->type == IOT_CAP_VAL_TYPE_INTEGER) {
+			number = value->integer;
+		} else if (value->type == IOT_CAP_VAL_TYPE_NUMBER && desc->value_type == VALUE_TYPE_NUMBER) {
+			number = value->number;
+		} else {
+			goto type_mismatch;
+		}
+
+		if (((desc->property & ATTR_SET_VALUE_MIN) && number < desc->min) ||
+				((desc->property & ATTR_SET_VALUE_MAX) && number > desc->max)) {
+			IOT_ERROR("%s.%s : %f is out of range", desc->capability, desc->name, number);
+			return IOT_ERROR_INVALID_ARGS;
+		}
+	}
+
+	if (*unit == NULL) {
+		if (desc->units_num == 1) {
+			*unit = desc->units[0];
+		} else if (desc->property & ATTR_SET_UNIT_REQUIRED) {
+			IOT_ERROR("%s.%s : unit is required", desc->capability, desc->name);
+			return IOT_ERROR_INVALID_ARGS;
+		}
+	} else if (!_iot_caps_has_value(desc->units, desc->units_num, *unit)) {
+		IOT_ERROR("%s.%s : unit '%s' is not allowed", desc->capability, desc->name, *unit);
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	return IOT_ERROR_NONE;
 
-	evt_root = JSON_CREATE_OBJECT();
-	evt_arr = JSON_CREATE_ARRAY();
+type_mismatch:
+	IOT_ERROR("%s.%s : value type %d is not allowed", desc->capability, desc->name, value->type);
+	return IOT_ERROR_INVALID_ARGS;
+}
 
-	JSON_ADD_ITEM_TO_OBJECT(evt_root, "deviceEvents", evt_arr);
+int st_cap_send_attr_desc(IOT_CAP_HANDLE *cap_handle, unsigned int attr_id,
+			const iot_cap_val_t *value, const char *unit)
+{
+	struct iot_cap_handle *handle = (struct iot_cap_handle *)cap_handle;
+	const iot_caps_attr_desc_t *desc;
+	iot_cap_evt_data_t evt_data;
+	IOT_EVENT *event[1];
 
-	/* Make event data format & enqueue data */
-	for (i = 0; i < evt_num; i++) {
-		if (!evt_data[i] || !(evt_data[i]->ref_cap) || ctx != evt_data[i]->ref_cap->ctx) {
-			IOT_ERROR("There si no capability reference in event data or ctx not matched");
-			JSON_DELETE(evt_root);
-			return IOT_ERROR_BAD_REQ;
-		}
-		evt_item = _iot_make_evt_data(evt_data[i]->ref_cap->component, evt_data[i]->ref_cap->capability,
-				evt_data[i], ctx->event_sequence_num);
-		if (evt_item == NULL) {
-			IOT_ERROR("Cannot make evt_data!!");
-			JSON_DELETE(evt_root);
-			return IOT_ERROR_BAD_REQ;
-		}
-		JSON_ADD_ITEM_TO_ARRAY(evt_arr, evt_item);
+	if (!handle || !handle->capability || !value || attr_id >= IOT_CAPS_ATTR_MAX) {
+		IOT_ERROR("Invalid argument. attr_id : %u", attr_id);
+		return IOT_ERROR_INVALID_ARGS;
 	}
+	desc = &iot_caps_attr_descs[attr_id];
 
-#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
-	iot_serialize_json2cbor(evt_root, (uint8_t **)&msg.payload, (size_t *)&msg.payloadlen);
-#else
-	msg.payload = JSON_PRINT(evt_root);
-	if (msg.payload != NULL) {
-		msg.payloadlen = strlen(msg.payload);
-	}
-#endif
-	JSON_DELETE(evt_root);
-	if (msg.payload == NULL) {
-		IOT_ERROR("Fail to transfer to payload");
-		return IOT_ERROR_BAD_REQ;
+	if (strcmp(handle->capability, desc->capability)) {
+		IOT_ERROR("%s is not an attribute of %s", desc->name, handle->capability);
+		return IOT_ERROR_INVALID_ARGS;
 	}
-	msg.qos = st_mqtt_qos1;
-	msg.retained = false;
-	msg.topic = ctx->mqtt_event_topic;
-
-	IOT_INFO("publish event, topic : %s, payload :\n%s",
-		ctx->mqtt_event_topic, (char *)msg.payload);
 
-	ret = st_mqtt_publish_async(ctx->evt_mqttcli, &msg);
-	if (ret) {
-		IOT_WARN("MQTT pub error(%d)", ret);
-		free(msg.payload);
-		return IOT_ERROR_MQTT_PUBLISH_FAIL;
+	if (iot_caps_validate_attr(desc, value, &unit) != IOT_ERROR_NONE) {
+		return IOT_ERROR_INVALID_ARGS;
 	}
 
-	IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_SEND_EVENT_SUCCESS, evt_num, 0);
+	/* Event is serialized before returning, so everything is borrowed */
+	memset(&evt_data, 0, sizeof(iot_cap_evt_data_t));
+	evt_data.ref_cap = handle;
+	evt_data.evt_type = desc->name;
+	evt_data.evt_value = *value;
+	if (unit) {
+		evt_data.evt_unit.type = IOT_CAP_UNIT_TYPE_STRING;
+		evt_data.evt_unit.string = (char *)unit;
+	}
+	evt_data.desc = desc;
+	event[0] = (IOT_EVENT *)&evt_data;
 
-	free(msg.payload);
-	return ctx->event_sequence_num;
+	return st_cap_send_attr(event, 1);
 }
 
 STATIC_FUNCTION
@@ -674,6 +2657,28 @@ static void _iot_noti_rate_limit_cb(iot_os_timer_handle handle, void *user_data)
 	IOT_INFO("Timeout");
 
 	ctx->rate_limit = false;
+	if (iot_os_mutex_lock(&ctx->evt_lock) == IOT_OS_TRUE) {
+		_iot_evt_offline_schedule_replay(ctx);
+		iot_os_mutex_unlock(&ctx->evt_lock);
+	}
+}
+
+void iot_cap_noti_process(struct iot_context *ctx, iot_noti_data_t *noti_data)
+{
+	if (noti_data->type == IOT_NOTI_TYPE_RATE_LIMIT) {
+		if (ctx->rate_limit_timeout) {
+			iot_os_timer_delete(ctx->rate_limit_timeout);
+		}
+		ctx->rate_limit_timeout = iot_os_timer_create(_iot_noti_rate_limit_cb, IOT_RATE_LIMIT_BREAK_TIME, ctx);
+		if (!ctx->rate_limit_timeout) {
+			IOT_ERROR("Failed to create rate limit timeout");
+		} else if(!iot_os_timer_start(ctx->rate_limit_timeout)) {
+			ctx->rate_limit = true;
+		}
+	}
+
+	iot_command_send(ctx, IOT_COMMAND_NOTIFICATION_RECEIVED,
+		noti_data, sizeof(*noti_data));
 }
 
 void iot_noti_sub_cb(struct iot_context *ctx, char *payload)
@@ -694,29 +2699,30 @@ void iot_noti_sub_cb(struct iot_context *ctx, char *payload)
 		IOT_INFO("Ignore notification");
 		return;
 	}
-	if (noti_data.type == IOT_NOTI_TYPE_RATE_LIMIT) {
-		if (ctx->rate_limit_timeout) {
-			iot_os_timer_delete(ctx->rate_limit_timeout);
-		}
-		ctx->rate_limit_timeout = iot_os_timer_create(_iot_noti_rate_limit_cb, IOT_RATE_LIMIT_BREAK_TIME, ctx);
-		if (!ctx->rate_limit_timeout) {
-			IOT_ERROR("Failed to create rate limit timeout");
-		} else if(!iot_os_timer_start(ctx->rate_limit_timeout)) {
-			ctx->rate_limit = true;
-		}
-	}
-
-	iot_command_send(ctx, IOT_COMMAND_NOTIFICATION_RECEIVED,
-		&noti_data, sizeof(noti_data));
+	iot_cap_noti_process(ctx, &noti_data);
 }
 
-static iot_error_t _iot_process_cmd(iot_cap_handle_list_t *cap_handle_list, char *component_name,
-			char *capability_name, char *command_name, iot_cap_cmd_data_t *cmd_data)
+iot_error_t iot_cap_process_cmd(iot_cap_cmd_index_t *cmd_index, iot_cap_handle_list_t *cap_handle_list,
+			char *component_name, char *capability_name, char *command_name, iot_cap_cmd_data_t *cmd_data)
 {
 	struct iot_cap_handle_list *handle_list = NULL;
 	struct iot_cap_handle *handle = NULL;
 	struct iot_cap_cmd_set_list *command_list = NULL;
 	struct iot_cap_cmd_set *command = NULL;
+	iot_cap_cmd_index_entry_t *entry = NULL;
+
+	if (cmd_index && cmd_index->count) {
+		entry = _iot_cap_cmd_index_find(cmd_index, component_name, capability_name, command_name);
+		if (entry == NULL) {
+			IOT_WARN("Not registed cmd set received [%s]%s:%s", component_name, capability_name, command_name);
+			return IOT_ERROR_BAD_REQ;
+		}
+		entry->command->cmd_cb((IOT_CAP_HANDLE *)entry->handle,
+			cmd_data, entry->command->usr_data);
+
+		IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_COMMAND_SUCCEED, 0, 0);
+		return IOT_ERROR_NONE;
+	}
 
 	/* find handle with capability */
 	handle_list = cap_handle_list;
@@ -755,35 +2761,49 @@ static iot_error_t _iot_process_cmd(iot_cap_handle_list_t *cap_handle_list, char
 	return IOT_ERROR_NONE;
 }
 
-void iot_cap_sub_cb(iot_cap_handle_list_t *cap_handle_list, char *payload)
+static JSON_H *_iot_cap_parse_commands(struct iot_context *ctx, iot_arena_t *arena, char *payload, bool *in_arena)
 {
 	JSON_H *json = NULL;
-	JSON_H *cap_cmds = NULL;
-	JSON_H *cmditem = NULL;
-	char *raw_data = NULL;
-	iot_error_t err;
-	int i;
-	int arr_size = 0;
-
-	if (!cap_handle_list || !payload) {
-		IOT_ERROR("There is no cap_handle_list or payload");
-		return;
-	}
 
+	*in_arena = iot_arena_json_begin(arena);
 	json = JSON_PARSE(payload);
+	if (*in_arena) {
+		iot_arena_json_end(arena);
+	}
 	if (json == NULL) {
 		IOT_ERROR("Cannot parse by json");
-		goto out;
+		return NULL;
+	}
+	if (ctx) {
+		ctx->cmd_parsed++;
+	}
+	IOT_INFO("command : %s", payload);
+
+	return json;
+}
+
+/* Ends one command transaction, every decoded piece goes away with arena reset */
+static void _iot_cap_release_commands(iot_arena_t *arena, JSON_H *json, bool in_arena)
+{
+	if (json && !in_arena) {
+		JSON_DELETE(json);
 	}
+	iot_arena_reset(arena);
+}
 
-	raw_data = JSON_PRINT(json);
-	IOT_INFO("command : %s", raw_data);
-	free(raw_data);
+static void _iot_cap_sub_process(iot_arena_t *arena, iot_cap_cmd_index_t *cmd_index,
+			iot_cap_handle_list_t *cap_handle_list, JSON_H *json)
+{
+	JSON_H *cap_cmds = NULL;
+	JSON_H *cmditem = NULL;
+	iot_error_t err;
+	int i;
+	int arr_size = 0;
 
 	cap_cmds = JSON_GET_OBJECT_ITEM(json, "commands");
 	if (cap_cmds == NULL) {
 		IOT_ERROR("there is no commands in raw_data");
-		goto out;
+		return;
 	}
 
 	arr_size = JSON_GET_ARRAY_SIZE(cap_cmds);
@@ -792,7 +2812,7 @@ void iot_cap_sub_cb(iot_cap_handle_list_t *cap_handle_list, char *payload)
 
 	if (arr_size == 0) {
 		IOT_ERROR("There are no commands data");
-		goto out;
+		return;
 	}
 
 	for (i = 0; i < arr_size; i++) {
@@ -814,45 +2834,44 @@ void iot_cap_sub_cb(iot_cap_handle_list_t *cap_handle_list, char *payload)
 		}
 
 		IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_PROCESS_COMMAND, i + 1, 0);
-		err = _iot_parse_cmd_data(cmditem, &component_name, &capability_name, &command_name, &cmd_data);
+		err = _iot_parse_cmd_data(arena, cmditem, &component_name, &capability_name, &command_name, &cmd_data);
 		if (err != IOT_ERROR_NONE) {
 			IOT_ERROR("Cannot parse %dth command data", i);
 		} else {
-			_iot_process_cmd(cap_handle_list, component_name, capability_name, command_name, &cmd_data);
-		}
-
-		if (cmd_data.num_args != 0) {
-			_iot_free_cmd_data(&cmd_data);
-			cmd_data.num_args = 0;
-		}
-
-		if (component_name != NULL) {
-			iot_os_free(component_name);
-			component_name = NULL;
+			iot_cap_process_cmd(cmd_index, cap_handle_list, component_name, capability_name, command_name, &cmd_data);
 		}
+	}
+}
 
-		if (capability_name != NULL) {
-			iot_os_free(capability_name);
-			capability_name = NULL;
-		}
+void iot_cap_sub_cb(iot_cap_handle_list_t *cap_handle_list, char *payload)
+{
+	JSON_H *json = NULL;
+	struct iot_context *ctx = NULL;
+	iot_cap_cmd_index_t *cmd_index = NULL;
+	iot_arena_t arena;
+	bool in_arena;
 
-		if (command_name != NULL) {
-			iot_os_free(command_name);
-			command_name = NULL;
-		}
+	if (!cap_handle_list || !payload) {
+		IOT_ERROR("There is no cap_handle_list or payload");
+		return;
+	}
 
-		if (cmd_data.command_id != NULL) {
-			iot_os_free(cmd_data.command_id);
-			cmd_data.command_id = NULL;
+	if (cap_handle_list->handle) {
+		ctx = cap_handle_list->handle->ctx;
+	}
+	iot_arena_init(&arena, 0);
+	json = _iot_cap_parse_commands(ctx, &arena, payload, &in_arena);
+	if (json != NULL) {
+		if (ctx) {
+			cmd_index = ctx->cap_cmd_index;
 		}
+		_iot_cap_sub_process(&arena, cmd_index, cap_handle_list, json);
 	}
-
-out:
-	if (json != NULL)
-		JSON_DELETE(json);
+	_iot_cap_release_commands(&arena, json, in_arena);
+	iot_arena_deinit(&arena);
 }
 
-static iot_error_t _iot_parse_cmd_data_v2(JSON_H* cmditem, st_command_data *cmd_data)
+static iot_error_t _iot_parse_cmd_data_v2(iot_arena_t *arena, JSON_H* cmditem, st_command_data *cmd_data)
 {
 	JSON_H *cap_component = NULL;
 	JSON_H *cap_capability = NULL;
@@ -878,19 +2897,18 @@ static iot_error_t _iot_parse_cmd_data_v2(JSON_H* cmditem, st_command_data *cmd_
 	IOT_DEBUG("cap_args arr_size=%d", arr_size);
 	subitem = JSON_GET_ARRAY_ITEM(cap_args, 0);
 	if (arr_size > 0) {
-		cmd_data->param_list = (st_data *)iot_os_malloc(sizeof(st_data) * arr_size);
+		cmd_data->param_list = (st_data *)iot_arena_calloc(arena, arr_size, sizeof(st_data));
 		if (cmd_data->param_list == NULL) {
 			IOT_ERROR("Failed to malloc for cmd data param list");
 			return IOT_ERROR_MEM_ALLOC;
 		}
-		memset(cmd_data->param_list, 0, sizeof(st_data) * arr_size);
 	}
 	cmd_data->param_num = arr_size;
 
-	cmd_data->command_id = iot_os_strdup(command_id->valuestring);
-	cmd_data->custom_component_name = iot_os_strdup(cap_component->valuestring);
-	cmd_data->custom_cap_name = iot_os_strdup(cap_capability->valuestring);
-	cmd_data->custom_command_name = iot_os_strdup(cap_command->valuestring);
+	cmd_data->command_id = iot_arena_strdup(arena, command_id->valuestring);
+	cmd_data->custom_component_name = iot_arena_strdup(arena, cap_component->valuestring);
+	cmd_data->custom_cap_name = iot_arena_strdup(arena, cap_capability->valuestring);
+	cmd_data->custom_command_name = iot_arena_strdup(arena, cap_command->valuestring);
 
 	IOT_DEBUG("component:%s, capability:%s command:%s", cmd_data->custom_component_name,
 														cmd_data->custom_cap_name,
@@ -930,39 +2948,25 @@ static iot_error_t _iot_parse_cmd_data_v2(JSON_H* cmditem, st_command_data *cmd_
 	return IOT_ERROR_NONE;
 }
 
-static void _iot_free_cmd_data_v2(st_command_data *cmd_data)
+void iot_cap_free_cmd_data_v2(st_command_data *cmd_data)
 {
 	int i;
 
-	if (cmd_data == NULL) {
+	if (cmd_data == NULL || cmd_data->param_list == NULL) {
 		return;
 	}
 
+	/* The rest is in command arena, only printed JSON text is on heap */
 	for (i = 0; i < cmd_data->param_num; i++) {
 		if (cmd_data->param_list[i].data_type == ST_DATA_TYPE_RAW_JSON)
 			free(cmd_data->param_list[i].data.raw_json);
 	}
-
-	if (cmd_data->param_list)
-		iot_os_free(cmd_data->param_list);
-
-	if (cmd_data->custom_command_name)
-		iot_os_free(cmd_data->custom_command_name);
-	if (cmd_data->custom_cap_name)
-		iot_os_free(cmd_data->custom_cap_name);
-	if (cmd_data->custom_component_name)
-		iot_os_free(cmd_data->custom_component_name);
-	if (cmd_data->command_id)
-		iot_os_free(cmd_data->command_id);
-
 }
 
-void iot_cap_commands_cb(struct iot_context *ctx, char *payload)
+static void _iot_cap_commands_process(struct iot_context *ctx, JSON_H *json)
 {
-	JSON_H *json = NULL;
 	JSON_H *cap_cmds = NULL;
 	JSON_H *cmditem = NULL;
-	char *raw_data = NULL;
 	iot_error_t err;
 	int i;
 	int arr_size = 0;
@@ -970,21 +2974,6 @@ void iot_cap_commands_cb(struct iot_context *ctx, char *payload)
 									.raw.commands.commands_data = NULL,
 									.raw.commands.commands_num = 0};
 
-	if (!payload) {
-		IOT_ERROR("There is no payload");
-		return;
-	}
-
-	json = JSON_PARSE(payload);
-	if (json == NULL) {
-		IOT_ERROR("Cannot parse by json");
-		goto out;
-	}
-
-	raw_data = JSON_PRINT(json);
-	IOT_INFO("command : %s", raw_data);
-	free(raw_data);
-
 	cap_cmds = JSON_GET_OBJECT_ITEM(json, "commands");
 	if (cap_cmds == NULL) {
 		IOT_ERROR("there is no commands in raw_data");
@@ -1001,12 +2990,12 @@ void iot_cap_commands_cb(struct iot_context *ctx, char *payload)
 	}
 
 	command_noti.raw.commands.commands_num = arr_size;
-	command_noti.raw.commands.commands_data = (st_command_data *)iot_os_malloc(sizeof(st_command_data) * arr_size);
+	command_noti.raw.commands.commands_data = (st_command_data *)iot_arena_calloc(&ctx->cmd_arena,
+			arr_size, sizeof(st_command_data));
 	if (!command_noti.raw.commands.commands_data) {
 		IOT_ERROR("Failed to malloc command_noti cmd data");
 		goto out;
 	}
-	memset(command_noti.raw.commands.commands_data, 0, sizeof(st_command_data) * arr_size);
 
 	for (i = 0; i < arr_size; i++) {
 		cmditem = JSON_GET_ARRAY_ITEM(cap_cmds, i);
@@ -1016,7 +3005,7 @@ void iot_cap_commands_cb(struct iot_context *ctx, char *payload)
 		}
 
 		IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_PROCESS_COMMAND, i + 1, 0);
-		err = _iot_parse_cmd_data_v2(cmditem, &command_noti.raw.commands.commands_data[i]);
+		err = _iot_parse_cmd_data_v2(&ctx->cmd_arena, cmditem, &command_noti.raw.commands.commands_data[i]);
 		if (err != IOT_ERROR_NONE) {
 			IOT_ERROR("Cannot parse %dth command data", i);
 			goto out;
@@ -1028,17 +3017,86 @@ void iot_cap_commands_cb(struct iot_context *ctx, char *payload)
 out:
 	if (command_noti.raw.commands.commands_data) {
 		for (i = 0; i < arr_size; i++) {
-			_iot_free_cmd_data_v2(&command_noti.raw.commands.commands_data[i]);
+			iot_cap_free_cmd_data_v2(&command_noti.raw.commands.commands_data[i]);
 		}
-		iot_os_free(command_noti.raw.commands.commands_data);
 	}
-	if (json != NULL)
-		JSON_DELETE(json);
 }
 
+void iot_cap_commands_cb(struct iot_context *ctx, char *payload)
+{
+	JSON_H *json = NULL;
+	bool in_arena;
+
+	if (!ctx || !payload) {
+		IOT_ERROR("There is no ctx or payload");
+		return;
+	}
+
+	json = _iot_cap_parse_commands(ctx, &ctx->cmd_arena, payload, &in_arena);
+	if (json != NULL) {
+		_iot_cap_commands_process(ctx, json);
+	}
+	_iot_cap_release_commands(&ctx->cmd_arena, json, in_arena);
+}
+
+void iot_cap_dispatch_commands(struct iot_context *ctx, char *payload)
+{
+	JSON_H *json = NULL;
+	bool in_arena;
+
+	if (!ctx || !payload) {
+		IOT_ERROR("There is no ctx or payload");
+		return;
+	}
+	ctx->cmd_dispatched++;
+
+	json = _iot_cap_parse_commands(ctx, &ctx->cmd_arena, payload, &in_arena);
+	if (json == NULL) {
+		_iot_cap_release_commands(&ctx->cmd_arena, json, in_arena);
+		return;
+	}
+
+	/* Both handler flavors share one parsed tree,
+	 * application can choose one of both handlers to handle commands */
+	if (ctx->cap_handle_list) {
+		_iot_cap_sub_process(&ctx->cmd_arena, ctx->cap_cmd_index, ctx->cap_handle_list, json);
+	}
+	_iot_cap_commands_process(ctx, json);
+	_iot_cap_release_commands(&ctx->cmd_arena, json, in_arena);
+}
+
+void iot_cap_get_command_stats(struct iot_context *ctx, unsigned int *dispatched, unsigned int *parsed)
+{
+	if (!ctx) {
+		return;
+	}
+	if (dispatched) {
+		*dispatched = ctx->cmd_dispatched;
+	}
+	if (parsed) {
+		*parsed = ctx->cmd_parsed;
+	}
+}
+
+int st_conn_get_command_arena_stats(IOT_CTX *iot_ctx, st_command_arena_stats *stats)
+{
+	struct iot_context *ctx = (struct iot_context *)iot_ctx;
+
+	if (!ctx || !stats) {
+		IOT_ERROR("There is no ctx or stats");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	stats->block_size = ctx->cmd_arena.block_size ? ctx->cmd_arena.block_size : IOT_ARENA_DEFAULT_SIZE;
+	stats->high_water = ctx->cmd_arena.high_water;
+	stats->overflows = ctx->cmd_arena.overflows;
+	stats->messages = ctx->cmd_arena.resets;
+
+	return IOT_ERROR_NONE;
+}
 
 /* Internal API */
-static iot_error_t _iot_parse_cmd_data(JSON_H* cmditem, char** component,
+static iot_error_t _iot_parse_cmd_data(iot_arena_t *arena, JSON_H* cmditem, char** component,
 			char** capability, char** command, iot_cap_cmd_data_t* cmd_data)
 {
 	JSON_H *cap_component = NULL;
@@ -1063,9 +3121,9 @@ static iot_error_t _iot_parse_cmd_data(JSON_H* cmditem, char** component,
 		return IOT_ERROR_BAD_REQ;
 	}
 
-	*component = iot_os_strdup(cap_component->valuestring);
-	*capability = iot_os_strdup(cap_capability->valuestring);
-	*command = iot_os_strdup(cap_command->valuestring);
+	*component = iot_arena_strdup(arena, cap_component->valuestring);
+	*capability = iot_arena_strdup(arena, cap_capability->valuestring);
+	*command = iot_arena_strdup(arena, cap_command->valuestring);
 
 	IOT_DEBUG("component:%s, capability:%s command:%s", *component, *capability, *command);
 
@@ -1074,19 +3132,16 @@ static iot_error_t _iot_parse_cmd_data(JSON_H* cmditem, char** component,
 	subitem = JSON_GET_ARRAY_ITEM(cap_args, 0);
 
 	if (subitem != NULL) {
-		cmd_data->args_str = (char **)iot_os_malloc(sizeof(char *) * arr_size);
+		cmd_data->args_str = (char **)iot_arena_calloc(arena, arr_size, sizeof(char *));
 		if (!cmd_data->args_str) {
 			IOT_ERROR("Failed to malloc args_str");
 			return IOT_ERROR_MEM_ALLOC;
 		}
-		memset(cmd_data->args_str, 0, sizeof(char *) * arr_size);
-		cmd_data->cmd_data = (iot_cap_val_t *)iot_os_malloc(sizeof(iot_cap_val_t) * arr_size);
+		cmd_data->cmd_data = (iot_cap_val_t *)iot_arena_calloc(arena, arr_size, sizeof(iot_cap_val_t));
 		if (!cmd_data->cmd_data) {
 			IOT_ERROR("Failed to malloc cmd_data");
-			iot_os_free(cmd_data->args_str);
 			return IOT_ERROR_MEM_ALLOC;
 		}
-		memset(cmd_data->cmd_data, 0, sizeof(iot_cap_val_t) * arr_size);
 		for (i = 0; i < arr_size; i++) {
 			if (JSON_IS_BOOL(subitem)) {
 				cmd_data->args_str[num_args] = NULL;
@@ -1112,7 +3167,7 @@ static iot_error_t _iot_parse_cmd_data(JSON_H* cmditem, char** component,
 				IOT_DEBUG("[%d] %s", num_args, JSON_GET_STRING_VALUE(subitem));
 				cmd_data->args_str[num_args] = NULL;
 				cmd_data->cmd_data[num_args].type = IOT_CAP_VAL_TYPE_STRING;
-				cmd_data->cmd_data[num_args].string = iot_os_strdup(JSON_GET_STRING_VALUE(subitem));
+				cmd_data->cmd_data[num_args].string = iot_arena_strdup(arena, JSON_GET_STRING_VALUE(subitem));
 				num_args++;
 			}
 			else if (JSON_IS_OBJECT(subitem) || JSON_IS_ARRAY(subitem)) {
@@ -1120,7 +3175,7 @@ static iot_error_t _iot_parse_cmd_data(JSON_H* cmditem, char** component,
 				cmd_data->cmd_data[num_args].type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
 				json_str = JSON_PRINT(subitem);
 				if (json_str != NULL) {
-					cmd_data->cmd_data[num_args].json_object = iot_os_strdup(json_str);
+					cmd_data->cmd_data[num_args].json_object = iot_arena_strdup(arena, json_str);
 					IOT_DEBUG("[%d] %s", num_args, cmd_data->cmd_data[num_args].json_object);
 					free(json_str);
 				} else {
@@ -1134,98 +3189,101 @@ static iot_error_t _iot_parse_cmd_data(JSON_H* cmditem, char** component,
 	cmd_data->num_args = num_args;
 
 	if (command_id != NULL) {
-		cmd_data->command_id = iot_os_strdup(JSON_GET_STRING_VALUE(command_id));
+		cmd_data->command_id = iot_arena_strdup(arena, JSON_GET_STRING_VALUE(command_id));
 	}
 
 	return IOT_ERROR_NONE;
 }
 
-static JSON_H *_iot_make_evt_data(const char* component, const char* capability, iot_cap_evt_data_t* evt_data, int seq_num)
+static iot_error_t _iot_write_evt_data(iot_serialize_writer_t *writer, const char* component,
+			const char* capability, iot_cap_evt_data_t* evt_data, int seq_num)
 {
-	JSON_H *evt_item = NULL;
-	JSON_H *evt_subarr = NULL;
-	JSON_H *evt_subjson = NULL;
-	JSON_H *evt_subdata = NULL;
-	JSON_H *prov_data = NULL;
-	JSON_H *visibility_data = NULL;
 	char time_in_ms[16]; /* 155934720000 is '2019-06-01 00:00:00.00 UTC' */
 
-	evt_item = JSON_CREATE_OBJECT();
+	switch (evt_data->evt_value.type) {
+	case IOT_CAP_VAL_TYPE_BOOLEAN:
+	case IOT_CAP_VAL_TYPE_INTEGER:
+	case IOT_CAP_VAL_TYPE_NUMBER:
+	case IOT_CAP_VAL_TYPE_STRING:
+	case IOT_CAP_VAL_TYPE_STR_ARRAY:
+	case IOT_CAP_VAL_TYPE_JSON_OBJECT:
+		break;
+	default:
+		IOT_ERROR("Event data value type error :%d", evt_data->evt_value.type);
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	iot_serialize_writer_open_object(writer, NULL);
 
 	if (evt_data->options.command_id != NULL) {
 		/* commandId */
-		JSON_ADD_STRING_TO_OBJECT(evt_item, "commandId", evt_data->options.command_id);
+		iot_serialize_writer_add_string(writer, "commandId", evt_data->options.command_id);
 	}
 
 	/* component */
-	JSON_ADD_STRING_TO_OBJECT(evt_item, "component", component);
+	iot_serialize_writer_add_string(writer, "component", component);
 
-	/* capability */
-	JSON_ADD_STRING_TO_OBJECT(evt_item, "capability", capability);
+	if (evt_data->desc && writer->format == IOT_EVT_SERIALIZE_FORMAT) {
+		/* capability and attribute, pre-encoded */
+		iot_serialize_writer_add_members(writer, evt_data->desc->key, evt_data->desc->key_len, 2);
+	} else {
+		/* capability */
+		iot_serialize_writer_add_string(writer, "capability", capability);
 
-	/* attribute */
-	JSON_ADD_STRING_TO_OBJECT(evt_item, "attribute", evt_data->evt_type);
+		/* attribute */
+		iot_serialize_writer_add_string(writer, "attribute", evt_data->evt_type);
+	}
 
 	/* value */
 	if (evt_data->evt_value.type == IOT_CAP_VAL_TYPE_BOOLEAN) {
-		JSON_ADD_BOOL_TO_OBJECT(evt_item, "value", evt_data->evt_value.boolean);
+		iot_serialize_writer_add_bool(writer, "value", evt_data->evt_value.boolean);
 	} else if (evt_data->evt_value.type == IOT_CAP_VAL_TYPE_INTEGER) {
-		JSON_ADD_NUMBER_TO_OBJECT(evt_item, "value", evt_data->evt_value.integer);
+		iot_serialize_writer_add_number(writer, "value", evt_data->evt_value.integer);
 	} else if (evt_data->evt_value.type == IOT_CAP_VAL_TYPE_NUMBER) {
-		JSON_ADD_NUMBER_TO_OBJECT(evt_item, "value", evt_data->evt_value.number);
+		iot_serialize_writer_add_number(writer, "value", evt_data->evt_value.number);
 	} else if (evt_data->evt_value.type == IOT_CAP_VAL_TYPE_STRING) {
-		JSON_ADD_STRING_TO_OBJECT(evt_item, "value", evt_data->evt_value.string);
+		iot_serialize_writer_add_string(writer, "value", evt_data->evt_value.string);
 	} else if (evt_data->evt_value.type == IOT_CAP_VAL_TYPE_STR_ARRAY) {
-		if (evt_data->evt_value.str_num == 0) {
-			evt_subarr = JSON_CREATE_ARRAY();
-		} else {
-			evt_subarr = JSON_CREATE_STRING_ARRAY(
-				(const char**)evt_data->evt_value.strings, evt_data->evt_value.str_num);
-		}
-		JSON_ADD_ITEM_TO_OBJECT(evt_item, "value", evt_subarr);
-	} else if (evt_data->evt_value.type == IOT_CAP_VAL_TYPE_JSON_OBJECT) {
-		evt_subjson = JSON_PARSE(evt_data->evt_value.json_object);
-		JSON_ADD_ITEM_TO_OBJECT(evt_item, "value", evt_subjson);
+		iot_serialize_writer_add_string_array(writer, "value",
+			(const char**)evt_data->evt_value.strings, evt_data->evt_value.str_num);
 	} else {
-		IOT_ERROR("Event data value type error :%d", evt_data->evt_value.type);
-		JSON_DELETE(evt_item);
-		return NULL;
+		iot_serialize_writer_add_raw_json(writer, "value", evt_data->evt_value.json_object);
 	}
 
 	/* unit */
 	if (evt_data->evt_unit.type == IOT_CAP_UNIT_TYPE_STRING)
-			JSON_ADD_STRING_TO_OBJECT(evt_item, "unit", evt_data->evt_unit.string);
+			iot_serialize_writer_add_string(writer, "unit", evt_data->evt_unit.string);
 
 	/* data */
 	if (evt_data->evt_value_data) {
-		evt_subdata = JSON_PARSE(evt_data->evt_value_data);
-		JSON_ADD_ITEM_TO_OBJECT(evt_item, "data", evt_subdata);
+		iot_serialize_writer_add_raw_json(writer, "data", evt_data->evt_value_data);
 	}
 
 	/* visibility */
 	if (evt_data->options.displayed != NULL)
 	{
-		visibility_data = JSON_CREATE_OBJECT();
-		JSON_ADD_BOOL_TO_OBJECT(visibility_data, "displayed", *(evt_data->options.displayed));
-
-		JSON_ADD_ITEM_TO_OBJECT(evt_item, "visibility", visibility_data);
+		iot_serialize_writer_open_object(writer, "visibility");
+		iot_serialize_writer_add_bool(writer, "displayed", *(evt_data->options.displayed));
+		iot_serialize_writer_close(writer);
 	}
 
 	/* providerData */
-	prov_data = JSON_CREATE_OBJECT();
-	JSON_ADD_NUMBER_TO_OBJECT(prov_data, "sequenceNumber", seq_num);
+	iot_serialize_writer_open_object(writer, "providerData");
+	iot_serialize_writer_add_number(writer, "sequenceNumber", seq_num);
 
 	if (iot_get_time_in_ms(time_in_ms, sizeof(time_in_ms)) != IOT_ERROR_NONE)
 		IOT_WARN("Cannot add optional timestamp value");
 	else
-		JSON_ADD_STRING_TO_OBJECT(prov_data, "timestamp", time_in_ms);
+		iot_serialize_writer_add_string(writer, "timestamp", time_in_ms);
 
 	if (evt_data->options.state_change)
-		JSON_ADD_STRING_TO_OBJECT(prov_data, "stateChange", "Y");
+		iot_serialize_writer_add_string(writer, "stateChange", "Y");
+
+	iot_serialize_writer_close(writer);
 
-	JSON_ADD_ITEM_TO_OBJECT(evt_item, "providerData", prov_data);
+	iot_serialize_writer_close(writer);
 
-	return evt_item;
+	return IOT_ERROR_NONE;
 }
 
 void iot_cap_call_init_cb(iot_cap_handle_list_t *cap_handle_list)
@@ -1287,30 +3345,6 @@ static void _iot_free_unit(iot_cap_unit_t* unit)
 	}
 }
 
-static void _iot_free_cmd_data(iot_cap_cmd_data_t* cmd_data)
-{
-	int i;
-
-	if (cmd_data == NULL) {
-		return;
-	}
-
-	for (i = 0; i < cmd_data->num_args; i++) {
-		if (cmd_data->args_str[i] != NULL) {
-			free(cmd_data->args_str[i]);
-		}
-		_iot_free_val(&cmd_data->cmd_data[i]);
-	}
-
-	if (cmd_data->args_str) {
-		iot_os_free(cmd_data->args_str);
-	}
-
-	if (cmd_data->cmd_data) {
-		iot_os_free(cmd_data->cmd_data);
-	}
-}
-
 static void _iot_free_evt_data(iot_cap_evt_data_t* evt_data)
 {
 	if (evt_data == NULL) {
@@ -1336,114 +3370,97 @@ static void _iot_free_evt_data(iot_cap_evt_data_t* evt_data)
 	}
 }
 
-static JSON_H *_iot_make_evt_data_v2(st_attr_data *attr_data, int seq_num)
+static iot_error_t _iot_write_evt_data_v2(iot_serialize_writer_t *writer, st_attr_data *attr_data, int seq_num)
 {
-	JSON_H *evt_item = NULL;
-	JSON_H *evt_subjson = NULL;
-	JSON_H *evt_subdata = NULL;
-	JSON_H *prov_data = NULL;
-	JSON_H *visibility_data = NULL;
 	char time_in_ms[16]; /* 155934720000 is '2019-06-01 00:00:00.00 UTC' */
 
-	evt_item = JSON_CREATE_OBJECT();
+	if (attr_data->component_type == ST_COMPONENT_CUSTOM && !attr_data->custom_component_name)
+		return IOT_ERROR_BAD_REQ;
+	else if (attr_data->component_type != ST_COMPONENT_DEFULAT &&
+			attr_data->component_type != ST_COMPONENT_CUSTOM)
+		return IOT_ERROR_BAD_REQ;
+
+	if (attr_data->attr_type != ST_ATTR_CUSTOM ||
+			!attr_data->custom_cap_name || !attr_data->custom_attr_name)
+		return IOT_ERROR_BAD_REQ;
+
+	iot_serialize_writer_open_object(writer, NULL);
 
 	/* component */
-	if (attr_data->component_type == ST_COMPONENT_DEFULAT) {
-		JSON_ADD_STRING_TO_OBJECT(evt_item, "component", "main");
-	} else if (attr_data->component_type == ST_COMPONENT_CUSTOM) {
-		if (attr_data->custom_component_name)
-			JSON_ADD_STRING_TO_OBJECT(evt_item, "component", attr_data->custom_component_name);
-		else
-			goto err_make_evt_item;
-	} else
-		goto err_make_evt_item;
+	if (attr_data->component_type == ST_COMPONENT_DEFULAT)
+		iot_serialize_writer_add_string(writer, "component", "main");
+	else
+		iot_serialize_writer_add_string(writer, "component", attr_data->custom_component_name);
 
 	/* capability && attribute */
-	if (attr_data->attr_type == ST_ATTR_CUSTOM) {
-		if (attr_data->custom_cap_name && attr_data->custom_attr_name) {
-			JSON_ADD_STRING_TO_OBJECT(evt_item, "capability", attr_data->custom_cap_name);
-			JSON_ADD_STRING_TO_OBJECT(evt_item, "attribute", attr_data->custom_attr_name);
-		} else
-			goto err_make_evt_item;
-	} else
-		goto err_make_evt_item;
+	iot_serialize_writer_add_string(writer, "capability", attr_data->custom_cap_name);
+	iot_serialize_writer_add_string(writer, "attribute", attr_data->custom_attr_name);
 
 	/* value */
 	switch (attr_data->value.data_type) {
 		case ST_DATA_TYPE_STRING:
-			JSON_ADD_STRING_TO_OBJECT(evt_item, "value", attr_data->value.data.string);
+			iot_serialize_writer_add_string(writer, "value", attr_data->value.data.string);
 			break;
 		case ST_DATA_TYPE_NUMBER:
-			JSON_ADD_NUMBER_TO_OBJECT(evt_item, "value", attr_data->value.data.number);
+			iot_serialize_writer_add_number(writer, "value", attr_data->value.data.number);
 			break;
 		case ST_DATA_TYPE_JSON_OBJECT:
 			break;
 		case ST_DATA_TYPE_JSON_ARRAY:
 			break;
 		case ST_DATA_TYPE_BOOLEAN:
-			JSON_ADD_BOOL_TO_OBJECT(evt_item, "value", attr_data->value.data.boolean);
+			iot_serialize_writer_add_bool(writer, "value", attr_data->value.data.boolean);
 			break;
 		case ST_DATA_TYPE_NULL:
 			break;
 		case ST_DATA_TYPE_RAW_JSON:
-			evt_subjson = JSON_PARSE(attr_data->value.data.raw_json);
-			JSON_ADD_ITEM_TO_OBJECT(evt_item, "value", evt_subjson);
+			iot_serialize_writer_add_raw_json(writer, "value", attr_data->value.data.raw_json);
 			break;
 	}
 
 	/* unit */
 	if (attr_data->unit)
-		JSON_ADD_STRING_TO_OBJECT(evt_item, "unit", attr_data->unit);
+		iot_serialize_writer_add_string(writer, "unit", attr_data->unit);
 
 	/* data */
 	if (attr_data->data) {
-		evt_subdata = JSON_PARSE(attr_data->data);
-		JSON_ADD_ITEM_TO_OBJECT(evt_item, "data", evt_subdata);
+		iot_serialize_writer_add_raw_json(writer, "data", attr_data->data);
 	}
 
 	/* visibility */
 	if (!attr_data->support_history) {
-		visibility_data = JSON_CREATE_OBJECT();
-		JSON_ADD_BOOL_TO_OBJECT(visibility_data, "displayed", false);
-		JSON_ADD_ITEM_TO_OBJECT(evt_item, "visibility", visibility_data);
+		iot_serialize_writer_open_object(writer, "visibility");
+		iot_serialize_writer_add_bool(writer, "displayed", false);
+		iot_serialize_writer_close(writer);
 	}
 
 	/* providerData */
-	prov_data = JSON_CREATE_OBJECT();
-	JSON_ADD_NUMBER_TO_OBJECT(prov_data, "sequenceNumber", seq_num);
+	iot_serialize_writer_open_object(writer, "providerData");
+	iot_serialize_writer_add_number(writer, "sequenceNumber", seq_num);
 
 	if (iot_get_time_in_ms(time_in_ms, sizeof(time_in_ms)) != IOT_ERROR_NONE)
 		IOT_WARN("Cannot add optional timestamp value");
 	else
-		JSON_ADD_STRING_TO_OBJECT(prov_data, "timestamp", time_in_ms);
+		iot_serialize_writer_add_string(writer, "timestamp", time_in_ms);
 
 	if (attr_data->state_change)
-		JSON_ADD_STRING_TO_OBJECT(prov_data, "stateChange", "Y");
+		iot_serialize_writer_add_string(writer, "stateChange", "Y");
 
-	JSON_ADD_ITEM_TO_OBJECT(evt_item, "providerData", prov_data);
+	iot_serialize_writer_close(writer);
 
 	/* related command ID */
 	if (attr_data->related_command_id != NULL)
-		JSON_ADD_STRING_TO_OBJECT(evt_item, "commandId", attr_data->related_command_id);
+		iot_serialize_writer_add_string(writer, "commandId", attr_data->related_command_id);
 
-	return evt_item;
-err_make_evt_item:
-	if (evt_item) {
-		JSON_DELETE(evt_item);
-	}
+	iot_serialize_writer_close(writer);
 
-	return NULL;
+	return IOT_ERROR_NONE;
 }
 
 int st_cap_send_attr_v2(IOT_CTX *iot_ctx, st_attr_data* attr_data[], uint8_t attr_num)
 {
-	int ret;
 	struct iot_context *ctx = (struct iot_context *)iot_ctx;
-	st_mqtt_msg msg = {0};
 	int i;
-	JSON_H *evt_root = NULL;
-	JSON_H *evt_arr = NULL;
-	JSON_H *evt_item = NULL;
 
 	if (!ctx || attr_num == 0) {
 		IOT_DUMP(IOT_DEBUG_LEVEL_ERROR, IOT_DUMP_CAPABILITY_SEND_EVENT_NO_DATA_ERROR, 0, 0);
@@ -1451,73 +3468,24 @@ int st_cap_send_attr_v2(IOT_CTX *iot_ctx, st_attr_data* attr_data[], uint8_t att
 		return IOT_ERROR_INVALID_ARGS;
 	}
 
-	if (ctx->curr_state != IOT_STATE_CLOUD_CONNECTED || ctx->evt_mqttcli == NULL) {
+	if ((ctx->curr_state != IOT_STATE_CLOUD_CONNECTED || ctx->evt_mqttcli == NULL) && !ctx->evt_offline) {
 		IOT_DUMP(IOT_DEBUG_LEVEL_ERROR, IOT_DUMP_CAPABILITY_SEND_EVENT_NO_CONNECT_ERROR, ctx->curr_state, 0);
 		IOT_ERROR("Target has not connected to server yet!!");
 		return IOT_ERROR_BAD_REQ;
 	}
 
-	if (ctx->rate_limit) {
+	if (ctx->rate_limit && !ctx->evt_offline) {
 		IOT_WARN("Exceed rate limit. Can't send attributes for a while");
 		return IOT_ERROR_BAD_REQ;
 	}
 
-	if (ctx->event_sequence_num == MAX_SQNUM) {
-		ctx->event_sequence_num = 0;
-	}
-	ctx->event_sequence_num = (ctx->event_sequence_num + 1) & MAX_SQNUM;
-
-	evt_root = JSON_CREATE_OBJECT();
-	evt_arr = JSON_CREATE_ARRAY();
-
-	JSON_ADD_ITEM_TO_OBJECT(evt_root, "deviceEvents", evt_arr);
-
-	/* Make event data format & enqueue data */
 	for (i = 0; i < attr_num; i++) {
 		if (!attr_data[i]) {
 			IOT_ERROR("There si no capability reference in event data or ctx not matched");
-			JSON_DELETE(evt_root);
 			return IOT_ERROR_BAD_REQ;
 		}
-		evt_item = _iot_make_evt_data_v2(attr_data[i], ctx->event_sequence_num);
-		if (evt_item == NULL) {
-			IOT_ERROR("Cannot make evt_data!!");
-			JSON_DELETE(evt_root);
-			return IOT_ERROR_BAD_REQ;
-		}
-		JSON_ADD_ITEM_TO_ARRAY(evt_arr, evt_item);
-	}
-
-#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
-	iot_serialize_json2cbor(evt_root, (uint8_t **)&msg.payload, (size_t *)&msg.payloadlen);
-#else
-	msg.payload = JSON_PRINT(evt_root);
-	if (msg.payload != NULL) {
-		msg.payloadlen = strlen(msg.payload);
-	}
-#endif
-	JSON_DELETE(evt_root);
-	if (msg.payload == NULL) {
-		IOT_ERROR("Fail to transfer to payload");
-		return IOT_ERROR_BAD_REQ;
-	}
-	msg.qos = st_mqtt_qos1;
-	msg.retained = false;
-	msg.topic = ctx->mqtt_event_topic;
-
-	IOT_INFO("publish event, topic : %s, payload :\n%s",
-		ctx->mqtt_event_topic, (char *)msg.payload);
-
-	ret = st_mqtt_publish_async(ctx->evt_mqttcli, &msg);
-	if (ret) {
-		IOT_WARN("MQTT pub error(%d)", ret);
-		free(msg.payload);
-		return IOT_ERROR_MQTT_PUBLISH_FAIL;
 	}
 
-	IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_SEND_EVENT_SUCCESS, attr_num, 0);
-
-	free(msg.payload);
-	return ctx->event_sequence_num;
+	return _iot_cap_send_attr_events(ctx, (void **)attr_data, attr_num, true);
 }
 /* External API */
@@ -0,0 +1,638 @@
+/* ***************************************************************************
+ *
+ * Copyright (c) 2019-2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+#include "iot_internal.h"
+#include "iot_debug.h"
+#include "iot_capability.h"
+#include "iot_os_util.h"
+#include "iot_bsp_system.h"
+
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+#include <cbor.h>
+
+/* Decoders walk received CBOR with CborValue, without JSON text and tree */
+
+/* Strings go to arena when it is given, or to heap */
+static char *_iot_cbor_dup_string(const CborValue *value, iot_arena_t *arena)
+{
+	char *str;
+	size_t len;
+
+	if (!cbor_value_is_text_string(value) ||
+			cbor_value_calculate_string_length(value, &len) != CborNoError) {
+		return NULL;
+	}
+
+	str = arena ? (char *)iot_arena_alloc(arena, len + 1) : (char *)iot_os_malloc(len + 1);
+	if (str == NULL) {
+		IOT_ERROR("Failed to malloc for cbor string");
+		return NULL;
+	}
+
+	len++;
+	if (cbor_value_copy_text_string(value, str, &len, NULL) != CborNoError) {
+		if (!arena) {
+			iot_os_free(str);
+		}
+		return NULL;
+	}
+
+	return str;
+}
+
+static char *_iot_cbor_find_string(const CborValue *map, const char *key, iot_arena_t *arena)
+{
+	CborValue value;
+
+	if (cbor_value_map_find_value(map, key, &value) != CborNoError) {
+		return NULL;
+	}
+
+	return _iot_cbor_dup_string(&value, arena);
+}
+
+static bool _iot_cbor_get_number(const CborValue *value, double *number)
+{
+	CborValue recursed;
+	CborTag tag;
+	uint64_t raw;
+	int64_t exp;
+	int64_t man;
+	float val_flt;
+
+	switch (cbor_value_get_type(value)) {
+	case CborIntegerType:
+		cbor_value_get_raw_integer(value, &raw);
+		*number = (double)raw;
+		if (cbor_value_is_negative_integer(value)) {
+			*number = -*number - 1;
+		}
+		return true;
+	case CborDoubleType:
+		return cbor_value_get_double(value, number) == CborNoError;
+	case CborFloatType:
+		if (cbor_value_get_float(value, &val_flt) != CborNoError) {
+			return false;
+		}
+		*number = val_flt;
+		return true;
+	case CborTagType:
+		/* Decimal fraction is [exponent, mantissa] of base 10 */
+		if (cbor_value_get_tag(value, &tag) != CborNoError || tag != CborDecimalTag) {
+			return false;
+		}
+		recursed = *value;
+		if (cbor_value_skip_tag(&recursed) != CborNoError || !cbor_value_is_array(&recursed) ||
+				cbor_value_enter_container(&recursed, &recursed) != CborNoError) {
+			return false;
+		}
+		if (cbor_value_get_int64_checked(&recursed, &exp) != CborNoError ||
+				cbor_value_advance_fixed(&recursed) != CborNoError ||
+				cbor_value_get_int64_checked(&recursed, &man) != CborNoError) {
+			return false;
+		}
+		*number = (double)man * pow(10, (double)exp);
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* Same saturation as valueint of parsed JSON number */
+static int _iot_cbor_number_to_int(double number)
+{
+	if (number >= INT_MAX) {
+		return INT_MAX;
+	} else if (number <= (double)INT_MIN) {
+		return INT_MIN;
+	}
+
+	return (int)number;
+}
+
+static bool _iot_cbor_find_int(const CborValue *map, const char *key, int *result)
+{
+	CborValue value;
+	double number;
+
+	if (cbor_value_map_find_value(map, key, &value) != CborNoError ||
+			!_iot_cbor_get_number(&value, &number)) {
+		return false;
+	}
+
+	*result = _iot_cbor_number_to_int(number);
+	return true;
+}
+
+/* Every item takes a byte at least, so a count over payload_len is forged */
+static int _iot_cbor_array_size(const CborValue *array, size_t payload_len)
+{
+	CborValue it;
+	size_t len;
+	int count = 0;
+
+	if (!cbor_value_is_array(array)) {
+		return -1;
+	}
+	if (cbor_value_get_array_length(array, &len) == CborNoError) {
+		if (len > payload_len || len > INT_MAX) {
+			IOT_ERROR("array of %lu items in %lu bytes of cbor",
+					(unsigned long)len, (unsigned long)payload_len);
+			return -1;
+		}
+		return (int)len;
+	}
+
+	/* indefinite length */
+	if (cbor_value_enter_container(array, &it) != CborNoError) {
+		return -1;
+	}
+	while (!cbor_value_at_end(&it)) {
+		if (cbor_value_advance(&it) != CborNoError) {
+			return -1;
+		}
+		count++;
+	}
+
+	return count;
+}
+
+static iot_error_t _iot_cbor_parse_arg(iot_arena_t *arena, CborValue *arg, st_data *data)
+{
+	size_t len;
+	double number;
+	bool boolean;
+
+	switch (cbor_value_get_type(arg)) {
+	case CborBooleanType:
+		cbor_value_get_boolean(arg, &boolean);
+		data->data_type = ST_DATA_TYPE_BOOLEAN;
+		data->data.boolean = boolean;
+		break;
+	case CborTextStringType:
+		data->data.string = _iot_cbor_dup_string(arg, arena);
+		if (data->data.string == NULL) {
+			return IOT_ERROR_MEM_ALLOC;
+		}
+		data->data_type = ST_DATA_TYPE_STRING;
+		break;
+	case CborArrayType:
+	case CborMapType:
+		/* Nested value is handed to application as JSON text, like JSON_PRINT() */
+		if (iot_serialize_cbor_value_to_json(arg, &data->data.raw_json, &len) != IOT_ERROR_NONE) {
+			return IOT_ERROR_BAD_REQ;
+		}
+		data->data_type = ST_DATA_TYPE_RAW_JSON;
+		return IOT_ERROR_NONE;
+	default:
+		if (_iot_cbor_get_number(arg, &number)) {
+			data->data_type = ST_DATA_TYPE_NUMBER;
+			data->data.number = number;
+		} else {
+			data->data_type = ST_DATA_TYPE_NULL;
+		}
+		break;
+	}
+
+	if (cbor_value_advance(arg) != CborNoError) {
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	return IOT_ERROR_NONE;
+}
+
+static iot_error_t _iot_cbor_parse_cmd_data(iot_arena_t *arena, const CborValue *cmditem,
+			size_t payload_len, st_command_data *cmd_data, bool *complete)
+{
+	CborValue cap_args;
+	CborValue subitem;
+	iot_error_t err;
+	int arr_size;
+	int i;
+
+	*complete = false;
+	if (!cbor_value_is_map(cmditem)) {
+		IOT_ERROR("command is not a map");
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	cmd_data->custom_component_name = _iot_cbor_find_string(cmditem, "component", arena);
+	cmd_data->custom_cap_name = _iot_cbor_find_string(cmditem, "capability", arena);
+	cmd_data->custom_command_name = _iot_cbor_find_string(cmditem, "command", arena);
+	cmd_data->command_id = _iot_cbor_find_string(cmditem, "id", arena);
+
+	if (cmd_data->custom_component_name == NULL || cmd_data->custom_cap_name == NULL ||
+			cmd_data->custom_command_name == NULL) {
+		IOT_ERROR("Cannot find value index!!");
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	IOT_DEBUG("component:%s, capability:%s command:%s", cmd_data->custom_component_name,
+														cmd_data->custom_cap_name,
+														cmd_data->custom_command_name);
+
+	if (cbor_value_map_find_value(cmditem, "arguments", &cap_args) != CborNoError ||
+			(arr_size = _iot_cbor_array_size(&cap_args, payload_len)) < 0) {
+		return IOT_ERROR_NONE;
+	}
+	IOT_DEBUG("cap_args arr_size=%d", arr_size);
+
+	if (arr_size > 0) {
+		cmd_data->param_list = (st_data *)iot_arena_calloc(arena, arr_size, sizeof(st_data));
+		if (cmd_data->param_list == NULL) {
+			IOT_ERROR("Failed to malloc for cmd data param list");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+
+		if (cbor_value_enter_container(&cap_args, &subitem) != CborNoError) {
+			cmd_data->param_list = NULL;
+			return IOT_ERROR_BAD_REQ;
+		}
+		for (i = 0; i < arr_size; i++) {
+			cmd_data->param_num = i + 1;
+			err = _iot_cbor_parse_arg(arena, &subitem, &cmd_data->param_list[i]);
+			if (err != IOT_ERROR_NONE) {
+				IOT_ERROR("Cannot parse %dth argument", i);
+				return err;
+			}
+		}
+	}
+	cmd_data->param_num = arr_size;
+
+	/* Handler of version 2 requires every field */
+	*complete = (cmd_data->command_id != NULL);
+
+	return IOT_ERROR_NONE;
+}
+
+static void _iot_cbor_cap_sub_process(struct iot_context *ctx, st_command_data *cmds, int cmd_num)
+{
+	iot_cap_cmd_data_t cmd_data;
+	st_data *param;
+	int i, j;
+
+	for (i = 0; i < cmd_num; i++) {
+		if (cmds[i].custom_command_name == NULL) {
+			IOT_ERROR("Cannot parse %dth command data", i);
+			continue;
+		}
+
+		/* Per-capability handler borrows values decoded for version 2 handler */
+		memset(&cmd_data, 0, sizeof(iot_cap_cmd_data_t));
+		cmd_data.total_commands_num = cmd_num;
+		cmd_data.order_of_command = i + 1;
+		cmd_data.command_id = cmds[i].command_id;
+
+		if (cmds[i].param_num > 0) {
+			cmd_data.args_str = (char **)iot_arena_calloc(&ctx->cmd_arena, cmds[i].param_num, sizeof(char *));
+			cmd_data.cmd_data = (iot_cap_val_t *)iot_arena_calloc(&ctx->cmd_arena,
+					cmds[i].param_num, sizeof(iot_cap_val_t));
+			if (!cmd_data.args_str || !cmd_data.cmd_data) {
+				IOT_ERROR("Failed to malloc cmd_data");
+				continue;
+			}
+		}
+
+		for (j = 0; j < cmds[i].param_num; j++) {
+			param = &cmds[i].param_list[j];
+			switch (param->data_type) {
+			case ST_DATA_TYPE_BOOLEAN:
+				cmd_data.cmd_data[cmd_data.num_args].type = IOT_CAP_VAL_TYPE_BOOLEAN;
+				cmd_data.cmd_data[cmd_data.num_args].boolean = param->data.boolean;
+				break;
+			case ST_DATA_TYPE_NUMBER:
+				cmd_data.cmd_data[cmd_data.num_args].type = IOT_CAP_VAL_TYPE_INT_OR_NUM;
+				cmd_data.cmd_data[cmd_data.num_args].integer = _iot_cbor_number_to_int(param->data.number);
+				cmd_data.cmd_data[cmd_data.num_args].number = param->data.number;
+				break;
+			case ST_DATA_TYPE_STRING:
+				cmd_data.cmd_data[cmd_data.num_args].type = IOT_CAP_VAL_TYPE_STRING;
+				cmd_data.cmd_data[cmd_data.num_args].string = param->data.string;
+				break;
+			case ST_DATA_TYPE_RAW_JSON:
+				cmd_data.cmd_data[cmd_data.num_args].type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
+				cmd_data.cmd_data[cmd_data.num_args].json_object = param->data.raw_json;
+				break;
+			default:
+				continue;
+			}
+			cmd_data.num_args++;
+		}
+
+		IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_PROCESS_COMMAND, i + 1, 0);
+		iot_cap_process_cmd(ctx->cap_cmd_index, ctx->cap_handle_list, cmds[i].custom_component_name,
+				cmds[i].custom_cap_name, cmds[i].custom_command_name, &cmd_data);
+	}
+}
+
+void iot_cap_dispatch_commands_cbor(struct iot_context *ctx, uint8_t *payload, size_t len)
+{
+	CborParser parser;
+	CborValue root;
+	CborValue cap_cmds;
+	CborValue cmditem;
+	iot_error_t err;
+	bool complete;
+	bool all_complete = true;
+	int i;
+	int arr_size = 0;
+	iot_noti_data_t command_noti = {.type = IOT_NOTI_TYPE_COMMANDS,
+									.raw.commands.commands_data = NULL,
+									.raw.commands.commands_num = 0};
+
+	if (!ctx || !payload || !len) {
+		IOT_ERROR("There is no ctx or payload");
+		return;
+	}
+	ctx->cmd_dispatched++;
+
+	if (cbor_parser_init(payload, len, 0, &parser, &root) != CborNoError || !cbor_value_is_map(&root)) {
+		IOT_ERROR("Cannot parse by cbor");
+		return;
+	}
+	ctx->cmd_parsed++;
+	IOT_INFO("command : %d bytes of cbor", (int)len);
+
+	if (cbor_value_map_find_value(&root, "commands", &cap_cmds) != CborNoError ||
+			(arr_size = _iot_cbor_array_size(&cap_cmds, len)) < 0) {
+		IOT_ERROR("there is no commands in raw_data");
+		return;
+	}
+
+	IOT_DEBUG("cap_cmds arr_size=%d", arr_size);
+	IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_COMMANDS_RECEIVED, arr_size, 0);
+
+	if (arr_size == 0) {
+		IOT_ERROR("There are no commands data");
+		return;
+	}
+
+	command_noti.raw.commands.commands_num = arr_size;
+	command_noti.raw.commands.commands_data = (st_command_data *)iot_arena_calloc(&ctx->cmd_arena,
+			arr_size, sizeof(st_command_data));
+	if (!command_noti.raw.commands.commands_data) {
+		IOT_ERROR("Failed to malloc command_noti cmd data");
+		iot_arena_reset(&ctx->cmd_arena);
+		return;
+	}
+
+	if (cbor_value_enter_container(&cap_cmds, &cmditem) != CborNoError) {
+		IOT_ERROR("Cannot get commands data");
+		goto out;
+	}
+
+	/* Decoded once, both handler flavors share decoded commands */
+	for (i = 0; i < arr_size; i++) {
+		err = _iot_cbor_parse_cmd_data(&ctx->cmd_arena, &cmditem, len,
+				&command_noti.raw.commands.commands_data[i], &complete);
+		all_complete &= (err == IOT_ERROR_NONE) && complete;
+		if (err != IOT_ERROR_NONE) {
+			IOT_ERROR("Cannot parse %dth command data", i);
+			/* per-capability handler skips partially decoded command */
+			command_noti.raw.commands.commands_data[i].custom_command_name = NULL;
+		}
+		if (cbor_value_advance(&cmditem) != CborNoError) {
+			IOT_ERROR("Cannot get %dth commands data", i + 1);
+			arr_size = i + 1;
+			all_complete = false;
+			break;
+		}
+	}
+
+	if (ctx->cap_handle_list) {
+		_iot_cbor_cap_sub_process(ctx, command_noti.raw.commands.commands_data, arr_size);
+	}
+
+	if (all_complete && ctx->noti_cb)
+		ctx->noti_cb(&command_noti, ctx->noti_usr_data);
+out:
+	for (i = 0; i < command_noti.raw.commands.commands_num; i++) {
+		iot_cap_free_cmd_data_v2(&command_noti.raw.commands.commands_data[i]);
+	}
+	iot_arena_reset(&ctx->cmd_arena);
+}
+
+static iot_error_t _iot_cbor_parse_preference(const CborValue *sub_item, iot_preference_data *preference)
+{
+	CborValue preference_value;
+	char *preference_type;
+	double number;
+
+	if (!cbor_value_is_map(sub_item)) {
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	preference_type = _iot_cbor_find_string(sub_item, "preferenceType", NULL);
+	if (cbor_value_map_find_value(sub_item, "value", &preference_value) != CborNoError ||
+			!cbor_value_is_valid(&preference_value)) {
+		preference->preference_data.type = IOT_CAP_VAL_TYPE_NULL;
+	} else if (preference_type == NULL) {
+		preference->preference_data.type = IOT_CAP_VAL_TYPE_UNKNOWN;
+	} else if (!strncmp(preference_type, "string", 6)) {
+		preference->preference_data.type = IOT_CAP_VAL_TYPE_STRING;
+		preference->preference_data.string = _iot_cbor_dup_string(&preference_value, NULL);
+	} else if (!strncmp(preference_type, "number", 6) &&
+			_iot_cbor_get_number(&preference_value, &number)) {
+		preference->preference_data.type = IOT_CAP_VAL_TYPE_NUMBER;
+		preference->preference_data.number = number;
+	} else if (!strncmp(preference_type, "boolean", 7)) {
+		preference->preference_data.type = IOT_CAP_VAL_TYPE_BOOLEAN;
+		if (cbor_value_is_boolean(&preference_value))
+			cbor_value_get_boolean(&preference_value, &preference->preference_data.boolean);
+	} else if (!strncmp(preference_type, "integer", 7) &&
+			_iot_cbor_get_number(&preference_value, &number)) {
+		preference->preference_data.type = IOT_CAP_VAL_TYPE_INTEGER;
+		preference->preference_data.integer = _iot_cbor_number_to_int(number);
+	} else {
+		preference->preference_data.type = IOT_CAP_VAL_TYPE_UNKNOWN;
+	}
+
+	if (preference_type)
+		iot_os_free(preference_type);
+
+	return IOT_ERROR_NONE;
+}
+
+static iot_error_t _iot_cbor_parse_preferences(const CborValue *values, iot_noti_data_t *noti_data)
+{
+	CborValue sub_item;
+	size_t item_size = 0;
+	bool is_map = cbor_value_is_map(values);
+	int i;
+
+	/* Preferences come as a map keyed by name or as an array without names */
+	if (!is_map && !cbor_value_is_array(values)) {
+		return IOT_ERROR_BAD_REQ;
+	}
+	if (cbor_value_enter_container(values, &sub_item) != CborNoError) {
+		return IOT_ERROR_BAD_REQ;
+	}
+	while (!cbor_value_at_end(&sub_item)) {
+		if (cbor_value_advance(&sub_item) != CborNoError) {
+			return IOT_ERROR_BAD_REQ;
+		}
+		item_size++;
+	}
+	if (is_map) {
+		item_size /= 2;
+	}
+
+	if (item_size == 0) {
+		IOT_INFO("No references");
+		return IOT_ERROR_BAD_REQ;
+	}
+	noti_data->raw.preferences.preferences_num = item_size;
+	noti_data->raw.preferences.preferences_data = iot_os_malloc(
+			sizeof(iot_preference_data) * item_size);
+	if (!noti_data->raw.preferences.preferences_data) {
+		IOT_ERROR("Failed to alloc preferences data");
+		return IOT_ERROR_BAD_REQ;
+	}
+	memset(noti_data->raw.preferences.preferences_data, 0, sizeof(iot_preference_data) * item_size);
+
+	cbor_value_enter_container(values, &sub_item);
+	for (i = 0; i < (int)item_size; i++) {
+		iot_preference_data *preference = &noti_data->raw.preferences.preferences_data[i];
+
+		if (is_map) {
+			preference->preference_name = _iot_cbor_dup_string(&sub_item, NULL);
+			if (cbor_value_advance(&sub_item) != CborNoError) {
+				break;
+			}
+		}
+		if (_iot_cbor_parse_preference(&sub_item, preference) != IOT_ERROR_NONE) {
+			IOT_ERROR("Cannot get %dth item data", i);
+		}
+		if (cbor_value_advance(&sub_item) != CborNoError) {
+			break;
+		}
+	}
+
+	return IOT_ERROR_NONE;
+}
+
+STATIC_FUNCTION
+iot_error_t _iot_parse_noti_data_cbor(uint8_t *data, size_t len, iot_noti_data_t *noti_data)
+{
+	CborParser parser;
+	CborValue root;
+	CborValue values;
+	char *noti_type_string = NULL;
+	char time_str[11] = {0,};
+	int current_time;
+	iot_error_t err = IOT_ERROR_NONE;
+
+	if (cbor_parser_init(data, len, 0, &parser, &root) != CborNoError || !cbor_value_is_map(&root)) {
+		IOT_ERROR("Cannot parse by cbor");
+		return IOT_ERROR_BAD_REQ;
+	}
+	IOT_INFO("payload : %d bytes of cbor", (int)len);
+
+	noti_type_string = _iot_cbor_find_string(&root, "event", NULL);
+	if (noti_type_string == NULL) {
+		IOT_ERROR("there is no event in raw_msgn");
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	if (!strncmp(noti_type_string, SERVER_NOTI_TYPE_DEVICE_DELETED, strlen(SERVER_NOTI_TYPE_DEVICE_DELETED))) {
+		IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_DEVICE_DELETED_RECEIVED, 0, 0);
+
+		noti_data->type = _IOT_NOTI_TYPE_DEV_DELETED;
+	} else if (!strncmp(noti_type_string, SERVER_NOTI_TYPE_EXPIRED_JWT, strlen(SERVER_NOTI_TYPE_EXPIRED_JWT))) {
+		noti_data->type = _IOT_NOTI_TYPE_JWT_EXPIRED;
+
+		if (!_iot_cbor_find_int(&root, "currentTime", &current_time)) {
+			IOT_ERROR("there is no currentTime in raw_msgn");
+			err = IOT_ERROR_BAD_REQ;
+			goto out_noti_parse;
+		}
+
+		snprintf(time_str, sizeof(time_str), "%d", current_time);
+		IOT_INFO("Set SNTP with current time %s", time_str);
+		iot_bsp_system_set_time_in_sec(time_str);
+		IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_EXPIRED_JWT_RECEIVED, current_time, 0);
+	} else if (!strncmp(noti_type_string, SERVER_NOTI_TYPE_RATE_LIMIT_REACHED, strlen(SERVER_NOTI_TYPE_RATE_LIMIT_REACHED))) {
+		noti_data->type = _IOT_NOTI_TYPE_RATE_LIMIT;
+
+		if (!_iot_cbor_find_int(&root, "count", &noti_data->raw.rate_limit.count) ||
+				!_iot_cbor_find_int(&root, "threshold", &noti_data->raw.rate_limit.threshold) ||
+				!_iot_cbor_find_int(&root, "remainingTime", &noti_data->raw.rate_limit.remainingTime) ||
+				!_iot_cbor_find_int(&root, "sequenceNumber", &noti_data->raw.rate_limit.sequenceNumber)) {
+			IOT_ERROR("there is no rate limit data in raw_msgn");
+			err = IOT_ERROR_BAD_REQ;
+			goto out_noti_parse;
+		}
+		IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_RATE_LIMIT_RECEIVED, noti_data->raw.rate_limit.sequenceNumber, 0);
+	} else if (!strncmp(noti_type_string, SERVER_NOTI_TYPE_QUOTA_REACHED, strlen(SERVER_NOTI_TYPE_QUOTA_REACHED))) {
+		noti_data->type = _IOT_NOTI_TYPE_QUOTA_REACHED;
+
+		if (!_iot_cbor_find_int(&root, "used", &noti_data->raw.quota.used) ||
+				!_iot_cbor_find_int(&root, "limit", &noti_data->raw.quota.limit)) {
+			IOT_ERROR("there is no quota data in raw_msgn");
+			err = IOT_ERROR_BAD_REQ;
+			goto out_noti_parse;
+		}
+		IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_QUOTA_LIMIT_RECEIVED, noti_data->raw.quota.used, noti_data->raw.quota.limit);
+	} else if (!strncmp(noti_type_string, SERVER_NOTI_TYPE_PREFERENCE_UPDATED, strlen(SERVER_NOTI_TYPE_PREFERENCE_UPDATED))) {
+		noti_data->type = _IOT_NOTI_TYPE_PREFERENCE_UPDATED;
+
+		if (cbor_value_map_find_value(&root, "values", &values) != CborNoError ||
+				!cbor_value_is_valid(&values)) {
+			IOT_ERROR("there is value in updated preference");
+			err = IOT_ERROR_BAD_REQ;
+			goto out_noti_parse;
+		}
+		err = _iot_cbor_parse_preferences(&values, noti_data);
+	} else {
+		IOT_WARN("There is no noti_type matched");
+		err = IOT_ERROR_BAD_REQ;
+	}
+
+out_noti_parse:
+	iot_os_free(noti_type_string);
+
+	return err;
+}
+
+void iot_noti_sub_cb_cbor(struct iot_context *ctx, uint8_t *payload, size_t len)
+{
+	iot_error_t err;
+	iot_noti_data_t noti_data;
+
+	if (!ctx || !payload || !len) {
+		IOT_ERROR("There is no ctx or payload");
+		return;
+	}
+
+	memset(&noti_data, 0, sizeof(iot_noti_data_t));
+
+	IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_CAPABILITY_NOTI_RECEIVED, 0, 0);
+	err = _iot_parse_noti_data_cbor(payload, len, &noti_data);
+	if (err != IOT_ERROR_NONE) {
+		IOT_INFO("Ignore notification");
+		return;
+	}
+	iot_cap_noti_process(ctx, &noti_data);
+}
+#endif /* STDK_IOT_CORE_SERIALIZE_CBOR */
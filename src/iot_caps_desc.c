@@ -0,0 +1,1481 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Generated by tools/capgen/stdk-capgen.py from iot_caps_helper_*.h, do not edit */
+
+#include <stddef.h>
+
+#include "iot_capability.h"
+#include "caps/iot_caps_helper.h"
+#include "caps/iot_caps_desc.h"
+
+/* Only the key fragment of event payload format is built in */
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+#define _IOT_CAPS_KEY(json, cbor)	.key = cbor, .key_len = sizeof(cbor) - 1
+#else
+#define _IOT_CAPS_KEY(json, cbor)	.key = json, .key_len = sizeof(json) - 1
+#endif
+
+static const char *const _accelerationSensor_acceleration_values[] = {"active", "inactive"};
+static const char *const _activityLightingMode_lightingMode_values[] = {"reading", "writing", "computer", "night", "sleepPreparation", "day", "cozy", "soft"};
+static const char *const _airQualitySensor_airQuality_units[] = {"CAQI"};
+static const char *const _alarm_alarm_values[] = {"both", "off", "siren", "strobe"};
+static const char *const _audioMute_mute_values[] = {"muted", "unmuted"};
+static const char *const _audioVolume_volume_units[] = {"%"};
+static const char *const _battery_battery_units[] = {"%"};
+static const char *const _bodyMassIndexMeasurement_bmiMeasurement_units[] = {"kg/m^2"};
+static const char *const _bodyWeightMeasurement_bodyWeightMeasurement_units[] = {"kg", "lbs", "斤"};
+static const char *const _button_supportedButtonValues_values[] = {"pushed", "held", "double", "pushed_2x", "pushed_3x", "pushed_4x", "pushed_5x", "pushed_6x", "down", "down_2x", "down_3x", "down_4x", "down_5x", "down_6x", "down_hold", "up", "up_2x", "up_3x", "up_4x", "up_5x", "up_6x", "up_hold"};
+static const char *const _button_button_values[] = {"pushed", "held", "double", "pushed_2x", "pushed_3x", "pushed_4x", "pushed_5x", "pushed_6x", "down", "down_2x", "down_3x", "down_4x", "down_5x", "down_6x", "down_hold", "up", "up_2x", "up_3x", "up_4x", "up_5x", "up_6x", "up_hold"};
+static const char *const _carbonDioxideHealthConcern_carbonDioxideHealthConcern_values[] = {"good", "moderate", "slightlyUnhealthy", "unhealthy", "veryUnhealthy", "hazardous"};
+static const char *const _carbonDioxideMeasurement_carbonDioxide_units[] = {"ppm"};
+static const char *const _carbonMonoxideDetector_carbonMonoxide_values[] = {"clear", "detected", "tested"};
+static const char *const _carbonMonoxideMeasurement_carbonMonoxideLevel_units[] = {"ppm"};
+static const char *const _colorTemperature_colorTemperature_units[] = {"K"};
+static const char *const _contactSensor_contact_values[] = {"closed", "open"};
+static const char *const _dishwasherOperatingState_supportedMachineStates_values[] = {"pause", "run", "stop"};
+static const char *const _dishwasherOperatingState_machineState_values[] = {"pause", "run", "stop"};
+static const char *const _dishwasherOperatingState_dishwasherJobState_values[] = {"airwash", "cooling", "drying", "finish", "preDrain", "prewash", "rinse", "spin", "unknown", "wash", "wrinklePrevent"};
+static const char *const _doorControl_door_values[] = {"closed", "closing", "open", "opening", "unknown"};
+static const char *const _dryerOperatingState_supportedMachineStates_values[] = {"pause", "run", "stop"};
+static const char *const _dryerOperatingState_machineState_values[] = {"pause", "run", "stop"};
+static const char *const _dryerOperatingState_dryerJobState_values[] = {"cooling", "delayWash", "drying", "finished", "none", "refreshing", "weightSensing", "wrinklePrevent", "dehumidifying", "aIDrying", "sanitizing", "internalCare"};
+static const char *const _dustHealthConcern_dustHealthConcern_values[] = {"good", "moderate", "slightlyUnhealthy", "unhealthy", "veryUnhealthy", "hazardous"};
+static const char *const _dustSensor_fineDustLevel_units[] = {"μg/m^3"};
+static const char *const _dustSensor_dustLevel_units[] = {"μg/m^3"};
+static const char *const _energyMeter_energy_units[] = {"Wh", "kWh", "mWh", "kVAh"};
+static const char *const _equivalentCarbonDioxideMeasurement_equivalentCarbonDioxideMeasurement_units[] = {"ppm"};
+static const char *const _fanOscillationMode_supportedFanOscillationModes_values[] = {"'off'", "individual", "fixed", "vertical", "horizontal", "all", "indirect", "direct", "fixedCenter", "fixedLeft", "fixedRight", "far", "wide", "mid", "spot", "swing"};
+static const char *const _fanOscillationMode_fanOscillationMode_values[] = {"'off'", "individual", "fixed", "vertical", "horizontal", "all", "indirect", "direct", "fixedCenter", "fixedLeft", "fixedRight", "far", "wide", "mid", "spot", "swing"};
+static const char *const _filterStatus_filterStatus_values[] = {"normal", "replace"};
+static const char *const _fineDustHealthConcern_fineDustHealthConcern_values[] = {"good", "moderate", "slightlyUnhealthy", "unhealthy", "veryUnhealthy", "hazardous"};
+static const char *const _fineDustSensor_fineDustLevel_units[] = {"μg/m^3"};
+static const char *const _firmwareUpdate_lastUpdateStatus_values[] = {"updateSucceeded", "updateFailed"};
+static const char *const _firmwareUpdate_state_values[] = {"normalOperation", "updateInProgress"};
+static const char *const _formaldehydeMeasurement_formaldehydeLevel_units[] = {"ppm", "mg/m^3"};
+static const char *const _garageDoorControl_door_values[] = {"closed", "closing", "open", "opening", "unknown"};
+static const char *const _gasMeter_gasMeter_units[] = {"kWh"};
+static const char *const _gasMeter_gasMeterVolume_units[] = {"m^3"};
+static const char *const _illuminanceMeasurement_illuminance_units[] = {"lux"};
+static const char *const _lock_lock_values[] = {"locked", "unknown", "unlocked", "unlocked with timeout"};
+static const char *const _mediaInputSource_inputSource_values[] = {"AM", "CD", "FM", "HDMI", "HDMI1", "HDMI2", "HDMI3", "HDMI4", "HDMI5", "HDMI6", "digitalTv", "USB", "YouTube", "aux", "bluetooth", "digital", "melon", "wifi"};
+static const char *const _mediaInputSource_supportedInputSources_values[] = {"AM", "CD", "FM", "HDMI", "HDMI1", "HDMI2", "HDMI3", "HDMI4", "HDMI5", "HDMI6", "digitalTv", "USB", "YouTube", "aux", "bluetooth", "digital", "melon", "wifi"};
+static const char *const _mediaPlayback_supportedPlaybackCommands_values[] = {"pause", "play", "stop", "fastForward", "rewind"};
+static const char *const _mediaPlayback_playbackStatus_values[] = {"paused", "playing", "stopped", "fast forwarding", "rewinding"};
+static const char *const _mediaPlaybackRepeat_playbackRepeatMode_values[] = {"all", "off", "one"};
+static const char *const _mediaPlaybackShuffle_playbackShuffle_values[] = {"disabled", "enabled"};
+static const char *const _moldHealthConcern_moldHealthConcern_values[] = {"good", "moderate", "slightlyUnhealthy", "unhealthy", "veryUnhealthy", "hazardous"};
+static const char *const _motionSensor_motion_values[] = {"active", "inactive"};
+static const char *const _operatingState_supportedMachineStates_values[] = {"paused", "running", "ready"};
+static const char *const _operatingState_machineState_values[] = {"paused", "running", "ready"};
+static const char *const _ovenOperatingState_ovenJobState_values[] = {"cleaning", "cooking", "cooling", "draining", "preheat", "ready", "rinsing", "finished", "scheduledStart", "warming", "defrosting", "sensing", "searing", "fastPreheat", "scheduledEnd", "stoneHeating", "timeHoldPreheat"};
+static const char *const _ovenOperatingState_supportedMachineStates_values[] = {"ready", "running", "paused"};
+static const char *const _ovenOperatingState_progress_units[] = {"%"};
+static const char *const _ovenOperatingState_machineState_values[] = {"ready", "running", "paused"};
+static const char *const _pHMeasurement_pH_units[] = {"pH"};
+static const char *const _panicAlarm_panicAlarm_values[] = {"panic", "clear"};
+static const char *const _powerMeter_power_units[] = {"W"};
+static const char *const _powerSource_powerSource_values[] = {"battery", "dc", "mains", "unknown"};
+static const char *const _presenceSensor_presence_values[] = {"present", "not present"};
+static const char *const _radonHealthConcern_radonHealthConcern_values[] = {"good", "moderate", "slightlyUnhealthy", "unhealthy", "veryUnhealthy", "hazardous"};
+static const char *const _rapidCooling_rapidCooling_values[] = {"off", "on"};
+static const char *const _relativeHumidityMeasurement_humidity_units[] = {"%"};
+static const char *const _remoteControlStatus_remoteControlEnabled_values[] = {"true", "false"};
+static const char *const _robotCleanerMovement_robotCleanerMovement_values[] = {"homing", "idle", "charging", "alarm", "powerOff", "reserve", "point", "after", "cleaning", "pause"};
+static const char *const _robotCleanerTurboMode_robotCleanerTurboMode_values[] = {"on", "off", "silence"};
+static const char *const _samsungTV_switch_values[] = {"on", "off"};
+static const char *const _samsungTV_mute_values[] = {"muted", "unknown", "unmuted"};
+static const char *const _samsungTV_pictureMode_values[] = {"dynamic", "movie", "standard", "unknown"};
+static const char *const _samsungTV_soundMode_values[] = {"clear voice", "movie", "music", "standard", "unknown"};
+static const char *const _securitySystem_securitySystemStatus_values[] = {"armedAway", "armedStay", "disarmed"};
+static const char *const _signalStrength_rssi_units[] = {"dBm"};
+static const char *const _sleepSensor_sleeping_values[] = {"not sleeping", "sleeping"};
+static const char *const _smokeDetector_smoke_values[] = {"clear", "detected", "tested"};
+static const char *const _soundPressureLevel_soundPressureLevel_units[] = {"dB"};
+static const char *const _soundSensor_sound_values[] = {"detected", "not detected"};
+static const char *const _switch_switch_values[] = {"on", "off"};
+static const char *const _switchLevel_level_units[] = {"%"};
+static const char *const _tamperAlert_tamper_values[] = {"clear", "detected"};
+static const char *const _temperatureAlarm_temperatureAlarm_values[] = {"cleared", "freeze", "heat", "rateOfRise"};
+static const char *const _temperatureMeasurement_temperature_units[] = {"F", "C"};
+static const char *const _thermostatCoolingSetpoint_coolingSetpoint_units[] = {"F", "C"};
+static const char *const _thermostatFanMode_thermostatFanMode_values[] = {"auto", "circulate", "followschedule", "on"};
+static const char *const _thermostatFanMode_supportedThermostatFanModes_values[] = {"auto", "circulate", "followschedule", "on"};
+static const char *const _thermostatHeatingSetpoint_heatingSetpoint_units[] = {"F", "C"};
+static const char *const _thermostatMode_thermostatMode_values[] = {"asleep", "auto", "autowitheco", "autowithreset", "autochangeover", "autochangeoveractive", "autocool", "autoheat", "auxheatonly", "auxiliaryemergencyheat", "away", "cool", "custom", "dayoff", "dryair", "eco", "emergency heat", "emergencyheat", "emergencyheatactive", "energysavecool", "energysaveheat", "fanonly", "frostguard", "furnace", "heat", "heatingoff", "home", "in", "manual", "moistair", "off", "out", "resume", "rush hour", "rushhour", "schedule", "southernaway"};
+static const char *const _thermostatMode_supportedThermostatModes_values[] = {"asleep", "auto", "autowitheco", "autowithreset", "autochangeover", "autochangeoveractive", "autocool", "autoheat", "auxheatonly", "auxiliaryemergencyheat", "away", "cool", "custom", "dayoff", "dryair", "eco", "emergency heat", "emergencyheat", "emergencyheatactive", "energysavecool", "energysaveheat", "fanonly", "frostguard", "furnace", "heat", "heatingoff", "home", "in", "manual", "moistair", "off", "out", "resume", "rush hour", "rushhour", "schedule", "southernaway"};
+static const char *const _thermostatOperatingState_thermostatOperatingState_values[] = {"cooling", "fan only", "heating", "idle", "pending cool", "pending heat", "vent economizer"};
+static const char *const _thermostatSetpoint_thermostatSetpoint_units[] = {"F", "C"};
+static const char *const _threeAxis_threeAxis_units[] = {"mG"};
+static const char *const _timedSession_sessionStatus_values[] = {"canceled", "paused", "running", "stopped"};
+static const char *const _tvocHealthConcern_tvocHealthConcern_values[] = {"good", "moderate", "slightlyUnhealthy", "unhealthy", "veryUnhealthy", "hazardous"};
+static const char *const _tvocMeasurement_tvocLevel_units[] = {"ppm"};
+static const char *const _valve_valve_values[] = {"closed", "open"};
+static const char *const _veryFineDustHealthConcern_veryFineDustHealthConcern_values[] = {"good", "moderate", "slightlyUnhealthy", "unhealthy", "veryUnhealthy", "hazardous"};
+static const char *const _veryFineDustSensor_veryFineDustLevel_units[] = {"μg/m^3"};
+static const char *const _voltageMeasurement_voltage_units[] = {"V"};
+static const char *const _waterSensor_water_values[] = {"dry", "wet"};
+static const char *const _windowShade_windowShade_values[] = {"closed", "closing", "open", "opening", "partially open", "unknown"};
+static const char *const _windowShade_supportedWindowShadeCommands_values[] = {"open", "close", "pause"};
+
+const iot_caps_attr_desc_t iot_caps_attr_descs[IOT_CAPS_ATTR_MAX] = {
+	[IOT_CAPS_ATTR_ACCELERATIONSENSOR_ACCELERATION] = {
+		.capability = "accelerationSensor",
+		.name = "acceleration",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _accelerationSensor_acceleration_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"accelerationSensor\",\"attribute\":\"acceleration\"",
+				"\x6a" "capability" "\x72" "accelerationSensor" "\x69" "attribute" "\x6c" "acceleration"),
+	},
+	[IOT_CAPS_ATTR_ACTIVITYLIGHTINGMODE_LIGHTINGMODE] = {
+		.capability = "activityLightingMode",
+		.name = "lightingMode",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _activityLightingMode_lightingMode_values,
+		.values_num = 8,
+		_IOT_CAPS_KEY("\"capability\":\"activityLightingMode\",\"attribute\":\"lightingMode\"",
+				"\x6a" "capability" "\x74" "activityLightingMode" "\x69" "attribute" "\x6c" "lightingMode"),
+	},
+	[IOT_CAPS_ATTR_AIRQUALITYSENSOR_AIRQUALITY] = {
+		.capability = "airQualitySensor",
+		.name = "airQuality",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.max = 100,
+		.units = _airQualitySensor_airQuality_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"airQualitySensor\",\"attribute\":\"airQuality\"",
+				"\x6a" "capability" "\x70" "airQualitySensor" "\x69" "attribute" "\x6a" "airQuality"),
+	},
+	[IOT_CAPS_ATTR_ALARM_ALARM] = {
+		.capability = "alarm",
+		.name = "alarm",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _alarm_alarm_values,
+		.values_num = 4,
+		_IOT_CAPS_KEY("\"capability\":\"alarm\",\"attribute\":\"alarm\"",
+				"\x6a" "capability" "\x65" "alarm" "\x69" "attribute" "\x65" "alarm"),
+	},
+	[IOT_CAPS_ATTR_AUDIOMUTE_MUTE] = {
+		.capability = "audioMute",
+		.name = "mute",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _audioMute_mute_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"audioMute\",\"attribute\":\"mute\"",
+				"\x6a" "capability" "\x69" "audioMute" "\x69" "attribute" "\x64" "mute"),
+	},
+	[IOT_CAPS_ATTR_AUDIOVOLUME_VOLUME] = {
+		.capability = "audioVolume",
+		.name = "volume",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.max = 100,
+		.units = _audioVolume_volume_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"audioVolume\",\"attribute\":\"volume\"",
+				"\x6a" "capability" "\x6b" "audioVolume" "\x69" "attribute" "\x66" "volume"),
+	},
+	[IOT_CAPS_ATTR_BATTERY_BATTERY] = {
+		.capability = "battery",
+		.name = "battery",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.max = 100,
+		.units = _battery_battery_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"battery\",\"attribute\":\"battery\"",
+				"\x6a" "capability" "\x67" "battery" "\x69" "attribute" "\x67" "battery"),
+	},
+	[IOT_CAPS_ATTR_BODYMASSINDEXMEASUREMENT_BMIMEASUREMENT] = {
+		.capability = "bodyMassIndexMeasurement",
+		.name = "bmiMeasurement",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.units = _bodyMassIndexMeasurement_bmiMeasurement_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"bodyMassIndexMeasurement\",\"attribute\":\"bmiMeasurement\"",
+				"\x6a" "capability" "\x78\x18" "bodyMassIndexMeasurement" "\x69" "attribute" "\x6e" "bmiMeasurement"),
+	},
+	[IOT_CAPS_ATTR_BODYWEIGHTMEASUREMENT_BODYWEIGHTMEASUREMENT] = {
+		.capability = "bodyWeightMeasurement",
+		.name = "bodyWeightMeasurement",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED | ATTR_SET_UNIT_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.units = _bodyWeightMeasurement_bodyWeightMeasurement_units,
+		.units_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"bodyWeightMeasurement\",\"attribute\":\"bodyWeightMeasurement\"",
+				"\x6a" "capability" "\x75" "bodyWeightMeasurement" "\x69" "attribute" "\x75" "bodyWeightMeasurement"),
+	},
+	[IOT_CAPS_ATTR_BUTTON_SUPPORTEDBUTTONVALUES] = {
+		.capability = "button",
+		.name = "supportedButtonValues",
+		.property = ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _button_supportedButtonValues_values,
+		.values_num = 22,
+		_IOT_CAPS_KEY("\"capability\":\"button\",\"attribute\":\"supportedButtonValues\"",
+				"\x6a" "capability" "\x66" "button" "\x69" "attribute" "\x75" "supportedButtonValues"),
+	},
+	[IOT_CAPS_ATTR_BUTTON_BUTTON] = {
+		.capability = "button",
+		.name = "button",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _button_button_values,
+		.values_num = 22,
+		_IOT_CAPS_KEY("\"capability\":\"button\",\"attribute\":\"button\"",
+				"\x6a" "capability" "\x66" "button" "\x69" "attribute" "\x66" "button"),
+	},
+	[IOT_CAPS_ATTR_BUTTON_NUMBEROFBUTTONS] = {
+		.capability = "button",
+		.name = "numberOfButtons",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"button\",\"attribute\":\"numberOfButtons\"",
+				"\x6a" "capability" "\x66" "button" "\x69" "attribute" "\x6f" "numberOfButtons"),
+	},
+	[IOT_CAPS_ATTR_CARBONDIOXIDEHEALTHCONCERN_CARBONDIOXIDEHEALTHCONCERN] = {
+		.capability = "carbonDioxideHealthConcern",
+		.name = "carbonDioxideHealthConcern",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _carbonDioxideHealthConcern_carbonDioxideHealthConcern_values,
+		.values_num = 6,
+		_IOT_CAPS_KEY("\"capability\":\"carbonDioxideHealthConcern\",\"attribute\":\"carbonDioxideHealthConcern\"",
+				"\x6a" "capability" "\x78\x1a" "carbonDioxideHealthConcern" "\x69" "attribute" "\x78\x1a" "carbonDioxideHealthConcern"),
+	},
+	[IOT_CAPS_ATTR_CARBONDIOXIDEMEASUREMENT_CARBONDIOXIDE] = {
+		.capability = "carbonDioxideMeasurement",
+		.name = "carbonDioxide",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.max = 1000000,
+		.units = _carbonDioxideMeasurement_carbonDioxide_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"carbonDioxideMeasurement\",\"attribute\":\"carbonDioxide\"",
+				"\x6a" "capability" "\x78\x18" "carbonDioxideMeasurement" "\x69" "attribute" "\x6d" "carbonDioxide"),
+	},
+	[IOT_CAPS_ATTR_CARBONMONOXIDEDETECTOR_CARBONMONOXIDE] = {
+		.capability = "carbonMonoxideDetector",
+		.name = "carbonMonoxide",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _carbonMonoxideDetector_carbonMonoxide_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"carbonMonoxideDetector\",\"attribute\":\"carbonMonoxide\"",
+				"\x6a" "capability" "\x76" "carbonMonoxideDetector" "\x69" "attribute" "\x6e" "carbonMonoxide"),
+	},
+	[IOT_CAPS_ATTR_CARBONMONOXIDEMEASUREMENT_CARBONMONOXIDELEVEL] = {
+		.capability = "carbonMonoxideMeasurement",
+		.name = "carbonMonoxideLevel",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED | ATTR_SET_UNIT_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.max = 1000000,
+		.units = _carbonMonoxideMeasurement_carbonMonoxideLevel_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"carbonMonoxideMeasurement\",\"attribute\":\"carbonMonoxideLevel\"",
+				"\x6a" "capability" "\x78\x19" "carbonMonoxideMeasurement" "\x69" "attribute" "\x73" "carbonMonoxideLevel"),
+	},
+	[IOT_CAPS_ATTR_COLORCONTROL_COLOR] = {
+		.capability = "colorControl",
+		.name = "color",
+		.property = ATTR_SET_MAX_LENGTH,
+		.value_type = VALUE_TYPE_STRING,
+		.max_length = 255,
+		_IOT_CAPS_KEY("\"capability\":\"colorControl\",\"attribute\":\"color\"",
+				"\x6a" "capability" "\x6c" "colorControl" "\x69" "attribute" "\x65" "color"),
+	},
+	[IOT_CAPS_ATTR_COLORCONTROL_HUE] = {
+		.capability = "colorControl",
+		.name = "hue",
+		.property = ATTR_SET_VALUE_MIN,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"colorControl\",\"attribute\":\"hue\"",
+				"\x6a" "capability" "\x6c" "colorControl" "\x69" "attribute" "\x63" "hue"),
+	},
+	[IOT_CAPS_ATTR_COLORCONTROL_SATURATION] = {
+		.capability = "colorControl",
+		.name = "saturation",
+		.property = ATTR_SET_VALUE_MIN,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"colorControl\",\"attribute\":\"saturation\"",
+				"\x6a" "capability" "\x6c" "colorControl" "\x69" "attribute" "\x6a" "saturation"),
+	},
+	[IOT_CAPS_ATTR_COLORTEMPERATURE_COLORTEMPERATURE] = {
+		.capability = "colorTemperature",
+		.name = "colorTemperature",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 1,
+		.max = 30000,
+		.units = _colorTemperature_colorTemperature_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"colorTemperature\",\"attribute\":\"colorTemperature\"",
+				"\x6a" "capability" "\x70" "colorTemperature" "\x69" "attribute" "\x70" "colorTemperature"),
+	},
+	[IOT_CAPS_ATTR_CONTACTSENSOR_CONTACT] = {
+		.capability = "contactSensor",
+		.name = "contact",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _contactSensor_contact_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"contactSensor\",\"attribute\":\"contact\"",
+				"\x6a" "capability" "\x6d" "contactSensor" "\x69" "attribute" "\x67" "contact"),
+	},
+	[IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_COMPLETIONTIME] = {
+		.capability = "dishwasherOperatingState",
+		.name = "completionTime",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"dishwasherOperatingState\",\"attribute\":\"completionTime\"",
+				"\x6a" "capability" "\x78\x18" "dishwasherOperatingState" "\x69" "attribute" "\x6e" "completionTime"),
+	},
+	[IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_SUPPORTEDMACHINESTATES] = {
+		.capability = "dishwasherOperatingState",
+		.name = "supportedMachineStates",
+		.property = ATTR_SET_VALUE_REQUIRED | ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _dishwasherOperatingState_supportedMachineStates_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"dishwasherOperatingState\",\"attribute\":\"supportedMachineStates\"",
+				"\x6a" "capability" "\x78\x18" "dishwasherOperatingState" "\x69" "attribute" "\x76" "supportedMachineStates"),
+	},
+	[IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_MACHINESTATE] = {
+		.capability = "dishwasherOperatingState",
+		.name = "machineState",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _dishwasherOperatingState_machineState_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"dishwasherOperatingState\",\"attribute\":\"machineState\"",
+				"\x6a" "capability" "\x78\x18" "dishwasherOperatingState" "\x69" "attribute" "\x6c" "machineState"),
+	},
+	[IOT_CAPS_ATTR_DISHWASHEROPERATINGSTATE_DISHWASHERJOBSTATE] = {
+		.capability = "dishwasherOperatingState",
+		.name = "dishwasherJobState",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _dishwasherOperatingState_dishwasherJobState_values,
+		.values_num = 11,
+		_IOT_CAPS_KEY("\"capability\":\"dishwasherOperatingState\",\"attribute\":\"dishwasherJobState\"",
+				"\x6a" "capability" "\x78\x18" "dishwasherOperatingState" "\x69" "attribute" "\x72" "dishwasherJobState"),
+	},
+	[IOT_CAPS_ATTR_DOORCONTROL_DOOR] = {
+		.capability = "doorControl",
+		.name = "door",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _doorControl_door_values,
+		.values_num = 5,
+		_IOT_CAPS_KEY("\"capability\":\"doorControl\",\"attribute\":\"door\"",
+				"\x6a" "capability" "\x6b" "doorControl" "\x69" "attribute" "\x64" "door"),
+	},
+	[IOT_CAPS_ATTR_DRYEROPERATINGSTATE_COMPLETIONTIME] = {
+		.capability = "dryerOperatingState",
+		.name = "completionTime",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"dryerOperatingState\",\"attribute\":\"completionTime\"",
+				"\x6a" "capability" "\x73" "dryerOperatingState" "\x69" "attribute" "\x6e" "completionTime"),
+	},
+	[IOT_CAPS_ATTR_DRYEROPERATINGSTATE_SUPPORTEDMACHINESTATES] = {
+		.capability = "dryerOperatingState",
+		.name = "supportedMachineStates",
+		.property = ATTR_SET_VALUE_REQUIRED | ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _dryerOperatingState_supportedMachineStates_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"dryerOperatingState\",\"attribute\":\"supportedMachineStates\"",
+				"\x6a" "capability" "\x73" "dryerOperatingState" "\x69" "attribute" "\x76" "supportedMachineStates"),
+	},
+	[IOT_CAPS_ATTR_DRYEROPERATINGSTATE_MACHINESTATE] = {
+		.capability = "dryerOperatingState",
+		.name = "machineState",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _dryerOperatingState_machineState_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"dryerOperatingState\",\"attribute\":\"machineState\"",
+				"\x6a" "capability" "\x73" "dryerOperatingState" "\x69" "attribute" "\x6c" "machineState"),
+	},
+	[IOT_CAPS_ATTR_DRYEROPERATINGSTATE_DRYERJOBSTATE] = {
+		.capability = "dryerOperatingState",
+		.name = "dryerJobState",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _dryerOperatingState_dryerJobState_values,
+		.values_num = 12,
+		_IOT_CAPS_KEY("\"capability\":\"dryerOperatingState\",\"attribute\":\"dryerJobState\"",
+				"\x6a" "capability" "\x73" "dryerOperatingState" "\x69" "attribute" "\x6d" "dryerJobState"),
+	},
+	[IOT_CAPS_ATTR_DUSTHEALTHCONCERN_DUSTHEALTHCONCERN] = {
+		.capability = "dustHealthConcern",
+		.name = "dustHealthConcern",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _dustHealthConcern_dustHealthConcern_values,
+		.values_num = 6,
+		_IOT_CAPS_KEY("\"capability\":\"dustHealthConcern\",\"attribute\":\"dustHealthConcern\"",
+				"\x6a" "capability" "\x71" "dustHealthConcern" "\x69" "attribute" "\x71" "dustHealthConcern"),
+	},
+	[IOT_CAPS_ATTR_DUSTSENSOR_FINEDUSTLEVEL] = {
+		.capability = "dustSensor",
+		.name = "fineDustLevel",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.units = _dustSensor_fineDustLevel_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"dustSensor\",\"attribute\":\"fineDustLevel\"",
+				"\x6a" "capability" "\x6a" "dustSensor" "\x69" "attribute" "\x6d" "fineDustLevel"),
+	},
+	[IOT_CAPS_ATTR_DUSTSENSOR_DUSTLEVEL] = {
+		.capability = "dustSensor",
+		.name = "dustLevel",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.units = _dustSensor_dustLevel_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"dustSensor\",\"attribute\":\"dustLevel\"",
+				"\x6a" "capability" "\x6a" "dustSensor" "\x69" "attribute" "\x69" "dustLevel"),
+	},
+	[IOT_CAPS_ATTR_ENERGYMETER_ENERGY] = {
+		.capability = "energyMeter",
+		.name = "energy",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.units = _energyMeter_energy_units,
+		.units_num = 4,
+		_IOT_CAPS_KEY("\"capability\":\"energyMeter\",\"attribute\":\"energy\"",
+				"\x6a" "capability" "\x6b" "energyMeter" "\x69" "attribute" "\x66" "energy"),
+	},
+	[IOT_CAPS_ATTR_EQUIVALENTCARBONDIOXIDEMEASUREMENT_EQUIVALENTCARBONDIOXIDEMEASUREMENT] = {
+		.capability = "equivalentCarbonDioxideMeasurement",
+		.name = "equivalentCarbonDioxideMeasurement",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.max = 1000000,
+		.units = _equivalentCarbonDioxideMeasurement_equivalentCarbonDioxideMeasurement_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"equivalentCarbonDioxideMeasurement\",\"attribute\":\"equivalentCarbonDioxideMeasurement\"",
+				"\x6a" "capability" "\x78\x22" "equivalentCarbonDioxideMeasurement" "\x69" "attribute" "\x78\x22" "equivalentCarbonDioxideMeasurement"),
+	},
+	[IOT_CAPS_ATTR_EXECUTE_DATA] = {
+		.capability = "execute",
+		.name = "data",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_OBJECT,
+		_IOT_CAPS_KEY("\"capability\":\"execute\",\"attribute\":\"data\"",
+				"\x6a" "capability" "\x67" "execute" "\x69" "attribute" "\x64" "data"),
+	},
+	[IOT_CAPS_ATTR_FANOSCILLATIONMODE_SUPPORTEDFANOSCILLATIONMODES] = {
+		.capability = "fanOscillationMode",
+		.name = "supportedFanOscillationModes",
+		.property = ATTR_SET_VALUE_REQUIRED | ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _fanOscillationMode_supportedFanOscillationModes_values,
+		.values_num = 16,
+		_IOT_CAPS_KEY("\"capability\":\"fanOscillationMode\",\"attribute\":\"supportedFanOscillationModes\"",
+				"\x6a" "capability" "\x72" "fanOscillationMode" "\x69" "attribute" "\x78\x1c" "supportedFanOscillationModes"),
+	},
+	[IOT_CAPS_ATTR_FANOSCILLATIONMODE_FANOSCILLATIONMODE] = {
+		.capability = "fanOscillationMode",
+		.name = "fanOscillationMode",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _fanOscillationMode_fanOscillationMode_values,
+		.values_num = 16,
+		_IOT_CAPS_KEY("\"capability\":\"fanOscillationMode\",\"attribute\":\"fanOscillationMode\"",
+				"\x6a" "capability" "\x72" "fanOscillationMode" "\x69" "attribute" "\x72" "fanOscillationMode"),
+	},
+	[IOT_CAPS_ATTR_FANSPEED_FANSPEED] = {
+		.capability = "fanSpeed",
+		.name = "fanSpeed",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"fanSpeed\",\"attribute\":\"fanSpeed\"",
+				"\x6a" "capability" "\x68" "fanSpeed" "\x69" "attribute" "\x68" "fanSpeed"),
+	},
+	[IOT_CAPS_ATTR_FILTERSTATUS_FILTERSTATUS] = {
+		.capability = "filterStatus",
+		.name = "filterStatus",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _filterStatus_filterStatus_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"filterStatus\",\"attribute\":\"filterStatus\"",
+				"\x6a" "capability" "\x6c" "filterStatus" "\x69" "attribute" "\x6c" "filterStatus"),
+	},
+	[IOT_CAPS_ATTR_FINEDUSTHEALTHCONCERN_FINEDUSTHEALTHCONCERN] = {
+		.capability = "fineDustHealthConcern",
+		.name = "fineDustHealthConcern",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _fineDustHealthConcern_fineDustHealthConcern_values,
+		.values_num = 6,
+		_IOT_CAPS_KEY("\"capability\":\"fineDustHealthConcern\",\"attribute\":\"fineDustHealthConcern\"",
+				"\x6a" "capability" "\x75" "fineDustHealthConcern" "\x69" "attribute" "\x75" "fineDustHealthConcern"),
+	},
+	[IOT_CAPS_ATTR_FINEDUSTSENSOR_FINEDUSTLEVEL] = {
+		.capability = "fineDustSensor",
+		.name = "fineDustLevel",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.units = _fineDustSensor_fineDustLevel_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"fineDustSensor\",\"attribute\":\"fineDustLevel\"",
+				"\x6a" "capability" "\x6e" "fineDustSensor" "\x69" "attribute" "\x6d" "fineDustLevel"),
+	},
+	[IOT_CAPS_ATTR_FIRMWAREUPDATE_LASTUPDATESTATUS] = {
+		.capability = "firmwareUpdate",
+		.name = "lastUpdateStatus",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _firmwareUpdate_lastUpdateStatus_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"firmwareUpdate\",\"attribute\":\"lastUpdateStatus\"",
+				"\x6a" "capability" "\x6e" "firmwareUpdate" "\x69" "attribute" "\x70" "lastUpdateStatus"),
+	},
+	[IOT_CAPS_ATTR_FIRMWAREUPDATE_STATE] = {
+		.capability = "firmwareUpdate",
+		.name = "state",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _firmwareUpdate_state_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"firmwareUpdate\",\"attribute\":\"state\"",
+				"\x6a" "capability" "\x6e" "firmwareUpdate" "\x69" "attribute" "\x65" "state"),
+	},
+	[IOT_CAPS_ATTR_FIRMWAREUPDATE_CURRENTVERSION] = {
+		.capability = "firmwareUpdate",
+		.name = "currentVersion",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"firmwareUpdate\",\"attribute\":\"currentVersion\"",
+				"\x6a" "capability" "\x6e" "firmwareUpdate" "\x69" "attribute" "\x6e" "currentVersion"),
+	},
+	[IOT_CAPS_ATTR_FIRMWAREUPDATE_LASTUPDATETIME] = {
+		.capability = "firmwareUpdate",
+		.name = "lastUpdateTime",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"firmwareUpdate\",\"attribute\":\"lastUpdateTime\"",
+				"\x6a" "capability" "\x6e" "firmwareUpdate" "\x69" "attribute" "\x6e" "lastUpdateTime"),
+	},
+	[IOT_CAPS_ATTR_FIRMWAREUPDATE_AVAILABLEVERSION] = {
+		.capability = "firmwareUpdate",
+		.name = "availableVersion",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"firmwareUpdate\",\"attribute\":\"availableVersion\"",
+				"\x6a" "capability" "\x6e" "firmwareUpdate" "\x69" "attribute" "\x70" "availableVersion"),
+	},
+	[IOT_CAPS_ATTR_FIRMWAREUPDATE_LASTUPDATESTATUSREASON] = {
+		.capability = "firmwareUpdate",
+		.name = "lastUpdateStatusReason",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"firmwareUpdate\",\"attribute\":\"lastUpdateStatusReason\"",
+				"\x6a" "capability" "\x6e" "firmwareUpdate" "\x69" "attribute" "\x76" "lastUpdateStatusReason"),
+	},
+	[IOT_CAPS_ATTR_FORMALDEHYDEMEASUREMENT_FORMALDEHYDELEVEL] = {
+		.capability = "formaldehydeMeasurement",
+		.name = "formaldehydeLevel",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED | ATTR_SET_UNIT_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.max = 1000000,
+		.units = _formaldehydeMeasurement_formaldehydeLevel_units,
+		.units_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"formaldehydeMeasurement\",\"attribute\":\"formaldehydeLevel\"",
+				"\x6a" "capability" "\x77" "formaldehydeMeasurement" "\x69" "attribute" "\x71" "formaldehydeLevel"),
+	},
+	[IOT_CAPS_ATTR_GARAGEDOORCONTROL_DOOR] = {
+		.capability = "garageDoorControl",
+		.name = "door",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _garageDoorControl_door_values,
+		.values_num = 5,
+		_IOT_CAPS_KEY("\"capability\":\"garageDoorControl\",\"attribute\":\"door\"",
+				"\x6a" "capability" "\x71" "garageDoorControl" "\x69" "attribute" "\x64" "door"),
+	},
+	[IOT_CAPS_ATTR_GASMETER_GASMETERTIME] = {
+		.capability = "gasMeter",
+		.name = "gasMeterTime",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"gasMeter\",\"attribute\":\"gasMeterTime\"",
+				"\x6a" "capability" "\x68" "gasMeter" "\x69" "attribute" "\x6c" "gasMeterTime"),
+	},
+	[IOT_CAPS_ATTR_GASMETER_GASMETER] = {
+		.capability = "gasMeter",
+		.name = "gasMeter",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.units = _gasMeter_gasMeter_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"gasMeter\",\"attribute\":\"gasMeter\"",
+				"\x6a" "capability" "\x68" "gasMeter" "\x69" "attribute" "\x68" "gasMeter"),
+	},
+	[IOT_CAPS_ATTR_GASMETER_GASMETERCALORIFIC] = {
+		.capability = "gasMeter",
+		.name = "gasMeterCalorific",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"gasMeter\",\"attribute\":\"gasMeterCalorific\"",
+				"\x6a" "capability" "\x68" "gasMeter" "\x69" "attribute" "\x71" "gasMeterCalorific"),
+	},
+	[IOT_CAPS_ATTR_GASMETER_GASMETERVOLUME] = {
+		.capability = "gasMeter",
+		.name = "gasMeterVolume",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.units = _gasMeter_gasMeterVolume_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"gasMeter\",\"attribute\":\"gasMeterVolume\"",
+				"\x6a" "capability" "\x68" "gasMeter" "\x69" "attribute" "\x6e" "gasMeterVolume"),
+	},
+	[IOT_CAPS_ATTR_GASMETER_GASMETERPRECISION] = {
+		.capability = "gasMeter",
+		.name = "gasMeterPrecision",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_OBJECT,
+		_IOT_CAPS_KEY("\"capability\":\"gasMeter\",\"attribute\":\"gasMeterPrecision\"",
+				"\x6a" "capability" "\x68" "gasMeter" "\x69" "attribute" "\x71" "gasMeterPrecision"),
+	},
+	[IOT_CAPS_ATTR_GASMETER_GASMETERCONVERSION] = {
+		.capability = "gasMeter",
+		.name = "gasMeterConversion",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"gasMeter\",\"attribute\":\"gasMeterConversion\"",
+				"\x6a" "capability" "\x68" "gasMeter" "\x69" "attribute" "\x72" "gasMeterConversion"),
+	},
+	[IOT_CAPS_ATTR_ILLUMINANCEMEASUREMENT_ILLUMINANCE] = {
+		.capability = "illuminanceMeasurement",
+		.name = "illuminance",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.max = 100000,
+		.units = _illuminanceMeasurement_illuminance_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"illuminanceMeasurement\",\"attribute\":\"illuminance\"",
+				"\x6a" "capability" "\x76" "illuminanceMeasurement" "\x69" "attribute" "\x6b" "illuminance"),
+	},
+	[IOT_CAPS_ATTR_IMAGECAPTURE_ENCRYPTED] = {
+		.capability = "imageCapture",
+		.name = "encrypted",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_BOOLEAN,
+		_IOT_CAPS_KEY("\"capability\":\"imageCapture\",\"attribute\":\"encrypted\"",
+				"\x6a" "capability" "\x6c" "imageCapture" "\x69" "attribute" "\x69" "encrypted"),
+	},
+	[IOT_CAPS_ATTR_IMAGECAPTURE_IMAGE] = {
+		.capability = "imageCapture",
+		.name = "image",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"imageCapture\",\"attribute\":\"image\"",
+				"\x6a" "capability" "\x6c" "imageCapture" "\x69" "attribute" "\x65" "image"),
+	},
+	[IOT_CAPS_ATTR_IMAGECAPTURE_CAPTURETIME] = {
+		.capability = "imageCapture",
+		.name = "captureTime",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"imageCapture\",\"attribute\":\"captureTime\"",
+				"\x6a" "capability" "\x6c" "imageCapture" "\x69" "attribute" "\x6b" "captureTime"),
+	},
+	[IOT_CAPS_ATTR_LOCK_LOCK] = {
+		.capability = "lock",
+		.name = "lock",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _lock_lock_values,
+		.values_num = 4,
+		_IOT_CAPS_KEY("\"capability\":\"lock\",\"attribute\":\"lock\"",
+				"\x6a" "capability" "\x64" "lock" "\x69" "attribute" "\x64" "lock"),
+	},
+	[IOT_CAPS_ATTR_MEDIAINPUTSOURCE_INPUTSOURCE] = {
+		.capability = "mediaInputSource",
+		.name = "inputSource",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _mediaInputSource_inputSource_values,
+		.values_num = 18,
+		_IOT_CAPS_KEY("\"capability\":\"mediaInputSource\",\"attribute\":\"inputSource\"",
+				"\x6a" "capability" "\x70" "mediaInputSource" "\x69" "attribute" "\x6b" "inputSource"),
+	},
+	[IOT_CAPS_ATTR_MEDIAINPUTSOURCE_SUPPORTEDINPUTSOURCES] = {
+		.capability = "mediaInputSource",
+		.name = "supportedInputSources",
+		.property = ATTR_SET_VALUE_REQUIRED | ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _mediaInputSource_supportedInputSources_values,
+		.values_num = 18,
+		_IOT_CAPS_KEY("\"capability\":\"mediaInputSource\",\"attribute\":\"supportedInputSources\"",
+				"\x6a" "capability" "\x70" "mediaInputSource" "\x69" "attribute" "\x75" "supportedInputSources"),
+	},
+	[IOT_CAPS_ATTR_MEDIAPLAYBACK_SUPPORTEDPLAYBACKCOMMANDS] = {
+		.capability = "mediaPlayback",
+		.name = "supportedPlaybackCommands",
+		.property = ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _mediaPlayback_supportedPlaybackCommands_values,
+		.values_num = 5,
+		_IOT_CAPS_KEY("\"capability\":\"mediaPlayback\",\"attribute\":\"supportedPlaybackCommands\"",
+				"\x6a" "capability" "\x6d" "mediaPlayback" "\x69" "attribute" "\x78\x19" "supportedPlaybackCommands"),
+	},
+	[IOT_CAPS_ATTR_MEDIAPLAYBACK_PLAYBACKSTATUS] = {
+		.capability = "mediaPlayback",
+		.name = "playbackStatus",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _mediaPlayback_playbackStatus_values,
+		.values_num = 5,
+		_IOT_CAPS_KEY("\"capability\":\"mediaPlayback\",\"attribute\":\"playbackStatus\"",
+				"\x6a" "capability" "\x6d" "mediaPlayback" "\x69" "attribute" "\x6e" "playbackStatus"),
+	},
+	[IOT_CAPS_ATTR_MEDIAPLAYBACKREPEAT_PLAYBACKREPEATMODE] = {
+		.capability = "mediaPlaybackRepeat",
+		.name = "playbackRepeatMode",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _mediaPlaybackRepeat_playbackRepeatMode_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"mediaPlaybackRepeat\",\"attribute\":\"playbackRepeatMode\"",
+				"\x6a" "capability" "\x73" "mediaPlaybackRepeat" "\x69" "attribute" "\x72" "playbackRepeatMode"),
+	},
+	[IOT_CAPS_ATTR_MEDIAPLAYBACKSHUFFLE_PLAYBACKSHUFFLE] = {
+		.capability = "mediaPlaybackShuffle",
+		.name = "playbackShuffle",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _mediaPlaybackShuffle_playbackShuffle_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"mediaPlaybackShuffle\",\"attribute\":\"playbackShuffle\"",
+				"\x6a" "capability" "\x74" "mediaPlaybackShuffle" "\x69" "attribute" "\x6f" "playbackShuffle"),
+	},
+	[IOT_CAPS_ATTR_MODE_SUPPORTEDMODES] = {
+		.capability = "mode",
+		.name = "supportedModes",
+		.property = ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"mode\",\"attribute\":\"supportedModes\"",
+				"\x6a" "capability" "\x64" "mode" "\x69" "attribute" "\x6e" "supportedModes"),
+	},
+	[IOT_CAPS_ATTR_MODE_MODE] = {
+		.capability = "mode",
+		.name = "mode",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"mode\",\"attribute\":\"mode\"",
+				"\x6a" "capability" "\x64" "mode" "\x69" "attribute" "\x64" "mode"),
+	},
+	[IOT_CAPS_ATTR_MOLDHEALTHCONCERN_MOLDHEALTHCONCERN] = {
+		.capability = "moldHealthConcern",
+		.name = "moldHealthConcern",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _moldHealthConcern_moldHealthConcern_values,
+		.values_num = 6,
+		_IOT_CAPS_KEY("\"capability\":\"moldHealthConcern\",\"attribute\":\"moldHealthConcern\"",
+				"\x6a" "capability" "\x71" "moldHealthConcern" "\x69" "attribute" "\x71" "moldHealthConcern"),
+	},
+	[IOT_CAPS_ATTR_MOTIONSENSOR_MOTION] = {
+		.capability = "motionSensor",
+		.name = "motion",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _motionSensor_motion_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"motionSensor\",\"attribute\":\"motion\"",
+				"\x6a" "capability" "\x6c" "motionSensor" "\x69" "attribute" "\x66" "motion"),
+	},
+	[IOT_CAPS_ATTR_OBJECTDETECTION_DETECTED] = {
+		.capability = "objectDetection",
+		.name = "detected",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_OBJECT,
+		_IOT_CAPS_KEY("\"capability\":\"objectDetection\",\"attribute\":\"detected\"",
+				"\x6a" "capability" "\x6f" "objectDetection" "\x69" "attribute" "\x68" "detected"),
+	},
+	[IOT_CAPS_ATTR_OBJECTDETECTION_SUPPORTEDVALUES] = {
+		.capability = "objectDetection",
+		.name = "supportedValues",
+		.property = ATTR_SET_MAX_LENGTH | ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.max_length = 255,
+		_IOT_CAPS_KEY("\"capability\":\"objectDetection\",\"attribute\":\"supportedValues\"",
+				"\x6a" "capability" "\x6f" "objectDetection" "\x69" "attribute" "\x6f" "supportedValues"),
+	},
+	[IOT_CAPS_ATTR_ODORSENSOR_ODORLEVEL] = {
+		.capability = "odorSensor",
+		.name = "odorLevel",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"odorSensor\",\"attribute\":\"odorLevel\"",
+				"\x6a" "capability" "\x6a" "odorSensor" "\x69" "attribute" "\x69" "odorLevel"),
+	},
+	[IOT_CAPS_ATTR_OPERATINGSTATE_SUPPORTEDMACHINESTATES] = {
+		.capability = "operatingState",
+		.name = "supportedMachineStates",
+		.property = ATTR_SET_VALUE_REQUIRED | ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _operatingState_supportedMachineStates_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"operatingState\",\"attribute\":\"supportedMachineStates\"",
+				"\x6a" "capability" "\x6e" "operatingState" "\x69" "attribute" "\x76" "supportedMachineStates"),
+	},
+	[IOT_CAPS_ATTR_OPERATINGSTATE_MACHINESTATE] = {
+		.capability = "operatingState",
+		.name = "machineState",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _operatingState_machineState_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"operatingState\",\"attribute\":\"machineState\"",
+				"\x6a" "capability" "\x6e" "operatingState" "\x69" "attribute" "\x6c" "machineState"),
+	},
+	[IOT_CAPS_ATTR_OVENOPERATINGSTATE_OVENJOBSTATE] = {
+		.capability = "ovenOperatingState",
+		.name = "ovenJobState",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _ovenOperatingState_ovenJobState_values,
+		.values_num = 17,
+		_IOT_CAPS_KEY("\"capability\":\"ovenOperatingState\",\"attribute\":\"ovenJobState\"",
+				"\x6a" "capability" "\x72" "ovenOperatingState" "\x69" "attribute" "\x6c" "ovenJobState"),
+	},
+	[IOT_CAPS_ATTR_OVENOPERATINGSTATE_COMPLETIONTIME] = {
+		.capability = "ovenOperatingState",
+		.name = "completionTime",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"ovenOperatingState\",\"attribute\":\"completionTime\"",
+				"\x6a" "capability" "\x72" "ovenOperatingState" "\x69" "attribute" "\x6e" "completionTime"),
+	},
+	[IOT_CAPS_ATTR_OVENOPERATINGSTATE_SUPPORTEDMACHINESTATES] = {
+		.capability = "ovenOperatingState",
+		.name = "supportedMachineStates",
+		.property = ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _ovenOperatingState_supportedMachineStates_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"ovenOperatingState\",\"attribute\":\"supportedMachineStates\"",
+				"\x6a" "capability" "\x72" "ovenOperatingState" "\x69" "attribute" "\x76" "supportedMachineStates"),
+	},
+	[IOT_CAPS_ATTR_OVENOPERATINGSTATE_PROGRESS] = {
+		.capability = "ovenOperatingState",
+		.name = "progress",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.max = 100,
+		.units = _ovenOperatingState_progress_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"ovenOperatingState\",\"attribute\":\"progress\"",
+				"\x6a" "capability" "\x72" "ovenOperatingState" "\x69" "attribute" "\x68" "progress"),
+	},
+	[IOT_CAPS_ATTR_OVENOPERATINGSTATE_OPERATIONTIME] = {
+		.capability = "ovenOperatingState",
+		.name = "operationTime",
+		.property = ATTR_SET_VALUE_MIN,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"ovenOperatingState\",\"attribute\":\"operationTime\"",
+				"\x6a" "capability" "\x72" "ovenOperatingState" "\x69" "attribute" "\x6d" "operationTime"),
+	},
+	[IOT_CAPS_ATTR_OVENOPERATINGSTATE_MACHINESTATE] = {
+		.capability = "ovenOperatingState",
+		.name = "machineState",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _ovenOperatingState_machineState_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"ovenOperatingState\",\"attribute\":\"machineState\"",
+				"\x6a" "capability" "\x72" "ovenOperatingState" "\x69" "attribute" "\x6c" "machineState"),
+	},
+	[IOT_CAPS_ATTR_OVENSETPOINT_OVENSETPOINT] = {
+		.capability = "ovenSetpoint",
+		.name = "ovenSetpoint",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"ovenSetpoint\",\"attribute\":\"ovenSetpoint\"",
+				"\x6a" "capability" "\x6c" "ovenSetpoint" "\x69" "attribute" "\x6c" "ovenSetpoint"),
+	},
+	[IOT_CAPS_ATTR_PHMEASUREMENT_PH] = {
+		.capability = "pHMeasurement",
+		.name = "pH",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.max = 14,
+		.units = _pHMeasurement_pH_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"pHMeasurement\",\"attribute\":\"pH\"",
+				"\x6a" "capability" "\x6d" "pHMeasurement" "\x69" "attribute" "\x62" "pH"),
+	},
+	[IOT_CAPS_ATTR_PANICALARM_PANICALARM] = {
+		.capability = "panicAlarm",
+		.name = "panicAlarm",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _panicAlarm_panicAlarm_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"panicAlarm\",\"attribute\":\"panicAlarm\"",
+				"\x6a" "capability" "\x6a" "panicAlarm" "\x69" "attribute" "\x6a" "panicAlarm"),
+	},
+	[IOT_CAPS_ATTR_POWERMETER_POWER] = {
+		.capability = "powerMeter",
+		.name = "power",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.units = _powerMeter_power_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"powerMeter\",\"attribute\":\"power\"",
+				"\x6a" "capability" "\x6a" "powerMeter" "\x69" "attribute" "\x65" "power"),
+	},
+	[IOT_CAPS_ATTR_POWERSOURCE_POWERSOURCE] = {
+		.capability = "powerSource",
+		.name = "powerSource",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _powerSource_powerSource_values,
+		.values_num = 4,
+		_IOT_CAPS_KEY("\"capability\":\"powerSource\",\"attribute\":\"powerSource\"",
+				"\x6a" "capability" "\x6b" "powerSource" "\x69" "attribute" "\x6b" "powerSource"),
+	},
+	[IOT_CAPS_ATTR_PRESENCESENSOR_PRESENCE] = {
+		.capability = "presenceSensor",
+		.name = "presence",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _presenceSensor_presence_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"presenceSensor\",\"attribute\":\"presence\"",
+				"\x6a" "capability" "\x6e" "presenceSensor" "\x69" "attribute" "\x68" "presence"),
+	},
+	[IOT_CAPS_ATTR_RADONHEALTHCONCERN_RADONHEALTHCONCERN] = {
+		.capability = "radonHealthConcern",
+		.name = "radonHealthConcern",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _radonHealthConcern_radonHealthConcern_values,
+		.values_num = 6,
+		_IOT_CAPS_KEY("\"capability\":\"radonHealthConcern\",\"attribute\":\"radonHealthConcern\"",
+				"\x6a" "capability" "\x72" "radonHealthConcern" "\x69" "attribute" "\x72" "radonHealthConcern"),
+	},
+	[IOT_CAPS_ATTR_RAPIDCOOLING_RAPIDCOOLING] = {
+		.capability = "rapidCooling",
+		.name = "rapidCooling",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _rapidCooling_rapidCooling_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"rapidCooling\",\"attribute\":\"rapidCooling\"",
+				"\x6a" "capability" "\x6c" "rapidCooling" "\x69" "attribute" "\x6c" "rapidCooling"),
+	},
+	[IOT_CAPS_ATTR_RELATIVEHUMIDITYMEASUREMENT_HUMIDITY] = {
+		.capability = "relativeHumidityMeasurement",
+		.name = "humidity",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.max = 100,
+		.units = _relativeHumidityMeasurement_humidity_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"relativeHumidityMeasurement\",\"attribute\":\"humidity\"",
+				"\x6a" "capability" "\x78\x1b" "relativeHumidityMeasurement" "\x69" "attribute" "\x68" "humidity"),
+	},
+	[IOT_CAPS_ATTR_REMOTECONTROLSTATUS_REMOTECONTROLENABLED] = {
+		.capability = "remoteControlStatus",
+		.name = "remoteControlEnabled",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _remoteControlStatus_remoteControlEnabled_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"remoteControlStatus\",\"attribute\":\"remoteControlEnabled\"",
+				"\x6a" "capability" "\x73" "remoteControlStatus" "\x69" "attribute" "\x74" "remoteControlEnabled"),
+	},
+	[IOT_CAPS_ATTR_ROBOTCLEANERMOVEMENT_ROBOTCLEANERMOVEMENT] = {
+		.capability = "robotCleanerMovement",
+		.name = "robotCleanerMovement",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _robotCleanerMovement_robotCleanerMovement_values,
+		.values_num = 10,
+		_IOT_CAPS_KEY("\"capability\":\"robotCleanerMovement\",\"attribute\":\"robotCleanerMovement\"",
+				"\x6a" "capability" "\x74" "robotCleanerMovement" "\x69" "attribute" "\x74" "robotCleanerMovement"),
+	},
+	[IOT_CAPS_ATTR_ROBOTCLEANERTURBOMODE_ROBOTCLEANERTURBOMODE] = {
+		.capability = "robotCleanerTurboMode",
+		.name = "robotCleanerTurboMode",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _robotCleanerTurboMode_robotCleanerTurboMode_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"robotCleanerTurboMode\",\"attribute\":\"robotCleanerTurboMode\"",
+				"\x6a" "capability" "\x75" "robotCleanerTurboMode" "\x69" "attribute" "\x75" "robotCleanerTurboMode"),
+	},
+	[IOT_CAPS_ATTR_SAMSUNGTV_VOLUME] = {
+		.capability = "samsungTV",
+		.name = "volume",
+		.property = ATTR_SET_VALUE_MIN,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		_IOT_CAPS_KEY("\"capability\":\"samsungTV\",\"attribute\":\"volume\"",
+				"\x6a" "capability" "\x69" "samsungTV" "\x69" "attribute" "\x66" "volume"),
+	},
+	[IOT_CAPS_ATTR_SAMSUNGTV_MESSAGEBUTTON] = {
+		.capability = "samsungTV",
+		.name = "messageButton",
+		.property = 0,
+		.value_type = VALUE_TYPE_OBJECT,
+		_IOT_CAPS_KEY("\"capability\":\"samsungTV\",\"attribute\":\"messageButton\"",
+				"\x6a" "capability" "\x69" "samsungTV" "\x69" "attribute" "\x6d" "messageButton"),
+	},
+	[IOT_CAPS_ATTR_SAMSUNGTV_SWITCH] = {
+		.capability = "samsungTV",
+		.name = "switch",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _samsungTV_switch_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"samsungTV\",\"attribute\":\"switch\"",
+				"\x6a" "capability" "\x69" "samsungTV" "\x69" "attribute" "\x66" "switch"),
+	},
+	[IOT_CAPS_ATTR_SAMSUNGTV_MUTE] = {
+		.capability = "samsungTV",
+		.name = "mute",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _samsungTV_mute_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"samsungTV\",\"attribute\":\"mute\"",
+				"\x6a" "capability" "\x69" "samsungTV" "\x69" "attribute" "\x64" "mute"),
+	},
+	[IOT_CAPS_ATTR_SAMSUNGTV_PICTUREMODE] = {
+		.capability = "samsungTV",
+		.name = "pictureMode",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _samsungTV_pictureMode_values,
+		.values_num = 4,
+		_IOT_CAPS_KEY("\"capability\":\"samsungTV\",\"attribute\":\"pictureMode\"",
+				"\x6a" "capability" "\x69" "samsungTV" "\x69" "attribute" "\x6b" "pictureMode"),
+	},
+	[IOT_CAPS_ATTR_SAMSUNGTV_SOUNDMODE] = {
+		.capability = "samsungTV",
+		.name = "soundMode",
+		.property = 0,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _samsungTV_soundMode_values,
+		.values_num = 5,
+		_IOT_CAPS_KEY("\"capability\":\"samsungTV\",\"attribute\":\"soundMode\"",
+				"\x6a" "capability" "\x69" "samsungTV" "\x69" "attribute" "\x69" "soundMode"),
+	},
+	[IOT_CAPS_ATTR_SECURITYSYSTEM_ALARM] = {
+		.capability = "securitySystem",
+		.name = "alarm",
+		.property = ATTR_SET_VALUE_REQUIRED | ATTR_SET_MAX_LENGTH,
+		.value_type = VALUE_TYPE_STRING,
+		.max_length = 255,
+		_IOT_CAPS_KEY("\"capability\":\"securitySystem\",\"attribute\":\"alarm\"",
+				"\x6a" "capability" "\x6e" "securitySystem" "\x69" "attribute" "\x65" "alarm"),
+	},
+	[IOT_CAPS_ATTR_SECURITYSYSTEM_SECURITYSYSTEMSTATUS] = {
+		.capability = "securitySystem",
+		.name = "securitySystemStatus",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _securitySystem_securitySystemStatus_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"securitySystem\",\"attribute\":\"securitySystemStatus\"",
+				"\x6a" "capability" "\x6e" "securitySystem" "\x69" "attribute" "\x74" "securitySystemStatus"),
+	},
+	[IOT_CAPS_ATTR_SIGNALSTRENGTH_RSSI] = {
+		.capability = "signalStrength",
+		.name = "rssi",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = -200,
+		.max = 0,
+		.units = _signalStrength_rssi_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"signalStrength\",\"attribute\":\"rssi\"",
+				"\x6a" "capability" "\x6e" "signalStrength" "\x69" "attribute" "\x64" "rssi"),
+	},
+	[IOT_CAPS_ATTR_SIGNALSTRENGTH_LQI] = {
+		.capability = "signalStrength",
+		.name = "lqi",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.max = 255,
+		_IOT_CAPS_KEY("\"capability\":\"signalStrength\",\"attribute\":\"lqi\"",
+				"\x6a" "capability" "\x6e" "signalStrength" "\x69" "attribute" "\x63" "lqi"),
+	},
+	[IOT_CAPS_ATTR_SLEEPSENSOR_SLEEPING] = {
+		.capability = "sleepSensor",
+		.name = "sleeping",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _sleepSensor_sleeping_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"sleepSensor\",\"attribute\":\"sleeping\"",
+				"\x6a" "capability" "\x6b" "sleepSensor" "\x69" "attribute" "\x68" "sleeping"),
+	},
+	[IOT_CAPS_ATTR_SMOKEDETECTOR_SMOKE] = {
+		.capability = "smokeDetector",
+		.name = "smoke",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _smokeDetector_smoke_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"smokeDetector\",\"attribute\":\"smoke\"",
+				"\x6a" "capability" "\x6d" "smokeDetector" "\x69" "attribute" "\x65" "smoke"),
+	},
+	[IOT_CAPS_ATTR_SOUNDPRESSURELEVEL_SOUNDPRESSURELEVEL] = {
+		.capability = "soundPressureLevel",
+		.name = "soundPressureLevel",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.max = 194,
+		.units = _soundPressureLevel_soundPressureLevel_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"soundPressureLevel\",\"attribute\":\"soundPressureLevel\"",
+				"\x6a" "capability" "\x72" "soundPressureLevel" "\x69" "attribute" "\x72" "soundPressureLevel"),
+	},
+	[IOT_CAPS_ATTR_SOUNDSENSOR_SOUND] = {
+		.capability = "soundSensor",
+		.name = "sound",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _soundSensor_sound_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"soundSensor\",\"attribute\":\"sound\"",
+				"\x6a" "capability" "\x6b" "soundSensor" "\x69" "attribute" "\x65" "sound"),
+	},
+	[IOT_CAPS_ATTR_SWITCH_SWITCH] = {
+		.capability = "switch",
+		.name = "switch",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _switch_switch_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"switch\",\"attribute\":\"switch\"",
+				"\x6a" "capability" "\x66" "switch" "\x69" "attribute" "\x66" "switch"),
+	},
+	[IOT_CAPS_ATTR_SWITCHLEVEL_LEVEL] = {
+		.capability = "switchLevel",
+		.name = "level",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.max = 100,
+		.units = _switchLevel_level_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"switchLevel\",\"attribute\":\"level\"",
+				"\x6a" "capability" "\x6b" "switchLevel" "\x69" "attribute" "\x65" "level"),
+	},
+	[IOT_CAPS_ATTR_TAMPERALERT_TAMPER] = {
+		.capability = "tamperAlert",
+		.name = "tamper",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _tamperAlert_tamper_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"tamperAlert\",\"attribute\":\"tamper\"",
+				"\x6a" "capability" "\x6b" "tamperAlert" "\x69" "attribute" "\x66" "tamper"),
+	},
+	[IOT_CAPS_ATTR_TEMPERATUREALARM_TEMPERATUREALARM] = {
+		.capability = "temperatureAlarm",
+		.name = "temperatureAlarm",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _temperatureAlarm_temperatureAlarm_values,
+		.values_num = 4,
+		_IOT_CAPS_KEY("\"capability\":\"temperatureAlarm\",\"attribute\":\"temperatureAlarm\"",
+				"\x6a" "capability" "\x70" "temperatureAlarm" "\x69" "attribute" "\x70" "temperatureAlarm"),
+	},
+	[IOT_CAPS_ATTR_TEMPERATUREMEASUREMENT_TEMPERATURE] = {
+		.capability = "temperatureMeasurement",
+		.name = "temperature",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED | ATTR_SET_UNIT_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = -460,
+		.max = 10000,
+		.units = _temperatureMeasurement_temperature_units,
+		.units_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"temperatureMeasurement\",\"attribute\":\"temperature\"",
+				"\x6a" "capability" "\x76" "temperatureMeasurement" "\x69" "attribute" "\x6b" "temperature"),
+	},
+	[IOT_CAPS_ATTR_THERMOSTATCOOLINGSETPOINT_COOLINGSETPOINT] = {
+		.capability = "thermostatCoolingSetpoint",
+		.name = "coolingSetpoint",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED | ATTR_SET_UNIT_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = -460,
+		.max = 10000,
+		.units = _thermostatCoolingSetpoint_coolingSetpoint_units,
+		.units_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"thermostatCoolingSetpoint\",\"attribute\":\"coolingSetpoint\"",
+				"\x6a" "capability" "\x78\x19" "thermostatCoolingSetpoint" "\x69" "attribute" "\x6f" "coolingSetpoint"),
+	},
+	[IOT_CAPS_ATTR_THERMOSTATFANMODE_THERMOSTATFANMODE] = {
+		.capability = "thermostatFanMode",
+		.name = "thermostatFanMode",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _thermostatFanMode_thermostatFanMode_values,
+		.values_num = 4,
+		_IOT_CAPS_KEY("\"capability\":\"thermostatFanMode\",\"attribute\":\"thermostatFanMode\"",
+				"\x6a" "capability" "\x71" "thermostatFanMode" "\x69" "attribute" "\x71" "thermostatFanMode"),
+	},
+	[IOT_CAPS_ATTR_THERMOSTATFANMODE_SUPPORTEDTHERMOSTATFANMODES] = {
+		.capability = "thermostatFanMode",
+		.name = "supportedThermostatFanModes",
+		.property = ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _thermostatFanMode_supportedThermostatFanModes_values,
+		.values_num = 4,
+		_IOT_CAPS_KEY("\"capability\":\"thermostatFanMode\",\"attribute\":\"supportedThermostatFanModes\"",
+				"\x6a" "capability" "\x71" "thermostatFanMode" "\x69" "attribute" "\x78\x1b" "supportedThermostatFanModes"),
+	},
+	[IOT_CAPS_ATTR_THERMOSTATHEATINGSETPOINT_HEATINGSETPOINT] = {
+		.capability = "thermostatHeatingSetpoint",
+		.name = "heatingSetpoint",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED | ATTR_SET_UNIT_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = -460,
+		.max = 10000,
+		.units = _thermostatHeatingSetpoint_heatingSetpoint_units,
+		.units_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"thermostatHeatingSetpoint\",\"attribute\":\"heatingSetpoint\"",
+				"\x6a" "capability" "\x78\x19" "thermostatHeatingSetpoint" "\x69" "attribute" "\x6f" "heatingSetpoint"),
+	},
+	[IOT_CAPS_ATTR_THERMOSTATMODE_THERMOSTATMODE] = {
+		.capability = "thermostatMode",
+		.name = "thermostatMode",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _thermostatMode_thermostatMode_values,
+		.values_num = 37,
+		_IOT_CAPS_KEY("\"capability\":\"thermostatMode\",\"attribute\":\"thermostatMode\"",
+				"\x6a" "capability" "\x6e" "thermostatMode" "\x69" "attribute" "\x6e" "thermostatMode"),
+	},
+	[IOT_CAPS_ATTR_THERMOSTATMODE_SUPPORTEDTHERMOSTATMODES] = {
+		.capability = "thermostatMode",
+		.name = "supportedThermostatModes",
+		.property = ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _thermostatMode_supportedThermostatModes_values,
+		.values_num = 37,
+		_IOT_CAPS_KEY("\"capability\":\"thermostatMode\",\"attribute\":\"supportedThermostatModes\"",
+				"\x6a" "capability" "\x6e" "thermostatMode" "\x69" "attribute" "\x78\x18" "supportedThermostatModes"),
+	},
+	[IOT_CAPS_ATTR_THERMOSTATOPERATINGSTATE_THERMOSTATOPERATINGSTATE] = {
+		.capability = "thermostatOperatingState",
+		.name = "thermostatOperatingState",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _thermostatOperatingState_thermostatOperatingState_values,
+		.values_num = 7,
+		_IOT_CAPS_KEY("\"capability\":\"thermostatOperatingState\",\"attribute\":\"thermostatOperatingState\"",
+				"\x6a" "capability" "\x78\x18" "thermostatOperatingState" "\x69" "attribute" "\x78\x18" "thermostatOperatingState"),
+	},
+	[IOT_CAPS_ATTR_THERMOSTATSETPOINT_THERMOSTATSETPOINT] = {
+		.capability = "thermostatSetpoint",
+		.name = "thermostatSetpoint",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED | ATTR_SET_UNIT_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = -460,
+		.max = 10000,
+		.units = _thermostatSetpoint_thermostatSetpoint_units,
+		.units_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"thermostatSetpoint\",\"attribute\":\"thermostatSetpoint\"",
+				"\x6a" "capability" "\x72" "thermostatSetpoint" "\x69" "attribute" "\x72" "thermostatSetpoint"),
+	},
+	[IOT_CAPS_ATTR_THREEAXIS_THREEAXIS] = {
+		.capability = "threeAxis",
+		.name = "threeAxis",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED | ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = -10000,
+		.max = 10000,
+		.units = _threeAxis_threeAxis_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"threeAxis\",\"attribute\":\"threeAxis\"",
+				"\x6a" "capability" "\x69" "threeAxis" "\x69" "attribute" "\x69" "threeAxis"),
+	},
+	[IOT_CAPS_ATTR_TIMEDSESSION_COMPLETIONTIME] = {
+		.capability = "timedSession",
+		.name = "completionTime",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		_IOT_CAPS_KEY("\"capability\":\"timedSession\",\"attribute\":\"completionTime\"",
+				"\x6a" "capability" "\x6c" "timedSession" "\x69" "attribute" "\x6e" "completionTime"),
+	},
+	[IOT_CAPS_ATTR_TIMEDSESSION_SESSIONSTATUS] = {
+		.capability = "timedSession",
+		.name = "sessionStatus",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _timedSession_sessionStatus_values,
+		.values_num = 4,
+		_IOT_CAPS_KEY("\"capability\":\"timedSession\",\"attribute\":\"sessionStatus\"",
+				"\x6a" "capability" "\x6c" "timedSession" "\x69" "attribute" "\x6d" "sessionStatus"),
+	},
+	[IOT_CAPS_ATTR_TVOCHEALTHCONCERN_TVOCHEALTHCONCERN] = {
+		.capability = "tvocHealthConcern",
+		.name = "tvocHealthConcern",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _tvocHealthConcern_tvocHealthConcern_values,
+		.values_num = 6,
+		_IOT_CAPS_KEY("\"capability\":\"tvocHealthConcern\",\"attribute\":\"tvocHealthConcern\"",
+				"\x6a" "capability" "\x71" "tvocHealthConcern" "\x69" "attribute" "\x71" "tvocHealthConcern"),
+	},
+	[IOT_CAPS_ATTR_TVOCMEASUREMENT_TVOCLEVEL] = {
+		.capability = "tvocMeasurement",
+		.name = "tvocLevel",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED | ATTR_SET_UNIT_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.max = 1000000,
+		.units = _tvocMeasurement_tvocLevel_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"tvocMeasurement\",\"attribute\":\"tvocLevel\"",
+				"\x6a" "capability" "\x6f" "tvocMeasurement" "\x69" "attribute" "\x69" "tvocLevel"),
+	},
+	[IOT_CAPS_ATTR_ULTRAVIOLETINDEX_ULTRAVIOLETINDEX] = {
+		.capability = "ultravioletIndex",
+		.name = "ultravioletIndex",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.max = 255,
+		_IOT_CAPS_KEY("\"capability\":\"ultravioletIndex\",\"attribute\":\"ultravioletIndex\"",
+				"\x6a" "capability" "\x70" "ultravioletIndex" "\x69" "attribute" "\x70" "ultravioletIndex"),
+	},
+	[IOT_CAPS_ATTR_VALVE_VALVE] = {
+		.capability = "valve",
+		.name = "valve",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _valve_valve_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"valve\",\"attribute\":\"valve\"",
+				"\x6a" "capability" "\x65" "valve" "\x69" "attribute" "\x65" "valve"),
+	},
+	[IOT_CAPS_ATTR_VERYFINEDUSTHEALTHCONCERN_VERYFINEDUSTHEALTHCONCERN] = {
+		.capability = "veryFineDustHealthConcern",
+		.name = "veryFineDustHealthConcern",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _veryFineDustHealthConcern_veryFineDustHealthConcern_values,
+		.values_num = 6,
+		_IOT_CAPS_KEY("\"capability\":\"veryFineDustHealthConcern\",\"attribute\":\"veryFineDustHealthConcern\"",
+				"\x6a" "capability" "\x78\x19" "veryFineDustHealthConcern" "\x69" "attribute" "\x78\x19" "veryFineDustHealthConcern"),
+	},
+	[IOT_CAPS_ATTR_VERYFINEDUSTSENSOR_VERYFINEDUSTLEVEL] = {
+		.capability = "veryFineDustSensor",
+		.name = "veryFineDustLevel",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_INTEGER,
+		.min = 0,
+		.units = _veryFineDustSensor_veryFineDustLevel_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"veryFineDustSensor\",\"attribute\":\"veryFineDustLevel\"",
+				"\x6a" "capability" "\x72" "veryFineDustSensor" "\x69" "attribute" "\x71" "veryFineDustLevel"),
+	},
+	[IOT_CAPS_ATTR_VOLTAGEMEASUREMENT_VOLTAGE] = {
+		.capability = "voltageMeasurement",
+		.name = "voltage",
+		.property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_NUMBER,
+		.min = 0,
+		.units = _voltageMeasurement_voltage_units,
+		.units_num = 1,
+		_IOT_CAPS_KEY("\"capability\":\"voltageMeasurement\",\"attribute\":\"voltage\"",
+				"\x6a" "capability" "\x72" "voltageMeasurement" "\x69" "attribute" "\x67" "voltage"),
+	},
+	[IOT_CAPS_ATTR_WATERSENSOR_WATER] = {
+		.capability = "waterSensor",
+		.name = "water",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _waterSensor_water_values,
+		.values_num = 2,
+		_IOT_CAPS_KEY("\"capability\":\"waterSensor\",\"attribute\":\"water\"",
+				"\x6a" "capability" "\x6b" "waterSensor" "\x69" "attribute" "\x65" "water"),
+	},
+	[IOT_CAPS_ATTR_WINDOWSHADE_WINDOWSHADE] = {
+		.capability = "windowShade",
+		.name = "windowShade",
+		.property = ATTR_SET_VALUE_REQUIRED,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _windowShade_windowShade_values,
+		.values_num = 6,
+		_IOT_CAPS_KEY("\"capability\":\"windowShade\",\"attribute\":\"windowShade\"",
+				"\x6a" "capability" "\x6b" "windowShade" "\x69" "attribute" "\x6b" "windowShade"),
+	},
+	[IOT_CAPS_ATTR_WINDOWSHADE_SUPPORTEDWINDOWSHADECOMMANDS] = {
+		.capability = "windowShade",
+		.name = "supportedWindowShadeCommands",
+		.property = ATTR_SET_VALUE_ARRAY,
+		.value_type = VALUE_TYPE_STRING,
+		.values = _windowShade_supportedWindowShadeCommands_values,
+		.values_num = 3,
+		_IOT_CAPS_KEY("\"capability\":\"windowShade\",\"attribute\":\"supportedWindowShadeCommands\"",
+				"\x6a" "capability" "\x6b" "windowShade" "\x69" "attribute" "\x78\x1c" "supportedWindowShadeCommands"),
+	},
+};
@@ -0,0 +1,521 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_STDK_IOT_CORE_OS_SUPPORT_POSIX)
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "iot_main.h"
+#include "iot_internal.h"
+#include "iot_util.h"
+#include "iot_debug.h"
+#include "iot_executor.h"
+
+#define IOT_EXECUTOR_RUN_SIGNAL		(1 << 0)
+#define IOT_EXECUTOR_POLL_EVENTS	16
+
+enum {
+	IOT_EXECUTOR_STOPPED = 0,
+	IOT_EXECUTOR_STARTING,
+	IOT_EXECUTOR_READY,
+	IOT_EXECUTOR_FAILED,
+};
+
+struct iot_executor_watch {
+	int fd;
+	iot_executor_ready_cb cb;
+	void *arg;
+	bool removed;
+	bool woken;
+	struct iot_executor_watch *next_woken;
+	struct iot_executor_watch *next_garbage;
+};
+
+/*
+ * Contexts with pending works are put on run_queue once at a time, which is
+ * tracked by ctx->work_scheduled, so a context is run by one worker only.
+ * A worker runs a few works of the context and puts it back at the tail if
+ * more are left, so busy contexts can't starve others.
+ * ctx->work_refs is held from scheduling until the end of its run, so a
+ * detached context can be freed once it drops to zero.
+ */
+static struct {
+	int state;
+	iot_os_mutex lock;
+	iot_util_queue_t *run_queue;
+	iot_os_eventgroup *signal;
+	iot_os_thread thread[IOT_EXECUTOR_WORKERS + 1];
+	unsigned int contexts;
+	unsigned int threads;
+	unsigned int runs;
+
+	int epoll_fd;
+	int wake_fd;
+	unsigned int sockets;
+	iot_executor_watch_t *running;
+	iot_executor_watch_t *woken;
+	iot_executor_watch_t *garbage;
+} _executor;
+
+static __thread bool _executor_worker;
+
+static void _iot_executor_schedule(struct iot_context *ctx)
+{
+	int expected = 0;
+
+	if (!__atomic_compare_exchange_n(&ctx->work_scheduled, &expected, 1,
+			false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+		return;
+	}
+	__atomic_fetch_add(&ctx->work_refs, 1, __ATOMIC_SEQ_CST);
+
+	if (iot_util_queue_send(_executor.run_queue, &ctx) != IOT_ERROR_NONE) {
+		IOT_ERROR("failed to schedule context");
+		__atomic_store_n(&ctx->work_scheduled, 0, __ATOMIC_SEQ_CST);
+		__atomic_fetch_sub(&ctx->work_refs, 1, __ATOMIC_RELEASE);
+		return;
+	}
+	iot_os_eventgroup_set_bits(_executor.signal, IOT_EXECUTOR_RUN_SIGNAL);
+}
+
+static void _iot_executor_notify(void *arg)
+{
+	/* Pairs with the fence in _iot_executor_run() so no queued work is missed */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	_iot_executor_schedule((struct iot_context *)arg);
+}
+
+static void _iot_executor_run(struct iot_context *ctx)
+{
+	device_work_data_t work[DEVICE_WORK_QUEUE_BATCH];
+	size_t count, i;
+
+	count = iot_util_queue_receive_batch(ctx->work_queue, work, DEVICE_WORK_QUEUE_BATCH);
+	for (i = 0; i < count; i++) {
+		work[i].handler(ctx, work[i].param);
+	}
+
+	__atomic_store_n(&ctx->work_scheduled, 0, __ATOMIC_SEQ_CST);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (!iot_util_queue_is_empty(ctx->work_queue)) {
+		_iot_executor_schedule(ctx);
+	}
+
+	/* Last access to ctx on this run */
+	__atomic_fetch_sub(&ctx->work_refs, 1, __ATOMIC_RELEASE);
+}
+
+static void _iot_executor_worker_task(void *parm)
+{
+	struct iot_context *ctx;
+
+	_executor_worker = true;
+	for ( ; ; ) {
+		iot_os_eventgroup_wait_bits(_executor.signal,
+				IOT_EXECUTOR_RUN_SIGNAL, true, IOT_OS_WAIT_FOREVER);
+
+		while (iot_util_queue_receive(_executor.run_queue, &ctx) == IOT_ERROR_NONE) {
+			/* Wake another worker up for the rest */
+			if (!iot_util_queue_is_empty(_executor.run_queue)) {
+				iot_os_eventgroup_set_bits(_executor.signal, IOT_EXECUTOR_RUN_SIGNAL);
+			}
+			_iot_executor_run(ctx);
+			__atomic_fetch_add(&_executor.runs, 1, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+static void _iot_executor_free_garbage(void)
+{
+	iot_executor_watch_t *watch;
+
+	if ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE) {
+		return;
+	}
+	while (_executor.garbage) {
+		watch = _executor.garbage;
+		_executor.garbage = watch->next_garbage;
+		iot_os_free(watch);
+	}
+	iot_os_mutex_unlock(&_executor.lock);
+}
+
+static uint32_t _iot_executor_epoll_events(int wait)
+{
+	uint32_t events = EPOLLONESHOT;
+
+	if (wait & IOT_EXECUTOR_WAIT_READ)
+		events |= EPOLLIN;
+	if (wait & IOT_EXECUTOR_WAIT_WRITE)
+		events |= EPOLLOUT;
+
+	return events;
+}
+
+static void _iot_executor_run_watch(iot_executor_watch_t *watch)
+{
+	struct epoll_event rearm;
+	int wait;
+
+	while ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE);
+	if (watch->removed) {
+		iot_os_mutex_unlock(&_executor.lock);
+		return;
+	}
+	_executor.running = watch;
+	iot_os_mutex_unlock(&_executor.lock);
+
+	wait = watch->cb(watch->arg);
+
+	while ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE);
+	_executor.running = NULL;
+	if (wait && !watch->removed) {
+		memset(&rearm, '\0', sizeof(rearm));
+		rearm.events = _iot_executor_epoll_events(wait);
+		rearm.data.ptr = watch;
+		if (epoll_ctl(_executor.epoll_fd, EPOLL_CTL_MOD, watch->fd, &rearm) < 0) {
+			IOT_WARN("failed to rearm socket %d (%d)", watch->fd, errno);
+		}
+	}
+	iot_os_mutex_unlock(&_executor.lock);
+}
+
+static void _iot_executor_run_woken(void)
+{
+	iot_executor_watch_t *watch;
+	iot_executor_watch_t *next;
+	uint64_t count;
+
+	if (read(_executor.wake_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+		IOT_WARN("failed to read wake event (%d)", errno);
+	}
+
+	/* Wake-ups requested from now on are run on next round */
+	while ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE);
+	watch = _executor.woken;
+	_executor.woken = NULL;
+	iot_os_mutex_unlock(&_executor.lock);
+
+	while (watch) {
+		while ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE);
+		next = watch->next_woken;
+		watch->next_woken = NULL;
+		watch->woken = false;
+		iot_os_mutex_unlock(&_executor.lock);
+
+		_iot_executor_run_watch(watch);
+		watch = next;
+	}
+}
+
+static void _iot_executor_poller_task(void *parm)
+{
+	struct epoll_event events[IOT_EXECUTOR_POLL_EVENTS];
+	int n, i;
+
+	for ( ; ; ) {
+		n = epoll_wait(_executor.epoll_fd, events, IOT_EXECUTOR_POLL_EVENTS, -1);
+		if (n < 0) {
+			if (errno != EINTR) {
+				IOT_ERROR("epoll_wait error %d", errno);
+				iot_os_delay(100);
+			}
+			continue;
+		}
+
+		for (i = 0; i < n; i++) {
+			if (events[i].data.ptr == &_executor.wake_fd) {
+				_iot_executor_run_woken();
+			} else {
+				_iot_executor_run_watch((iot_executor_watch_t *)events[i].data.ptr);
+			}
+		}
+
+		/* Events of this round referred to them, so free unwatched ones only now */
+		_iot_executor_free_garbage();
+	}
+}
+
+static iot_error_t _iot_executor_start(void)
+{
+	struct epoll_event event;
+	int state = IOT_EXECUTOR_STOPPED;
+	int i;
+
+	if (!__atomic_compare_exchange_n(&_executor.state, &state, IOT_EXECUTOR_STARTING,
+			false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+		while (state == IOT_EXECUTOR_STARTING) {
+			iot_os_delay(10);
+			state = __atomic_load_n(&_executor.state, __ATOMIC_ACQUIRE);
+		}
+		return (state == IOT_EXECUTOR_READY) ? IOT_ERROR_NONE : IOT_ERROR_BAD_REQ;
+	}
+
+	if (iot_os_mutex_init(&_executor.lock) != IOT_OS_TRUE) {
+		IOT_ERROR("failed to init executor lock");
+		goto error_lock_init;
+	}
+	_executor.run_queue = iot_util_queue_create(sizeof(struct iot_context *));
+	if (!_executor.run_queue) {
+		IOT_ERROR("failed to create run queue");
+		goto error_run_queue_create;
+	}
+	_executor.signal = iot_os_eventgroup_create();
+	if (!_executor.signal) {
+		IOT_ERROR("failed to create executor signal");
+		goto error_signal_create;
+	}
+	_executor.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (_executor.epoll_fd < 0) {
+		IOT_ERROR("failed to create epoll (%d)", errno);
+		goto error_epoll_create;
+	}
+	_executor.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (_executor.wake_fd < 0) {
+		IOT_ERROR("failed to create wake event (%d)", errno);
+		goto error_wake_create;
+	}
+	memset(&event, '\0', sizeof(event));
+	event.events = EPOLLIN;
+	event.data.ptr = &_executor.wake_fd;
+	if (epoll_ctl(_executor.epoll_fd, EPOLL_CTL_ADD, _executor.wake_fd, &event) < 0) {
+		IOT_ERROR("failed to watch wake event (%d)", errno);
+		goto error_wake_watch;
+	}
+
+	if (iot_os_thread_create(_iot_executor_poller_task, IOT_EXECUTOR_POLLER_NAME,
+			IOT_TASK_STACK_SIZE, NULL, IOT_TASK_PRIORITY,
+			&_executor.thread[0]) != IOT_OS_TRUE) {
+		IOT_ERROR("failed to create poller task");
+		goto error_thread_create;
+	}
+	_executor.threads = 1;
+
+	for (i = 1; i <= IOT_EXECUTOR_WORKERS; i++) {
+		if (iot_os_thread_create(_iot_executor_worker_task, IOT_EXECUTOR_TASK_NAME,
+				IOT_TASK_STACK_SIZE, NULL, IOT_TASK_PRIORITY,
+				&_executor.thread[i]) != IOT_OS_TRUE) {
+			IOT_WARN("failed to create worker task %d", i);
+			break;
+		}
+		_executor.threads++;
+	}
+	if (_executor.threads == 1) {
+		IOT_ERROR("no worker task");
+		goto error_thread_create;
+	}
+
+	IOT_INFO("executor started with %u workers", _executor.threads - 1);
+	__atomic_store_n(&_executor.state, IOT_EXECUTOR_READY, __ATOMIC_RELEASE);
+
+	return IOT_ERROR_NONE;
+
+error_thread_create:
+	/* Poller thread, if any, just sleeps on epoll set forever */
+	if (_executor.threads != 0) {
+		goto error_epoll_create;
+	}
+error_wake_watch:
+	close(_executor.wake_fd);
+error_wake_create:
+	close(_executor.epoll_fd);
+error_epoll_create:
+	iot_os_eventgroup_delete(_executor.signal);
+error_signal_create:
+	iot_util_queue_delete(_executor.run_queue);
+error_run_queue_create:
+	iot_os_mutex_destroy(&_executor.lock);
+error_lock_init:
+	__atomic_store_n(&_executor.state, IOT_EXECUTOR_FAILED, __ATOMIC_RELEASE);
+
+	return IOT_ERROR_BAD_REQ;
+}
+
+iot_error_t iot_executor_attach(struct iot_context *ctx)
+{
+	iot_error_t err;
+
+	if (!ctx || !ctx->work_queue) {
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	err = _iot_executor_start();
+	if (err != IOT_ERROR_NONE) {
+		return err;
+	}
+
+	ctx->work_scheduled = 0;
+	ctx->work_refs = 0;
+	iot_util_queue_set_notify(ctx->work_queue, _iot_executor_notify, ctx);
+	__atomic_fetch_add(&_executor.contexts, 1, __ATOMIC_RELAXED);
+
+	/* Works queued before attach */
+	if (!iot_util_queue_is_empty(ctx->work_queue)) {
+		_iot_executor_schedule(ctx);
+	}
+
+	return IOT_ERROR_NONE;
+}
+
+void iot_executor_detach(struct iot_context *ctx)
+{
+	if (!ctx || !ctx->work_queue) {
+		return;
+	}
+
+	iot_util_queue_set_notify(ctx->work_queue, NULL, NULL);
+	while (__atomic_load_n(&ctx->work_refs, __ATOMIC_ACQUIRE) != 0) {
+		iot_os_delay(1);
+	}
+	__atomic_fetch_sub(&_executor.contexts, 1, __ATOMIC_RELAXED);
+}
+
+iot_executor_watch_t *iot_executor_watch_socket(int fd, iot_executor_ready_cb cb, void *arg)
+{
+	iot_executor_watch_t *watch;
+	struct epoll_event event;
+
+	if (fd < 0 || !cb) {
+		return NULL;
+	}
+
+	if (_iot_executor_start() != IOT_ERROR_NONE) {
+		return NULL;
+	}
+
+	watch = iot_os_malloc(sizeof(iot_executor_watch_t));
+	if (!watch) {
+		IOT_ERROR("failed to malloc watch");
+		return NULL;
+	}
+	memset(watch, '\0', sizeof(iot_executor_watch_t));
+	watch->fd = fd;
+	watch->cb = cb;
+	watch->arg = arg;
+
+	memset(&event, '\0', sizeof(event));
+	event.events = _iot_executor_epoll_events(IOT_EXECUTOR_WAIT_READ);
+	event.data.ptr = watch;
+
+	while ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE);
+	if (epoll_ctl(_executor.epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+		iot_os_mutex_unlock(&_executor.lock);
+		IOT_ERROR("failed to watch socket %d (%d)", fd, errno);
+		iot_os_free(watch);
+		return NULL;
+	}
+	_executor.sockets++;
+	iot_os_mutex_unlock(&_executor.lock);
+
+	return watch;
+}
+
+void iot_executor_wake_socket(iot_executor_watch_t *watch)
+{
+	uint64_t count = 1;
+	bool wake = false;
+
+	if (!watch) {
+		return;
+	}
+
+	while ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE);
+	if (!watch->removed && !watch->woken) {
+		watch->woken = true;
+		watch->next_woken = _executor.woken;
+		_executor.woken = watch;
+		wake = true;
+	}
+	iot_os_mutex_unlock(&_executor.lock);
+
+	if (wake && write(_executor.wake_fd, &count, sizeof(count)) < 0) {
+		IOT_WARN("failed to write wake event (%d)", errno);
+	}
+}
+
+void iot_executor_unwatch_socket(iot_executor_watch_t *watch)
+{
+	iot_executor_watch_t **link;
+
+	if (!watch) {
+		return;
+	}
+
+	while ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE);
+	if (!watch->removed) {
+		epoll_ctl(_executor.epoll_fd, EPOLL_CTL_DEL, watch->fd, NULL);
+		/* Poller may hold it on list taken already, then it's skipped as removed */
+		for (link = &_executor.woken; *link; link = &(*link)->next_woken) {
+			if (*link == watch) {
+				*link = watch->next_woken;
+				watch->next_woken = NULL;
+				break;
+			}
+		}
+		watch->removed = true;
+		watch->next_garbage = _executor.garbage;
+		_executor.garbage = watch;
+		_executor.sockets--;
+	}
+	iot_os_mutex_unlock(&_executor.lock);
+}
+
+bool iot_executor_is_running(void *arg)
+{
+	bool running;
+
+	if (__atomic_load_n(&_executor.state, __ATOMIC_ACQUIRE) != IOT_EXECUTOR_READY) {
+		return false;
+	}
+
+	while ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE);
+	running = (_executor.running && _executor.running->arg == arg);
+	iot_os_mutex_unlock(&_executor.lock);
+
+	return running;
+}
+
+bool iot_executor_is_worker(void)
+{
+	return _executor_worker;
+}
+
+void iot_executor_get_stats(iot_executor_stats_t *stats)
+{
+	if (!stats) {
+		return;
+	}
+
+	memset(stats, '\0', sizeof(iot_executor_stats_t));
+	if (__atomic_load_n(&_executor.state, __ATOMIC_ACQUIRE) != IOT_EXECUTOR_READY) {
+		return;
+	}
+
+	stats->contexts = __atomic_load_n(&_executor.contexts, __ATOMIC_RELAXED);
+	stats->threads = _executor.threads;
+	stats->runs = __atomic_load_n(&_executor.runs, __ATOMIC_RELAXED);
+	while ((iot_os_mutex_lock(&_executor.lock)) != IOT_OS_TRUE);
+	stats->sockets = _executor.sockets;
+	iot_os_mutex_unlock(&_executor.lock);
+}
+
+#endif /* CONFIG_STDK_IOT_CORE_OS_SUPPORT_POSIX */
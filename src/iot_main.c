@@ -32,6 +32,7 @@
 #include "iot_util.h"
 #include "iot_bsp_system.h"
 #include "iot_bsp_random.h"
+#include "iot_executor.h"
 
 #if defined(CONFIG_STDK_IOT_CORE_LOG_FILE)
 #include "iot_log_file.h"
@@ -48,6 +49,16 @@
 #define IOT_DUMP_MAIN_ARG2(LVL, LOGID, arg1, arg2) \
 	IOT_DUMP(IOT_DEBUG_LEVEL_##LVL, IOT_DUMP_MAIN_##LOGID, arg1, arg2)
 
+#if defined(CONFIG_STDK_IOT_CORE_GATEWAY_MODE)
+/*
+ * NV data (device id, provisioning and certificates) is kept once per
+ * process, not per context. Until it gets a namespace per context, only
+ * one st_conn_init() context may own it, otherwise every device would
+ * share one identity.
+ */
+static int gateway_nv_owned;
+#endif
+
 STATIC_FUNCTION
 iot_error_t _check_prov_data_validation(struct iot_device_prov_data *prov_data)
 {
@@ -194,11 +205,13 @@ static iot_error_t _check_prov_status(struct iot_context *ctx, bool cmd_only)
 	char *usr_id = NULL;
 	size_t str_len;
 	bool is_diff_dip;
+	bool batched;
 
 	/* Now we allow D2D process reentrant and prov_data could be loaded
 	 * at the init state or previous D2D, so free it first to avoid memory-leak
 	 */
 	iot_api_prov_data_mem_free(&ctx->prov_data);
+	batched = (iot_nv_begin() == IOT_ERROR_NONE);
 	err = iot_nv_get_prov_data(&ctx->prov_data);
 	if (err != IOT_ERROR_NONE) {
 		IOT_DEBUG("There are no prov data in NV\n");
@@ -272,6 +285,10 @@ static iot_error_t _check_prov_status(struct iot_context *ctx, bool cmd_only)
 		}
 	}
 
+	if (batched) {
+		(void)iot_nv_commit();
+	}
+
 	if (cmd_only) {
 		/* We don't need recovering for command only case */
 		if (err != IOT_ERROR_NONE) {
@@ -575,6 +592,11 @@ static iot_error_t _do_state_updating(struct iot_context *ctx, iot_state_t new_s
 
 	ctx->curr_state = new_state;
 
+	/* Events raised while offline go out before anything new */
+	if (new_state == IOT_STATE_CLOUD_CONNECTED) {
+		iot_cap_replay_offline_events(ctx);
+	}
+
 	if (ctx->status_cb) {
 		switch (new_state) {
 		case IOT_STATE_PROV_SLEEP :
@@ -909,6 +931,7 @@ static iot_error_t _do_iot_main_command(struct iot_context *ctx,
 				if (ctx->noti_cb)
 					ctx->noti_cb(noti, ctx->noti_usr_data);
 			} else if (noti->type == (iot_noti_type_t)_IOT_NOTI_TYPE_JWT_EXPIRED) {
+				iot_wt_cache_clear(&ctx->wt_cache);
 				iot_es_disconnect(ctx, IOT_CONNECT_TYPE_COMMUNICATION);
 				if (iot_es_connect(ctx, IOT_CONNECT_TYPE_COMMUNICATION) != IOT_ERROR_NONE)
                                     IOT_ERROR("failed to iot_es_connect for communication");
@@ -985,7 +1008,8 @@ static void _device_work_queue_task(void *parm)
 {
 	struct iot_context *ctx = (struct iot_context *)parm;
 	unsigned char curr_events;
-	device_work_data_t work;
+	device_work_data_t work[DEVICE_WORK_QUEUE_BATCH];
+	size_t count, i;
 
 	IOT_INFO("Enter device work queue task");
 	for( ; ;) {
@@ -997,9 +1021,12 @@ static void _device_work_queue_task(void *parm)
 			break;
 		}
 		if (curr_events & DEVICE_PENDING_WORK_SIGNAL) {
-			if (iot_util_queue_receive(ctx->work_queue,
-					&work) == IOT_ERROR_NONE) {
-				work.handler(ctx, work.param);
+			count = iot_util_queue_receive_batch(ctx->work_queue,
+					work, DEVICE_WORK_QUEUE_BATCH);
+			for (i = 0; i < count; i++) {
+				work[i].handler(ctx, work[i].param);
+			}
+			if (count == DEVICE_WORK_QUEUE_BATCH) {
 				/* Set bit again to check whether the several cmds are already
 				 * stacked up in the queue.
 				 */
@@ -1013,6 +1040,16 @@ static void _device_work_queue_task(void *parm)
 	iot_os_thread_delete(NULL);
 }
 
+static bool _iot_is_work_thread(struct iot_context *ctx, iot_os_thread thread)
+{
+#if defined(CONFIG_STDK_IOT_CORE_GATEWAY_MODE)
+	/* Works of every context run on shared workers */
+	if (iot_executor_is_worker())
+		return true;
+#endif
+	return (thread == ctx->work_queue_thread);
+}
+
 iot_error_t iot_put_device_work(struct iot_context *ctx, device_work_handler handler,
 		device_work_param param)
 {
@@ -1047,10 +1084,17 @@ IOT_CTX* st_conn_init(unsigned char *onboarding_config, unsigned int onboarding_
 		return NULL;
 	}
 
+#if defined(CONFIG_STDK_IOT_CORE_GATEWAY_MODE)
+	if (__atomic_exchange_n(&gateway_nv_owned, 1, __ATOMIC_SEQ_CST)) {
+		IOT_ERROR("NV data is shared by process, only one context is supported\n");
+		return NULL;
+	}
+#endif
+
 	ctx = iot_os_malloc(sizeof(struct iot_context));
 	if (!ctx) {
 		IOT_ERROR("failed to malloc for iot_context\n");
-		return NULL;
+		goto error_main_ctx_alloc;
 	}
 
 	/* Initialize all values */
@@ -1106,7 +1150,12 @@ IOT_CTX* st_conn_init(unsigned char *onboarding_config, unsigned int onboarding_
     }
 
 	/* create queue */
+#if defined(CONFIG_STDK_IOT_CORE_WORK_QUEUE_RING)
+	ctx->work_queue = iot_util_queue_create_ring(sizeof(device_work_data_t),
+			CONFIG_STDK_IOT_CORE_WORK_QUEUE_RING_SIZE);
+#else
 	ctx->work_queue = iot_util_queue_create(sizeof(device_work_data_t));
+#endif
 	if (!ctx->work_queue) {
 		IOT_ERROR("failed to create Queue for iot core task\n");
 		IOT_DUMP_MAIN(ERROR, BASE, IOT_QUEUE_LENGTH);
@@ -1145,6 +1194,18 @@ IOT_CTX* st_conn_init(unsigned char *onboarding_config, unsigned int onboarding_
 		goto error_main_conn_mutex_init;
 	}
 
+	if (iot_os_mutex_init(&ctx->evt_lock) != IOT_OS_TRUE) {
+		IOT_ERROR("failed to init evt_lock\n");
+		goto error_main_evt_mutex_init;
+	}
+
+#if defined(CONFIG_STDK_IOT_CORE_GATEWAY_MODE)
+	/* works run on threads shared by every context */
+	if (iot_executor_attach(ctx) != IOT_ERROR_NONE) {
+		IOT_ERROR("failed to attach to executor\n");
+		goto error_main_task_init;
+	}
+#else
 	/* create task */
 	if (iot_os_thread_create(_device_work_queue_task, IOT_TASK_NAME,
 			IOT_TASK_STACK_SIZE, (void *)ctx, IOT_TASK_PRIORITY,
@@ -1153,6 +1214,7 @@ IOT_CTX* st_conn_init(unsigned char *onboarding_config, unsigned int onboarding_
 		IOT_DUMP_MAIN(ERROR, BASE, IOT_TASK_STACK_SIZE);
 		goto error_main_task_init;
 	}
+#endif
 
 	IOT_MEM_CHECK("MAIN_INIT_ALL_DONE >>PT<<");
 
@@ -1169,6 +1231,9 @@ IOT_CTX* st_conn_init(unsigned char *onboarding_config, unsigned int onboarding_
 
 
 error_main_task_init:
+	iot_os_mutex_destroy(&ctx->evt_lock);
+
+error_main_evt_mutex_init:
 	iot_os_mutex_destroy(&ctx->st_conn_lock);
 
 error_main_conn_mutex_init:
@@ -1200,6 +1265,10 @@ error_main_log_file_init:
 error_main_bsp_init:
 	free(ctx);
 
+error_main_ctx_alloc:
+#if defined(CONFIG_STDK_IOT_CORE_GATEWAY_MODE)
+	__atomic_store_n(&gateway_nv_owned, 0, __ATOMIC_SEQ_CST);
+#endif
 	return NULL;
 }
 
@@ -1234,7 +1303,7 @@ int st_conn_start(IOT_CTX *iot_ctx, st_status_cb status_cb,
 		return IOT_ERROR_INVALID_ARGS;
 
 	if (iot_os_thread_get_current_handle(&curr_thread) == IOT_OS_TRUE) {
-		if (curr_thread == ctx->work_queue_thread) {
+		if (_iot_is_work_thread(ctx, curr_thread)) {
 			IOT_WARN("Can't support it on same thread!!");
 			IOT_DUMP_MAIN(ERROR, BASE, 0xDEADBABE);
 			return IOT_ERROR_BAD_REQ;
@@ -1317,7 +1386,7 @@ int st_conn_cleanup(IOT_CTX *iot_ctx, bool reboot)
 		return IOT_ERROR_INVALID_ARGS;
 
 	if (iot_os_thread_get_current_handle(&curr_thread) == IOT_OS_TRUE) {
-		if (curr_thread == ctx->work_queue_thread) {
+		if (_iot_is_work_thread(ctx, curr_thread)) {
 			IOT_WARN("Can't support it on same thread!!");
 			IOT_DUMP_MAIN(ERROR, BASE, 0xDEADBABE);
 			return IOT_ERROR_BAD_REQ;
@@ -1362,7 +1431,7 @@ int st_conn_start_ex(IOT_CTX *iot_ctx, iot_ext_args_t *ext_args)
 	}
 
 	if (iot_os_thread_get_current_handle(&curr_thread) == IOT_OS_TRUE) {
-		if (curr_thread == ctx->work_queue_thread) {
+		if (_iot_is_work_thread(ctx, curr_thread)) {
 			IOT_WARN("Can't support it on same thread!!");
 			IOT_DUMP_MAIN(ERROR, BASE, 0xDEADBABE);
 			return IOT_ERROR_BAD_REQ;
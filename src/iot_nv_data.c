@@ -55,6 +55,39 @@ static const char name_deviceCert[] = "deviceCert";
 static const char name_serialNumber[] = "serialNumber";
 #endif
 
+#ifndef CONFIG_STDK_IOT_CORE_NV_CACHE_MAX_LEN
+#define CONFIG_STDK_IOT_CORE_NV_CACHE_MAX_LEN	2048
+#endif
+
+#define IOT_NV_CACHE_MAX_LEN	CONFIG_STDK_IOT_CORE_NV_CACHE_MAX_LEN
+
+typedef enum iot_nv_cache_state {
+	IOT_NV_CACHE_EMPTY = 0,
+	IOT_NV_CACHE_PRESENT,
+	IOT_NV_CACHE_ABSENT,
+} iot_nv_cache_state_t;
+
+/* RAM copy of a provisioning nv, dirty one is not written to the storage yet */
+typedef struct iot_nv_cache_entry {
+	iot_nv_cache_state_t state;
+	bool dirty;
+	unsigned char *data;
+	size_t len;
+} iot_nv_cache_entry_t;
+
+/*
+ * Storage context shared by nv accesses.
+ * It is set up by the first user and torn down when the last one leaves,
+ * so accesses grouped by iot_nv_begin()/iot_nv_commit() pay one backend init.
+ * Dirty cache entries are written back just before it is torn down.
+ */
+static struct {
+	iot_os_mutex lock;
+	iot_security_context_t *security_context;
+	unsigned int refs;
+	iot_nv_cache_entry_t cache[IOT_NVD_FACTORY];
+} nv_storage;
+
 STATIC_FUNCTION
 iot_security_context_t *_iot_nv_io_storage_init(void)
 {
@@ -96,30 +129,14 @@ iot_error_t _iot_nv_io_storage_deinit(iot_security_context_t *security_context)
 }
 
 STATIC_FUNCTION
-iot_error_t _iot_nv_io_storage(const iot_nvd_t nv_id, iot_nv_io_mode_t mode, char *data, size_t data_len, size_t *read_len)
+iot_error_t _iot_nv_io_backend(iot_security_context_t *security_context, const iot_nvd_t nv_id,
+		iot_nv_io_mode_t mode, iot_security_buffer_t *data_buf)
 {
 	iot_error_t err = IOT_ERROR_NONE;
-	iot_security_context_t *security_context;
-	iot_security_buffer_t data_buf = {0};
-
-	IOT_DEBUG("id = %d, mode = %d", nv_id, mode);
-
-	if ((nv_id < 0 || nv_id >= IOT_NVD_MAX)) {
-		IOT_ERROR("nv type is invalid");
-		return IOT_ERROR_INVALID_ARGS;
-	}
-
-	if ((mode != IOT_NV_MODE_REMOVE) && (!data || (data_len == 0))) {
-		IOT_ERROR("data input is invalid");
-		return IOT_ERROR_INVALID_ARGS;
-	}
-
-	security_context = _iot_nv_io_storage_init();
-	IOT_ERROR_CHECK(security_context == NULL, IOT_ERROR_NV_DATA_ERROR, "failed to init storage");
 
 	switch (mode) {
 	case IOT_NV_MODE_READ:
-		err = iot_security_storage_read(security_context, nv_id, &data_buf);
+		err = iot_security_storage_read(security_context, nv_id, data_buf);
 		if (err != IOT_ERROR_NONE) {
 			if (err == IOT_ERROR_SECURITY_FS_NOT_FOUND) {
 				IOT_DEBUG("nv '%d' does not exist", nv_id);
@@ -128,40 +145,17 @@ iot_error_t _iot_nv_io_storage(const iot_nvd_t nv_id, iot_nv_io_mode_t mode, cha
 				IOT_ERROR("iot_security_storage_read = %d", err);
 				err = IOT_ERROR_NV_DATA_ERROR;
 			}
-			break;
-		}
-
-		if (data_len < data_buf.len) {
-			IOT_ERROR("output buffer is not enough (%d < %d)", data_len, data_buf.len);
-			err = IOT_ERROR_SECURITY_FS_BUFFER;
-			iot_os_free(data_buf.p);
-			break;
 		}
-
-		memcpy(data, data_buf.p, data_buf.len);
-		/* make null terminated string */
-		if (data_buf.len < data_len) {
-			data[data_buf.len] = '\0';
-		}
-
-		if (read_len != NULL) {
-			*read_len = data_buf.len;
-		}
-
-		iot_os_free(data_buf.p);
 		break;
 	case IOT_NV_MODE_WRITE:
-		data_buf.p = (unsigned char *)data;
-		data_buf.len = data_len;
-
-		err = iot_security_storage_write(security_context, nv_id, &data_buf);
+		err = iot_security_storage_write(security_context, nv_id, data_buf);
 		if (err != IOT_ERROR_NONE) {
 			IOT_ERROR("iot_security_storage_write = %d", err);
 			err = IOT_ERROR_NV_DATA_ERROR;
 		}
 		break;
 	case IOT_NV_MODE_REMOVE:
-                err = iot_security_storage_remove(security_context, nv_id);
+		err = iot_security_storage_remove(security_context, nv_id);
 		if (err != IOT_ERROR_NONE) {
 			if (err == IOT_ERROR_SECURITY_FS_NOT_FOUND) {
 				IOT_DEBUG("nv '%d' does not exist", nv_id);
@@ -174,7 +168,316 @@ iot_error_t _iot_nv_io_storage(const iot_nvd_t nv_id, iot_nv_io_mode_t mode, cha
 		break;
 	}
 
-	(void)_iot_nv_io_storage_deinit(security_context);
+	return err;
+}
+
+STATIC_FUNCTION
+iot_error_t _iot_nv_copy_out(char *data, size_t data_len, size_t *read_len, const unsigned char *p, size_t len)
+{
+	if (data_len < len) {
+		IOT_ERROR("output buffer is not enough (%d < %d)", data_len, len);
+		return IOT_ERROR_SECURITY_FS_BUFFER;
+	}
+
+	memcpy(data, p, len);
+	/* make null terminated string */
+	if (len < data_len) {
+		data[len] = '\0';
+	}
+
+	if (read_len != NULL) {
+		*read_len = len;
+	}
+
+	return IOT_ERROR_NONE;
+}
+
+static inline bool _iot_nv_cacheable(const iot_nvd_t nv_id)
+{
+	return (IOT_NV_CACHE_MAX_LEN > 0) && (nv_id < IOT_NVD_FACTORY) && (nv_storage.lock.sem != NULL);
+}
+
+STATIC_FUNCTION
+void _iot_nv_cache_drop(iot_nv_cache_entry_t *entry, iot_nv_cache_state_t state)
+{
+	if (entry->data) {
+		iot_os_free(entry->data);
+	}
+	entry->data = NULL;
+	entry->len = 0;
+	entry->dirty = false;
+	entry->state = state;
+}
+
+STATIC_FUNCTION
+bool _iot_nv_cache_store(iot_nv_cache_entry_t *entry, const unsigned char *p, size_t len)
+{
+	unsigned char *data;
+
+	if (len > IOT_NV_CACHE_MAX_LEN) {
+		return false;
+	}
+
+	data = iot_os_malloc(len ? len : 1);
+	if (!data) {
+		return false;
+	}
+	memcpy(data, p, len);
+
+	_iot_nv_cache_drop(entry, IOT_NV_CACHE_PRESENT);
+	entry->data = data;
+	entry->len = len;
+
+	return true;
+}
+
+/* write every dirty entry back to the storage, lock is held */
+STATIC_FUNCTION
+iot_error_t _iot_nv_cache_flush_locked(iot_security_context_t *security_context)
+{
+	iot_error_t err = IOT_ERROR_NONE;
+	iot_security_buffer_t data_buf;
+	int nv_id;
+
+	for (nv_id = 0; nv_id < IOT_NVD_FACTORY; nv_id++) {
+		iot_nv_cache_entry_t *entry = &nv_storage.cache[nv_id];
+
+		if (!entry->dirty) {
+			continue;
+		}
+
+		data_buf.p = entry->data;
+		data_buf.len = entry->len;
+		if (_iot_nv_io_backend(security_context, nv_id, IOT_NV_MODE_WRITE, &data_buf) != IOT_ERROR_NONE) {
+			IOT_ERROR("failed to write back nv '%d'", nv_id);
+			_iot_nv_cache_drop(entry, IOT_NV_CACHE_EMPTY);
+			err = IOT_ERROR_NV_DATA_ERROR;
+			continue;
+		}
+		entry->dirty = false;
+	}
+
+	return err;
+}
+
+STATIC_FUNCTION
+iot_security_context_t *_iot_nv_io_storage_ref_locked(void)
+{
+	if (nv_storage.refs == 0) {
+		nv_storage.security_context = _iot_nv_io_storage_init();
+		if (nv_storage.security_context == NULL) {
+			return NULL;
+		}
+	}
+	nv_storage.refs++;
+
+	return nv_storage.security_context;
+}
+
+STATIC_FUNCTION
+iot_error_t _iot_nv_io_storage_unref_locked(void)
+{
+	iot_error_t err = IOT_ERROR_NONE;
+
+	if (nv_storage.refs == 0) {
+		IOT_WARN("nv storage is not referenced");
+		return IOT_ERROR_NONE;
+	}
+
+	if (--nv_storage.refs == 0) {
+		err = _iot_nv_cache_flush_locked(nv_storage.security_context);
+		(void)_iot_nv_io_storage_deinit(nv_storage.security_context);
+		nv_storage.security_context = NULL;
+	}
+
+	return err;
+}
+
+/* returns storage context with lock held, nv without iot_nv_init() gets a private one */
+STATIC_FUNCTION
+iot_security_context_t *_iot_nv_io_storage_get(void)
+{
+	iot_security_context_t *security_context;
+
+	if (nv_storage.lock.sem == NULL) {
+		return _iot_nv_io_storage_init();
+	}
+
+	while ((iot_os_mutex_lock(&nv_storage.lock)) != IOT_OS_TRUE);
+	security_context = _iot_nv_io_storage_ref_locked();
+	if (security_context == NULL) {
+		iot_os_mutex_unlock(&nv_storage.lock);
+	}
+
+	return security_context;
+}
+
+STATIC_FUNCTION
+iot_error_t _iot_nv_io_storage_put(iot_security_context_t *security_context)
+{
+	iot_error_t err;
+
+	if (nv_storage.lock.sem == NULL) {
+		(void)_iot_nv_io_storage_deinit(security_context);
+		return IOT_ERROR_NONE;
+	}
+
+	err = _iot_nv_io_storage_unref_locked();
+	iot_os_mutex_unlock(&nv_storage.lock);
+
+	return err;
+}
+
+/* serves access from cache if possible, lock is held */
+STATIC_FUNCTION
+bool _iot_nv_cache_hit_locked(const iot_nvd_t nv_id, iot_nv_io_mode_t mode,
+		char *data, size_t data_len, size_t *read_len, iot_error_t *err)
+{
+	iot_nv_cache_entry_t *entry = &nv_storage.cache[nv_id];
+
+	switch (mode) {
+	case IOT_NV_MODE_READ:
+		if (entry->state == IOT_NV_CACHE_PRESENT) {
+			*err = _iot_nv_copy_out(data, data_len, read_len, entry->data, entry->len);
+			return true;
+		} else if (entry->state == IOT_NV_CACHE_ABSENT) {
+			IOT_DEBUG("nv '%d' does not exist", nv_id);
+			*err = IOT_ERROR_NV_DATA_NOT_EXIST;
+			return true;
+		}
+		break;
+	case IOT_NV_MODE_WRITE:
+		if ((entry->state == IOT_NV_CACHE_PRESENT) && (entry->len == data_len)
+				&& !memcmp(entry->data, data, data_len)) {
+			IOT_DEBUG("nv '%d' is not changed", nv_id);
+			*err = IOT_ERROR_NONE;
+			return true;
+		}
+		break;
+	case IOT_NV_MODE_REMOVE:
+		if ((entry->state == IOT_NV_CACHE_ABSENT) && !entry->dirty) {
+			IOT_DEBUG("nv '%d' does not exist", nv_id);
+			*err = IOT_ERROR_NV_DATA_NOT_EXIST;
+			return true;
+		}
+		break;
+	}
+
+	return false;
+}
+
+/* accesses storage and updates cache, lock is held */
+STATIC_FUNCTION
+iot_error_t _iot_nv_cache_io_locked(iot_security_context_t *security_context, const iot_nvd_t nv_id,
+		iot_nv_io_mode_t mode, char *data, size_t data_len, size_t *read_len)
+{
+	iot_error_t err;
+	iot_nv_cache_entry_t *entry = &nv_storage.cache[nv_id];
+	iot_security_buffer_t data_buf = {0};
+	bool was_present;
+
+	switch (mode) {
+	case IOT_NV_MODE_READ:
+		err = _iot_nv_io_backend(security_context, nv_id, mode, &data_buf);
+		if (err == IOT_ERROR_NV_DATA_NOT_EXIST) {
+			_iot_nv_cache_drop(entry, IOT_NV_CACHE_ABSENT);
+		} else if (err == IOT_ERROR_NONE) {
+			(void)_iot_nv_cache_store(entry, data_buf.p, data_buf.len);
+			err = _iot_nv_copy_out(data, data_len, read_len, data_buf.p, data_buf.len);
+			iot_os_free(data_buf.p);
+		}
+		break;
+	case IOT_NV_MODE_WRITE:
+		if (_iot_nv_cache_store(entry, (unsigned char *)data, data_len)) {
+			/* written back when the last user leaves */
+			entry->dirty = true;
+			err = IOT_ERROR_NONE;
+			break;
+		}
+
+		_iot_nv_cache_drop(entry, IOT_NV_CACHE_EMPTY);
+		data_buf.p = (unsigned char *)data;
+		data_buf.len = data_len;
+		err = _iot_nv_io_backend(security_context, nv_id, mode, &data_buf);
+		break;
+	case IOT_NV_MODE_REMOVE:
+		was_present = (entry->state == IOT_NV_CACHE_PRESENT);
+		err = _iot_nv_io_backend(security_context, nv_id, mode, &data_buf);
+		if (err == IOT_ERROR_NV_DATA_NOT_EXIST && was_present) {
+			/* it was only in cache */
+			err = IOT_ERROR_NONE;
+		}
+
+		if (err == IOT_ERROR_NONE || err == IOT_ERROR_NV_DATA_NOT_EXIST) {
+			_iot_nv_cache_drop(entry, IOT_NV_CACHE_ABSENT);
+		} else {
+			_iot_nv_cache_drop(entry, IOT_NV_CACHE_EMPTY);
+		}
+		break;
+	default:
+		err = IOT_ERROR_INVALID_ARGS;
+		break;
+	}
+
+	return err;
+}
+
+STATIC_FUNCTION
+iot_error_t _iot_nv_io_storage(const iot_nvd_t nv_id, iot_nv_io_mode_t mode, char *data, size_t data_len, size_t *read_len)
+{
+	iot_error_t err = IOT_ERROR_NONE;
+	iot_error_t put_err;
+	iot_security_context_t *security_context;
+	iot_security_buffer_t data_buf = {0};
+	bool cacheable;
+
+	IOT_DEBUG("id = %d, mode = %d", nv_id, mode);
+
+	if ((nv_id < 0 || nv_id >= IOT_NVD_MAX)) {
+		IOT_ERROR("nv type is invalid");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	if ((mode != IOT_NV_MODE_REMOVE) && (!data || (data_len == 0))) {
+		IOT_ERROR("data input is invalid");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	cacheable = _iot_nv_cacheable(nv_id);
+	if (cacheable) {
+		while ((iot_os_mutex_lock(&nv_storage.lock)) != IOT_OS_TRUE);
+		if (_iot_nv_cache_hit_locked(nv_id, mode, data, data_len, read_len, &err)) {
+			iot_os_mutex_unlock(&nv_storage.lock);
+			return err;
+		}
+		security_context = _iot_nv_io_storage_ref_locked();
+		if (security_context == NULL) {
+			iot_os_mutex_unlock(&nv_storage.lock);
+		}
+	} else {
+		security_context = _iot_nv_io_storage_get();
+	}
+	IOT_ERROR_CHECK(security_context == NULL, IOT_ERROR_NV_DATA_ERROR, "failed to init storage");
+
+	if (cacheable) {
+		err = _iot_nv_cache_io_locked(security_context, nv_id, mode, data, data_len, read_len);
+	} else if (mode == IOT_NV_MODE_READ) {
+		err = _iot_nv_io_backend(security_context, nv_id, mode, &data_buf);
+		if (err == IOT_ERROR_NONE) {
+			err = _iot_nv_copy_out(data, data_len, read_len, data_buf.p, data_buf.len);
+			iot_os_free(data_buf.p);
+		}
+	} else {
+		data_buf.p = (unsigned char *)data;
+		data_buf.len = data_len;
+		err = _iot_nv_io_backend(security_context, nv_id, mode, &data_buf);
+	}
+
+	/* dirty data is written back here unless a batch is still open */
+	put_err = _iot_nv_io_storage_put(security_context);
+	if (err == IOT_ERROR_NONE && put_err != IOT_ERROR_NONE) {
+		err = put_err;
+	}
 
 	return err;
 }
@@ -200,6 +503,13 @@ iot_error_t iot_nv_init(unsigned char *device_info, size_t device_info_len)
 	iot_error_t ret = iot_bsp_fs_init();
 	IOT_DEBUG_CHECK(ret != IOT_ERROR_NONE, IOT_ERROR_INIT_FAIL, "NV init fail");
 
+	if (nv_storage.lock.sem == NULL) {
+		if (iot_os_mutex_init(&nv_storage.lock) != IOT_OS_TRUE) {
+			IOT_ERROR("failed to init nv storage lock");
+			return IOT_ERROR_INIT_FAIL;
+		}
+	}
+
 #if !defined(CONFIG_STDK_IOT_CORE_SUPPORT_STNV_PARTITION)
 	unsigned char* data = NULL;
 
@@ -221,6 +531,23 @@ iot_error_t iot_nv_init(unsigned char *device_info, size_t device_info_len)
 iot_error_t iot_nv_deinit()
 {
 	HIT();
+	int nv_id;
+
+	if (nv_storage.lock.sem) {
+		if (nv_storage.refs) {
+			IOT_WARN("nv storage is still referenced(%u)", nv_storage.refs);
+			(void)_iot_nv_cache_flush_locked(nv_storage.security_context);
+			(void)_iot_nv_io_storage_deinit(nv_storage.security_context);
+			nv_storage.security_context = NULL;
+			nv_storage.refs = 0;
+		}
+		for (nv_id = 0; nv_id < IOT_NVD_FACTORY; nv_id++) {
+			_iot_nv_cache_drop(&nv_storage.cache[nv_id], IOT_NV_CACHE_EMPTY);
+		}
+		iot_os_mutex_destroy(&nv_storage.lock);
+		nv_storage.lock.sem = NULL;
+	}
+
 	iot_error_t ret = iot_bsp_fs_deinit();
 	IOT_DEBUG_CHECK(ret != IOT_ERROR_NONE, IOT_ERROR_DEINIT_FAIL, "NV deinit fail");
 
@@ -234,6 +561,43 @@ iot_error_t iot_nv_deinit()
 	return IOT_ERROR_NONE;
 }
 
+iot_error_t iot_nv_begin(void)
+{
+	iot_security_context_t *security_context;
+
+	if (nv_storage.lock.sem == NULL) {
+		IOT_WARN("nv is not initialized");
+		return IOT_ERROR_NV_DATA_ERROR;
+	}
+
+	while ((iot_os_mutex_lock(&nv_storage.lock)) != IOT_OS_TRUE);
+	security_context = _iot_nv_io_storage_ref_locked();
+	iot_os_mutex_unlock(&nv_storage.lock);
+
+	if (security_context == NULL) {
+		IOT_ERROR("failed to init storage");
+		return IOT_ERROR_NV_DATA_ERROR;
+	}
+
+	return IOT_ERROR_NONE;
+}
+
+iot_error_t iot_nv_commit(void)
+{
+	if (nv_storage.lock.sem == NULL) {
+		IOT_WARN("nv is not initialized");
+		return IOT_ERROR_NV_DATA_ERROR;
+	}
+
+	iot_error_t err;
+
+	while ((iot_os_mutex_lock(&nv_storage.lock)) != IOT_OS_TRUE);
+	err = _iot_nv_io_storage_unref_locked();
+	iot_os_mutex_unlock(&nv_storage.lock);
+
+	return err;
+}
+
 bool iot_nv_prov_data_exist(void)
 {
 	iot_error_t ret;
@@ -278,14 +642,25 @@ iot_error_t iot_nv_get_prov_data(struct iot_device_prov_data* prov_data)
 	IOT_WARN_CHECK(prov_data == NULL, IOT_ERROR_INVALID_ARGS, "Invalid args 'NULL'");
 
 	iot_error_t ret;
+	bool batched;
+
+	batched = (iot_nv_begin() == IOT_ERROR_NONE);
 
 	ret = iot_nv_get_wifi_prov_data(&prov_data->wifi);
-	IOT_DEBUG_CHECK(ret != IOT_ERROR_NONE, IOT_ERROR_NV_DATA_ERROR, "get wifi prov fail");
+	if (ret == IOT_ERROR_NONE) {
+		ret = iot_nv_get_cloud_prov_data(&prov_data->cloud);
+		if (ret != IOT_ERROR_NONE) {
+			IOT_DEBUG("get cloud prov fail");
+		}
+	} else {
+		IOT_DEBUG("get wifi prov fail");
+	}
 
-	ret = iot_nv_get_cloud_prov_data(&prov_data->cloud);
-	IOT_DEBUG_CHECK(ret != IOT_ERROR_NONE, IOT_ERROR_NV_DATA_ERROR, "get cloud prov fail");
+	if (batched) {
+		(void)iot_nv_commit();
+	}
 
-	return IOT_ERROR_NONE;
+	return (ret == IOT_ERROR_NONE) ? IOT_ERROR_NONE : IOT_ERROR_NV_DATA_ERROR;
 }
 
 iot_error_t iot_nv_set_prov_data(struct iot_device_prov_data* prov_data)
@@ -294,14 +669,26 @@ iot_error_t iot_nv_set_prov_data(struct iot_device_prov_data* prov_data)
 	IOT_WARN_CHECK(prov_data == NULL, IOT_ERROR_INVALID_ARGS, "Invalid args 'NULL'");
 
 	iot_error_t ret;
+	bool batched;
+
+	batched = (iot_nv_begin() == IOT_ERROR_NONE);
 
 	ret = iot_nv_set_wifi_prov_data(&prov_data->wifi);
-	IOT_DEBUG_CHECK(ret != IOT_ERROR_NONE, IOT_ERROR_NV_DATA_ERROR, "set wifi prov fail");
+	if (ret == IOT_ERROR_NONE) {
+		ret = iot_nv_set_cloud_prov_data(&prov_data->cloud);
+		if (ret != IOT_ERROR_NONE) {
+			IOT_DEBUG("set cloud prov fail");
+		}
+	} else {
+		IOT_DEBUG("set wifi prov fail");
+	}
 
-	ret = iot_nv_set_cloud_prov_data(&prov_data->cloud);
-	IOT_DEBUG_CHECK(ret != IOT_ERROR_NONE, IOT_ERROR_NV_DATA_ERROR, "set cloud prov fail");
+	if (batched && (iot_nv_commit() != IOT_ERROR_NONE)) {
+		IOT_ERROR("failed to commit nv");
+		ret = IOT_ERROR_NV_DATA_ERROR;
+	}
 
-	return IOT_ERROR_NONE;
+	return (ret == IOT_ERROR_NONE) ? IOT_ERROR_NONE : IOT_ERROR_NV_DATA_ERROR;
 }
 
 iot_error_t iot_nv_erase_prov_data()
@@ -349,10 +736,13 @@ iot_error_t iot_nv_get_wifi_prov_data(struct iot_wifi_prov_data* wifi_prov)
 	const int DATA_SIZE = IOT_WIFI_PROV_PASSWORD_STR_LEN + 1;
 	unsigned int size;
 	char* data = NULL;
+	bool batched;
 
 	data = malloc(sizeof(char) * DATA_SIZE);
 	IOT_WARN_CHECK(data == NULL, IOT_ERROR_NV_DATA_ERROR, "memory alloc fail");
 
+	batched = (iot_nv_begin() == IOT_ERROR_NONE);
+
 	/* CHECK IOT_NVD_WIFI_PROV_STATUS */
 	ret = _iot_nv_read_data(IOT_NVD_WIFI_PROV_STATUS, data, DATA_SIZE, NULL);
 	if (ret != IOT_ERROR_NONE) {
@@ -467,6 +857,9 @@ iot_error_t iot_nv_get_wifi_prov_data(struct iot_wifi_prov_data* wifi_prov)
 
 exit:
 	free(data);
+	if (batched) {
+		(void)iot_nv_commit();
+	}
 	if (ret) {
 		memset(wifi_prov, 0, sizeof(struct iot_wifi_prov_data));
 	}
@@ -491,10 +884,13 @@ iot_error_t iot_nv_set_wifi_prov_data(struct iot_wifi_prov_data* wifi_prov)
 	unsigned int size;
 	int state;
 	char* data = NULL;
+	bool batched;
 
 	data = malloc(sizeof(char) * DATA_SIZE);
 	IOT_WARN_CHECK(data == NULL, IOT_ERROR_NV_DATA_ERROR, "memory alloc fail");
 
+	batched = (iot_nv_begin() == IOT_ERROR_NONE);
+
 	/* IOT_NVD_WIFI_PROV_STATUS - NONE */
 	size = 4;
 	memcpy(data, "NONE", size);
@@ -597,6 +993,10 @@ iot_error_t iot_nv_set_wifi_prov_data(struct iot_wifi_prov_data* wifi_prov)
 
 exit:
 	free(data);
+	if (batched && (iot_nv_commit() != IOT_ERROR_NONE)) {
+		IOT_ERROR("failed to commit nv");
+		ret = IOT_ERROR_NV_DATA_ERROR;
+	}
 
 	return ret;
 }
@@ -618,11 +1018,14 @@ iot_error_t iot_nv_get_cloud_prov_data(struct iot_cloud_prov_data* cloud_prov)
 	const int DATA_SIZE = (IOT_NVD_MAX_DATA_LEN / 2) + 1;
 	unsigned int size;
 	char* data = NULL;
+	bool batched;
 	char* new_buff = NULL;
 
 	data = iot_os_malloc(sizeof(char) * DATA_SIZE);
 	IOT_WARN_CHECK(data == NULL, IOT_ERROR_NV_DATA_ERROR, "memory alloc fail");
 
+	batched = (iot_nv_begin() == IOT_ERROR_NONE);
+
 	/* CHECK IOT_NVD_CLOUD_PROV_STATUS */
 	ret = _iot_nv_read_data(IOT_NVD_CLOUD_PROV_STATUS, data, DATA_SIZE, NULL);
 	if (ret != IOT_ERROR_NONE) {
@@ -706,6 +1109,9 @@ iot_error_t iot_nv_get_cloud_prov_data(struct iot_cloud_prov_data* cloud_prov)
 
 exit:
 	iot_os_free(data);
+	if (batched) {
+		(void)iot_nv_commit();
+	}
 
 	return ret;
 }
@@ -728,10 +1134,13 @@ iot_error_t iot_nv_set_cloud_prov_data(struct iot_cloud_prov_data* cloud_prov)
 	size_t size;
 	int state;
 	char* data = NULL;
+	bool batched;
 
 	data = malloc(sizeof(char) * DATA_SIZE);
 	IOT_WARN_CHECK(data == NULL, IOT_ERROR_NV_DATA_ERROR, "memory alloc fail");
 
+	batched = (iot_nv_begin() == IOT_ERROR_NONE);
+
 	/* IOT_NVD_CLOUD_PROV_STATUS - NONE */
 	size = 4;
 	memcpy(data, "NONE", size);
@@ -808,6 +1217,10 @@ iot_error_t iot_nv_set_cloud_prov_data(struct iot_cloud_prov_data* cloud_prov)
 
 exit:
 	free(data);
+	if (batched && (iot_nv_commit() != IOT_ERROR_NONE)) {
+		IOT_ERROR("failed to commit nv");
+		ret = IOT_ERROR_NV_DATA_ERROR;
+	}
 
 	return ret;
 }
@@ -821,7 +1234,7 @@ iot_error_t iot_nv_get_certificate(iot_security_cert_id_t cert_id, char** cert,
 	HIT();
 	IOT_WARN_CHECK((cert == NULL || len == NULL), IOT_ERROR_INVALID_ARGS, "Invalid args 'NULL'");
 
-	security_context = _iot_nv_io_storage_init();
+	security_context = _iot_nv_io_storage_get();
 	if (security_context == NULL) {
 		IOT_ERROR("failed to init storage");
 		return IOT_ERROR_NV_DATA_ERROR;
@@ -830,10 +1243,15 @@ iot_error_t iot_nv_get_certificate(iot_security_cert_id_t cert_id, char** cert,
 	ret = iot_security_manager_init(security_context);
 	if (ret != IOT_ERROR_NONE) {
 		IOT_ERROR("failed to init manager");
+		_iot_nv_io_storage_put(security_context);
 		return IOT_ERROR_NV_DATA_ERROR;
 	}
 
 	ret = iot_security_manager_get_certificate(security_context, cert_id, &cert_buf);
+
+	(void)iot_security_manager_deinit(security_context);
+	_iot_nv_io_storage_put(security_context);
+
 	if (ret != IOT_ERROR_NONE) {
 		IOT_ERROR("failed to get cert(%d), ret = %d", cert_id, ret);
 		return IOT_ERROR_NV_DATA_ERROR;
@@ -842,9 +1260,6 @@ iot_error_t iot_nv_get_certificate(iot_security_cert_id_t cert_id, char** cert,
 	*cert = (char *)cert_buf.p;
 	*len = cert_buf.len;
 
-	(void)iot_security_manager_deinit(security_context);
-	(void)_iot_nv_io_storage_deinit(security_context);
-
 	return IOT_ERROR_NONE;
 }
 
@@ -33,6 +33,17 @@
 
 static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, size_t *olen);
 
+/* Output position c can run past len while measuring, nothing is written there */
+static inline char *_iot_json_at(char *out, size_t len, int c)
+{
+	return (out && (size_t)c < len) ? out + c : NULL;
+}
+
+static inline size_t _iot_json_left(size_t len, int c)
+{
+	return ((size_t)c < len) ? len - c : 0;
+}
+
 static CborError _iot_cbor_array_to_json(CborValue *it, char *out, size_t len, size_t *olen)
 {
 	CborError err;
@@ -42,12 +53,14 @@ static CborError _iot_cbor_array_to_json(CborValue *it, char *out, size_t len, s
 
 	while (!cbor_value_at_end(it)) {
 		if (comma) {
-			out[c++] = comma;
+			if (_iot_json_at(out, len, c))
+				out[c] = comma;
+			c++;
 		} else {
 			comma = ',';
 		}
 
-		err = _iot_cbor_value_to_json(it, out + c, len - c, &n);
+		err = _iot_cbor_value_to_json(it, _iot_json_at(out, len, c), _iot_json_left(len, c), &n);
 		if (err) {
 			return err;
 		}
@@ -72,7 +85,9 @@ static CborError _iot_cbor_map_to_json(CborValue *it, char *out, size_t len, siz
 
 	while (!cbor_value_at_end(it)) {
 		if (comma) {
-			out[c++] = comma;
+			if (_iot_json_at(out, len, c))
+				out[c] = comma;
+			c++;
 		} else {
 			comma = ',';
 		}
@@ -88,14 +103,14 @@ static CborError _iot_cbor_map_to_json(CborValue *it, char *out, size_t len, siz
 			return err;
 		}
 
-		sret = snprintf(out + c, len - c, "\"%s\":", key);
+		sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "\"%s\":", key);
 		free(key);
 		if (sret < 0)
 			return CborErrorInvalidUtf8TextString;
 		c += sret;
 
 		/* value */
-		err = _iot_cbor_value_to_json(it, out + c, len - c, &n);
+		err = _iot_cbor_value_to_json(it, _iot_json_at(out, len, c), _iot_json_left(len, c), &n);
 		c += (int)n;
 
 		if (err) {
@@ -135,12 +150,12 @@ static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, s
 			return err;
 		}
 
-		c += snprintf(out + c, len - c, "%c", type == CborArrayType ? '[' : '{');
+		c += snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%c", type == CborArrayType ? '[' : '{');
 
 		if (type == CborArrayType)
-			err = _iot_cbor_array_to_json(&recursed, out + c, len - c, &n);
+			err = _iot_cbor_array_to_json(&recursed, _iot_json_at(out, len, c), _iot_json_left(len, c), &n);
 		else
-			err = _iot_cbor_map_to_json(&recursed, out + c, len - c, &n);
+			err = _iot_cbor_map_to_json(&recursed, _iot_json_at(out, len, c), _iot_json_left(len, c), &n);
 
 		if (err) {
 			it->ptr = recursed.ptr;
@@ -149,7 +164,7 @@ static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, s
 
 		c += (int)n;
 
-		c += snprintf(out + c, len - c, "%c", type == CborArrayType ? ']' : '}');
+		c += snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%c", type == CborArrayType ? ']' : '}');
 
 		err = cbor_value_leave_container(it, &recursed);
 		if (err) {
@@ -166,7 +181,7 @@ static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, s
 			return err;
 		}
 
-		sret = snprintf(out + c, len - c, "\"%s\"", str);
+		sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "\"%s\"", str);
 		free(str);
 		if (sret < 0)
 			return CborErrorInvalidUtf8TextString;
@@ -184,14 +199,22 @@ static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, s
 			val_dbl = -val_dbl - 1;
 		}
 
-		sret = snprintf(out + c, len - c, "%d", (int)val_dbl);
+		sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%d", (int)val_dbl);
 		if (sret < 0)
 			return CborErrorInvalidUtf8TextString;
 		c += sret;
 
 		break;
+	case CborFloatType:
 	case CborDoubleType:
-		cbor_value_get_double(it, &val_dbl);
+		if (type == CborFloatType) {
+			float val_flt;
+
+			cbor_value_get_float(it, &val_flt);
+			val_dbl = val_flt;
+		} else {
+			cbor_value_get_double(it, &val_dbl);
+		}
 
 		if (fpclassify(val_dbl) < 0) {
 			return CborErrorIO;
@@ -200,26 +223,26 @@ static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, s
 		val_i64 = (uint64_t)fabs(val_dbl);
 		if ((double)val_i64 == fabs(val_dbl)) {
 			/* print as integer so we get the full precision */
-			sret = snprintf(out + c, len - c, "%s%" PRIu64, val_dbl < 0 ? "-" : "", val_i64);
+			sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%s%" PRIu64, val_dbl < 0 ? "-" : "", val_i64);
 			if (sret < 0)
 				return CborErrorInvalidUtf8TextString;
 			c += sret;
 		} else {
 			/* this number is definitely not a 64-bit integer */
-			sret = snprintf(out + c, len - c, "%." DBL_DECIMAL_DIG_STR "g", val_dbl);
+			sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%." DBL_DECIMAL_DIG_STR "g", val_dbl);
 			if (sret < 0)
 				return CborErrorInvalidUtf8TextString;
 			c += sret;
 		}
 #else
 		fracpart = modf(val_dbl, &intpart);
-		sret = snprintf(out + c, len - c, "%d", (int)intpart);
+		sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%d", (int)intpart);
 		if (sret < 0)
 			return CborErrorInvalidUtf8TextString;
 		c += sret;
 
 		if (fracpart != 0) {
-			c += snprintf(out + c, len - c, ".");
+			c += snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), ".");
 
 			fracpart = round(fracpart * IOT_SERIALIZE_DECIMAL_PRECISION) / IOT_SERIALIZE_DECIMAL_PRECISION;
 			if (fracpart < 0) {
@@ -227,7 +250,7 @@ static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, s
 			}
 			while(fracpart != (int)fracpart) {
 				fracpart *= 10;
-				sret = snprintf(out + c, len - c, "%d", ((int)fracpart) % 10);
+				sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%d", ((int)fracpart) % 10);
 				if (sret < 0)
 					return CborErrorInvalidUtf8TextString;
 				c += sret;
@@ -279,20 +302,20 @@ static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, s
 						/* mantissa is negative */
 						if (man_sign)
 						{
-							c += snprintf(out + c, len - c, "-");
+							c += snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "-");
 						}
 
-						sret = snprintf(out + c, len - c, "%u", (uint32_t)(man/exp));
+						sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%u", (uint32_t)(man/exp));
 						if (sret < 0)
 							return CborErrorInvalidUtf8TextString;
 						c += sret;
 
-						c += snprintf(out + c, len - c, ".");
+						c += snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), ".");
 						if (exp > IOT_SERIALIZE_DECIMAL_PRECISION)
-							sret = snprintf(out + c, len - c, "%u",
+							sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%u",
 									(uint32_t)((man%exp)/(exp/IOT_SERIALIZE_DECIMAL_PRECISION)));
 						else
-							sret = snprintf(out + c, len - c, "%u", (uint32_t)(man%exp));
+							sret = snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%u", (uint32_t)(man%exp));
 
 						if (sret < 0)
 							return CborErrorInvalidUtf8TextString;
@@ -316,13 +339,17 @@ static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, s
 
 		if (val_bool)
 		{
-			c += snprintf(out + c, len -c, "%s", "true");
+			c += snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%s", "true");
 		}
 		else
 		{
-			c += snprintf(out + c, len -c, "%s", "false");
+			c += snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%s", "false");
 		}
 
+		break;
+	case CborNullType:
+		c += snprintf(_iot_json_at(out, len, c), _iot_json_left(len, c), "%s", "null");
+
 		break;
 	default:
 		return CborErrorUnknownType;
@@ -333,63 +360,73 @@ static CborError _iot_cbor_value_to_json(CborValue *it, char *out, size_t len, s
 	return cbor_value_advance_fixed(it);
 }
 
-iot_error_t iot_serialize_cbor2json(uint8_t *cbor, size_t cborlen, char **json, size_t *jsonlen)
+iot_error_t iot_serialize_cbor_value_to_json(CborValue *value, char **json, size_t *jsonlen)
 {
-	CborParser parser;
-	CborValue it;
+	CborValue measure;
 	CborError err;
 	char *buf;
-	char *tmp;
-	size_t len;
+	size_t len = 0;
 	size_t olen = 0;
 
-	if ((cbor == NULL) || (cborlen == 0) ||
-	    (json == NULL) || (jsonlen == NULL)) {
-		IOT_ERROR("invalid cbor");
+	if ((value == NULL) || (json == NULL) || (jsonlen == NULL)) {
+		IOT_ERROR("invalid args");
 		return IOT_ERROR_INVALID_ARGS;
 	}
 
-	IOT_DEBUG("cbor 0x%x@%p", (int)cborlen, cbor);
-
-	err = cbor_parser_init(cbor, cborlen, 0, &parser, &it);
+	/* The first pass only counts, so that json is allocated once in exact size */
+	measure = *value;
+	err = _iot_cbor_value_to_json(&measure, NULL, 0, &len);
 	if (err) {
-		IOT_ERROR("cbor_parser_init = %d", err);
-		return IOT_ERROR_CBOR_PARSE;
+		IOT_ERROR("_iot_cbor_value_to_json = %d", err);
+		return IOT_ERROR_CBOR_TO_JSON;
 	}
 
-	len = cborlen * 2;
-	buf = (char *)malloc(len);
+	buf = (char *)malloc(len + 1);
 	if (!buf) {
 		IOT_ERROR("malloc failed for json");
 		return IOT_ERROR_MEM_ALLOC;
 	}
+	buf[0] = '\0';
 
-	memset(buf, 0, len);
-
-	err = _iot_cbor_value_to_json(&it, buf, len, &olen);
-	if (err) {
-		IOT_ERROR("_iot_cbor_value_to_json_advance = %d", err);
+	err = _iot_cbor_value_to_json(value, buf, len + 1, &olen);
+	if (err || (olen != len)) {
+		IOT_ERROR("_iot_cbor_value_to_json = %d (%d/%d)", err, (int)olen, (int)len);
 		free(buf);
 		return IOT_ERROR_CBOR_TO_JSON;
 	}
 
-	if (olen < len) {
-		tmp = (char *)realloc(buf, olen + 1);
-		if (!tmp) {
-			IOT_WARN("realloc failed for json, use origin");
-		} else {
-			buf = tmp;
-		}
-	} else {
-		IOT_ERROR("allocated size is not enough (%d < %d)",
-				(int)len, (int)olen);
-		free(buf);
-		return IOT_ERROR_MEM_ALLOC;
-	}
-
 	*json = buf;
 	*jsonlen = olen;
 
+	return IOT_ERROR_NONE;
+}
+
+iot_error_t iot_serialize_cbor2json(uint8_t *cbor, size_t cborlen, char **json, size_t *jsonlen)
+{
+	CborParser parser;
+	CborValue it;
+	CborError err;
+	iot_error_t iot_err;
+
+	if ((cbor == NULL) || (cborlen == 0) ||
+	    (json == NULL) || (jsonlen == NULL)) {
+		IOT_ERROR("invalid cbor");
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	IOT_DEBUG("cbor 0x%x@%p", (int)cborlen, cbor);
+
+	err = cbor_parser_init(cbor, cborlen, 0, &parser, &it);
+	if (err) {
+		IOT_ERROR("cbor_parser_init = %d", err);
+		return IOT_ERROR_CBOR_PARSE;
+	}
+
+	iot_err = iot_serialize_cbor_value_to_json(&it, json, jsonlen);
+	if (iot_err != IOT_ERROR_NONE) {
+		return iot_err;
+	}
+
 	IOT_DEBUG("json 0x%x@%p", (int)*jsonlen, *json);
 
 	return IOT_ERROR_NONE;
@@ -402,7 +439,7 @@ static CborError _iot_json_value_to_cbor(JSON_H *json, CborEncoder *cbor)
 	if (JSON_IS_OBJECT(json)) {
 		CborEncoder d = {0};
 		char *string;
-		cbor_encoder_create_map(cbor, &d, CborIndefiniteLength);
+		cbor_encoder_create_map(cbor, &d, JSON_GET_ARRAY_SIZE(json));
 		JSON_H *child = JSON_GET_CHILD_ITEM(json);
 		while (child) {
 			string = JSON_GET_OBJECT_ITEM_STRING(child);
@@ -427,7 +464,7 @@ static CborError _iot_json_value_to_cbor(JSON_H *json, CborEncoder *cbor)
 		}
 	} else if (JSON_IS_ARRAY(json)) {
 		CborEncoder d = {0};
-		cbor_encoder_create_array(cbor, &d, CborIndefiniteLength);
+		cbor_encoder_create_array(cbor, &d, JSON_GET_ARRAY_SIZE(json));
 		JSON_H *child = JSON_GET_CHILD_ITEM(json);
 		while (child) {
 			err = _iot_json_value_to_cbor(child, &d);
@@ -468,8 +505,7 @@ iot_error_t iot_serialize_json2cbor(JSON_H *json, uint8_t **cbor, size_t *cborle
 	CborError err;
 	CborEncoder root = {0};
 	uint8_t *buf;
-	size_t olen = 128, actual_len;
-	size_t extra_bytes_needed = 0;
+	size_t olen, actual_len;
 
 	if ((cbor == NULL) || (cborlen == NULL) ||
 	    (json == NULL)) {
@@ -477,40 +513,30 @@ iot_error_t iot_serialize_json2cbor(JSON_H *json, uint8_t **cbor, size_t *cborle
 		return IOT_ERROR_INVALID_ARGS;
 	}
 
-retry:
-	olen += extra_bytes_needed;
-	buf = (uint8_t *)iot_os_malloc(olen + 1);
+	/* Encoder without buffer only counts, so that cbor is written once in exact size */
+	cbor_encoder_init(&root, NULL, 0, 0);
+	err = _iot_json_value_to_cbor(json, &root);
+	if (err != 0 && err != CborErrorOutOfMemory) {
+		IOT_ERROR("fail serialize to cbor");
+		return IOT_ERROR_BAD_REQ;
+	}
+	olen = cbor_encoder_get_extra_bytes_needed(&root);
+
+	buf = (uint8_t *)malloc(olen + 1);
 	if (buf == NULL) {
 		IOT_ERROR("failed to malloc for cbor");
 		return IOT_ERROR_MEM_ALLOC;
 	}
-	memset(buf, 0, olen + 1);
+	buf[olen] = 0;
 
 	cbor_encoder_init(&root, buf, olen, 0);
-
 	err = _iot_json_value_to_cbor(json, &root);
-	if (err != 0 && err != CborErrorOutOfMemory) {
-		IOT_ERROR("fail serialize to cbor");
+	if (err != 0 || cbor_encoder_get_extra_bytes_needed(&root)) {
+		IOT_ERROR("fail serialize to cbor (%d)", err);
 		goto exit_failed;
 	}
 
-	extra_bytes_needed = cbor_encoder_get_extra_bytes_needed(&root);
-	if (extra_bytes_needed) {
-		IOT_WARN("allocated size is not enough need more %d", extra_bytes_needed);
-		free(buf);
-		goto retry;
-	}
-
 	actual_len = cbor_encoder_get_buffer_size(&root, buf);
-	if (actual_len < olen) {
-		uint8_t *tmp = (uint8_t *)realloc(buf, actual_len + 1);
-		if (!tmp) {
-			IOT_ERROR("realloc failed for cbor");
-			goto exit_failed;
-		} else {
-			buf = tmp;
-		}
-	}
 
 	*cbor = buf;
 	*cborlen = actual_len;
@@ -0,0 +1,947 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+
+#include "iot_debug.h"
+#include "iot_error.h"
+#include "iot_os_util.h"
+#include "iot_serialize.h"
+
+#define _WRITER_BIT(depth)	(1u << (depth))
+#define _RAW_STRING_LOCAL_SIZE	64
+
+enum {
+	_RAW_OK = 0,
+	_RAW_INVALID,
+	_RAW_TOO_DEEP,
+	_RAW_NO_MEM,
+};
+
+static void _iot_serialize_writer_fail(iot_serialize_writer_t *writer, iot_error_t err)
+{
+	if (writer->err == IOT_ERROR_NONE) {
+		writer->err = err;
+	}
+}
+
+static void _iot_serialize_writer_put(iot_serialize_writer_t *writer, const char *data, size_t len)
+{
+	size_t room;
+
+	if (writer->len < writer->size) {
+		room = writer->size - writer->len;
+		memcpy(writer->buf + writer->len, data, (len < room) ? len : room);
+	}
+	writer->len += len;
+}
+
+/* Same escaping as cJSON print_string_ptr() */
+static void _iot_serialize_writer_json_string(iot_serialize_writer_t *writer, const char *string, size_t len)
+{
+	const char *run = string;
+	char escaped[7];
+	unsigned char c;
+	size_t i;
+
+	_iot_serialize_writer_put(writer, "\"", 1);
+	for (i = 0; i < len; i++) {
+		c = (unsigned char)string[i];
+		if (c >= 32 && c != '\"' && c != '\\') {
+			continue;
+		}
+
+		_iot_serialize_writer_put(writer, run, (string + i) - run);
+		run = string + i + 1;
+
+		switch (c) {
+		case '\\':
+			_iot_serialize_writer_put(writer, "\\\\", 2);
+			break;
+		case '\"':
+			_iot_serialize_writer_put(writer, "\\\"", 2);
+			break;
+		case '\b':
+			_iot_serialize_writer_put(writer, "\\b", 2);
+			break;
+		case '\f':
+			_iot_serialize_writer_put(writer, "\\f", 2);
+			break;
+		case '\n':
+			_iot_serialize_writer_put(writer, "\\n", 2);
+			break;
+		case '\r':
+			_iot_serialize_writer_put(writer, "\\r", 2);
+			break;
+		case '\t':
+			_iot_serialize_writer_put(writer, "\\t", 2);
+			break;
+		default:
+			snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+			_iot_serialize_writer_put(writer, escaped, 6);
+			break;
+		}
+	}
+	_iot_serialize_writer_put(writer, run, (string + len) - run);
+	_iot_serialize_writer_put(writer, "\"", 1);
+}
+
+static int _iot_serialize_compare_double(double a, double b)
+{
+	double max_val = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+
+	return (fabs(a - b) <= max_val * DBL_EPSILON);
+}
+
+/* Same formatting as cJSON print_number() */
+static void _iot_serialize_writer_json_number(iot_serialize_writer_t *writer, double number)
+{
+	char buf[26];
+	double test = 0.0;
+	int valueint;
+	int len;
+
+	if (isnan(number) || isinf(number)) {
+		len = snprintf(buf, sizeof(buf), "null");
+	} else {
+		if (number >= INT_MAX) {
+			valueint = INT_MAX;
+		} else if (number <= (double)INT_MIN) {
+			valueint = INT_MIN;
+		} else {
+			valueint = (int)number;
+		}
+
+		if (number == (double)valueint) {
+			len = snprintf(buf, sizeof(buf), "%d", valueint);
+		} else {
+			len = snprintf(buf, sizeof(buf), "%1.15g", number);
+			if ((sscanf(buf, "%lg", &test) != 1) || !_iot_serialize_compare_double(test, number)) {
+				len = snprintf(buf, sizeof(buf), "%1.17g", number);
+			}
+		}
+	}
+
+	if (len < 0 || len > (int)(sizeof(buf) - 1)) {
+		_iot_serialize_writer_fail(writer, IOT_ERROR_BAD_REQ);
+		return;
+	}
+	_iot_serialize_writer_put(writer, buf, len);
+}
+
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+static void _iot_serialize_writer_cbor_check(iot_serialize_writer_t *writer, CborError err)
+{
+	/* Running out of buffer only makes writer count required bytes */
+	if (err != CborNoError && err != CborErrorOutOfMemory) {
+		IOT_ERROR("fail serialize to cbor (%d)", err);
+		_iot_serialize_writer_fail(writer, IOT_ERROR_BAD_REQ);
+	}
+}
+
+/* Same as tinycbor append_to_buffer(), returns where len bytes go or NULL once it only counts */
+static uint8_t *_iot_serialize_writer_cbor_advance(CborEncoder *enc, size_t len)
+{
+	uint8_t *at;
+
+	if (enc->end && (size_t)(enc->end - enc->data.ptr) >= len) {
+		at = enc->data.ptr;
+		enc->data.ptr += len;
+		return at;
+	}
+
+	if (enc->end) {
+		len -= enc->end - enc->data.ptr;
+		enc->end = NULL;
+		enc->data.bytes_needed = 0;
+	}
+	enc->data.bytes_needed += len;
+
+	return NULL;
+}
+
+/*
+ * Containers are opened with indefinite length head, as the number of items
+ * isn't known yet. On close, the head is rewritten with the number of items
+ * instead of writing a break, so that output is the same as definite length
+ * containers of iot_serialize_json2cbor().
+ */
+static void _iot_serialize_writer_cbor_close(iot_serialize_writer_t *writer)
+{
+	CborEncoder *parent = &writer->enc[writer->depth - 1];
+	CborEncoder *container = &writer->enc[writer->depth];
+	uint8_t *head = writer->head[writer->depth];
+	uint32_t items = writer->items[writer->depth];
+	uint8_t major = (writer->is_array & _WRITER_BIT(writer->depth)) ? 0x80 : 0xa0;
+	size_t head_len;
+	uint8_t *body_end;
+	size_t i;
+
+	if (items < 24) {
+		head_len = 1;
+	} else if (items <= 0xff) {
+		head_len = 2;
+	} else if (items <= 0xffff) {
+		head_len = 3;
+	} else {
+		head_len = 5;
+	}
+
+	parent->data = container->data;
+	parent->end = container->end;
+	body_end = parent->data.ptr;
+
+	if (_iot_serialize_writer_cbor_advance(parent, head_len - 1) == NULL || head == NULL) {
+		/* Output doesn't fit in buffer, only its size is counted */
+		return;
+	}
+
+	if (head_len == 1) {
+		head[0] = major | items;
+		return;
+	}
+
+	memmove(head + head_len, head + 1, body_end - (head + 1));
+	head[0] = major | ((head_len == 2) ? 24 : (head_len == 3) ? 25 : 26);
+	for (i = head_len - 1; i > 0; i--) {
+		head[i] = (uint8_t)items;
+		items >>= 8;
+	}
+}
+#endif
+
+static void _iot_serialize_writer_begin_item(iot_serialize_writer_t *writer, const char *key, size_t keylen)
+{
+	if (writer->format == IOT_SERIALIZE_FORMAT_JSON) {
+		if (writer->has_item & _WRITER_BIT(writer->depth)) {
+			_iot_serialize_writer_put(writer, ",", 1);
+		}
+		writer->has_item |= _WRITER_BIT(writer->depth);
+		if (key) {
+			_iot_serialize_writer_json_string(writer, key, keylen);
+			_iot_serialize_writer_put(writer, ":", 1);
+		}
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	} else {
+		writer->items[writer->depth]++;
+		if (key) {
+			_iot_serialize_writer_cbor_check(writer,
+					cbor_encode_text_string(&writer->enc[writer->depth], key, keylen));
+		}
+#endif
+	}
+}
+
+static void _iot_serialize_writer_open(iot_serialize_writer_t *writer, const char *key, size_t keylen, bool array)
+{
+	if (writer->err != IOT_ERROR_NONE) {
+		return;
+	}
+	if (writer->depth >= IOT_SERIALIZE_WRITER_MAX_DEPTH) {
+		IOT_ERROR("too deep nesting (%u)", writer->depth);
+		_iot_serialize_writer_fail(writer, IOT_ERROR_BAD_REQ);
+		return;
+	}
+
+	_iot_serialize_writer_begin_item(writer, key, keylen);
+
+	if (writer->format == IOT_SERIALIZE_FORMAT_JSON) {
+		_iot_serialize_writer_put(writer, array ? "[" : "{", 1);
+		writer->depth++;
+		writer->has_item &= ~_WRITER_BIT(writer->depth);
+		if (array) {
+			writer->is_array |= _WRITER_BIT(writer->depth);
+		} else {
+			writer->is_array &= ~_WRITER_BIT(writer->depth);
+		}
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	} else {
+		CborEncoder *enc = &writer->enc[writer->depth];
+
+		/* Head is rewritten on close, see _iot_serialize_writer_cbor_close() */
+		writer->head[writer->depth + 1] = (enc->end && enc->data.ptr < enc->end) ? enc->data.ptr : NULL;
+		if (array) {
+			cbor_encoder_create_array(enc, &writer->enc[writer->depth + 1], CborIndefiniteLength);
+		} else {
+			cbor_encoder_create_map(enc, &writer->enc[writer->depth + 1], CborIndefiniteLength);
+		}
+		writer->depth++;
+		writer->items[writer->depth] = 0;
+		if (array) {
+			writer->is_array |= _WRITER_BIT(writer->depth);
+		} else {
+			writer->is_array &= ~_WRITER_BIT(writer->depth);
+		}
+#endif
+	}
+}
+
+static void _iot_serialize_writer_string(iot_serialize_writer_t *writer, const char *key, size_t keylen,
+		const char *string, size_t len)
+{
+	if (writer->err != IOT_ERROR_NONE) {
+		return;
+	}
+
+	_iot_serialize_writer_begin_item(writer, key, keylen);
+
+	if (writer->format == IOT_SERIALIZE_FORMAT_JSON) {
+		_iot_serialize_writer_json_string(writer, string, len);
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	} else {
+		_iot_serialize_writer_cbor_check(writer,
+				cbor_encode_text_string(&writer->enc[writer->depth], string, len));
+#endif
+	}
+}
+
+static void _iot_serialize_writer_number(iot_serialize_writer_t *writer, const char *key, size_t keylen,
+		double number)
+{
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	double intpart;
+#endif
+
+	if (writer->err != IOT_ERROR_NONE) {
+		return;
+	}
+
+	_iot_serialize_writer_begin_item(writer, key, keylen);
+
+	if (writer->format == IOT_SERIALIZE_FORMAT_JSON) {
+		_iot_serialize_writer_json_number(writer, number);
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	} else if (modf(number, &intpart) == 0) {
+		_iot_serialize_writer_cbor_check(writer,
+				cbor_encode_int(&writer->enc[writer->depth], (int)number));
+	} else {
+		_iot_serialize_writer_cbor_check(writer,
+				cbor_encode_double(&writer->enc[writer->depth], number));
+#endif
+	}
+}
+
+static void _iot_serialize_writer_bool(iot_serialize_writer_t *writer, const char *key, size_t keylen,
+		bool boolean)
+{
+	if (writer->err != IOT_ERROR_NONE) {
+		return;
+	}
+
+	_iot_serialize_writer_begin_item(writer, key, keylen);
+
+	if (writer->format == IOT_SERIALIZE_FORMAT_JSON) {
+		_iot_serialize_writer_put(writer, boolean ? "true" : "false", boolean ? 4 : 5);
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	} else {
+		_iot_serialize_writer_cbor_check(writer,
+				cbor_encode_boolean(&writer->enc[writer->depth], boolean));
+#endif
+	}
+}
+
+static void _iot_serialize_writer_null(iot_serialize_writer_t *writer, const char *key, size_t keylen)
+{
+	if (writer->err != IOT_ERROR_NONE) {
+		return;
+	}
+
+	if (writer->format != IOT_SERIALIZE_FORMAT_JSON) {
+		/* json2cbor doesn't support null either */
+		IOT_ERROR("not supporting type");
+		_iot_serialize_writer_fail(writer, IOT_ERROR_BAD_REQ);
+		return;
+	}
+
+	_iot_serialize_writer_begin_item(writer, key, keylen);
+	_iot_serialize_writer_put(writer, "null", 4);
+}
+
+/*
+ * JSON text re-serialization
+ *
+ * Follows cJSON_Parse() acceptance rules, so that text which cJSON rejects is
+ * dropped and accepted text is written as cJSON_PrintUnformatted() would.
+ * Each value is validated first with writer NULL, then written.
+ */
+static const char *_iot_raw_skip_ws(const char *p)
+{
+	while (*p && (unsigned char)*p <= 32) {
+		p++;
+	}
+	return p;
+}
+
+static const char *_iot_raw_string_end(const char *p)
+{
+	for (p++; *p && *p != '\"'; p++) {
+		if (*p == '\\') {
+			if (!p[1]) {
+				return NULL;
+			}
+			p++;
+		}
+	}
+
+	return (*p == '\"') ? p : NULL;
+}
+
+static unsigned int _iot_raw_hex4(const char *p)
+{
+	unsigned int h = 0;
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		if (p[i] >= '0' && p[i] <= '9') {
+			h += (unsigned int)p[i] - '0';
+		} else if (p[i] >= 'A' && p[i] <= 'F') {
+			h += (unsigned int)10 + p[i] - 'A';
+		} else if (p[i] >= 'a' && p[i] <= 'f') {
+			h += (unsigned int)10 + p[i] - 'a';
+		} else {
+			return 0;
+		}
+		if (i < 3) {
+			h = h << 4;
+		}
+	}
+
+	return h;
+}
+
+/* Returns consumed input length, 0 on invalid sequence */
+static size_t _iot_raw_utf16_to_utf8(const char *p, const char *end, char *out, size_t *outlen)
+{
+	static const unsigned char first_byte_mark[5] = {0x00, 0x00, 0xC0, 0xE0, 0xF0};
+	unsigned long codepoint;
+	unsigned int first_code, second_code;
+	size_t seq_len, utf8_len, pos;
+
+	if ((end - p) < 6) {
+		return 0;
+	}
+
+	first_code = _iot_raw_hex4(p + 2);
+	if (first_code >= 0xDC00 && first_code <= 0xDFFF) {
+		return 0;
+	}
+
+	if (first_code >= 0xD800 && first_code <= 0xDBFF) {
+		seq_len = 12;
+		if ((end - (p + 6)) < 6 || p[6] != '\\' || p[7] != 'u') {
+			return 0;
+		}
+		second_code = _iot_raw_hex4(p + 8);
+		if (second_code < 0xDC00 || second_code > 0xDFFF) {
+			return 0;
+		}
+		codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+	} else {
+		seq_len = 6;
+		codepoint = first_code;
+	}
+
+	if (codepoint < 0x80) {
+		utf8_len = 1;
+	} else if (codepoint < 0x800) {
+		utf8_len = 2;
+	} else if (codepoint < 0x10000) {
+		utf8_len = 3;
+	} else if (codepoint <= 0x10FFFF) {
+		utf8_len = 4;
+	} else {
+		return 0;
+	}
+
+	if (out) {
+		for (pos = utf8_len - 1; pos > 0; pos--) {
+			out[pos] = (char)((codepoint | 0x80) & 0xBF);
+			codepoint >>= 6;
+		}
+		if (utf8_len > 1) {
+			out[0] = (char)((codepoint | first_byte_mark[utf8_len]) & 0xFF);
+		} else {
+			out[0] = (char)(codepoint & 0x7F);
+		}
+	}
+	*outlen = utf8_len;
+
+	return seq_len;
+}
+
+/* Decode string body [p, end), out can be NULL to validate only */
+static int _iot_raw_string_decode(const char *p, const char *end, char *out, size_t *outlen)
+{
+	size_t n = 0, seq_len, utf8_len;
+	char c;
+
+	while (p < end) {
+		if (*p != '\\') {
+			if (out) {
+				out[n] = *p;
+			}
+			n++;
+			p++;
+			continue;
+		}
+
+		switch (p[1]) {
+		case 'b':
+			c = '\b';
+			break;
+		case 'f':
+			c = '\f';
+			break;
+		case 'n':
+			c = '\n';
+			break;
+		case 'r':
+			c = '\r';
+			break;
+		case 't':
+			c = '\t';
+			break;
+		case '\"':
+		case '\\':
+		case '/':
+			c = p[1];
+			break;
+		case 'u':
+			seq_len = _iot_raw_utf16_to_utf8(p, end, out ? out + n : NULL, &utf8_len);
+			if (seq_len == 0) {
+				return _RAW_INVALID;
+			}
+			n += utf8_len;
+			p += seq_len;
+			continue;
+		default:
+			return _RAW_INVALID;
+		}
+
+		if (out) {
+			out[n] = c;
+		}
+		n++;
+		p += 2;
+	}
+
+	*outlen = n;
+	return _RAW_OK;
+}
+
+/*
+ * Parse a string literal at *pp. When string is not NULL, decoded string is
+ * returned there, *alloc is set if it had to be allocated for decoding.
+ */
+static int _iot_raw_string(const char **pp, char *local, const char **string, size_t *len, char **alloc)
+{
+	const char *start = *pp + 1;
+	const char *end;
+	char *out;
+	size_t n;
+	int ret;
+
+	end = _iot_raw_string_end(*pp);
+	if (end == NULL) {
+		return _RAW_INVALID;
+	}
+
+	if (string == NULL) {
+		ret = _iot_raw_string_decode(start, end, NULL, &n);
+	} else if (memchr(start, '\\', end - start) == NULL) {
+		*string = start;
+		*len = end - start;
+		ret = _RAW_OK;
+	} else {
+		/* Decoded string never gets longer than its literal */
+		if ((size_t)(end - start) <= _RAW_STRING_LOCAL_SIZE) {
+			out = local;
+		} else {
+			out = (char *)iot_os_malloc(end - start);
+			if (out == NULL) {
+				IOT_ERROR("failed to malloc for string");
+				return _RAW_NO_MEM;
+			}
+			*alloc = out;
+		}
+		ret = _iot_raw_string_decode(start, end, out, &n);
+		/* cJSON keeps decoded string as C string */
+		*string = out;
+		*len = strnlen(out, n);
+	}
+
+	if (ret == _RAW_OK) {
+		*pp = end + 1;
+	}
+	return ret;
+}
+
+static int _iot_raw_value(iot_serialize_writer_t *writer, const char **pp,
+		const char *key, size_t keylen, unsigned int depth);
+
+static int _iot_raw_container(iot_serialize_writer_t *writer, const char **pp,
+		const char *key, size_t keylen, unsigned int depth, bool array)
+{
+	const char *p = *pp;
+	char local[_RAW_STRING_LOCAL_SIZE];
+	const char *member = NULL;
+	size_t member_len = 0;
+	char *alloc;
+	int ret;
+
+	if (depth >= IOT_SERIALIZE_WRITER_MAX_DEPTH) {
+		return _RAW_TOO_DEEP;
+	}
+
+	if (writer) {
+		_iot_serialize_writer_open(writer, key, keylen, array);
+	}
+
+	p = _iot_raw_skip_ws(p + 1);
+	if (*p != (array ? ']' : '}')) {
+		while (1) {
+			p = _iot_raw_skip_ws(p);
+			if (array) {
+				ret = _iot_raw_value(writer, &p, NULL, 0, depth + 1);
+			} else {
+				if (*p != '\"') {
+					return _RAW_INVALID;
+				}
+				alloc = NULL;
+				ret = _iot_raw_string(&p, local, writer ? &member : NULL, &member_len, &alloc);
+				if (ret == _RAW_OK) {
+					p = _iot_raw_skip_ws(p);
+					if (*p != ':') {
+						ret = _RAW_INVALID;
+					} else {
+						p = _iot_raw_skip_ws(p + 1);
+						ret = _iot_raw_value(writer, &p, member, member_len, depth + 1);
+					}
+				}
+				if (alloc) {
+					iot_os_free(alloc);
+				}
+			}
+			if (ret != _RAW_OK) {
+				return ret;
+			}
+
+			p = _iot_raw_skip_ws(p);
+			if (*p != ',') {
+				break;
+			}
+			p++;
+		}
+
+		if (*p != (array ? ']' : '}')) {
+			return _RAW_INVALID;
+		}
+	}
+
+	if (writer) {
+		iot_serialize_writer_close(writer);
+	}
+	*pp = p + 1;
+
+	return _RAW_OK;
+}
+
+static int _iot_raw_value(iot_serialize_writer_t *writer, const char **pp,
+		const char *key, size_t keylen, unsigned int depth)
+{
+	const char *p = *pp;
+	char local[_RAW_STRING_LOCAL_SIZE];
+	char number_str[64];
+	const char *string;
+	size_t len;
+	char *alloc = NULL;
+	char *after_end;
+	double number;
+	int ret;
+
+	if (!strncmp(p, "null", 4)) {
+		if (writer) {
+			_iot_serialize_writer_null(writer, key, keylen);
+		}
+		*pp = p + 4;
+	} else if (!strncmp(p, "false", 5)) {
+		if (writer) {
+			_iot_serialize_writer_bool(writer, key, keylen, false);
+		}
+		*pp = p + 5;
+	} else if (!strncmp(p, "true", 4)) {
+		if (writer) {
+			_iot_serialize_writer_bool(writer, key, keylen, true);
+		}
+		*pp = p + 4;
+	} else if (*p == '\"') {
+		ret = _iot_raw_string(pp, local, writer ? &string : NULL, &len, &alloc);
+		if (ret == _RAW_OK && writer) {
+			_iot_serialize_writer_string(writer, key, keylen, string, len);
+		}
+		if (alloc) {
+			iot_os_free(alloc);
+		}
+		return ret;
+	} else if (*p == '-' || (*p >= '0' && *p <= '9')) {
+		/* Same number scanning as cJSON parse_number() */
+		for (len = 0; len < sizeof(number_str) - 1; len++) {
+			if ((p[len] >= '0' && p[len] <= '9') || p[len] == '+' || p[len] == '-' ||
+					p[len] == 'e' || p[len] == 'E' || p[len] == '.') {
+				number_str[len] = p[len];
+			} else {
+				break;
+			}
+		}
+		number_str[len] = '\0';
+
+		number = strtod(number_str, &after_end);
+		if (after_end == number_str) {
+			return _RAW_INVALID;
+		}
+		if (writer) {
+			_iot_serialize_writer_number(writer, key, keylen, number);
+		}
+		*pp = p + (after_end - number_str);
+	} else if (*p == '[' || *p == '{') {
+		return _iot_raw_container(writer, pp, key, keylen, depth, *p == '[');
+	} else {
+		return _RAW_INVALID;
+	}
+
+	return _RAW_OK;
+}
+
+void iot_serialize_writer_init(iot_serialize_writer_t *writer, iot_serialize_format_t format,
+		uint8_t *buf, size_t size)
+{
+	memset(writer, '\0', sizeof(iot_serialize_writer_t));
+	writer->format = format;
+	writer->buf = buf;
+	writer->size = buf ? size : 0;
+
+	if (format == IOT_SERIALIZE_FORMAT_CBOR) {
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+		cbor_encoder_init(&writer->enc[0], writer->buf, writer->size, 0);
+#else
+		IOT_ERROR("cbor is not supported");
+		writer->err = IOT_ERROR_INVALID_ARGS;
+#endif
+	}
+}
+
+void iot_serialize_writer_open_object(iot_serialize_writer_t *writer, const char *key)
+{
+	_iot_serialize_writer_open(writer, key, key ? strlen(key) : 0, false);
+}
+
+void iot_serialize_writer_open_array(iot_serialize_writer_t *writer, const char *key)
+{
+	_iot_serialize_writer_open(writer, key, key ? strlen(key) : 0, true);
+}
+
+void iot_serialize_writer_close(iot_serialize_writer_t *writer)
+{
+	if (writer->err != IOT_ERROR_NONE) {
+		return;
+	}
+	if (writer->depth == 0) {
+		IOT_ERROR("no container to close");
+		_iot_serialize_writer_fail(writer, IOT_ERROR_BAD_REQ);
+		return;
+	}
+
+	if (writer->format == IOT_SERIALIZE_FORMAT_JSON) {
+		if (writer->is_array & _WRITER_BIT(writer->depth)) {
+			_iot_serialize_writer_put(writer, "]", 1);
+		} else {
+			_iot_serialize_writer_put(writer, "}", 1);
+		}
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	} else {
+		_iot_serialize_writer_cbor_close(writer);
+#endif
+	}
+	writer->depth--;
+}
+
+void iot_serialize_writer_add_string(iot_serialize_writer_t *writer, const char *key, const char *string)
+{
+	if (string == NULL) {
+		return;
+	}
+	_iot_serialize_writer_string(writer, key, key ? strlen(key) : 0, string, strlen(string));
+}
+
+void iot_serialize_writer_add_number(iot_serialize_writer_t *writer, const char *key, double number)
+{
+	_iot_serialize_writer_number(writer, key, key ? strlen(key) : 0, number);
+}
+
+void iot_serialize_writer_add_bool(iot_serialize_writer_t *writer, const char *key, bool boolean)
+{
+	_iot_serialize_writer_bool(writer, key, key ? strlen(key) : 0, boolean);
+}
+
+void iot_serialize_writer_add_string_array(iot_serialize_writer_t *writer, const char *key,
+		const char **strings, int count)
+{
+	int i;
+
+	if (count < 0 || (count > 0 && strings == NULL)) {
+		return;
+	}
+	for (i = 0; i < count; i++) {
+		if (strings[i] == NULL) {
+			return;
+		}
+	}
+
+	iot_serialize_writer_open_array(writer, key);
+	for (i = 0; i < count; i++) {
+		iot_serialize_writer_add_string(writer, NULL, strings[i]);
+	}
+	iot_serialize_writer_close(writer);
+}
+
+void iot_serialize_writer_add_raw_json(iot_serialize_writer_t *writer, const char *key, const char *json)
+{
+	const char *p;
+	int ret;
+
+	if (json == NULL || writer->err != IOT_ERROR_NONE) {
+		return;
+	}
+
+	if (!strncmp(json, "\xEF\xBB\xBF", 3)) {
+		json += 3;
+	}
+	json = _iot_raw_skip_ws(json);
+
+	p = json;
+	ret = _iot_raw_value(NULL, &p, NULL, 0, writer->depth);
+	if (ret == _RAW_INVALID) {
+		IOT_WARN("drop unparsable json for %s", key ? key : "item");
+		return;
+	} else if (ret != _RAW_OK) {
+		IOT_ERROR("fail to write json for %s (%d)", key ? key : "item", ret);
+		_iot_serialize_writer_fail(writer, IOT_ERROR_BAD_REQ);
+		return;
+	}
+
+	p = json;
+	ret = _iot_raw_value(writer, &p, key, key ? strlen(key) : 0, writer->depth);
+	if (ret != _RAW_OK) {
+		_iot_serialize_writer_fail(writer, (ret == _RAW_NO_MEM) ? IOT_ERROR_MEM_ALLOC : IOT_ERROR_BAD_REQ);
+	}
+}
+
+void iot_serialize_writer_add_encoded(iot_serialize_writer_t *writer, const char *key,
+		const uint8_t *data, size_t len)
+{
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	uint8_t *at;
+#endif
+
+	if (writer->err != IOT_ERROR_NONE) {
+		return;
+	}
+
+	_iot_serialize_writer_begin_item(writer, key, key ? strlen(key) : 0);
+
+	if (writer->format == IOT_SERIALIZE_FORMAT_JSON) {
+		_iot_serialize_writer_put(writer, (const char *)data, len);
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	} else {
+		at = _iot_serialize_writer_cbor_advance(&writer->enc[writer->depth], len);
+		if (at) {
+			memcpy(at, data, len);
+		}
+#endif
+	}
+}
+
+void iot_serialize_writer_add_members(iot_serialize_writer_t *writer,
+		const char *data, size_t len, unsigned int count)
+{
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	uint8_t *at;
+#endif
+
+	if (writer->err != IOT_ERROR_NONE || count == 0) {
+		return;
+	}
+
+	if (writer->format == IOT_SERIALIZE_FORMAT_JSON) {
+		_iot_serialize_writer_begin_item(writer, NULL, 0);
+		_iot_serialize_writer_put(writer, data, len);
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	} else {
+		writer->items[writer->depth] += count;
+		at = _iot_serialize_writer_cbor_advance(&writer->enc[writer->depth], len);
+		if (at) {
+			memcpy(at, data, len);
+		}
+#endif
+	}
+}
+
+iot_error_t iot_serialize_writer_finish(iot_serialize_writer_t *writer, size_t *len, size_t *needed)
+{
+	size_t total;
+
+	if (writer->err != IOT_ERROR_NONE) {
+		return writer->err;
+	}
+	if (writer->depth != 0) {
+		IOT_ERROR("%u containers are not closed", writer->depth);
+		return IOT_ERROR_BAD_REQ;
+	}
+
+	if (writer->format == IOT_SERIALIZE_FORMAT_JSON) {
+		total = writer->len;
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+	} else if (cbor_encoder_get_extra_bytes_needed(&writer->enc[0])) {
+		total = writer->size + cbor_encoder_get_extra_bytes_needed(&writer->enc[0]);
+	} else {
+		total = cbor_encoder_get_buffer_size(&writer->enc[0], writer->buf);
+#else
+	} else {
+		return IOT_ERROR_INVALID_ARGS;
+#endif
+	}
+
+	if (needed) {
+		*needed = total + 1;
+	}
+	if (total + 1 > writer->size) {
+		return IOT_ERROR_MEM_ALLOC;
+	}
+
+	writer->buf[total] = '\0';
+	if (len) {
+		*len = total;
+	}
+
+	return IOT_ERROR_NONE;
+}
@@ -460,6 +460,18 @@ iot_error_t iot_util_url_parse(char *url, url_parse_t *output)
 	return IOT_ERROR_NONE;
 }
 
+#define _QUEUE_LOAD(ptr)		__atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define _QUEUE_LOAD_RELAXED(ptr)	__atomic_load_n(ptr, __ATOMIC_RELAXED)
+#define _QUEUE_STORE(ptr, val)		__atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#define _QUEUE_CLAIM(ptr, expected, desired)	\
+	__atomic_compare_exchange_n(ptr, expected, desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+
+/* Each ring slot is sequence, removed mark and item */
+#define _QUEUE_SLOT(ring, pos)		((ring)->slots + ((pos) & (ring)->mask) * (ring)->slot_size)
+#define _QUEUE_SLOT_SEQ(slot)		((size_t *)(slot))
+#define _QUEUE_SLOT_REMOVED(slot)	((size_t *)(slot) + 1)
+#define _QUEUE_SLOT_ITEM(slot)		((unsigned char *)(slot) + 2 * sizeof(size_t))
+
 iot_util_queue_t* iot_util_queue_create(size_t item_size)
 {
 	iot_util_queue_t *queue = NULL;
@@ -488,6 +500,47 @@ iot_util_queue_t* iot_util_queue_create(size_t item_size)
 	return queue;
 }
 
+iot_util_queue_t* iot_util_queue_create_ring(size_t item_size, size_t capacity)
+{
+	iot_util_queue_t *queue = NULL;
+	iot_util_queue_ring_t *ring;
+	size_t slot_size, i;
+
+	if (item_size == 0 || capacity < 2) {
+		IOT_ERROR("Queue item size should be above 0 and capacity above 1");
+		return NULL;
+	}
+	for (i = 2; i < capacity; i <<= 1);
+	capacity = i;
+
+	queue = iot_util_queue_create(item_size);
+	if (queue == NULL) {
+		return NULL;
+	}
+
+	slot_size = 2 * sizeof(size_t) + item_size;
+	slot_size = (slot_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+	ring = iot_os_malloc(sizeof(iot_util_queue_ring_t) + slot_size * capacity);
+	if (ring == NULL) {
+		IOT_ERROR("Fail to malloc queue ring");
+		iot_util_queue_delete(queue);
+		return NULL;
+	}
+	memset(ring, '\0', sizeof(iot_util_queue_ring_t));
+	ring->mask = capacity - 1;
+	ring->slot_size = slot_size;
+	ring->slots = (unsigned char *)(ring + 1);
+	for (i = 0; i < capacity; i++) {
+		*_QUEUE_SLOT_SEQ(ring->slots + i * slot_size) = i;
+		*_QUEUE_SLOT_REMOVED(ring->slots + i * slot_size) = 0;
+	}
+
+	queue->ring = ring;
+
+	return queue;
+}
+
 void iot_util_queue_delete(iot_util_queue_t* queue)
 {
 	do {
@@ -510,9 +563,75 @@ void iot_util_queue_delete(iot_util_queue_t* queue)
 		queue->lock.sem = NULL;
 	}
 
+	if (queue->ring) {
+		iot_os_free(queue->ring);
+	}
 	iot_os_free(queue);
 }
 
+static iot_error_t _iot_util_queue_ring_send(iot_util_queue_t* queue, void * data)
+{
+	iot_util_queue_ring_t *ring = queue->ring;
+	unsigned char *slot;
+	size_t pos, seq;
+	intptr_t diff;
+
+	pos = _QUEUE_LOAD_RELAXED(&ring->enqueue_pos);
+	for (;;) {
+		slot = _QUEUE_SLOT(ring, pos);
+		seq = _QUEUE_LOAD(_QUEUE_SLOT_SEQ(slot));
+		diff = (intptr_t)seq - (intptr_t)pos;
+		if (diff == 0) {
+			if (_QUEUE_CLAIM(&ring->enqueue_pos, &pos, pos + 1)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return IOT_ERROR_MEM_ALLOC;
+		} else {
+			pos = _QUEUE_LOAD_RELAXED(&ring->enqueue_pos);
+		}
+	}
+
+	memcpy(_QUEUE_SLOT_ITEM(slot), data, queue->item_size);
+	_QUEUE_STORE(_QUEUE_SLOT_SEQ(slot), pos + 1);
+
+	return IOT_ERROR_NONE;
+}
+
+static iot_error_t _iot_util_queue_ring_receive(iot_util_queue_t* queue, void * data)
+{
+	iot_util_queue_ring_t *ring = queue->ring;
+	unsigned char *slot;
+	size_t pos, seq;
+	intptr_t diff;
+	bool removed;
+
+	pos = _QUEUE_LOAD_RELAXED(&ring->dequeue_pos);
+	for (;;) {
+		slot = _QUEUE_SLOT(ring, pos);
+		seq = _QUEUE_LOAD(_QUEUE_SLOT_SEQ(slot));
+		diff = (intptr_t)seq - (intptr_t)(pos + 1);
+		if (diff == 0) {
+			if (_QUEUE_CLAIM(&ring->dequeue_pos, &pos, pos + 1)) {
+				removed = (_QUEUE_LOAD(_QUEUE_SLOT_REMOVED(slot)) == pos + 1);
+				if (!removed) {
+					memcpy(data, _QUEUE_SLOT_ITEM(slot), queue->item_size);
+				}
+				_QUEUE_STORE(_QUEUE_SLOT_SEQ(slot), pos + ring->mask + 1);
+				if (!removed) {
+					return IOT_ERROR_NONE;
+				}
+				/* Removed by iot_util_queue_remove_if, free the slot and go on */
+				pos = _QUEUE_LOAD_RELAXED(&ring->dequeue_pos);
+			}
+		} else if (diff < 0) {
+			return IOT_ERROR_BAD_REQ;
+		} else {
+			pos = _QUEUE_LOAD_RELAXED(&ring->dequeue_pos);
+		}
+	}
+}
+
 iot_error_t iot_util_queue_send(iot_util_queue_t* queue, void * data)
 {
 	iot_util_queue_data_t *queue_data = NULL;
@@ -520,6 +639,17 @@ iot_error_t iot_util_queue_send(iot_util_queue_t* queue, void * data)
 		return IOT_ERROR_INVALID_ARGS;
 	}
 
+	if (queue->ring) {
+		if (_iot_util_queue_ring_send(queue, data) != IOT_ERROR_NONE) {
+			IOT_ERROR("Queue ring is full");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+		if (queue->notify) {
+			queue->notify(queue->notify_arg);
+		}
+		return IOT_ERROR_NONE;
+	}
+
 	queue_data = iot_os_malloc(sizeof(iot_util_queue_data_t));
 	if (queue_data == NULL) {
 		IOT_ERROR("Fail to malloc queue data struct");
@@ -549,6 +679,10 @@ iot_error_t iot_util_queue_send(iot_util_queue_t* queue, void * data)
 
 	iot_os_mutex_unlock(&queue->lock);
 
+	if (queue->notify) {
+		queue->notify(queue->notify_arg);
+	}
+
 	return IOT_ERROR_NONE;
 }
 
@@ -561,6 +695,10 @@ iot_error_t iot_util_queue_receive(iot_util_queue_t* queue, void * data)
 		return IOT_ERROR_INVALID_ARGS;
 	}
 
+	if (queue->ring) {
+		return _iot_util_queue_ring_receive(queue, data);
+	}
+
 	if((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE)
 		return IOT_ERROR_TIMEOUT;
 
@@ -586,6 +724,175 @@ iot_error_t iot_util_queue_receive(iot_util_queue_t* queue, void * data)
 	return ret;
 }
 
+size_t iot_util_queue_receive_batch(iot_util_queue_t* queue, void * data, size_t max_items)
+{
+	iot_util_queue_data_t *queue_data, *first, *last = NULL;
+	size_t count = 0;
+
+	if (queue == NULL || data == NULL) {
+		return 0;
+	}
+
+	if (queue->ring) {
+		while (count < max_items &&
+				_iot_util_queue_ring_receive(queue, (char *)data + count * queue->item_size) == IOT_ERROR_NONE) {
+			count++;
+		}
+		return count;
+	}
+
+	/* Detach items under one lock, copy them out after */
+	if((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE)
+		return 0;
+
+	first = queue->head;
+	for (queue_data = queue->head; queue_data && count < max_items; queue_data = queue_data->next) {
+		last = queue_data;
+		count++;
+	}
+	if (last) {
+		queue->head = last->next;
+		last->next = NULL;
+		if (queue->head == NULL) {
+			queue->tail = NULL;
+		}
+	}
+
+	iot_os_mutex_unlock(&queue->lock);
+
+	for (count = 0; first; count++) {
+		queue_data = first;
+		first = first->next;
+		memcpy((char *)data + count * queue->item_size, queue_data->data, queue->item_size);
+		iot_os_free(queue_data->data);
+		iot_os_free(queue_data);
+	}
+
+	return count;
+}
+
+/*
+ * Queued items stay in their slots and are only marked as removed, so
+ * producers and consumers keep running and the order is kept. The mark
+ * is the filled sequence of the slot, so a stale one never matches the
+ * item of a later lap. An item taken by a consumer while it is checked
+ * here is delivered as usual, same as a linked queue receive that wins
+ * the lock.
+ */
+static void _iot_util_queue_ring_remove_if(iot_util_queue_t* queue,
+		bool (*match)(void *item, void *arg), void *arg)
+{
+	iot_util_queue_ring_t *ring = queue->ring;
+	unsigned char *slot, *item;
+	size_t pos, end;
+
+	item = iot_os_malloc(queue->item_size);
+	if (item == NULL) {
+		IOT_ERROR("Fail to malloc queue item");
+		return;
+	}
+
+	pos = _QUEUE_LOAD(&ring->dequeue_pos);
+	end = _QUEUE_LOAD(&ring->enqueue_pos);
+	for (; (intptr_t)(end - pos) > 0; pos++) {
+		slot = _QUEUE_SLOT(ring, pos);
+		if (_QUEUE_LOAD(_QUEUE_SLOT_SEQ(slot)) != pos + 1) {
+			/* Already taken by a consumer, or not written yet */
+			continue;
+		}
+		memcpy(item, _QUEUE_SLOT_ITEM(slot), queue->item_size);
+		/* Sequence only grows, so the copy is valid if the slot is still filled */
+		if (_QUEUE_LOAD(_QUEUE_SLOT_SEQ(slot)) != pos + 1) {
+			continue;
+		}
+		if (match(item, arg)) {
+			_QUEUE_STORE(_QUEUE_SLOT_REMOVED(slot), pos + 1);
+		}
+	}
+
+	iot_os_free(item);
+}
+
+void iot_util_queue_remove_if(iot_util_queue_t* queue,
+		bool (*match)(void *item, void *arg), void *arg)
+{
+	iot_util_queue_data_t *queue_data_iter, *queue_data_prev, *tmp;
+
+	if (queue == NULL || match == NULL)
+		return;
+
+	if (queue->ring) {
+		_iot_util_queue_ring_remove_if(queue, match, arg);
+		return;
+	}
+
+	if((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE)
+		return;
+
+	queue_data_iter = queue->head;
+	queue_data_prev = NULL;
+	while (queue_data_iter) {
+		if (match(queue_data_iter->data, arg)) {
+			tmp = queue_data_iter;
+			queue_data_iter = queue_data_iter->next;
+			if (queue_data_prev) {
+				queue_data_prev->next = queue_data_iter;
+			} else {
+				queue->head = queue_data_iter;
+			}
+			if (queue->tail == tmp) {
+				queue->tail = queue_data_prev;
+			}
+			iot_os_free(tmp->data);
+			iot_os_free(tmp);
+		} else {
+			queue_data_prev = queue_data_iter;
+			queue_data_iter = queue_data_iter->next;
+		}
+	}
+
+	iot_os_mutex_unlock(&queue->lock);
+}
+
+bool iot_util_queue_is_empty(iot_util_queue_t* queue)
+{
+	iot_util_queue_ring_t *ring;
+	size_t pos;
+	bool empty;
+
+	if (queue == NULL) {
+		return true;
+	}
+
+	if (queue->ring) {
+		ring = queue->ring;
+		pos = _QUEUE_LOAD(&ring->dequeue_pos);
+		/*
+		 * Slot at dequeue position is filled once its sequence passes the position.
+		 * Removed items count until a receiver frees their slots.
+		 */
+		return _QUEUE_LOAD(_QUEUE_SLOT_SEQ(_QUEUE_SLOT(ring, pos))) != pos + 1;
+	}
+
+	if ((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE) {
+		return false;
+	}
+	empty = (queue->head == NULL);
+	iot_os_mutex_unlock(&queue->lock);
+
+	return empty;
+}
+
+void iot_util_queue_set_notify(iot_util_queue_t* queue,
+		void (*notify)(void *arg), void *arg)
+{
+	if (queue == NULL) {
+		return;
+	}
+
+	queue->notify_arg = arg;
+	queue->notify = notify;
+}
 
 unsigned int iot_util_generator_backoff(unsigned int try_count, unsigned int maximum_backoff)
 {
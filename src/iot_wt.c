@@ -1176,3 +1176,104 @@ iot_error_t iot_wt_create(const iot_wt_params_t *wt_params, iot_security_buffer_
 	return _iot_jwt_create(wt_params, token_buf);
 #endif
 }
+
+static char *_iot_wt_cache_params(const iot_wt_params_t *wt_params)
+{
+	const char *field[4] = { wt_params->sn, wt_params->mnid, wt_params->dipid, wt_params->cert_sn };
+	size_t field_len[4] = { wt_params->sn_len, wt_params->mnid_len, wt_params->dipid_len, 0 };
+	size_t len = 0;
+	char *params;
+	int i;
+
+	if (wt_params->cert_sn) {
+		field_len[3] = strlen(wt_params->cert_sn);
+	}
+	for (i = 0; i < 4; i++) {
+		len += (field[i] ? field_len[i] : 0) + 1;
+	}
+
+	params = (char *)iot_os_malloc(len);
+	if (params == NULL) {
+		return NULL;
+	}
+
+	/* fields joined by '\n', none of them has it */
+	len = 0;
+	for (i = 0; i < 4; i++) {
+		if (field[i]) {
+			memcpy(params + len, field[i], field_len[i]);
+			len += field_len[i];
+		}
+		params[len++] = (i < 3) ? '\n' : '\0';
+	}
+
+	return params;
+}
+
+void iot_wt_cache_clear(iot_wt_cache_t *cache)
+{
+	if (cache == NULL) {
+		return;
+	}
+
+	if (cache->token.p) {
+		iot_os_free(cache->token.p);
+	}
+	if (cache->params) {
+		iot_os_free(cache->params);
+	}
+	memset(cache, 0, sizeof(iot_wt_cache_t));
+}
+
+iot_error_t iot_wt_create_cached(iot_wt_cache_t *cache, const iot_wt_params_t *wt_params,
+		iot_security_buffer_t *token_buf)
+{
+	iot_error_t err;
+	iot_security_buffer_t new_token = { 0 };
+	char *params;
+	long now = 0;
+
+	if (!cache || !wt_params || !token_buf) {
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	params = _iot_wt_cache_params(wt_params);
+	if (params == NULL) {
+		return IOT_ERROR_MEM_ALLOC;
+	}
+
+	err = iot_get_time_in_sec_by_long(&now);
+	if (err == IOT_ERROR_NONE && cache->token.p && !strcmp(cache->params, params) &&
+			now >= cache->issued_at &&
+			now - cache->issued_at < CONFIG_STDK_IOT_CORE_WEBTOKEN_REUSE_SEC) {
+		iot_os_free(params);
+		IOT_DEBUG("reuse token issued %lds ago", now - cache->issued_at);
+		goto copy_token;
+	}
+
+	iot_wt_cache_clear(cache);
+
+	err = iot_wt_create(wt_params, &new_token);
+	if (err) {
+		iot_os_free(params);
+		return err;
+	}
+	/* Taken after signing, so that it never looks younger than iat in it */
+	if (iot_get_time_in_sec_by_long(&now) != IOT_ERROR_NONE) {
+		now = 0;
+	}
+	cache->token = new_token;
+	cache->issued_at = now;
+	cache->params = params;
+
+copy_token:
+	token_buf->p = (unsigned char *)iot_os_malloc(cache->token.len + 1);
+	if (token_buf->p == NULL) {
+		return IOT_ERROR_MEM_ALLOC;
+	}
+	memcpy(token_buf->p, cache->token.p, cache->token.len);
+	token_buf->p[cache->token.len] = '\0';
+	token_buf->len = cache->token.len;
+
+	return IOT_ERROR_NONE;
+}
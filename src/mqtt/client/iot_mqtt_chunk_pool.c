@@ -0,0 +1,315 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include "iot_debug.h"
+#include "iot_mqtt_client.h"
+#include "iot_mqtt_chunk_pool.h"
+
+#define _CHUNK_POOL_ALIGN(x)	(((x) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+static int _iot_mqtt_chunk_slab_init(iot_mqtt_chunk_slab_t *slab, size_t block_size, unsigned int block_count)
+{
+	unsigned int i;
+
+	memset(slab, '\0', sizeof(iot_mqtt_chunk_slab_t));
+	if (block_size == 0 || block_count == 0) {
+		return 0;
+	}
+
+	slab->block_size = _CHUNK_POOL_ALIGN(block_size);
+	slab->base = iot_os_malloc(slab->block_size * block_count);
+	if (slab->base == NULL) {
+		IOT_ERROR("slab malloc fail");
+		return -1;
+	}
+	slab->block_count = block_count;
+
+	for (i = 0; i < block_count; i++) {
+		void **block = (void **)(slab->base + (i * slab->block_size));
+		*block = slab->free_list;
+		slab->free_list = block;
+	}
+
+	return 0;
+}
+
+static void _iot_mqtt_chunk_slab_deinit(iot_mqtt_chunk_slab_t *slab)
+{
+	if (slab->base) {
+		iot_os_free(slab->base);
+	}
+	memset(slab, '\0', sizeof(iot_mqtt_chunk_slab_t));
+}
+
+static bool _iot_mqtt_chunk_slab_owns(iot_mqtt_chunk_slab_t *slab, void *ptr)
+{
+	unsigned char *p = ptr;
+
+	if (slab->base == NULL) {
+		return false;
+	}
+	return (p >= slab->base && p < slab->base + (slab->block_size * slab->block_count));
+}
+
+static void *_iot_mqtt_chunk_slab_get(iot_mqtt_chunk_slab_t *slab)
+{
+	void **block = slab->free_list;
+
+	if (block == NULL) {
+		return NULL;
+	}
+	slab->free_list = *block;
+
+	return block;
+}
+
+static void _iot_mqtt_chunk_slab_put(iot_mqtt_chunk_slab_t *slab, void *ptr)
+{
+	void **block = ptr;
+
+	*block = slab->free_list;
+	slab->free_list = block;
+}
+
+static void _iot_mqtt_chunk_pool_destroy(iot_mqtt_chunk_pool_t *pool)
+{
+	int i;
+
+	_iot_mqtt_chunk_slab_deinit(&pool->header_slab);
+	for (i = 0; i < IOT_MQTT_CHUNK_POOL_CLASS_MAX; i++) {
+		_iot_mqtt_chunk_slab_deinit(&pool->data_slab[i]);
+	}
+
+	if (pool->lock.sem != NULL) {
+		iot_os_mutex_destroy(&pool->lock);
+		pool->lock.sem = NULL;
+	}
+	iot_os_free(pool);
+}
+
+iot_mqtt_chunk_pool_t *iot_mqtt_chunk_pool_create(void)
+{
+	const size_t class_size[IOT_MQTT_CHUNK_POOL_CLASS_MAX] = {
+		IOT_MQTT_CHUNK_POOL_SMALL_SIZE,
+		IOT_MQTT_CHUNK_POOL_MEDIUM_SIZE,
+		IOT_MQTT_CHUNK_POOL_LARGE_SIZE,
+	};
+	const unsigned int class_count[IOT_MQTT_CHUNK_POOL_CLASS_MAX] = {
+		IOT_MQTT_CHUNK_POOL_SMALL_COUNT,
+		IOT_MQTT_CHUNK_POOL_MEDIUM_COUNT,
+		IOT_MQTT_CHUNK_POOL_LARGE_COUNT,
+	};
+	iot_mqtt_chunk_pool_t *pool;
+	int i;
+
+	pool = iot_os_malloc(sizeof(iot_mqtt_chunk_pool_t));
+	if (pool == NULL) {
+		IOT_ERROR("pool malloc fail");
+		return NULL;
+	}
+	memset(pool, '\0', sizeof(iot_mqtt_chunk_pool_t));
+
+	iot_os_mutex_init(&pool->lock);
+	if (pool->lock.sem == NULL) {
+		IOT_ERROR("fail to init pool lock");
+		goto error_handle;
+	}
+
+	if (_iot_mqtt_chunk_slab_init(&pool->header_slab, sizeof(iot_mqtt_packet_chunk_t),
+			IOT_MQTT_CHUNK_POOL_HEADER_COUNT)) {
+		goto error_handle;
+	}
+
+	for (i = 0; i < IOT_MQTT_CHUNK_POOL_CLASS_MAX; i++) {
+		if (_iot_mqtt_chunk_slab_init(&pool->data_slab[i], class_size[i], class_count[i])) {
+			goto error_handle;
+		}
+	}
+	pool->refs = 1;
+
+	return pool;
+
+error_handle:
+	_iot_mqtt_chunk_pool_destroy(pool);
+	return NULL;
+}
+
+void iot_mqtt_chunk_pool_release(iot_mqtt_chunk_pool_t *pool)
+{
+	unsigned int refs;
+
+	if (pool == NULL) {
+		return;
+	}
+
+	while (iot_os_mutex_lock(&pool->lock) != IOT_OS_TRUE);
+	refs = --pool->refs;
+	if (refs) {
+		IOT_DEBUG("chunk pool outlives client by %u chunks", pool->in_use);
+	}
+	iot_os_mutex_unlock(&pool->lock);
+
+	if (refs == 0) {
+		_iot_mqtt_chunk_pool_destroy(pool);
+	}
+}
+
+iot_mqtt_packet_chunk_t *iot_mqtt_chunk_pool_alloc_header(iot_mqtt_chunk_pool_t *pool)
+{
+	iot_mqtt_packet_chunk_t *chunk = NULL;
+
+	if (pool == NULL) {
+		chunk = iot_os_malloc(sizeof(iot_mqtt_packet_chunk_t));
+		goto exit;
+	}
+
+	if ((iot_os_mutex_lock(&pool->lock)) != IOT_OS_TRUE) {
+		IOT_ERROR("fail to lock chunk pool");
+		return NULL;
+	}
+
+	chunk = _iot_mqtt_chunk_slab_get(&pool->header_slab);
+	if (chunk) {
+		pool->header_hits++;
+	} else {
+		chunk = iot_os_malloc(sizeof(iot_mqtt_packet_chunk_t));
+		if (chunk) {
+			pool->header_misses++;
+		}
+	}
+	if (chunk) {
+		pool->refs++;
+		pool->in_use++;
+		if (pool->in_use > pool->high_water) {
+			pool->high_water = pool->in_use;
+		}
+	}
+	iot_os_mutex_unlock(&pool->lock);
+
+exit:
+	if (chunk) {
+		memset(chunk, '\0', sizeof(iot_mqtt_packet_chunk_t));
+	}
+	return chunk;
+}
+
+void iot_mqtt_chunk_pool_free_header(iot_mqtt_chunk_pool_t *pool, iot_mqtt_packet_chunk_t *chunk)
+{
+	unsigned int refs;
+
+	if (chunk == NULL) {
+		return;
+	}
+
+	if (pool == NULL) {
+		iot_os_free(chunk);
+		return;
+	}
+
+	while (iot_os_mutex_lock(&pool->lock) != IOT_OS_TRUE);
+	if (_iot_mqtt_chunk_slab_owns(&pool->header_slab, chunk)) {
+		_iot_mqtt_chunk_slab_put(&pool->header_slab, chunk);
+	} else {
+		iot_os_free(chunk);
+	}
+	if (pool->in_use) {
+		pool->in_use--;
+	}
+	refs = --pool->refs;
+	iot_os_mutex_unlock(&pool->lock);
+
+	if (refs == 0) {
+		_iot_mqtt_chunk_pool_destroy(pool);
+	}
+}
+
+unsigned char *iot_mqtt_chunk_pool_alloc_data(iot_mqtt_chunk_pool_t *pool, size_t size)
+{
+	unsigned char *data = NULL;
+	int i;
+
+	if (size == 0) {
+		return NULL;
+	}
+
+	if (pool == NULL) {
+		return iot_os_malloc(size);
+	}
+
+	if ((iot_os_mutex_lock(&pool->lock)) != IOT_OS_TRUE) {
+		IOT_ERROR("fail to lock chunk pool");
+		return NULL;
+	}
+
+	for (i = 0; i < IOT_MQTT_CHUNK_POOL_CLASS_MAX; i++) {
+		if (size <= pool->data_slab[i].block_size) {
+			data = _iot_mqtt_chunk_slab_get(&pool->data_slab[i]);
+			if (data) {
+				break;
+			}
+		}
+	}
+
+	if (data) {
+		pool->data_hits++;
+	} else {
+		data = iot_os_malloc(size);
+		if (data) {
+			pool->data_misses++;
+		}
+	}
+	if (data) {
+		pool->data_in_use++;
+		if (pool->data_in_use > pool->data_high_water) {
+			pool->data_high_water = pool->data_in_use;
+		}
+	}
+	iot_os_mutex_unlock(&pool->lock);
+
+	return data;
+}
+
+void iot_mqtt_chunk_pool_free_data(iot_mqtt_chunk_pool_t *pool, unsigned char *data)
+{
+	int i;
+
+	if (data == NULL) {
+		return;
+	}
+
+	if (pool == NULL) {
+		iot_os_free(data);
+		return;
+	}
+
+	while (iot_os_mutex_lock(&pool->lock) != IOT_OS_TRUE);
+	for (i = 0; i < IOT_MQTT_CHUNK_POOL_CLASS_MAX; i++) {
+		if (_iot_mqtt_chunk_slab_owns(&pool->data_slab[i], data)) {
+			_iot_mqtt_chunk_slab_put(&pool->data_slab[i], data);
+			break;
+		}
+	}
+	if (i == IOT_MQTT_CHUNK_POOL_CLASS_MAX) {
+		iot_os_free(data);
+	}
+	if (pool->data_in_use) {
+		pool->data_in_use--;
+	}
+	iot_os_mutex_unlock(&pool->lock);
+}
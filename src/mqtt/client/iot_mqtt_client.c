@@ -26,13 +26,14 @@
 #include "port_net.h"
 
 static void _iot_mqtt_pending_work(struct iot_context *ctx, device_work_param param);
+static void _iot_mqtt_chunk_destroy(iot_mqtt_packet_chunk_t *chunk);
 
-static int _iot_mqtt_signal_pending_work(MQTTClient *client)
+static int _iot_mqtt_queue_work(MQTTClient *client, device_work_handler handler)
 {
 	device_work_data_t work;
 	iot_error_t err;
 
-	work.handler = _iot_mqtt_pending_work;
+	work.handler = handler;
 	work.param = (device_work_param)client;
 	work.owner_id = client;
 
@@ -47,14 +48,36 @@ static int _iot_mqtt_signal_pending_work(MQTTClient *client)
 	return IOT_ERROR_NONE;
 }
 
-static int _iot_mqtt_write_net(PORT_NET_CONTEXT net_ctx, unsigned char *buf, int len)
+static int _iot_mqtt_signal_pending_work(MQTTClient *client)
+{
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	bool woken = false;
+
+	/* Connected client runs its works on poller thread */
+	if ((iot_os_mutex_lock(&client->client_manage_lock)) == IOT_OS_TRUE) {
+		if (client->socket_watch) {
+			iot_executor_wake_socket(client->socket_watch);
+			woken = true;
+		}
+		iot_os_mutex_unlock(&client->client_manage_lock);
+	}
+	if (woken) {
+		return IOT_ERROR_NONE;
+	}
+#endif
+
+	return _iot_mqtt_queue_work(client, _iot_mqtt_pending_work);
+}
+
+static int _iot_mqtt_write_net(MQTTClient *client, unsigned char *buf, int len)
 {
 	int sentLen = 0, ret = 0;
 
 	IOT_DEBUG("%d@%p", len, buf);
 
 	do {
-		ret = port_net_write(net_ctx, buf + sentLen, (size_t)len - sentLen);
+		ret = port_net_write(client->net_ctx, buf + sentLen, (size_t)len - sentLen);
+		client->write_stats.writes++;
 
 		if(ret >= 0) {
 			sentLen += ret;
@@ -104,8 +127,27 @@ static void _iot_mqtt_close_net(MQTTClient *client)
 	} while ((iot_os_mutex_lock(&client->write_lock)) != IOT_OS_TRUE);
 	if (client->isconnected) {
 		client->isconnected = 0;
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+		if ((iot_os_mutex_lock(&client->client_manage_lock)) == IOT_OS_TRUE) {
+			iot_executor_unwatch_socket(client->socket_watch);
+			client->socket_watch = NULL;
+			iot_os_mutex_unlock(&client->client_manage_lock);
+		}
+#endif
 		port_net_close(client->net_ctx);
 	}
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	if (client->read_partial) {
+		_iot_mqtt_chunk_destroy(client->read_partial);
+		client->read_partial = NULL;
+	}
+	/* Unsent packet is sent from the start or failed like queued ones */
+	client->write_offset = 0;
+	if (client->write_blocked) {
+		client->write_blocked = 0;
+		iot_os_eventgroup_set_bits(client->write_event, MQTT_WRITE_UNBLOCKED_SIGNAL);
+	}
+#endif
 	iot_os_mutex_unlock(&client->write_lock);
 	iot_os_mutex_unlock(&client->read_lock);
 
@@ -144,6 +186,20 @@ static int _iot_mqtt_connect_net(MQTTClient *client, st_mqtt_broker_info_t *brok
 		goto exit;
 	}
 
+	if((iot_os_mutex_lock(&client->client_manage_lock)) == IOT_OS_TRUE) {
+		port_net_connect_stats net_stats;
+
+		memset(&client->connect_stats, '\0', sizeof(client->connect_stats));
+		if (!port_net_get_connect_stats(client->net_ctx, &net_stats)) {
+			client->connect_stats.dns_ms = net_stats.dns_ms;
+			client->connect_stats.tcp_ms = net_stats.tcp_ms;
+			client->connect_stats.handshake_ms = net_stats.handshake_ms;
+			client->connect_stats.session_offered = net_stats.session_offered;
+		}
+		iot_os_mutex_unlock(&client->client_manage_lock);
+	}
+
+	iot_mqtt_reader_reset(&client->reader);
 	client->isconnected = 1;
 
 exit:
@@ -155,34 +211,33 @@ exit:
 
 static void _iot_mqtt_chunk_destroy(iot_mqtt_packet_chunk_t *chunk)
 {
-	if (chunk && chunk->chunk_data) {
-		iot_os_free(chunk->chunk_data);
-	}
-
-	if (chunk && chunk->expiry_time) {
-		iot_os_timer_delete(chunk->expiry_time);
+	if (chunk && chunk->reader) {
+		iot_mqtt_reader_release(chunk->reader);
+	} else if (chunk && chunk->chunk_data) {
+		iot_mqtt_chunk_pool_free_data(chunk->pool, chunk->chunk_data);
 	}
 
 	if (chunk) {
-		iot_os_free(chunk);
+		iot_mqtt_chunk_pool_free_header(chunk->pool, chunk);
 	}
 }
 
-static iot_mqtt_packet_chunk_t * _iot_mqtt_chunk_create(size_t chunk_size)
+static iot_mqtt_packet_chunk_t * _iot_mqtt_chunk_create(MQTTClient *client, size_t chunk_size)
 {
 	iot_mqtt_packet_chunk_t *chunk = NULL;
+	iot_mqtt_chunk_pool_t *pool = client ? client->chunk_pool : NULL;
 
-	chunk = iot_os_malloc(sizeof(iot_mqtt_packet_chunk_t));
+	chunk = iot_mqtt_chunk_pool_alloc_header(pool);
 	if (chunk == NULL) {
 		IOT_ERROR("chunk malloc fail");
 		return NULL;
 	}
-	memset(chunk, '\0', sizeof(iot_mqtt_packet_chunk_t));
+	chunk->pool = pool;
 
-	chunk->chunk_data = iot_os_malloc(chunk_size);
+	chunk->chunk_data = iot_mqtt_chunk_pool_alloc_data(pool, chunk_size);
 	if (chunk_size != 0 && chunk->chunk_data == NULL) {
 		IOT_ERROR("chunk data malloc fail");
-		iot_os_free(chunk);
+		iot_mqtt_chunk_pool_free_header(pool, chunk);
 		return NULL;
 	}
 	chunk->chunk_size = chunk_size;
@@ -190,18 +245,44 @@ static iot_mqtt_packet_chunk_t * _iot_mqtt_chunk_create(size_t chunk_size)
 	return chunk;
 }
 
+static void _iot_mqtt_queue_unlink(iot_mqtt_packet_chunk_queue_t *queue, iot_mqtt_packet_chunk_t *chunk)
+{
+	if (chunk->prev) {
+		chunk->prev->next = chunk->next;
+	} else {
+		queue->head = chunk->next;
+	}
+	if (chunk->next) {
+		chunk->next->prev = chunk->prev;
+	} else {
+		queue->tail = chunk->prev;
+	}
+	chunk->next = chunk->prev = NULL;
+
+	if (queue->index) {
+		iot_mqtt_inflight_remove(queue->index, chunk);
+	}
+}
+
 static int _iot_mqtt_queue_push(iot_mqtt_packet_chunk_queue_t *queue, iot_mqtt_packet_chunk_t *chunk)
 {
 	if((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE)
 		return -1;
 
+	chunk->next = NULL;
 	if (queue->head == NULL || queue->tail == NULL) {
+		chunk->prev = NULL;
 		queue->head = queue->tail = chunk;
 	} else {
+		chunk->prev = queue->tail;
 		queue->tail->next = chunk;
 		queue->tail = chunk;
 	}
 
+	if (queue->index) {
+		iot_mqtt_inflight_add(queue->index, chunk);
+	}
+
 	iot_os_mutex_unlock(&queue->lock);
 
 	return 0;
@@ -210,39 +291,26 @@ static int _iot_mqtt_queue_push(iot_mqtt_packet_chunk_queue_t *queue, iot_mqtt_p
 static iot_mqtt_packet_chunk_t* _iot_mqtt_queue_pop_by_type_and_id(iot_mqtt_packet_chunk_queue_t *queue,
 								int packet_type, unsigned int packet_id)
 {
-	iot_mqtt_packet_chunk_t *chunk = NULL, *iterator = NULL;
+	iot_mqtt_packet_chunk_t *chunk = NULL;
 
 	if((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE)
 		return NULL;
 
-	if (queue->head == NULL || queue->tail == NULL) {
-		chunk = NULL;
-	} else if (queue->head == queue->tail) {
-		if (queue->head->packet_type == packet_type && queue->head->packet_id == packet_id) {
-			chunk = queue->head;
-			queue->head = queue->tail = NULL;
-		}
+	if (queue->index) {
+		chunk = iot_mqtt_inflight_find(queue->index, packet_type, packet_id);
 	} else {
-		if (queue->head->packet_type == packet_type && queue->head->packet_id == packet_id) {
-			chunk = queue->head;
-			queue->head = queue->head->next;
-			chunk->next = NULL;
-		} else {
-			iterator = queue->head;
-			while (iterator->next) {
-				if (iterator->next->packet_type == packet_type && iterator->next->packet_id == packet_id) {
-					if (iterator->next == queue->tail)
-						queue->tail = iterator;
-					chunk = iterator->next;
-					iterator->next = iterator->next->next;
-					chunk->next = NULL;
-					break;
-				}
-				iterator = iterator->next;
-			}
+		chunk = queue->head;
+		while (chunk) {
+			if (chunk->packet_type == packet_type && chunk->packet_id == packet_id)
+				break;
+			chunk = chunk->next;
 		}
 	}
 
+	if (chunk) {
+		_iot_mqtt_queue_unlink(queue, chunk);
+	}
+
 	iot_os_mutex_unlock(&queue->lock);
 
 	return chunk;
@@ -250,39 +318,28 @@ static iot_mqtt_packet_chunk_t* _iot_mqtt_queue_pop_by_type_and_id(iot_mqtt_pack
 
 static iot_mqtt_packet_chunk_t* _iot_mqtt_queue_pop_by_expiry(iot_mqtt_packet_chunk_queue_t *queue)
 {
-	iot_mqtt_packet_chunk_t *chunk = NULL, *iterator = NULL;
+	iot_mqtt_packet_chunk_t *chunk = NULL;
 
 	if((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE)
 		return NULL;
 
-	if (queue->head == NULL || queue->tail == NULL) {
-		chunk = NULL;
-	} else if (queue->head == queue->tail) {
-		if (queue->head->expiry_time && !iot_os_timer_is_active(queue->head->expiry_time)) {
-			chunk = queue->head;
-			queue->head = queue->tail = NULL;
-		}
+	if (queue->index) {
+		chunk = iot_mqtt_inflight_find_expired(queue->index, iot_os_get_tick_ms());
 	} else {
-		if (queue->head->expiry_time && !iot_os_timer_is_active(queue->head->expiry_time)) {
-			chunk = queue->head;
-			queue->head = queue->head->next;
-			chunk->next = NULL;
-		} else {
-			iterator = queue->head;
-			while (iterator->next) {
-				if (iterator->next->expiry_time && !iot_os_timer_is_active(iterator->next->expiry_time)) {
-					if (iterator->next == queue->tail)
-						queue->tail = iterator;
-					chunk = iterator->next;
-					iterator->next = iterator->next->next;
-					chunk->next = NULL;
-					break;
-				}
-				iterator = iterator->next;
-			}
+		unsigned int now = iot_os_get_tick_ms();
+
+		chunk = queue->head;
+		while (chunk) {
+			if ((int)(now - chunk->deadline) >= 0)
+				break;
+			chunk = chunk->next;
 		}
 	}
 
+	if (chunk) {
+		_iot_mqtt_queue_unlink(queue, chunk);
+	}
+
 	iot_os_mutex_unlock(&queue->lock);
 
 	return chunk;
@@ -295,15 +352,28 @@ static iot_mqtt_packet_chunk_t* _iot_mqtt_queue_pop(iot_mqtt_packet_chunk_queue_
 	if((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE)
 		return NULL;
 
-	if (queue->head == NULL || queue->tail == NULL) {
-		chunk = NULL;
-	} else if (queue->head == queue->tail) {
-		chunk = queue->head;
-		queue->head = queue->tail = NULL;
+	chunk = queue->head;
+	if (chunk) {
+		_iot_mqtt_queue_unlink(queue, chunk);
+	}
+
+	iot_os_mutex_unlock(&queue->lock);
+
+	return chunk;
+}
+
+static iot_mqtt_packet_chunk_t* _iot_mqtt_queue_pop_if_fits(iot_mqtt_packet_chunk_queue_t *queue, size_t max_size)
+{
+	iot_mqtt_packet_chunk_t *chunk = NULL;
+
+	if((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE)
+		return NULL;
+
+	chunk = queue->head;
+	if (chunk && chunk->chunk_size <= max_size) {
+		_iot_mqtt_queue_unlink(queue, chunk);
 	} else {
-		chunk = queue->head;
-		queue->head = queue->head->next;
-		chunk->next = NULL;
+		chunk = NULL;
 	}
 
 	iot_os_mutex_unlock(&queue->lock);
@@ -311,7 +381,7 @@ static iot_mqtt_packet_chunk_t* _iot_mqtt_queue_pop(iot_mqtt_packet_chunk_queue_
 	return chunk;
 }
 
-static int _iot_mqtt_queue_init(iot_mqtt_packet_chunk_queue_t *queue)
+static int _iot_mqtt_queue_init(iot_mqtt_packet_chunk_queue_t *queue, iot_mqtt_inflight_t *index)
 {
 	iot_os_mutex_init(&queue->lock);
 	if (queue->lock.sem == NULL) {
@@ -320,6 +390,10 @@ static int _iot_mqtt_queue_init(iot_mqtt_packet_chunk_queue_t *queue)
 	}
 	queue->head = NULL;
 	queue->tail = NULL;
+	queue->index = index;
+	if (index) {
+		iot_mqtt_inflight_init(index, iot_os_get_tick_ms());
+	}
 
 	return 0;
 }
@@ -335,13 +409,16 @@ static void _iot_mqtt_queue_destroy(iot_mqtt_packet_chunk_queue_t *queue)
 		tmp = iterator;
 		iterator = iterator->next;
 		if (tmp->have_owner) {
-			tmp->next = NULL;
+			tmp->next = tmp->prev = NULL;
 			tmp->chunk_state = PACKET_CHUNK_QUEUE_DESTROYED;
 		} else {
 			_iot_mqtt_chunk_destroy(tmp);
 		}
 	}
 	queue->head = queue->tail = NULL;
+	if (queue->index) {
+		iot_mqtt_inflight_init(queue->index, iot_os_get_tick_ms());
+	}
 	iot_os_mutex_unlock(&queue->lock);
 
 	if (queue->lock.sem != NULL) {
@@ -350,7 +427,7 @@ static void _iot_mqtt_queue_destroy(iot_mqtt_packet_chunk_queue_t *queue)
 	}
 }
 
-static void _iot_mqtt_chunk_expire_timeout(iot_os_timer_handle handle, void *user_data)
+static void _iot_mqtt_retry_timeout(iot_os_timer_handle handle, void *user_data)
 {
 	MQTTClient *client = (MQTTClient *)user_data;
 	IOT_INFO("Timeout");
@@ -360,21 +437,68 @@ static void _iot_mqtt_chunk_expire_timeout(iot_os_timer_handle handle, void *use
 	}
 }
 
+static void _iot_mqtt_retry_timer_arm(MQTTClient *client, unsigned int deadline)
+{
+	unsigned int now = iot_os_get_tick_ms();
+	unsigned int wait_ms = 1;
+
+	if ((int)(deadline - now) > 0) {
+		wait_ms = deadline - now;
+	}
+	if (iot_os_timer_change_period(client->retry_timer, wait_ms)) {
+		IOT_ERROR("Failed to arm retry timer");
+		return;
+	}
+	client->retry_deadline = deadline;
+}
+
+/* Wake up earlier only if new deadline comes before the armed one */
+static void _iot_mqtt_retry_timer_update(MQTTClient *client, unsigned int deadline)
+{
+	if (client->retry_timer == NULL)
+		return;
+
+	if((iot_os_mutex_lock(&client->ack_pending_queue.lock)) != IOT_OS_TRUE)
+		return;
+
+	if (!iot_os_timer_is_active(client->retry_timer) ||
+			(int)(deadline - client->retry_deadline) < 0) {
+		_iot_mqtt_retry_timer_arm(client, deadline);
+	}
+
+	iot_os_mutex_unlock(&client->ack_pending_queue.lock);
+}
+
+/* Re-arm single wake-up timer to the earliest remaining deadline */
+static void _iot_mqtt_retry_timer_refresh(MQTTClient *client)
+{
+	unsigned int deadline;
+
+	if (client->retry_timer == NULL)
+		return;
+
+	if((iot_os_mutex_lock(&client->ack_pending_queue.lock)) != IOT_OS_TRUE)
+		return;
+
+	if (iot_mqtt_inflight_next_deadline(&client->ack_inflight, &deadline)) {
+		if (iot_os_timer_is_active(client->retry_timer)) {
+			iot_os_timer_stop(client->retry_timer);
+		}
+	} else if (!iot_os_timer_is_active(client->retry_timer) || deadline != client->retry_deadline) {
+		_iot_mqtt_retry_timer_arm(client, deadline);
+	}
+
+	iot_os_mutex_unlock(&client->ack_pending_queue.lock);
+}
+
 static void _iot_mqtt_process_post_write(MQTTClient *client, iot_mqtt_packet_chunk_t *chunk)
 {
 	switch(chunk->packet_type) {
 		case CONNECT:
 			chunk->chunk_state = PACKET_CHUNK_ACK_PENDING;
-			if (chunk->expiry_time) {
-				iot_os_timer_delete(chunk->expiry_time);
-			}
-			chunk->expiry_time = iot_os_timer_create(_iot_mqtt_chunk_expire_timeout, MQTT_CONNECT_TIMEOUT, client);
-			if (!chunk->expiry_time) {
-				IOT_ERROR("Failed to create expiry timer");
-			} else {
-				iot_os_timer_start(chunk->expiry_time);
-			}
+			chunk->deadline = iot_os_get_tick_ms() + MQTT_CONNECT_TIMEOUT;
 			_iot_mqtt_queue_push(&client->ack_pending_queue, chunk);
+			_iot_mqtt_retry_timer_update(client, chunk->deadline);
 			break;
 		case SUBSCRIBE:
 		case UNSUBSCRIBE:
@@ -382,16 +506,9 @@ static void _iot_mqtt_process_post_write(MQTTClient *client, iot_mqtt_packet_chu
 		case PUBREC:
 		case PINGREQ:
 			chunk->chunk_state = PACKET_CHUNK_ACK_PENDING;
-			if (chunk->expiry_time) {
-				iot_os_timer_delete(chunk->expiry_time);
-			}
-			chunk->expiry_time = iot_os_timer_create(_iot_mqtt_chunk_expire_timeout, MQTT_RETRY_TIMEOUT, client);
-			if (!chunk->expiry_time) {
-				IOT_ERROR("Failed to create expiry timer");
-			} else {
-				iot_os_timer_start(chunk->expiry_time);
-			}
+			chunk->deadline = iot_os_get_tick_ms() + MQTT_RETRY_TIMEOUT;
 			_iot_mqtt_queue_push(&client->ack_pending_queue, chunk);
+			_iot_mqtt_retry_timer_update(client, chunk->deadline);
 			break;
 		case PUBLISH:
 			if (chunk->qos == 0) {
@@ -401,16 +518,9 @@ static void _iot_mqtt_process_post_write(MQTTClient *client, iot_mqtt_packet_chu
 				}
 			} else {
 				chunk->chunk_state = PACKET_CHUNK_ACK_PENDING;
-				if (chunk->expiry_time) {
-					iot_os_timer_delete(chunk->expiry_time);
-				}
-				chunk->expiry_time = iot_os_timer_create(_iot_mqtt_chunk_expire_timeout, MQTT_RETRY_TIMEOUT, client);
-				if (!chunk->expiry_time) {
-					IOT_ERROR("Failed to create expiry timer");
-				} else {
-					iot_os_timer_start(chunk->expiry_time);
-				}
+				chunk->deadline = iot_os_get_tick_ms() + MQTT_RETRY_TIMEOUT;
 				_iot_mqtt_queue_push(&client->ack_pending_queue, chunk);
+				_iot_mqtt_retry_timer_update(client, chunk->deadline);
 			}
 			break;
 		case DISCONNECT:
@@ -426,10 +536,59 @@ static void _iot_mqtt_process_post_write(MQTTClient *client, iot_mqtt_packet_chu
 	}
 }
 
+/* Take the head packet and following ones which fit in write buffer together */
+static int _iot_mqtt_collect_write_batch(MQTTClient *client)
+{
+	iot_mqtt_packet_chunk_t *chunk;
+	size_t len;
+	int i;
+
+	chunk = _iot_mqtt_queue_pop(&client->write_pending_queue);
+	if (chunk == NULL) {
+		return 0;
+	}
+	client->write_batch[0] = chunk;
+	client->write_batch_count = 1;
+	len = chunk->chunk_size;
+
+	if (client->write_buf == NULL || len > IOT_MQTT_WRITE_BUFFER_SIZE) {
+		client->write_len = len;
+		return 1;
+	}
+
+	while (client->write_batch_count < IOT_MQTT_WRITE_BATCH) {
+		chunk = _iot_mqtt_queue_pop_if_fits(&client->write_pending_queue,
+				IOT_MQTT_WRITE_BUFFER_SIZE - len);
+		if (chunk == NULL) {
+			break;
+		}
+		client->write_batch[client->write_batch_count++] = chunk;
+		len += chunk->chunk_size;
+	}
+
+	/* Single packet is written from its own memory */
+	if (client->write_batch_count > 1) {
+		len = 0;
+		for (i = 0; i < client->write_batch_count; i++) {
+			chunk = client->write_batch[i];
+			memcpy(client->write_buf + len, chunk->chunk_data, chunk->chunk_size);
+			len += chunk->chunk_size;
+		}
+	}
+	client->write_len = len;
+
+	return client->write_batch_count;
+}
+
 static int _iot_mqtt_run_write_stream(MQTTClient *client)
 {
-	int rc = 0, written = 0;
-	iot_mqtt_packet_chunk_t *w_chunk = NULL;
+	int rc = 0, written = 0, i;
+	int batch_count = 0;
+	iot_mqtt_packet_chunk_t *w_batch[IOT_MQTT_WRITE_BATCH];
+	unsigned char *w_data;
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	bool unblocked = false;
+#endif
 
 	if (client == NULL || client->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER) {
 		return E_ST_MQTT_FAILURE;
@@ -439,8 +598,15 @@ static int _iot_mqtt_run_write_stream(MQTTClient *client)
 		return 0;
 	}
 
-	w_chunk = _iot_mqtt_queue_pop(&client->write_pending_queue);
-	if (w_chunk == NULL) {
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	unblocked = client->write_blocked;
+	client->write_blocked = 0;
+	if (client->write_batch_count > 0) {
+		written = client->write_offset;
+		client->write_offset = 0;
+	} else
+#endif
+	if (_iot_mqtt_collect_write_batch(client) == 0) {
 		goto exit;
 	}
 
@@ -449,9 +615,25 @@ static int _iot_mqtt_run_write_stream(MQTTClient *client)
 		goto exit;
 	}
 
-	while (written != w_chunk->chunk_size) {
-		rc = _iot_mqtt_write_net(client->net_ctx, &w_chunk->chunk_data[written],
-				w_chunk->chunk_size - written);
+	w_data = (client->write_batch_count > 1) ?
+			client->write_buf : client->write_batch[0]->chunk_data;
+
+	while (written != client->write_len) {
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+		rc = port_net_write(client->net_ctx, &w_data[written],
+				client->write_len - written);
+		client->write_stats.writes++;
+		if (rc == 0) {
+			/* Socket is full, resume from here when it gets writable */
+			client->write_offset = written;
+			client->write_blocked = 1;
+			written = 0;
+			goto exit;
+		}
+#else
+		rc = _iot_mqtt_write_net(client, &w_data[written],
+				client->write_len - written);
+#endif
 
 		if (rc > 0) {
 			written += rc;
@@ -460,21 +642,36 @@ static int _iot_mqtt_run_write_stream(MQTTClient *client)
 		}
 	}
 
-	if (written == w_chunk->chunk_size) {
-		_iot_mqtt_process_post_write(client, w_chunk);
-		w_chunk = NULL;
+	if (written == client->write_len) {
+		client->write_stats.packets += client->write_batch_count;
+		client->write_stats.records++;
+		client->write_stats.bytes += written;
+		for (i = 0; i < client->write_batch_count; i++) {
+			_iot_mqtt_process_post_write(client, client->write_batch[i]);
+		}
+		client->write_batch_count = 0;
 	} else {
 		written = E_ST_MQTT_NETWORK_ERROR;
 	}
 
 exit:
+	if (written < 0) {
+		batch_count = client->write_batch_count;
+		memcpy(w_batch, client->write_batch, sizeof(w_batch[0]) * batch_count);
+		client->write_batch_count = 0;
+	}
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	if (unblocked && !client->write_blocked) {
+		iot_os_eventgroup_set_bits(client->write_event, MQTT_WRITE_UNBLOCKED_SIGNAL);
+	}
+#endif
 	iot_os_mutex_unlock(&client->write_lock);
 
-	if (written < 0 && w_chunk != NULL) {
-		w_chunk->chunk_state = PACKET_CHUNK_WRITE_FAIL;
-		w_chunk->return_code = written;
-		if (!w_chunk->have_owner) {
-			_iot_mqtt_queue_push(&client->user_event_callback_queue, w_chunk);
+	for (i = 0; i < batch_count; i++) {
+		w_batch[i]->chunk_state = PACKET_CHUNK_WRITE_FAIL;
+		w_batch[i]->return_code = written;
+		if (!w_batch[i]->have_owner) {
+			_iot_mqtt_queue_push(&client->user_event_callback_queue, w_batch[i]);
 		}
 	}
 
@@ -490,7 +687,7 @@ exit:
 	if (written == E_ST_MQTT_NETWORK_ERROR) {
 		iot_mqtt_packet_chunk_t *event_chunk = NULL;
 		_iot_mqtt_close_net(client);
-		event_chunk = _iot_mqtt_chunk_create(0);
+		event_chunk = _iot_mqtt_chunk_create(client, 0);
 		if (event_chunk != NULL) {
 			event_chunk->chunk_state = EVENT_CHUNK_DISCONNECTED;
 			event_chunk->return_code = MQTT_DISCONNECTED_NETWORK_ERROR;
@@ -570,10 +767,6 @@ static void _iot_mqtt_process_received_ack(MQTTClient *client, iot_mqtt_packet_c
 
 		if (tmp->have_owner) {
 			tmp->chunk_state = PACKET_CHUNK_ACKNOWLEDGED;
-			if (tmp->expiry_time) {
-				iot_os_timer_delete(tmp->expiry_time);
-				tmp->expiry_time = NULL;
-			}
 		} else {
 			_iot_mqtt_chunk_destroy(tmp);
 		}
@@ -588,7 +781,7 @@ static void _iot_mqtt_process_received_publish(MQTTClient *client, iot_mqtt_pack
 	// Send Ack back
 	if (chunk->qos != st_mqtt_qos0) {
 		iot_mqtt_packet_chunk_t *puback;
-		puback = _iot_mqtt_chunk_create(MQTT_ACK_PACKET_SIZE);
+		puback = _iot_mqtt_chunk_create(client, MQTT_ACK_PACKET_SIZE);
 		if (puback == NULL) {
 			IOT_ERROR("chunk malloc fail");
 			_iot_mqtt_chunk_destroy(chunk);
@@ -630,11 +823,11 @@ static void _iot_mqtt_process_received_pubrec_pubrel(MQTTClient *client, iot_mqt
 
 	// Recycling packet
 	if (tmp != NULL) {
-		iot_os_free(tmp->chunk_data);
+		iot_mqtt_chunk_pool_free_data(tmp->pool, tmp->chunk_data);
 		tmp->chunk_data = NULL;
 
 		tmp->chunk_size = MQTT_ACK_PACKET_SIZE;
-		tmp->chunk_data = iot_os_malloc(tmp->chunk_size);
+		tmp->chunk_data = iot_mqtt_chunk_pool_alloc_data(tmp->pool, tmp->chunk_size);
 		if (tmp->chunk_data == NULL) {
 			IOT_ERROR("chunk data malloc fail");
 			_iot_mqtt_chunk_destroy(tmp);
@@ -679,12 +872,23 @@ static void _iot_mqtt_process_post_read(MQTTClient *client, iot_mqtt_packet_chun
 	}
 }
 
+static int _iot_mqtt_read_byte(MQTTClient *client, unsigned char *byte)
+{
+	if (iot_mqtt_reader_take(&client->reader, byte, 1) == 1) {
+		return 1;
+	}
+	return _iot_mqtt_read_net(client->net_ctx, byte, 1);
+}
+
 static int _iot_mqtt_run_read_stream(MQTTClient *client)
 {
 	int rc = 0 , read = 0;
 	iot_mqtt_packet_chunk_t *w_chunk = NULL;
+	iot_mqtt_reader_t *reader;
 	unsigned char packet_fixed_header[MAX_NUM_OF_REMAINING_LENGTH_BYTES + 1];
 	int rem_size = 0, multiplier = 1;
+	size_t packet_len = 0;
+	bool in_place = false;
 
 	if (client == NULL || client->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER) {
 		return E_ST_MQTT_FAILURE;
@@ -697,47 +901,125 @@ static int _iot_mqtt_run_read_stream(MQTTClient *client)
 		read = E_ST_MQTT_DISCONNECTED;
 		goto exit;
 	}
+	reader = &client->reader;
 
-	rc = port_net_read_poll(client->net_ctx, 0);
-	if (rc < 0) {
-		read = E_ST_MQTT_NETWORK_ERROR;
-		goto exit;
-	} else if (rc == 0) {
-		goto exit;
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	if (client->read_partial) {
+		w_chunk = client->read_partial;
+		read = client->read_offset;
+		client->read_partial = NULL;
+		goto read_body;
 	}
+#endif
 
-	rc = _iot_mqtt_read_net(client->net_ctx, &packet_fixed_header[0], 1);
-	if (rc <= 0) {
+	rc = iot_mqtt_reader_frame(reader, &packet_len);
+	if (rc == 0 && reader->head == reader->tail) {
+		rc = port_net_read_poll(client->net_ctx, 0);
+		if (rc < 0) {
+			read = E_ST_MQTT_NETWORK_ERROR;
+			goto exit;
+		} else if (rc == 0) {
+			goto exit;
+		}
+		rc = 0;
+	}
+
+	/* Frame packet in place as long as it fits in receive buffer */
+	while (rc == 0) {
+		if (packet_len && !iot_mqtt_reader_can_frame(reader, packet_len)) {
+			break;
+		}
+		rc = iot_mqtt_reader_fill(reader, client->net_ctx, packet_len);
+		if (rc < 0) {
+			read = E_ST_MQTT_NETWORK_ERROR;
+			goto exit;
+		} else if (rc == 0) {
+			if (reader->tail == reader->size) {
+				break;
+			} else if (reader->head == reader->tail) {
+				goto exit;
+			}
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+			/* Rest of frame is not arrived yet, it stays in reader until readable */
+			goto exit;
+#endif
+		}
+		rc = iot_mqtt_reader_frame(reader, &packet_len);
+	}
+	if (rc < 0) {
+		IOT_ERROR("malformed remaining length");
 		read = E_ST_MQTT_NETWORK_ERROR;
 		goto exit;
 	}
-	read++;
-	do {
-		if (read - 1 >= MAX_NUM_OF_REMAINING_LENGTH_BYTES) {
-			read = E_ST_MQTT_NETWORK_ERROR;
+
+	if (rc == 1) {
+		w_chunk = _iot_mqtt_chunk_create(client, 0);
+		if (w_chunk == NULL) {
+			IOT_ERROR("chunk malloc fail");
+			read = E_ST_MQTT_BUFFER_OVERFLOW;
 			goto exit;
 		}
-		rc = _iot_mqtt_read_net(client->net_ctx, &packet_fixed_header[read], 1);
+		w_chunk->chunk_data = iot_mqtt_reader_pin(reader, packet_len);
+		if (w_chunk->chunk_data == NULL) {
+			read = E_ST_MQTT_FAILURE;
+			goto exit;
+		}
+		w_chunk->reader = reader;
+		w_chunk->chunk_size = packet_len;
+		read = packet_len;
+		in_place = true;
+	} else {
+		/* Too large for receive buffer, read into own chunk memory */
+		rc = _iot_mqtt_read_byte(client, &packet_fixed_header[0]);
 		if (rc <= 0) {
 			read = E_ST_MQTT_NETWORK_ERROR;
 			goto exit;
 		}
-		rem_size += (packet_fixed_header[read] & 127) * multiplier;
-		multiplier *= 128;
 		read++;
-	} while ((packet_fixed_header[read - 1] & 128) != 0);
+		do {
+			if (read - 1 >= MAX_NUM_OF_REMAINING_LENGTH_BYTES) {
+				read = E_ST_MQTT_NETWORK_ERROR;
+				goto exit;
+			}
+			rc = _iot_mqtt_read_byte(client, &packet_fixed_header[read]);
+			if (rc <= 0) {
+				read = E_ST_MQTT_NETWORK_ERROR;
+				goto exit;
+			}
+			rem_size += (packet_fixed_header[read] & 127) * multiplier;
+			multiplier *= 128;
+			read++;
+		} while ((packet_fixed_header[read - 1] & 128) != 0);
 
-	w_chunk = _iot_mqtt_chunk_create(read + rem_size);
-	if (w_chunk == NULL) {
-		IOT_ERROR("chunk malloc fail");
-		read = E_ST_MQTT_BUFFER_OVERFLOW;
-		goto exit;
+		w_chunk = _iot_mqtt_chunk_create(client, read + rem_size);
+		if (w_chunk == NULL) {
+			IOT_ERROR("chunk malloc fail");
+			read = E_ST_MQTT_BUFFER_OVERFLOW;
+			goto exit;
+		}
+		memcpy(w_chunk->chunk_data, packet_fixed_header, read);
+		read += iot_mqtt_reader_take(reader, w_chunk->chunk_data + read, w_chunk->chunk_size - read);
 	}
-	memcpy(w_chunk->chunk_data, packet_fixed_header, read);
 
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+read_body:
+#endif
 	while (read != w_chunk->chunk_size) {
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+		rc = port_net_read(client->net_ctx, w_chunk->chunk_data + read,
+				w_chunk->chunk_size - read);
+		if (rc == 0) {
+			/* Rest of packet is not arrived yet, resume from here when readable */
+			client->read_partial = w_chunk;
+			client->read_offset = read;
+			w_chunk = NULL;
+			read = 0;
+			goto exit;
+		}
+#else
 		rc = _iot_mqtt_read_net(client->net_ctx, w_chunk->chunk_data + read,
 				w_chunk->chunk_size - read);
+#endif
 		if (rc < 0) {
 			break;
 		} else {
@@ -746,6 +1028,7 @@ static int _iot_mqtt_run_read_stream(MQTTClient *client)
 	}
 
 	if (read == w_chunk->chunk_size) {
+		iot_mqtt_reader_account(reader, in_place);
 		w_chunk->chunk_state = PACKET_CHUNK_READ_COMPLETED;
 		w_chunk->packet_type = (w_chunk->chunk_data[0] & MQTT_FIXED_HEADER_PACKET_TYPE_MASK) >> MQTT_FIXED_HEADER_PACKET_TYPE_OFFSET;
 		w_chunk->qos = (w_chunk->chunk_data[0] & MQTT_FIXED_HEADER_QOS_MASK) >> MQTT_FIXED_HEADER_QOS_OFFSET;
@@ -777,7 +1060,7 @@ exit:
 	if (read == E_ST_MQTT_NETWORK_ERROR) {
 		iot_mqtt_packet_chunk_t *event_chunk = NULL;
 		_iot_mqtt_close_net(client);
-		event_chunk = _iot_mqtt_chunk_create(0);
+		event_chunk = _iot_mqtt_chunk_create(client, 0);
 		if (event_chunk != NULL) {
 			event_chunk->chunk_state = EVENT_CHUNK_DISCONNECTED;
 			event_chunk->return_code = MQTT_DISCONNECTED_NETWORK_ERROR;
@@ -823,7 +1106,7 @@ exit:
 	if (rc == E_ST_MQTT_PING_TIMEOUT) {
 		iot_mqtt_packet_chunk_t *event_chunk = NULL;
 		_iot_mqtt_close_net(client);
-		event_chunk = _iot_mqtt_chunk_create(0);
+		event_chunk = _iot_mqtt_chunk_create(client, 0);
 		if (event_chunk != NULL) {
 			event_chunk->chunk_state = EVENT_CHUNK_DISCONNECTED;
 			event_chunk->return_code = MQTT_DISCONNECTED_PING_TIMEOUT;
@@ -974,6 +1257,7 @@ static int _iot_mqtt_run_cycle(MQTTClient *client)
 	}
 
 	_iot_mqtt_process_pending_packets(client);
+	_iot_mqtt_retry_timer_refresh(client);
 
 	rc = _iot_mqtt_check_alive(client);
 	if (rc < 0) {
@@ -987,12 +1271,25 @@ static int _iot_mqtt_run_cycle(MQTTClient *client)
 static bool _iot_mqtt_is_pending_work(MQTTClient *client)
 {
 	bool rc = false;
+	bool write_pending;
 
 	if((iot_os_mutex_lock(&client->read_lock)) == IOT_OS_TRUE) {
-		if (client->write_pending_queue.head != NULL) {
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+		/* Blocked write is resumed by socket readiness, not by looping */
+		write_pending = !client->write_blocked &&
+				(client->write_pending_queue.head != NULL || client->write_batch_count > 0);
+#else
+		write_pending = (client->write_pending_queue.head != NULL);
+#endif
+		if (write_pending) {
 			rc = true;
+#if !defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
 		} else if (client->user_event_callback_queue.head != NULL) {
 			rc = true;
+#endif
+		} else if (client->isconnected) {
+			size_t packet_len;
+			rc = (iot_mqtt_reader_frame(&client->reader, &packet_len) == 1);
 		}
 
 		iot_os_mutex_unlock(&client->read_lock);
@@ -1001,6 +1298,7 @@ static bool _iot_mqtt_is_pending_work(MQTTClient *client)
 	return rc;
 }
 
+#if !defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
 static void _iot_mqtt_listen_socket(void *parm)
 {
 	MQTTClient *client = (MQTTClient *)parm;
@@ -1020,6 +1318,68 @@ static void _iot_mqtt_listen_socket(void *parm)
 	client->socket_thread = NULL;
 	iot_os_thread_delete(NULL);
 }
+#else
+static void _iot_mqtt_user_callback_work(struct iot_context *ctx, device_work_param param)
+{
+	MQTTClient *client = (MQTTClient *)param;
+
+	/* Cleared before draining, so callbacks queued from now on get a new work */
+	__atomic_store_n(&client->callback_work_queued, 0, __ATOMIC_SEQ_CST);
+	_iot_mqtt_process_user_callback(client);
+}
+
+/*
+ * User callbacks dispatch commands and notifications to application, so
+ * they run on work queue of the context instead of the shared poller thread.
+ */
+static void _iot_mqtt_schedule_user_callback(MQTTClient *client)
+{
+	bool pending = false;
+
+	if ((iot_os_mutex_lock(&client->user_event_callback_queue.lock)) == IOT_OS_TRUE) {
+		pending = (client->user_event_callback_queue.head != NULL);
+		iot_os_mutex_unlock(&client->user_event_callback_queue.lock);
+	}
+	if (!pending) {
+		return;
+	}
+
+	if (client->work_queue == NULL) {
+		_iot_mqtt_process_user_callback(client);
+		return;
+	}
+
+	if (__atomic_exchange_n(&client->callback_work_queued, 1, __ATOMIC_SEQ_CST)) {
+		return;
+	}
+	if (_iot_mqtt_queue_work(client, _iot_mqtt_user_callback_work) != IOT_ERROR_NONE) {
+		__atomic_store_n(&client->callback_work_queued, 0, __ATOMIC_SEQ_CST);
+	}
+}
+
+/* Runs on poller thread each time socket gets ready or client is woken up */
+static int _iot_mqtt_socket_ready(void *arg)
+{
+	MQTTClient *client = (MQTTClient *)arg;
+	int cycles = 0;
+
+	do {
+		_iot_mqtt_run_cycle(client);
+		_iot_mqtt_schedule_user_callback(client);
+		if (!client->isconnected) {
+			return 0;
+		}
+		if (++cycles == MQTT_REACTOR_MAX_CYCLES) {
+			/* Let other sockets run, then continue */
+			_iot_mqtt_signal_pending_work(client);
+			break;
+		}
+		/* TLS layer may hold decrypted bytes the socket doesn't report */
+	} while (_iot_mqtt_is_pending_work(client) || port_net_read_poll(client->net_ctx, 0) > 0);
+
+	return IOT_EXECUTOR_WAIT_READ | (client->write_blocked ? IOT_EXECUTOR_WAIT_WRITE : 0);
+}
+#endif
 
 static void _iot_mqtt_pending_work(struct iot_context *ctx, device_work_param param)
 {
@@ -1107,21 +1467,45 @@ int st_mqtt_create(st_mqtt_client *client, st_mqtt_event_callback callback_fp, v
 		IOT_ERROR("fail to init read_lock");
 		goto error_handle;
 	}
-	if ((_iot_mqtt_queue_init(&c->write_pending_queue))) {
+	if ((_iot_mqtt_queue_init(&c->write_pending_queue, NULL))) {
+		goto error_handle;
+	}
+	if ((_iot_mqtt_queue_init(&c->ack_pending_queue, &c->ack_inflight))) {
 		goto error_handle;
 	}
-	if ((_iot_mqtt_queue_init(&c->ack_pending_queue))) {
+	if ((_iot_mqtt_queue_init(&c->user_event_callback_queue, NULL))) {
 		goto error_handle;
 	}
-	if ((_iot_mqtt_queue_init(&c->user_event_callback_queue))) {
+	if ((c->chunk_pool = iot_mqtt_chunk_pool_create()) == NULL) {
 		goto error_handle;
 	}
-	if ((c->ping_packet = _iot_mqtt_chunk_create(MQTT_PINGREQ_PACKET_SIZE)) == NULL) {
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	if ((c->write_event = iot_os_eventgroup_create()) == NULL) {
+		IOT_ERROR("fail to create write event");
+		goto error_handle;
+	}
+#endif
+	if ((iot_mqtt_reader_init(&c->reader, IOT_MQTT_READ_BUFFER_SIZE))) {
+		goto error_handle;
+	}
+	if (IOT_MQTT_WRITE_BATCH > 1) {
+		c->write_buf = iot_os_malloc(IOT_MQTT_WRITE_BUFFER_SIZE);
+		if (c->write_buf == NULL) {
+			IOT_ERROR("fail to alloc write buffer");
+			goto error_handle;
+		}
+	}
+	if ((c->ping_packet = _iot_mqtt_chunk_create(c, MQTT_PINGREQ_PACKET_SIZE)) == NULL) {
 		goto error_handle;
 	}
 	MQTTSerialize_pingreq(c->ping_packet->chunk_data, MQTT_PINGREQ_PACKET_SIZE);
 	c->ping_packet->packet_type = PINGREQ;
 	c->ping_packet->have_owner = 1;
+	c->retry_timer = iot_os_timer_create(_iot_mqtt_retry_timeout, MQTT_RETRY_TIMEOUT, c);
+	if (c->retry_timer == NULL) {
+		IOT_ERROR("fail to create retry timer");
+		goto error_handle;
+	}
 	c->work_queue = work_queue;
 	c->work_queue_signal = work_queue_signal;
 
@@ -1137,9 +1521,22 @@ error_handle:
 		_iot_mqtt_queue_destroy(&c->write_pending_queue);
 		_iot_mqtt_queue_destroy(&c->ack_pending_queue);
 		_iot_mqtt_queue_destroy(&c->user_event_callback_queue);
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+		if (c->write_event) {
+			iot_os_eventgroup_delete(c->write_event);
+		}
+#endif
 		if (c->ping_packet) {
 			_iot_mqtt_chunk_destroy(c->ping_packet);
 		}
+		if (c->retry_timer) {
+			iot_os_timer_delete(c->retry_timer);
+		}
+		iot_mqtt_reader_deinit(&c->reader);
+		if (c->write_buf) {
+			iot_os_free(c->write_buf);
+		}
+		iot_mqtt_chunk_pool_release(c->chunk_pool);
 		iot_os_free(c);
 		*client = NULL;
 	}
@@ -1147,44 +1544,17 @@ error_handle:
 	return rc;
 }
 
-static void _iot_mqtt_delete_pending_task(MQTTClient *client)
+static bool _iot_mqtt_is_own_task(void *item, void *arg)
 {
-	iot_util_queue_t *queue = client->work_queue;
-	iot_util_queue_data_t *queue_data_iter, *queue_data_prev;
-
-	if (queue == NULL)
-		return;
-
-	queue_data_iter = queue->head;
-	queue_data_prev = NULL;
+	return ((device_work_data_t *)item)->owner_id == arg;
+}
 
-	if((iot_os_mutex_lock(&queue->lock)) != IOT_OS_TRUE)
+static void _iot_mqtt_delete_pending_task(MQTTClient *client)
+{
+	if (client->work_queue == NULL)
 		return;
 
-	while (queue_data_iter) {
-		if (((device_work_data_t *)(queue_data_iter->data))->owner_id == client) {
-			if (queue->head == queue->tail) {
-				iot_os_free(queue_data_iter->data);
-				iot_os_free(queue_data_iter);
-				queue_data_iter = queue->head = queue->tail = NULL;
-			} else if (queue_data_iter == queue->head) {
-				queue->head = queue->head->next;
-				iot_os_free(queue_data_iter->data);
-				iot_os_free(queue_data_iter);
-				queue_data_iter = queue->head;
-			} else {
-				queue_data_prev->next = queue_data_iter->next;
-				iot_os_free(queue_data_iter->data);
-				iot_os_free(queue_data_iter);
-				queue_data_iter = queue_data_prev->next;
-			}
-		} else {
-			queue_data_prev = queue_data_iter;
-			queue_data_iter = queue_data_iter->next;
-		}
-	}
-
-	iot_os_mutex_unlock(&queue->lock);
+	iot_util_queue_remove_if(client->work_queue, _iot_mqtt_is_own_task, client);
 }
 
 void st_mqtt_destroy(st_mqtt_client client)
@@ -1202,13 +1572,33 @@ void st_mqtt_destroy(st_mqtt_client client)
 		IOT_INFO("Waiting socket thread exit");
 		iot_os_delay(100);
 	}
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	while (iot_executor_is_running(c)) {
+		iot_os_delay(10);
+	}
+#endif
 	_iot_mqtt_delete_pending_task(c);
+	for (int i = 0; i < c->write_batch_count; i++) {
+		if (c->write_batch[i]->have_owner) {
+			c->write_batch[i]->chunk_state = PACKET_CHUNK_QUEUE_DESTROYED;
+		} else {
+			_iot_mqtt_chunk_destroy(c->write_batch[i]);
+		}
+	}
+	c->write_batch_count = 0;
+	if (c->retry_timer) {
+		iot_os_timer_delete(c->retry_timer);
+		c->retry_timer = NULL;
+	}
 	if (c->net_ctx) {
 		port_net_free(c->net_ctx);
 		c->net_ctx = NULL;
 	}
 	iot_os_mutex_destroy(&c->write_lock);
 	iot_os_mutex_destroy(&c->read_lock);
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+	iot_os_eventgroup_delete(c->write_event);
+#endif
 
 	_iot_mqtt_queue_destroy(&c->write_pending_queue);
 	_iot_mqtt_queue_destroy(&c->ack_pending_queue);
@@ -1228,6 +1618,12 @@ void st_mqtt_destroy(st_mqtt_client client)
 	iot_os_mutex_destroy(&c->client_manage_lock);
 
 skip_manage_lock:
+	iot_mqtt_reader_deinit(&c->reader);
+	if (c->write_buf) {
+		iot_os_free(c->write_buf);
+	}
+	/* Chunks still owned by callers keep the pool until they are destroyed */
+	iot_mqtt_chunk_pool_release(c->chunk_pool);
 	iot_os_free(c);
 }
 
@@ -1246,6 +1642,13 @@ static int _iot_mqtt_wait_for(MQTTClient *client, iot_mqtt_packet_chunk_t *chunk
 						goto exit;
 					}
 				}
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+				else if (client->write_blocked) {
+					/* Poller thread resumes it when socket gets writable */
+					iot_os_eventgroup_wait_bits(client->write_event, MQTT_WRITE_UNBLOCKED_SIGNAL,
+							true, MQTT_ACKPENDING_WAITCYCLE_IN_SYNC_FUNCTION);
+				}
+#endif
 				break;
 			case PACKET_CHUNK_ACK_PENDING:
 				if (rc < 0) {
@@ -1294,6 +1697,7 @@ int st_mqtt_connect(st_mqtt_client client, st_mqtt_broker_info_t *broker, st_mqt
 	MQTTPacket_connectData options = MQTTPacket_connectData_initializer;
 	int chunk_size;
 	iot_mqtt_packet_chunk_t *connect_packet = NULL;
+	unsigned int connect_start;
 
 	rc = _iot_mqtt_connect_net(c, broker);
 	if (rc < 0) {
@@ -1317,7 +1721,7 @@ int st_mqtt_connect(st_mqtt_client client, st_mqtt_broker_info_t *broker, st_mqt
 	options.cleansession = connect_data->cleansession;
 
 	chunk_size = MQTTSerialize_connect_size(&options);
-	connect_packet = _iot_mqtt_chunk_create(chunk_size);
+	connect_packet = _iot_mqtt_chunk_create(c, chunk_size);
 	if (connect_packet == NULL) {
 		IOT_ERROR("buf malloc fail");
 		rc = E_ST_MQTT_BUFFER_OVERFLOW;
@@ -1349,9 +1753,19 @@ int st_mqtt_connect(st_mqtt_client client, st_mqtt_broker_info_t *broker, st_mqt
 		iot_os_timer_start(c->last_received);
 	}
 	connect_packet->chunk_state = PACKET_CHUNK_WRITE_PENDING;
+	connect_start = iot_os_get_tick_ms();
 	_iot_mqtt_queue_push(&c->write_pending_queue, connect_packet);
 
 	rc = _iot_mqtt_wait_for(c, connect_packet);
+	if (rc == 0 && (iot_os_mutex_lock(&c->client_manage_lock)) == IOT_OS_TRUE) {
+		c->connect_stats.connack_ms = iot_os_get_tick_ms() - connect_start;
+		IOT_INFO("connected in dns %u tcp %u tls %u%s connack %u ms",
+				c->connect_stats.dns_ms, c->connect_stats.tcp_ms,
+				c->connect_stats.handshake_ms,
+				c->connect_stats.session_offered ? " (session offered)" : "",
+				c->connect_stats.connack_ms);
+		iot_os_mutex_unlock(&c->client_manage_lock);
+	}
 
 exit:
 	if (rc < 0) {
@@ -1365,9 +1779,29 @@ exit:
 			c->last_received = NULL;
 		}
 	} else {
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_REACTOR)
+		iot_executor_watch_t *watch = NULL;
+
+		if (port_net_set_nonblock(c->net_ctx) == 0) {
+			watch = iot_executor_watch_socket(port_net_get_socket(c->net_ctx),
+					_iot_mqtt_socket_ready, (void *)c);
+		}
+		if (watch == NULL) {
+			IOT_ERROR("failed to watch mqtt socket");
+			_iot_mqtt_close_net(c);
+			rc = E_ST_MQTT_FAILURE;
+		} else {
+			while ((iot_os_mutex_lock(&c->client_manage_lock)) != IOT_OS_TRUE);
+			c->socket_watch = watch;
+			iot_os_mutex_unlock(&c->client_manage_lock);
+			/* Works queued while connecting */
+			iot_executor_wake_socket(watch);
+		}
+#else
 		iot_os_thread_create(_iot_mqtt_listen_socket, "MQTTSocketListen",
 			MQTT_TASK_STACK_SIZE, (void *)c, MQTT_TASK_PRIORITY,
 			&c->socket_thread);
+#endif
 	}
 
 	IOT_DUMP(IOT_DEBUG_LEVEL_INFO, IOT_DUMP_MQTT_CONNECT_RESULT, rc, connect_data->alive_interval);
@@ -1397,18 +1831,17 @@ int st_mqtt_subscribe(st_mqtt_client client, int count, char* topics[], int qos[
 		Topics[i].cstring = (char *)topics[i];
 	}
 
+	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER) {
+		rc = E_ST_MQTT_FAILURE;
+		goto exit;
+	}
 	chunk_size = MQTTSerialize_subscribe_size(count, Topics);
-	sub_packet = _iot_mqtt_chunk_create(chunk_size);
+	sub_packet = _iot_mqtt_chunk_create(c, chunk_size);
 	if (sub_packet == NULL) {
 		IOT_ERROR("buf malloc fail");
 		rc = E_ST_MQTT_BUFFER_OVERFLOW;
 		goto exit;
 	}
-	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER) {
-		rc = E_ST_MQTT_FAILURE;
-		_iot_mqtt_chunk_destroy(sub_packet);
-		goto exit;
-	}
 	c->next_packetid = (c->next_packetid >= MAX_PACKET_ID) ? 1 : c->next_packetid + 1;
 	sub_packet->packet_id = c->next_packetid;
 	MQTTSerialize_subscribe(sub_packet->chunk_data, chunk_size, 0, sub_packet->packet_id, count, Topics, qos);
@@ -1450,18 +1883,17 @@ int st_mqtt_unsubscribe(st_mqtt_client client, int count, char* topics[])
 		Topics[i].cstring = (char *)topics[i];
 	}
 
+	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER) {
+		rc = E_ST_MQTT_FAILURE;
+		goto exit;
+	}
 	chunk_size = MQTTSerialize_unsubscribe_size(count, Topics);
-	unsub_packet = _iot_mqtt_chunk_create(chunk_size);
+	unsub_packet = _iot_mqtt_chunk_create(c, chunk_size);
 	if (unsub_packet == NULL) {
 		IOT_ERROR("buf malloc fail");
 		rc = E_ST_MQTT_BUFFER_OVERFLOW;
 		goto exit;
 	}
-	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER) {
-		rc = E_ST_MQTT_FAILURE;
-		_iot_mqtt_chunk_destroy(unsub_packet);
-		goto exit;
-	}
 	c->next_packetid = (c->next_packetid >= MAX_PACKET_ID) ? 1 : c->next_packetid + 1;
 	unsub_packet->packet_id = c->next_packetid;
 	MQTTSerialize_unsubscribe(unsub_packet->chunk_data, chunk_size, 0, unsub_packet->packet_id, count, Topics);
@@ -1495,7 +1927,7 @@ static iot_mqtt_packet_chunk_t * _iot_mqtt_push_publish_packet(MQTTClient *c, st
 	}
 
 	chunk_size = MQTTSerialize_publish_size(msg->qos, topic, msg->payloadlen);
-	pub_packet = _iot_mqtt_chunk_create(chunk_size);
+	pub_packet = _iot_mqtt_chunk_create(c, chunk_size);
 	if (pub_packet == NULL) {
 		IOT_ERROR("buf malloc fail");
 		goto exit;
@@ -1584,13 +2016,95 @@ int st_mqtt_publish_async(st_mqtt_client client, st_mqtt_msg *msg)
 	return rc;
 }
 
+int st_mqtt_get_chunk_pool_stats(st_mqtt_client client, st_mqtt_chunk_pool_stats *stats)
+{
+	MQTTClient *c = client;
+
+	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER || stats == NULL) {
+		return E_ST_MQTT_FAILURE;
+	}
+
+	if((iot_os_mutex_lock(&c->chunk_pool->lock)) != IOT_OS_TRUE) {
+		return E_ST_MQTT_FAILURE;
+	}
+	stats->header_hits = c->chunk_pool->header_hits;
+	stats->header_misses = c->chunk_pool->header_misses;
+	stats->data_hits = c->chunk_pool->data_hits;
+	stats->data_misses = c->chunk_pool->data_misses;
+	stats->in_use = c->chunk_pool->in_use;
+	stats->high_water = c->chunk_pool->high_water;
+	stats->data_in_use = c->chunk_pool->data_in_use;
+	stats->data_high_water = c->chunk_pool->data_high_water;
+	iot_os_mutex_unlock(&c->chunk_pool->lock);
+
+	return 0;
+}
+
+int st_mqtt_get_read_stats(st_mqtt_client client, st_mqtt_read_stats *stats)
+{
+	MQTTClient *c = client;
+
+	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER || stats == NULL) {
+		return E_ST_MQTT_FAILURE;
+	}
+
+	if((iot_os_mutex_lock(&c->reader.lock)) != IOT_OS_TRUE) {
+		return E_ST_MQTT_FAILURE;
+	}
+	stats->packets = c->reader.packets;
+	stats->packets_in_place = c->reader.packets_in_place;
+	stats->bytes_copied = c->reader.bytes_copied;
+	stats->last_bytes_copied = c->reader.last_bytes_copied;
+	iot_os_mutex_unlock(&c->reader.lock);
+
+	return 0;
+}
+
+int st_mqtt_get_write_stats(st_mqtt_client client, st_mqtt_write_stats *stats)
+{
+	MQTTClient *c = client;
+
+	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER || stats == NULL) {
+		return E_ST_MQTT_FAILURE;
+	}
+
+	if((iot_os_mutex_lock(&c->write_lock)) != IOT_OS_TRUE) {
+		return E_ST_MQTT_FAILURE;
+	}
+	*stats = c->write_stats;
+	iot_os_mutex_unlock(&c->write_lock);
+
+	return 0;
+}
+
+int st_mqtt_get_connect_stats(st_mqtt_client client, st_mqtt_connect_stats *stats)
+{
+	MQTTClient *c = client;
+
+	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER || stats == NULL) {
+		return E_ST_MQTT_FAILURE;
+	}
+
+	if((iot_os_mutex_lock(&c->client_manage_lock)) != IOT_OS_TRUE) {
+		return E_ST_MQTT_FAILURE;
+	}
+	*stats = c->connect_stats;
+	iot_os_mutex_unlock(&c->client_manage_lock);
+
+	return 0;
+}
+
 int st_mqtt_disconnect(st_mqtt_client client)
 {
 	MQTTClient *c = client;
 	int rc = 0;
 	iot_mqtt_packet_chunk_t *disconnect_packet = NULL;
 
-	disconnect_packet = _iot_mqtt_chunk_create(MQTT_DISCONNECT_PACKET_SIZE);
+	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER) {
+		rc = E_ST_MQTT_FAILURE;
+		goto exit;
+	}
+	disconnect_packet = _iot_mqtt_chunk_create(c, MQTT_DISCONNECT_PACKET_SIZE);
 	if (disconnect_packet == NULL) {
 		IOT_ERROR("buf malloc fail");
 		rc = E_ST_MQTT_BUFFER_OVERFLOW;
@@ -1600,11 +2114,6 @@ int st_mqtt_disconnect(st_mqtt_client client)
 	disconnect_packet->packet_type = DISCONNECT;
 	disconnect_packet->have_owner = 1;
 	disconnect_packet->chunk_state = PACKET_CHUNK_WRITE_PENDING;
-	if (c == NULL || c->magic != MQTT_CLIENT_STRUCT_MAGIC_NUMBER) {
-		rc = E_ST_MQTT_FAILURE;
-		_iot_mqtt_chunk_destroy(disconnect_packet);
-		goto exit;
-	}
 	_iot_mqtt_queue_push(&c->write_pending_queue, disconnect_packet);
 
 	rc = _iot_mqtt_wait_for(c, disconnect_packet);
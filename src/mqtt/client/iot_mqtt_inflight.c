@@ -0,0 +1,186 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include "iot_debug.h"
+#include "iot_mqtt_client.h"
+#include "iot_mqtt_inflight.h"
+
+#define _INFLIGHT_BUCKET_MASK	(IOT_MQTT_INFLIGHT_BUCKETS - 1)
+#define _INFLIGHT_SLOT_MASK	(IOT_MQTT_INFLIGHT_WHEEL_SLOTS - 1)
+#define _INFLIGHT_TICK(ms)	((ms) / IOT_MQTT_INFLIGHT_WHEEL_TICK_MS)
+#define _INFLIGHT_TIME_AFTER_EQ(a, b)	((int)((a) - (b)) >= 0)
+
+static unsigned int _iot_mqtt_inflight_hash(int packet_type, unsigned int packet_id)
+{
+	return (((unsigned int)packet_type * 31u) + packet_id) & _INFLIGHT_BUCKET_MASK;
+}
+
+void iot_mqtt_inflight_init(iot_mqtt_inflight_t *inflight, unsigned int now_ms)
+{
+	memset(inflight, '\0', sizeof(iot_mqtt_inflight_t));
+	inflight->cursor_tick = _INFLIGHT_TICK(now_ms);
+}
+
+void iot_mqtt_inflight_add(iot_mqtt_inflight_t *inflight, iot_mqtt_packet_chunk_t *chunk)
+{
+	unsigned int bucket = _iot_mqtt_inflight_hash(chunk->packet_type, chunk->packet_id);
+	unsigned int deadline_tick = _INFLIGHT_TICK(chunk->deadline);
+	unsigned int slot = deadline_tick & _INFLIGHT_SLOT_MASK;
+
+	chunk->hash_prev = NULL;
+	chunk->hash_next = inflight->bucket[bucket];
+	if (chunk->hash_next) {
+		chunk->hash_next->hash_prev = chunk;
+	}
+	inflight->bucket[bucket] = chunk;
+
+	chunk->wheel_prev = NULL;
+	chunk->wheel_next = inflight->slot[slot];
+	if (chunk->wheel_next) {
+		chunk->wheel_next->wheel_prev = chunk;
+	}
+	inflight->slot[slot] = chunk;
+
+	/* Deadline behind the sweep cursor must not wait for a full revolution */
+	if (!_INFLIGHT_TIME_AFTER_EQ(deadline_tick, inflight->cursor_tick)) {
+		inflight->cursor_tick = deadline_tick;
+	}
+
+	inflight->count++;
+}
+
+void iot_mqtt_inflight_remove(iot_mqtt_inflight_t *inflight, iot_mqtt_packet_chunk_t *chunk)
+{
+	if (chunk->hash_prev) {
+		chunk->hash_prev->hash_next = chunk->hash_next;
+	} else {
+		inflight->bucket[_iot_mqtt_inflight_hash(chunk->packet_type, chunk->packet_id)] = chunk->hash_next;
+	}
+	if (chunk->hash_next) {
+		chunk->hash_next->hash_prev = chunk->hash_prev;
+	}
+
+	if (chunk->wheel_prev) {
+		chunk->wheel_prev->wheel_next = chunk->wheel_next;
+	} else {
+		inflight->slot[_INFLIGHT_TICK(chunk->deadline) & _INFLIGHT_SLOT_MASK] = chunk->wheel_next;
+	}
+	if (chunk->wheel_next) {
+		chunk->wheel_next->wheel_prev = chunk->wheel_prev;
+	}
+
+	chunk->hash_prev = chunk->hash_next = NULL;
+	chunk->wheel_prev = chunk->wheel_next = NULL;
+
+	if (inflight->count) {
+		inflight->count--;
+	}
+}
+
+iot_mqtt_packet_chunk_t *iot_mqtt_inflight_find(iot_mqtt_inflight_t *inflight,
+		int packet_type, unsigned int packet_id)
+{
+	iot_mqtt_packet_chunk_t *iterator;
+
+	iterator = inflight->bucket[_iot_mqtt_inflight_hash(packet_type, packet_id)];
+	while (iterator) {
+		if (iterator->packet_type == packet_type && iterator->packet_id == packet_id) {
+			return iterator;
+		}
+		iterator = iterator->hash_next;
+	}
+
+	return NULL;
+}
+
+iot_mqtt_packet_chunk_t *iot_mqtt_inflight_find_expired(iot_mqtt_inflight_t *inflight,
+		unsigned int now_ms)
+{
+	iot_mqtt_packet_chunk_t *iterator;
+	unsigned int now_tick = _INFLIGHT_TICK(now_ms);
+	int lag = (int)(now_tick - inflight->cursor_tick);
+
+	if (inflight->count == 0) {
+		inflight->cursor_tick = now_tick;
+		return NULL;
+	}
+
+	/* Sweep every slot once at most, also covers tick counter wrap-around */
+	if (lag < 0 || lag >= IOT_MQTT_INFLIGHT_WHEEL_SLOTS) {
+		inflight->cursor_tick = now_tick - (IOT_MQTT_INFLIGHT_WHEEL_SLOTS - 1);
+	}
+
+	while (1) {
+		iterator = inflight->slot[inflight->cursor_tick & _INFLIGHT_SLOT_MASK];
+		while (iterator) {
+			if (_INFLIGHT_TIME_AFTER_EQ(now_ms, iterator->deadline)) {
+				return iterator;
+			}
+			iterator = iterator->wheel_next;
+		}
+
+		if (inflight->cursor_tick == now_tick) {
+			break;
+		}
+		inflight->cursor_tick++;
+	}
+
+	return NULL;
+}
+
+int iot_mqtt_inflight_next_deadline(iot_mqtt_inflight_t *inflight, unsigned int *deadline)
+{
+	iot_mqtt_packet_chunk_t *iterator;
+	unsigned int tick;
+	int i, found = 0;
+
+	if (inflight->count == 0) {
+		return -1;
+	}
+
+	/* First slot holding a deadline of its own revolution has the earliest one */
+	for (i = 0; i < IOT_MQTT_INFLIGHT_WHEEL_SLOTS && !found; i++) {
+		tick = inflight->cursor_tick + i;
+		for (iterator = inflight->slot[tick & _INFLIGHT_SLOT_MASK]; iterator; iterator = iterator->wheel_next) {
+			if (_INFLIGHT_TICK(iterator->deadline) != tick) {
+				continue;
+			}
+			if (!found || !_INFLIGHT_TIME_AFTER_EQ(iterator->deadline, *deadline)) {
+				*deadline = iterator->deadline;
+				found = 1;
+			}
+		}
+	}
+
+	if (found) {
+		return 0;
+	}
+
+	/* Every deadline is further than one revolution */
+	for (i = 0; i < IOT_MQTT_INFLIGHT_WHEEL_SLOTS; i++) {
+		for (iterator = inflight->slot[i]; iterator; iterator = iterator->wheel_next) {
+			if (!found || !_INFLIGHT_TIME_AFTER_EQ(iterator->deadline, *deadline)) {
+				*deadline = iterator->deadline;
+				found = 1;
+			}
+		}
+	}
+
+	return found ? 0 : -1;
+}
@@ -0,0 +1,216 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include "iot_debug.h"
+#include "iot_mqtt_packet.h"
+#include "iot_mqtt_reader.h"
+
+int iot_mqtt_reader_init(iot_mqtt_reader_t *reader, size_t size)
+{
+	if (reader == NULL || size == 0) {
+		return -1;
+	}
+	memset(reader, '\0', sizeof(iot_mqtt_reader_t));
+
+	iot_os_mutex_init(&reader->lock);
+	if (reader->lock.sem == NULL) {
+		IOT_ERROR("fail to init reader lock");
+		return -1;
+	}
+
+	reader->buf = iot_os_malloc(size);
+	if (reader->buf == NULL) {
+		IOT_ERROR("reader buffer malloc fail");
+		iot_os_mutex_destroy(&reader->lock);
+		reader->lock.sem = NULL;
+		return -1;
+	}
+	reader->size = size;
+
+	return 0;
+}
+
+void iot_mqtt_reader_deinit(iot_mqtt_reader_t *reader)
+{
+	if (reader == NULL) {
+		return;
+	}
+
+	if (reader->pinned) {
+		IOT_WARN("reader deinit with %u packets pinned", reader->pinned);
+	}
+	if (reader->buf) {
+		iot_os_free(reader->buf);
+	}
+	if (reader->lock.sem != NULL) {
+		iot_os_mutex_destroy(&reader->lock);
+	}
+	memset(reader, '\0', sizeof(iot_mqtt_reader_t));
+}
+
+void iot_mqtt_reader_reset(iot_mqtt_reader_t *reader)
+{
+	if (reader->buf == NULL || (iot_os_mutex_lock(&reader->lock)) != IOT_OS_TRUE) {
+		return;
+	}
+
+	/* Pinned regions stay in place until released */
+	reader->head = reader->tail;
+	if (reader->pinned == 0) {
+		reader->head = reader->tail = 0;
+	}
+	reader->pending_copied = 0;
+	iot_os_mutex_unlock(&reader->lock);
+}
+
+int iot_mqtt_reader_frame(iot_mqtt_reader_t *reader, size_t *packet_len)
+{
+	size_t avail = reader->tail - reader->head;
+	unsigned char *p = reader->buf + reader->head;
+	size_t rem_size = 0, multiplier = 1;
+	size_t len = 1;
+
+	*packet_len = 0;
+
+	do {
+		if (len > MAX_NUM_OF_REMAINING_LENGTH_BYTES) {
+			return -1;
+		}
+		if (len >= avail) {
+			return 0;
+		}
+		rem_size += (p[len] & 127) * multiplier;
+		multiplier *= 128;
+	} while ((p[len++] & 128) != 0);
+
+	*packet_len = len + rem_size;
+
+	return (*packet_len <= avail) ? 1 : 0;
+}
+
+bool iot_mqtt_reader_can_frame(iot_mqtt_reader_t *reader, size_t packet_len)
+{
+	bool ret = false;
+
+	if (packet_len > reader->size) {
+		return false;
+	}
+
+	if ((iot_os_mutex_lock(&reader->lock)) != IOT_OS_TRUE) {
+		return false;
+	}
+	/* Pinned memory keeps the buffer from being compacted */
+	ret = (reader->pinned == 0) || (reader->head + packet_len <= reader->size);
+	iot_os_mutex_unlock(&reader->lock);
+
+	return ret;
+}
+
+int iot_mqtt_reader_fill(iot_mqtt_reader_t *reader, PORT_NET_CONTEXT net_ctx, size_t need)
+{
+	size_t avail;
+	int ret;
+
+	if ((iot_os_mutex_lock(&reader->lock)) != IOT_OS_TRUE) {
+		return 0;
+	}
+	if (reader->pinned == 0) {
+		avail = reader->tail - reader->head;
+		if (avail == 0) {
+			reader->head = reader->tail = 0;
+		} else if (reader->head > 0 &&
+				(reader->tail == reader->size || reader->head + need > reader->size)) {
+			memmove(reader->buf, reader->buf + reader->head, avail);
+			reader->pending_copied += avail;
+			reader->head = 0;
+			reader->tail = avail;
+		}
+	}
+	iot_os_mutex_unlock(&reader->lock);
+
+	if (reader->tail == reader->size) {
+		return 0;
+	}
+
+	ret = port_net_read(net_ctx, reader->buf + reader->tail, reader->size - reader->tail);
+	if (ret > 0) {
+		reader->tail += ret;
+	}
+
+	return ret;
+}
+
+unsigned char *iot_mqtt_reader_pin(iot_mqtt_reader_t *reader, size_t packet_len)
+{
+	unsigned char *packet = reader->buf + reader->head;
+
+	if ((iot_os_mutex_lock(&reader->lock)) != IOT_OS_TRUE) {
+		return NULL;
+	}
+	reader->head += packet_len;
+	reader->pinned++;
+	iot_os_mutex_unlock(&reader->lock);
+
+	return packet;
+}
+
+void iot_mqtt_reader_release(iot_mqtt_reader_t *reader)
+{
+	while ((iot_os_mutex_lock(&reader->lock)) != IOT_OS_TRUE);
+	if (reader->pinned) {
+		reader->pinned--;
+	}
+	iot_os_mutex_unlock(&reader->lock);
+}
+
+size_t iot_mqtt_reader_take(iot_mqtt_reader_t *reader, unsigned char *dst, size_t len)
+{
+	size_t avail = reader->tail - reader->head;
+
+	if (len > avail) {
+		len = avail;
+	}
+	if (len == 0) {
+		return 0;
+	}
+
+	memcpy(dst, reader->buf + reader->head, len);
+	reader->head += len;
+	reader->pending_copied += len;
+
+	return len;
+}
+
+void iot_mqtt_reader_account(iot_mqtt_reader_t *reader, bool in_place)
+{
+	if ((iot_os_mutex_lock(&reader->lock)) != IOT_OS_TRUE) {
+		return;
+	}
+	reader->packets++;
+	if (in_place) {
+		reader->packets_in_place++;
+	}
+	reader->bytes_copied += reader->pending_copied;
+	reader->last_bytes_copied = reader->pending_copied;
+	reader->pending_copied = 0;
+	iot_os_mutex_unlock(&reader->lock);
+
+	IOT_DEBUG("packet framed %s, %u bytes copied", in_place ? "in place" : "by copy",
+			reader->last_bytes_copied);
+}
@@ -24,19 +24,57 @@
 #include <unistd.h>
 #include "iot_bsp_fs.h"
 #include "iot_debug.h"
+#if defined(CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV)
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
-
-iot_error_t iot_bsp_fs_init()
+static iot_error_t _iot_bsp_fs_file_read(iot_bsp_fs_handle_t handle, char* buffer, size_t *length)
 {
+    char* data;
+    ssize_t size;
+
+	if (access(handle.filename, F_OK) == -1) {
+		IOT_DEBUG("file does not exist");
+		return IOT_ERROR_FS_NO_FILE;
+	}
+
+	data = malloc(*length + 1);
+	if (!data) {
+	    IOT_DEBUG("malloc failed");
+	    return IOT_ERROR_FS_OPEN_FAIL;
+	}
+	size = read(handle.fd, data, *length);
+	if (size < 0) {
+		free(data);
+		IOT_DEBUG("read fail [%s]", strerror(errno));
+		return IOT_ERROR_FS_READ_FAIL;
+	}
+
+	memcpy(buffer, data, size);
+	if (size < *length) {
+		buffer[size] = '\0';
+	}
+
+	*length = size;
+
+	free(data);
+
 	return IOT_ERROR_NONE;
 }
 
-iot_error_t iot_bsp_fs_deinit()
+static iot_error_t _iot_bsp_fs_file_close(iot_bsp_fs_handle_t handle)
 {
+	int ret = close(handle.fd);
+	IOT_DEBUG_CHECK(ret != 0, IOT_ERROR_FS_CLOSE_FAIL, "close fail [%s]", strerror(errno));
+
 	return IOT_ERROR_NONE;
 }
 
-iot_error_t iot_bsp_fs_open(const char* filename, iot_bsp_fs_open_mode_t mode, iot_bsp_fs_handle_t* handle)
+static iot_error_t _iot_bsp_fs_file_open(const char* filename, iot_bsp_fs_open_mode_t mode, iot_bsp_fs_handle_t* handle)
 {
 	int fd;
 	int open_mode;
@@ -62,81 +100,620 @@ iot_error_t iot_bsp_fs_open(const char* filename, iot_bsp_fs_open_mode_t mode, i
 	}
 }
 
-iot_error_t iot_bsp_fs_open_from_stnv(const char* filename, iot_bsp_fs_handle_t* handle)
+static iot_error_t _iot_bsp_fs_file_write(iot_bsp_fs_handle_t handle, const char* data, size_t length)
+{
+	ssize_t size = write(handle.fd, data, length);
+	IOT_DEBUG_CHECK(size != length, IOT_ERROR_FS_WRITE_FAIL, "write fail [%s]", strerror(errno));
+
+	return IOT_ERROR_NONE;
+}
+
+static iot_error_t _iot_bsp_fs_file_remove(const char* filename)
 {
+	int ret = remove(filename);
+
+	IOT_DEBUG_CHECK(((ret != 0) && (errno == ENOENT)), IOT_ERROR_FS_NO_FILE, "remove fail [%s]", strerror(errno));
+	IOT_DEBUG_CHECK(ret != 0, IOT_ERROR_FS_REMOVE_FAIL, "remove fail [%s]", strerror(errno));
+
+	return IOT_ERROR_NONE;
+}
+
+#if defined(CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV)
+#ifndef CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV_PATH
+#define CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV_PATH	"iot_nv.pack"
+#endif
+
+/*
+ * Every file lives in one log-structured container.
+ *
+ *  header | record | record | ...
+ *  record = packed_nv_record, name, data, padding to 4 bytes
+ *
+ * A write or remove appends a new record for the name, and the latest one wins.
+ * On open the log is scanned once through mmap to build the index, and a torn
+ * record left by a crash during append is cut off, so other files stay intact.
+ * When dead records take over half of the log, live ones are copied to a new
+ * container which atomically replaces the old one by rename().
+ * Spill files (IOT_BSP_FS_SPILL_PREFIX) churn too fast for the log and are
+ * kept as plain files next to it.
+ */
+#define PACKED_NV_PATH		CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV_PATH
+#define PACKED_NV_MAGIC		0x564e5453	/* "STNV" */
+#define PACKED_NV_VERSION	1
+#define PACKED_NV_RECORD_MAGIC	0x5243		/* "RC" */
+#define PACKED_NV_FLAG_REMOVED	(1 << 0)
+#define PACKED_NV_COMPACT_MIN	(16 * 1024)
+#define PACKED_NV_ALIGN(x)	(((x) + 3) & ~((size_t)3))
+
+struct packed_nv_header {
+	uint32_t magic;
+	uint32_t version;
+};
+
+struct packed_nv_record {
+	uint16_t magic;
+	uint8_t flags;
+	uint8_t name_len;
+	uint32_t data_len;
+	uint32_t crc;		/* over flags, name and data */
+};
+
+struct packed_nv_entry {
+	char name[sizeof(((iot_bsp_fs_handle_t *)0)->filename)];
+	size_t offset;		/* of the latest record */
+	size_t data_len;
+};
+
+static struct {
+	pthread_mutex_t lock;
 	int fd;
+	unsigned char *map;
+	size_t map_size;
+	size_t size;		/* end of valid log */
+	size_t live;		/* bytes taken by latest records */
+	unsigned int refs;
+	struct packed_nv_entry *entry;
+	unsigned int entries;
+	unsigned int entries_max;
+} packed_nv = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.fd = -1,
+};
 
-	if (access(filename, F_OK) < 0) {
-		IOT_DEBUG("file doesn't exist");
-		return IOT_ERROR_FS_NO_FILE;
+static bool _packed_nv_is_spill(const char *filename)
+{
+	return !strncmp(filename, IOT_BSP_FS_SPILL_PREFIX, strlen(IOT_BSP_FS_SPILL_PREFIX));
+}
+
+static uint32_t _packed_nv_crc32(uint32_t crc, const unsigned char *p, size_t len)
+{
+	crc = ~crc;
+	while (len--) {
+		crc ^= *p++;
+		for (int i = 0; i < 8; i++) {
+			crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+		}
 	}
-	fd = open(filename, O_RDONLY);
-	if (fd > 0) {
-		handle->fd = fd;
-		snprintf(handle->filename, sizeof(handle->filename), "%s", filename);
+	return ~crc;
+}
+
+static size_t _packed_nv_record_size(size_t name_len, size_t data_len)
+{
+	return PACKED_NV_ALIGN(sizeof(struct packed_nv_record) + name_len + data_len);
+}
+
+static int _packed_nv_find(const char *name)
+{
+	for (unsigned int i = 0; i < packed_nv.entries; i++) {
+		if (!strcmp(packed_nv.entry[i].name, name)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static void _packed_nv_index_remove(int i)
+{
+	struct packed_nv_entry *entry = &packed_nv.entry[i];
+
+	packed_nv.live -= _packed_nv_record_size(strlen(entry->name), entry->data_len);
+	packed_nv.entry[i] = packed_nv.entry[--packed_nv.entries];
+}
+
+static iot_error_t _packed_nv_index_set(const char *name, size_t offset, size_t data_len)
+{
+	struct packed_nv_entry *entry;
+	int i = _packed_nv_find(name);
+
+	if (i >= 0) {
+		_packed_nv_index_remove(i);
+	}
+
+	if (packed_nv.entries == packed_nv.entries_max) {
+		unsigned int entries_max = packed_nv.entries_max ? packed_nv.entries_max * 2 : 16;
+
+		entry = realloc(packed_nv.entry, entries_max * sizeof(*entry));
+		if (!entry) {
+			IOT_DEBUG("index alloc failed");
+			return IOT_ERROR_MEM_ALLOC;
+		}
+		packed_nv.entry = entry;
+		packed_nv.entries_max = entries_max;
+	}
+
+	entry = &packed_nv.entry[packed_nv.entries++];
+	snprintf(entry->name, sizeof(entry->name), "%s", name);
+	entry->offset = offset;
+	entry->data_len = data_len;
+	packed_nv.live += _packed_nv_record_size(strlen(name), data_len);
+
+	return IOT_ERROR_NONE;
+}
+
+static void _packed_nv_unmap_locked(void)
+{
+	if (packed_nv.map) {
+		munmap(packed_nv.map, packed_nv.map_size);
+	}
+	packed_nv.map = NULL;
+	packed_nv.map_size = 0;
+}
+
+static iot_error_t _packed_nv_map_locked(void)
+{
+	struct stat st;
+
+	_packed_nv_unmap_locked();
+
+	if (fstat(packed_nv.fd, &st) < 0) {
+		IOT_DEBUG("stat fail [%s]", strerror(errno));
+		return IOT_ERROR_FS_OPEN_FAIL;
+	}
+	if (st.st_size == 0) {
 		return IOT_ERROR_NONE;
-	} else {
-		IOT_DEBUG("file open failed [%s]", strerror(errno));
+	}
+
+	packed_nv.map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, packed_nv.fd, 0);
+	if (packed_nv.map == MAP_FAILED) {
+		IOT_DEBUG("mmap fail [%s]", strerror(errno));
+		packed_nv.map = NULL;
+		return IOT_ERROR_FS_OPEN_FAIL;
+	}
+	packed_nv.map_size = st.st_size;
+
+	return IOT_ERROR_NONE;
+}
+
+/* builds index from the log and cuts a torn tail off */
+static iot_error_t _packed_nv_scan_locked(void)
+{
+	const struct packed_nv_header *header;
+	struct packed_nv_header new_header = {PACKED_NV_MAGIC, PACKED_NV_VERSION};
+	struct packed_nv_record record;
+	char name[sizeof(((iot_bsp_fs_handle_t *)0)->filename)];
+	size_t offset;
+	size_t record_size;
+	uint32_t crc;
+	iot_error_t err;
+
+	packed_nv.entries = 0;
+	packed_nv.live = 0;
+
+	header = (const struct packed_nv_header *)packed_nv.map;
+	if (packed_nv.map_size < sizeof(*header) || header->magic != PACKED_NV_MAGIC
+			|| header->version != PACKED_NV_VERSION) {
+		if (packed_nv.map_size) {
+			IOT_WARN("%s is not a nv container, reset it", PACKED_NV_PATH);
+		}
+		if (ftruncate(packed_nv.fd, 0) < 0
+				|| pwrite(packed_nv.fd, &new_header, sizeof(new_header), 0) != sizeof(new_header)
+				|| fdatasync(packed_nv.fd) < 0) {
+			IOT_DEBUG("header write fail [%s]", strerror(errno));
+			return IOT_ERROR_FS_WRITE_FAIL;
+		}
+		packed_nv.size = sizeof(new_header);
+		return _packed_nv_map_locked();
+	}
+
+	offset = sizeof(*header);
+	while (offset + sizeof(record) <= packed_nv.map_size) {
+		memcpy(&record, packed_nv.map + offset, sizeof(record));
+		if (record.magic != PACKED_NV_RECORD_MAGIC || record.name_len == 0
+				|| record.name_len >= sizeof(name)) {
+			break;
+		}
+		record_size = _packed_nv_record_size(record.name_len, record.data_len);
+		if (record.data_len > packed_nv.map_size || offset + record_size > packed_nv.map_size) {
+			break;
+		}
+
+		crc = _packed_nv_crc32(0, &record.flags, sizeof(record.flags));
+		crc = _packed_nv_crc32(crc, packed_nv.map + offset + sizeof(record),
+				record.name_len + record.data_len);
+		if (crc != record.crc) {
+			break;
+		}
+
+		memcpy(name, packed_nv.map + offset + sizeof(record), record.name_len);
+		name[record.name_len] = '\0';
+		if (record.flags & PACKED_NV_FLAG_REMOVED) {
+			int i = _packed_nv_find(name);
+
+			if (i >= 0) {
+				_packed_nv_index_remove(i);
+			}
+		} else {
+			err = _packed_nv_index_set(name, offset, record.data_len);
+			if (err != IOT_ERROR_NONE) {
+				return err;
+			}
+		}
+		offset += record_size;
+	}
+
+	packed_nv.size = offset;
+	if (offset < packed_nv.map_size) {
+		IOT_WARN("cut %d bytes of broken record off %s", (int)(packed_nv.map_size - offset), PACKED_NV_PATH);
+		if (ftruncate(packed_nv.fd, offset) < 0) {
+			IOT_DEBUG("truncate fail [%s]", strerror(errno));
+			return IOT_ERROR_FS_WRITE_FAIL;
+		}
+		return _packed_nv_map_locked();
+	}
+
+	return IOT_ERROR_NONE;
+}
+
+static void _packed_nv_close_locked(void)
+{
+	_packed_nv_unmap_locked();
+	if (packed_nv.fd >= 0) {
+		close(packed_nv.fd);
+	}
+	packed_nv.fd = -1;
+	free(packed_nv.entry);
+	packed_nv.entry = NULL;
+	packed_nv.entries = 0;
+	packed_nv.entries_max = 0;
+	packed_nv.size = 0;
+	packed_nv.live = 0;
+}
+
+static iot_error_t _packed_nv_open_locked(void)
+{
+	iot_error_t err;
+
+	if (packed_nv.fd >= 0) {
+		return IOT_ERROR_NONE;
+	}
+
+	packed_nv.fd = open(PACKED_NV_PATH, O_RDWR | O_CREAT, 0644);
+	if (packed_nv.fd < 0) {
+		IOT_DEBUG("%s open failed [%s]", PACKED_NV_PATH, strerror(errno));
 		return IOT_ERROR_FS_OPEN_FAIL;
 	}
+
+	err = _packed_nv_map_locked();
+	if (err == IOT_ERROR_NONE) {
+		err = _packed_nv_scan_locked();
+	}
+	if (err != IOT_ERROR_NONE) {
+		_packed_nv_close_locked();
+	}
+
+	return err;
+}
+
+/* copies latest records to a new container and swaps it in */
+static void _packed_nv_compact_locked(void)
+{
+	struct packed_nv_header header = {PACKED_NV_MAGIC, PACKED_NV_VERSION};
+	char tmp_path[sizeof(PACKED_NV_PATH) + 4];
+	size_t offset = sizeof(header);
+	size_t record_size;
+	int fd;
+
+	snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", PACKED_NV_PATH);
+	fd = open(tmp_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		IOT_DEBUG("%s open failed [%s]", tmp_path, strerror(errno));
+		return;
+	}
+
+	if (pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) {
+		goto fail;
+	}
+	for (unsigned int i = 0; i < packed_nv.entries; i++) {
+		struct packed_nv_entry *entry = &packed_nv.entry[i];
+
+		record_size = _packed_nv_record_size(strlen(entry->name), entry->data_len);
+		if (pwrite(fd, packed_nv.map + entry->offset, record_size, offset) != (ssize_t)record_size) {
+			goto fail;
+		}
+		entry->offset = offset;
+		offset += record_size;
+	}
+	if (fsync(fd) < 0 || rename(tmp_path, PACKED_NV_PATH) < 0) {
+		goto fail;
+	}
+
+	close(packed_nv.fd);
+	packed_nv.fd = fd;
+	packed_nv.size = offset;
+	if (_packed_nv_map_locked() != IOT_ERROR_NONE) {
+		_packed_nv_close_locked();
+	}
+	return;
+
+fail:
+	IOT_DEBUG("compaction fail [%s]", strerror(errno));
+	close(fd);
+	remove(tmp_path);
+	/* offsets may be half updated, take them from the log again */
+	if (_packed_nv_scan_locked() != IOT_ERROR_NONE) {
+		_packed_nv_close_locked();
+	}
+}
+
+static iot_error_t _packed_nv_append_locked(const char *name, uint8_t flags, const char *data, size_t length)
+{
+	struct packed_nv_record record;
+	size_t name_len = strlen(name);
+	size_t record_size = _packed_nv_record_size(name_len, length);
+	size_t offset = packed_nv.size;
+	unsigned char *buf;
+	iot_error_t err;
+	int i;
+
+	if (name_len == 0 || name_len >= sizeof(((iot_bsp_fs_handle_t *)0)->filename)) {
+		return IOT_ERROR_INVALID_ARGS;
+	}
+
+	buf = calloc(1, record_size);
+	if (!buf) {
+		IOT_DEBUG("malloc failed");
+		return IOT_ERROR_FS_WRITE_FAIL;
+	}
+
+	record.magic = PACKED_NV_RECORD_MAGIC;
+	record.flags = flags;
+	record.name_len = name_len;
+	record.data_len = length;
+	memcpy(buf + sizeof(record), name, name_len);
+	if (length) {
+		memcpy(buf + sizeof(record) + name_len, data, length);
+	}
+	record.crc = _packed_nv_crc32(0, &record.flags, sizeof(record.flags));
+	record.crc = _packed_nv_crc32(record.crc, buf + sizeof(record), name_len + length);
+	memcpy(buf, &record, sizeof(record));
+
+	if (pwrite(packed_nv.fd, buf, record_size, offset) != (ssize_t)record_size
+			|| fdatasync(packed_nv.fd) < 0) {
+		IOT_DEBUG("write fail [%s]", strerror(errno));
+		free(buf);
+		/* leave nothing behind for the next scan */
+		(void)ftruncate(packed_nv.fd, offset);
+		return IOT_ERROR_FS_WRITE_FAIL;
+	}
+	free(buf);
+	packed_nv.size = offset + record_size;
+
+	err = _packed_nv_map_locked();
+	if (err != IOT_ERROR_NONE) {
+		_packed_nv_close_locked();
+		return err;
+	}
+
+	if (flags & PACKED_NV_FLAG_REMOVED) {
+		i = _packed_nv_find(name);
+		if (i >= 0) {
+			_packed_nv_index_remove(i);
+		}
+	} else {
+		err = _packed_nv_index_set(name, offset, length);
+		if (err != IOT_ERROR_NONE) {
+			return err;
+		}
+	}
+
+	if (packed_nv.size > PACKED_NV_COMPACT_MIN && packed_nv.live < packed_nv.size / 2) {
+		_packed_nv_compact_locked();
+	}
+
+	return IOT_ERROR_NONE;
+}
+
+iot_error_t iot_bsp_fs_init()
+{
+	iot_error_t err;
+
+	pthread_mutex_lock(&packed_nv.lock);
+	err = _packed_nv_open_locked();
+	if (err == IOT_ERROR_NONE) {
+		packed_nv.refs++;
+	}
+	pthread_mutex_unlock(&packed_nv.lock);
+
+	return (err == IOT_ERROR_NONE) ? IOT_ERROR_NONE : IOT_ERROR_INIT_FAIL;
+}
+
+iot_error_t iot_bsp_fs_deinit()
+{
+	pthread_mutex_lock(&packed_nv.lock);
+	if (packed_nv.refs && --packed_nv.refs == 0) {
+		_packed_nv_close_locked();
+	}
+	pthread_mutex_unlock(&packed_nv.lock);
+
+	return IOT_ERROR_NONE;
+}
+
+iot_error_t iot_bsp_fs_open(const char* filename, iot_bsp_fs_open_mode_t mode, iot_bsp_fs_handle_t* handle)
+{
+	iot_error_t err;
+
+	if (_packed_nv_is_spill(filename)) {
+		return _iot_bsp_fs_file_open(filename, mode, handle);
+	}
+
+	pthread_mutex_lock(&packed_nv.lock);
+	err = _packed_nv_open_locked();
+	if (err == IOT_ERROR_NONE && mode == FS_READONLY && _packed_nv_find(filename) < 0) {
+		IOT_DEBUG("file doesn't exist");
+		err = IOT_ERROR_FS_NO_FILE;
+	}
+	pthread_mutex_unlock(&packed_nv.lock);
+
+	if (err == IOT_ERROR_NONE) {
+		/* no file descriptor of its own, data is in container */
+		handle->fd = -1;
+		snprintf(handle->filename, sizeof(handle->filename), "%s", filename);
+	}
+
+	return err;
 }
 
 iot_error_t iot_bsp_fs_read(iot_bsp_fs_handle_t handle, char* buffer, size_t *length)
 {
-    char* data;
-    ssize_t size;
+	struct packed_nv_entry *entry;
+	size_t size;
+	int i;
 
-	if (access(handle.filename, F_OK) == -1) {
+	if (handle.fd >= 0) {
+		/* opened from stnv or spill file */
+		return _iot_bsp_fs_file_read(handle, buffer, length);
+	}
+
+	pthread_mutex_lock(&packed_nv.lock);
+	i = (packed_nv.fd >= 0) ? _packed_nv_find(handle.filename) : -1;
+	if (i < 0) {
+		pthread_mutex_unlock(&packed_nv.lock);
 		IOT_DEBUG("file does not exist");
 		return IOT_ERROR_FS_NO_FILE;
 	}
 
-	data = malloc(*length + 1);
-	if (!data) {
-	    IOT_DEBUG("malloc failed");
-	    return IOT_ERROR_FS_OPEN_FAIL;
-	}
-	size = read(handle.fd, data, *length);
-	if (size < 0) {
-		free(data);
-		IOT_DEBUG("read fail [%s]", strerror(errno));
-		return IOT_ERROR_FS_READ_FAIL;
-	}
+	entry = &packed_nv.entry[i];
+	size = (entry->data_len < *length) ? entry->data_len : *length;
+	memcpy(buffer, packed_nv.map + entry->offset + sizeof(struct packed_nv_record) + strlen(entry->name), size);
+	pthread_mutex_unlock(&packed_nv.lock);
 
-	memcpy(buffer, data, size);
 	if (size < *length) {
 		buffer[size] = '\0';
 	}
 
 	*length = size;
 
-	free(data);
-
 	return IOT_ERROR_NONE;
 }
 
+/* each write replaces the whole content of the file */
 iot_error_t iot_bsp_fs_write(iot_bsp_fs_handle_t handle, const char* data, size_t length)
 {
-	ssize_t size = write(handle.fd, data, length);
-	IOT_DEBUG_CHECK(size != length, IOT_ERROR_FS_WRITE_FAIL, "write fail [%s]", strerror(errno));
+	iot_error_t err;
+
+	if (handle.fd >= 0) {
+		return _iot_bsp_fs_file_write(handle, data, length);
+	}
+
+	pthread_mutex_lock(&packed_nv.lock);
+	err = _packed_nv_open_locked();
+	if (err == IOT_ERROR_NONE) {
+		err = _packed_nv_append_locked(handle.filename, 0, data, length);
+	}
+	pthread_mutex_unlock(&packed_nv.lock);
+	IOT_DEBUG_CHECK(err != IOT_ERROR_NONE, IOT_ERROR_FS_WRITE_FAIL, "write fail [%d]", err);
 
 	return IOT_ERROR_NONE;
 }
 
 iot_error_t iot_bsp_fs_close(iot_bsp_fs_handle_t handle)
 {
-	int ret = close(handle.fd);
-	IOT_DEBUG_CHECK(ret != 0, IOT_ERROR_FS_CLOSE_FAIL, "close fail [%s]", strerror(errno));
+	if (handle.fd >= 0) {
+		return _iot_bsp_fs_file_close(handle);
+	}
 
 	return IOT_ERROR_NONE;
 }
 
 iot_error_t iot_bsp_fs_remove(const char* filename)
 {
-	int ret = remove(filename);
+	iot_error_t err;
 
-	IOT_DEBUG_CHECK(((ret != 0) && (errno == ENOENT)), IOT_ERROR_FS_NO_FILE, "remove fail [%s]", strerror(errno));
-	IOT_DEBUG_CHECK(ret != 0, IOT_ERROR_FS_REMOVE_FAIL, "remove fail [%s]", strerror(errno));
+	if (_packed_nv_is_spill(filename)) {
+		return _iot_bsp_fs_file_remove(filename);
+	}
+
+	pthread_mutex_lock(&packed_nv.lock);
+	err = _packed_nv_open_locked();
+	if (err == IOT_ERROR_NONE) {
+		if (_packed_nv_find(filename) < 0) {
+			err = IOT_ERROR_FS_NO_FILE;
+		} else {
+			err = _packed_nv_append_locked(filename, PACKED_NV_FLAG_REMOVED, NULL, 0);
+		}
+	}
+	pthread_mutex_unlock(&packed_nv.lock);
+
+	IOT_DEBUG_CHECK(err == IOT_ERROR_FS_NO_FILE, IOT_ERROR_FS_NO_FILE, "remove fail [no file]");
+	IOT_DEBUG_CHECK(err != IOT_ERROR_NONE, IOT_ERROR_FS_REMOVE_FAIL, "remove fail [%d]", err);
 
 	return IOT_ERROR_NONE;
 }
+
+#else /* !CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV */
+
+iot_error_t iot_bsp_fs_init()
+{
+	return IOT_ERROR_NONE;
+}
+
+iot_error_t iot_bsp_fs_deinit()
+{
+	return IOT_ERROR_NONE;
+}
+
+iot_error_t iot_bsp_fs_open(const char* filename, iot_bsp_fs_open_mode_t mode, iot_bsp_fs_handle_t* handle)
+{
+	return _iot_bsp_fs_file_open(filename, mode, handle);
+}
+
+iot_error_t iot_bsp_fs_write(iot_bsp_fs_handle_t handle, const char* data, size_t length)
+{
+	return _iot_bsp_fs_file_write(handle, data, length);
+}
+
+iot_error_t iot_bsp_fs_read(iot_bsp_fs_handle_t handle, char* buffer, size_t *length)
+{
+	return _iot_bsp_fs_file_read(handle, buffer, length);
+}
+
+iot_error_t iot_bsp_fs_close(iot_bsp_fs_handle_t handle)
+{
+	return _iot_bsp_fs_file_close(handle);
+}
+
+iot_error_t iot_bsp_fs_remove(const char* filename)
+{
+	return _iot_bsp_fs_file_remove(filename);
+}
+
+#endif /* CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV */
+
+iot_error_t iot_bsp_fs_open_from_stnv(const char* filename, iot_bsp_fs_handle_t* handle)
+{
+	int fd;
+
+	if (access(filename, F_OK) < 0) {
+		IOT_DEBUG("file doesn't exist");
+		return IOT_ERROR_FS_NO_FILE;
+	}
+	fd = open(filename, O_RDONLY);
+	if (fd > 0) {
+		handle->fd = fd;
+		snprintf(handle->filename, sizeof(handle->filename), "%s", filename);
+		return IOT_ERROR_NONE;
+	} else {
+		IOT_DEBUG("file open failed [%s]", strerror(errno));
+		return IOT_ERROR_FS_OPEN_FAIL;
+	}
+}
@@ -17,9 +17,11 @@
  ****************************************************************************/
 
 #include "iot_debug.h"
+#include "iot_os_util.h"
 #include "port_net.h"
 
 #include <sys/socket.h>
+#include <netdb.h>
 #include <errno.h>
 #if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
 #include <netinet/in.h>
@@ -41,22 +43,307 @@
 #include "mbedtls/certs.h"
 #endif
 #include "mbedtls/x509.h"
+#include "mbedtls/sha256.h"
 #include "mbedtls/debug.h"
 
 #define IOT_MBEDTLS_READ_TIMEOUT_MS 10000
 
+#ifndef CONFIG_STDK_IOT_CORE_NET_TLS_SESSION_CACHE
+#define CONFIG_STDK_IOT_CORE_NET_TLS_SESSION_CACHE	2
+#endif
+
+#define PORT_NET_SESSION_CACHE_SIZE	CONFIG_STDK_IOT_CORE_NET_TLS_SESSION_CACHE
+
+/* CA chain parsed once and shared by connections while it doesn't change */
+typedef struct {
+	mbedtls_x509_crt crt;
+	unsigned char digest[32];
+	int refs;
+} port_net_ca_t;
+
+typedef struct {
+	char *server;	/* "address:port" session was made with, NULL if empty */
+	mbedtls_ssl_session session;
+} port_net_session_t;
+
+enum {
+	PORT_NET_SHARED_NONE = 0,
+	PORT_NET_SHARED_INITIALIZING,
+	PORT_NET_SHARED_READY,
+};
+
+static struct {
+	int state;
+	iot_os_mutex lock;
+	mbedtls_entropy_context entropy;
+	mbedtls_ctr_drbg_context ctr_drbg;
+	port_net_ca_t *ca;
+#if PORT_NET_SESSION_CACHE_SIZE > 0
+	port_net_session_t sessions[PORT_NET_SESSION_CACHE_SIZE];
+	unsigned int session_next;
+#endif
+} _shared;
+
 typedef struct {
 	bool is_tls_connection;
 
 	mbedtls_net_context sock_fd;
 	mbedtls_ssl_context ssl;
 	mbedtls_ssl_config conf;
-	mbedtls_entropy_context entropy;
-	mbedtls_ctr_drbg_context ctr_drbg;
 	mbedtls_x509_crt cacert;
 	mbedtls_x509_crt own_cert;
+	port_net_ca_t *shared_ca;
+	port_net_connect_stats stats;
 } port_net_mbedtls_context_t;
 
+static int _port_net_shared_init(void)
+{
+	const char *pers = "iot_net_mbedtls";
+	int state = PORT_NET_SHARED_NONE;
+	int ret;
+
+	if (!__atomic_compare_exchange_n(&_shared.state, &state, PORT_NET_SHARED_INITIALIZING,
+			false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+		while (state == PORT_NET_SHARED_INITIALIZING) {
+			iot_os_delay(10);
+			state = __atomic_load_n(&_shared.state, __ATOMIC_ACQUIRE);
+		}
+		return (state == PORT_NET_SHARED_READY) ? 0 : -1;
+	}
+
+	if (iot_os_mutex_init(&_shared.lock) != IOT_OS_TRUE) {
+		IOT_ERROR("failed to init net lock");
+		goto error_lock_init;
+	}
+
+	mbedtls_ctr_drbg_init(&_shared.ctr_drbg);
+	mbedtls_entropy_init(&_shared.entropy);
+	ret = mbedtls_ctr_drbg_seed(&_shared.ctr_drbg, mbedtls_entropy_func, &_shared.entropy,
+				(const unsigned char *)pers, strlen((char *)pers));
+	if (ret) {
+		IOT_ERROR("mbedtls_ctr_drbg_seed = -0x%04X", -ret);
+		goto error_drbg_seed;
+	}
+
+#if PORT_NET_SESSION_CACHE_SIZE > 0
+	for (int i = 0; i < PORT_NET_SESSION_CACHE_SIZE; i++) {
+		mbedtls_ssl_session_init(&_shared.sessions[i].session);
+	}
+#endif
+
+	__atomic_store_n(&_shared.state, PORT_NET_SHARED_READY, __ATOMIC_RELEASE);
+	return 0;
+
+error_drbg_seed:
+	mbedtls_ctr_drbg_free(&_shared.ctr_drbg);
+	mbedtls_entropy_free(&_shared.entropy);
+	iot_os_mutex_destroy(&_shared.lock);
+error_lock_init:
+	__atomic_store_n(&_shared.state, PORT_NET_SHARED_NONE, __ATOMIC_RELEASE);
+	return -1;
+}
+
+/* One DRBG seeded once serves every connection, so it is used under lock */
+static int _port_net_random(void *p_rng, unsigned char *output, size_t output_len)
+{
+	int ret;
+
+	while ((iot_os_mutex_lock(&_shared.lock)) != IOT_OS_TRUE);
+	ret = mbedtls_ctr_drbg_random(&_shared.ctr_drbg, output, output_len);
+	iot_os_mutex_unlock(&_shared.lock);
+
+	return ret;
+}
+
+static void _port_net_ca_put(port_net_ca_t *ca)
+{
+	int refs;
+
+	if (ca == NULL) {
+		return;
+	}
+
+	while ((iot_os_mutex_lock(&_shared.lock)) != IOT_OS_TRUE);
+	refs = --ca->refs;
+	iot_os_mutex_unlock(&_shared.lock);
+
+	if (refs == 0) {
+		mbedtls_x509_crt_free(&ca->crt);
+		free(ca);
+	}
+}
+
+static port_net_ca_t *_port_net_ca_get(const char *ca_cert, unsigned int ca_cert_len)
+{
+	unsigned char digest[32];
+	port_net_ca_t *ca, *old_ca;
+	int ret;
+
+#if MBEDTLS_VERSION_NUMBER >= 0x03000000
+	ret = mbedtls_sha256((const unsigned char *)ca_cert, ca_cert_len, digest, 0);
+#else
+	ret = mbedtls_sha256_ret((const unsigned char *)ca_cert, ca_cert_len, digest, 0);
+#endif
+	if (ret) {
+		IOT_ERROR("mbedtls_sha256 = -0x%04X", -ret);
+		return NULL;
+	}
+
+	while ((iot_os_mutex_lock(&_shared.lock)) != IOT_OS_TRUE);
+	ca = _shared.ca;
+	if (ca && !memcmp(ca->digest, digest, sizeof(digest))) {
+		ca->refs++;
+		iot_os_mutex_unlock(&_shared.lock);
+		return ca;
+	}
+	iot_os_mutex_unlock(&_shared.lock);
+
+	ca = (port_net_ca_t *)malloc(sizeof(port_net_ca_t));
+	if (!ca) {
+		return NULL;
+	}
+
+	IOT_INFO("Loading the CA root certificate %d@%p",
+			ca_cert_len + 1, ca_cert);
+	mbedtls_x509_crt_init(&ca->crt);
+	/* iot-core passed the certificate without NULL character */
+	ret = mbedtls_x509_crt_parse(&ca->crt,
+				(const unsigned char *)ca_cert,
+				ca_cert_len + 1);
+	if (ret) {
+		IOT_ERROR("mbedtls_x509_crt_parse = -0x%04X", -ret);
+		mbedtls_x509_crt_free(&ca->crt);
+		free(ca);
+		return NULL;
+	}
+	memcpy(ca->digest, digest, sizeof(digest));
+	ca->refs = 2;	/* held by cache and caller */
+
+	while ((iot_os_mutex_lock(&_shared.lock)) != IOT_OS_TRUE);
+	old_ca = _shared.ca;
+	_shared.ca = ca;
+	iot_os_mutex_unlock(&_shared.lock);
+
+	_port_net_ca_put(old_ca);
+
+	return ca;
+}
+
+#if PORT_NET_SESSION_CACHE_SIZE > 0
+static port_net_session_t *_port_net_session_find(const char *server)
+{
+	for (int i = 0; i < PORT_NET_SESSION_CACHE_SIZE; i++) {
+		if (_shared.sessions[i].server && !strcmp(_shared.sessions[i].server, server)) {
+			return &_shared.sessions[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void _port_net_session_load(port_net_mbedtls_context_t *ctx, const char *server)
+{
+	port_net_session_t *entry;
+
+	while ((iot_os_mutex_lock(&_shared.lock)) != IOT_OS_TRUE);
+	entry = _port_net_session_find(server);
+	if (entry && mbedtls_ssl_set_session(&ctx->ssl, &entry->session) == 0) {
+		ctx->stats.session_offered = 1;
+	}
+	iot_os_mutex_unlock(&_shared.lock);
+}
+
+/* Keep session of successful handshake for next connection to the same server */
+static void _port_net_session_save(port_net_mbedtls_context_t *ctx, const char *server)
+{
+	port_net_session_t *entry;
+	mbedtls_ssl_session session;
+	char *new_server = NULL;
+
+	mbedtls_ssl_session_init(&session);
+	if (mbedtls_ssl_get_session(&ctx->ssl, &session)) {
+		mbedtls_ssl_session_free(&session);
+		return;
+	}
+
+	while ((iot_os_mutex_lock(&_shared.lock)) != IOT_OS_TRUE);
+	entry = _port_net_session_find(server);
+	if (entry == NULL) {
+		new_server = strdup(server);
+		if (new_server == NULL) {
+			iot_os_mutex_unlock(&_shared.lock);
+			mbedtls_ssl_session_free(&session);
+			return;
+		}
+		entry = &_shared.sessions[_shared.session_next];
+		_shared.session_next = (_shared.session_next + 1) % PORT_NET_SESSION_CACHE_SIZE;
+		free(entry->server);
+		entry->server = new_server;
+	}
+	mbedtls_ssl_session_free(&entry->session);
+	entry->session = session;
+	iot_os_mutex_unlock(&_shared.lock);
+}
+
+/* Server may have forgotten it, next connection does full handshake */
+static void _port_net_session_drop(const char *server)
+{
+	port_net_session_t *entry;
+
+	while ((iot_os_mutex_lock(&_shared.lock)) != IOT_OS_TRUE);
+	entry = _port_net_session_find(server);
+	if (entry) {
+		free(entry->server);
+		entry->server = NULL;
+		mbedtls_ssl_session_free(&entry->session);
+		mbedtls_ssl_session_init(&entry->session);
+	}
+	iot_os_mutex_unlock(&_shared.lock);
+}
+#endif
+
+/* Same as mbedtls_net_connect(), but name resolving and TCP connection are timed apart */
+static int _port_net_tcp_connect(port_net_mbedtls_context_t *ctx, const char *address, const char *port)
+{
+	struct addrinfo hints, *addr_list, *cur;
+	mbedtls_net_context fd;
+	unsigned int start;
+	int ret;
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP;
+
+	start = iot_os_get_tick_ms();
+	if (getaddrinfo(address, port, &hints, &addr_list) != 0) {
+		return MBEDTLS_ERR_NET_UNKNOWN_HOST;
+	}
+	ctx->stats.dns_ms = iot_os_get_tick_ms() - start;
+
+	start = iot_os_get_tick_ms();
+	ret = MBEDTLS_ERR_NET_UNKNOWN_HOST;
+	for (cur = addr_list; cur != NULL; cur = cur->ai_next) {
+		mbedtls_net_init(&fd);
+		fd.fd = socket(cur->ai_family, cur->ai_socktype, cur->ai_protocol);
+		if (fd.fd < 0) {
+			ret = MBEDTLS_ERR_NET_SOCKET_FAILED;
+			continue;
+		}
+		if (connect(fd.fd, cur->ai_addr, cur->ai_addrlen) == 0) {
+			ctx->sock_fd = fd;
+			ret = 0;
+			break;
+		}
+		mbedtls_net_free(&fd);
+		ret = MBEDTLS_ERR_NET_CONNECT_FAILED;
+	}
+	freeaddrinfo(addr_list);
+	ctx->stats.tcp_ms = iot_os_get_tick_ms() - start;
+
+	return ret;
+}
+
 static void _free_net_ctx(port_net_mbedtls_context_t *ctx)
 {
 	mbedtls_net_free(&ctx->sock_fd);
@@ -64,8 +351,8 @@ static void _free_net_ctx(port_net_mbedtls_context_t *ctx)
 	mbedtls_x509_crt_free(&ctx->own_cert);
 	mbedtls_ssl_free(&ctx->ssl);
 	mbedtls_ssl_config_free(&ctx->conf);
-	mbedtls_ctr_drbg_free(&ctx->ctr_drbg);
-	mbedtls_entropy_free(&ctx->entropy);
+	_port_net_ca_put(ctx->shared_ca);
+	ctx->shared_ca = NULL;
 }
 
 void port_net_free(PORT_NET_CONTEXT ctx)
@@ -95,6 +382,7 @@ static void _iot_net_mbedtls_debug(void *ctx, int level, const char *file, int l
 PORT_NET_CONTEXT port_net_connect(char *address, char *port, port_net_tls_config *config)
 {
 	port_net_mbedtls_context_t *new_net_context = NULL;
+	char *server = NULL;
 
 	new_net_context = (port_net_mbedtls_context_t *)malloc(sizeof(port_net_mbedtls_context_t));
 	if (!new_net_context)
@@ -102,39 +390,30 @@ PORT_NET_CONTEXT port_net_connect(char *address, char *port, port_net_tls_config
 	memset(new_net_context, 0, sizeof(port_net_mbedtls_context_t));
 
 	if (config) {
-		const char *pers = "iot_net_mbedtls";
+		unsigned int start;
 		int ret;
 
 		mbedtls_net_init(&new_net_context->sock_fd);
 		mbedtls_ssl_init(&new_net_context->ssl);
 		mbedtls_ssl_config_init(&new_net_context->conf);
 
-		mbedtls_ctr_drbg_init(&new_net_context->ctr_drbg);
-		mbedtls_entropy_init(&new_net_context->entropy);
-		ret = mbedtls_ctr_drbg_seed(&new_net_context->ctr_drbg, mbedtls_entropy_func, &new_net_context->entropy,
-					(const unsigned char *)pers, strlen((char *)pers));
-		if (ret) {
-			IOT_ERROR("mbedtls_ctr_drbg_seed = -0x%04X", -ret);
+		if (_port_net_shared_init()) {
 			goto exit;
 		}
 
-		IOT_INFO("Loading the CA root certificate %d@%p",
-				config->ca_cert_len + 1,
-				config->ca_cert);
-		mbedtls_x509_crt_init(&new_net_context->cacert);
-		/* iot-core passed the certificate without NULL character */
-		ret = mbedtls_x509_crt_parse(&new_net_context->cacert,
-					(const unsigned char *)config->ca_cert,
-					config->ca_cert_len + 1);
-		if (ret) {
-			IOT_ERROR("mbedtls_x509_crt_parse = -0x%04X", -ret);
+		new_net_context->shared_ca = _port_net_ca_get(config->ca_cert, config->ca_cert_len);
+		if (new_net_context->shared_ca == NULL) {
 			goto exit;
 		}
 
-		IOT_DEBUG("Connecting to %s:%s", address, port);
-		ret = mbedtls_net_connect(&new_net_context->sock_fd,
-				address, port,
-				MBEDTLS_NET_PROTO_TCP);
+		server = (char *)malloc(strlen(address) + strlen(port) + 2);
+		if (!server) {
+			goto exit;
+		}
+		sprintf(server, "%s:%s", address, port);
+
+		IOT_DEBUG("Connecting to %s", server);
+		ret = _port_net_tcp_connect(new_net_context, address, port);
 		if (ret) {
 			IOT_ERROR("mbedtls_net_connect = -0x%04X", -ret);
 			goto exit;
@@ -145,9 +424,12 @@ PORT_NET_CONTEXT port_net_connect(char *address, char *port, port_net_tls_config
 					MBEDTLS_SSL_TRANSPORT_STREAM,
 					MBEDTLS_SSL_PRESET_DEFAULT);
 		mbedtls_ssl_conf_authmode(&new_net_context->conf, MBEDTLS_SSL_VERIFY_REQUIRED);
-		mbedtls_ssl_conf_ca_chain(&new_net_context->conf, &new_net_context->cacert, NULL);
-		mbedtls_ssl_conf_rng(&new_net_context->conf, mbedtls_ctr_drbg_random, &new_net_context->ctr_drbg);
+		mbedtls_ssl_conf_ca_chain(&new_net_context->conf, &new_net_context->shared_ca->crt, NULL);
+		mbedtls_ssl_conf_rng(&new_net_context->conf, _port_net_random, NULL);
 		mbedtls_ssl_conf_read_timeout(&new_net_context->conf, IOT_MBEDTLS_READ_TIMEOUT_MS);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+		mbedtls_ssl_conf_session_tickets(&new_net_context->conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
 
 #ifdef CONFIG_MBEDTLS_DEBUG
 		mbedtls_ssl_conf_dbg(&new_net_context->conf, _iot_net_mbedtls_debug, NULL);
@@ -170,8 +452,13 @@ PORT_NET_CONTEXT port_net_connect(char *address, char *port, port_net_tls_config
 					&new_net_context->sock_fd,
 					mbedtls_net_send, NULL, mbedtls_net_recv_timeout);
 
+#if PORT_NET_SESSION_CACHE_SIZE > 0
+		_port_net_session_load(new_net_context, server);
+#endif
+
 		IOT_DEBUG("Performing the SSL/TLS handshake");
 
+		start = iot_os_get_tick_ms();
 		while ((ret = mbedtls_ssl_handshake(&new_net_context->ssl)) != 0) {
 			if ((ret != MBEDTLS_ERR_SSL_WANT_READ) &&
 			    (ret != MBEDTLS_ERR_SSL_WANT_WRITE)) {
@@ -179,9 +466,13 @@ PORT_NET_CONTEXT port_net_connect(char *address, char *port, port_net_tls_config
 				if (ret == MBEDTLS_ERR_X509_CERT_VERIFY_FAILED) {
 					IOT_ERROR("failed to verify the server's certificate");
 				}
+#if PORT_NET_SESSION_CACHE_SIZE > 0
+				_port_net_session_drop(server);
+#endif
 				goto exit;
 			}
 		}
+		new_net_context->stats.handshake_ms = iot_os_get_tick_ms() - start;
 
 		IOT_DEBUG("Protocol is %s", mbedtls_ssl_get_version(&new_net_context->ssl));
 		IOT_DEBUG("Ciphersuite is %s", mbedtls_ssl_get_ciphersuite(&new_net_context->ssl));
@@ -189,6 +480,9 @@ PORT_NET_CONTEXT port_net_connect(char *address, char *port, port_net_tls_config
 		ret = mbedtls_ssl_get_verify_result(&new_net_context->ssl);
 		if (ret) {
 			IOT_ERROR("mbedtls_ssl_get_verify_result = 0x%x", ret);
+#if PORT_NET_SESSION_CACHE_SIZE > 0
+			_port_net_session_drop(server);
+#endif
 			goto exit;
 		}
 #if defined(STDK_IOT_CORE_TLS_DEBUG)
@@ -199,6 +493,9 @@ PORT_NET_CONTEXT port_net_connect(char *address, char *port, port_net_tls_config
 					"!", mbedtls_ssl_get_peer_cert(&new_net_context->ssl));
 			IOT_INFO("%s\n", buf);
 		}
+#endif
+#if PORT_NET_SESSION_CACHE_SIZE > 0
+		_port_net_session_save(new_net_context, server);
 #endif
 		new_net_context->is_tls_connection = true;
 	} else {
@@ -206,8 +503,12 @@ PORT_NET_CONTEXT port_net_connect(char *address, char *port, port_net_tls_config
 		goto exit;
 	}
 
+	free(server);
 	return (PORT_NET_CONTEXT)new_net_context;
 exit:
+	if (server) {
+		free(server);
+	}
 	if (new_net_context) {
 		_free_net_ctx(new_net_context);
 		free(new_net_context);
@@ -229,18 +530,11 @@ PORT_NET_CONTEXT port_net_listen(char *port, port_net_tls_config *config)
 	mbedtls_net_init(&listen_fd);
 
 	if (config) {
-		const char *pers = "easysetup";
-
 		mbedtls_net_init(&new_net_context->sock_fd);
 		mbedtls_ssl_init(&new_net_context->ssl);
 		mbedtls_ssl_config_init(&new_net_context->conf);
 
-		mbedtls_ctr_drbg_init(&new_net_context->ctr_drbg);
-		mbedtls_entropy_init(&new_net_context->entropy);
-		ret = mbedtls_ctr_drbg_seed(&new_net_context->ctr_drbg, mbedtls_entropy_func, &new_net_context->entropy,
-					(const unsigned char *)pers, strlen((char *)pers));
-		if (ret) {
-			IOT_ERROR("mbedtls_ctr_drbg_seed = -0x%04X", -ret);
+		if (_port_net_shared_init()) {
 			goto exit;
 		}
 
@@ -274,7 +568,7 @@ PORT_NET_CONTEXT port_net_listen(char *port, port_net_tls_config *config)
 					MBEDTLS_SSL_IS_CLIENT,
 					MBEDTLS_SSL_TRANSPORT_STREAM,
 					MBEDTLS_SSL_PRESET_DEFAULT);
-		mbedtls_ssl_conf_rng(&new_net_context->conf, mbedtls_ctr_drbg_random, &new_net_context->ctr_drbg);
+		mbedtls_ssl_conf_rng(&new_net_context->conf, _port_net_random, NULL);
 		mbedtls_ssl_conf_ca_chain(&new_net_context->conf, &new_net_context->cacert, NULL);
 		mbedtls_ssl_conf_own_cert(&new_net_context->conf, &new_net_context->own_cert, NULL);
 
@@ -411,6 +705,9 @@ int port_net_read(PORT_NET_CONTEXT ctx, void *buf, size_t len)
 		}
 	} else {
 		recvLen = mbedtls_net_recv(&_ctx->sock_fd, buf, len);
+		if (recvLen == MBEDTLS_ERR_SSL_WANT_READ) {
+			recvLen = 0;
+		}
 	}
 
 	return recvLen;
@@ -428,6 +725,11 @@ int port_net_read_poll(PORT_NET_CONTEXT ctx, unsigned int wait_time_ms)
 		return -1;
 	}
 
+	/* Records already decrypted are not seen on socket */
+	if (_ctx->is_tls_connection && mbedtls_ssl_get_bytes_avail(&_ctx->ssl) > 0) {
+		return 1;
+	}
+
 	socket = _ctx->sock_fd.fd;
 	FD_ZERO(&fdset);
 	FD_SET(socket, &fdset);
@@ -442,6 +744,41 @@ int port_net_read_poll(PORT_NET_CONTEXT ctx, unsigned int wait_time_ms)
 	return ret;
 }
 
+int port_net_get_socket(PORT_NET_CONTEXT ctx)
+{
+	port_net_mbedtls_context_t *_ctx = (port_net_mbedtls_context_t *)ctx;
+
+	if (_ctx == NULL) {
+		return -1;
+	}
+
+	return _ctx->sock_fd.fd;
+}
+
+int port_net_set_nonblock(PORT_NET_CONTEXT ctx)
+{
+	int ret;
+	port_net_mbedtls_context_t *_ctx = (port_net_mbedtls_context_t *)ctx;
+
+	if (_ctx == NULL) {
+		return -1;
+	}
+
+	ret = mbedtls_net_set_nonblock(&_ctx->sock_fd);
+	if (ret) {
+		IOT_ERROR("mbedtls_net_set_nonblock = %d", ret);
+		return ret;
+	}
+
+	if (_ctx->is_tls_connection) {
+		/* Read returns at once instead of waiting for IOT_MBEDTLS_READ_TIMEOUT_MS */
+		mbedtls_ssl_set_bio(&_ctx->ssl, &_ctx->sock_fd,
+				mbedtls_net_send, mbedtls_net_recv, NULL);
+	}
+
+	return 0;
+}
+
 int port_net_write(PORT_NET_CONTEXT ctx, void *buf, size_t len)
 {
 	int sentLen = 0, ret = 0;
@@ -466,11 +803,27 @@ int port_net_write(PORT_NET_CONTEXT ctx, void *buf, size_t len)
 		}
 	} else {
 		sentLen = mbedtls_net_send(&_ctx->sock_fd, buf, len);
+		if (sentLen == MBEDTLS_ERR_SSL_WANT_WRITE) {
+			sentLen = 0;
+		}
 	}
 
 	return sentLen;
 }
 
+int port_net_get_connect_stats(PORT_NET_CONTEXT ctx, port_net_connect_stats *stats)
+{
+	port_net_mbedtls_context_t *_ctx = (port_net_mbedtls_context_t *)ctx;
+
+	if (_ctx == NULL || stats == NULL) {
+		return -1;
+	}
+
+	*stats = _ctx->stats;
+
+	return 0;
+}
+
 void port_net_close(PORT_NET_CONTEXT ctx)
 {
 	port_net_mbedtls_context_t *_ctx = (port_net_mbedtls_context_t *)ctx;
@@ -188,6 +188,11 @@ void iot_os_delay(unsigned int delay_ms)
 	vTaskDelay(pdMS_TO_TICKS(delay_ms));
 }
 
+unsigned int iot_os_get_tick_ms(void)
+{
+	return (unsigned int)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
 typedef struct Freertos_Timer {
 	TickType_t xTicksToWait;
 	TimeOut_t xTimeOut;
@@ -299,6 +304,25 @@ int iot_os_timer_start(iot_os_timer_handle timer_handle)
 	return (err == pdPASS) ? 0 : -1;
 }
 
+int iot_os_timer_change_period(iot_os_timer_handle timer_handle, unsigned int expiry_time_ms)
+{
+	BaseType_t err;
+	TickType_t period = pdMS_TO_TICKS(expiry_time_ms);
+	freertos_timer_handle_t *port_timer_handle = (freertos_timer_handle_t *)timer_handle;
+
+	if (period == 0) {
+		period = 1;
+	}
+	/* xTimerChangePeriod() starts dormant timer too */
+	err = xTimerChangePeriod(port_timer_handle->timer, period, portMAX_DELAY);
+	if (err != pdPASS) {
+		printf("Failed to change timer period\n");
+	} else {
+		port_timer_handle->is_started = true;
+	}
+	return (err == pdPASS) ? 0 : -1;
+}
+
 int iot_os_timer_stop(iot_os_timer_handle timer_handle)
 {
 	BaseType_t err;
@@ -26,6 +26,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <signal.h>
+#include <errno.h>
 #include "iot_debug.h"
 #include "iot_error.h"
 #include "iot_os_util.h"
@@ -103,22 +104,25 @@ int iot_os_thread_get_current_handle(iot_os_thread* thread_handle)
 
 /* Event Group */
 
-#define EVENT_MAX 8
-
-typedef struct {
-	unsigned char id;
-	int fd[2];
-} event_t;
-
+/*
+ * Bits live in one byte which is only changed under mutex, waiters sleep on
+ * a condition variable bound to the monotonic clock. Setting bits always
+ * takes the mutex: an unlocked "already set" check could read the value from
+ * before a waiter cleared it and skip the wake-up that waiter depends on.
+ * Only setting bits nobody waits for skips the broadcast.
+ */
 typedef struct {
-	event_t group[EVENT_MAX];
-	unsigned char event_status;
 	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	unsigned char event_status;
+	unsigned int waiters;
 } eventgroup_t;
 
 iot_os_eventgroup* iot_os_eventgroup_create(void)
 {
 	eventgroup_t *eventgroup = malloc(sizeof(eventgroup_t));
+	pthread_condattr_t attr;
+
 	if (eventgroup == NULL)
 		return NULL;
 
@@ -127,16 +131,18 @@ iot_os_eventgroup* iot_os_eventgroup_create(void)
 		return NULL;
 	}
 
-	for (int i = 0; i < EVENT_MAX; i++) {
-		eventgroup->group[i].id = (1 << i);
-		int ret = pipe(eventgroup->group[i].fd);
-		if (ret == -1) {
-			free(eventgroup);
-			return NULL;
-		}
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	if (pthread_cond_init(&eventgroup->cond, &attr)) {
+		pthread_condattr_destroy(&attr);
+		pthread_mutex_destroy(&eventgroup->mutex);
+		free(eventgroup);
+		return NULL;
 	}
+	pthread_condattr_destroy(&attr);
 
 	eventgroup->event_status = 0;
+	eventgroup->waiters = 0;
 
 	return eventgroup;
 }
@@ -145,10 +151,7 @@ void iot_os_eventgroup_delete(iot_os_eventgroup* eventgroup_handle)
 {
 	eventgroup_t* eventgroup = eventgroup_handle;
 
-	for (int i = 0; i < EVENT_MAX; i++) {
-		close(eventgroup->group[i].fd[0]);
-		close(eventgroup->group[i].fd[1]);
-	}
+	pthread_cond_destroy(&eventgroup->cond);
 	pthread_mutex_destroy(&eventgroup->mutex);
 	free(eventgroup);
 }
@@ -157,84 +160,46 @@ unsigned char iot_os_eventgroup_wait_bits(iot_os_eventgroup* eventgroup_handle,
 		const unsigned char bits_to_wait_for, const int clear_on_exit, const unsigned int wait_time_ms)
 {
 	eventgroup_t *eventgroup = eventgroup_handle;
-	fd_set readfds;
-	int fd_max = 0;
 	unsigned char event_status_backup;
+	struct timespec abstime;
+	int ret = 0;
 
-	FD_ZERO(&readfds);
-
-	for (int i = 0; i < EVENT_MAX; i++) {
-		if (eventgroup->group[i].id == (eventgroup->group[i].id & bits_to_wait_for)) {
-			FD_SET(eventgroup->group[i].fd[0], &readfds);
-			if (eventgroup->group[i].fd[0] >= fd_max) {
-				fd_max = eventgroup->group[i].fd[0];
-			}
-		}
-	}
-
-	char buf[3] = {0,};
-	struct timeval tv;
-	memset(&tv, 0x00, sizeof(tv));
-	unsigned char bits = 0x00;
-	ssize_t read_size = 0;
-
-	tv.tv_sec = wait_time_ms / 1000;
-	tv.tv_usec = (wait_time_ms % 1000) * 1000;
-
-	int ret = select(fd_max + 1, &readfds, NULL, NULL, &tv);
 	pthread_mutex_lock(&eventgroup->mutex);
-	if (ret == -1) {
-		// Select Error
-		pthread_mutex_unlock(&eventgroup->mutex);
-		return 0;
-	} else if (ret == 0) {
-		// Select Timeout
-		pthread_mutex_unlock(&eventgroup->mutex);
-		return (unsigned int)eventgroup->event_status;
-	} else {
-		// read pipe
-		for (int i = 0; i < EVENT_MAX; i++) {
-			if (eventgroup->group[i].id == (eventgroup->group[i].id & bits_to_wait_for)) {
-				if (FD_ISSET(eventgroup->group[i].fd[0], &readfds)) {
-					memset(buf, 0, sizeof(buf));
-					read_size = read(eventgroup->group[i].fd[0], buf, sizeof(buf));
-					IOT_DEBUG("read_size = %d (%d)", read_size, i);
-					bits |= eventgroup->group[i].id;
-				}
-			}
+	if (!(eventgroup->event_status & bits_to_wait_for) && wait_time_ms > 0) {
+		clock_gettime(CLOCK_MONOTONIC, &abstime);
+		abstime.tv_sec += wait_time_ms / 1000;
+		abstime.tv_nsec += (wait_time_ms % 1000) * 1000000L;
+		if (abstime.tv_nsec >= 1000000000L) {
+			abstime.tv_sec++;
+			abstime.tv_nsec -= 1000000000L;
 		}
 
-		event_status_backup = eventgroup->event_status;
-		if (clear_on_exit) {
-			eventgroup->event_status &= ~(bits);
+		eventgroup->waiters++;
+		while (!(eventgroup->event_status & bits_to_wait_for) && ret != ETIMEDOUT) {
+			ret = pthread_cond_timedwait(&eventgroup->cond, &eventgroup->mutex, &abstime);
 		}
-		pthread_mutex_unlock(&eventgroup->mutex);
+		eventgroup->waiters--;
+	}
 
-		return (unsigned int)event_status_backup;
+	event_status_backup = eventgroup->event_status;
+	if (clear_on_exit) {
+		eventgroup->event_status = event_status_backup & ~bits_to_wait_for;
 	}
+	pthread_mutex_unlock(&eventgroup->mutex);
+
+	return event_status_backup;
 }
 
 int iot_os_eventgroup_set_bits(iot_os_eventgroup* eventgroup_handle,
 		const unsigned char bits_to_set)
 {
 	eventgroup_t *eventgroup = eventgroup_handle;
-	unsigned char bits = 0;
-	ssize_t write_size = 0;
 
 	pthread_mutex_lock(&eventgroup->mutex);
-	for (int i = 0; i < EVENT_MAX; i++) {
-        if (eventgroup->group[i].id == (eventgroup->group[i].id & eventgroup->event_status)) {
-            IOT_DEBUG("already set 0x%08x (%d)", eventgroup->group[i].id, i);
-            continue;
-        }
-		if (eventgroup->group[i].id == (eventgroup->group[i].id & bits_to_set)) {
-			write_size = write(eventgroup->group[i].fd[1], "Set", strlen("Set"));
-			IOT_DEBUG("write_size = %d (%d)", write_size, i);
-			bits |= eventgroup->group[i].id;
-		}
+	eventgroup->event_status |= bits_to_set;
+	if (eventgroup->waiters) {
+		pthread_cond_broadcast(&eventgroup->cond);
 	}
-
-	eventgroup->event_status |= bits;
 	pthread_mutex_unlock(&eventgroup->mutex);
 
 	return IOT_OS_TRUE;
@@ -243,11 +208,10 @@ int iot_os_eventgroup_set_bits(iot_os_eventgroup* eventgroup_handle,
 int iot_os_eventgroup_clear_bits(iot_os_eventgroup* eventgroup_handle,
 		const unsigned char bits_to_clear)
 {
-    eventgroup_t *eventgroup = eventgroup_handle;
+	eventgroup_t *eventgroup = eventgroup_handle;
 
 	pthread_mutex_lock(&eventgroup->mutex);
-    eventgroup->event_status &= ~(bits_to_clear);
-    // TODO: clear written event to pipe
+	eventgroup->event_status &= ~bits_to_clear;
 	pthread_mutex_unlock(&eventgroup->mutex);
 
 	return IOT_OS_TRUE;
@@ -330,6 +294,15 @@ void iot_os_delay(unsigned int delay_ms)
 	nanosleep(&ts, NULL);
 }
 
+unsigned int iot_os_get_tick_ms(void)
+{
+	struct timespec ts = {0,};
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (unsigned int)((ts.tv_sec * 1000) + (ts.tv_nsec / 1000000));
+}
+
 void iot_os_timer_count_ms(iot_os_timer timer, unsigned int timeout_ms)
 {
 	timer_t* timer_id = (timer_t*) timer;
@@ -433,100 +406,354 @@ char *iot_os_strdup(const char *src)
     return strdup(src);
 }
 
+/* Timer service */
+
+#ifndef CONFIG_STDK_IOT_CORE_OS_POSIX_TIMER_SLOTS
+#define CONFIG_STDK_IOT_CORE_OS_POSIX_TIMER_SLOTS	64
+#endif
+
+#if defined(CONFIG_STDK_IOT_CORE_GATEWAY_MODE)
+#ifndef CONFIG_STDK_IOT_CORE_GATEWAY_DEVICES
+#define CONFIG_STDK_IOT_CORE_GATEWAY_DEVICES	256
+#endif
+
+/*
+ * retry, last_sent and last_received of both registration and event mqtt
+ * clients (they overlap while connecting), st_mqtt_yield() countdown,
+ * easysetup connection response, state, connection retry, rate limit,
+ * event batch and attribute cache
+ */
+#define TIMERS_PER_CONTEXT	13
+#define GATEWAY_TIMER_SLOTS	(CONFIG_STDK_IOT_CORE_GATEWAY_DEVICES * TIMERS_PER_CONTEXT)
+#endif
+
+#if defined(GATEWAY_TIMER_SLOTS) && (GATEWAY_TIMER_SLOTS > CONFIG_STDK_IOT_CORE_OS_POSIX_TIMER_SLOTS)
+#define TIMER_SLOTS	GATEWAY_TIMER_SLOTS
+#else
+#define TIMER_SLOTS	CONFIG_STDK_IOT_CORE_OS_POSIX_TIMER_SLOTS
+#endif
+
 typedef struct _posix_timer_handle {
-	timer_t timerId;
+	bool in_use;
 	bool is_started;
+	bool deleting;		/* deleted while its callback runs, freed after it returns */
 	iot_os_timer_cb user_cb;
 	void *user_data;
 	unsigned int expiry_time_ms;
+	unsigned long long deadline_ns;
+	int heap_index;		/* -1 while not armed */
 } posix_timer_handle_t;
 
-static void _port_timer_cb(union sigval timer_data)
+/*
+ * Every timer callback runs on one service thread. Armed timers are kept in
+ * a binary min-heap ordered by deadline and the thread sleeps on a monotonic
+ * condition variable until the earliest one, so arming an earlier timer only
+ * has to signal it. Timer handles are slots of a static pool, create and
+ * delete don't allocate. A slot deleted while its callback runs goes back to
+ * the pool only after the callback returns, so it can't be handed out again
+ * under the callback.
+ */
+static struct {
+	pthread_once_t once;
+	bool ready;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	posix_timer_handle_t slot[TIMER_SLOTS];
+	posix_timer_handle_t *heap[TIMER_SLOTS];
+	posix_timer_handle_t *running;	/* timer whose callback runs now */
+	int heap_len;
+	int free_slot[TIMER_SLOTS];
+	int free_len;
+} _timer_service = {
+	.once = PTHREAD_ONCE_INIT,
+};
+
+static unsigned long long _port_timer_now_ns(void)
+{
+	struct timespec ts = {0,};
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void _port_timer_heap_swap(int a, int b)
+{
+	posix_timer_handle_t *tmp = _timer_service.heap[a];
+
+	_timer_service.heap[a] = _timer_service.heap[b];
+	_timer_service.heap[b] = tmp;
+	_timer_service.heap[a]->heap_index = a;
+	_timer_service.heap[b]->heap_index = b;
+}
+
+static void _port_timer_heap_up(int index)
+{
+	int parent;
+
+	while (index > 0) {
+		parent = (index - 1) / 2;
+		if (_timer_service.heap[parent]->deadline_ns <= _timer_service.heap[index]->deadline_ns) {
+			break;
+		}
+		_port_timer_heap_swap(parent, index);
+		index = parent;
+	}
+}
+
+static void _port_timer_heap_down(int index)
+{
+	int child, smallest;
+
+	while (1) {
+		smallest = index;
+		child = 2 * index + 1;
+		if (child < _timer_service.heap_len &&
+				_timer_service.heap[child]->deadline_ns < _timer_service.heap[smallest]->deadline_ns) {
+			smallest = child;
+		}
+		child++;
+		if (child < _timer_service.heap_len &&
+				_timer_service.heap[child]->deadline_ns < _timer_service.heap[smallest]->deadline_ns) {
+			smallest = child;
+		}
+		if (smallest == index) {
+			break;
+		}
+		_port_timer_heap_swap(index, smallest);
+		index = smallest;
+	}
+}
+
+static void _port_timer_heap_remove(posix_timer_handle_t *timer)
+{
+	int index = timer->heap_index;
+
+	if (index < 0) {
+		return;
+	}
+
+	_timer_service.heap_len--;
+	if (index != _timer_service.heap_len) {
+		_port_timer_heap_swap(index, _timer_service.heap_len);
+		_port_timer_heap_down(index);
+		_port_timer_heap_up(index);
+	}
+	timer->heap_index = -1;
+}
+
+static void _port_timer_heap_insert(posix_timer_handle_t *timer)
+{
+	timer->heap_index = _timer_service.heap_len;
+	_timer_service.heap[_timer_service.heap_len++] = timer;
+	_port_timer_heap_up(timer->heap_index);
+}
+
+/* Caller holds the service mutex */
+static bool _port_timer_is_valid(posix_timer_handle_t *timer)
+{
+	size_t offset = (char *)timer - (char *)_timer_service.slot;
+
+	if ((char *)timer < (char *)_timer_service.slot || offset >= sizeof(_timer_service.slot) ||
+			offset % sizeof(posix_timer_handle_t)) {
+		return false;
+	}
+
+	return timer->in_use && !timer->deleting;
+}
+
+/* Caller holds the service mutex */
+static void _port_timer_free(posix_timer_handle_t *timer)
+{
+	timer->in_use = false;
+	timer->deleting = false;
+	_timer_service.free_slot[_timer_service.free_len++] = timer - _timer_service.slot;
+}
+
+/* Restart timer with its period, or with a new one if expiry_time_ms is given */
+static int _port_timer_arm(posix_timer_handle_t *timer, const unsigned int *expiry_time_ms)
+{
+	pthread_mutex_lock(&_timer_service.mutex);
+	if (!_port_timer_is_valid(timer)) {
+		pthread_mutex_unlock(&_timer_service.mutex);
+		IOT_ERROR("invalid timer handle %p", timer);
+		return -1;
+	}
+	if (expiry_time_ms) {
+		timer->expiry_time_ms = *expiry_time_ms;
+	}
+	_port_timer_heap_remove(timer);
+	timer->deadline_ns = _port_timer_now_ns() +
+			(unsigned long long)timer->expiry_time_ms * 1000000ULL;
+	_port_timer_heap_insert(timer);
+	__atomic_store_n(&timer->is_started, true, __ATOMIC_RELEASE);
+	if (_timer_service.heap[0] == timer) {
+		pthread_cond_signal(&_timer_service.cond);
+	}
+	pthread_mutex_unlock(&_timer_service.mutex);
+
+	return 0;
+}
+
+static void *_port_timer_service_thread(void *arg)
+{
+	posix_timer_handle_t *timer;
+	iot_os_timer_cb user_cb;
+	void *user_data;
+	struct timespec abstime;
+
+	pthread_mutex_lock(&_timer_service.mutex);
+	while (1) {
+		if (_timer_service.heap_len == 0) {
+			pthread_cond_wait(&_timer_service.cond, &_timer_service.mutex);
+			continue;
+		}
+
+		timer = _timer_service.heap[0];
+		if (timer->deadline_ns > _port_timer_now_ns()) {
+			abstime.tv_sec = timer->deadline_ns / 1000000000ULL;
+			abstime.tv_nsec = timer->deadline_ns % 1000000000ULL;
+			pthread_cond_timedwait(&_timer_service.cond, &_timer_service.mutex, &abstime);
+			continue;
+		}
+
+		_port_timer_heap_remove(timer);
+		__atomic_store_n(&timer->is_started, false, __ATOMIC_RELEASE);
+		user_cb = timer->user_cb;
+		user_data = timer->user_data;
+		_timer_service.running = timer;
+
+		pthread_mutex_unlock(&_timer_service.mutex);
+		if (user_cb) {
+			user_cb((iot_os_timer_handle)timer, user_data);
+		}
+		pthread_mutex_lock(&_timer_service.mutex);
+
+		_timer_service.running = NULL;
+		if (timer->deleting) {
+			_port_timer_free(timer);
+		}
+	}
+
+	return NULL;
+}
+
+static void _port_timer_service_init(void)
 {
-	posix_timer_handle_t *timer_handle = timer_data.sival_ptr;
-	timer_handle->is_started = false;
+	pthread_condattr_t attr;
+	pthread_attr_t thread_attr;
+	pthread_t thread;
+
+	for (int i = 0; i < TIMER_SLOTS; i++) {
+		_timer_service.free_slot[i] = TIMER_SLOTS - 1 - i;
+	}
+	_timer_service.free_len = TIMER_SLOTS;
 
-	if (timer_handle->user_cb) {
-		timer_handle->user_cb((iot_os_timer_handle)timer_handle, timer_handle->user_data);
+	if (pthread_mutex_init(&_timer_service.mutex, NULL)) {
+		return;
 	}
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	if (pthread_cond_init(&_timer_service.cond, &attr)) {
+		pthread_condattr_destroy(&attr);
+		pthread_mutex_destroy(&_timer_service.mutex);
+		return;
+	}
+	pthread_condattr_destroy(&attr);
+
+	pthread_attr_init(&thread_attr);
+	pthread_attr_setdetachstate(&thread_attr, PTHREAD_CREATE_DETACHED);
+	if (pthread_create(&thread, &thread_attr, _port_timer_service_thread, NULL)) {
+		pthread_attr_destroy(&thread_attr);
+		pthread_cond_destroy(&_timer_service.cond);
+		pthread_mutex_destroy(&_timer_service.mutex);
+		return;
+	}
+	pthread_attr_destroy(&thread_attr);
+
+	_timer_service.ready = true;
 }
 
 iot_os_timer_handle iot_os_timer_create(iot_os_timer_cb cb, unsigned int expiry_time_ms, void *user_data)
 {
 	posix_timer_handle_t *new_timer_handle;
-	int res;
-	struct sigevent sev = { 0 };
 
-	new_timer_handle = (posix_timer_handle_t *)malloc(sizeof(posix_timer_handle_t));
-	if (new_timer_handle == NULL) {
+	pthread_once(&_timer_service.once, _port_timer_service_init);
+	if (!_timer_service.ready) {
 		return NULL;
 	}
-	memset(new_timer_handle, 0, sizeof(posix_timer_handle_t));
 
-    sev.sigev_notify = SIGEV_THREAD;
-    sev.sigev_notify_function = &_port_timer_cb;
-    sev.sigev_value.sival_ptr = new_timer_handle;
-	res = timer_create(CLOCK_MONOTONIC, &sev, &new_timer_handle->timerId);
-	if (res != 0) {
-		free(new_timer_handle);
+	pthread_mutex_lock(&_timer_service.mutex);
+	if (_timer_service.free_len == 0) {
+		pthread_mutex_unlock(&_timer_service.mutex);
+		IOT_ERROR("no free timer slot (%d)", TIMER_SLOTS);
 		return NULL;
 	}
+	new_timer_handle = &_timer_service.slot[_timer_service.free_slot[--_timer_service.free_len]];
 
+	new_timer_handle->in_use = true;
+	new_timer_handle->deleting = false;
 	new_timer_handle->user_cb = cb;
 	new_timer_handle->user_data = user_data;
-	new_timer_handle->is_started = false;
+	__atomic_store_n(&new_timer_handle->is_started, false, __ATOMIC_RELEASE);
 	new_timer_handle->expiry_time_ms = expiry_time_ms;
+	new_timer_handle->heap_index = -1;
+	pthread_mutex_unlock(&_timer_service.mutex);
 
 	return (iot_os_timer_handle)new_timer_handle;
 }
 
 void iot_os_timer_delete(iot_os_timer_handle timer_handle)
 {
-	int err;
 	posix_timer_handle_t *port_timer_handle = (posix_timer_handle_t *)timer_handle;
 
-	err = timer_delete(port_timer_handle->timerId);
-	if (err != 0) {
+	pthread_mutex_lock(&_timer_service.mutex);
+	if (!_port_timer_is_valid(port_timer_handle)) {
+		pthread_mutex_unlock(&_timer_service.mutex);
 		printf("Failed to delete timer\n");
+		return;
+	}
+	_port_timer_heap_remove(port_timer_handle);
+	__atomic_store_n(&port_timer_handle->is_started, false, __ATOMIC_RELEASE);
+	port_timer_handle->user_cb = NULL;
+	if (_timer_service.running == port_timer_handle) {
+		/* Service thread frees it once the callback returns */
+		port_timer_handle->deleting = true;
+	} else {
+		_port_timer_free(port_timer_handle);
 	}
-	free(port_timer_handle);
+	pthread_mutex_unlock(&_timer_service.mutex);
 }
 
 int iot_os_timer_start(iot_os_timer_handle timer_handle)
 {
-	posix_timer_handle_t *port_timer_handle = (posix_timer_handle_t *)timer_handle;
-    struct itimerspec its = { 0,};
-	int err;
-
-	its.it_value.tv_sec = port_timer_handle->expiry_time_ms / 1000;
-	its.it_value.tv_nsec = (port_timer_handle->expiry_time_ms % 1000) * 1000;
+	return _port_timer_arm((posix_timer_handle_t *)timer_handle, NULL);
+}
 
-	err = timer_settime(port_timer_handle->timerId, 0, &its, NULL);
-	if (err != 0) {
-		printf("Failed to start timer\n");
-	} else {
-		port_timer_handle->is_started = true;
-	}
-	return err;
+int iot_os_timer_change_period(iot_os_timer_handle timer_handle, unsigned int expiry_time_ms)
+{
+	return _port_timer_arm((posix_timer_handle_t *)timer_handle, &expiry_time_ms);
 }
 
 int iot_os_timer_stop(iot_os_timer_handle timer_handle)
 {
 	posix_timer_handle_t *port_timer_handle = (posix_timer_handle_t *)timer_handle;
-    struct itimerspec its = { 0,};
-	int err;
 
-	err = timer_settime(port_timer_handle->timerId, 0, &its, NULL);
-	if (err != 0) {
-		printf("Failed to stop timer\n");
-	} else {
-		port_timer_handle->is_started = false;
+	/* Nothing to wake up, service thread just sleeps a bit longer */
+	pthread_mutex_lock(&_timer_service.mutex);
+	if (!_port_timer_is_valid(port_timer_handle)) {
+		pthread_mutex_unlock(&_timer_service.mutex);
+		return -1;
 	}
-	return err;
+	_port_timer_heap_remove(port_timer_handle);
+	__atomic_store_n(&port_timer_handle->is_started, false, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&_timer_service.mutex);
+
+	return 0;
 }
 
 bool iot_os_timer_is_active(iot_os_timer_handle timer_handle)
 {
 	posix_timer_handle_t *port_timer_handle = (posix_timer_handle_t *)timer_handle;
-	return port_timer_handle->is_started;
+	return __atomic_load_n(&port_timer_handle->is_started, __ATOMIC_ACQUIRE);
 }
@@ -30,6 +30,8 @@ SET(STDK_UNITTEST_EXTRA_CFLAGS
     CONFIG_STDK_IOT_CORE_LOG_FILE
     CONFIG_STDK_IOT_CORE_LOG_FILE_RAM_ONLY
     CONFIG_STDK_IOT_CORE_LOG_FILE_RAM_BUF_SIZE=8192
+    CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL
+    CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV
     #CONFIG_STDK_IOT_CORE_LOG_LEVEL_ERROR
     #CONFIG_STDK_IOT_CORE_LOG_LEVEL_WARN
     #CONFIG_STDK_IOT_CORE_LOG_LEVEL_INFO
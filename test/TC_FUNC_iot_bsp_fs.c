@@ -0,0 +1,263 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <iot_bsp_fs.h>
+
+#define UNUSED(x) (void**)(x)
+
+#if defined(CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV)
+#ifndef CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV_PATH
+#define CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV_PATH	"iot_nv.pack"
+#endif
+#define TEST_PACKED_NV_PATH CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV_PATH
+
+static void bsp_fs_write(const char *name, const char *data, size_t length)
+{
+    iot_bsp_fs_handle_t handle;
+
+    assert_int_equal(iot_bsp_fs_open(name, FS_READWRITE, &handle), IOT_ERROR_NONE);
+    assert_int_equal(iot_bsp_fs_write(handle, data, length), IOT_ERROR_NONE);
+    assert_int_equal(iot_bsp_fs_close(handle), IOT_ERROR_NONE);
+}
+
+static size_t bsp_fs_read(const char *name, char *buffer, size_t size)
+{
+    iot_bsp_fs_handle_t handle;
+    size_t length = size;
+
+    assert_int_equal(iot_bsp_fs_open(name, FS_READONLY, &handle), IOT_ERROR_NONE);
+    assert_int_equal(iot_bsp_fs_read(handle, buffer, &length), IOT_ERROR_NONE);
+    assert_int_equal(iot_bsp_fs_close(handle), IOT_ERROR_NONE);
+
+    return length;
+}
+
+static void assert_bsp_fs_content(const char *name, const char *data, size_t length)
+{
+    char buffer[2048];
+
+    assert_true(length < sizeof(buffer));
+    assert_int_equal(bsp_fs_read(name, buffer, sizeof(buffer)), length);
+    assert_memory_equal(buffer, data, length);
+}
+
+static void assert_bsp_fs_no_file(const char *name)
+{
+    iot_bsp_fs_handle_t handle;
+
+    assert_int_equal(iot_bsp_fs_open(name, FS_READONLY, &handle), IOT_ERROR_FS_NO_FILE);
+}
+
+static off_t packed_nv_size(void)
+{
+    struct stat st;
+
+    assert_int_equal(stat(TEST_PACKED_NV_PATH, &st), 0);
+    return st.st_size;
+}
+
+/* last deinit closes container, next init scans it again */
+static void packed_nv_reopen(void)
+{
+    assert_int_equal(iot_bsp_fs_deinit(), IOT_ERROR_NONE);
+    assert_int_equal(iot_bsp_fs_init(), IOT_ERROR_NONE);
+}
+
+int TC_iot_bsp_fs_packed_nv_setup(void **state)
+{
+    UNUSED(state);
+
+    iot_bsp_fs_init();
+    iot_bsp_fs_deinit();
+    unlink(TEST_PACKED_NV_PATH);
+
+    return (iot_bsp_fs_init() == IOT_ERROR_NONE) ? 0 : -1;
+}
+
+int TC_iot_bsp_fs_packed_nv_teardown(void **state)
+{
+    UNUSED(state);
+
+    iot_bsp_fs_deinit();
+    unlink(TEST_PACKED_NV_PATH);
+
+    return 0;
+}
+
+void TC_iot_bsp_fs_packed_nv_write_remove_reopen(void **state)
+{
+    UNUSED(state);
+
+    // Given
+    bsp_fs_write("DeviceID", "device-id-1", 11);
+    bsp_fs_write("WifiProvStatus", "DONE", 4);
+    assert_bsp_fs_content("DeviceID", "device-id-1", 11);
+
+    // When: one file is removed and container is scanned again
+    assert_int_equal(iot_bsp_fs_remove("DeviceID"), IOT_ERROR_NONE);
+    packed_nv_reopen();
+
+    // Then: removed file stays removed, the other one is intact
+    assert_bsp_fs_no_file("DeviceID");
+    assert_int_equal(iot_bsp_fs_remove("DeviceID"), IOT_ERROR_FS_NO_FILE);
+    assert_bsp_fs_content("WifiProvStatus", "DONE", 4);
+}
+
+void TC_iot_bsp_fs_packed_nv_torn_tail(void **state)
+{
+    char tail[100];
+    off_t size;
+    unsigned char byte;
+    int fd;
+    UNUSED(state);
+
+    // Given: record header, name "Tail" and data take 116 bytes without padding
+    memset(tail, 'T', sizeof(tail));
+    bsp_fs_write("CloudProvStatus", "DONE", 4);
+    bsp_fs_write("ServerURL", "mqtt-regional.smartthings.com", 29);
+    size = packed_nv_size();
+    bsp_fs_write("Tail", tail, sizeof(tail));
+
+    // When: only part of the last record made it to the file
+    assert_int_equal(iot_bsp_fs_deinit(), IOT_ERROR_NONE);
+    assert_int_equal(truncate(TEST_PACKED_NV_PATH, size + 20), 0);
+    assert_int_equal(iot_bsp_fs_init(), IOT_ERROR_NONE);
+
+    // Then: torn record is cut off and earlier records survive
+    assert_int_equal(packed_nv_size(), size);
+    assert_bsp_fs_no_file("Tail");
+    assert_bsp_fs_content("CloudProvStatus", "DONE", 4);
+    assert_bsp_fs_content("ServerURL", "mqtt-regional.smartthings.com", 29);
+
+    // Given
+    bsp_fs_write("Tail", tail, sizeof(tail));
+    assert_int_equal(packed_nv_size(), size + 116);
+
+    // When: last byte of the record is corrupted
+    assert_int_equal(iot_bsp_fs_deinit(), IOT_ERROR_NONE);
+    fd = open(TEST_PACKED_NV_PATH, O_RDWR);
+    assert_true(fd >= 0);
+    assert_int_equal(pread(fd, &byte, 1, size + 115), 1);
+    byte ^= 0xff;
+    assert_int_equal(pwrite(fd, &byte, 1, size + 115), 1);
+    close(fd);
+    assert_int_equal(iot_bsp_fs_init(), IOT_ERROR_NONE);
+
+    // Then: record failing crc is cut off as well
+    assert_int_equal(packed_nv_size(), size);
+    assert_bsp_fs_no_file("Tail");
+    assert_bsp_fs_content("ServerURL", "mqtt-regional.smartthings.com", 29);
+
+    // Then: container takes appends again after the cut
+    bsp_fs_write("Tail", "new", 3);
+    packed_nv_reopen();
+    assert_bsp_fs_content("Tail", "new", 3);
+}
+
+void TC_iot_bsp_fs_packed_nv_compaction(void **state)
+{
+    char churn[1000];
+    char live[32];
+    UNUSED(state);
+
+    // Given
+    memset(live, 'L', sizeof(live));
+    bsp_fs_write("Live", live, sizeof(live));
+
+    // When: one file is rewritten until dead records take over the log
+    for (int i = 0; i < 40; i++) {
+        memset(churn, 'a' + (i % 26), sizeof(churn));
+        bsp_fs_write("Churn", churn, sizeof(churn));
+    }
+
+    // Then: log was compacted and kept the latest record of each file
+    assert_true(packed_nv_size() < 20 * (off_t)sizeof(churn));
+    assert_bsp_fs_content("Live", live, sizeof(live));
+    assert_bsp_fs_content("Churn", churn, sizeof(churn));
+
+    // Then: compacted container scans the same
+    packed_nv_reopen();
+    assert_bsp_fs_content("Live", live, sizeof(live));
+    assert_bsp_fs_content("Churn", churn, sizeof(churn));
+}
+
+void TC_iot_bsp_fs_packed_nv_latest_record_wins(void **state)
+{
+    UNUSED(state);
+
+    // Given: older records of the file are longer and shorter than the latest one
+    bsp_fs_write("MiscInfo", "first value which is long", 25);
+    bsp_fs_write("MiscInfo", "2nd", 3);
+    bsp_fs_write("MiscInfo", "third value", 11);
+
+    // Then
+    assert_bsp_fs_content("MiscInfo", "third value", 11);
+
+    // When: container is scanned again
+    packed_nv_reopen();
+
+    // Then: stale records lose to the latest one
+    assert_bsp_fs_content("MiscInfo", "third value", 11);
+
+    // When: file is removed and written again
+    assert_int_equal(iot_bsp_fs_remove("MiscInfo"), IOT_ERROR_NONE);
+    bsp_fs_write("MiscInfo", "after remove", 12);
+    packed_nv_reopen();
+
+    // Then
+    assert_bsp_fs_content("MiscInfo", "after remove", 12);
+}
+
+void TC_iot_bsp_fs_packed_nv_spill_file_outside(void **state)
+{
+    char name[32];
+    char data[64];
+    off_t size;
+    UNUSED(state);
+
+    // Given
+    snprintf(name, sizeof(name), "%s%u", IOT_BSP_FS_SPILL_PREFIX, 7);
+    memset(data, 'S', sizeof(data));
+    unlink(name);
+    size = packed_nv_size();
+
+    // When
+    bsp_fs_write(name, data, sizeof(data));
+
+    // Then: spill file is a plain file, not a record of container
+    assert_int_equal(packed_nv_size(), size);
+    assert_int_equal(access(name, F_OK), 0);
+    assert_bsp_fs_content(name, data, sizeof(data));
+
+    // When
+    assert_int_equal(iot_bsp_fs_remove(name), IOT_ERROR_NONE);
+
+    // Then
+    assert_int_not_equal(access(name, F_OK), 0);
+    assert_int_equal(packed_nv_size(), size);
+    assert_int_equal(iot_bsp_fs_remove(name), IOT_ERROR_FS_NO_FILE);
+}
+#endif /* CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV */
@@ -22,10 +22,15 @@
 #include <cmocka.h>
 #include <st_dev.h>
 #include <string.h>
+#include <pthread.h>
 #include <iot_capability.h>
+#include <caps/iot_caps_desc.h>
 #include <iot_internal.h>
 #include <external/JSON.h>
 #include <mqtt/iot_mqtt_client.h>
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+#include <cbor.h>
+#endif
 #include "TC_MOCK_functions.h"
 
 #define UNUSED(x) (void*)(x)
@@ -717,6 +722,321 @@ void TC_st_cap_send_attr_invalid_parameter(void **state)
     free(internal_context);
 }
 
+void TC_st_cap_send_attr_desc_success(void **state)
+{
+    int sequence_number;
+    IOT_CTX *context;
+    IOT_CAP_HANDLE* cap_handle;
+    struct iot_cap_handle *internal_handle;
+    struct iot_context *internal_context;
+    iot_mqtt_packet_chunk_t *final_chunk;
+    MQTTClient *c;
+    JSON_H *root;
+    JSON_H *event;
+    UNUSED(state);
+
+    // Given
+    internal_context = (struct iot_context*) malloc(sizeof(struct iot_context));
+    assert_non_null(internal_context);
+    memset(internal_context, '\0', sizeof(struct iot_context));
+    context = (IOT_CTX*) internal_context;
+    internal_context->curr_state = IOT_STATE_CLOUD_CONNECTED;
+    internal_context->iot_events = iot_os_eventgroup_create();
+    internal_context->mqtt_event_topic = "TCtest";
+    st_mqtt_create(&internal_context->evt_mqttcli, dummy_mqtt_callback, NULL, NULL, NULL);
+    cap_handle = st_cap_handle_init(context, "main", "switchLevel", test_cap_init_callback, NULL);
+    assert_non_null(cap_handle);
+
+    // When
+    sequence_number = st_cap_send_switchLevel_level(cap_handle, 42);
+    // Then
+    assert_true(sequence_number > 0);
+    c = internal_context->evt_mqttcli;
+    final_chunk = c->write_pending_queue.head;
+    /* packet header(2bytes) + MQTTTopiclength(2bytes) + MQTTTopicstring("TCTEST", 6bytes) + packetId(2bytes) = 12 */
+    root = JSON_PARSE((char *)final_chunk->chunk_data + 12);
+    assert_non_null(root);
+    event = JSON_GET_ARRAY_ITEM(JSON_GET_OBJECT_ITEM(root, "deviceEvents"), 0);
+    assert_non_null(event);
+    assert_string_equal(JSON_GET_STRING_VALUE(JSON_GET_OBJECT_ITEM(event, "component")), "main");
+    assert_string_equal(JSON_GET_STRING_VALUE(JSON_GET_OBJECT_ITEM(event, "capability")), "switchLevel");
+    assert_string_equal(JSON_GET_STRING_VALUE(JSON_GET_OBJECT_ITEM(event, "attribute")), "level");
+    assert_int_equal(JSON_GET_OBJECT_ITEM(event, "value")->valueint, 42);
+    // Then: the only unit is added
+    assert_string_equal(JSON_GET_STRING_VALUE(JSON_GET_OBJECT_ITEM(event, "unit")), "%");
+    assert_int_equal(JSON_GET_OBJECT_ITEM(JSON_GET_OBJECT_ITEM(event, "providerData"), "sequenceNumber")->valueint,
+            sequence_number);
+    JSON_DELETE(root);
+
+    // Teardown
+    internal_handle = (struct iot_cap_handle*) cap_handle;
+    if (internal_handle->capability) {
+        iot_os_free((void*)internal_handle->capability);
+    }
+    if (internal_handle->component) {
+        iot_os_free((void*)internal_handle->component);
+    }
+    st_mqtt_destroy(internal_context->evt_mqttcli);
+    if (internal_context->cap_handle_list) {
+        iot_os_free(internal_context->cap_handle_list);
+    }
+    iot_os_free(cap_handle);
+    iot_os_eventgroup_delete(internal_context->iot_events);
+    free(context);
+}
+
+void TC_st_cap_send_attr_desc_invalid_value(void **state)
+{
+    struct iot_cap_handle internal_handle;
+    iot_cap_val_t value;
+    const char *unit;
+    const char *buttons[2] = {"pushed", "hold"};
+    UNUSED(state);
+
+    // Given: level is between 0 and 100
+    value.type = IOT_CAP_VAL_TYPE_INTEGER;
+    value.integer = 101;
+    unit = NULL;
+    // When & Then
+    assert_int_equal(iot_caps_validate_attr(&iot_caps_attr_descs[IOT_CAPS_ATTR_SWITCHLEVEL_LEVEL], &value, &unit),
+            IOT_ERROR_INVALID_ARGS);
+    value.integer = 100;
+    assert_int_equal(iot_caps_validate_attr(&iot_caps_attr_descs[IOT_CAPS_ATTR_SWITCHLEVEL_LEVEL], &value, &unit),
+            IOT_ERROR_NONE);
+    assert_string_equal(unit, "%");
+
+    // Given: wrong value type
+    value.type = IOT_CAP_VAL_TYPE_STRING;
+    value.string = "on";
+    unit = NULL;
+    // When & Then
+    assert_int_equal(iot_caps_validate_attr(&iot_caps_attr_descs[IOT_CAPS_ATTR_SWITCHLEVEL_LEVEL], &value, &unit),
+            IOT_ERROR_INVALID_ARGS);
+
+    // Given: string not in allowed values
+    value.string = "dim";
+    unit = NULL;
+    // When & Then
+    assert_int_equal(iot_caps_validate_attr(&iot_caps_attr_descs[IOT_CAPS_ATTR_SWITCH_SWITCH], &value, &unit),
+            IOT_ERROR_INVALID_ARGS);
+    value.string = "on";
+    assert_int_equal(iot_caps_validate_attr(&iot_caps_attr_descs[IOT_CAPS_ATTR_SWITCH_SWITCH], &value, &unit),
+            IOT_ERROR_NONE);
+
+    // Given: an element of string array not in allowed values
+    value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+    value.strings = (char **)buttons;
+    value.str_num = 2;
+    unit = NULL;
+    // When & Then
+    assert_int_equal(iot_caps_validate_attr(&iot_caps_attr_descs[IOT_CAPS_ATTR_BUTTON_SUPPORTEDBUTTONVALUES], &value, &unit),
+            IOT_ERROR_INVALID_ARGS);
+
+    // Given: unit not allowed
+    value.type = IOT_CAP_VAL_TYPE_NUMBER;
+    value.number = 70.5;
+    unit = "g";
+    // When & Then
+    assert_int_equal(iot_caps_validate_attr(&iot_caps_attr_descs[IOT_CAPS_ATTR_BODYWEIGHTMEASUREMENT_BODYWEIGHTMEASUREMENT],
+            &value, &unit), IOT_ERROR_INVALID_ARGS);
+
+    // Given: attribute of other capability
+    memset(&internal_handle, '\0', sizeof(struct iot_cap_handle));
+    internal_handle.component = "main";
+    internal_handle.capability = "switch";
+    // When & Then
+    assert_int_equal(st_cap_send_switchLevel_level((IOT_CAP_HANDLE *)&internal_handle, 50), IOT_ERROR_INVALID_ARGS);
+    // When & Then: value not allowed is rejected before context is used
+    assert_int_equal(st_cap_send_switch_switch((IOT_CAP_HANDLE *)&internal_handle, "dim"), IOT_ERROR_INVALID_ARGS);
+    assert_int_equal(st_cap_send_attr_desc((IOT_CAP_HANDLE *)&internal_handle, IOT_CAPS_ATTR_MAX, &value, NULL),
+            IOT_ERROR_INVALID_ARGS);
+}
+
+/* Events of several attributes don't fit in one byte of remaining length */
+static char *test_publish_payload(iot_mqtt_packet_chunk_t *chunk)
+{
+    unsigned char *pos = chunk->chunk_data + 1;
+    size_t topic_len;
+
+    while (*pos++ & 0x80);
+    topic_len = (pos[0] << 8) | pos[1];
+    /* MQTTTopiclength(2bytes) + MQTTTopicstring + packetId(2bytes) */
+    return (char *)pos + 2 + topic_len + 2;
+}
+
+static int test_publish_count(MQTTClient *c, iot_mqtt_packet_chunk_t **last)
+{
+    iot_mqtt_packet_chunk_t *chunk;
+    int count = 0;
+
+    *last = NULL;
+    for (chunk = c->write_pending_queue.head; chunk; chunk = chunk->next) {
+        *last = chunk;
+        count++;
+    }
+    return count;
+}
+
+void TC_st_cap_send_attr_cache_suppress(void **state)
+{
+    int sequence_number;
+    IOT_CTX *context;
+    IOT_CAP_HANDLE* cap_handle;
+    struct iot_cap_handle *internal_handle;
+    struct iot_context *internal_context;
+    st_attr_cache_config config = { .max_entries = 4, .deadband = 0.5, .min_interval_ms = 0 };
+    st_attr_cache_stats stats;
+    iot_cap_val_t value;
+    iot_cap_attr_option_t opt;
+    IOT_EVENT* event[3];
+    iot_mqtt_packet_chunk_t *chunk;
+    MQTTClient *c;
+    JSON_H *root;
+    JSON_H *item;
+    int published;
+    UNUSED(state);
+
+    // Given
+    internal_context = (struct iot_context*) malloc(sizeof(struct iot_context));
+    assert_non_null(internal_context);
+    memset(internal_context, '\0', sizeof(struct iot_context));
+    context = (IOT_CTX*) internal_context;
+    internal_context->curr_state = IOT_STATE_CLOUD_CONNECTED;
+    internal_context->iot_events = iot_os_eventgroup_create();
+    internal_context->mqtt_event_topic = "TCtest";
+    iot_os_mutex_init(&internal_context->evt_lock);
+    st_mqtt_create(&internal_context->evt_mqttcli, dummy_mqtt_callback, NULL, NULL, NULL);
+    c = internal_context->evt_mqttcli;
+    cap_handle = st_cap_handle_init(context, "main", "temperatureMeasurement", test_cap_init_callback, NULL);
+    assert_non_null(cap_handle);
+    assert_int_equal(st_conn_set_attr_cache(context, &config), 0);
+
+    // When: first value
+    sequence_number = st_cap_send_temperatureMeasurement_temperature(cap_handle, 20.0, "C");
+    // Then
+    assert_true(sequence_number > 0);
+
+    // When: same value and change within deadband
+    // Then: suppressed without using sequence number
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 20.0, "C"), 0);
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 20.3, "C"), 0);
+
+    // When: unit changed
+    // Then
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 20.3, "F"), sequence_number + 1);
+    // When: value changed beyond deadband
+    // Then
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 21.0, "F"), sequence_number + 2);
+
+    assert_int_equal(st_conn_get_attr_cache_stats(context, &stats), 0);
+    assert_int_equal(stats.sent, 3);
+    assert_int_equal(stats.suppressed, 2);
+    assert_int_equal(stats.entries, 1);
+
+    // When: cache disabled
+    assert_int_equal(st_conn_set_attr_cache(context, NULL), 0);
+    // Then: same value is sent again
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 21.0, "F"), sequence_number + 3);
+    assert_int_not_equal(st_conn_get_attr_cache_stats(context, &stats), 0);
+
+    // Given: cache enabled again
+    assert_int_equal(st_conn_set_attr_cache(context, &config), 0);
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 21.0, "F"), sequence_number + 4);
+    value.type = IOT_CAP_VAL_TYPE_NUMBER;
+    value.number = 21.0;
+    event[0] = st_cap_create_attr(cap_handle, "temperature", &value, "F", NULL);
+    assert_non_null(event[0]);
+    memset(&opt, '\0', sizeof(iot_cap_attr_option_t));
+    opt.state_change = 1;
+    event[1] = st_cap_create_attr_with_option(cap_handle, "temperature", &value, "F", NULL, &opt);
+    assert_non_null(event[1]);
+    opt.state_change = 0;
+    opt.command_id = "test_cmd_id";
+    event[2] = st_cap_create_attr_with_option(cap_handle, "temperature", &value, "F", NULL, &opt);
+    assert_non_null(event[2]);
+    // When: same value without option
+    // Then: suppressed
+    assert_int_equal(st_cap_send_attr(&event[0], 1), 0);
+    // When: same value with state_change or command id
+    // Then: sent anyway
+    assert_int_equal(st_cap_send_attr(&event[1], 1), sequence_number + 5);
+    assert_int_equal(st_cap_send_attr(&event[2], 1), sequence_number + 6);
+    for (int i = 0; i < 3; i++)
+        st_cap_free_attr(event[i]);
+
+    // Given: cache of two attributes
+    config.max_entries = 2;
+    assert_int_equal(st_conn_set_attr_cache(context, &config), 0);
+    for (int i = 0; i < 3; i++) {
+        value.number = 10.0 * (i + 1);
+        event[i] = st_cap_create_attr(cap_handle, i == 0 ? "tempA" : i == 1 ? "tempB" : "tempC", &value, "C", NULL);
+        assert_non_null(event[i]);
+    }
+    // When: third attribute is sent
+    assert_int_equal(st_cap_send_attr(&event[0], 1), sequence_number + 7);
+    iot_os_delay(5);
+    assert_int_equal(st_cap_send_attr(&event[1], 1), sequence_number + 8);
+    iot_os_delay(5);
+    assert_int_equal(st_cap_send_attr(&event[2], 1), sequence_number + 9);
+    // Then: least recently sent one is evicted, others are kept
+    assert_int_equal(st_cap_send_attr(&event[1], 1), 0);
+    assert_int_equal(st_cap_send_attr(&event[2], 1), 0);
+    assert_int_equal(st_cap_send_attr(&event[0], 1), sequence_number + 10);
+    assert_int_equal(st_conn_get_attr_cache_stats(context, &stats), 0);
+    assert_int_equal(stats.entries, 2);
+    for (int i = 0; i < 3; i++)
+        st_cap_free_attr(event[i]);
+
+    // Given: changed value is limited to once in 100ms
+    config.max_entries = 4;
+    config.deadband = 0;
+    config.min_interval_ms = 100;
+    assert_int_equal(st_conn_set_attr_cache(context, &config), 0);
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 30.0, "C"), sequence_number + 11);
+    published = test_publish_count(c, &chunk);
+    // When: value changes twice within interval
+    // Then: held back with own sequence number, nothing is published
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 31.0, "C"), sequence_number + 12);
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 32.0, "C"), sequence_number + 13);
+    assert_int_equal(test_publish_count(c, &chunk), published);
+    // When: interval passes
+    iot_os_delay(300);
+    // Then: only the latest held back value is published
+    assert_int_equal(test_publish_count(c, &chunk), published + 1);
+    root = JSON_PARSE(test_publish_payload(chunk));
+    assert_non_null(root);
+    item = JSON_GET_ARRAY_ITEM(JSON_GET_OBJECT_ITEM(root, "deviceEvents"), 0);
+    assert_non_null(item);
+    assert_int_equal(JSON_GET_OBJECT_ITEM(item, "value")->valueint, 32);
+    assert_int_equal(JSON_GET_OBJECT_ITEM(JSON_GET_OBJECT_ITEM(item, "providerData"), "sequenceNumber")->valueint,
+            sequence_number + 13);
+    JSON_DELETE(root);
+    // Then: published value is kept as last sent one
+    assert_int_equal(st_cap_send_temperatureMeasurement_temperature(cap_handle, 32.0, "C"), 0);
+    assert_int_equal(st_conn_get_attr_cache_stats(context, &stats), 0);
+    assert_int_equal(stats.sent, 2);
+    assert_int_equal(stats.suppressed, 2);
+    assert_int_equal(stats.entries, 1);
+
+    // Teardown
+    assert_int_equal(st_conn_set_attr_cache(context, NULL), 0);
+    internal_handle = (struct iot_cap_handle*) cap_handle;
+    if (internal_handle->capability) {
+        iot_os_free((void*)internal_handle->capability);
+    }
+    if (internal_handle->component) {
+        iot_os_free((void*)internal_handle->component);
+    }
+    st_mqtt_destroy(internal_context->evt_mqttcli);
+    if (internal_context->cap_handle_list) {
+        iot_os_free(internal_context->cap_handle_list);
+    }
+    iot_os_free(cap_handle);
+    iot_os_eventgroup_delete(internal_context->iot_events);
+    iot_os_mutex_destroy(&internal_context->evt_lock);
+    free(context);
+}
+
 bool test_cap_sub_switch_on_called;
 static void test_cap_sub_switch_on(IOT_CAP_HANDLE *HANDLE,
                           iot_cap_cmd_data_t *cmd_data, void *usr_data)
@@ -1226,9 +1546,300 @@ void TC_iot_cap_commands_cb_success(void **state)
     assert_true(test_st_cap_noti_cb_called);
 
     // Teardown
+    iot_arena_deinit(&context->cmd_arena);
     free(context);
 }
 
+void TC_iot_cap_dispatch_commands_parse_once(void **state)
+{
+    UNUSED(state);
+    struct iot_context *context;
+    iot_cap_handle_list_t cap_handle_list;
+    unsigned int dispatched_before, parsed_before;
+    unsigned int dispatched, parsed;
+    char *payload = "{\"commands\":[{\"component\":\"main\",\"capability\":\"switch\",\"command\":\"on\","
+    "\"arguments\":[true,123,\"xyz\",{\"ab\":\"xy\"},[21,22]],\"id\":\"test_id\"}]}";
+
+    // Given
+    context = (struct iot_context*)malloc(sizeof(struct iot_context));
+    assert_non_null(context);
+    memset(context, '\0', sizeof(struct iot_context));
+    cap_handle_list.next = NULL;
+    cap_handle_list.handle = malloc(sizeof(struct iot_cap_handle));
+    assert_non_null(cap_handle_list.handle);
+    memset(cap_handle_list.handle, '\0', sizeof(struct iot_cap_handle));
+    cap_handle_list.handle->capability = "switch";
+    cap_handle_list.handle->component = "main";
+    cap_handle_list.handle->cmd_list = malloc(sizeof(struct iot_cap_cmd_set_list));
+    cap_handle_list.handle->cmd_list->next = NULL;
+    cap_handle_list.handle->cmd_list->command = malloc(sizeof(struct iot_cap_cmd_set));
+    cap_handle_list.handle->cmd_list->command->cmd_type = "on";
+    cap_handle_list.handle->cmd_list->command->cmd_cb = test_cap_sub_switch_on;
+    cap_handle_list.handle->cmd_list->command->usr_data = NULL;
+    context->cap_handle_list = &cap_handle_list;
+    context->noti_cb = test_st_cap_noti_cb;
+    test_cap_sub_switch_on_called = false;
+    test_st_cap_noti_cb_called = false;
+    iot_cap_get_command_stats(context, &dispatched_before, &parsed_before);
+
+    // When
+    iot_cap_dispatch_commands(context, payload);
+
+    // Then: both handlers got the command from a single parse
+    assert_true(test_cap_sub_switch_on_called);
+    assert_true(test_st_cap_noti_cb_called);
+    iot_cap_get_command_stats(context, &dispatched, &parsed);
+    assert_int_equal(dispatched - dispatched_before, 1);
+    assert_int_equal(parsed - parsed_before, 1);
+
+    // Teardown
+    free(cap_handle_list.handle->cmd_list->command);
+    free(cap_handle_list.handle->cmd_list);
+    free(cap_handle_list.handle);
+    iot_arena_deinit(&context->cmd_arena);
+    free(context);
+}
+
+void TC_iot_cap_dispatch_commands_arena_reset(void **state)
+{
+    UNUSED(state);
+    int ret;
+    struct iot_context *context;
+    IOT_CAP_HANDLE *switch_handle;
+    st_command_arena_stats stats;
+    size_t high_water;
+    char *payload = "{\"commands\":[{\"component\":\"main\",\"capability\":\"switch\",\"command\":\"on\","
+    "\"arguments\":[true,123,\"xyz\",{\"ab\":\"xy\"},[21,22]],\"id\":\"test_id\"}]}";
+
+    // Given: arena smaller than one command message
+    context = (struct iot_context*)malloc(sizeof(struct iot_context));
+    assert_non_null(context);
+    memset(context, '\0', sizeof(struct iot_context));
+    iot_arena_init(&context->cmd_arena, 64);
+    switch_handle = st_cap_handle_init((IOT_CTX*)context, "main", "switch", NULL, NULL);
+    assert_non_null(switch_handle);
+    ret = st_cap_cmd_set_cb(switch_handle, "on", test_cap_sub_switch_on, NULL);
+    assert_int_equal(ret, 0);
+    context->noti_cb = test_st_cap_noti_cb;
+
+    // When
+    test_cap_sub_switch_on_called = false;
+    test_st_cap_noti_cb_called = false;
+    iot_cap_dispatch_commands(context, payload);
+    // Then: handled through extra blocks, which are released at the end
+    assert_true(test_cap_sub_switch_on_called);
+    assert_true(test_st_cap_noti_cb_called);
+    assert_int_equal(context->cmd_arena.used, 0);
+    assert_ptr_equal(context->cmd_arena.curr, context->cmd_arena.head);
+    high_water = context->cmd_arena.high_water;
+    assert_true(high_water > 64);
+
+    // When: same message again
+    iot_cap_dispatch_commands(context, payload);
+    // Then: it needs the same amount
+    ret = st_conn_get_command_arena_stats((IOT_CTX*)context, &stats);
+    assert_int_equal(ret, 0);
+    assert_int_equal(stats.block_size, 64);
+    assert_int_equal(stats.high_water, high_water);
+    assert_int_equal(stats.messages, 2);
+    assert_true(stats.overflows >= 2);
+
+    // When: invalid arguments
+    ret = st_conn_get_command_arena_stats(NULL, &stats);
+    // Then
+    assert_int_not_equal(ret, 0);
+
+    // Teardown
+    iot_arena_deinit(&context->cmd_arena);
+    iot_os_free((void*)context->cap_handle_list->handle->cmd_list->command->cmd_type);
+    iot_os_free(context->cap_handle_list->handle->cmd_list->command);
+    iot_os_free(context->cap_handle_list->handle->cmd_list);
+    iot_os_free((void*)context->cap_handle_list->handle->component);
+    iot_os_free((void*)context->cap_handle_list->handle->capability);
+    iot_os_free(context->cap_handle_list->handle);
+    iot_os_free(context->cap_handle_list);
+    iot_os_free(context->cap_cmd_index->entries);
+    iot_os_free(context->cap_cmd_index);
+    free(context);
+}
+
+static void test_cap_cmd_record_handle(IOT_CAP_HANDLE *cap_handle,
+                      iot_cap_cmd_data_t *cmd_data, void *usr_data)
+{
+    UNUSED(cmd_data);
+    *(IOT_CAP_HANDLE **)usr_data = cap_handle;
+}
+
+void TC_iot_cap_dispatch_commands_hashed_index(void **state)
+{
+    UNUSED(state);
+    int ret;
+    struct iot_context *context;
+    IOT_CAP_HANDLE *switch_handle;
+    IOT_CAP_HANDLE *dup_handle;
+    IOT_CAP_HANDLE *called_handle;
+    IOT_CAP_HANDLE *level_handle;
+    struct iot_cap_handle_list *handle_list;
+    struct iot_cap_cmd_set_list *cmd_list;
+    char cmd_type[16];
+    char *on_payload = "{\"commands\":[{\"component\":\"main\",\"capability\":\"switch\",\"command\":\"on\","
+    "\"arguments\":[true,123,\"xyz\",{\"ab\":\"xy\"},[21,22]],\"id\":\"test_id\"}]}";
+    char *unknown_payload = "{\"commands\":[{\"component\":\"sub\",\"capability\":\"switch\",\"command\":\"on\","
+    "\"arguments\":[],\"id\":\"test_id\"}]}";
+
+    // Given: enough commands to grow the index
+    context = (struct iot_context*)malloc(sizeof(struct iot_context));
+    assert_non_null(context);
+    memset(context, '\0', sizeof(struct iot_context));
+    switch_handle = st_cap_handle_init((IOT_CTX*)context, "main", "switch", NULL, NULL);
+    assert_non_null(switch_handle);
+    level_handle = st_cap_handle_init((IOT_CTX*)context, "main", "switchLevel", NULL, NULL);
+    assert_non_null(level_handle);
+    for (int i = 0; i < 20; i++) {
+        snprintf(cmd_type, sizeof(cmd_type), "level%d", i);
+        ret = st_cap_cmd_set_cb(level_handle, cmd_type, test_cap_cmd_cb, NULL);
+        assert_int_equal(ret, 0);
+    }
+    ret = st_cap_cmd_set_cb(switch_handle, "on", test_cap_sub_switch_on, NULL);
+    assert_int_equal(ret, 0);
+    assert_non_null(context->cap_cmd_index);
+    assert_int_equal(context->cap_cmd_index->count, 21);
+    assert_true(context->cap_cmd_index->count * 2 <= context->cap_cmd_index->capacity);
+
+    // When: registered command
+    test_cap_sub_switch_on_called = false;
+    iot_cap_dispatch_commands(context, on_payload);
+    // Then
+    assert_true(test_cap_sub_switch_on_called);
+
+    // When: same capability and command on unknown component
+    test_cap_sub_switch_on_called = false;
+    iot_cap_dispatch_commands(context, unknown_payload);
+    // Then
+    assert_false(test_cap_sub_switch_on_called);
+
+    // When: another handle of same capability registers same command
+    dup_handle = st_cap_handle_init((IOT_CTX*)context, "main", "switch", NULL, NULL);
+    assert_non_null(dup_handle);
+    ret = st_cap_cmd_set_cb(dup_handle, "on", test_cap_cmd_record_handle, &called_handle);
+    assert_int_equal(ret, 0);
+    assert_int_equal(context->cap_cmd_index->count, 21);
+    test_cap_sub_switch_on_called = false;
+    called_handle = NULL;
+    iot_cap_dispatch_commands(context, on_payload);
+    // Then: the last registration is dispatched
+    assert_false(test_cap_sub_switch_on_called);
+    assert_ptr_equal(called_handle, dup_handle);
+
+    // Teardown
+    while (context->cap_handle_list) {
+        handle_list = context->cap_handle_list;
+        context->cap_handle_list = handle_list->next;
+        while (handle_list->handle->cmd_list) {
+            cmd_list = handle_list->handle->cmd_list;
+            handle_list->handle->cmd_list = cmd_list->next;
+            iot_os_free((void*)cmd_list->command->cmd_type);
+            iot_os_free(cmd_list->command);
+            iot_os_free(cmd_list);
+        }
+        iot_os_free((void*)handle_list->handle->component);
+        iot_os_free((void*)handle_list->handle->capability);
+        iot_os_free(handle_list->handle);
+        iot_os_free(handle_list);
+    }
+    iot_os_free(context->cap_cmd_index->entries);
+    iot_os_free(context->cap_cmd_index);
+    iot_arena_deinit(&context->cmd_arena);
+    free(context);
+}
+
+void TC_iot_serialize_writer_matches_json_print(void **state)
+{
+    UNUSED(state);
+    iot_serialize_writer_t writer;
+    iot_error_t err;
+    JSON_H *root;
+    JSON_H *arr;
+    JSON_H *item;
+    JSON_H *sub;
+    char *expected;
+    uint8_t *buf;
+    size_t len;
+    size_t needed;
+    const char *strings[2] = {"abc", "x\"y\n\t\x01"};
+    const char *raw_value = " {\"k\\u00e9y\" : [1.50, -0, 2e3, \"a\\/b\\ud83d\\ude00\", {}, []], \"z\":true, \"n\":null}";
+    const char *raw_data = "[1,}";
+
+    // Given: tree made the way events were made before
+    root = JSON_CREATE_OBJECT();
+    arr = JSON_CREATE_ARRAY();
+    JSON_ADD_ITEM_TO_OBJECT(root, "deviceEvents", arr);
+    item = JSON_CREATE_OBJECT();
+    JSON_ADD_STRING_TO_OBJECT(item, "component", "main");
+    JSON_ADD_NUMBER_TO_OBJECT(item, "integer", 12);
+    JSON_ADD_NUMBER_TO_OBJECT(item, "number", 0.1);
+    JSON_ADD_NUMBER_TO_OBJECT(item, "third", 1.0 / 3);
+    JSON_ADD_NUMBER_TO_OBJECT(item, "big", 1e300);
+    JSON_ADD_BOOL_TO_OBJECT(item, "boolean", false);
+    JSON_ADD_ITEM_TO_OBJECT(item, "strings", JSON_CREATE_STRING_ARRAY(strings, 2));
+    JSON_ADD_ITEM_TO_OBJECT(item, "empty", JSON_CREATE_ARRAY());
+    JSON_ADD_ITEM_TO_OBJECT(item, "value", JSON_PARSE(raw_value));
+    JSON_ADD_ITEM_TO_OBJECT(item, "data", JSON_PARSE(raw_data));
+    sub = JSON_CREATE_OBJECT();
+    JSON_ADD_NUMBER_TO_OBJECT(sub, "sequenceNumber", 3);
+    JSON_ADD_ITEM_TO_OBJECT(item, "providerData", sub);
+    JSON_ADD_ITEM_TO_ARRAY(arr, item);
+    expected = JSON_PRINT(root);
+    assert_non_null(expected);
+
+    for (int pass = 0; pass < 2; pass++) {
+        // When: written straight, first without buffer to get required size
+        buf = NULL;
+        len = needed = 0;
+        if (pass == 1) {
+            buf = malloc(strlen(expected) + 1);
+            assert_non_null(buf);
+        }
+        iot_serialize_writer_init(&writer, IOT_SERIALIZE_FORMAT_JSON, buf, strlen(expected) + 1);
+        iot_serialize_writer_open_object(&writer, NULL);
+        iot_serialize_writer_open_array(&writer, "deviceEvents");
+        iot_serialize_writer_open_object(&writer, NULL);
+        iot_serialize_writer_add_string(&writer, "component", "main");
+        iot_serialize_writer_add_string(&writer, "unit", NULL);
+        iot_serialize_writer_add_number(&writer, "integer", 12);
+        iot_serialize_writer_add_number(&writer, "number", 0.1);
+        iot_serialize_writer_add_number(&writer, "third", 1.0 / 3);
+        iot_serialize_writer_add_number(&writer, "big", 1e300);
+        iot_serialize_writer_add_bool(&writer, "boolean", false);
+        iot_serialize_writer_add_string_array(&writer, "strings", strings, 2);
+        iot_serialize_writer_add_string_array(&writer, "empty", NULL, 0);
+        iot_serialize_writer_add_raw_json(&writer, "value", raw_value);
+        iot_serialize_writer_add_raw_json(&writer, "data", raw_data);
+        iot_serialize_writer_open_object(&writer, "providerData");
+        iot_serialize_writer_add_number(&writer, "sequenceNumber", 3);
+        iot_serialize_writer_close(&writer);
+        iot_serialize_writer_close(&writer);
+        iot_serialize_writer_close(&writer);
+        iot_serialize_writer_close(&writer);
+        err = iot_serialize_writer_finish(&writer, &len, &needed);
+
+        // Then
+        assert_int_equal(needed, strlen(expected) + 1);
+        if (pass == 0) {
+            assert_int_equal(err, IOT_ERROR_MEM_ALLOC);
+        } else {
+            assert_int_equal(err, IOT_ERROR_NONE);
+            assert_int_equal(len, strlen(expected));
+            assert_string_equal((char *)buf, expected);
+            free(buf);
+        }
+    }
+
+    // Teardown
+    free(expected);
+    JSON_DELETE(root);
+}
+
 void TC_iot_parse_noti_data_presference_updated(void** state)
 {
     iot_error_t err;
@@ -1258,38 +1869,491 @@ void TC_iot_parse_noti_data_presference_updated(void** state)
     iot_os_free(notification.raw.preferences.preferences_data);
 }
 
-void TC_iot_cap_call_init_cb_null_parameteer(void **state)
+#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)
+#define TEST_RENDER_SIZE 512
+static char test_cap_cmd_rendered[TEST_RENDER_SIZE];
+static char test_cmd_noti_rendered[TEST_RENDER_SIZE];
+
+static void test_render(char *buf, const char *fmt, ...)
 {
-    UNUSED(state);
+    va_list ap;
+    size_t len = strlen(buf);
 
-    // When handle is null
-    iot_cap_call_init_cb(NULL);
+    va_start(ap, fmt);
+    vsnprintf(buf + len, TEST_RENDER_SIZE - len, fmt, ap);
+    va_end(ap);
 }
 
-void TC_iot_cap_call_init_cb_success(void **state)
+static void test_render_cap_val(char *buf, const iot_cap_val_t *val)
 {
-    struct iot_cap_handle_list *cap_handle_list;
-
-    UNUSED(state);
-
-    // Given
-    cap_handle_list = (struct iot_cap_handle_list*)malloc(sizeof(struct iot_cap_handle_list));
-    cap_handle_list->handle = (struct iot_cap_handle*)malloc(sizeof(struct iot_cap_handle));
-    cap_handle_list->handle->init_cb = test_cap_init_callback;
-    cap_handle_list->handle->capability = iot_os_strdup("main");
-    cap_handle_list->next = NULL;
-
-    // When:
-    iot_cap_call_init_cb(cap_handle_list);
+    switch (val->type) {
+    case IOT_CAP_VAL_TYPE_BOOLEAN:
+        test_render(buf, "b:%d", val->boolean);
+        break;
+    case IOT_CAP_VAL_TYPE_INTEGER:
+        test_render(buf, "i:%d", val->integer);
+        break;
+    case IOT_CAP_VAL_TYPE_NUMBER:
+        test_render(buf, "n:%.17g", val->number);
+        break;
+    case IOT_CAP_VAL_TYPE_INT_OR_NUM:
+        test_render(buf, "i:%d|n:%.17g", val->integer, val->number);
+        break;
+    case IOT_CAP_VAL_TYPE_STRING:
+        test_render(buf, "s:%s", val->string);
+        break;
+    case IOT_CAP_VAL_TYPE_JSON_OBJECT:
+        test_render(buf, "j:%s", val->json_object);
+        break;
+    default:
+        test_render(buf, "t:%d", val->type);
+        break;
+    }
+}
 
-    // Teardown
-    iot_os_free((void*)cap_handle_list->handle->capability);
-    free(cap_handle_list->handle);
-    free(cap_handle_list);
+static void test_render_st_data(char *buf, const st_data *data)
+{
+    switch (data->data_type) {
+    case ST_DATA_TYPE_BOOLEAN:
+        test_render(buf, "b:%d", data->data.boolean);
+        break;
+    case ST_DATA_TYPE_NUMBER:
+        test_render(buf, "n:%.17g", data->data.number);
+        break;
+    case ST_DATA_TYPE_STRING:
+        test_render(buf, "s:%s", data->data.string);
+        break;
+    case ST_DATA_TYPE_RAW_JSON:
+        test_render(buf, "j:%s", data->data.raw_json);
+        break;
+    default:
+        test_render(buf, "t:%d", data->data_type);
+        break;
+    }
 }
 
-static void assert_st_cap_attr_v2_send(char *message, char *expected_component, char *expected_capability,
-                                st_attr_data *attr_data[], int expected_sequence_number)
+static void test_render_noti_data(char *buf, const iot_noti_data_t *noti_data)
+{
+    switch ((int)noti_data->type) {
+    case _IOT_NOTI_TYPE_RATE_LIMIT:
+        test_render(buf, "%d,%d,%d,%d", noti_data->raw.rate_limit.count, noti_data->raw.rate_limit.threshold,
+                noti_data->raw.rate_limit.remainingTime, noti_data->raw.rate_limit.sequenceNumber);
+        break;
+    case _IOT_NOTI_TYPE_QUOTA_REACHED:
+        test_render(buf, "%d,%d", noti_data->raw.quota.used, noti_data->raw.quota.limit);
+        break;
+    case _IOT_NOTI_TYPE_PREFERENCE_UPDATED:
+        for (size_t i = 0; i < noti_data->raw.preferences.preferences_num; i++) {
+            test_render(buf, "%s%s=", i ? "," : "", noti_data->raw.preferences.preferences_data[i].preference_name);
+            test_render_cap_val(buf, &noti_data->raw.preferences.preferences_data[i].preference_data);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void test_free_noti_data(iot_noti_data_t *noti_data)
+{
+    iot_preference_data *preference;
+
+    if ((int)noti_data->type != _IOT_NOTI_TYPE_PREFERENCE_UPDATED || !noti_data->raw.preferences.preferences_data)
+        return;
+
+    for (size_t i = 0; i < noti_data->raw.preferences.preferences_num; i++) {
+        preference = &noti_data->raw.preferences.preferences_data[i];
+        if (preference->preference_name)
+            iot_os_free(preference->preference_name);
+        if (preference->preference_data.type == IOT_CAP_VAL_TYPE_STRING && preference->preference_data.string)
+            iot_os_free(preference->preference_data.string);
+    }
+    iot_os_free(noti_data->raw.preferences.preferences_data);
+}
+
+static CborError test_json_to_cbor(CborEncoder *encoder, JSON_H *item)
+{
+    CborEncoder container;
+    CborError err;
+    JSON_H *child;
+    double number;
+
+    if (JSON_IS_OBJECT(item) || JSON_IS_ARRAY(item)) {
+        if (JSON_IS_OBJECT(item))
+            err = cbor_encoder_create_map(encoder, &container, JSON_GET_ARRAY_SIZE(item));
+        else
+            err = cbor_encoder_create_array(encoder, &container, JSON_GET_ARRAY_SIZE(item));
+        for (child = JSON_GET_CHILD_ITEM(item); child && err == CborNoError; child = JSON_GET_NEXT_ITEM(child)) {
+            if (JSON_IS_OBJECT(item))
+                err = cbor_encode_text_stringz(&container, JSON_GET_OBJECT_ITEM_STRING(child));
+            if (err == CborNoError)
+                err = test_json_to_cbor(&container, child);
+        }
+        return err != CborNoError ? err : cbor_encoder_close_container(encoder, &container);
+    } else if (JSON_IS_BOOL(item)) {
+        return cbor_encode_boolean(encoder, JSON_IS_TRUE(item));
+    } else if (JSON_IS_NUMBER(item)) {
+        number = JSON_GET_NUMBER_VALUE(item);
+        if (number == (double)(int64_t)number)
+            return cbor_encode_int(encoder, (int64_t)number);
+        return cbor_encode_double(encoder, number);
+    } else if (JSON_IS_STRING(item)) {
+        return cbor_encode_text_stringz(encoder, JSON_GET_STRING_VALUE(item));
+    }
+
+    return cbor_encode_null(encoder);
+}
+
+/* Same message as given JSON text, integral numbers become CBOR integers */
+static size_t test_json_to_cbor_payload(const char *json_payload, uint8_t *buf, size_t size)
+{
+    CborEncoder encoder;
+    JSON_H *json;
+
+    json = JSON_PARSE(json_payload);
+    assert_non_null(json);
+    cbor_encoder_init(&encoder, buf, size, 0);
+    assert_int_equal(test_json_to_cbor(&encoder, json), CborNoError);
+    JSON_DELETE(json);
+
+    return cbor_encoder_get_buffer_size(&encoder, buf);
+}
+
+static void test_cap_cmd_render(IOT_CAP_HANDLE *cap_handle,
+                      iot_cap_cmd_data_t *cmd_data, void *usr_data)
+{
+    struct iot_cap_handle *handle = (struct iot_cap_handle *)cap_handle;
+
+    test_render(test_cap_cmd_rendered, "%s/%s/%s#%s %d/%d[", handle->component, handle->capability,
+            (char *)usr_data, cmd_data->command_id, cmd_data->order_of_command, cmd_data->total_commands_num);
+    for (int i = 0; i < cmd_data->num_args; i++) {
+        if (i)
+            test_render(test_cap_cmd_rendered, ",");
+        test_render_cap_val(test_cap_cmd_rendered, &cmd_data->cmd_data[i]);
+    }
+    test_render(test_cap_cmd_rendered, "]");
+}
+
+static void test_cmd_noti_render(iot_noti_data_t *noti_data, void *noti_usr_data)
+{
+    st_command_data *cmd;
+    UNUSED(noti_usr_data);
+
+    assert_int_equal(noti_data->type, IOT_NOTI_TYPE_COMMANDS);
+    for (int i = 0; i < noti_data->raw.commands.commands_num; i++) {
+        cmd = &noti_data->raw.commands.commands_data[i];
+        test_render(test_cmd_noti_rendered, "%s/%s/%s#%s[", cmd->custom_component_name, cmd->custom_cap_name,
+                cmd->custom_command_name, cmd->command_id);
+        for (int j = 0; j < cmd->param_num; j++) {
+            if (j)
+                test_render(test_cmd_noti_rendered, ",");
+            test_render_st_data(test_cmd_noti_rendered, &cmd->param_list[j]);
+        }
+        test_render(test_cmd_noti_rendered, "]");
+    }
+}
+
+static void test_cap_free_handles(struct iot_context *context)
+{
+    struct iot_cap_handle_list *handle_list;
+    struct iot_cap_cmd_set_list *cmd_list;
+
+    while (context->cap_handle_list) {
+        handle_list = context->cap_handle_list;
+        context->cap_handle_list = handle_list->next;
+        while (handle_list->handle->cmd_list) {
+            cmd_list = handle_list->handle->cmd_list;
+            handle_list->handle->cmd_list = cmd_list->next;
+            iot_os_free((void*)cmd_list->command->cmd_type);
+            iot_os_free(cmd_list->command);
+            iot_os_free(cmd_list);
+        }
+        iot_os_free((void*)handle_list->handle->component);
+        iot_os_free((void*)handle_list->handle->capability);
+        iot_os_free(handle_list->handle);
+        iot_os_free(handle_list);
+    }
+    iot_os_free(context->cap_cmd_index->entries);
+    iot_os_free(context->cap_cmd_index);
+}
+
+void TC_iot_cap_dispatch_commands_cbor_matches_json(void **state)
+{
+    UNUSED(state);
+    int ret;
+    struct iot_context *context;
+    IOT_CAP_HANDLE *switch_handle;
+    IOT_CAP_HANDLE *level_handle;
+    char json_cap_cmd[TEST_RENDER_SIZE];
+    char json_cmd_noti[TEST_RENDER_SIZE];
+    uint8_t cbor_payload[256];
+    size_t cbor_len;
+    unsigned int dispatched, parsed;
+    size_t high_water;
+    /* {"commands": array of 100000 items} without any item */
+    const uint8_t forged_count[] = {0xa1, 0x68, 'c', 'o', 'm', 'm', 'a', 'n', 'd', 's',
+            0x9a, 0x00, 0x01, 0x86, 0xa0};
+    char *payload = "{\"commands\":[{\"component\":\"main\",\"capability\":\"switch\",\"command\":\"on\","
+    "\"arguments\":[true,123,\"xyz\",{\"ab\":\"xy\",\"n\":[1,2.5,false]},[21,22]],\"id\":\"test_id\"},"
+    "{\"component\":\"main\",\"capability\":\"switchLevel\",\"command\":\"setLevel\","
+    "\"arguments\":[-2.5],\"id\":\"test_id2\"}]}";
+
+    // Given: both handler flavors registered
+    context = (struct iot_context*)malloc(sizeof(struct iot_context));
+    assert_non_null(context);
+    memset(context, '\0', sizeof(struct iot_context));
+    switch_handle = st_cap_handle_init((IOT_CTX*)context, "main", "switch", NULL, NULL);
+    assert_non_null(switch_handle);
+    ret = st_cap_cmd_set_cb(switch_handle, "on", test_cap_cmd_render, "on");
+    assert_int_equal(ret, 0);
+    level_handle = st_cap_handle_init((IOT_CTX*)context, "main", "switchLevel", NULL, NULL);
+    assert_non_null(level_handle);
+    ret = st_cap_cmd_set_cb(level_handle, "setLevel", test_cap_cmd_render, "setLevel");
+    assert_int_equal(ret, 0);
+    context->noti_cb = test_cmd_noti_render;
+    cbor_len = test_json_to_cbor_payload(payload, cbor_payload, sizeof(cbor_payload));
+
+    // When: JSON message
+    test_cap_cmd_rendered[0] = test_cmd_noti_rendered[0] = '\0';
+    iot_cap_dispatch_commands(context, payload);
+    strcpy(json_cap_cmd, test_cap_cmd_rendered);
+    strcpy(json_cmd_noti, test_cmd_noti_rendered);
+    // When: same message in CBOR
+    test_cap_cmd_rendered[0] = test_cmd_noti_rendered[0] = '\0';
+    iot_cap_dispatch_commands_cbor(context, cbor_payload, cbor_len);
+
+    // Then: both handlers see the same data as from JSON, nested args as JSON text
+    assert_string_equal(json_cap_cmd, "main/switch/on#test_id 1/2[b:1,i:123|n:123,s:xyz,"
+            "j:{\"ab\":\"xy\",\"n\":[1,2.5,false]},j:[21,22]]main/switchLevel/setLevel#test_id2 2/2[i:-2|n:-2.5]");
+    assert_string_equal(test_cap_cmd_rendered, json_cap_cmd);
+    assert_string_equal(json_cmd_noti, "main/switch/on#test_id[b:1,n:123,s:xyz,"
+            "j:{\"ab\":\"xy\",\"n\":[1,2.5,false]},j:[21,22]]main/switchLevel/setLevel#test_id2[n:-2.5]");
+    assert_string_equal(test_cmd_noti_rendered, json_cmd_noti);
+    iot_cap_get_command_stats(context, &dispatched, &parsed);
+    assert_int_equal(dispatched, 2);
+    assert_int_equal(parsed, 2);
+    assert_int_equal(context->cmd_arena.used, 0);
+
+    // When: CBOR which is not a map
+    test_cap_cmd_rendered[0] = test_cmd_noti_rendered[0] = '\0';
+    cbor_payload[0] = 0x80;
+    iot_cap_dispatch_commands_cbor(context, cbor_payload, 1);
+    // Then: nothing is dispatched
+    assert_string_equal(test_cap_cmd_rendered, "");
+    assert_string_equal(test_cmd_noti_rendered, "");
+
+    // When: commands array claims more items than there are bytes
+    test_cap_cmd_rendered[0] = test_cmd_noti_rendered[0] = '\0';
+    high_water = context->cmd_arena.high_water;
+    memcpy(cbor_payload, forged_count, sizeof(forged_count));
+    iot_cap_dispatch_commands_cbor(context, cbor_payload, sizeof(forged_count));
+    // Then: nothing is allocated for it nor dispatched
+    assert_int_equal(context->cmd_arena.high_water, high_water);
+    assert_string_equal(test_cap_cmd_rendered, "");
+    assert_string_equal(test_cmd_noti_rendered, "");
+
+    // Teardown
+    test_cap_free_handles(context);
+    iot_arena_deinit(&context->cmd_arena);
+    free(context);
+}
+
+extern iot_error_t _iot_parse_noti_data_cbor(uint8_t *data, size_t len, iot_noti_data_t *noti_data);
+
+void TC_iot_parse_noti_data_cbor_matches_json(void **state)
+{
+    iot_error_t json_err;
+    iot_error_t cbor_err;
+    iot_noti_data_t json_notification;
+    iot_noti_data_t cbor_notification;
+    char json_rendered[TEST_RENDER_SIZE];
+    char cbor_rendered[TEST_RENDER_SIZE];
+    uint8_t cbor_payload[512];
+    size_t cbor_len;
+    struct {
+        char *payload;
+        int expected_result;
+        iot_noti_type_t type;
+        char *rendered;
+    } test_data[] = {
+        { "{\"target\":\""NOTI_TEST_UUID"\",\"event\":\"device.deleted\",\"deviceId\":\""NOTI_TEST_UUID"\"}",
+                IOT_ERROR_NONE, _IOT_NOTI_TYPE_DEV_DELETED, "" },
+        { "{\"target\":\""NOTI_TEST_UUID"\",\"event\":\"device.deleting\",\"deviceId\":\""NOTI_TEST_UUID"\"}",
+                IOT_ERROR_BAD_REQ, _IOT_NOTI_TYPE_DEV_DELETED, "" },
+        { "{\"event\":\"expired.jwt\",\"deviceId\":\""NOTI_TEST_UUID"\",\"currentTime\":"NOTI_TEST_TIME"}",
+                IOT_ERROR_NONE, _IOT_NOTI_TYPE_JWT_EXPIRED, "" },
+        { "{\"event\":\"expired.jwt\",\"deviceId\":\""NOTI_TEST_UUID"\"}",
+                IOT_ERROR_BAD_REQ, _IOT_NOTI_TYPE_JWT_EXPIRED, "" },
+        { "{\"target\":\""NOTI_TEST_UUID"\",\"event\":\"quota.reached\",\"limit\":500,\"used\":501}",
+                IOT_ERROR_NONE, _IOT_NOTI_TYPE_QUOTA_REACHED, "501,500" },
+        { "{\"target\":\""NOTI_TEST_UUID"\",\"event\":\"quota.reached\",\"used\":501}",
+                IOT_ERROR_BAD_REQ, _IOT_NOTI_TYPE_QUOTA_REACHED, "" },
+        { "{\"event\":\"rate.limit.reached\",\"deviceId\":\""NOTI_TEST_UUID"\",\"count\":7,"
+                "\"threshold\":30,\"remainingTime\":60,\"eventId\":\"\",\"sequenceNumber\":128}",
+                IOT_ERROR_NONE, _IOT_NOTI_TYPE_RATE_LIMIT, "7,30,60,128" },
+        { "{\"event\":\"rate.limit.reached\",\"deviceId\":\""NOTI_TEST_UUID"\",\"count\":7,"
+                "\"threshold\":30,\"remainingTime\":60,\"eventId\":\"\"}",
+                IOT_ERROR_BAD_REQ, _IOT_NOTI_TYPE_RATE_LIMIT, "" },
+        { "{\"target\":\""NOTI_TEST_UUID"\",\"event\":\"device.preferences\",\"values\":{"
+                "\"stringPref\":{\"preferenceType\":\"string\",\"value\":\"testValue\"},"
+                "\"numberPref\":{\"preferenceType\":\"number\",\"value\":12.5},"
+                "\"boolPref\":{\"preferenceType\":\"boolean\",\"value\":true},"
+                "\"intPref\":{\"preferenceType\":\"integer\",\"value\":40}}}",
+                IOT_ERROR_NONE, _IOT_NOTI_TYPE_PREFERENCE_UPDATED,
+                "stringPref=s:testValue,numberPref=n:12.5,boolPref=b:1,intPref=i:40" },
+    };
+    UNUSED(state);
+
+    for (int i = 0; i < (int)(sizeof(test_data) / sizeof(test_data[0])); i++) {
+        // Given
+        memset(&json_notification, 0, sizeof(json_notification));
+        memset(&cbor_notification, 0, sizeof(cbor_notification));
+        json_rendered[0] = cbor_rendered[0] = '\0';
+        cbor_len = test_json_to_cbor_payload(test_data[i].payload, cbor_payload, sizeof(cbor_payload));
+        if (test_data[i].expected_result == IOT_ERROR_NONE && (int)test_data[i].type == _IOT_NOTI_TYPE_JWT_EXPIRED) {
+            expect_string(__wrap_iot_bsp_system_set_time_in_sec, time_in_sec, NOTI_TEST_TIME);
+            expect_string(__wrap_iot_bsp_system_set_time_in_sec, time_in_sec, NOTI_TEST_TIME);
+        }
+        // When
+        json_err = _iot_parse_noti_data((void*)test_data[i].payload, &json_notification);
+        cbor_err = _iot_parse_noti_data_cbor(cbor_payload, cbor_len, &cbor_notification);
+        // Then
+        assert_int_equal(json_err, test_data[i].expected_result);
+        assert_int_equal(cbor_err, json_err);
+        if (test_data[i].expected_result == IOT_ERROR_NONE) {
+            assert_int_equal(json_notification.type, test_data[i].type);
+            assert_int_equal(cbor_notification.type, json_notification.type);
+            test_render_noti_data(json_rendered, &json_notification);
+            test_render_noti_data(cbor_rendered, &cbor_notification);
+            assert_string_equal(json_rendered, test_data[i].rendered);
+            assert_string_equal(cbor_rendered, json_rendered);
+        }
+        // Teardown
+        test_free_noti_data(&json_notification);
+        test_free_noti_data(&cbor_notification);
+    }
+
+    // When: CBOR which is not a map
+    cbor_payload[0] = 0x80;
+    cbor_err = _iot_parse_noti_data_cbor(cbor_payload, 1, &cbor_notification);
+    // Then
+    assert_int_equal(cbor_err, IOT_ERROR_BAD_REQ);
+}
+
+static void test_noti_sub_cb_receive(struct iot_context *context, char *rendered)
+{
+    iot_error_t err;
+    device_work_data_t work_data;
+    struct iot_command *noti_cmd;
+    iot_noti_data_t *noti_data;
+
+    err = iot_util_queue_receive(context->work_queue, &work_data);
+    assert_int_equal(err, IOT_ERROR_NONE);
+    noti_cmd = (struct iot_command *)(work_data.param);
+    assert_int_equal(noti_cmd->cmd_type, IOT_COMMAND_NOTIFICATION_RECEIVED);
+    noti_data = noti_cmd->param;
+    assert_int_equal(noti_data->type, _IOT_NOTI_TYPE_RATE_LIMIT);
+    rendered[0] = '\0';
+    test_render_noti_data(rendered, noti_data);
+    iot_os_free(noti_cmd->param);
+    iot_os_free(noti_cmd);
+}
+
+void TC_iot_noti_sub_cb_cbor_rate_limit_reached_SUCCESS(void **state)
+{
+    struct iot_context *internal_context;
+    device_work_data_t work_data;
+    char json_rendered[TEST_RENDER_SIZE];
+    char cbor_rendered[TEST_RENDER_SIZE];
+    uint8_t cbor_payload[256];
+    size_t cbor_len;
+    char *payload = "{\"target\":\"test-target\",\"count\":51,\"threshold\":50,\"remainingTime\":3990,\"sequenceNumber\":72,\"event\":\"rate.limit.reached\",\"deviceId\":\"test-deviceId\"}";
+    UNUSED(state);
+
+    // Given
+    internal_context = (struct iot_context*) malloc(sizeof(struct iot_context));
+    assert_non_null(internal_context);
+    memset(internal_context, '\0', sizeof(struct iot_context));
+    internal_context->curr_state = IOT_STATE_CLOUD_CONNECTED;
+    internal_context->work_queue = iot_util_queue_create(sizeof(device_work_data_t));
+    internal_context->work_queue_signal = iot_os_eventgroup_create();
+    cbor_len = test_json_to_cbor_payload(payload, cbor_payload, sizeof(cbor_payload));
+
+    // When: JSON then CBOR
+    iot_noti_sub_cb(internal_context, payload);
+    test_noti_sub_cb_receive(internal_context, json_rendered);
+    internal_context->rate_limit = false;
+    iot_noti_sub_cb_cbor(internal_context, cbor_payload, cbor_len);
+    test_noti_sub_cb_receive(internal_context, cbor_rendered);
+
+    // Then: same notification is queued and rate limit is started again
+    assert_string_equal(json_rendered, "51,50,3990,72");
+    assert_string_equal(cbor_rendered, json_rendered);
+    assert_true(internal_context->rate_limit);
+    assert_non_null(internal_context->rate_limit_timeout);
+
+    // When: broken CBOR
+    iot_noti_sub_cb_cbor(internal_context, cbor_payload, cbor_len / 2);
+    // Then: ignored
+    assert_int_not_equal(iot_util_queue_receive(internal_context->work_queue, &work_data), IOT_ERROR_NONE);
+
+    // Teardown
+    iot_os_timer_delete(internal_context->rate_limit_timeout);
+    iot_os_eventgroup_delete(internal_context->work_queue_signal);
+    iot_util_queue_delete(internal_context->work_queue);
+    free(internal_context);
+}
+#else
+void TC_iot_cap_dispatch_commands_cbor_matches_json(void **state)
+{
+    UNUSED(state);
+    skip();
+}
+
+void TC_iot_parse_noti_data_cbor_matches_json(void **state)
+{
+    UNUSED(state);
+    skip();
+}
+
+void TC_iot_noti_sub_cb_cbor_rate_limit_reached_SUCCESS(void **state)
+{
+    UNUSED(state);
+    skip();
+}
+#endif /* STDK_IOT_CORE_SERIALIZE_CBOR */
+
+void TC_iot_cap_call_init_cb_null_parameteer(void **state)
+{
+    UNUSED(state);
+
+    // When handle is null
+    iot_cap_call_init_cb(NULL);
+}
+
+void TC_iot_cap_call_init_cb_success(void **state)
+{
+    struct iot_cap_handle_list *cap_handle_list;
+
+    UNUSED(state);
+
+    // Given
+    cap_handle_list = (struct iot_cap_handle_list*)malloc(sizeof(struct iot_cap_handle_list));
+    cap_handle_list->handle = (struct iot_cap_handle*)malloc(sizeof(struct iot_cap_handle));
+    cap_handle_list->handle->init_cb = test_cap_init_callback;
+    cap_handle_list->handle->capability = iot_os_strdup("main");
+    cap_handle_list->next = NULL;
+
+    // When:
+    iot_cap_call_init_cb(cap_handle_list);
+
+    // Teardown
+    iot_os_free((void*)cap_handle_list->handle->capability);
+    free(cap_handle_list->handle);
+    free(cap_handle_list);
+}
+
+static void assert_st_cap_attr_v2_send(char *message, char *expected_component, char *expected_capability,
+                                st_attr_data *attr_data[], int expected_sequence_number)
 {
     JSON_H *root;
     JSON_H *attr_array;
@@ -1510,3 +2574,432 @@ void TC_st_cap_send_attr_v2_success(void **state)
 
     free(context);
 }
+
+void TC_st_cap_send_attr_batch_coalesce(void **state)
+{
+    int sequence_number[3];
+    IOT_CTX *context;
+    IOT_CAP_HANDLE* cap_handle;
+    IOT_EVENT* event[3];
+    struct iot_cap_handle *internal_handle;
+    struct iot_context *internal_context;
+    iot_mqtt_packet_chunk_t *final_chunk;
+    MQTTClient *c;
+    JSON_H *root;
+    JSON_H *event_array;
+    JSON_H *item;
+    st_event_batch_config config = {
+        .window_ms = 60000,
+        .max_events = 2,
+        .max_bytes = 0,
+        .coalesce = true,
+    };
+    int err;
+    UNUSED(state);
+
+    // Given
+    internal_context = (struct iot_context*) malloc(sizeof(struct iot_context));
+    assert_non_null(internal_context);
+    memset(internal_context, '\0', sizeof(struct iot_context));
+    context = (IOT_CTX*) internal_context;
+    internal_context->curr_state = IOT_STATE_CLOUD_CONNECTED;
+    internal_context->mqtt_event_topic = "TCtest";
+    iot_os_mutex_init(&internal_context->evt_lock);
+    st_mqtt_create(&internal_context->evt_mqttcli, dummy_mqtt_callback, NULL, NULL, NULL);
+    c = internal_context->evt_mqttcli;
+    cap_handle = st_cap_handle_init(context, "main", "testCap", test_cap_init_callback, NULL);
+    assert_non_null(cap_handle);
+    ST_CAP_CREATE_ATTR_NUMBER(cap_handle, "testAttr", 10, NULL, NULL, event[0]);
+    assert_non_null(event[0]);
+    ST_CAP_CREATE_ATTR_NUMBER(cap_handle, "testAttr", 20, NULL, NULL, event[1]);
+    assert_non_null(event[1]);
+    ST_CAP_CREATE_ATTR_STRING(cap_handle, "otherAttr", "abc", NULL, NULL, event[2]);
+    assert_non_null(event[2]);
+    err = st_conn_set_event_batch(context, &config);
+    assert_int_equal(err, 0);
+
+    // When: same attribute twice within window
+    sequence_number[0] = st_cap_send_attr(&event[0], 1);
+    sequence_number[1] = st_cap_send_attr(&event[1], 1);
+    // Then: every call gets own sequence number and nothing is published yet
+    assert_true(sequence_number[0] > 0);
+    assert_int_equal(sequence_number[1], sequence_number[0] + 1);
+    assert_null(c->write_pending_queue.head);
+
+    // When: another attribute reaches max_events
+    sequence_number[2] = st_cap_send_attr(&event[2], 1);
+    // Then: one message with last value of testAttr and otherAttr
+    assert_int_equal(sequence_number[2], sequence_number[1] + 1);
+    final_chunk = c->write_pending_queue.head;
+    assert_non_null(final_chunk);
+    assert_null(final_chunk->next);
+    root = JSON_PARSE(test_publish_payload(final_chunk));
+    assert_non_null(root);
+    event_array = JSON_GET_OBJECT_ITEM(root, "deviceEvents");
+    assert_non_null(event_array);
+    assert_int_equal(JSON_GET_ARRAY_SIZE(event_array), 2);
+    item = JSON_GET_ARRAY_ITEM(event_array, 0);
+    assert_string_equal(JSON_GET_STRING_VALUE(JSON_GET_OBJECT_ITEM(item, "attribute")), "testAttr");
+    assert_int_equal(JSON_GET_OBJECT_ITEM(item, "value")->valueint, 20);
+    assert_int_equal(JSON_GET_OBJECT_ITEM(JSON_GET_OBJECT_ITEM(item, "providerData"), "sequenceNumber")->valueint,
+            sequence_number[1]);
+    item = JSON_GET_ARRAY_ITEM(event_array, 1);
+    assert_string_equal(JSON_GET_STRING_VALUE(JSON_GET_OBJECT_ITEM(item, "attribute")), "otherAttr");
+    assert_int_equal(JSON_GET_OBJECT_ITEM(JSON_GET_OBJECT_ITEM(item, "providerData"), "sequenceNumber")->valueint,
+            sequence_number[2]);
+    JSON_DELETE(root);
+
+    // Teardown
+    err = st_conn_set_event_batch(context, NULL);
+    assert_int_equal(err, 0);
+    assert_null(internal_context->evt_batch);
+    for (int i = 0; i < 3; i++)
+        st_cap_free_attr(event[i]);
+    internal_handle = (struct iot_cap_handle*) cap_handle;
+    if (internal_handle->capability) {
+        iot_os_free((void*)internal_handle->capability);
+    }
+    if (internal_handle->component) {
+        iot_os_free((void*)internal_handle->component);
+    }
+    st_mqtt_destroy(internal_context->evt_mqttcli);
+    if (internal_context->cap_handle_list->next) {
+        iot_os_free(internal_context->cap_handle_list->next);
+    }
+    if (internal_context->cap_handle_list) {
+        iot_os_free(internal_context->cap_handle_list);
+    }
+    iot_os_free(cap_handle);
+    iot_os_mutex_destroy(&internal_context->evt_lock);
+    free(context);
+}
+
+void TC_st_cap_send_attr_offline_replay(void **state)
+{
+    int sequence_number[3];
+    IOT_CTX *context;
+    IOT_CAP_HANDLE* cap_handle;
+    IOT_EVENT* event[3];
+    struct iot_cap_handle *internal_handle;
+    struct iot_context *internal_context;
+    iot_mqtt_packet_chunk_t *final_chunk;
+    MQTTClient *c;
+    JSON_H *root;
+    JSON_H *event_array;
+    JSON_H *item;
+    st_offline_buffer_config config = {
+        .max_events = 2,
+        .max_bytes = 0,
+        .max_spill_files = 0,
+        .replay_batch = 4,
+        .policy = ST_OFFLINE_DROP_OLDEST,
+    };
+    st_offline_buffer_stats stats;
+    int err;
+    UNUSED(state);
+
+    // Given: disconnected target with offline buffer of two events
+    internal_context = (struct iot_context*) malloc(sizeof(struct iot_context));
+    assert_non_null(internal_context);
+    memset(internal_context, '\0', sizeof(struct iot_context));
+    context = (IOT_CTX*) internal_context;
+    internal_context->curr_state = IOT_STATE_CLOUD_DISCONNECTED;
+    internal_context->mqtt_event_topic = "TCtest";
+    iot_os_mutex_init(&internal_context->evt_lock);
+    st_mqtt_create(&internal_context->evt_mqttcli, dummy_mqtt_callback, NULL, NULL, NULL);
+    c = internal_context->evt_mqttcli;
+    cap_handle = st_cap_handle_init(context, "main", "testCap", test_cap_init_callback, NULL);
+    assert_non_null(cap_handle);
+    ST_CAP_CREATE_ATTR_NUMBER(cap_handle, "testAttr", 10, NULL, NULL, event[0]);
+    assert_non_null(event[0]);
+    ST_CAP_CREATE_ATTR_NUMBER(cap_handle, "testAttr", 20, NULL, NULL, event[1]);
+    assert_non_null(event[1]);
+    ST_CAP_CREATE_ATTR_STRING(cap_handle, "otherAttr", "abc", NULL, NULL, event[2]);
+    assert_non_null(event[2]);
+    err = st_conn_set_offline_buffer(context, &config);
+    assert_int_equal(err, 0);
+
+    // When: three events while disconnected
+    for (int i = 0; i < 3; i++) {
+        sequence_number[i] = st_cap_send_attr(&event[i], 1);
+        assert_true(sequence_number[i] > 0);
+    }
+    // Then: the oldest one is dropped and nothing is published
+    assert_null(c->write_pending_queue.head);
+    err = st_conn_get_offline_buffer_stats(context, &stats);
+    assert_int_equal(err, 0);
+    assert_int_equal(stats.buffered, 3);
+    assert_int_equal(stats.dropped, 1);
+    assert_int_equal(stats.pending, 2);
+
+    // When: connected again
+    internal_context->curr_state = IOT_STATE_CLOUD_CONNECTED;
+    iot_cap_replay_offline_events(internal_context);
+    // Then: remaining events are published in one message by sequence number order
+    final_chunk = c->write_pending_queue.head;
+    assert_non_null(final_chunk);
+    assert_null(final_chunk->next);
+    root = JSON_PARSE(test_publish_payload(final_chunk));
+    assert_non_null(root);
+    event_array = JSON_GET_OBJECT_ITEM(root, "deviceEvents");
+    assert_non_null(event_array);
+    assert_int_equal(JSON_GET_ARRAY_SIZE(event_array), 2);
+    for (int i = 0; i < 2; i++) {
+        item = JSON_GET_ARRAY_ITEM(event_array, i);
+        assert_int_equal(JSON_GET_OBJECT_ITEM(JSON_GET_OBJECT_ITEM(item, "providerData"), "sequenceNumber")->valueint,
+                sequence_number[i + 1]);
+    }
+    JSON_DELETE(root);
+    err = st_conn_get_offline_buffer_stats(context, &stats);
+    assert_int_equal(err, 0);
+    assert_int_equal(stats.replayed, 2);
+    assert_int_equal(stats.pending, 0);
+
+    // Teardown
+    err = st_conn_set_offline_buffer(context, NULL);
+    assert_int_equal(err, 0);
+    assert_null(internal_context->evt_offline);
+    for (int i = 0; i < 3; i++)
+        st_cap_free_attr(event[i]);
+    internal_handle = (struct iot_cap_handle*) cap_handle;
+    if (internal_handle->capability) {
+        iot_os_free((void*)internal_handle->capability);
+    }
+    if (internal_handle->component) {
+        iot_os_free((void*)internal_handle->component);
+    }
+    st_mqtt_destroy(internal_context->evt_mqttcli);
+    if (internal_context->cap_handle_list->next) {
+        iot_os_free(internal_context->cap_handle_list->next);
+    }
+    if (internal_context->cap_handle_list) {
+        iot_os_free(internal_context->cap_handle_list);
+    }
+    iot_os_free(cap_handle);
+    iot_os_mutex_destroy(&internal_context->evt_lock);
+    free(context);
+}
+
+static void assert_event_message_sequence(iot_mqtt_packet_chunk_t *chunk, int first, int num)
+{
+    JSON_H *root;
+    JSON_H *event_array;
+    JSON_H *item;
+
+    assert_non_null(chunk);
+    root = JSON_PARSE(test_publish_payload(chunk));
+    assert_non_null(root);
+    event_array = JSON_GET_OBJECT_ITEM(root, "deviceEvents");
+    assert_non_null(event_array);
+    assert_int_equal(JSON_GET_ARRAY_SIZE(event_array), num);
+    for (int i = 0; i < num; i++) {
+        item = JSON_GET_ARRAY_ITEM(event_array, i);
+        assert_int_equal(JSON_GET_OBJECT_ITEM(JSON_GET_OBJECT_ITEM(item, "providerData"), "sequenceNumber")->valueint,
+                first + i);
+    }
+    JSON_DELETE(root);
+}
+
+void TC_st_cap_send_attr_offline_spill(void **state)
+{
+    int sequence_number[7];
+    IOT_CTX *context;
+    IOT_CAP_HANDLE* cap_handle;
+    IOT_EVENT* event;
+    struct iot_cap_handle *internal_handle;
+    struct iot_context *internal_context;
+    iot_mqtt_packet_chunk_t *chunk;
+    MQTTClient *c;
+    st_offline_buffer_config config = {
+        .max_events = 2,
+        .max_bytes = 0,
+        .max_spill_files = 2,
+        .replay_batch = 4,
+        .policy = ST_OFFLINE_DROP_OLDEST,
+    };
+    st_offline_buffer_stats stats;
+    int err;
+    UNUSED(state);
+
+    // Given: disconnected target with RAM ring of two events and two spill files
+    set_mock_iot_bsp_fs(true);
+    internal_context = (struct iot_context*) malloc(sizeof(struct iot_context));
+    assert_non_null(internal_context);
+    memset(internal_context, '\0', sizeof(struct iot_context));
+    context = (IOT_CTX*) internal_context;
+    internal_context->curr_state = IOT_STATE_CLOUD_DISCONNECTED;
+    internal_context->mqtt_event_topic = "TCtest";
+    iot_os_mutex_init(&internal_context->evt_lock);
+    st_mqtt_create(&internal_context->evt_mqttcli, dummy_mqtt_callback, NULL, NULL, NULL);
+    c = internal_context->evt_mqttcli;
+    cap_handle = st_cap_handle_init(context, "main", "testCap", test_cap_init_callback, NULL);
+    assert_non_null(cap_handle);
+    ST_CAP_CREATE_ATTR_NUMBER(cap_handle, "testAttr", 10, NULL, NULL, event);
+    assert_non_null(event);
+    err = st_conn_set_offline_buffer(context, &config);
+    assert_int_equal(err, 0);
+
+    // When: five events while disconnected
+    for (int i = 0; i < 5; i++) {
+        sequence_number[i] = st_cap_send_attr(&event, 1);
+        assert_true(sequence_number[i] > 0);
+    }
+    // Then: full rings went to numbered segment files, the newest event stays in RAM
+    assert_null(c->write_pending_queue.head);
+    assert_int_equal(mock_iot_bsp_fs_count(), 2);
+    assert_true(mock_iot_bsp_fs_exists("OfflineEvt0"));
+    assert_true(mock_iot_bsp_fs_exists("OfflineEvt1"));
+    assert_int_equal(internal_context->evt_offline->count, 1);
+    err = st_conn_get_offline_buffer_stats(context, &stats);
+    assert_int_equal(err, 0);
+    assert_int_equal(stats.buffered, 5);
+    assert_int_equal(stats.dropped, 0);
+    assert_int_equal(stats.pending, 5);
+
+    // When: two more events need a third file
+    for (int i = 5; i < 7; i++) {
+        sequence_number[i] = st_cap_send_attr(&event, 1);
+        assert_true(sequence_number[i] > 0);
+    }
+    // Then: the oldest segment is removed and its events are dropped
+    assert_int_equal(mock_iot_bsp_fs_count(), 2);
+    assert_false(mock_iot_bsp_fs_exists("OfflineEvt0"));
+    assert_true(mock_iot_bsp_fs_exists("OfflineEvt1"));
+    assert_true(mock_iot_bsp_fs_exists("OfflineEvt2"));
+    err = st_conn_get_offline_buffer_stats(context, &stats);
+    assert_int_equal(err, 0);
+    assert_int_equal(stats.buffered, 7);
+    assert_int_equal(stats.dropped, 2);
+    assert_int_equal(stats.pending, 5);
+
+    // When: connected again
+    internal_context->curr_state = IOT_STATE_CLOUD_CONNECTED;
+    iot_cap_replay_offline_events(internal_context);
+    // Then: files are replayed oldest first and removed, then the event in RAM
+    chunk = c->write_pending_queue.head;
+    assert_event_message_sequence(chunk, sequence_number[2], 2);
+    chunk = chunk->next;
+    assert_event_message_sequence(chunk, sequence_number[4], 2);
+    chunk = chunk->next;
+    assert_event_message_sequence(chunk, sequence_number[6], 1);
+    assert_null(chunk->next);
+    assert_int_equal(mock_iot_bsp_fs_count(), 0);
+    err = st_conn_get_offline_buffer_stats(context, &stats);
+    assert_int_equal(err, 0);
+    assert_int_equal(stats.replayed, 5);
+    assert_int_equal(stats.pending, 0);
+
+    // Teardown
+    err = st_conn_set_offline_buffer(context, NULL);
+    assert_int_equal(err, 0);
+    st_cap_free_attr(event);
+    internal_handle = (struct iot_cap_handle*) cap_handle;
+    if (internal_handle->capability) {
+        iot_os_free((void*)internal_handle->capability);
+    }
+    if (internal_handle->component) {
+        iot_os_free((void*)internal_handle->component);
+    }
+    st_mqtt_destroy(internal_context->evt_mqttcli);
+    if (internal_context->cap_handle_list) {
+        iot_os_free(internal_context->cap_handle_list);
+    }
+    iot_os_free(cap_handle);
+    iot_os_mutex_destroy(&internal_context->evt_lock);
+    free(context);
+    set_mock_iot_bsp_fs(false);
+}
+
+struct offline_sender {
+    IOT_CAP_HANDLE *cap_handle;
+    volatile bool stop;
+    int buffered;
+};
+
+static void *offline_sender_thread(void *arg)
+{
+    struct offline_sender *sender = (struct offline_sender *)arg;
+    IOT_EVENT *event;
+    int i = 0;
+
+    while (!sender->stop) {
+        ST_CAP_CREATE_ATTR_NUMBER(sender->cap_handle, "testAttr", i++, NULL, NULL, event);
+        if (event == NULL)
+            continue;
+        if (st_cap_send_attr(&event, 1) > 0)
+            sender->buffered++;
+        st_cap_free_attr(event);
+    }
+    return NULL;
+}
+
+void TC_st_cap_send_attr_offline_replace(void **state)
+{
+    IOT_CTX *context;
+    IOT_CAP_HANDLE* cap_handle;
+    struct iot_cap_handle *internal_handle;
+    struct iot_context *internal_context;
+    struct offline_sender sender;
+    pthread_t thread;
+    st_offline_buffer_config config = {
+        .max_events = 4,
+        .max_bytes = 0,
+        .max_spill_files = 0,
+        .replay_batch = 4,
+        .policy = ST_OFFLINE_DROP_OLDEST,
+    };
+    st_offline_buffer_stats stats;
+    int err;
+    UNUSED(state);
+
+    // Given: disconnected target whose events go to offline buffer
+    internal_context = (struct iot_context*) malloc(sizeof(struct iot_context));
+    assert_non_null(internal_context);
+    memset(internal_context, '\0', sizeof(struct iot_context));
+    context = (IOT_CTX*) internal_context;
+    internal_context->curr_state = IOT_STATE_CLOUD_DISCONNECTED;
+    internal_context->mqtt_event_topic = "TCtest";
+    iot_os_mutex_init(&internal_context->evt_lock);
+    cap_handle = st_cap_handle_init(context, "main", "testCap", test_cap_init_callback, NULL);
+    assert_non_null(cap_handle);
+    memset(&sender, '\0', sizeof(sender));
+    sender.cap_handle = cap_handle;
+    assert_int_equal(pthread_create(&thread, NULL, offline_sender_thread, &sender), 0);
+
+    // When: buffer is replaced and turned off while events are sent
+    for (int i = 0; i < 300; i++) {
+        err = st_conn_set_offline_buffer(context, (i % 3) ? &config : NULL);
+        assert_int_equal(err, 0);
+        err = st_conn_get_offline_buffer_stats(context, &stats);
+        if (i % 3) {
+            assert_int_equal(err, 0);
+            assert_true(stats.pending <= config.max_events);
+        }
+        iot_os_delay(1);
+    }
+    sender.stop = true;
+    pthread_join(thread, NULL);
+
+    // Then: events were buffered and the last buffer is consistent
+    assert_true(sender.buffered > 0);
+    err = st_conn_get_offline_buffer_stats(context, &stats);
+    assert_int_equal(err, 0);
+    assert_int_equal(stats.buffered, stats.pending + stats.dropped);
+
+    // Teardown
+    err = st_conn_set_offline_buffer(context, NULL);
+    assert_int_equal(err, 0);
+    internal_handle = (struct iot_cap_handle*) cap_handle;
+    if (internal_handle->capability) {
+        iot_os_free((void*)internal_handle->capability);
+    }
+    if (internal_handle->component) {
+        iot_os_free((void*)internal_handle->component);
+    }
+    if (internal_context->cap_handle_list) {
+        iot_os_free(internal_context->cap_handle_list);
+    }
+    iot_os_free(cap_handle);
+    iot_os_mutex_destroy(&internal_context->evt_lock);
+    free(context);
+}
@@ -0,0 +1,419 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <pthread.h>
+#include <time.h>
+#include <iot_main.h>
+#include <iot_util.h>
+#include <iot_executor.h>
+
+#define UNUSED(x) (void**)(x)
+
+#define TEST_EXECUTOR_CONTEXTS  1000
+#define TEST_EXECUTOR_WORKS     8
+#define TEST_EXECUTOR_TIMEOUT   10000
+
+struct executor_record {
+    struct iot_context *ctx;
+    int running;
+    int overlapped;
+    int next;
+    int out_of_order;
+};
+
+static struct executor_record *executor_record;
+static int executor_done;
+
+static void executor_record_work(struct iot_context *ctx, device_work_param param)
+{
+    intptr_t seq = (intptr_t)param;
+    struct executor_record *record = NULL;
+
+    for (int i = 0; i < TEST_EXECUTOR_CONTEXTS; i++) {
+        if (executor_record[i].ctx == ctx) {
+            record = &executor_record[i];
+            break;
+        }
+    }
+    if (record == NULL)
+        return;
+
+    if (__atomic_exchange_n(&record->running, 1, __ATOMIC_SEQ_CST))
+        __atomic_store_n(&record->overlapped, 1, __ATOMIC_RELAXED);
+    if (record->next != seq)
+        record->out_of_order = 1;
+    record->next++;
+    sched_yield();
+    __atomic_store_n(&record->running, 0, __ATOMIC_SEQ_CST);
+
+    __atomic_fetch_add(&executor_done, 1, __ATOMIC_SEQ_CST);
+}
+
+void TC_iot_executor_context_serialization(void **state)
+{
+    struct iot_context *ctx[TEST_EXECUTOR_CONTEXTS];
+    device_work_data_t work;
+    iot_executor_stats_t stats;
+    int total = TEST_EXECUTOR_CONTEXTS * TEST_EXECUTOR_WORKS;
+    int waited;
+    UNUSED(state);
+
+    // Given: many contexts with their own work queue on shared executor
+    executor_record = calloc(TEST_EXECUTOR_CONTEXTS, sizeof(struct executor_record));
+    assert_non_null(executor_record);
+    executor_done = 0;
+    for (int i = 0; i < TEST_EXECUTOR_CONTEXTS; i++) {
+        ctx[i] = calloc(1, sizeof(struct iot_context));
+        assert_non_null(ctx[i]);
+        ctx[i]->work_queue = iot_util_queue_create(sizeof(device_work_data_t));
+        assert_non_null(ctx[i]->work_queue);
+        executor_record[i].ctx = ctx[i];
+        assert_int_equal(iot_executor_attach(ctx[i]), IOT_ERROR_NONE);
+    }
+
+    // When: works are queued to every context at once
+    work.handler = executor_record_work;
+    for (int seq = 0; seq < TEST_EXECUTOR_WORKS; seq++) {
+        for (int i = 0; i < TEST_EXECUTOR_CONTEXTS; i++) {
+            work.param = (device_work_param)(intptr_t)seq;
+            assert_int_equal(iot_util_queue_send(ctx[i]->work_queue, &work), IOT_ERROR_NONE);
+        }
+    }
+    for (waited = 0; waited < TEST_EXECUTOR_TIMEOUT; waited++) {
+        if (__atomic_load_n(&executor_done, __ATOMIC_SEQ_CST) == total)
+            break;
+        iot_os_delay(1);
+    }
+
+    // Then: every work runs once, in order, never concurrently within one context
+    assert_int_equal(__atomic_load_n(&executor_done, __ATOMIC_SEQ_CST), total);
+    for (int i = 0; i < TEST_EXECUTOR_CONTEXTS; i++) {
+        assert_int_equal(executor_record[i].next, TEST_EXECUTOR_WORKS);
+        assert_int_equal(executor_record[i].overlapped, 0);
+        assert_int_equal(executor_record[i].out_of_order, 0);
+    }
+    iot_executor_get_stats(&stats);
+    assert_true(stats.contexts >= TEST_EXECUTOR_CONTEXTS);
+    assert_int_equal(stats.threads, IOT_EXECUTOR_WORKERS + 1);
+    print_message("%d contexts on %u threads\n", TEST_EXECUTOR_CONTEXTS, stats.threads);
+
+    // Teardown
+    for (int i = 0; i < TEST_EXECUTOR_CONTEXTS; i++) {
+        iot_executor_detach(ctx[i]);
+        iot_util_queue_delete(ctx[i]->work_queue);
+        free(ctx[i]);
+    }
+    free(executor_record);
+    executor_record = NULL;
+}
+
+struct executor_socket {
+    int fd[2];
+    int readable;
+    iot_executor_watch_t *watch;
+};
+
+static int executor_socket_readable(void *arg)
+{
+    struct executor_socket *sock = (struct executor_socket *)arg;
+    char buf[16];
+
+    while (read(sock->fd[0], buf, sizeof(buf)) > 0)
+        __atomic_fetch_add(&sock->readable, 1, __ATOMIC_SEQ_CST);
+
+    return IOT_EXECUTOR_WAIT_READ;
+}
+
+static int executor_socket_count(struct executor_socket *sock, int count, int expected)
+{
+    int waited;
+    int readable = 0;
+
+    for (waited = 0; waited < TEST_EXECUTOR_TIMEOUT; waited++) {
+        readable = 0;
+        for (int i = 0; i < count; i++)
+            readable += __atomic_load_n(&sock[i].readable, __ATOMIC_SEQ_CST);
+        if (readable == expected)
+            break;
+        iot_os_delay(1);
+    }
+
+    return readable;
+}
+
+void TC_iot_executor_socket_watch(void **state)
+{
+    struct executor_socket *sock;
+    iot_executor_stats_t stats;
+    struct rlimit limit;
+    unsigned int sockets_before;
+    int count = TEST_EXECUTOR_CONTEXTS;
+    UNUSED(state);
+
+    // Given: as many sockets as fd limit allows, up to one per context
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+        getrlimit(RLIMIT_NOFILE, &limit);
+        if (limit.rlim_cur < (rlim_t)(2 * count + 64))
+            count = (int)(limit.rlim_cur - 64) / 2;
+    }
+    sock = calloc(count, sizeof(struct executor_socket));
+    assert_non_null(sock);
+    iot_executor_get_stats(&stats);
+    sockets_before = stats.sockets;
+    for (int i = 0; i < count; i++) {
+        assert_int_equal(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sock[i].fd), 0);
+        sock[i].watch = iot_executor_watch_socket(sock[i].fd[0], executor_socket_readable, &sock[i]);
+        assert_non_null(sock[i].watch);
+    }
+    iot_executor_get_stats(&stats);
+    assert_int_equal(stats.sockets, sockets_before + count);
+
+    // When: every peer writes
+    for (int i = 0; i < count; i++)
+        assert_int_equal(write(sock[i].fd[1], "a", 1), 1);
+    // Then: one poller thread reads every socket
+    assert_int_equal(executor_socket_count(sock, count, count), count);
+
+    // When: every peer writes again
+    for (int i = 0; i < count; i++)
+        assert_int_equal(write(sock[i].fd[1], "b", 1), 1);
+    // Then: sockets are rearmed after callback
+    assert_int_equal(executor_socket_count(sock, count, 2 * count), 2 * count);
+    iot_executor_get_stats(&stats);
+    assert_int_equal(stats.threads, IOT_EXECUTOR_WORKERS + 1);
+    print_message("%d sockets on one poller thread\n", count);
+
+    // Teardown
+    for (int i = 0; i < count; i++) {
+        iot_executor_unwatch_socket(sock[i].watch);
+        while (iot_executor_is_running(&sock[i]))
+            iot_os_delay(1);
+        close(sock[i].fd[0]);
+        close(sock[i].fd[1]);
+    }
+    iot_executor_get_stats(&stats);
+    assert_int_equal(stats.sockets, sockets_before);
+    free(sock);
+}
+
+struct executor_waker {
+    int fd[2];
+    int runs;
+    int want_write;
+    iot_executor_watch_t *watch;
+};
+
+static int executor_waker_ready(void *arg)
+{
+    struct executor_waker *waker = (struct executor_waker *)arg;
+
+    __atomic_fetch_add(&waker->runs, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&waker->want_write, __ATOMIC_SEQ_CST) > 0) {
+        __atomic_fetch_sub(&waker->want_write, 1, __ATOMIC_SEQ_CST);
+        return IOT_EXECUTOR_WAIT_READ | IOT_EXECUTOR_WAIT_WRITE;
+    }
+
+    return IOT_EXECUTOR_WAIT_READ;
+}
+
+static int executor_waker_runs(struct executor_waker *waker, int expected)
+{
+    for (int waited = 0; waited < TEST_EXECUTOR_TIMEOUT; waited++) {
+        if (__atomic_load_n(&waker->runs, __ATOMIC_SEQ_CST) >= expected)
+            break;
+        iot_os_delay(1);
+    }
+    /* Give a chance to run more than expected */
+    iot_os_delay(20);
+
+    return __atomic_load_n(&waker->runs, __ATOMIC_SEQ_CST);
+}
+
+void TC_iot_executor_socket_wake_write(void **state)
+{
+    struct executor_waker waker;
+    int runs;
+    UNUSED(state);
+
+    // Given: idle socket
+    memset(&waker, 0, sizeof(waker));
+    assert_int_equal(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, waker.fd), 0);
+    waker.watch = iot_executor_watch_socket(waker.fd[0], executor_waker_ready, &waker);
+    assert_non_null(waker.watch);
+
+    // When: woken up without socket readiness
+    iot_executor_wake_socket(waker.watch);
+    // Then: callback runs once
+    assert_int_equal(executor_waker_runs(&waker, 1), 1);
+
+    // When: callback waits writable socket three times
+    __atomic_store_n(&waker.want_write, 3, __ATOMIC_SEQ_CST);
+    iot_executor_wake_socket(waker.watch);
+    // Then: writable socket runs it until it waits read only
+    assert_int_equal(executor_waker_runs(&waker, 5), 5);
+
+    // When: woken up many times in a row
+    for (int i = 0; i < 100; i++)
+        iot_executor_wake_socket(waker.watch);
+    // Then: wake-ups are merged, not lost
+    runs = executor_waker_runs(&waker, 6);
+    assert_true(runs >= 6 && runs <= 105);
+
+    // Teardown
+    iot_executor_unwatch_socket(waker.watch);
+    while (iot_executor_is_running(&waker))
+        iot_os_delay(1);
+    close(waker.fd[0]);
+    close(waker.fd[1]);
+}
+
+#define TEST_EXECUTOR_PINGPONG  5000
+#define TEST_EXECUTOR_HOP_SIGNAL    (1 << 0)
+#define TEST_EXECUTOR_HOP_KILL      (1 << 1)
+
+struct executor_pingpong {
+    int fd[2];
+    iot_util_queue_t *queue;
+    iot_os_eventgroup *signal;
+    pthread_t listener;
+    pthread_t worker;
+};
+
+static int executor_pingpong_ready(void *arg)
+{
+    struct executor_pingpong *pingpong = (struct executor_pingpong *)arg;
+    char buf[16];
+
+    while (read(pingpong->fd[0], buf, sizeof(buf)) > 0) {
+        if (write(pingpong->fd[0], buf, 1) != 1)
+            return 0;
+    }
+
+    return IOT_EXECUTOR_WAIT_READ;
+}
+
+/* Socket listen thread handing packets over to a work queue thread */
+static void *executor_pingpong_listener(void *arg)
+{
+    struct executor_pingpong *pingpong = (struct executor_pingpong *)arg;
+    char byte;
+
+    while (read(pingpong->fd[0], &byte, 1) == 1) {
+        iot_util_queue_send(pingpong->queue, &byte);
+        iot_os_eventgroup_set_bits(pingpong->signal, TEST_EXECUTOR_HOP_SIGNAL);
+    }
+    iot_os_eventgroup_set_bits(pingpong->signal, TEST_EXECUTOR_HOP_KILL);
+
+    return NULL;
+}
+
+static void *executor_pingpong_worker(void *arg)
+{
+    struct executor_pingpong *pingpong = (struct executor_pingpong *)arg;
+    unsigned char bits;
+    char byte;
+
+    for ( ; ; ) {
+        bits = iot_os_eventgroup_wait_bits(pingpong->signal,
+                TEST_EXECUTOR_HOP_SIGNAL | TEST_EXECUTOR_HOP_KILL, true, IOT_OS_WAIT_FOREVER);
+        while (iot_util_queue_receive(pingpong->queue, &byte) == IOT_ERROR_NONE) {
+            if (write(pingpong->fd[0], &byte, 1) != 1)
+                break;
+        }
+        if (bits & TEST_EXECUTOR_HOP_KILL)
+            break;
+    }
+
+    return NULL;
+}
+
+static double executor_pingpong_run(struct executor_pingpong *pingpong)
+{
+    struct timespec start, end;
+    char byte = 'p';
+    int i;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < TEST_EXECUTOR_PINGPONG; i++) {
+        if (write(pingpong->fd[1], &byte, 1) != 1 || read(pingpong->fd[1], &byte, 1) != 1)
+            break;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    assert_int_equal(i, TEST_EXECUTOR_PINGPONG);
+
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / TEST_EXECUTOR_PINGPONG;
+}
+
+void TC_iot_executor_inbound_latency(void **state)
+{
+    struct executor_pingpong pingpong;
+    iot_executor_watch_t *watch;
+    double reactor, handover;
+    UNUSED(state);
+
+    // Given: socket answered on poller thread
+    memset(&pingpong, 0, sizeof(pingpong));
+    assert_int_equal(socketpair(AF_UNIX, SOCK_STREAM, 0, pingpong.fd), 0);
+    assert_int_equal(fcntl(pingpong.fd[0], F_SETFL, O_NONBLOCK), 0);
+    watch = iot_executor_watch_socket(pingpong.fd[0], executor_pingpong_ready, &pingpong);
+    assert_non_null(watch);
+
+    // When
+    reactor = executor_pingpong_run(&pingpong);
+
+    // Given: same socket answered through listen thread and work queue thread
+    iot_executor_unwatch_socket(watch);
+    while (iot_executor_is_running(&pingpong))
+        iot_os_delay(1);
+    assert_int_equal(fcntl(pingpong.fd[0], F_SETFL, 0), 0);
+    pingpong.queue = iot_util_queue_create(sizeof(char));
+    pingpong.signal = iot_os_eventgroup_create();
+    assert_non_null(pingpong.queue);
+    assert_non_null(pingpong.signal);
+    assert_int_equal(pthread_create(&pingpong.worker, NULL, executor_pingpong_worker, &pingpong), 0);
+    assert_int_equal(pthread_create(&pingpong.listener, NULL, executor_pingpong_listener, &pingpong), 0);
+
+    // When
+    handover = executor_pingpong_run(&pingpong);
+
+    // Then: every round trip completes, latency is only reported
+    print_message("inbound round trip : poller %.1f ns, listen thread to work queue %.1f ns\n",
+            reactor, handover);
+
+    // Teardown
+    shutdown(pingpong.fd[1], SHUT_RDWR);
+    pthread_join(pingpong.listener, NULL);
+    pthread_join(pingpong.worker, NULL);
+    close(pingpong.fd[0]);
+    close(pingpong.fd[1]);
+    iot_util_queue_delete(pingpong.queue);
+    iot_os_eventgroup_delete(pingpong.signal);
+}
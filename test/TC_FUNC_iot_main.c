@@ -22,6 +22,7 @@
 #include <st_dev.h>
 #include <string.h>
 #include <stdbool.h>
+#include <malloc.h>
 #include <iot_main.h>
 #include <iot_internal.h>
 #include <iot_nv_data.h>
@@ -200,6 +201,48 @@ void TC_st_conn_init_success(void **state)
     iot_os_free(internal_context);
 }
 
+void TC_st_conn_init_context_memory(void **state)
+{
+    IOT_CTX *context;
+    struct iot_context *internal_context;
+    size_t heap_before, heap_after;
+    size_t count = 0;
+    UNUSED(state);
+
+    // Given
+    heap_before = mallinfo2().uordblks;
+    // When: context is set up by st_conn_init() as applications do
+    context = st_conn_init(sample_onboarding_config, sizeof(sample_onboarding_config), sample_device_info, sizeof(sample_device_info));
+    heap_after = mallinfo2().uordblks;
+    // Then
+    assert_non_null(context);
+    internal_context = (struct iot_context*) context;
+    assert_true(heap_after - heap_before >= sizeof(struct iot_context));
+    print_message("st_conn_init() context takes %zu heap bytes (struct %zu, nv copy of device info %zu)\n",
+            heap_after - heap_before, sizeof(struct iot_context), sizeof(sample_device_info) + 1);
+
+    //Teardown
+    iot_os_eventgroup_set_bits(internal_context->work_queue_signal, DEVICE_WORK_QUEUE_KILL_SIGNAL);
+    while (internal_context->work_queue_thread && count < 100) {
+        iot_os_delay(50);
+        count++;
+    }
+    if (internal_context->work_queue_thread) {
+        print_error("Failed to kill work queue thread\n");
+        return;
+    }
+    iot_os_mutex_destroy(&internal_context->evt_lock);
+    iot_os_mutex_destroy(&internal_context->st_conn_lock);
+    iot_os_eventgroup_delete(internal_context->work_queue_signal);
+    iot_os_eventgroup_delete(internal_context->iot_events);
+    iot_os_eventgroup_delete(internal_context->usr_events);
+    iot_util_queue_delete(internal_context->work_queue);
+    iot_api_device_info_mem_free(&internal_context->device_info);
+    iot_api_onboarding_config_mem_free(&internal_context->devconf);
+    iot_nv_deinit();
+    iot_os_free(internal_context);
+}
+
 void TC_st_conn_cleanup_invalid_parameters(void **state)
 {
     IOT_CTX *context;
@@ -26,6 +26,7 @@
 #include <iot_internal.h>
 #include <root_ca.h>
 #include <mqtt/iot_mqtt_client.h>
+#include <mqtt/iot_mqtt_inflight.h>
 #include "TC_MOCK_functions.h"
 #define UNUSED(x) (void**)(x)
 
@@ -82,6 +83,317 @@ void TC_st_mqtt_create_failure(void** state)
     assert_int_equal(err, E_ST_MQTT_FAILURE);
 }
 
+void TC_st_mqtt_get_chunk_pool_stats(void** state)
+{
+    int err;
+    st_mqtt_client client;
+    st_mqtt_chunk_pool_stats stats;
+    UNUSED(state);
+
+    // Given
+    set_mock_detect_memory_leak(true);
+    err = st_mqtt_create(&client, _dummy_mqtt_client_callback, NULL, NULL, NULL);
+    assert_return_code(err, 0);
+    // When
+    err = st_mqtt_get_chunk_pool_stats(client, &stats);
+    // Then: only the PINGREQ chunk (header + payload) is alive
+    assert_return_code(err, 0);
+    assert_int_equal(stats.in_use, 1);
+    assert_int_equal(stats.high_water, 1);
+    assert_int_equal(stats.header_hits + stats.header_misses, 1);
+    assert_int_equal(stats.data_in_use, 1);
+    assert_int_equal(stats.data_high_water, 1);
+    assert_int_equal(stats.data_hits + stats.data_misses, 1);
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL)
+    assert_int_equal(stats.header_hits, 1);
+    assert_int_equal(stats.data_hits, 1);
+#endif
+
+    // When
+    err = st_mqtt_get_chunk_pool_stats(client, NULL);
+    // Then
+    assert_int_equal(err, E_ST_MQTT_FAILURE);
+    // When
+    err = st_mqtt_get_chunk_pool_stats(NULL, &stats);
+    // Then
+    assert_int_equal(err, E_ST_MQTT_FAILURE);
+
+    // Teardown
+    st_mqtt_destroy(client);
+    set_mock_detect_memory_leak(false);
+}
+
+void TC_st_mqtt_destroy_with_owned_chunk(void** state)
+{
+    int err;
+    st_mqtt_client client;
+    MQTTClient *internal_client;
+    iot_mqtt_chunk_pool_t *pool;
+    iot_mqtt_packet_chunk_t *chunk;
+    st_mqtt_chunk_pool_stats stats;
+    UNUSED(state);
+
+    // Given: a packet still owned by its sender, like a pending SUBSCRIBE
+    set_mock_detect_memory_leak(true);
+    err = st_mqtt_create(&client, _dummy_mqtt_client_callback, NULL, NULL, NULL);
+    assert_return_code(err, 0);
+    internal_client = (MQTTClient*) client;
+    pool = internal_client->chunk_pool;
+    chunk = iot_mqtt_chunk_pool_alloc_header(pool);
+    assert_non_null(chunk);
+    chunk->pool = pool;
+    chunk->chunk_size = 32;
+    chunk->chunk_data = iot_mqtt_chunk_pool_alloc_data(pool, chunk->chunk_size);
+    assert_non_null(chunk->chunk_data);
+    chunk->have_owner = 1;
+    err = st_mqtt_get_chunk_pool_stats(client, &stats);
+    assert_return_code(err, 0);
+    assert_int_equal(stats.in_use, 2);
+    assert_int_equal(stats.data_in_use, 2);
+#if defined(CONFIG_STDK_IOT_CORE_MQTT_CHUNK_POOL)
+    assert_int_equal(stats.header_hits, 2);
+    assert_int_equal(stats.data_hits, 2);
+#endif
+    // When: client goes away first
+    st_mqtt_destroy(client);
+    // Then: the pool stays usable for the owner
+    memset(chunk->chunk_data, 0xa5, chunk->chunk_size);
+    assert_int_equal(pool->in_use, 1);
+    assert_int_equal(pool->refs, 1);
+
+    // When: owner releases the packet, which frees the pool
+    iot_mqtt_chunk_pool_free_data(chunk->pool, chunk->chunk_data);
+    iot_mqtt_chunk_pool_free_header(chunk->pool, chunk);
+
+    // Then: nothing is leaked
+    set_mock_detect_memory_leak(false);
+}
+
+void TC_st_mqtt_get_read_stats(void** state)
+{
+    int err;
+    st_mqtt_client client;
+    st_mqtt_broker_info_t broker_info;
+    st_mqtt_connect_data conn_data = st_mqtt_connect_data_initializer;
+    st_mqtt_read_stats stats;
+    // CONNACK followed by PINGRESP in the same network read
+    unsigned char mock_read_buffer[6] = { 0x20, 0x02, 0x00, 0x00, 0xd0, 0x00 };
+    UNUSED(state);
+
+    // Given
+    err = st_mqtt_create(&client, _dummy_mqtt_client_callback, NULL, NULL, NULL);
+    assert_return_code(err, 0);
+    port_net_mock_reset_socket_status(1);
+    broker_info.url = "test.domain.com";
+    broker_info.port = 555;
+    broker_info.ca_cert = (const unsigned char *)st_root_ca;
+    broker_info.ca_cert_len = st_root_ca_len;
+    broker_info.ssl = 1;
+    conn_data.clientid = "testClientId";
+    conn_data.username = "testUserName";
+    conn_data.password = "testPassword";
+    port_net_mock_reset_read_stream(mock_read_buffer, sizeof(mock_read_buffer));
+    expect_any(__wrap_port_net_write, len);
+    expect_any(__wrap_port_net_write, buf);
+    err = st_mqtt_connect(client, &broker_info, &conn_data);
+    assert_return_code(err, 0);
+    // When: buffered PINGRESP is framed without polling network again
+    err = st_mqtt_yield(client, 0);
+    assert_true(err >= 0);
+    err = st_mqtt_get_read_stats(client, &stats);
+    // Then
+    assert_return_code(err, 0);
+    assert_int_equal(stats.packets, 2);
+    assert_int_equal(stats.packets_in_place, 2);
+    assert_int_equal(stats.bytes_copied, 0);
+    assert_int_equal(stats.last_bytes_copied, 0);
+
+    // When
+    err = st_mqtt_get_read_stats(client, NULL);
+    // Then
+    assert_int_equal(err, E_ST_MQTT_FAILURE);
+
+    // Teardown
+    st_mqtt_destroy(client);
+}
+
+void TC_st_mqtt_write_coalescing(void** state)
+{
+    int err;
+    st_mqtt_client client;
+    st_mqtt_broker_info_t broker_info;
+    st_mqtt_connect_data conn_data = st_mqtt_connect_data_initializer;
+    st_mqtt_write_stats stats;
+    st_mqtt_msg msg;
+    MQTTString topic = MQTTString_initializer;
+    unsigned char mock_read_buffer[4] = { 0x20, 0x02, 0x00, 0x00 };
+    unsigned char expected[256];
+    char *payload[3] = { "on", "off", "{\"level\":50}" };
+    int expected_len = 0;
+    unsigned int connect_bytes;
+    UNUSED(state);
+
+    if (IOT_MQTT_WRITE_BATCH < 3) {
+        skip();
+    }
+
+    // Given: connected client
+    err = st_mqtt_create(&client, _dummy_mqtt_client_callback, NULL, NULL, NULL);
+    assert_return_code(err, 0);
+    port_net_mock_reset_socket_status(1);
+    broker_info.url = "test.domain.com";
+    broker_info.port = 555;
+    broker_info.ca_cert = (const unsigned char *)st_root_ca;
+    broker_info.ca_cert_len = st_root_ca_len;
+    broker_info.ssl = 1;
+    conn_data.clientid = "testClientId";
+    conn_data.username = "testUserName";
+    conn_data.password = "testPassword";
+    port_net_mock_reset_read_stream(mock_read_buffer, sizeof(mock_read_buffer));
+    expect_any(__wrap_port_net_write, len);
+    expect_any(__wrap_port_net_write, buf);
+    err = st_mqtt_connect(client, &broker_info, &conn_data);
+    assert_return_code(err, 0);
+    err = st_mqtt_get_write_stats(client, &stats);
+    assert_return_code(err, 0);
+    assert_int_equal(stats.packets, 1);
+    assert_int_equal(stats.records, 1);
+    connect_bytes = stats.bytes;
+
+    // When: small packets are queued before write stream runs
+    msg.qos = st_mqtt_qos0;
+    msg.retained = false;
+    msg.topic = "/v1/deviceEvents/123e4567-e89b-12d3-a456-426655440000";
+    topic.cstring = (char *)msg.topic;
+    for (int i = 0; i < 3; i++) {
+        msg.payload = payload[i];
+        msg.payloadlen = strlen(payload[i]);
+        err = st_mqtt_publish_async(client, &msg);
+        assert_return_code(err, 0);
+        expected_len += MQTTSerialize_publish(&expected[expected_len], sizeof(expected) - expected_len,
+                0, msg.qos, msg.retained, 0, topic, (unsigned char *)msg.payload, msg.payloadlen);
+    }
+    port_net_mock_reset_read_stream(NULL, 0);
+    // Then: they are sent back to back with one write
+    expect_value(__wrap_port_net_write, len, expected_len);
+    expect_memory(__wrap_port_net_write, buf, expected, expected_len);
+    err = st_mqtt_yield(client, 0);
+    assert_true(err >= 0);
+    err = st_mqtt_get_write_stats(client, &stats);
+    assert_return_code(err, 0);
+    assert_int_equal(stats.packets, 4);
+    assert_int_equal(stats.records, 2);
+    assert_int_equal(stats.writes, 2);
+    assert_int_equal(stats.bytes, connect_bytes + expected_len);
+
+    // When
+    err = st_mqtt_get_write_stats(client, NULL);
+    // Then
+    assert_int_equal(err, E_ST_MQTT_FAILURE);
+
+    // Teardown
+    st_mqtt_destroy(client);
+}
+
+void TC_st_mqtt_get_connect_stats(void** state)
+{
+    int err;
+    st_mqtt_client client;
+    st_mqtt_broker_info_t broker_info;
+    st_mqtt_connect_data conn_data = st_mqtt_connect_data_initializer;
+    st_mqtt_connect_stats stats;
+    unsigned char mock_read_buffer[4] = { 0x20, 0x02, 0x00, 0x00 };
+    UNUSED(state);
+
+    // Given
+    err = st_mqtt_create(&client, _dummy_mqtt_client_callback, NULL, NULL, NULL);
+    assert_return_code(err, 0);
+    err = st_mqtt_get_connect_stats(client, &stats);
+    assert_return_code(err, 0);
+    assert_int_equal(stats.handshake_ms, 0);
+    port_net_mock_reset_socket_status(1);
+    broker_info.url = "test.domain.com";
+    broker_info.port = 555;
+    broker_info.ca_cert = (const unsigned char *)st_root_ca;
+    broker_info.ca_cert_len = st_root_ca_len;
+    broker_info.ssl = 1;
+    conn_data.clientid = "testClientId";
+    conn_data.username = "testUserName";
+    conn_data.password = "testPassword";
+    port_net_mock_reset_read_stream(mock_read_buffer, sizeof(mock_read_buffer));
+    expect_any(__wrap_port_net_write, len);
+    expect_any(__wrap_port_net_write, buf);
+    // When
+    err = st_mqtt_connect(client, &broker_info, &conn_data);
+    assert_return_code(err, 0);
+    err = st_mqtt_get_connect_stats(client, &stats);
+    // Then: network phases come from port, CONNACK wait is measured by client
+    assert_return_code(err, 0);
+    assert_int_equal(stats.dns_ms, 1);
+    assert_int_equal(stats.tcp_ms, 2);
+    assert_int_equal(stats.handshake_ms, 3);
+    assert_int_equal(stats.session_offered, 1);
+    assert_true(stats.connack_ms < DEFAULT_COMMNAD_TIMEOUT);
+
+    // When
+    err = st_mqtt_get_connect_stats(client, NULL);
+    // Then
+    assert_int_equal(err, E_ST_MQTT_FAILURE);
+
+    // Teardown
+    st_mqtt_destroy(client);
+}
+
+void TC_iot_mqtt_inflight_find_and_expire(void** state)
+{
+    iot_mqtt_inflight_t inflight;
+    iot_mqtt_packet_chunk_t chunk[3];
+    unsigned int now = 1000;
+    unsigned int deadline;
+    UNUSED(state);
+
+    // Given
+    memset(chunk, '\0', sizeof(chunk));
+    iot_mqtt_inflight_init(&inflight, now);
+    chunk[0].packet_type = PUBLISH;
+    chunk[0].packet_id = 1;
+    chunk[0].deadline = now + MQTT_RETRY_TIMEOUT;
+    chunk[1].packet_type = PUBLISH;
+    chunk[1].packet_id = 1 + IOT_MQTT_INFLIGHT_BUCKETS;
+    chunk[1].deadline = now + MQTT_RETRY_TIMEOUT;
+    chunk[2].packet_type = SUBSCRIBE;
+    chunk[2].packet_id = 1;
+    chunk[2].deadline = now + MQTT_CONNECT_TIMEOUT;
+    iot_mqtt_inflight_add(&inflight, &chunk[0]);
+    iot_mqtt_inflight_add(&inflight, &chunk[1]);
+    iot_mqtt_inflight_add(&inflight, &chunk[2]);
+    // Then
+    assert_ptr_equal(iot_mqtt_inflight_find(&inflight, PUBLISH, 1), &chunk[0]);
+    assert_ptr_equal(iot_mqtt_inflight_find(&inflight, PUBLISH, 1 + IOT_MQTT_INFLIGHT_BUCKETS), &chunk[1]);
+    assert_ptr_equal(iot_mqtt_inflight_find(&inflight, SUBSCRIBE, 1), &chunk[2]);
+    assert_null(iot_mqtt_inflight_find(&inflight, PUBACK, 1));
+    assert_null(iot_mqtt_inflight_find_expired(&inflight, now + MQTT_RETRY_TIMEOUT - 1));
+    assert_int_equal(iot_mqtt_inflight_next_deadline(&inflight, &deadline), 0);
+    assert_int_equal(deadline, now + MQTT_RETRY_TIMEOUT);
+
+    // When: acknowledged one is removed
+    iot_mqtt_inflight_remove(&inflight, &chunk[0]);
+    // Then
+    assert_null(iot_mqtt_inflight_find(&inflight, PUBLISH, 1));
+    assert_ptr_equal(iot_mqtt_inflight_find_expired(&inflight, now + MQTT_RETRY_TIMEOUT), &chunk[1]);
+
+    // When
+    iot_mqtt_inflight_remove(&inflight, &chunk[1]);
+    assert_int_equal(iot_mqtt_inflight_next_deadline(&inflight, &deadline), 0);
+    assert_int_equal(deadline, now + MQTT_CONNECT_TIMEOUT);
+    // Then: long idle gap still finds the remaining one
+    assert_ptr_equal(iot_mqtt_inflight_find_expired(&inflight, now + (MQTT_CONNECT_TIMEOUT * 10)), &chunk[2]);
+    iot_mqtt_inflight_remove(&inflight, &chunk[2]);
+    assert_int_equal(inflight.count, 0);
+    assert_int_equal(iot_mqtt_inflight_next_deadline(&inflight, &deadline), -1);
+    assert_null(iot_mqtt_inflight_find_expired(&inflight, now + (MQTT_CONNECT_TIMEOUT * 10)));
+}
+
 static void _st_mqtt_connect_test_with_parameter(unsigned char give_rc, int expected_err)
 {
     int err;
@@ -383,6 +383,107 @@ void TC_iot_nv_get_data_from_device_info_success(void** state)
 	assert_memory_equal(buf.p, sample_public_key, strlen(sample_public_key));
 }
 
+void TC_iot_nv_begin_commit_batch(void** state)
+{
+    iot_error_t err;
+    struct iot_wifi_prov_data wifi_prov;
+    char *serial_number = NULL;
+    size_t serial_number_len = 0;
+    UNUSED(state);
+
+    // Given
+    _setup_wifi_prov_status(DONE);
+    _setup_wifi_prov_data(IOT_NVD_AP_SSID);
+    _setup_wifi_prov_data(IOT_NVD_AP_PASS);
+    set_mock_detect_memory_leak(true);
+
+    // When: nested batches around several accesses
+    err = iot_nv_begin();
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_nv_begin();
+    assert_int_equal(err, IOT_ERROR_NONE);
+    memset(&wifi_prov, 0, sizeof(wifi_prov));
+    err = iot_nv_get_wifi_prov_data(&wifi_prov);
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_nv_commit();
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_nv_get_serial_number(&serial_number, &serial_number_len);
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_nv_commit();
+    assert_int_equal(err, IOT_ERROR_NONE);
+    // Then: data is the same as without batch
+    assert_string_equal(wifi_prov.ssid, sample_wifi_ssid);
+    assert_string_equal(wifi_prov.password, sample_wifi_password);
+    assert_int_equal(serial_number_len, strlen("STDKtESt7968d226"));
+
+    // When: commit without begin
+    err = iot_nv_commit();
+    // Then: ignored, following access still works
+    assert_int_equal(err, IOT_ERROR_NONE);
+    memset(&wifi_prov, 0, sizeof(wifi_prov));
+    err = iot_nv_get_wifi_prov_data(&wifi_prov);
+    assert_int_equal(err, IOT_ERROR_NONE);
+    assert_string_equal(wifi_prov.ssid, sample_wifi_ssid);
+
+    // Local teardown
+    iot_os_free(serial_number);
+    set_mock_detect_memory_leak(false);
+    _teardown_wifi_prov_data();
+}
+
+void TC_iot_nv_cache_write_back(void** state)
+{
+    iot_error_t err;
+    char *device_id = NULL;
+    size_t device_id_len = 0;
+    UNUSED(state);
+
+    // Given
+    err = iot_nv_set_device_id("first-device-id");
+    assert_int_equal(err, IOT_ERROR_NONE);
+
+    // When: stored several times in one batch
+    err = iot_nv_begin();
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_nv_set_device_id("second-device-id");
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_nv_set_device_id("third-device-id");
+    assert_int_equal(err, IOT_ERROR_NONE);
+    // Then: read in batch gets the last one
+    err = iot_nv_get_device_id(&device_id, &device_id_len);
+    assert_int_equal(err, IOT_ERROR_NONE);
+    assert_string_equal(device_id, "third-device-id");
+    iot_os_free(device_id);
+    err = iot_nv_commit();
+    assert_int_equal(err, IOT_ERROR_NONE);
+
+    // When: nv is initialized again without cache
+    TC_iot_nv_data_teardown(state);
+    TC_iot_nv_data_setup(state);
+    err = iot_nv_get_device_id(&device_id, &device_id_len);
+    // Then: committed one is in storage
+    assert_int_equal(err, IOT_ERROR_NONE);
+    assert_string_equal(device_id, "third-device-id");
+    iot_os_free(device_id);
+
+    // When: stored and erased in one batch
+    err = iot_nv_begin();
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_nv_set_device_id("fourth-device-id");
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_nv_erase(IOT_NVD_DEVICE_ID);
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_nv_commit();
+    assert_int_equal(err, IOT_ERROR_NONE);
+    // Then: nothing is left
+    err = iot_nv_erase(IOT_NVD_DEVICE_ID);
+    assert_int_equal(err, IOT_ERROR_NV_DATA_NOT_EXIST);
+    TC_iot_nv_data_teardown(state);
+    TC_iot_nv_data_setup(state);
+    err = iot_nv_get_device_id(&device_id, &device_id_len);
+    assert_int_not_equal(err, IOT_ERROR_NONE);
+}
+
 #define SECURITY_TYPE_MAX 10
 extern iot_error_t _iot_nv_write_data(const iot_nvd_t nv_type, const char* data, size_t size);
 
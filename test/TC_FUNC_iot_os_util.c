@@ -0,0 +1,312 @@
+/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <iot_os_util.h>
+
+#define UNUSED(x) (void**)(x)
+
+#define TEST_EVENT_BIT_0    (1 << 0)
+#define TEST_EVENT_BIT_1    (1 << 1)
+#define TEST_EVENT_BIT_2    (1 << 2)
+
+void TC_iot_os_eventgroup_wait_set_bits(void **state)
+{
+    iot_os_eventgroup *eventgroup;
+    unsigned char bits;
+    UNUSED(state);
+
+    // Given
+    eventgroup = iot_os_eventgroup_create();
+    assert_non_null(eventgroup);
+
+    // When: bit is set before waiting
+    iot_os_eventgroup_set_bits(eventgroup, TEST_EVENT_BIT_0 | TEST_EVENT_BIT_2);
+    bits = iot_os_eventgroup_wait_bits(eventgroup, TEST_EVENT_BIT_0 | TEST_EVENT_BIT_1, false, 1000);
+    // Then: returns at once with every set bit
+    assert_int_equal(bits, TEST_EVENT_BIT_0 | TEST_EVENT_BIT_2);
+
+    // When: bits are not cleared on exit
+    bits = iot_os_eventgroup_wait_bits(eventgroup, TEST_EVENT_BIT_0, true, 1000);
+    // Then: still set, only waited bit is cleared now
+    assert_int_equal(bits, TEST_EVENT_BIT_0 | TEST_EVENT_BIT_2);
+    bits = iot_os_eventgroup_wait_bits(eventgroup, TEST_EVENT_BIT_2, false, 0);
+    assert_int_equal(bits, TEST_EVENT_BIT_2);
+
+    // When: waited bit is cleared
+    iot_os_eventgroup_clear_bits(eventgroup, TEST_EVENT_BIT_2);
+    bits = iot_os_eventgroup_wait_bits(eventgroup, TEST_EVENT_BIT_2, true, 10);
+    // Then: times out without bits
+    assert_int_equal(bits, 0);
+
+    // Teardown
+    iot_os_eventgroup_delete(eventgroup);
+}
+
+struct eventgroup_pingpong {
+    iot_os_eventgroup *ping;
+    iot_os_eventgroup *pong;
+    int rounds;
+};
+
+static void *eventgroup_pong_thread(void *arg)
+{
+    struct eventgroup_pingpong *pingpong = (struct eventgroup_pingpong *)arg;
+    unsigned char bits;
+
+    for (int i = 0; i < pingpong->rounds; i++) {
+        bits = iot_os_eventgroup_wait_bits(pingpong->ping, TEST_EVENT_BIT_0, true, IOT_OS_WAIT_FOREVER);
+        if (!(bits & TEST_EVENT_BIT_0)) {
+            break;
+        }
+        iot_os_eventgroup_set_bits(pingpong->pong, TEST_EVENT_BIT_1);
+    }
+
+    return NULL;
+}
+
+void TC_iot_os_eventgroup_wakeup_from_thread(void **state)
+{
+    struct eventgroup_pingpong pingpong;
+    struct timespec start, end;
+    pthread_t thread;
+    unsigned char bits;
+    int i;
+    UNUSED(state);
+
+    // Given
+    pingpong.ping = iot_os_eventgroup_create();
+    pingpong.pong = iot_os_eventgroup_create();
+    assert_non_null(pingpong.ping);
+    assert_non_null(pingpong.pong);
+    pingpong.rounds = 10000;
+    assert_int_equal(pthread_create(&thread, NULL, eventgroup_pong_thread, &pingpong), 0);
+
+    // When: every signal has to wake the other thread up
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < pingpong.rounds; i++) {
+        iot_os_eventgroup_set_bits(pingpong.ping, TEST_EVENT_BIT_0);
+        bits = iot_os_eventgroup_wait_bits(pingpong.pong, TEST_EVENT_BIT_1, true, 1000);
+        if (!(bits & TEST_EVENT_BIT_1)) {
+            break;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    pthread_join(thread, NULL);
+
+    // Then: no wake-up is lost, latency is only reported
+    assert_int_equal(i, pingpong.rounds);
+    print_message("eventgroup signal to wake : %.1f ns\n",
+            ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / (2.0 * pingpong.rounds));
+
+    // Teardown
+    iot_os_eventgroup_delete(pingpong.ping);
+    iot_os_eventgroup_delete(pingpong.pong);
+}
+
+struct timer_record {
+    pthread_mutex_t lock;
+    int fired[4];
+    int order[4];
+    int count;
+    pthread_t thread[4];
+};
+
+static struct timer_record timer_record = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static void timer_record_get(struct timer_record *record)
+{
+    pthread_mutex_lock(&timer_record.lock);
+    memcpy(record->fired, timer_record.fired, sizeof(record->fired));
+    memcpy(record->order, timer_record.order, sizeof(record->order));
+    memcpy(record->thread, timer_record.thread, sizeof(record->thread));
+    record->count = timer_record.count;
+    pthread_mutex_unlock(&timer_record.lock);
+}
+
+static void timer_record_cb(iot_os_timer_handle handle, void *user_data)
+{
+    int id = (int)(intptr_t)user_data;
+
+    pthread_mutex_lock(&timer_record.lock);
+    timer_record.fired[id]++;
+    timer_record.thread[timer_record.count] = pthread_self();
+    timer_record.order[timer_record.count++] = id;
+    pthread_mutex_unlock(&timer_record.lock);
+}
+
+void TC_iot_os_timer_expiry_order(void **state)
+{
+    iot_os_timer_handle timer[4];
+    unsigned int expiry[4] = {40, 10, 30, 20};
+    struct timer_record record;
+    UNUSED(state);
+
+    // Given
+    pthread_mutex_lock(&timer_record.lock);
+    memset(timer_record.fired, 0, sizeof(timer_record.fired));
+    timer_record.count = 0;
+    pthread_mutex_unlock(&timer_record.lock);
+    for (int i = 0; i < 4; i++) {
+        timer[i] = iot_os_timer_create(timer_record_cb, expiry[i], (void *)(intptr_t)i);
+        assert_non_null(timer[i]);
+    }
+
+    // When: every timer starts and timer 2 is stopped
+    for (int i = 0; i < 4; i++) {
+        assert_int_equal(iot_os_timer_start(timer[i]), 0);
+        assert_true(iot_os_timer_is_active(timer[i]));
+    }
+    assert_int_equal(iot_os_timer_stop(timer[2]), 0);
+    assert_false(iot_os_timer_is_active(timer[2]));
+    iot_os_delay(200);
+    timer_record_get(&record);
+
+    // Then: others fire once in deadline order on one thread
+    assert_int_equal(record.count, 3);
+    assert_int_equal(record.order[0], 1);
+    assert_int_equal(record.order[1], 3);
+    assert_int_equal(record.order[2], 0);
+    assert_int_equal(record.fired[2], 0);
+    assert_true(pthread_equal(record.thread[0], record.thread[1]));
+    assert_true(pthread_equal(record.thread[0], record.thread[2]));
+    for (int i = 0; i < 4; i++) {
+        assert_false(iot_os_timer_is_active(timer[i]));
+    }
+
+    // When: restarted with shorter period
+    assert_int_equal(iot_os_timer_change_period(timer[0], 5), 0);
+    iot_os_delay(100);
+    timer_record_get(&record);
+    // Then
+    assert_int_equal(record.fired[0], 2);
+
+    // Teardown
+    for (int i = 0; i < 4; i++) {
+        iot_os_timer_delete(timer[i]);
+    }
+}
+
+void TC_iot_os_timer_create_delete_reuse(void **state)
+{
+    iot_os_timer_handle timer;
+    iot_os_timer_handle first;
+    UNUSED(state);
+
+    // Given
+    first = iot_os_timer_create(NULL, 1000, NULL);
+    assert_non_null(first);
+    iot_os_timer_start(first);
+    iot_os_timer_delete(first);
+
+    // When: armed timer is deleted and handle is reused many times
+    for (int i = 0; i < 10000; i++) {
+        timer = iot_os_timer_create(NULL, 1000, NULL);
+        assert_non_null(timer);
+        iot_os_timer_start(timer);
+        iot_os_timer_delete(timer);
+    }
+
+    // Then: deleted timer doesn't stay armed
+    timer = iot_os_timer_create(NULL, 1000, NULL);
+    assert_ptr_equal(timer, first);
+    assert_false(iot_os_timer_is_active(timer));
+
+    // Teardown
+    iot_os_timer_delete(timer);
+}
+
+struct timer_slow_cb {
+    int entered;
+    int left;
+};
+
+static void timer_slow_cb(iot_os_timer_handle handle, void *user_data)
+{
+    struct timer_slow_cb *slow = (struct timer_slow_cb *)user_data;
+
+    __atomic_store_n(&slow->entered, 1, __ATOMIC_RELEASE);
+    iot_os_delay(100);
+    __atomic_store_n(&slow->left, 1, __ATOMIC_RELEASE);
+}
+
+static void timer_self_delete_cb(iot_os_timer_handle handle, void *user_data)
+{
+    iot_os_timer_delete(handle);
+    __atomic_store_n((int *)user_data, 1, __ATOMIC_RELEASE);
+}
+
+void TC_iot_os_timer_delete_while_running(void **state)
+{
+    iot_os_timer_handle timer;
+    iot_os_timer_handle other;
+    struct timer_slow_cb slow = {0};
+    int deleted = 0;
+    UNUSED(state);
+
+    // Given: callback of timer is running
+    timer = iot_os_timer_create(timer_slow_cb, 1, &slow);
+    assert_non_null(timer);
+    assert_int_equal(iot_os_timer_start(timer), 0);
+    while (!__atomic_load_n(&slow.entered, __ATOMIC_ACQUIRE)) {
+        iot_os_delay(1);
+    }
+
+    // When: it is deleted from another thread
+    iot_os_timer_delete(timer);
+    // Then: the handle is no longer usable and its slot is not reused under the callback
+    assert_int_not_equal(iot_os_timer_start(timer), 0);
+    assert_int_not_equal(iot_os_timer_stop(timer), 0);
+    other = iot_os_timer_create(NULL, 1000, NULL);
+    assert_non_null(other);
+    assert_ptr_not_equal(other, timer);
+    iot_os_timer_delete(other);
+
+    // Then: slot goes back to the pool once the callback returns
+    while (!__atomic_load_n(&slow.left, __ATOMIC_ACQUIRE)) {
+        iot_os_delay(1);
+    }
+    iot_os_delay(10);
+    other = iot_os_timer_create(NULL, 1000, NULL);
+    assert_ptr_equal(other, timer);
+    iot_os_timer_delete(other);
+
+    // When: timer deletes itself in its callback
+    timer = iot_os_timer_create(timer_self_delete_cb, 1, &deleted);
+    assert_non_null(timer);
+    assert_int_equal(iot_os_timer_start(timer), 0);
+    while (!__atomic_load_n(&deleted, __ATOMIC_ACQUIRE)) {
+        iot_os_delay(1);
+    }
+    iot_os_delay(10);
+    // Then
+    assert_int_not_equal(iot_os_timer_start(timer), 0);
+    assert_int_not_equal(iot_os_timer_change_period(timer, 10), 0);
+
+    // Then: invalid handles are refused
+    assert_int_not_equal(iot_os_timer_start(NULL), 0);
+    assert_int_not_equal(iot_os_timer_start((iot_os_timer_handle)&deleted), 0);
+}
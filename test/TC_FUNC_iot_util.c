@@ -20,6 +20,9 @@
 #include <setjmp.h>
 #include <cmocka.h>
 #include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
 #include <iot_util.h>
 #include <iot_uuid.h>
 
@@ -329,3 +332,308 @@ void TC_iot_util_convert_mac_str_success(void **state)
     free(mac);
 }
 
+
+static bool match_even(void *item, void *arg)
+{
+    UNUSED(arg);
+    return (*(int *)item % 2) == 0;
+}
+
+void TC_iot_util_queue_ring_send_receive(void **state)
+{
+    iot_util_queue_t *queue;
+    iot_error_t err;
+    int item;
+    int items[4];
+    size_t count;
+    UNUSED(state);
+
+    // Given: capacity is rounded up to 4
+    queue = iot_util_queue_create_ring(sizeof(int), 3);
+    assert_non_null(queue);
+    // When: fill ring
+    for (item = 0; item < 4; item++) {
+        err = iot_util_queue_send(queue, &item);
+        assert_int_equal(err, IOT_ERROR_NONE);
+    }
+    // Then: no room for one more
+    err = iot_util_queue_send(queue, &item);
+    assert_int_not_equal(err, IOT_ERROR_NONE);
+
+    // When: remove even items
+    iot_util_queue_remove_if(queue, match_even, NULL);
+    // Then: odd items are left in order
+    count = iot_util_queue_receive_batch(queue, items, 4);
+    assert_int_equal(count, 2);
+    assert_int_equal(items[0], 1);
+    assert_int_equal(items[1], 3);
+    err = iot_util_queue_receive(queue, &item);
+    assert_int_not_equal(err, IOT_ERROR_NONE);
+
+    // When: positions wrap around several laps
+    for (int i = 0; i < 10; i++) {
+        item = i;
+        err = iot_util_queue_send(queue, &item);
+        assert_int_equal(err, IOT_ERROR_NONE);
+        err = iot_util_queue_receive(queue, &item);
+        assert_int_equal(err, IOT_ERROR_NONE);
+        assert_int_equal(item, i);
+    }
+
+    // Teardown
+    iot_util_queue_delete(queue);
+}
+
+void TC_iot_util_queue_receive_batch(void **state)
+{
+    iot_util_queue_t *queue;
+    iot_error_t err;
+    int item;
+    int items[4];
+    size_t count;
+    UNUSED(state);
+
+    // Given: linked queue with 5 items
+    queue = iot_util_queue_create(sizeof(int));
+    assert_non_null(queue);
+    for (item = 0; item < 5; item++) {
+        err = iot_util_queue_send(queue, &item);
+        assert_int_equal(err, IOT_ERROR_NONE);
+    }
+    // When
+    count = iot_util_queue_receive_batch(queue, items, 4);
+    // Then
+    assert_int_equal(count, 4);
+    for (int i = 0; i < 4; i++) {
+        assert_int_equal(items[i], i);
+    }
+    count = iot_util_queue_receive_batch(queue, items, 4);
+    assert_int_equal(count, 1);
+    assert_int_equal(items[0], 4);
+    count = iot_util_queue_receive_batch(queue, items, 4);
+    assert_int_equal(count, 0);
+
+    // When: queue is used again after being drained
+    item = 7;
+    err = iot_util_queue_send(queue, &item);
+    assert_int_equal(err, IOT_ERROR_NONE);
+    err = iot_util_queue_receive(queue, &item);
+    assert_int_equal(err, IOT_ERROR_NONE);
+    assert_int_equal(item, 7);
+
+    // Teardown
+    iot_util_queue_delete(queue);
+}
+
+#define QUEUE_BENCH_PRODUCERS   2
+#define QUEUE_BENCH_ITEMS       100000
+
+struct queue_bench_item {
+    int producer;
+    int index;
+    void *payload[2];
+};
+
+struct queue_bench_producer {
+    iot_util_queue_t *queue;
+    int id;
+};
+
+static void *queue_bench_producer_thread(void *arg)
+{
+    struct queue_bench_producer *producer = (struct queue_bench_producer *)arg;
+    struct queue_bench_item item = {0};
+
+    item.producer = producer->id;
+    for (item.index = 0; item.index < QUEUE_BENCH_ITEMS; ) {
+        if (iot_util_queue_send(producer->queue, &item) == IOT_ERROR_NONE) {
+            item.index++;
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static double queue_bench_run(iot_util_queue_t *queue)
+{
+    struct queue_bench_producer producer[QUEUE_BENCH_PRODUCERS];
+    pthread_t thread[QUEUE_BENCH_PRODUCERS];
+    struct queue_bench_item items[8];
+    int next_index[QUEUE_BENCH_PRODUCERS] = {0};
+    int received = 0;
+    struct timespec start, end;
+    size_t count;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < QUEUE_BENCH_PRODUCERS; i++) {
+        producer[i].queue = queue;
+        producer[i].id = i;
+        assert_int_equal(pthread_create(&thread[i], NULL, queue_bench_producer_thread, &producer[i]), 0);
+    }
+
+    // Items of each producer must come out in order
+    while (received < QUEUE_BENCH_PRODUCERS * QUEUE_BENCH_ITEMS) {
+        count = iot_util_queue_receive_batch(queue, items, 8);
+        if (count == 0) {
+            sched_yield();
+        }
+        for (size_t i = 0; i < count; i++) {
+            assert_int_equal(items[i].index, next_index[items[i].producer]);
+            next_index[items[i].producer]++;
+        }
+        received += count;
+    }
+
+    for (int i = 0; i < QUEUE_BENCH_PRODUCERS; i++) {
+        pthread_join(thread[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / received;
+}
+
+void TC_iot_util_queue_ring_benchmark(void **state)
+{
+    iot_util_queue_t *queue;
+    double linked_ns, ring_ns;
+    UNUSED(state);
+
+    // Given
+    queue = iot_util_queue_create(sizeof(struct queue_bench_item));
+    assert_non_null(queue);
+    // When
+    linked_ns = queue_bench_run(queue);
+    iot_util_queue_delete(queue);
+
+    // Given
+    queue = iot_util_queue_create_ring(sizeof(struct queue_bench_item), 1024);
+    assert_non_null(queue);
+    // When
+    ring_ns = queue_bench_run(queue);
+    iot_util_queue_delete(queue);
+
+    // Then: every item is received in order, timing is only reported
+    print_message("queue %d producers x %d items : linked %.1f ns/item, ring %.1f ns/item\n",
+            QUEUE_BENCH_PRODUCERS, QUEUE_BENCH_ITEMS, linked_ns, ring_ns);
+}
+
+#define QUEUE_REMOVE_ITEMS      20000
+
+struct queue_remover {
+    iot_util_queue_t *queue;
+    bool stop;
+    int runs;
+};
+
+struct queue_remove_producer {
+    iot_util_queue_t *queue;
+    int id;
+    bool done;
+};
+
+static bool match_producer(void *item, void *arg)
+{
+    return ((struct queue_bench_item *)item)->producer == *(int *)arg;
+}
+
+static void *queue_remover_thread(void *arg)
+{
+    struct queue_remover *remover = (struct queue_remover *)arg;
+    int producer = 1;
+
+    while (!__atomic_load_n(&remover->stop, __ATOMIC_ACQUIRE)) {
+        iot_util_queue_remove_if(remover->queue, match_producer, &producer);
+        remover->runs++;
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+static void *queue_remove_producer_thread(void *arg)
+{
+    struct queue_remove_producer *producer = (struct queue_remove_producer *)arg;
+    struct queue_bench_item item = {0};
+
+    item.producer = producer->id;
+    for (item.index = 0; item.index < QUEUE_REMOVE_ITEMS; ) {
+        if (iot_util_queue_send(producer->queue, &item) == IOT_ERROR_NONE) {
+            item.index++;
+        } else {
+            sched_yield();
+        }
+    }
+    __atomic_store_n(&producer->done, true, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+void TC_iot_util_queue_ring_remove_if_concurrent(void **state)
+{
+    iot_util_queue_t *queue;
+    struct queue_remove_producer producer[2];
+    struct queue_remover remover;
+    pthread_t thread[3];
+    struct queue_bench_item items[8];
+    int next_index[2] = {0};
+    size_t count;
+    UNUSED(state);
+
+    // Given: small ring wrapping many laps
+    queue = iot_util_queue_create_ring(sizeof(struct queue_bench_item), 16);
+    assert_non_null(queue);
+    remover.queue = queue;
+    remover.stop = false;
+    remover.runs = 0;
+
+    // When: items of producer 1 are removed while both producers and the consumer run
+    for (int i = 0; i < 2; i++) {
+        producer[i].queue = queue;
+        producer[i].id = i;
+        producer[i].done = false;
+        assert_int_equal(pthread_create(&thread[i], NULL, queue_remove_producer_thread, &producer[i]), 0);
+    }
+    assert_int_equal(pthread_create(&thread[2], NULL, queue_remover_thread, &remover), 0);
+
+    while (!__atomic_load_n(&producer[0].done, __ATOMIC_ACQUIRE) || !__atomic_load_n(&producer[1].done, __ATOMIC_ACQUIRE) ||
+            !iot_util_queue_is_empty(queue)) {
+        count = iot_util_queue_receive_batch(queue, items, 8);
+        if (count == 0) {
+            sched_yield();
+        }
+        for (size_t i = 0; i < count; i++) {
+            // Then: producer 0 items are never lost nor reordered
+            if (items[i].producer == 0) {
+                assert_int_equal(items[i].index, next_index[0]);
+            } else {
+                assert_true(items[i].index >= next_index[1]);
+            }
+            next_index[items[i].producer] = items[i].index + 1;
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        if (i == 2) {
+            __atomic_store_n(&remover.stop, true, __ATOMIC_RELEASE);
+        }
+        pthread_join(thread[i], NULL);
+    }
+    assert_int_equal(next_index[0], QUEUE_REMOVE_ITEMS);
+    assert_true(remover.runs > 0);
+
+    // When: items are left only for producer 1
+    for (int i = 0; i < 4; i++) {
+        items[0].producer = 1;
+        items[0].index = i;
+        assert_int_equal(iot_util_queue_send(queue, &items[0]), IOT_ERROR_NONE);
+    }
+    iot_util_queue_remove_if(queue, match_producer, &producer[1].id);
+    // Then: removed items are never received and their slots are freed
+    assert_int_equal(iot_util_queue_receive_batch(queue, items, 8), 0);
+    assert_true(iot_util_queue_is_empty(queue));
+
+    // Teardown
+    iot_util_queue_delete(queue);
+}
@@ -133,3 +133,67 @@ void TC_iot_wt_create_success(void **state)
 	// Local teardown
 	iot_os_free(token_buf.p);
 }
+
+void TC_iot_wt_create_cached_reuse(void **state)
+{
+	iot_error_t err;
+	iot_wt_params_t wt_params = { 0 };
+	iot_wt_cache_t cache = { 0 };
+	iot_security_buffer_t first_buf = { 0 };
+	iot_security_buffer_t token_buf = { 0 };
+	long issued_at;
+	UNUSED(state);
+
+	if (CONFIG_STDK_IOT_CORE_WEBTOKEN_REUSE_SEC == 0) {
+		skip();
+	}
+
+	// Given
+	wt_params.sn = (char *)sample_sn;
+	wt_params.sn_len = strlen(sample_sn);
+	wt_params.mnid = (char *)sample_mnid;
+	wt_params.mnid_len = strlen(sample_mnid);
+	err = iot_wt_create_cached(&cache, &wt_params, &first_buf);
+	assert_int_equal(err, IOT_ERROR_NONE);
+	assert_non_null(cache.token.p);
+	issued_at = cache.issued_at;
+
+	// When: asked again right away
+	err = iot_wt_create_cached(&cache, &wt_params, &token_buf);
+	// Then: the same token is copied without signing again
+	assert_int_equal(err, IOT_ERROR_NONE);
+	assert_int_equal(cache.issued_at, issued_at);
+	assert_int_equal(token_buf.len, first_buf.len);
+	assert_memory_equal(token_buf.p, first_buf.p, first_buf.len);
+	assert_ptr_not_equal(token_buf.p, cache.token.p);
+	iot_os_free(token_buf.p);
+
+	// When: kept token got too old
+	cache.issued_at -= CONFIG_STDK_IOT_CORE_WEBTOKEN_REUSE_SEC + 10;
+	issued_at = cache.issued_at;
+	err = iot_wt_create_cached(&cache, &wt_params, &token_buf);
+	// Then: new one is signed
+	assert_int_equal(err, IOT_ERROR_NONE);
+	assert_true(cache.issued_at > issued_at);
+	iot_os_free(token_buf.p);
+
+	// When: parameters are changed
+	cache.issued_at -= 1;
+	issued_at = cache.issued_at;
+	wt_params.mnid = "tst2";
+	wt_params.mnid_len = strlen(wt_params.mnid);
+	err = iot_wt_create_cached(&cache, &wt_params, &token_buf);
+	// Then: new one is signed
+	assert_int_equal(err, IOT_ERROR_NONE);
+	assert_true(cache.issued_at > issued_at);
+	iot_os_free(token_buf.p);
+
+	// When: cleared
+	iot_wt_cache_clear(&cache);
+	// Then
+	assert_null(cache.token.p);
+	assert_null(cache.params);
+
+	// Local teardown
+	iot_os_free(first_buf.p);
+}
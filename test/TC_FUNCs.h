@@ -28,6 +28,32 @@ void TC_iot_util_convert_str_uuid_invalid_parameters(void **state);
 void TC_iot_util_convert_channel_freq(void **state);
 void TC_iot_util_convert_mac_str_invalid_parameters(void **state);
 void TC_iot_util_convert_mac_str_success(void **state);
+void TC_iot_util_queue_ring_send_receive(void **state);
+void TC_iot_util_queue_receive_batch(void **state);
+void TC_iot_util_queue_ring_benchmark(void **state);
+void TC_iot_util_queue_ring_remove_if_concurrent(void **state);
+
+// TCs for iot_os_util_posix.c
+void TC_iot_os_eventgroup_wait_set_bits(void **state);
+void TC_iot_os_eventgroup_wakeup_from_thread(void **state);
+void TC_iot_os_timer_expiry_order(void **state);
+void TC_iot_os_timer_create_delete_reuse(void **state);
+void TC_iot_os_timer_delete_while_running(void **state);
+
+// TCs for iot_bsp_fs_posix.c
+int TC_iot_bsp_fs_packed_nv_setup(void **state);
+int TC_iot_bsp_fs_packed_nv_teardown(void **state);
+void TC_iot_bsp_fs_packed_nv_write_remove_reopen(void **state);
+void TC_iot_bsp_fs_packed_nv_torn_tail(void **state);
+void TC_iot_bsp_fs_packed_nv_compaction(void **state);
+void TC_iot_bsp_fs_packed_nv_latest_record_wins(void **state);
+void TC_iot_bsp_fs_packed_nv_spill_file_outside(void **state);
+
+// TCs for iot_executor.c
+void TC_iot_executor_context_serialization(void **state);
+void TC_iot_executor_socket_watch(void **state);
+void TC_iot_executor_socket_wake_write(void **state);
+void TC_iot_executor_inbound_latency(void **state);
 
 // TCs for iot_api.c
 int TC_iot_api_memleak_detect_setup(void **state);
@@ -95,6 +121,9 @@ void TC_st_cap_cmd_set_cb_invalid_parameters(void **state);
 void TC_st_cap_cmd_set_cb_success(void **state);
 void TC_st_cap_send_attr_success(void **state);
 void TC_st_cap_send_attr_invalid_parameter(void **state);
+void TC_st_cap_send_attr_desc_success(void **state);
+void TC_st_cap_send_attr_desc_invalid_value(void **state);
+void TC_st_cap_send_attr_cache_suppress(void **state);
 void TC_iot_cap_sub_cb_success(void **state);
 void TC_iot_noti_sub_cb_rate_limit_reached_SUCCESS(void **state);
 void TC_iot_parse_noti_data_device_deleted(void** state);
@@ -109,7 +138,18 @@ void TC_st_cap_create_attr_with_option_success(void** state);
 void TC_st_cap_cmd_set_cb_internal_failure(void **state);
 void TC_iot_cap_commands_cb_failure(void **state);
 void TC_iot_cap_commands_cb_success(void **state);
+void TC_iot_cap_dispatch_commands_parse_once(void **state);
+void TC_iot_cap_dispatch_commands_hashed_index(void **state);
+void TC_iot_cap_dispatch_commands_arena_reset(void **state);
+void TC_iot_serialize_writer_matches_json_print(void **state);
+void TC_st_cap_send_attr_batch_coalesce(void **state);
+void TC_st_cap_send_attr_offline_replay(void **state);
+void TC_st_cap_send_attr_offline_spill(void **state);
+void TC_st_cap_send_attr_offline_replace(void **state);
 void TC_iot_parse_noti_data_presference_updated(void** state);
+void TC_iot_cap_dispatch_commands_cbor_matches_json(void **state);
+void TC_iot_parse_noti_data_cbor_matches_json(void **state);
+void TC_iot_noti_sub_cb_cbor_rate_limit_reached_SUCCESS(void **state);
 void TC_iot_cap_call_init_cb_null_parameteer(void **state);
 void TC_iot_cap_call_init_cb_success(void **state);
 void TC_st_cap_send_attr_v2_null_parameter(void **state);
@@ -132,6 +172,8 @@ void TC_iot_nv_get_set_erase_device_id_success(void **state);
 void TC_iot_nv_erase_internal_failure(void** state);
 void TC_iot_nv_get_data_from_device_info_failure(void** state);
 void TC_iot_nv_get_data_from_device_info_success(void** state);
+void TC_iot_nv_begin_commit_batch(void** state);
+void TC_iot_nv_cache_write_back(void** state);
 
 // TCs for iot_easysetup_d2d.c
 int TC_iot_easysetup_common_setup(void **state);
@@ -169,6 +211,7 @@ void TC_st_conn_init_malloc_failure(void **state);
 void TC_st_conn_init_wrong_onboarding_config(void **state);
 void TC_st_conn_init_wrong_device_info(void **state);
 void TC_st_conn_init_success(void **state);
+void TC_st_conn_init_context_memory(void **state);
 void TC_st_conn_cleanup_invalid_parameters(void **state);
 void TC_st_conn_cleanup_success(void **state);
 void TC_easysetup_resources_create_delete_success(void** state);
@@ -180,6 +223,12 @@ void TC_st_mqtt_create_failure(void** state);
 void TC_st_mqtt_connect_with_connack_rc(void** state);
 void TC_st_mqtt_disconnect_success(void** state);
 void TC_st_mqtt_publish_success(void** state);
+void TC_st_mqtt_get_chunk_pool_stats(void** state);
+void TC_st_mqtt_destroy_with_owned_chunk(void** state);
+void TC_iot_mqtt_inflight_find_and_expire(void** state);
+void TC_st_mqtt_get_read_stats(void** state);
+void TC_st_mqtt_write_coalescing(void** state);
+void TC_st_mqtt_get_connect_stats(void** state);
 
 // TCs for iot_security_common.c
 void TC_iot_security_init_malloc_failure(void **state);
@@ -335,6 +384,7 @@ int TC_iot_wt_create_memleak_detect_setup(void **state);
 int TC_iot_wt_create_memleak_detect_teardown(void **state);
 void TC_iot_wt_create_null_parameters(void **state);
 void TC_iot_wt_create_success(void **state);
+void TC_iot_wt_create_cached_reuse(void **state);
 
 // TCs for iot_easysetup_httpd
 int TC_iot_easysetup_httpd_setup(void **state);
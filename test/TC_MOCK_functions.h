@@ -29,4 +29,8 @@ void set_mock_detect_memory_leak(bool detect);
 void port_net_mock_reset_read_stream(unsigned char *read_stream, size_t size);
 void port_net_mock_reset_socket_status(int status);
 
+void set_mock_iot_bsp_fs(bool enable);
+bool mock_iot_bsp_fs_exists(const char *filename);
+unsigned int mock_iot_bsp_fs_count(void);
+
 #endif //ST_DEVICE_SDK_C_TC_MOCK_FUNCTIONS_H
@@ -19,9 +19,13 @@
 #include <stddef.h>
 #include <setjmp.h>
 #include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
 #include <string.h>
 #include <iot_error.h>
 #include <iot_bsp_wifi.h>
+#include <iot_bsp_fs.h>
 
 iot_error_t __wrap_iot_bsp_wifi_get_mac(struct iot_mac *wifi_mac)
 {
@@ -88,4 +92,147 @@ iot_error_t __wrap_iot_bsp_wifi_set_mode(iot_wifi_conf *conf)
 {
     check_expected(conf->mode);
     return (int)mock();
-}
\ No newline at end of file
+}
+/* RAM backed files, real file system is used unless enabled */
+#define MOCK_FS_FILE_MAX    8
+
+static bool mock_fs_enabled;
+static struct {
+    char name[32];
+    char *data;
+    size_t len;
+} mock_fs_files[MOCK_FS_FILE_MAX];
+
+iot_error_t __real_iot_bsp_fs_open(const char* filename, iot_bsp_fs_open_mode_t mode, iot_bsp_fs_handle_t* handle);
+iot_error_t __real_iot_bsp_fs_read(iot_bsp_fs_handle_t handle, char* buffer, size_t *length);
+iot_error_t __real_iot_bsp_fs_write(iot_bsp_fs_handle_t handle, const char* data, size_t length);
+iot_error_t __real_iot_bsp_fs_close(iot_bsp_fs_handle_t handle);
+iot_error_t __real_iot_bsp_fs_remove(const char* filename);
+
+static int _mock_fs_find(const char *filename)
+{
+    for (int i = 0; i < MOCK_FS_FILE_MAX; i++) {
+        if (mock_fs_files[i].name[0] && !strcmp(mock_fs_files[i].name, filename)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void set_mock_iot_bsp_fs(bool enable)
+{
+    for (int i = 0; i < MOCK_FS_FILE_MAX; i++) {
+        free(mock_fs_files[i].data);
+        memset(&mock_fs_files[i], '\0', sizeof(mock_fs_files[i]));
+    }
+    mock_fs_enabled = enable;
+}
+
+bool mock_iot_bsp_fs_exists(const char *filename)
+{
+    return _mock_fs_find(filename) >= 0;
+}
+
+unsigned int mock_iot_bsp_fs_count(void)
+{
+    unsigned int count = 0;
+
+    for (int i = 0; i < MOCK_FS_FILE_MAX; i++) {
+        if (mock_fs_files[i].name[0]) {
+            count++;
+        }
+    }
+    return count;
+}
+
+iot_error_t __wrap_iot_bsp_fs_open(const char* filename, iot_bsp_fs_open_mode_t mode, iot_bsp_fs_handle_t* handle)
+{
+    int i;
+
+    if (!mock_fs_enabled) {
+        return __real_iot_bsp_fs_open(filename, mode, handle);
+    }
+
+    i = _mock_fs_find(filename);
+    if (i < 0) {
+        if (mode == FS_READONLY) {
+            return IOT_ERROR_FS_NO_FILE;
+        }
+        for (i = 0; i < MOCK_FS_FILE_MAX && mock_fs_files[i].name[0]; i++);
+        if (i == MOCK_FS_FILE_MAX || strlen(filename) >= sizeof(mock_fs_files[i].name)) {
+            return IOT_ERROR_FS_OPEN_FAIL;
+        }
+        strcpy(mock_fs_files[i].name, filename);
+    }
+    handle->fd = i;
+    snprintf(handle->filename, sizeof(handle->filename), "%s", filename);
+
+    return IOT_ERROR_NONE;
+}
+
+iot_error_t __wrap_iot_bsp_fs_read(iot_bsp_fs_handle_t handle, char* buffer, size_t *length)
+{
+    if (!mock_fs_enabled) {
+        return __real_iot_bsp_fs_read(handle, buffer, length);
+    }
+
+    if (handle.fd < 0 || handle.fd >= MOCK_FS_FILE_MAX || !mock_fs_files[handle.fd].name[0]) {
+        return IOT_ERROR_FS_NO_FILE;
+    }
+    if (*length > mock_fs_files[handle.fd].len) {
+        *length = mock_fs_files[handle.fd].len;
+    }
+    memcpy(buffer, mock_fs_files[handle.fd].data, *length);
+
+    return IOT_ERROR_NONE;
+}
+
+iot_error_t __wrap_iot_bsp_fs_write(iot_bsp_fs_handle_t handle, const char* data, size_t length)
+{
+    char *copy;
+
+    if (!mock_fs_enabled) {
+        return __real_iot_bsp_fs_write(handle, data, length);
+    }
+
+    if (handle.fd < 0 || handle.fd >= MOCK_FS_FILE_MAX || !mock_fs_files[handle.fd].name[0]) {
+        return IOT_ERROR_FS_WRITE_FAIL;
+    }
+    copy = malloc(length);
+    if (copy == NULL) {
+        return IOT_ERROR_FS_WRITE_FAIL;
+    }
+    memcpy(copy, data, length);
+    free(mock_fs_files[handle.fd].data);
+    mock_fs_files[handle.fd].data = copy;
+    mock_fs_files[handle.fd].len = length;
+
+    return IOT_ERROR_NONE;
+}
+
+iot_error_t __wrap_iot_bsp_fs_close(iot_bsp_fs_handle_t handle)
+{
+    if (!mock_fs_enabled) {
+        return __real_iot_bsp_fs_close(handle);
+    }
+
+    return IOT_ERROR_NONE;
+}
+
+iot_error_t __wrap_iot_bsp_fs_remove(const char* filename)
+{
+    int i;
+
+    if (!mock_fs_enabled) {
+        return __real_iot_bsp_fs_remove(filename);
+    }
+
+    i = _mock_fs_find(filename);
+    if (i < 0) {
+        return IOT_ERROR_FS_REMOVE_FAIL;
+    }
+    free(mock_fs_files[i].data);
+    memset(&mock_fs_files[i], '\0', sizeof(mock_fs_files[i]));
+
+    return IOT_ERROR_NONE;
+}
@@ -98,3 +98,14 @@ void __wrap_port_net_free(PORT_NET_CONTEXT ctx)
     UNUSED(ctx);
     mock_socket_status = 2;
 }
+
+int __wrap_port_net_get_connect_stats(PORT_NET_CONTEXT ctx, port_net_connect_stats *stats)
+{
+    UNUSED(ctx);
+    memset(stats, 0, sizeof(*stats));
+    stats->dns_ms = 1;
+    stats->tcp_ms = 2;
+    stats->handshake_ms = 3;
+    stats->session_offered = 1;
+    return 0;
+}
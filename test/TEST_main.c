@@ -82,6 +82,9 @@ int TEST_FUNC_iot_capability(void)
             cmocka_unit_test_setup_teardown(TC_st_cap_cmd_set_cb_success, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test_setup_teardown(TC_st_cap_send_attr_success, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test_setup_teardown(TC_st_cap_send_attr_invalid_parameter, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_st_cap_send_attr_desc_success, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_st_cap_send_attr_desc_invalid_value, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_st_cap_send_attr_cache_suppress, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test_setup_teardown(TC_iot_cap_sub_cb_success, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test_setup_teardown(TC_iot_noti_sub_cb_rate_limit_reached_SUCCESS, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test(TC_iot_parse_noti_data_device_deleted),
@@ -95,7 +98,18 @@ int TEST_FUNC_iot_capability(void)
             cmocka_unit_test_setup_teardown(TC_st_cap_cmd_set_cb_internal_failure, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test_setup_teardown(TC_iot_cap_commands_cb_failure, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test_setup_teardown(TC_iot_cap_commands_cb_success, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_cap_dispatch_commands_parse_once, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_cap_dispatch_commands_hashed_index, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_cap_dispatch_commands_arena_reset, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_serialize_writer_matches_json_print, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_st_cap_send_attr_batch_coalesce, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_st_cap_send_attr_offline_replay, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_st_cap_send_attr_offline_spill, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test(TC_st_cap_send_attr_offline_replace),
             cmocka_unit_test_setup_teardown(TC_iot_parse_noti_data_presference_updated, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_cap_dispatch_commands_cbor_matches_json, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_parse_noti_data_cbor_matches_json, TC_iot_capability_setup, TC_iot_capability_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_noti_sub_cb_cbor_rate_limit_reached_SUCCESS, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test_setup_teardown(TC_iot_cap_call_init_cb_null_parameteer, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test_setup_teardown(TC_iot_cap_call_init_cb_success, TC_iot_capability_setup, TC_iot_capability_teardown),
             cmocka_unit_test_setup_teardown(TC_st_cap_send_attr_v2_null_parameter, TC_iot_capability_setup, TC_iot_capability_teardown),
@@ -121,6 +135,8 @@ int TEST_FUNC_iot_nv_data(void)
             cmocka_unit_test_setup_teardown(TC_iot_nv_erase_internal_failure, TC_iot_nv_data_setup, TC_iot_nv_data_teardown),
             cmocka_unit_test_setup_teardown(TC_iot_nv_get_data_from_device_info_failure, TC_iot_nv_data_setup, TC_iot_nv_data_teardown),
             cmocka_unit_test_setup_teardown(TC_iot_nv_get_data_from_device_info_success, TC_iot_nv_data_setup, TC_iot_nv_data_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_nv_begin_commit_batch, TC_iot_nv_data_setup, TC_iot_nv_data_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_nv_cache_write_back, TC_iot_nv_data_setup, TC_iot_nv_data_teardown),
     };
     return cmocka_run_group_tests_name("iot_nv_data.c", tests, NULL, NULL);
 }
@@ -137,10 +153,51 @@ int TEST_FUNC_iot_util(void)
             cmocka_unit_test(TC_iot_util_convert_channel_freq),
             cmocka_unit_test(TC_iot_util_convert_mac_str_invalid_parameters),
             cmocka_unit_test(TC_iot_util_convert_mac_str_success),
+            cmocka_unit_test(TC_iot_util_queue_ring_send_receive),
+            cmocka_unit_test(TC_iot_util_queue_receive_batch),
+            cmocka_unit_test(TC_iot_util_queue_ring_benchmark),
+            cmocka_unit_test(TC_iot_util_queue_ring_remove_if_concurrent),
     };
     return cmocka_run_group_tests_name("iot_util.c", tests, NULL, NULL);
 }
 
+int TEST_FUNC_iot_os_util(void)
+{
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(TC_iot_os_eventgroup_wait_set_bits),
+            cmocka_unit_test(TC_iot_os_eventgroup_wakeup_from_thread),
+            cmocka_unit_test(TC_iot_os_timer_expiry_order),
+            cmocka_unit_test(TC_iot_os_timer_create_delete_reuse),
+            cmocka_unit_test(TC_iot_os_timer_delete_while_running),
+    };
+    return cmocka_run_group_tests_name("iot_os_util_posix.c", tests, NULL, NULL);
+}
+
+int TEST_FUNC_iot_bsp_fs(void)
+{
+    const struct CMUnitTest tests[] = {
+#if defined(CONFIG_STDK_IOT_CORE_BSP_POSIX_PACKED_NV)
+            cmocka_unit_test_setup_teardown(TC_iot_bsp_fs_packed_nv_write_remove_reopen, TC_iot_bsp_fs_packed_nv_setup, TC_iot_bsp_fs_packed_nv_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_bsp_fs_packed_nv_torn_tail, TC_iot_bsp_fs_packed_nv_setup, TC_iot_bsp_fs_packed_nv_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_bsp_fs_packed_nv_compaction, TC_iot_bsp_fs_packed_nv_setup, TC_iot_bsp_fs_packed_nv_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_bsp_fs_packed_nv_latest_record_wins, TC_iot_bsp_fs_packed_nv_setup, TC_iot_bsp_fs_packed_nv_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_bsp_fs_packed_nv_spill_file_outside, TC_iot_bsp_fs_packed_nv_setup, TC_iot_bsp_fs_packed_nv_teardown),
+#endif
+    };
+    return cmocka_run_group_tests_name("iot_bsp_fs_posix.c", tests, NULL, NULL);
+}
+
+int TEST_FUNC_iot_executor(void)
+{
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(TC_iot_executor_context_serialization),
+            cmocka_unit_test(TC_iot_executor_socket_watch),
+            cmocka_unit_test(TC_iot_executor_socket_wake_write),
+            cmocka_unit_test(TC_iot_executor_inbound_latency),
+    };
+    return cmocka_run_group_tests_name("iot_executor.c", tests, NULL, NULL);
+}
+
 int TEST_FUNC_iot_uuid(void)
 {
     const struct CMUnitTest tests[] = {
@@ -193,6 +250,7 @@ int TEST_FUNC_iot_main()
             cmocka_unit_test(TC_st_conn_init_wrong_onboarding_config),
             cmocka_unit_test(TC_st_conn_init_wrong_device_info),
             cmocka_unit_test(TC_st_conn_init_success),
+            cmocka_unit_test(TC_st_conn_init_context_memory),
             cmocka_unit_test(TC_st_conn_cleanup_invalid_parameters),
             cmocka_unit_test(TC_st_conn_cleanup_success),
             cmocka_unit_test(TC_easysetup_resources_create_delete_success),
@@ -209,6 +267,12 @@ int TEST_FUNC_iot_mqtt_client()
             cmocka_unit_test(TC_st_mqtt_connect_with_connack_rc),
             cmocka_unit_test(TC_st_mqtt_disconnect_success),
             cmocka_unit_test(TC_st_mqtt_publish_success),
+            cmocka_unit_test(TC_st_mqtt_get_chunk_pool_stats),
+            cmocka_unit_test(TC_st_mqtt_destroy_with_owned_chunk),
+            cmocka_unit_test(TC_iot_mqtt_inflight_find_and_expire),
+            cmocka_unit_test(TC_st_mqtt_get_read_stats),
+            cmocka_unit_test(TC_st_mqtt_write_coalescing),
+            cmocka_unit_test(TC_st_mqtt_get_connect_stats),
     };
     return cmocka_run_group_tests_name("iot_mqtt_client.c", tests, NULL, NULL);
 }
@@ -393,6 +457,7 @@ int TEST_FUNC_iot_wt(void)
     const struct CMUnitTest tests[] = {
             cmocka_unit_test_setup_teardown(TC_iot_wt_create_null_parameters, TC_iot_wt_create_memleak_detect_setup, TC_iot_wt_create_memleak_detect_teardown),
             cmocka_unit_test_setup_teardown(TC_iot_wt_create_success, TC_iot_wt_create_memleak_detect_setup, TC_iot_wt_create_memleak_detect_teardown),
+            cmocka_unit_test_setup_teardown(TC_iot_wt_create_cached_reuse, TC_iot_wt_create_memleak_detect_setup, TC_iot_wt_create_memleak_detect_teardown),
     };
     return cmocka_run_group_tests_name("iot_wt.c", tests, NULL, NULL);
 }
@@ -461,10 +526,13 @@ int TEST_FUNC_iot_easysetup_http(void)
 int main(void) {
     int err = 0;
 
+    err += TEST_FUNC_iot_bsp_fs();
     err += TEST_FUNC_iot_api();
     err += TEST_FUNC_iot_capability();
     err += TEST_FUNC_iot_nv_data();
     err += TEST_FUNC_iot_util();
+    err += TEST_FUNC_iot_os_util();
+    err += TEST_FUNC_iot_executor();
     err += TEST_FUNC_iot_uuid();
     err += TEST_FUNC_iot_easysetup_d2d();
     err += TEST_FUNC_iot_main();
@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+
+import argparse
+import glob
+import os
+import re
+
+__version__ = "1.0.0"
+helperPrefix = "iot_caps_helper_"
+descHeader = "iot_caps_desc.h"
+descSource = "iot_caps_desc.c"
+
+license = """/* ***************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Generated by tools/capgen/%s from %s*.h, do not edit */
+"""
+
+identifier = re.compile(r"^[A-Za-z_][A-Za-z0-9_]*$")
+
+
+class Attribute:
+    def __init__(self, capability, member, body):
+        self.capability = capability
+        self.member = member
+        self.name = self.readString("name", body)
+        self.property = self.readField("property", body) or "0"
+        self.valueType = self.readField("valueType", body)
+        self.values = self.readList("values", body)
+        self.units = self.readList("units", body)
+        self.min = self.readField("min", body)
+        self.max = self.readField("max", body)
+        self.maxLength = self.readField("max_length", body)
+
+        if not identifier.match(self.name):
+            raise ValueError("%s.%s is not usable for C identifier" % (capability, self.name))
+        if self.valueType is None:
+            raise ValueError("%s.%s has no valueType" % (capability, self.name))
+
+    @staticmethod
+    def readField(field, body):
+        m = re.search(r"^\s*\.%s\s*=\s*([^,\n]*),?\s*$" % field, body, re.M)
+        if m is None or m.group(1).strip() == "":
+            return None
+        return m.group(1).strip()
+
+    @staticmethod
+    def readString(field, body):
+        m = re.search(r"^\s*\.%s\s*=\s*\"([^\"]*)\"" % field, body, re.M)
+        if m is None:
+            raise ValueError("no %s in %s" % (field, body))
+        return m.group(1)
+
+    @staticmethod
+    def readList(field, body):
+        m = re.search(r"^\s*\.%s\s*=\s*\{(.*)\},?\s*$" % field, body, re.M)
+        if m is None:
+            return []
+        return re.findall(r"\"((?:[^\"\\]|\\.)*)\"", m.group(1))
+
+    def isArray(self):
+        return "ATTR_SET_VALUE_ARRAY" in self.property
+
+    def id(self):
+        return "IOT_CAPS_ATTR_%s_%s" % (self.capability.upper(), self.name.upper())
+
+    def symbol(self):
+        return "%s_%s" % (self.capability, self.name)
+
+
+def readCapability(path):
+    with open(path) as f:
+        text = f.read()
+
+    m = re.search(r"\}\s*caps_helper_(\w+)\s*=\s*\{(.*)\n\};", text, re.S)
+    if m is None:
+        raise ValueError("no caps_helper initializer in %s" % path)
+    capability = re.search(r"\.id\s*=\s*\"([^\"]+)\"", m.group(2)).group(1)
+    if not identifier.match(capability):
+        raise ValueError("%s is not usable for C identifier" % capability)
+
+    attributes = []
+    for member, body in re.findall(r"^\s*\.attr_(\w+)\s*=\s*\{\n(.*?)^\s*\},", m.group(2), re.S | re.M):
+        attributes.append(Attribute(capability, member, body))
+    return capability, attributes
+
+
+def cString(value):
+    return '"%s"' % value.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def jsonKey(attr):
+    return '"capability":"%s","attribute":"%s"' % (attr.capability, attr.name)
+
+
+def cborText(value):
+    data = value.encode("utf-8")
+    if len(data) < 24:
+        head = bytes([0x60 | len(data)])
+    elif len(data) < 256:
+        head = bytes([0x78, len(data)])
+    else:
+        raise ValueError("%s is too long" % value)
+    return '"%s" %s' % ("".join("\\x%02x" % b for b in head), cString(value))
+
+
+def cborKey(attr):
+    return " ".join([cborText("capability"), cborText(attr.capability),
+                     cborText("attribute"), cborText(attr.name)])
+
+
+def senderParams(attr):
+    if attr.valueType == "VALUE_TYPE_OBJECT" or (attr.isArray() and attr.valueType != "VALUE_TYPE_STRING"):
+        params = ["const char *json"]
+        body = ["value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;", "value.json_object = (char *)json;"]
+    elif attr.isArray():
+        params = ["const char **values", "uint8_t num"]
+        body = ["value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;", "value.strings = (char **)values;",
+                "value.str_num = num;"]
+    elif attr.valueType == "VALUE_TYPE_INTEGER":
+        params = ["int integer"]
+        body = ["value.type = IOT_CAP_VAL_TYPE_INTEGER;", "value.integer = integer;"]
+    elif attr.valueType == "VALUE_TYPE_NUMBER":
+        params = ["double number"]
+        body = ["value.type = IOT_CAP_VAL_TYPE_NUMBER;", "value.number = number;"]
+    elif attr.valueType == "VALUE_TYPE_BOOLEAN":
+        params = ["bool boolean"]
+        body = ["value.type = IOT_CAP_VAL_TYPE_BOOLEAN;", "value.boolean = boolean;"]
+    elif attr.valueType == "VALUE_TYPE_STRING":
+        params = ["const char *string"]
+        body = ["value.type = IOT_CAP_VAL_TYPE_STRING;", "value.string = (char *)string;"]
+    else:
+        raise ValueError("%s has unknown valueType %s" % (attr.symbol(), attr.valueType))
+
+    if len(attr.units) > 1:
+        params.append("const char *unit")
+    return params, body
+
+
+def writeHeader(path, attributes):
+    out = [license % (os.path.basename(__file__), helperPrefix)]
+    out.append("#ifndef _IOT_CAPS_DESC_H_\n#define _IOT_CAPS_DESC_H_\n")
+    out.append("#include <stdbool.h>\n#include \"st_dev.h\"\n")
+    out.append("#ifdef __cplusplus\nextern \"C\" {\n#endif\n")
+    out.append("/**\n * @brief Interned ids of attributes, index of generated attribute description table\n */")
+    out.append("enum {")
+    for attr in attributes:
+        out.append("\t%s," % attr.id())
+    out.append("\tIOT_CAPS_ATTR_MAX\n};\n")
+
+    out.append("/*\n * Typed senders check value against the attribute description and")
+    out.append(" * publish it without copying, see st_cap_send_attr_desc().")
+    out.append(" * Attribute with one unit is sent with it, unit is chosen by caller")
+    out.append(" * when there are several.\n */")
+    for attr in attributes:
+        params, body = senderParams(attr)
+        unit = "unit" if len(attr.units) > 1 else "NULL"
+        out.append("static inline int st_cap_send_%s(IOT_CAP_HANDLE *cap_handle, %s)" % (attr.symbol(), ", ".join(params)))
+        out.append("{\n\tiot_cap_val_t value;\n")
+        out.extend("\t" + line for line in body)
+        out.append("\n\treturn st_cap_send_attr_desc(cap_handle, %s, &value, %s);\n}\n" % (attr.id(), unit))
+
+    out.append("#ifdef __cplusplus\n}\n#endif\n")
+    out.append("#endif /* _IOT_CAPS_DESC_H_ */")
+    with open(path, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def writeSource(path, attributes):
+    out = [license % (os.path.basename(__file__), helperPrefix)]
+    out.append("#include <stddef.h>\n")
+    out.append("#include \"iot_capability.h\"\n#include \"caps/iot_caps_helper.h\"\n#include \"caps/iot_caps_desc.h\"\n")
+    out.append("/* Only the key fragment of event payload format is built in */")
+    out.append("#if defined(STDK_IOT_CORE_SERIALIZE_CBOR)")
+    out.append("#define _IOT_CAPS_KEY(json, cbor)\t.key = cbor, .key_len = sizeof(cbor) - 1")
+    out.append("#else")
+    out.append("#define _IOT_CAPS_KEY(json, cbor)\t.key = json, .key_len = sizeof(json) - 1")
+    out.append("#endif\n")
+
+    for attr in attributes:
+        if attr.values:
+            out.append("static const char *const _%s_values[] = {%s};" % (attr.symbol(), ", ".join(cString(v) for v in attr.values)))
+        if attr.units:
+            out.append("static const char *const _%s_units[] = {%s};" % (attr.symbol(), ", ".join(cString(v) for v in attr.units)))
+    out.append("")
+
+    out.append("const iot_caps_attr_desc_t iot_caps_attr_descs[IOT_CAPS_ATTR_MAX] = {")
+    for attr in attributes:
+        out.append("\t[%s] = {" % attr.id())
+        out.append("\t\t.capability = %s," % cString(attr.capability))
+        out.append("\t\t.name = %s," % cString(attr.name))
+        out.append("\t\t.property = %s," % attr.property)
+        out.append("\t\t.value_type = %s," % attr.valueType)
+        if attr.min is not None:
+            out.append("\t\t.min = %s," % attr.min)
+        if attr.max is not None:
+            out.append("\t\t.max = %s," % attr.max)
+        if attr.maxLength is not None:
+            out.append("\t\t.max_length = %s," % attr.maxLength)
+        if attr.values:
+            out.append("\t\t.values = _%s_values," % attr.symbol())
+            out.append("\t\t.values_num = %d," % len(attr.values))
+        if attr.units:
+            out.append("\t\t.units = _%s_units," % attr.symbol())
+            out.append("\t\t.units_num = %d," % len(attr.units))
+        out.append("\t\t_IOT_CAPS_KEY(%s,\n\t\t\t\t%s)," % (cString(jsonKey(attr)), cborKey(attr)))
+        out.append("\t},")
+    out.append("};")
+    with open(path, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def main():
+    root = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+
+    parser = argparse.ArgumentParser(
+        description="%s v%s - SmartThings capability description generation tool" %
+        (os.path.basename(__file__), __version__))
+
+    parser.add_argument(
+        '--caps',
+        default=os.path.join(root, "src", "include", "caps"),
+        help="Folder containing %s*.h, where %s is generated" % (helperPrefix, descHeader))
+    parser.add_argument(
+        '--src',
+        default=os.path.join(root, "src"),
+        help="Folder where %s is generated" % descSource)
+
+    args = parser.parse_args()
+
+    attributes = []
+    ids = {}
+    for path in sorted(glob.glob(os.path.join(args.caps, helperPrefix + "*.h"))):
+        capability, attrs = readCapability(path)
+        for attr in attrs:
+            if attr.id() in ids:
+                raise ValueError("%s and %s have the same id" % (attr.symbol(), ids[attr.id()]))
+            ids[attr.id()] = attr.symbol()
+        attributes.extend(attrs)
+
+    writeHeader(os.path.join(args.caps, descHeader), attributes)
+    writeSource(os.path.join(args.src, descSource), attributes)
+    print("%d attributes of %d files" % (len(attributes),
+          len(glob.glob(os.path.join(args.caps, helperPrefix + "*.h")))))
+
+
+if __name__ == "__main__":
+    main()